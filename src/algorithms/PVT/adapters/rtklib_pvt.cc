@@ -90,6 +90,8 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
         {
             pvt_output_parameters.rinex_name = FLAGS_RINEX_name;
         }
+    pvt_output_parameters.rinex_compact = configuration->property(role + ".rinex_compact", false);
+    pvt_output_parameters.rinex_gzip = configuration->property(role + ".rinex_gzip", false);
 
     // RTCM Printer settings
     pvt_output_parameters.flag_rtcm_tty_port = configuration->property(role + ".flag_rtcm_tty_port", false);
@@ -97,6 +99,30 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     pvt_output_parameters.flag_rtcm_server = configuration->property(role + ".flag_rtcm_server", false);
     pvt_output_parameters.rtcm_tcp_port = configuration->property(role + ".rtcm_tcp_port", 2101);
     pvt_output_parameters.rtcm_station_id = configuration->property(role + ".rtcm_station_id", 1234);
+    pvt_output_parameters.rtcm_server_threads = configuration->property(role + ".rtcm_server_threads", 1);
+    pvt_output_parameters.rtcm_server_max_backlog = configuration->property(role + ".rtcm_server_max_backlog", 256);
+    const std::string rtcm_backlog_policy_str = configuration->property(role + ".rtcm_server_backlog_policy", std::string("drop_oldest"));
+    if (rtcm_backlog_policy_str == "drop_newest")
+        {
+            pvt_output_parameters.rtcm_server_backlog_policy = 1;
+        }
+    else if (rtcm_backlog_policy_str == "disconnect")
+        {
+            pvt_output_parameters.rtcm_server_backlog_policy = 2;
+        }
+    else
+        {
+            if (rtcm_backlog_policy_str != "drop_oldest")
+                {
+                    // warn user and set the default
+                    std::cout << "WARNING: Bad specification of rtcm_server_backlog_policy.\n"
+                              << "rtcm_server_backlog_policy possible values: drop_oldest / drop_newest / disconnect\n"
+                              << "rtcm_server_backlog_policy specified value: " << rtcm_backlog_policy_str << "\n"
+                              << "Setting rtcm_server_backlog_policy to drop_oldest\n"
+                              << std::flush;
+                }
+            pvt_output_parameters.rtcm_server_backlog_policy = 0;
+        }
     // RTCM message rates: least common multiple with output_rate_ms
     const int rtcm_MT1019_rate_ms = bc::lcm(configuration->property(role + ".rtcm_MT1019_rate_ms", 5000), pvt_output_parameters.output_rate_ms);
     const int rtcm_MT1020_rate_ms = bc::lcm(configuration->property(role + ".rtcm_MT1020_rate_ms", 5000), pvt_output_parameters.output_rate_ms);
@@ -854,6 +880,11 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     pvt_output_parameters.max_obs_block_rx_clock_offset_ms = configuration->property(role + ".max_clock_offset_ms", pvt_output_parameters.max_obs_block_rx_clock_offset_ms);
 
 
+    // Vector tracking engine, fed with the satellite states of each solution
+    pvt_output_parameters.vector_tracking = configuration->property(role + ".vector_tracking", pvt_output_parameters.vector_tracking);
+    pvt_output_parameters.vtl_update_period_ms = configuration->property(role + ".vtl_update_period_ms", pvt_output_parameters.vtl_update_period_ms);
+    pvt_output_parameters.vtl_accel_sd_m_s2 = configuration->property(role + ".vtl_accel_sd_m_s2", pvt_output_parameters.vtl_accel_sd_m_s2);
+
     // Source timetag
     pvt_output_parameters.log_source_timetag = configuration->property(role + ".log_timetag", pvt_output_parameters.log_source_timetag);
     pvt_output_parameters.log_source_timetag_file = configuration->property(role + ".log_source_timetag_file", pvt_output_parameters.log_source_timetag_file);
@@ -891,6 +922,12 @@ bool Rtklib_Pvt::get_latest_PVT(double* longitude_deg,
 }
 
 
+bool Rtklib_Pvt::get_latest_clock_drift(double* clock_drift_ppm)
+{
+    return pvt_->get_latest_clock_drift(clock_drift_ppm);
+}
+
+
 void Rtklib_Pvt::clear_ephemeris()
 {
     pvt_->clear_ephemeris();
@@ -56,7 +56,7 @@
 #include "rtcm_printer.h"
 #include "rtklib_rtkcmn.h"
 #include "rtklib_solver.h"
-#include "trackingcmd.h"
+#include "vtl_engine.h"
 #include <boost/archive/xml_iarchive.hpp>  // for xml_iarchive
 #include <boost/archive/xml_oarchive.hpp>  // for xml_oarchive
 #include <boost/exception/diagnostic_information.hpp>
@@ -169,7 +169,8 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
       d_waiting_obs_block_rx_clock_offset_correction_msg(false),
       d_enable_rx_clock_correction(conf_.enable_rx_clock_correction),
       d_an_printer_enabled(conf_.an_output_enabled),
-      d_log_timetag(conf_.log_source_timetag)
+      d_log_timetag(conf_.log_source_timetag),
+      d_vector_tracking(conf_.vector_tracking)
 {
     // Send feedback message to observables block with the receiver clock offset
     this->message_port_register_out(pmt::mp("pvt_to_observables"));
@@ -309,7 +310,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
     const std::string rtcm_dump_filename = d_dump_filename;
     if (conf_.flag_rtcm_server || conf_.flag_rtcm_tty_port || conf_.rtcm_output_file_enabled)
         {
-            d_rtcm_printer = std::make_unique<Rtcm_Printer>(rtcm_dump_filename, conf_.rtcm_output_file_enabled, conf_.flag_rtcm_server, conf_.flag_rtcm_tty_port, conf_.rtcm_tcp_port, conf_.rtcm_station_id, conf_.rtcm_dump_devname, true, conf_.rtcm_output_file_path);
+            d_rtcm_printer = std::make_unique<Rtcm_Printer>(rtcm_dump_filename, conf_.rtcm_output_file_enabled, conf_.flag_rtcm_server, conf_.flag_rtcm_tty_port, conf_.rtcm_tcp_port, conf_.rtcm_station_id, conf_.rtcm_dump_devname, true, conf_.rtcm_output_file_path, conf_.rtcm_server_threads, conf_.rtcm_server_max_backlog, conf_.rtcm_server_backlog_policy);
             std::map<int, int> rtcm_msg_rate_ms = conf_.rtcm_msg_rate_ms;
             if (rtcm_msg_rate_ms.find(1019) != rtcm_msg_rate_ms.end())
                 {
@@ -379,7 +380,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
     // initialize RINEX printer
     if (d_rinex_output_enabled)
         {
-            d_rp = std::make_unique<Rinex_Printer>(d_rinex_version, conf_.rinex_output_path, conf_.rinex_name);
+            d_rp = std::make_unique<Rinex_Printer>(d_rinex_version, conf_.rinex_output_path, conf_.rinex_name, conf_.rinex_compact, conf_.rinex_gzip);
             d_rp->set_pre_2009_file(conf_.pre_2009_file);
         }
     else
@@ -544,6 +545,15 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
             d_user_pvt_solver = d_internal_pvt_solver;
         }
 
+    if (d_vector_tracking)
+        {
+            d_user_pvt_solver->enable_satellite_states(true);
+            Vtl_Engine::Parameters vtl_parameters;
+            vtl_parameters.update_period_s = static_cast<double>(conf_.vtl_update_period_ms) / 1000.0;
+            vtl_parameters.accel_sd_m_s2 = conf_.vtl_accel_sd_m_s2;
+            Vtl_Engine::instance().configure(vtl_parameters);
+        }
+
     d_mapStringValues["1C"] = evGPS_1C;
     d_mapStringValues["2S"] = evGPS_2S;
     d_mapStringValues["L5"] = evGPS_L5;
@@ -1781,6 +1791,18 @@ bool rtklib_pvt_gs::get_latest_PVT(double* longitude_deg,
 }
 
 
+bool rtklib_pvt_gs::get_latest_clock_drift(double* clock_drift_ppm) const
+{
+    const Rtklib_Solver* solver = d_enable_rx_clock_correction ? d_user_pvt_solver.get() : d_internal_pvt_solver.get();
+    if (solver != nullptr and solver->is_valid_position())
+        {
+            *clock_drift_ppm = solver->get_clock_drift_ppm();
+            return true;
+        }
+    return false;
+}
+
+
 void rtklib_pvt_gs::apply_rx_clock_offset(std::map<int, Gnss_Synchro>& observables_map,
     double rx_clock_offset_s)
 {
@@ -1884,6 +1906,55 @@ std::map<int, Gnss_Synchro> rtklib_pvt_gs::interpolate_observables(const std::ma
 }
 
 
+void rtklib_pvt_gs::update_vector_tracking_engine() const
+{
+    const Gnss_Synchro& first_obs = d_gnss_observables_map.cbegin()->second;
+    Vtl_Engine::Navigation_Solution solution{};
+    solution.sample_counter = first_obs.Tracking_sample_counter;
+    solution.fs = static_cast<double>(first_obs.fs);
+    for (int i = 0; i < 3; i++)
+        {
+            solution.pos[i] = d_user_pvt_solver->pvt_sol.rr[i];
+            solution.vel[i] = d_user_pvt_solver->pvt_sol.rr[i + 3];
+        }
+    solution.clock_drift_m_s = d_user_pvt_solver->pvt_sol.dtr[5];
+
+    for (const auto& obs : d_gnss_observables_map)
+        {
+            int sys = SYS_NONE;
+            switch (obs.second.System)
+                {
+                case 'G':
+                    sys = SYS_GPS;
+                    break;
+                case 'E':
+                    sys = SYS_GAL;
+                    break;
+                case 'R':
+                    sys = SYS_GLO;
+                    break;
+                case 'C':
+                    sys = SYS_BDS;
+                    break;
+                default:
+                    break;
+                }
+            const auto sat_state = d_user_pvt_solver->pvt_sat_states.find(satno(sys, static_cast<int>(obs.second.PRN)));
+            if (sys == SYS_NONE or sat_state == d_user_pvt_solver->pvt_sat_states.cend())
+                {
+                    continue;
+                }
+            Vtl_Engine::Satellite_State sat{};
+            sat.pos = {sat_state->second[0], sat_state->second[1], sat_state->second[2]};
+            sat.vel = {sat_state->second[3], sat_state->second[4], sat_state->second[5]};
+            sat.clock_drift = sat_state->second[6];
+            sat.satellite = Vtl_Engine::satellite_id(obs.second.System, obs.second.PRN);
+            solution.satellites[obs.first] = sat;
+        }
+    Vtl_Engine::instance().set_navigation_solution(solution);
+}
+
+
 void rtklib_pvt_gs::initialize_and_apply_carrier_phase_offset()
 {
     // we have a valid PVT. First check if we need to reset the initial carrier phase offsets to match their pseudoranges
@@ -2224,12 +2295,11 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
 
                     if (flag_pvt_valid == true)
                         {
-                            // experimental VTL tests
-                            // send tracking command
-                            //                            const std::shared_ptr<TrackingCmd> trk_cmd_test = std::make_shared<TrackingCmd>(TrackingCmd());
-                            //                            trk_cmd_test->carrier_freq_hz = 12345.4;
-                            //                            trk_cmd_test->sample_counter = d_gnss_observables_map.begin()->second.Tracking_sample_counter;
-                            //                            this->message_port_pub(pmt::mp("pvt_to_trk"), pmt::make_any(trk_cmd_test));
+                            // satellite states and receiver fix for the vector tracking engine
+                            if (d_vector_tracking)
+                                {
+                                    update_vector_tracking_engine();
+                                }
 
                             // initialize (if needed) the accumulated phase offset and apply it to the active channels
                             // required to report accumulated phase cycles comparable to pseudoranges
@@ -124,6 +124,11 @@ public:
         double* course_over_ground_deg,
         time_t* UTC_time) const;
 
+    /*!
+     * \brief Get the latest receiver clock drift [ppm], if available
+     */
+    bool get_latest_clock_drift(double* clock_drift_ppm) const;
+
     int work(int noutput_items, gr_vector_const_void_star& input_items,
         gr_vector_void_star& output_items);  //!< PVT Signal Processing
 
@@ -144,6 +149,8 @@ private:
 
     void initialize_and_apply_carrier_phase_offset();
 
+    void update_vector_tracking_engine() const;
+
     void apply_rx_clock_offset(std::map<int, Gnss_Synchro>& observables_map,
         double rx_clock_offset_s);
 
@@ -287,6 +294,7 @@ private:
     bool d_enable_has_messages;
     bool d_an_printer_enabled;
     bool d_log_timetag;
+    bool d_vector_tracking;
 };
 
 
@@ -0,0 +1,319 @@
+/*!
+ * \file compact_rinex_encoder.cc
+ * \brief Implementation of a class that converts RINEX 3 observation text
+ * into Compact RINEX (Hatanaka) format.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "compact_rinex_encoder.h"
+#include <algorithm>  // for std::max
+#include <cerrno>     // for errno
+#include <cstdlib>    // for strtol, strtoll
+#include <ctime>      // for time, gmtime, strftime
+#include <utility>    // for std::swap
+
+
+std::string Compact_Rinex_Encoder::encode(const std::string& rinex_text)
+{
+    std::string out;
+    out.reserve(rinex_text.size() / 2);
+    std::string::size_type start = 0;
+    while (start < rinex_text.size())
+        {
+            const auto end = rinex_text.find('\n', start);
+            if (end == std::string::npos)
+                {
+                    d_partial_line.append(rinex_text, start, std::string::npos);
+                    break;
+                }
+            d_partial_line.append(rinex_text, start, end - start);
+            if (!d_partial_line.empty() and d_partial_line.back() == '\r')
+                {
+                    d_partial_line.pop_back();
+                }
+            encode_line(d_partial_line, out);
+            d_partial_line.clear();
+            start = end + 1;
+        }
+    return out;
+}
+
+
+void Compact_Rinex_Encoder::reset()
+{
+    d_satellites.clear();
+    d_clock = Arc();
+    d_epoch_reset = true;
+}
+
+
+void Compact_Rinex_Encoder::encode_line(const std::string& line, std::string& out)
+{
+    if (d_in_header)
+        {
+            encode_header_line(line, out);
+            return;
+        }
+
+    if (d_in_event)
+        {
+            // Header records of a special event are copied as they are
+            encode_header_line(line, out);
+            d_in_header = false;
+            if (--d_pending_lines == 0)
+                {
+                    d_in_event = false;
+                }
+            return;
+        }
+
+    if (d_pending_lines > 0)
+        {
+            d_records.push_back(line);
+            if (--d_pending_lines == 0)
+                {
+                    encode_epoch(out);
+                }
+            return;
+        }
+
+    if (line.empty() or line[0] != '>')
+        {
+            // not an epoch record, nothing sensible can be done with it
+            return;
+        }
+
+    const char flag = line.size() > 31 ? line[31] : '0';
+    const int num_records = line.size() > 32 ? static_cast<int>(strtol(line.substr(32, 3).c_str(), nullptr, 10)) : 0;
+    if (flag >= '2' and flag <= '5')
+        {
+            // Special event: the epoch line and the records that follow are
+            // written uncompressed, and the next epoch line is written in full
+            out += rtrim(line);
+            out += '\n';
+            d_pending_lines = num_records;
+            d_in_event = num_records > 0;
+            d_epoch_reset = true;
+            return;
+        }
+
+    d_epoch_line = line;
+    d_records.clear();
+    d_pending_lines = num_records;
+    if (num_records <= 0)
+        {
+            d_pending_lines = 0;
+            encode_epoch(out);
+        }
+}
+
+
+void Compact_Rinex_Encoder::encode_header_line(const std::string& line, std::string& out)
+{
+    if (!d_header_started)
+        {
+            char date[20];
+            const std::time_t now = std::time(nullptr);
+            std::strftime(date, sizeof(date), "%d-%b-%y %H:%M", std::gmtime(&now));
+            std::string crx_version("3.0");
+            crx_version.resize(20, ' ');
+            std::string crx_type("COMPACT RINEX FORMAT");
+            crx_type.resize(40, ' ');
+            std::string crx_program("GNSS-SDR");
+            crx_program.resize(40, ' ');
+            std::string crx_date(date);
+            crx_date.resize(20, ' ');
+            out += crx_version + crx_type + "CRINEX VERS   / TYPE\n";
+            out += crx_program + crx_date + "CRINEX PROG / DATE\n";
+            d_header_started = true;
+        }
+
+    const std::string label = line.size() > 60 ? rtrim(line.substr(60)) : std::string();
+    if (label == "SYS / # / OBS TYPES" and line[0] != ' ')
+        {
+            d_num_obs_types[line[0]] = static_cast<int>(strtol(line.substr(3, 3).c_str(), nullptr, 10));
+        }
+    out += line;
+    out += '\n';
+    if (label == "END OF HEADER")
+        {
+            d_in_header = false;
+        }
+}
+
+
+void Compact_Rinex_Encoder::encode_epoch(std::string& out)
+{
+    // Epoch line, without the clock offset and followed by the list of satellites
+    std::string epoch = d_epoch_line.substr(0, 41);
+    epoch.resize(41, ' ');
+    const std::string clock = d_epoch_line.size() > 41 ? d_epoch_line.substr(41, 15) : std::string();
+    for (const auto& record : d_records)
+        {
+            std::string sat = record.substr(0, 3);
+            sat.resize(3, ' ');
+            epoch += sat;
+        }
+    if (d_epoch_reset)
+        {
+            out += rtrim(epoch);
+            d_epoch_reset = false;
+        }
+    else
+        {
+            out += text_diff(d_previous_epoch, epoch);
+        }
+    out += '\n';
+    d_previous_epoch = std::move(epoch);
+
+    // Receiver clock offset line (empty if not present)
+    out += take_diff(d_clock, clock);
+    out += '\n';
+
+    // One line per satellite: differenced observables, then the LLI and SSI flags
+    std::map<std::string, Satellite_State> current;
+    for (const auto& record : d_records)
+        {
+            std::string sat = record.substr(0, 3);
+            sat.resize(3, ' ');
+            int num_obs;
+            const auto types = d_num_obs_types.find(sat[0]);
+            if (types != d_num_obs_types.cend())
+                {
+                    num_obs = types->second;
+                }
+            else
+                {
+                    num_obs = std::max(0, static_cast<int>(rtrim(record).size()) - 3 + 15) / 16;
+                }
+
+            Satellite_State& state = current[sat];
+            const auto previous = d_satellites.find(sat);
+            if (previous != d_satellites.end() and static_cast<int>(previous->second.arcs.size()) == num_obs)
+                {
+                    std::swap(state, previous->second);
+                }
+            else
+                {
+                    state.arcs.assign(num_obs, Arc());
+                    state.flags = std::string(2 * num_obs, ' ');
+                }
+
+            std::string line;
+            std::string flags(2 * num_obs, ' ');
+            for (int j = 0; j < num_obs; j++)
+                {
+                    const std::string::size_type pos = 3 + 16 * j;
+                    if (j > 0)
+                        {
+                            line += ' ';
+                        }
+                    line += take_diff(state.arcs[j], pos < record.size() ? record.substr(pos, 14) : std::string());
+                    if (pos + 14 < record.size())
+                        {
+                            flags[2 * j] = record[pos + 14];
+                        }
+                    if (pos + 15 < record.size())
+                        {
+                            flags[2 * j + 1] = record[pos + 15];
+                        }
+                }
+            const std::string flags_diff = text_diff(state.flags, flags);
+            state.flags = std::move(flags);
+            if (flags_diff.empty())
+                {
+                    out += rtrim(line);
+                }
+            else
+                {
+                    out += line;
+                    out += ' ';
+                    out += flags_diff;
+                }
+            out += '\n';
+        }
+    d_satellites.swap(current);
+    d_records.clear();
+}
+
+
+std::string Compact_Rinex_Encoder::take_diff(Arc& arc, const std::string& field) const
+{
+    // Fixed-point text to integer, in units of its last decimal
+    std::string digits;
+    digits.reserve(field.size());
+    for (const char c : field)
+        {
+            if (c != '.' and c != ' ')
+                {
+                    digits += c;
+                }
+        }
+    if (digits.empty())
+        {
+            arc.order = -1;
+            return std::string();
+        }
+    char* end = nullptr;
+    errno = 0;
+    const int64_t value = strtoll(digits.c_str(), &end, 10);
+    if (errno != 0 or *end != '\0')
+        {
+            arc.order = -1;
+            return std::string();
+        }
+
+    if (arc.order < 0)
+        {
+            // Start of a new arc: the value is written in full
+            arc.order = 0;
+            arc.u[0] = value;
+            return std::to_string(ARC_ORDER) + "&" + std::to_string(value);
+        }
+
+    const Arc previous = arc;
+    arc.order = previous.order < ARC_ORDER ? previous.order + 1 : ARC_ORDER;
+    arc.u[0] = value;
+    for (int k = 0; k < arc.order; k++)
+        {
+            arc.u[k + 1] = arc.u[k] - previous.u[k];
+        }
+    return std::to_string(arc.u[arc.order]);
+}
+
+
+std::string Compact_Rinex_Encoder::text_diff(const std::string& previous, const std::string& current) const
+{
+    // Unchanged characters become blanks, characters that became blank become '&'
+    std::string diff(std::max(previous.size(), current.size()), ' ');
+    for (std::string::size_type i = 0; i < diff.size(); i++)
+        {
+            const char p = i < previous.size() ? previous[i] : ' ';
+            const char c = i < current.size() ? current[i] : ' ';
+            if (c != p)
+                {
+                    diff[i] = (c == ' ') ? '&' : c;
+                }
+        }
+    return rtrim(diff);
+}
+
+
+std::string Compact_Rinex_Encoder::rtrim(const std::string& s) const
+{
+    const auto last = s.find_last_not_of(' ');
+    if (last == std::string::npos)
+        {
+            return std::string();
+        }
+    return s.substr(0, last + 1);
+}
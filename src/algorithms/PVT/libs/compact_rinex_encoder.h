@@ -0,0 +1,99 @@
+/*!
+ * \file compact_rinex_encoder.h
+ * \brief Interface of a class that converts RINEX 3 observation text into
+ * Compact RINEX (Hatanaka) format.
+ * See Y. Hatanaka, "A Compression Format and Tools for GNSS Observation
+ * Data", Bulletin of the Geographical Survey Institute, 55, 21-30, 2008.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_COMPACT_RINEX_ENCODER_H
+#define GNSS_SDR_COMPACT_RINEX_ENCODER_H
+
+#include <array>    // for std::array
+#include <cstdint>  // for int64_t
+#include <map>      // for std::map
+#include <string>   // for std::string
+#include <vector>   // for std::vector
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Converts RINEX 3 observation text into Compact RINEX 3.0 text.
+ *
+ * The encoder is fed with the text that would otherwise be written to the
+ * RINEX observation file, in chunks of any size. It keeps the differencing
+ * state of the epoch line, of the receiver clock offset and of each
+ * observable of each satellite, so its output is a continuous Compact RINEX
+ * stream that can be expanded back with the standard CRX2RNX tool.
+ */
+class Compact_Rinex_Encoder
+{
+public:
+    Compact_Rinex_Encoder() = default;
+
+    /*!
+     * \brief Encodes a chunk of RINEX 3 observation text. Incomplete lines
+     * at the end of the chunk are kept until the next call.
+     */
+    std::string encode(const std::string& rinex_text);
+
+    /*!
+     * \brief Forgets the differencing state, so that the next epoch is
+     * written in full.
+     */
+    void reset();
+
+private:
+    static const int ARC_ORDER = 3;  // Maximum order of the differences
+
+    struct Arc
+    {
+        std::array<int64_t, ARC_ORDER + 1> u{};
+        int order{-1};  // -1: no previous value
+    };
+
+    struct Satellite_State
+    {
+        std::vector<Arc> arcs;
+        std::string flags;
+    };
+
+    void encode_line(const std::string& line, std::string& out);
+    void encode_epoch(std::string& out);
+    void encode_header_line(const std::string& line, std::string& out);
+    std::string take_diff(Arc& arc, const std::string& field) const;
+    std::string text_diff(const std::string& previous, const std::string& current) const;
+    std::string rtrim(const std::string& s) const;
+
+    std::map<char, int> d_num_obs_types;  // number of observation types per system
+    std::map<std::string, Satellite_State> d_satellites;
+    std::vector<std::string> d_records;
+    std::string d_partial_line;
+    std::string d_epoch_line;
+    std::string d_previous_epoch;
+    Arc d_clock;
+    int d_pending_lines{0};
+    bool d_header_started{false};
+    bool d_in_header{true};
+    bool d_in_event{false};
+    bool d_epoch_reset{true};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_COMPACT_RINEX_ENCODER_H
@@ -0,0 +1,120 @@
+/*!
+ * \file compressed_file_writer.cc
+ * \brief Implementation of a class that writes text to a file, optionally
+ * gzip-compressed, from a background thread.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "compressed_file_writer.h"
+#include <glog/logging.h>
+#include <fstream>       // for std::ofstream
+#include <system_error>  // for std::system_error
+#if HAS_ZLIB
+#include <zlib.h>
+#endif
+
+
+Compressed_File_Writer::Compressed_File_Writer(const std::string& filename, bool gzip) : d_filename(filename),
+                                                                                          d_gzip(gzip)
+{
+    if (d_gzip and !Compressed_File_Writer::gzip_available())
+        {
+            LOG(WARNING) << "GNSS-SDR was built without zlib, " << d_filename << " will not be compressed";
+            d_gzip = false;
+        }
+    d_thread = std::thread(&Compressed_File_Writer::run, this);
+}
+
+
+Compressed_File_Writer::~Compressed_File_Writer()
+{
+    d_stop = true;
+    d_queue.push(std::string());  // wake up the writer thread
+    try
+        {
+            if (d_thread.joinable())
+                {
+                    d_thread.join();
+                }
+        }
+    catch (const std::system_error& e)
+        {
+            LOG(WARNING) << "Error joining the writer thread of " << d_filename << ": " << e.what();
+        }
+}
+
+
+void Compressed_File_Writer::write(const std::string& data)
+{
+    if (!data.empty())
+        {
+            d_bytes_written += data.size();
+            d_queue.push(data);
+        }
+}
+
+
+bool Compressed_File_Writer::gzip_available()
+{
+#if HAS_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+void Compressed_File_Writer::run()
+{
+    std::string chunk;
+#if HAS_ZLIB
+    if (d_gzip)
+        {
+            gzFile gz = gzopen(d_filename.c_str(), "wb");
+            if (gz == nullptr)
+                {
+                    LOG(WARNING) << "Cannot open " << d_filename << " for writing";
+                }
+            while (true)
+                {
+                    d_queue.wait_and_pop(chunk);
+                    if (chunk.empty() and d_stop)
+                        {
+                            break;
+                        }
+                    if (gz != nullptr and gzwrite(gz, chunk.data(), static_cast<unsigned>(chunk.size())) == 0)
+                        {
+                            LOG(WARNING) << "Error writing to " << d_filename;
+                        }
+                }
+            if (gz != nullptr)
+                {
+                    gzclose(gz);
+                }
+            return;
+        }
+#endif
+    std::ofstream file(d_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        {
+            LOG(WARNING) << "Cannot open " << d_filename << " for writing";
+        }
+    while (true)
+        {
+            d_queue.wait_and_pop(chunk);
+            if (chunk.empty() and d_stop)
+                {
+                    break;
+                }
+            file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        }
+}
@@ -0,0 +1,76 @@
+/*!
+ * \file compressed_file_writer.h
+ * \brief Interface of a class that writes text to a file, optionally
+ * gzip-compressed, from a background thread.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_COMPRESSED_FILE_WRITER_H
+#define GNSS_SDR_COMPRESSED_FILE_WRITER_H
+
+#include "concurrent_queue.h"
+#include <atomic>   // for std::atomic
+#include <cstdint>  // for uint64_t
+#include <string>   // for std::string
+#include <thread>   // for std::thread
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Writes chunks of text to a file from a background thread, so that
+ * the caller never waits for the disk or for the compressor. If gzip is
+ * requested and GNSS-SDR was built with zlib, the file is written as a
+ * gzip stream.
+ */
+class Compressed_File_Writer
+{
+public:
+    Compressed_File_Writer(const std::string& filename, bool gzip);
+    ~Compressed_File_Writer();
+
+    /*!
+     * \brief Queues a chunk of text to be written. Empty chunks are ignored.
+     */
+    void write(const std::string& data);
+
+    /*!
+     * \brief Number of (uncompressed) bytes queued so far.
+     */
+    inline uint64_t bytes_written() const
+    {
+        return d_bytes_written;
+    }
+
+    /*!
+     * \brief Returns true if gzip compression is available in this build.
+     */
+    static bool gzip_available();
+
+private:
+    void run();
+
+    Concurrent_Queue<std::string> d_queue;
+    std::thread d_thread;
+    std::string d_filename;
+    std::atomic<bool> d_stop{false};
+    uint64_t d_bytes_written{0};
+    bool d_gzip;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_COMPRESSED_FILE_WRITER_H
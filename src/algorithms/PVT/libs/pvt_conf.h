@@ -65,6 +65,10 @@ public:
     int udp_port = 0;
     int udp_eph_port = 0;
     int rtk_trace_level = 0;
+    int32_t rtcm_server_threads = 1;
+    int32_t rtcm_server_max_backlog = 256;
+    int32_t rtcm_server_backlog_policy = 0;  // 0: drop oldest, 1: drop newest, 2: disconnect
+    int32_t vtl_update_period_ms = 20;
 
     uint16_t rtcm_tcp_port = 0;
     uint16_t rtcm_station_id = 0;
@@ -74,6 +78,8 @@ public:
     bool flag_rtcm_tty_port = false;
     bool output_enabled = true;
     bool rinex_output_enabled = true;
+    bool rinex_compact = false;
+    bool rinex_gzip = false;
     bool gpx_output_enabled = true;
     bool geojson_output_enabled = true;
     bool nmea_output_file_enabled = true;
@@ -90,6 +96,8 @@ public:
     bool dump = false;
     bool dump_mat = true;
     bool log_source_timetag;
+    bool vector_tracking = false;
+    double vtl_accel_sd_m_s2 = 2.0;
     std::string log_source_timetag_file;
 };
 
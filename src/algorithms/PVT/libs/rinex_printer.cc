@@ -23,6 +23,8 @@
 #include "beidou_dnav_ephemeris.h"
 #include "beidou_dnav_iono.h"
 #include "beidou_dnav_utc_model.h"
+#include "compact_rinex_encoder.h"
+#include "compressed_file_writer.h"
 #include "galileo_ephemeris.h"
 #include "galileo_iono.h"
 #include "galileo_utc_model.h"
@@ -30,6 +32,7 @@
 #include "glonass_gnav_ephemeris.h"
 #include "glonass_gnav_utc_model.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_make_unique.h"
 #include "gnss_synchro.h"
 #include "gps_cnav_ephemeris.h"
 #include "gps_cnav_iono.h"
@@ -46,6 +49,7 @@
 #include <algorithm>  // for min and max
 #include <array>
 #include <cmath>  // for floor
+#include <cstddef>
 #include <exception>
 #include <iostream>  // for cout
 #include <iterator>
@@ -56,13 +60,20 @@
 #include <vector>
 
 
+// Size of the output buffer of the RINEX observation file stream, in bytes
+constexpr std::size_t RINEX_OBS_FILE_BUFFER_SIZE = 1024 * 1024;
+
+
 Rinex_Printer::Rinex_Printer(int32_t conf_version,
     const std::string& base_path,
-    const std::string& base_name) : d_fake_cnav_iode(1),
-                                    d_numberTypesObservations(4),
-                                    d_rinex_header_updated(false),
-                                    d_rinex_header_written(false),
-                                    d_pre_2009_file(false)
+    const std::string& base_name,
+    bool compact,
+    bool gzip) : d_obs_header_patch_pos(-1),
+                 d_fake_cnav_iode(1),
+                 d_numberTypesObservations(4),
+                 d_rinex_header_updated(false),
+                 d_rinex_header_written(false),
+                 d_pre_2009_file(false)
 
 {
     // RINEX v3.02 codes
@@ -180,7 +191,21 @@ Rinex_Printer::Rinex_Printer(int32_t conf_version,
         }
 
     navfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GPS_NAV", base_name);
-    obsfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_OBS", base_name);
+    if (compact and conf_version == 2)
+        {
+            std::cout << "Compact RINEX output is only available for RINEX 3, writing uncompacted observations.\n";
+            compact = false;
+        }
+    if (gzip and !Compressed_File_Writer::gzip_available())
+        {
+            std::cout << "GNSS-SDR was built without zlib, writing uncompressed RINEX observations.\n";
+            gzip = false;
+        }
+    obsfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename(compact ? "RINEX_FILE_TYPE_COMPACT_OBS" : "RINEX_FILE_TYPE_OBS", base_name);
+    if (gzip)
+        {
+            obsfilename += ".gz";
+        }
     sbsfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_SBAS", base_name);
     navGalfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GAL_NAV", base_name);
     navMixfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_MIXED_NAV", base_name);
@@ -188,14 +213,30 @@ Rinex_Printer::Rinex_Printer(int32_t conf_version,
     navBdsfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_BDS_NAV", base_name);
 
     Rinex_Printer::navFile.open(navfilename, std::ios::out | std::ios::in | std::ios::app);
-    Rinex_Printer::obsFile.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
+    if (compact or gzip)
+        {
+            // Compact RINEX and/or gzip, encoded and written by a background thread
+            if (compact)
+                {
+                    d_crx_encoder = std::make_unique<Compact_Rinex_Encoder>();
+                }
+            d_obs_writer = std::make_unique<Compressed_File_Writer>(obsfilename, gzip);
+        }
+    else
+        {
+            // Large output buffer for the observation file, set before opening it. The file is not
+            // opened in append mode so that update_obs_header() can patch the header in place.
+            d_obs_file_buffer.resize(RINEX_OBS_FILE_BUFFER_SIZE);
+            Rinex_Printer::obsFile.rdbuf()->pubsetbuf(d_obs_file_buffer.data(), static_cast<std::streamsize>(d_obs_file_buffer.size()));
+            Rinex_Printer::obsFile.open(obsfilename, std::ios::out | std::ios::in | std::ios::trunc);
+        }
     Rinex_Printer::sbsFile.open(sbsfilename, std::ios::out | std::ios::app);
     Rinex_Printer::navGalFile.open(navGalfilename, std::ios::out | std::ios::in | std::ios::app);
     Rinex_Printer::navMixFile.open(navMixfilename, std::ios::out | std::ios::in | std::ios::app);
     Rinex_Printer::navGloFile.open(navGlofilename, std::ios::out | std::ios::in | std::ios::app);
     Rinex_Printer::navBdsFile.open(navBdsfilename, std::ios::out | std::ios::in | std::ios::app);
 
-    if (!Rinex_Printer::navFile.is_open() or !Rinex_Printer::obsFile.is_open() or
+    if (!Rinex_Printer::navFile.is_open() or (!Rinex_Printer::obsFile.is_open() and !d_obs_writer) or
         !Rinex_Printer::sbsFile.is_open() or !Rinex_Printer::navGalFile.is_open() or
         !Rinex_Printer::navMixFile.is_open() or !Rinex_Printer::navGloFile.is_open())
         {
@@ -220,7 +261,7 @@ Rinex_Printer::~Rinex_Printer()
     DLOG(INFO) << "RINEX printer destructor called.";
     // close RINEX files
     const auto posn = navFile.tellp();
-    const auto poso = obsFile.tellp();
+    auto poso = obsFile.tellp();
     const auto poss = sbsFile.tellp();
     const auto posng = navGalFile.tellp();
     const auto posmn = navMixFile.tellp();
@@ -240,6 +281,11 @@ Rinex_Printer::~Rinex_Printer()
         {
             std::cerr << e.what() << '\n';
         }
+    if (d_obs_writer)
+        {
+            poso = static_cast<std::streamoff>(d_obs_writer->bytes_written());
+            d_obs_writer.reset();  // waits for the pending data to be written
+        }
 
     // If nothing written, erase the files.
     if (posn == 0)
@@ -308,6 +354,8 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
     std::map<int, Gps_CNAV_Ephemeris>::const_iterator gps_cnav_ephemeris_iter;
     std::map<int, Glonass_Gnav_Ephemeris>::const_iterator glonass_gnav_ephemeris_iter;
     std::map<int, Beidou_Dnav_Ephemeris>::const_iterator beidou_dnav_ephemeris_iter;
+    // Compressed observation files are built in memory and handed to the background writer
+    std::ostream& obs_out = d_obs_writer ? static_cast<std::ostream&>(d_obs_text) : static_cast<std::ostream&>(obsFile);
     if (!d_rinex_header_written)  // & we have utc data in nav message!
         {
             galileo_ephemeris_iter = pvt_solver->galileo_ephemeris_map.cbegin();
@@ -320,7 +368,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                 case 1:  // GPS L1 C/A only
                     if (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend())
                         {
-                            rinex_obs_header(obsFile, gps_ephemeris_iter->second, rx_time);
+                            rinex_obs_header(obs_out, gps_ephemeris_iter->second, rx_time);
                             rinex_nav_header(navFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second);
                             output_navfilename.push_back(navfilename);
                             log_rinex_nav(navFile, pvt_solver->gps_ephemeris_map);
@@ -331,7 +379,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend())
                         {
                             const std::string signal("2S");
-                            rinex_obs_header(obsFile, gps_cnav_ephemeris_iter->second, rx_time, signal);
+                            rinex_obs_header(obs_out, gps_cnav_ephemeris_iter->second, rx_time, signal);
                             rinex_nav_header(navFile, pvt_solver->gps_cnav_iono, pvt_solver->gps_cnav_utc_model);
                             output_navfilename.push_back(navfilename);
                             log_rinex_nav(navFile, pvt_solver->gps_cnav_ephemeris_map);
@@ -342,7 +390,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend())
                         {
                             const std::string signal("L5");
-                            rinex_obs_header(obsFile, gps_cnav_ephemeris_iter->second, rx_time, signal);
+                            rinex_obs_header(obs_out, gps_cnav_ephemeris_iter->second, rx_time, signal);
                             rinex_nav_header(navFile, pvt_solver->gps_cnav_iono, pvt_solver->gps_cnav_utc_model);
                             output_navfilename.push_back(navfilename);
                             log_rinex_nav(navFile, pvt_solver->gps_cnav_ephemeris_map);
@@ -352,7 +400,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                 case 4:  // Galileo E1B only
                     if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                         {
-                            rinex_obs_header(obsFile, galileo_ephemeris_iter->second, rx_time);
+                            rinex_obs_header(obs_out, galileo_ephemeris_iter->second, rx_time);
                             rinex_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navGalfilename);
                             log_rinex_nav(navGalFile, pvt_solver->galileo_ephemeris_map);
@@ -363,7 +411,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                         {
                             const std::string signal("5X");
-                            rinex_obs_header(obsFile, galileo_ephemeris_iter->second, rx_time, signal);
+                            rinex_obs_header(obs_out, galileo_ephemeris_iter->second, rx_time, signal);
                             rinex_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navGalfilename);
                             log_rinex_nav(navGalFile, pvt_solver->galileo_ephemeris_map);
@@ -374,7 +422,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                         {
                             const std::string signal("7X");
-                            rinex_obs_header(obsFile, galileo_ephemeris_iter->second, rx_time, signal);
+                            rinex_obs_header(obs_out, galileo_ephemeris_iter->second, rx_time, signal);
                             rinex_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navGalfilename);
                             log_rinex_nav(navGalFile, pvt_solver->galileo_ephemeris_map);
@@ -385,7 +433,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                         {
                             const std::string signal("1C 2S");
-                            rinex_obs_header(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, signal);
+                            rinex_obs_header(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, signal);
                             rinex_nav_header(navFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second);
                             output_navfilename.push_back(navfilename);
                             log_rinex_nav(navFile, pvt_solver->gps_cnav_ephemeris_map);
@@ -396,7 +444,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                         {
                             const std::string signal("1C L5");
-                            rinex_obs_header(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, signal);
+                            rinex_obs_header(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, signal);
                             rinex_nav_header(navFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second);
                             output_navfilename.push_back(navfilename);
                             log_rinex_nav(navFile, pvt_solver->gps_ephemeris_map);
@@ -407,7 +455,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()) and (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                         {
                             const std::string gal_signal("1B");
-                            rinex_obs_header(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gal_signal);
+                            rinex_obs_header(obs_out, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gal_signal);
                             rinex_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navMixfilename);
                             log_rinex_nav(navMixFile, pvt_solver->gps_ephemeris_map, pvt_solver->galileo_ephemeris_map);
@@ -418,7 +466,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()) and (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                         {
                             const std::string gal_signal("5X");
-                            rinex_obs_header(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gal_signal);
+                            rinex_obs_header(obs_out, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gal_signal);
                             rinex_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navMixfilename);
                             log_rinex_nav(navMixFile, pvt_solver->gps_ephemeris_map, pvt_solver->galileo_ephemeris_map);
@@ -429,7 +477,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()) and (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                         {
                             const std::string gal_signal("7X");
-                            rinex_obs_header(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gal_signal);
+                            rinex_obs_header(obs_out, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gal_signal);
                             rinex_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navMixfilename);
                             log_rinex_nav(navMixFile, pvt_solver->gps_ephemeris_map, pvt_solver->galileo_ephemeris_map);
@@ -441,7 +489,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         {
                             const std::string gal_signal("5X");
                             const std::string gps_signal("L5");
-                            rinex_obs_header(obsFile, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gps_signal, gal_signal);
+                            rinex_obs_header(obs_out, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gps_signal, gal_signal);
                             rinex_nav_header(navMixFile, pvt_solver->gps_cnav_iono, pvt_solver->gps_cnav_utc_model, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navMixfilename);
                             log_rinex_nav(navMixFile, pvt_solver->gps_cnav_ephemeris_map, pvt_solver->galileo_ephemeris_map);
@@ -452,7 +500,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                         {
                             const std::string gal_signal("1B 5X");
-                            rinex_obs_header(obsFile, galileo_ephemeris_iter->second, rx_time, gal_signal);
+                            rinex_obs_header(obs_out, galileo_ephemeris_iter->second, rx_time, gal_signal);
                             rinex_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navGalfilename);
                             log_rinex_nav(navGalFile, pvt_solver->galileo_ephemeris_map);
@@ -463,7 +511,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                         {
                             const std::string gal_signal("1B 7X");
-                            rinex_obs_header(obsFile, galileo_ephemeris_iter->second, rx_time, gal_signal);
+                            rinex_obs_header(obs_out, galileo_ephemeris_iter->second, rx_time, gal_signal);
                             rinex_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navGalfilename);
                             log_rinex_nav(navGalFile, pvt_solver->galileo_ephemeris_map);
@@ -474,7 +522,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if (glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend())
                         {
                             const std::string signal("1G");
-                            rinex_obs_header(obsFile, glonass_gnav_ephemeris_iter->second, rx_time, signal);
+                            rinex_obs_header(obs_out, glonass_gnav_ephemeris_iter->second, rx_time, signal);
                             rinex_nav_header(navGloFile, pvt_solver->glonass_gnav_utc_model, glonass_gnav_ephemeris_iter->second);
                             output_navfilename.push_back(navGlofilename);
                             log_rinex_nav(navGloFile, pvt_solver->glonass_gnav_ephemeris_map);
@@ -485,7 +533,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if (glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend())
                         {
                             const std::string signal("2G");
-                            rinex_obs_header(obsFile, glonass_gnav_ephemeris_iter->second, rx_time, signal);
+                            rinex_obs_header(obs_out, glonass_gnav_ephemeris_iter->second, rx_time, signal);
                             rinex_nav_header(navGloFile, pvt_solver->glonass_gnav_utc_model, glonass_gnav_ephemeris_iter->second);
                             output_navfilename.push_back(navGlofilename);
                             log_rinex_nav(navGloFile, pvt_solver->glonass_gnav_ephemeris_map);
@@ -496,7 +544,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if (glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend())
                         {
                             const std::string signal("1G 2G");
-                            rinex_obs_header(obsFile, glonass_gnav_ephemeris_iter->second, rx_time, signal);
+                            rinex_obs_header(obs_out, glonass_gnav_ephemeris_iter->second, rx_time, signal);
                             rinex_nav_header(navGloFile, pvt_solver->glonass_gnav_utc_model, glonass_gnav_ephemeris_iter->second);
                             output_navfilename.push_back(navGlofilename);
                             log_rinex_nav(navGloFile, pvt_solver->glonass_gnav_ephemeris_map);
@@ -507,7 +555,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                         {
                             const std::string glo_signal("1G");
-                            rinex_obs_header(obsFile, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, glo_signal);
+                            rinex_obs_header(obs_out, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, glo_signal);
                             if (d_version == 3)
                                 {
                                     rinex_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
@@ -531,7 +579,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         {
                             const std::string glo_signal("1G");
                             const std::string gal_signal("1B");
-                            rinex_obs_header(obsFile, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, glo_signal, gal_signal);
+                            rinex_obs_header(obs_out, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, glo_signal, gal_signal);
                             rinex_nav_header(navMixFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
                             output_navfilename.push_back(navMixfilename);
                             log_rinex_nav(navMixFile, pvt_solver->galileo_ephemeris_map, pvt_solver->glonass_gnav_ephemeris_map);
@@ -542,7 +590,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                         {
                             const std::string glo_signal("1G");
-                            rinex_obs_header(obsFile, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, glo_signal);
+                            rinex_obs_header(obs_out, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, glo_signal);
                             rinex_nav_header(navMixFile, pvt_solver->gps_cnav_iono, pvt_solver->gps_cnav_utc_model, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
                             output_navfilename.push_back(navfilename);
                             log_rinex_nav(navMixFile, pvt_solver->gps_cnav_ephemeris_map, pvt_solver->glonass_gnav_ephemeris_map);
@@ -553,7 +601,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                         {
                             const std::string glo_signal("2G");
-                            rinex_obs_header(obsFile, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, glo_signal);
+                            rinex_obs_header(obs_out, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, glo_signal);
                             if (d_version == 3)
                                 {
                                     rinex_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
@@ -577,7 +625,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         {
                             const std::string glo_signal("2G");
                             const std::string gal_signal("1B");
-                            rinex_obs_header(obsFile, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, glo_signal, gal_signal);
+                            rinex_obs_header(obs_out, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, glo_signal, gal_signal);
                             rinex_nav_header(navMixFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
                             output_navfilename.push_back(navMixfilename);
                             log_rinex_nav(navMixFile, pvt_solver->galileo_ephemeris_map, pvt_solver->glonass_gnav_ephemeris_map);
@@ -588,7 +636,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                         {
                             const std::string glo_signal("2G");
-                            rinex_obs_header(obsFile, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, glo_signal);
+                            rinex_obs_header(obs_out, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, glo_signal);
                             rinex_nav_header(navMixFile, pvt_solver->gps_cnav_iono, pvt_solver->gps_cnav_utc_model, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
                             output_navfilename.push_back(navfilename);
                             log_rinex_nav(navMixFile, pvt_solver->gps_cnav_ephemeris_map, pvt_solver->glonass_gnav_ephemeris_map);
@@ -602,7 +650,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         {
                             const std::string gal_signal("1B 5X");
                             const std::string gps_signal("1C L5");
-                            rinex_obs_header(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gps_signal, gal_signal);
+                            rinex_obs_header(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gps_signal, gal_signal);
                             rinex_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navMixfilename);
                             log_rinex_nav(navMixFile, pvt_solver->gps_ephemeris_map, pvt_solver->galileo_ephemeris_map);
@@ -614,7 +662,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                         {
                             const std::string gal_signal("1B 5X");
-                            rinex_obs_header(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gal_signal);
+                            rinex_obs_header(obs_out, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gal_signal);
                             rinex_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navMixfilename);
                             log_rinex_nav(navMixFile, pvt_solver->gps_ephemeris_map, pvt_solver->galileo_ephemeris_map);
@@ -624,7 +672,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                 case 101:  // Galileo E1B + Galileo E6B
                     if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                         {
-                            rinex_obs_header(obsFile, galileo_ephemeris_iter->second, rx_time);
+                            rinex_obs_header(obs_out, galileo_ephemeris_iter->second, rx_time);
                             rinex_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navGalfilename);
                             log_rinex_nav(navGalFile, pvt_solver->galileo_ephemeris_map);
@@ -635,7 +683,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                         {
                             const std::string signal("5X");
-                            rinex_obs_header(obsFile, galileo_ephemeris_iter->second, rx_time, signal);
+                            rinex_obs_header(obs_out, galileo_ephemeris_iter->second, rx_time, signal);
                             rinex_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navGalfilename);
                             log_rinex_nav(navGalFile, pvt_solver->galileo_ephemeris_map);
@@ -646,7 +694,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                         {
                             const std::string signal("7X");
-                            rinex_obs_header(obsFile, galileo_ephemeris_iter->second, rx_time, signal);
+                            rinex_obs_header(obs_out, galileo_ephemeris_iter->second, rx_time, signal);
                             rinex_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navGalfilename);
                             log_rinex_nav(navGalFile, pvt_solver->galileo_ephemeris_map);
@@ -657,7 +705,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                         {
                             const std::string gal_signal("1B 5X");
-                            rinex_obs_header(obsFile, galileo_ephemeris_iter->second, rx_time, gal_signal);
+                            rinex_obs_header(obs_out, galileo_ephemeris_iter->second, rx_time, gal_signal);
                             rinex_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navGalfilename);
                             log_rinex_nav(navGalFile, pvt_solver->galileo_ephemeris_map);
@@ -668,7 +716,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                         {
                             const std::string gal_signal("1B 7X");
-                            rinex_obs_header(obsFile, galileo_ephemeris_iter->second, rx_time, gal_signal);
+                            rinex_obs_header(obs_out, galileo_ephemeris_iter->second, rx_time, gal_signal);
                             rinex_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navGalfilename);
                             log_rinex_nav(navGalFile, pvt_solver->galileo_ephemeris_map);
@@ -679,7 +727,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()) and (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                         {
                             const std::string gal_signal("1B");
-                            rinex_obs_header(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gal_signal);
+                            rinex_obs_header(obs_out, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gal_signal);
                             rinex_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navMixfilename);
                             log_rinex_nav(navMixFile, pvt_solver->gps_ephemeris_map, pvt_solver->galileo_ephemeris_map);
@@ -689,7 +737,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                 case 500:  // BDS B1I only
                     if (beidou_dnav_ephemeris_iter != pvt_solver->beidou_dnav_ephemeris_map.cend())
                         {
-                            rinex_obs_header(obsFile, beidou_dnav_ephemeris_iter->second, rx_time, "B1");
+                            rinex_obs_header(obs_out, beidou_dnav_ephemeris_iter->second, rx_time, "B1");
                             rinex_nav_header(navFile, pvt_solver->beidou_dnav_iono, pvt_solver->beidou_dnav_utc_model);
                             output_navfilename.push_back(navfilename);
                             log_rinex_nav(navFile, pvt_solver->beidou_dnav_ephemeris_map);
@@ -701,7 +749,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                     if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and (beidou_dnav_ephemeris_iter != pvt_solver->beidou_dnav_ephemeris_map.cend()))
                         {
                             const std::string bds_signal("B1");
-                            // rinex_obs_header(obsFile, gps_ephemeris_iter->second, beidou_dnav_ephemeris_iter->second, rx_time, bds_signal);
+                            // rinex_obs_header(obs_out, gps_ephemeris_iter->second, beidou_dnav_ephemeris_iter->second, rx_time, bds_signal);
                             // rinex_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->beidou_dnav_iono, pvt_solver->beidou_dnav_utc_model);
                             d_rinex_header_written = true;  // do not write header anymore
                         }
@@ -712,7 +760,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         {
                             const std::string bds_signal("B1");
                             const std::string gal_signal("1B");
-                            // rinex_obs_header(obsFile, galileo_ephemeris_iter->second, beidou_dnav_ephemeris_iter->second, rx_time, gal_signal, bds_signal);
+                            // rinex_obs_header(obs_out, galileo_ephemeris_iter->second, beidou_dnav_ephemeris_iter->second, rx_time, gal_signal, bds_signal);
                             // rinex_nav_header(navMixFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model, pvt_solver->beidou_dnav_iono, pvt_solver->beidou_dnav_utc_model);
                             d_rinex_header_written = true;  // do not write header anymore
                         }
@@ -724,7 +772,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                 case 506:  // BeiDou B1I + Beidou B3I
                     if (beidou_dnav_ephemeris_iter != pvt_solver->beidou_dnav_ephemeris_map.cend())
                         {
-                            // rinex_obs_header(obsFile, beidou_dnav_ephemeris_iter->second, rx_time, "B1");
+                            // rinex_obs_header(obs_out, beidou_dnav_ephemeris_iter->second, rx_time, "B1");
                             // rinex_nav_header(navFile, pvt_solver->beidou_dnav_iono, pvt_solver->beidou_dnav_utc_model);
                             // log_rinex_nav(navFile, pvt_solver->beidou_dnav_ephemeris_map);
                             d_rinex_header_written = true;  // do not write header anymore
@@ -734,7 +782,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                 case 600:  // BDS B3I only
                     if (beidou_dnav_ephemeris_iter != pvt_solver->beidou_dnav_ephemeris_map.cend())
                         {
-                            rinex_obs_header(obsFile, beidou_dnav_ephemeris_iter->second, rx_time, "B3");
+                            rinex_obs_header(obs_out, beidou_dnav_ephemeris_iter->second, rx_time, "B3");
                             rinex_nav_header(navFile, pvt_solver->beidou_dnav_iono, pvt_solver->beidou_dnav_utc_model);
                             output_navfilename.push_back(navfilename);
                             log_rinex_nav(navFile, pvt_solver->beidou_dnav_ephemeris_map);
@@ -747,7 +795,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                 case 603:  // BeiDou B3I + GPS L2C + GLONASS L2 C/A
                     if (beidou_dnav_ephemeris_iter != pvt_solver->beidou_dnav_ephemeris_map.cend())
                         {
-                            rinex_obs_header(obsFile, beidou_dnav_ephemeris_iter->second, rx_time, "B3");
+                            rinex_obs_header(obs_out, beidou_dnav_ephemeris_iter->second, rx_time, "B3");
                             // rinex_nav_header(navFile, pvt_solver->beidou_dnav_iono, pvt_solver->beidou_dnav_utc_model);
                             d_rinex_header_written = true;  // do not write header anymore
                         }
@@ -758,7 +806,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                         {
                             const std::string gps_signal("1C 2S L5");
-                            rinex_obs_header(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gps_signal);
+                            rinex_obs_header(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gps_signal);
                             rinex_nav_header(navFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second);
                             output_navfilename.push_back(navfilename);
                             log_rinex_nav(navFile, pvt_solver->gps_ephemeris_map);
@@ -772,7 +820,7 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         {
                             const std::string gal_signal("1B 5X");
                             const std::string gps_signal("1C 2S L5");
-                            rinex_obs_header(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gps_signal, gal_signal);
+                            rinex_obs_header(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gps_signal, gal_signal);
                             rinex_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                             output_navfilename.push_back(navMixfilename);
                             log_rinex_nav(navMixFile, pvt_solver->gps_ephemeris_map, pvt_solver->galileo_ephemeris_map);
@@ -799,10 +847,10 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 1:  // GPS L1 C/A only
                             if (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0))
                                         {
-                                            update_obs_header(obsFile, pvt_solver->gps_utc_model);
+                                            update_obs_header(obs_out, pvt_solver->gps_utc_model);
                                             update_nav_header(navFile, pvt_solver->gps_utc_model, pvt_solver->gps_iono, gps_ephemeris_iter->second);
                                             d_rinex_header_updated = true;
                                         }
@@ -812,11 +860,11 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 3:  // GPS L5
                             if (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->gps_cnav_utc_model.A0 != 0))
                                 {
-                                    update_obs_header(obsFile, pvt_solver->gps_cnav_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->gps_cnav_utc_model);
                                     update_nav_header(navFile, pvt_solver->gps_cnav_utc_model, pvt_solver->gps_cnav_iono);
                                     d_rinex_header_updated = true;
                                 }
@@ -824,46 +872,46 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 4:  // Galileo E1B only
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
                                     update_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
-                                    update_obs_header(obsFile, pvt_solver->galileo_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->galileo_utc_model);
                                     d_rinex_header_updated = true;
                                 }
                             break;
                         case 5:  // Galileo E5a only
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
                                     update_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
-                                    update_obs_header(obsFile, pvt_solver->galileo_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->galileo_utc_model);
                                     d_rinex_header_updated = true;
                                 }
                             break;
                         case 6:  // Galileo E5b only
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "7X");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "7X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
                                     update_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
-                                    update_obs_header(obsFile, pvt_solver->galileo_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->galileo_utc_model);
                                     d_rinex_header_updated = true;
                                 }
                             break;
                         case 7:  // GPS L1 C/A + GPS L2C
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0))
                                         {
-                                            update_obs_header(obsFile, pvt_solver->gps_utc_model);
+                                            update_obs_header(obs_out, pvt_solver->gps_utc_model);
                                             update_nav_header(navFile, pvt_solver->gps_utc_model, pvt_solver->gps_iono, gps_ephemeris_iter->second);
                                             d_rinex_header_updated = true;
                                         }
@@ -872,17 +920,17 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 8:  // L1+L5
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and ((pvt_solver->gps_cnav_utc_model.A0 != 0) or (pvt_solver->gps_utc_model.A0 != 0)))
                                         {
                                             if (pvt_solver->gps_cnav_utc_model.A0 != 0)
                                                 {
-                                                    update_obs_header(obsFile, pvt_solver->gps_cnav_utc_model);
+                                                    update_obs_header(obs_out, pvt_solver->gps_cnav_utc_model);
                                                     update_nav_header(navFile, pvt_solver->gps_cnav_utc_model, pvt_solver->gps_cnav_iono);
                                                 }
                                             else
                                                 {
-                                                    update_obs_header(obsFile, pvt_solver->gps_utc_model);
+                                                    update_obs_header(obs_out, pvt_solver->gps_utc_model);
                                                     update_nav_header(navFile, pvt_solver->gps_utc_model, pvt_solver->gps_iono, gps_ephemeris_iter->second);
                                                 }
                                             d_rinex_header_updated = true;
@@ -892,10 +940,10 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 9:  // GPS L1 C/A + Galileo E1B
                             if ((galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()) and (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0))
                                         {
-                                            update_obs_header(obsFile, pvt_solver->gps_utc_model);
+                                            update_obs_header(obs_out, pvt_solver->gps_utc_model);
                                             update_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                                             d_rinex_header_updated = true;
                                         }
@@ -904,11 +952,11 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 13:  // L5+E5a
                             if ((gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()) and (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->gps_cnav_utc_model.A0 != 0) and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
-                                    update_obs_header(obsFile, pvt_solver->gps_cnav_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->gps_cnav_utc_model);
                                     update_nav_header(navMixFile, pvt_solver->gps_cnav_utc_model, pvt_solver->gps_cnav_iono, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                                     d_rinex_header_updated = true;  // do not write header anymore
                                 }
@@ -916,70 +964,70 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 14:  // Galileo E1B + Galileo E5a
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 5X");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 5X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
                                     update_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
-                                    update_obs_header(obsFile, pvt_solver->galileo_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->galileo_utc_model);
                                     d_rinex_header_updated = true;
                                 }
                             break;
                         case 15:  // Galileo E1B + Galileo E5b
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 7X");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 7X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
                                     update_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
-                                    update_obs_header(obsFile, pvt_solver->galileo_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->galileo_utc_model);
                                     d_rinex_header_updated = true;
                                 }
                             break;
                         case 23:  // GLONASS L1 C/A only
                             if (glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "1C");
+                                    log_rinex_obs(obs_out, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "1C");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->glonass_gnav_utc_model.d_tau_c != 0))
                                 {
                                     update_nav_header(navGloFile, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
-                                    update_obs_header(obsFile, pvt_solver->glonass_gnav_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->glonass_gnav_utc_model);
                                     d_rinex_header_updated = true;
                                 }
                             break;
                         case 24:  // GLONASS L2 C/A only
                             if (glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "2C");
+                                    log_rinex_obs(obs_out, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "2C");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->glonass_gnav_utc_model.d_tau_c != 0))
                                 {
                                     update_nav_header(navGloFile, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
-                                    update_obs_header(obsFile, pvt_solver->glonass_gnav_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->glonass_gnav_utc_model);
                                     d_rinex_header_updated = true;
                                 }
                             break;
                         case 25:  // GLONASS L1 C/A + GLONASS L2 C/A
                             if (glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "1C 2C");
+                                    log_rinex_obs(obs_out, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map, "1C 2C");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->glonass_gnav_utc_model.d_tau_c != 0))
                                 {
                                     update_nav_header(navMixFile, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
-                                    update_obs_header(obsFile, pvt_solver->glonass_gnav_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->glonass_gnav_utc_model);
                                     d_rinex_header_updated = true;
                                 }
                             break;
                         case 26:  // GPS L1 C/A + GLONASS L1 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0))
                                         {
-                                            update_obs_header(obsFile, pvt_solver->gps_utc_model);
+                                            update_obs_header(obs_out, pvt_solver->gps_utc_model);
                                             update_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
                                             d_rinex_header_updated = true;  // do not write header anymore
                                         }
@@ -988,11 +1036,11 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 27:  // Galileo E1B + GLONASS L1 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
-                                    update_obs_header(obsFile, pvt_solver->galileo_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->galileo_utc_model);
                                     update_nav_header(navMixFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
                                     d_rinex_header_updated = true;  // do not write header anymore
                                 }
@@ -1000,11 +1048,11 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 28:  // GPS L2C + GLONASS L1 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->gps_cnav_utc_model.A0 != 0))
                                 {
-                                    update_obs_header(obsFile, pvt_solver->gps_cnav_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->gps_cnav_utc_model);
                                     update_nav_header(navMixFile, pvt_solver->gps_cnav_iono, pvt_solver->gps_cnav_utc_model, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
                                     d_rinex_header_updated = true;  // do not write header anymore
                                 }
@@ -1012,10 +1060,10 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 29:  // GPS L1 C/A + GLONASS L2 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0))
                                         {
-                                            update_obs_header(obsFile, pvt_solver->gps_utc_model);
+                                            update_obs_header(obs_out, pvt_solver->gps_utc_model);
                                             update_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
                                             d_rinex_header_updated = true;  // do not write header anymore
                                         }
@@ -1024,11 +1072,11 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 30:  // Galileo E1B + GLONASS L2 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
-                                    update_obs_header(obsFile, pvt_solver->galileo_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->galileo_utc_model);
                                     update_nav_header(navMixFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
                                     d_rinex_header_updated = true;  // do not write header anymore
                                 }
@@ -1036,11 +1084,11 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 31:  // GPS L2C + GLONASS L2 C/A
                             if ((glonass_gnav_ephemeris_iter != pvt_solver->glonass_gnav_ephemeris_map.cend()) and (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_cnav_ephemeris_iter->second, glonass_gnav_ephemeris_iter->second, rx_time, gnss_observables_map);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->gps_cnav_utc_model.A0 != 0))
                                 {
-                                    update_obs_header(obsFile, pvt_solver->gps_cnav_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->gps_cnav_utc_model);
                                     update_nav_header(navMixFile, pvt_solver->gps_cnav_iono, pvt_solver->gps_cnav_utc_model, pvt_solver->glonass_gnav_utc_model, pvt_solver->glonass_gnav_almanac);
                                     d_rinex_header_updated = true;  // do not write header anymore
                                 }
@@ -1048,17 +1096,17 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 32:  // L1+E1+L5+E5a
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()) and (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and ((pvt_solver->gps_cnav_utc_model.A0 != 0) or (pvt_solver->gps_utc_model.A0 != 0)) and (pvt_solver->galileo_utc_model.A0 != 0))
                                         {
                                             if (pvt_solver->gps_cnav_utc_model.A0 != 0)
                                                 {
-                                                    update_obs_header(obsFile, pvt_solver->gps_cnav_utc_model);
+                                                    update_obs_header(obs_out, pvt_solver->gps_cnav_utc_model);
                                                     update_nav_header(navMixFile, pvt_solver->gps_cnav_utc_model, pvt_solver->gps_cnav_iono, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                                                 }
                                             else
                                                 {
-                                                    update_obs_header(obsFile, pvt_solver->gps_utc_model);
+                                                    update_obs_header(obs_out, pvt_solver->gps_utc_model);
                                                     update_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                                                 }
                                             d_rinex_header_updated = true;  // do not write header anymore
@@ -1068,10 +1116,10 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 33:  // L1+E1+E5a
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0) and (pvt_solver->galileo_utc_model.A0 != 0))
                                         {
-                                            update_obs_header(obsFile, pvt_solver->gps_utc_model);
+                                            update_obs_header(obs_out, pvt_solver->gps_utc_model);
                                             update_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                                             d_rinex_header_updated = true;  // do not write header anymore
                                         }
@@ -1080,70 +1128,70 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 101:  // Galileo E1B + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
                                     update_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
-                                    update_obs_header(obsFile, pvt_solver->galileo_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->galileo_utc_model);
                                     d_rinex_header_updated = true;
                                 }
                             break;
                         case 102:  // Galileo E5a + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
                                     update_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
-                                    update_obs_header(obsFile, pvt_solver->galileo_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->galileo_utc_model);
                                     d_rinex_header_updated = true;
                                 }
                             break;
                         case 103:  // Galileo E5b + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "5X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
                                     update_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
-                                    update_obs_header(obsFile, pvt_solver->galileo_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->galileo_utc_model);
                                     d_rinex_header_updated = true;
                                 }
                             break;
                         case 104:  // Galileo E1B + Galileo E5a + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 5X");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 5X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
                                     update_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
-                                    update_obs_header(obsFile, pvt_solver->galileo_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->galileo_utc_model);
                                     d_rinex_header_updated = true;
                                 }
                             break;
                         case 105:  // Galileo E1B + Galileo E5b + Galileo E6B
                             if (galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 7X");
+                                    log_rinex_obs(obs_out, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, "1B 7X");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
                                     update_nav_header(navGalFile, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
-                                    update_obs_header(obsFile, pvt_solver->galileo_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->galileo_utc_model);
                                     d_rinex_header_updated = true;
                                 }
                             break;
                         case 106:  // GPS L1 C/A + Galileo E1B + Galileo E6B
                             if ((galileo_ephemeris_iter != pvt_solver->galileo_ephemeris_map.cend()) and (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map);
                                     if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0))
                                         {
-                                            update_obs_header(obsFile, pvt_solver->gps_utc_model);
+                                            update_obs_header(obs_out, pvt_solver->gps_utc_model);
                                             update_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                                             d_rinex_header_updated = true;
                                         }
@@ -1152,11 +1200,11 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 500:  // BDS B1I only
                             if (beidou_dnav_ephemeris_iter != pvt_solver->beidou_dnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, beidou_dnav_ephemeris_iter->second, rx_time, gnss_observables_map, "B1");
+                                    log_rinex_obs(obs_out, beidou_dnav_ephemeris_iter->second, rx_time, gnss_observables_map, "B1");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->beidou_dnav_utc_model.A0_UTC != 0))
                                 {
-                                    update_obs_header(obsFile, pvt_solver->beidou_dnav_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->beidou_dnav_utc_model);
                                     update_nav_header(navFile, pvt_solver->beidou_dnav_utc_model, pvt_solver->beidou_dnav_iono);
                                     d_rinex_header_updated = true;
                                 }
@@ -1164,11 +1212,11 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         case 600:  // BDS B3I only
                             if (beidou_dnav_ephemeris_iter != pvt_solver->beidou_dnav_ephemeris_map.cend())
                                 {
-                                    log_rinex_obs(obsFile, beidou_dnav_ephemeris_iter->second, rx_time, gnss_observables_map, "B3");
+                                    log_rinex_obs(obs_out, beidou_dnav_ephemeris_iter->second, rx_time, gnss_observables_map, "B3");
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->beidou_dnav_utc_model.A0_UTC != 0))
                                 {
-                                    update_obs_header(obsFile, pvt_solver->beidou_dnav_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->beidou_dnav_utc_model);
                                     update_nav_header(navFile, pvt_solver->beidou_dnav_utc_model, pvt_solver->beidou_dnav_iono);
                                     d_rinex_header_updated = true;
                                 }
@@ -1177,11 +1225,11 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                             if ((gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and
                                 (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map, true);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, rx_time, gnss_observables_map, true);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0))
                                 {
-                                    update_obs_header(obsFile, pvt_solver->gps_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->gps_utc_model);
                                     update_nav_header(navFile, pvt_solver->gps_utc_model, pvt_solver->gps_iono, gps_ephemeris_iter->second);
                                     d_rinex_header_updated = true;
                                 }
@@ -1191,11 +1239,11 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                                 (gps_ephemeris_iter != pvt_solver->gps_ephemeris_map.cend()) and
                                 (gps_cnav_ephemeris_iter != pvt_solver->gps_cnav_ephemeris_map.cend()))
                                 {
-                                    log_rinex_obs(obsFile, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, true);
+                                    log_rinex_obs(obs_out, gps_ephemeris_iter->second, gps_cnav_ephemeris_iter->second, galileo_ephemeris_iter->second, rx_time, gnss_observables_map, true);
                                 }
                             if (!d_rinex_header_updated and (pvt_solver->gps_utc_model.A0 != 0) and (pvt_solver->galileo_utc_model.A0 != 0))
                                 {
-                                    update_obs_header(obsFile, pvt_solver->gps_utc_model);
+                                    update_obs_header(obs_out, pvt_solver->gps_utc_model);
                                     update_nav_header(navMixFile, pvt_solver->gps_iono, pvt_solver->gps_utc_model, gps_ephemeris_iter->second, pvt_solver->galileo_iono, pvt_solver->galileo_utc_model);
                                     d_rinex_header_updated = true;
                                 }
@@ -1205,6 +1253,10 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
                         }
                 }
         }
+    if (d_obs_writer)
+        {
+            Rinex_Printer::flush_obs_text();
+        }
 }
 
 
@@ -1430,17 +1482,18 @@ std::string Rinex_Printer::createFilename(const std::string& type, const std::st
     const std::string dayOfTheYearTag = strm0.str();
 
     std::map<std::string, std::string> fileType;
-    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_OBS", "O"));        // O - Observation file.
-    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_GPS_NAV", "N"));    // N - GPS navigation message file.
-    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_MET", "M"));        // M - Meteorological data file.
-    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_GLO_NAV", "G"));    // G - GLONASS navigation file.
-    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_GAL_NAV", "L"));    // L - Galileo navigation message file.
-    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_MIXED_NAV", "P"));  // P - Mixed GNSS navigation message file.
-    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_GEO_NAV", "H"));    // H - SBAS Payload navigation message file.
-    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_SBAS", "B"));       // B - SBAS broadcast data file.
-    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_CLK", "C"));        // C - Clock file.
-    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_SUMMARY", "S"));    // S - Summary file (used e.g., by IGS, not a standard!).
-    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_BDS_NAV", "F"));    // G - GLONASS navigation file.
+    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_OBS", "O"));          // O - Observation file.
+    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_COMPACT_OBS", "D"));  // D - Compact RINEX (Hatanaka) observation file.
+    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_GPS_NAV", "N"));      // N - GPS navigation message file.
+    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_MET", "M"));          // M - Meteorological data file.
+    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_GLO_NAV", "G"));      // G - GLONASS navigation file.
+    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_GAL_NAV", "L"));      // L - Galileo navigation message file.
+    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_MIXED_NAV", "P"));    // P - Mixed GNSS navigation message file.
+    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_GEO_NAV", "H"));      // H - SBAS Payload navigation message file.
+    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_SBAS", "B"));         // B - SBAS broadcast data file.
+    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_CLK", "C"));          // C - Clock file.
+    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_SUMMARY", "S"));      // S - Summary file (used e.g., by IGS, not a standard!).
+    fileType.insert(std::pair<std::string, std::string>("RINEX_FILE_TYPE_BDS_NAV", "F"));      // G - GLONASS navigation file.
 
     const boost::posix_time::ptime pt = boost::posix_time::second_clock::local_time();
     const tm pt_tm = boost::posix_time::to_tm(pt);
@@ -5916,7 +5969,7 @@ void Rinex_Printer::log_rinex_nav(std::fstream& out, const std::map<int32_t, Bei
 }
 
 
-void Rinex_Printer::rinex_obs_header(std::fstream& out, const Glonass_Gnav_Ephemeris& eph, double d_TOW_first_observation, const std::string& glonass_bands)
+void Rinex_Printer::rinex_obs_header(std::ostream& out, const Glonass_Gnav_Ephemeris& eph, double d_TOW_first_observation, const std::string& glonass_bands)
 {
     if (eph.d_m > 0.0)
         {
@@ -6253,7 +6306,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Glonass_Gnav_Ephem
 }
 
 
-void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double d_TOW_first_observation, const std::string& glonass_bands)
+void Rinex_Printer::rinex_obs_header(std::ostream& out, const Gps_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double d_TOW_first_observation, const std::string& glonass_bands)
 {
     if (glonass_gnav_eph.d_m > 0.0)
         {
@@ -6556,6 +6609,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
     line += Rinex_Printer::leftJustify("TIME OF FIRST OBS", 20);
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
+    Rinex_Printer::reserve_obs_header_line(out);
 
     // -------- GLONASS SLOT / FRQ # (On;y version 3)
     if (d_version == 3)
@@ -6613,7 +6667,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
 }
 
 
-void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris& gps_cnav_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double d_TOW_first_observation, const std::string& glonass_bands)
+void Rinex_Printer::rinex_obs_header(std::ostream& out, const Gps_CNAV_Ephemeris& gps_cnav_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double d_TOW_first_observation, const std::string& glonass_bands)
 {
     if (glonass_gnav_eph.d_m > 0.0)
         {
@@ -6884,6 +6938,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
     line += Rinex_Printer::leftJustify("TIME OF FIRST OBS", 20);
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
+    Rinex_Printer::reserve_obs_header_line(out);
 
     // -------- GLONASS SLOT / FRQ #
     // TODO Need to provide system with list of all satellites and update this accordingly
@@ -6937,7 +6992,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
 }
 
 
-void Rinex_Printer::rinex_obs_header(std::fstream& out, const Galileo_Ephemeris& galileo_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double d_TOW_first_observation, const std::string& galileo_bands, const std::string& glonass_bands)
+void Rinex_Printer::rinex_obs_header(std::ostream& out, const Galileo_Ephemeris& galileo_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double d_TOW_first_observation, const std::string& galileo_bands, const std::string& glonass_bands)
 {
     if (glonass_gnav_eph.d_m > 0.0)
         {
@@ -7251,6 +7306,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Galileo_Ephemeris&
     line += Rinex_Printer::leftJustify("TIME OF FIRST OBS", 20);
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
+    Rinex_Printer::reserve_obs_header_line(out);
 
     // -------- end of header
     line.clear();
@@ -7261,7 +7317,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Galileo_Ephemeris&
 }
 
 
-void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& eph, double d_TOW_first_observation)
+void Rinex_Printer::rinex_obs_header(std::ostream& out, const Gps_Ephemeris& eph, double d_TOW_first_observation)
 {
     std::string line;
 
@@ -7517,6 +7573,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& eph
     line += Rinex_Printer::leftJustify("TIME OF FIRST OBS", 20);
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
+    Rinex_Printer::reserve_obs_header_line(out);
 
     // -------- SYS /PHASE SHIFTS
 
@@ -7529,7 +7586,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& eph
 }
 
 
-void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris& eph, double d_TOW_first_observation, const std::string& gps_bands)
+void Rinex_Printer::rinex_obs_header(std::ostream& out, const Gps_CNAV_Ephemeris& eph, double d_TOW_first_observation, const std::string& gps_bands)
 {
     std::string line;
 
@@ -7769,6 +7826,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
     line += Rinex_Printer::leftJustify("TIME OF FIRST OBS", 20);
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
+    Rinex_Printer::reserve_obs_header_line(out);
 
     // -------- SYS /PHASE SHIFTS
 
@@ -7781,7 +7839,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
 }
 
 
-void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& eph, const Gps_CNAV_Ephemeris& eph_cnav, double d_TOW_first_observation, const std::string& gps_bands)
+void Rinex_Printer::rinex_obs_header(std::ostream& out, const Gps_Ephemeris& eph, const Gps_CNAV_Ephemeris& eph_cnav, double d_TOW_first_observation, const std::string& gps_bands)
 {
     if (eph_cnav.i_0 > 0.0)
         {
@@ -8048,6 +8106,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& eph
     line += Rinex_Printer::leftJustify("TIME OF FIRST OBS", 20);
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
+    Rinex_Printer::reserve_obs_header_line(out);
 
     // -------- SYS /PHASE SHIFTS
 
@@ -8060,7 +8119,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& eph
 }
 
 
-void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps_eph, const Gps_CNAV_Ephemeris& eph_cnav, const Galileo_Ephemeris& galileo_eph, double d_TOW_first_observation, const std::string& gps_bands, const std::string& galileo_bands)
+void Rinex_Printer::rinex_obs_header(std::ostream& out, const Gps_Ephemeris& gps_eph, const Gps_CNAV_Ephemeris& eph_cnav, const Galileo_Ephemeris& galileo_eph, double d_TOW_first_observation, const std::string& gps_bands, const std::string& galileo_bands)
 {
     std::string line;
     d_version = 3;
@@ -8405,6 +8464,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
     line += Rinex_Printer::leftJustify("TIME OF FIRST OBS", 20);
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
+    Rinex_Printer::reserve_obs_header_line(out);
 
     // -------- end of header
     line.clear();
@@ -8415,7 +8475,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
 }
 
 
-void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris& eph_cnav, const Galileo_Ephemeris& galileo_eph, double d_TOW_first_observation, const std::string& gps_bands, const std::string& galileo_bands)
+void Rinex_Printer::rinex_obs_header(std::ostream& out, const Gps_CNAV_Ephemeris& eph_cnav, const Galileo_Ephemeris& galileo_eph, double d_TOW_first_observation, const std::string& gps_bands, const std::string& galileo_bands)
 {
     std::string line;
     d_version = 3;
@@ -8730,6 +8790,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
     line += Rinex_Printer::leftJustify("TIME OF FIRST OBS", 20);
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
+    Rinex_Printer::reserve_obs_header_line(out);
 
     // -------- end of header
     line.clear();
@@ -8740,7 +8801,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
 }
 
 
-void Rinex_Printer::rinex_obs_header(std::fstream& out, const Galileo_Ephemeris& eph, double d_TOW_first_observation, const std::string& bands)
+void Rinex_Printer::rinex_obs_header(std::ostream& out, const Galileo_Ephemeris& eph, double d_TOW_first_observation, const std::string& bands)
 {
     std::string line;
     d_version = 3;
@@ -8996,6 +9057,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Galileo_Ephemeris&
     line += Rinex_Printer::leftJustify("TIME OF FIRST OBS", 20);
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
+    Rinex_Printer::reserve_obs_header_line(out);
 
     // -------- SYS /PHASE SHIFTS
 
@@ -9008,7 +9070,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Galileo_Ephemeris&
 }
 
 
-void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps_eph, const Galileo_Ephemeris& galileo_eph, double d_TOW_first_observation, const std::string& galileo_bands)
+void Rinex_Printer::rinex_obs_header(std::ostream& out, const Gps_Ephemeris& gps_eph, const Galileo_Ephemeris& galileo_eph, double d_TOW_first_observation, const std::string& galileo_bands)
 {
     if (galileo_eph.ecc > 0.0)
         {
@@ -9295,6 +9357,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
     line += Rinex_Printer::leftJustify("TIME OF FIRST OBS", 20);
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
+    Rinex_Printer::reserve_obs_header_line(out);
 
     // -------- end of header
     line.clear();
@@ -9305,7 +9368,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
 }
 
 
-void Rinex_Printer::rinex_obs_header(std::fstream& out, const Beidou_Dnav_Ephemeris& eph, double d_TOW_first_observation, const std::string& bands)
+void Rinex_Printer::rinex_obs_header(std::ostream& out, const Beidou_Dnav_Ephemeris& eph, double d_TOW_first_observation, const std::string& bands)
 {
     std::string line;
     d_version = 3;
@@ -9529,6 +9592,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Beidou_Dnav_Epheme
     line += Rinex_Printer::leftJustify("TIME OF FIRST OBS", 20);
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
+    Rinex_Printer::reserve_obs_header_line(out);
 
     // -------- SYS /PHASE SHIFTS
 
@@ -9541,7 +9605,7 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Beidou_Dnav_Epheme
 }
 
 
-void Rinex_Printer::update_obs_header(std::fstream& out __attribute__((unused)), const Glonass_Gnav_Utc_Model& utc_model) const
+void Rinex_Printer::update_obs_header(std::ostream& out __attribute__((unused)), const Glonass_Gnav_Utc_Model& utc_model) const
 {
     if (utc_model.d_N_4 > 0.0)
         {
@@ -9550,266 +9614,142 @@ void Rinex_Printer::update_obs_header(std::fstream& out __attribute__((unused)),
 }
 
 
-void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_Utc_Model& utc_model) const
+void Rinex_Printer::update_obs_header(std::ostream& out, const Gps_Utc_Model& utc_model) const
 {
-    std::vector<std::string> data;
-    std::string line_aux;
-
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    std::string line;
+    line += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+    if (d_version == 2)
         {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if (d_version == 2)
-                        {
-                            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)  // TIME OF FIRST OBS last header annotation might change in the future
-                                {
-                                    data.push_back(line_str);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += std::string(54, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
-                        }
-
-                    if (d_version == 3)
-                        {
-                            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                                    line_aux += std::string(36, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
-                }
+            line += std::string(54, ' ');
         }
-
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
+    else
         {
-            out << data[i] << '\n';
+            line += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+            line += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+            line += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+            line += std::string(36, ' ');
         }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    line += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+    Rinex_Printer::lengthCheck(line);
+    Rinex_Printer::patch_obs_header_line(out, line);
 }
 
 
-void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model) const
+void Rinex_Printer::update_obs_header(std::ostream& out, const Gps_CNAV_Utc_Model& utc_model) const
 {
-    std::vector<std::string> data;
-    std::string line_aux;
+    std::string line;
+    line += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+    line += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+    line += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+    line += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+    line += std::string(36, ' ');
+    line += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+    Rinex_Printer::lengthCheck(line);
+    Rinex_Printer::patch_obs_header_line(out, line);
+}
 
-    out.seekp(0);
-    data.clear();
 
-    bool no_more_finds = false;
-    std::string line_str;
+void Rinex_Printer::update_obs_header(std::ostream& out, const Galileo_Utc_Model& galileo_utc_model) const
+{
+    std::string line;
+    line += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
+    line += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
+    line += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
+    line += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
+    line += std::string(36, ' ');
+    line += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+    Rinex_Printer::lengthCheck(line);
+    Rinex_Printer::patch_obs_header_line(out, line);
+}
 
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
 
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
+void Rinex_Printer::update_obs_header(std::ostream& out, const Beidou_Dnav_Utc_Model& utc_model) const
+{
+    std::string line;
+    line += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+    line += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+    line += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+    line += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+    line += std::string(36, ' ');
+    line += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+    Rinex_Printer::lengthCheck(line);
+    Rinex_Printer::patch_obs_header_line(out, line);
+}
 
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
+
+void Rinex_Printer::reserve_obs_header_line(std::ostream& out)
+{
+    if (d_obs_writer)
         {
-            out << data[i] << '\n';
+            // compressed output cannot be rewritten, see patch_obs_header_line()
+            return;
         }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    // Blank COMMENT line, overwritten by update_obs_header() once the UTC
+    // parameters are known. Same length, so the rest of the file is untouched.
+    d_obs_header_patch_pos = out.tellp();
+    std::string line;
+    line += std::string(60, ' ');
+    line += Rinex_Printer::leftJustify("COMMENT", 20);
+    Rinex_Printer::lengthCheck(line);
+    out << line << '\n';
 }
 
 
-void Rinex_Printer::update_obs_header(std::fstream& out, const Galileo_Utc_Model& galileo_utc_model) const
+void Rinex_Printer::patch_obs_header_line(std::ostream& out, const std::string& line) const
 {
-    std::vector<std::string> data;
-    std::string line_aux;
-
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    if (d_obs_writer)
         {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+            // The line goes into a "header information follows" special event
+            std::string event_line;
+            if (d_version == 2)
                 {
-                    line_aux.clear();
-
-                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    event_line += std::string(28, ' ');
                 }
             else
                 {
-                    data.push_back(line_str);
+                    event_line += std::string(1, '>');
+                    event_line += std::string(30, ' ');
                 }
+            event_line += std::string(1, '4');
+            event_line += Rinex_Printer::rightJustify(std::to_string(1), 3);
+            event_line += std::string(80 - event_line.size(), ' ');
+            Rinex_Printer::lengthCheck(event_line);
+            out << event_line << '\n';
+            out << line << '\n';
+            return;
         }
-
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
+    if (d_obs_header_patch_pos == std::fstream::pos_type(-1))
         {
-            out << data[i] << '\n';
+            LOG(WARNING) << "No room reserved in the RINEX observation header for the line " << line;
+            return;
         }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    const std::fstream::pos_type end_pos = out.tellp();
+    out.seekp(d_obs_header_patch_pos);
+    out << line << '\n';
+    out.seekp(end_pos);
 }
 
 
-void Rinex_Printer::update_obs_header(std::fstream& out, const Beidou_Dnav_Utc_Model& utc_model) const
+void Rinex_Printer::flush_obs_text()
 {
-    std::vector<std::string> data;
-    std::string line_aux;
-
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    const std::string text = d_obs_text.str();
+    if (text.empty())
         {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
-                }
+            return;
         }
-
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
+    d_obs_text.str(std::string());
+    if (d_crx_encoder)
         {
-            out << data[i] << '\n';
+            d_obs_writer->write(d_crx_encoder->encode(text));
+        }
+    else
+        {
+            d_obs_writer->write(text);
         }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& glonass_bands) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Glonass_Gnav_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& glonass_bands) const
 {
     // RINEX observations timestamps are GPS timestamps.
     std::string line;
@@ -9906,7 +9846,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
                     line.clear();
                     // GLONASS L1 PSEUDORANGE
                     line += std::string(2, ' ');
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -9921,9 +9861,9 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
                     // GLONASS L1 CA PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / TWO_PI, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_phase_rads / TWO_PI, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -9932,9 +9872,9 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
                     // GLONASS L1 CA DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -9943,9 +9883,9 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
                     // GLONASS L1 SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.CN0_dB_hz, 14, 3);
                     if (lineObs.size() < 80)
                         {
                             lineObs += std::string(80 - lineObs.size(), ' ');
@@ -10011,7 +9951,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
                         }
                     lineObs += std::to_string(static_cast<int32_t>(observables_iter->second.PRN));
                     // lineObs += std::string(2, ' ');
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -10026,10 +9966,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GLONASS L1 CA PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / TWO_PI, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_phase_rads / TWO_PI, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -10038,10 +9978,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GLONASS L1 CA DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -10051,10 +9991,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
 
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GLONASS L1 SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.CN0_dB_hz, 14, 3);
 
                     if (lineObs.size() < 80)
                         {
@@ -10066,7 +10006,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Glonass_Gnav_Ephemeri
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (glonass_gnav_eph.d_m > 0.0)
         {
@@ -10286,7 +10226,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                 }
 
             // Pseudorange Measurements
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Pseudorange_m, 14, 3);
 
             // Loss of lock indicator (LLI)
             int32_t lli = 0;  // Include in the observation!!
@@ -10301,10 +10241,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 
             // Signal Strength Indicator (SSI)
             const int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // PHASE
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / TWO_PI, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_phase_rads / TWO_PI, 14, 3);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -10313,10 +10253,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // DOPPLER
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_Doppler_hz, 14, 3);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -10325,10 +10265,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // SIGNAL STRENGTH
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.CN0_dB_hz, 14, 3);
 
             if (lineObs.size() < 80)
                 {
@@ -10357,7 +10297,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                 {
                     /// \todo Need to account for pseudorange correction for glonass
                     // double leap_seconds = Rinex_Printer::get_leap_second(glonass_gnav_eph, gps_obs_time);
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -10372,10 +10312,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GLONASS CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (TWO_PI), 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_phase_rads / (TWO_PI), 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -10384,10 +10324,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GLONASS  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -10396,10 +10336,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GLONASS SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.CN0_dB_hz, 14, 3);
                 }
 
             if (lineObs.size() < 80)
@@ -10411,7 +10351,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_CNAV_Ephemeris& gps_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (glonass_gnav_eph.d_m > 0.0)
         {
@@ -10546,7 +10486,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
             lineObs += std::to_string(static_cast<int32_t>(observables_iter->second.PRN));
 
             // Pseudorange Measurements
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Pseudorange_m, 14, 3);
 
             // Loss of lock indicator (LLI)
             int32_t lli = 0;  // Include in the observation!!
@@ -10561,10 +10501,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
 
             // Signal Strength Indicator (SSI)
             const int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // PHASE
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / TWO_PI, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_phase_rads / TWO_PI, 14, 3);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -10573,10 +10513,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // DOPPLER
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_Doppler_hz, 14, 3);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -10585,10 +10525,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // SIGNAL STRENGTH
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.CN0_dB_hz, 14, 3);
 
             if (lineObs.size() < 80)
                 {
@@ -10615,7 +10555,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
                 {
                     /// \todo Need to account for pseudorange correction for glonass
                     // double leap_seconds = Rinex_Printer::get_leap_second(glonass_gnav_eph, gps_obs_time);
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -10630,10 +10570,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GLONASS CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (TWO_PI), 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_phase_rads / (TWO_PI), 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -10642,10 +10582,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GLONASS  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -10654,10 +10594,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GLONASS SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.CN0_dB_hz, 14, 3);
                 }
 
             if (lineObs.size() < 80)
@@ -10669,7 +10609,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& g
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& galileo_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double galileo_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Galileo_Ephemeris& galileo_eph, const Glonass_Gnav_Ephemeris& glonass_gnav_eph, double galileo_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (glonass_gnav_eph.d_m > 0.0)
         {
@@ -10802,7 +10742,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
                     lineObs += std::string(1, '0');
                 }
             lineObs += std::to_string(static_cast<int32_t>(observables_iter->second.PRN));
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Pseudorange_m, 14, 3);
 
             // Loss of lock indicator (LLI)
             int32_t lli = 0;  // Include in the observation!!
@@ -10817,10 +10757,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
 
             // Signal Strength Indicator (SSI)
             const int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // PHASE
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / TWO_PI, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_phase_rads / TWO_PI, 14, 3);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -10829,10 +10769,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // DOPPLER
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_Doppler_hz, 14, 3);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -10841,10 +10781,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // SIGNAL STRENGTH
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.CN0_dB_hz, 14, 3);
 
             if (lineObs.size() < 80)
                 {
@@ -10868,7 +10808,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
             ret = total_glo_map.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -10883,10 +10823,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GLONASS CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (TWO_PI), 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_phase_rads / (TWO_PI), 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -10895,10 +10835,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GLONASS  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -10907,10 +10847,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //   }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GLONASS SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.CN0_dB_hz, 14, 3);
                 }
 
             if (lineObs.size() < 80)
@@ -10922,7 +10862,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ga
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     // RINEX observations timestamps are GPS timestamps.
     std::string line;
@@ -11014,7 +10954,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, d
                     line.clear();
                     // GPS L1 PSEUDORANGE
                     line += std::string(2, ' ');
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -11029,9 +10969,9 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, d
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
                     // GPS L1 CA PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / TWO_PI, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_phase_rads / TWO_PI, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -11040,9 +10980,9 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, d
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
                     // GPS L1 CA DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -11051,9 +10991,9 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, d
                     //    {
                     //       lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //   }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
                     // GPS L1 SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.CN0_dB_hz, 14, 3);
                     if (lineObs.size() < 80)
                         {
                             lineObs += std::string(80 - lineObs.size(), ' ');
@@ -11120,7 +11060,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, d
                         }
                     lineObs += std::to_string(static_cast<int32_t>(observables_iter->second.PRN));
                     // lineObs += std::string(2, ' ');
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -11135,10 +11075,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, d
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GPS L1 CA PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / TWO_PI, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_phase_rads / TWO_PI, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -11147,10 +11087,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, d
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GPS L1 CA DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -11160,10 +11100,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, d
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
 
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GPS L1 SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(observables_iter->second.CN0_dB_hz, 14, 3);
 
                     if (lineObs.size() < 80)
                         {
@@ -11175,7 +11115,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, d
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_CNAV_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     // RINEX observations timestamps are GPS timestamps.
     std::string line;
@@ -11248,7 +11188,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
             lineObs += std::to_string(static_cast<int32_t>(observables_iter->second.PRN));
             // lineObs += std::string(2, ' ');
             // GPS L2 PSEUDORANGE
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Pseudorange_m, 14, 3);
 
             // Loss of lock indicator (LLI)
             int32_t lli = 0;  // Include in the observation!!
@@ -11263,10 +11203,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
 
             // Signal Strength Indicator (SSI)
             const int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // GPS L2 PHASE
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / TWO_PI, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_phase_rads / TWO_PI, 14, 3);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -11275,10 +11215,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // GPS L2 DOPPLER
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_Doppler_hz, 14, 3);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -11288,10 +11228,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
             //   }
 
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // GPS L2 SIGNAL STRENGTH
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.CN0_dB_hz, 14, 3);
 
             if (lineObs.size() < 80)
                 {
@@ -11302,7 +11242,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, const Gps_CNAV_Ephemeris& eph_cnav, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, bool triple_band) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& eph, const Gps_CNAV_Ephemeris& eph_cnav, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, bool triple_band) const
 {
     if (eph_cnav.i_0 > 0.0)
         {
@@ -11484,7 +11424,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
                             lineObs += std::string(62, ' ');
                         }
 
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -11499,10 +11439,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GPS CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (TWO_PI), 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_phase_rads / (TWO_PI), 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -11511,10 +11451,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GPS  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -11523,10 +11463,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // GPS SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.CN0_dB_hz, 14, 3);
                 }
 
             if (lineObs.size() < 80)
@@ -11538,7 +11478,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& eph, c
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& galileo_bands) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Galileo_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& galileo_bands) const
 {
     // RINEX observations timestamps are Galileo timestamps.
     // See https://gage.upc.edu/sites/default/files/gLAB/HTML/Observation_Rinex_v3.01.html
@@ -11730,7 +11670,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ep
             ret = total_map.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -11745,10 +11685,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ep
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // Galileo CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (TWO_PI), 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_phase_rads / (TWO_PI), 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -11757,10 +11697,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // Galileo  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -11769,10 +11709,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ep
                     //    {
                     //       lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // Galileo SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.CN0_dB_hz, 14, 3);
                 }
 
             if (lineObs.size() < 80)
@@ -11784,7 +11724,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Galileo_Ephemeris& ep
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& gps_eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (galileo_eph.ecc > 0.0)
         {
@@ -11936,7 +11876,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     lineObs += std::string(1, '0');
                 }
             lineObs += std::to_string(static_cast<int32_t>(observables_iter->second.PRN));
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Pseudorange_m, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Pseudorange_m, 14, 3);
 
             // Loss of lock indicator (LLI)
             int32_t lli = 0;  // Include in the observation!!
@@ -11951,10 +11891,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 
             // Signal Strength Indicator (SSI)
             const int32_t ssi = Rinex_Printer::signalStrength(observables_iter->second.CN0_dB_hz);
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // PHASE
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_phase_rads / TWO_PI, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_phase_rads / TWO_PI, 14, 3);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -11963,10 +11903,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
             //   }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // DOPPLER
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.Carrier_Doppler_hz, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.Carrier_Doppler_hz, 14, 3);
             if (lli == 0)
                 {
                     lineObs += std::string(1, ' ');
@@ -11975,10 +11915,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
             //    {
             //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
             //    }
-            lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+            lineObs += std::to_string(ssi);
 
             // SIGNAL STRENGTH
-            lineObs += Rinex_Printer::rightJustify(asString(observables_iter->second.CN0_dB_hz, 3), 14);
+            lineObs += Rinex_Printer::asFixedField(observables_iter->second.CN0_dB_hz, 14, 3);
 
             if (lineObs.size() < 80)
                 {
@@ -12002,7 +11942,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
             ret = total_gal_map.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -12017,10 +11957,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // Galileo CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (TWO_PI), 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_phase_rads / (TWO_PI), 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -12029,10 +11969,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // Galileo  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -12041,10 +11981,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // Galileo SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.CN0_dB_hz, 14, 3);
                 }
 
             if (lineObs.size() < 80)
@@ -12056,7 +11996,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_CNAV_Ephemeris& eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables) const
 {
     if (galileo_eph.ecc > 0.0)
         {
@@ -12237,7 +12177,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
             ret = total_gps_map.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -12252,10 +12192,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (TWO_PI), 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_phase_rads / (TWO_PI), 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -12264,10 +12204,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     //  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -12276,10 +12216,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.CN0_dB_hz, 14, 3);
                 }
 
             out << lineObs << '\n';
@@ -12299,7 +12239,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
             ret = total_gal_map.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -12314,10 +12254,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // Galileo CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (TWO_PI), 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_phase_rads / (TWO_PI), 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -12326,10 +12266,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // Galileo  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -12338,10 +12278,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // Galileo SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.CN0_dB_hz, 14, 3);
                 }
 
             // if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
@@ -12350,7 +12290,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_CNAV_Ephemeris& e
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_eph, const Gps_CNAV_Ephemeris& gps_cnav_eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables, bool triple_band) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Gps_Ephemeris& gps_eph, const Gps_CNAV_Ephemeris& gps_cnav_eph, const Galileo_Ephemeris& galileo_eph, double gps_obs_time, const std::map<int32_t, Gnss_Synchro>& observables, bool triple_band) const
 {
     if (galileo_eph.ecc > 0.0)
         {
@@ -12563,7 +12503,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                             lineObs += std::string(62, ' ');
                         }
 
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -12578,10 +12518,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (TWO_PI), 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_phase_rads / (TWO_PI), 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -12590,10 +12530,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     //  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -12602,10 +12542,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.CN0_dB_hz, 14, 3);
                 }
 
             out << lineObs << '\n';
@@ -12625,7 +12565,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
             ret = total_gal_map.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -12640,10 +12580,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // Galileo CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (TWO_PI), 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_phase_rads / (TWO_PI), 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -12652,10 +12592,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // Galileo  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
@@ -12664,10 +12604,10 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
                     //    {
                     //        lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int16_t>(lli), 1);
                     //    }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // Galileo SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.CN0_dB_hz, 14, 3);
                 }
 
             // if (lineObs.size() < 80) lineObs += std::string(80 - lineObs.size(), ' ');
@@ -12676,7 +12616,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Gps_Ephemeris& gps_ep
 }
 
 
-void Rinex_Printer::log_rinex_obs(std::fstream& out, const Beidou_Dnav_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& bds_bands) const
+void Rinex_Printer::log_rinex_obs(std::ostream& out, const Beidou_Dnav_Ephemeris& eph, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables, const std::string& bds_bands) const
 {
     std::string line;
 
@@ -12810,7 +12750,7 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Beidou_Dnav_Ephemeris
             ret = total_map.equal_range(*it);
             for (auto iter = ret.first; iter != ret.second; ++iter)
                 {
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Pseudorange_m, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Pseudorange_m, 14, 3);
 
                     // Loss of lock indicator (LLI)
                     int32_t lli = 0;  // Include in the observation!!
@@ -12821,26 +12761,26 @@ void Rinex_Printer::log_rinex_obs(std::fstream& out, const Beidou_Dnav_Ephemeris
 
                     // Signal Strength Indicator (SSI)
                     const int32_t ssi = Rinex_Printer::signalStrength(iter->second.CN0_dB_hz);
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     // CARRIER PHASE
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_phase_rads / (TWO_PI), 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_phase_rads / (TWO_PI), 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
                         }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     //  DOPPLER
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.Carrier_Doppler_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.Carrier_Doppler_hz, 14, 3);
                     if (lli == 0)
                         {
                             lineObs += std::string(1, ' ');
                         }
-                    lineObs += Rinex_Printer::rightJustify(Rinex_Printer::asString<int32_t>(ssi), 1);
+                    lineObs += std::to_string(ssi);
 
                     //  SIGNAL STRENGTH
-                    lineObs += Rinex_Printer::rightJustify(asString(iter->second.CN0_dB_hz, 3), 14);
+                    lineObs += Rinex_Printer::asFixedField(iter->second.CN0_dB_hz, 14, 3);
                 }
 
             if (lineObs.size() < 80)
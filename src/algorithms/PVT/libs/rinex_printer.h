@@ -39,11 +39,13 @@
 #define GNSS_SDR_RINEX_PRINTER_H
 
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <cmath>    // for floor, signbit
 #include <cstdint>  // for int32_t
 #include <cstdlib>  // for strtol, strtod
 #include <fstream>  // for fstream
 #include <iomanip>  // for setprecision
 #include <map>      // for map
+#include <memory>   // for unique_ptr
 #include <sstream>  // for stringstream
 #include <string>   // for string
 #include <vector>
@@ -58,6 +60,8 @@
 class Beidou_Dnav_Ephemeris;
 class Beidou_Dnav_Iono;
 class Beidou_Dnav_Utc_Model;
+class Compact_Rinex_Encoder;
+class Compressed_File_Writer;
 class Galileo_Ephemeris;
 class Galileo_Iono;
 class Galileo_Utc_Model;
@@ -87,7 +91,9 @@ public:
      */
     explicit Rinex_Printer(int version = 0,
         const std::string& base_path = ".",
-        const std::string& base_name = "-");
+        const std::string& base_name = "-",
+        bool compact = false,
+        bool gzip = false);
 
     /*!
      * \brief Destructor. Removes created files if empty.
@@ -230,18 +236,58 @@ public:
     }
 
 
+    /*
+     * Right-justifies the receiver in a string of the specified
+     * length (const version). If the receiver's data is shorter than the
+     * requested length (\a length), it is padded on the left with
+     * the pad character (\a pad). The default pad
+     * character is a blank.*/
+    inline std::string rightJustify(const std::string& s,
+        std::string::size_type length,
+        char pad = ' ') const
+    {
+        std::string t(s);
+        return rightJustify(t, length, pad);
+    }
+
+
+    /*
+     * Convert a double to a string in fixed notation.
+     * @param x double.
+     * @param precision the number of decimal places you want displayed.
+     * @return string representation of \a x.
+     */
+    inline std::string asString(double x,
+        std::string::size_type precision = 17) const;
+
+
+    /*
+     * Convert a double to a right-justified string in fixed notation,
+     * equivalent to rightJustify(asString(x, precision), length) but
+     * without going through a stringstream. Used for the observation
+     * records, where it is called several times per satellite and epoch.
+     * @param x double.
+     * @param length width of the field.
+     * @param precision the number of decimal places (up to 9).
+     * @return string representation of \a x.
+     */
+    inline std::string asFixedField(double x,
+        std::string::size_type length,
+        int precision) const;
+
+
 private:
     /*
      * Generates the GPS Observation data header
      */
-    void rinex_obs_header(std::fstream& out,
+    void rinex_obs_header(std::ostream& out,
         const Gps_Ephemeris& eph,
         double d_TOW_first_observation);
 
     /*
      * Generates the GPS L2 Observation data header
      */
-    void rinex_obs_header(std::fstream& out,
+    void rinex_obs_header(std::ostream& out,
         const Gps_CNAV_Ephemeris& eph,
         double d_TOW_first_observation,
         const std::string& gps_bands = "2S");
@@ -249,7 +295,7 @@ private:
     /*
      * Generates the dual frequency GPS L1 & L2/L5 Observation data header
      */
-    void rinex_obs_header(std::fstream& out,
+    void rinex_obs_header(std::ostream& out,
         const Gps_Ephemeris& eph,
         const Gps_CNAV_Ephemeris& eph_cnav,
         double d_TOW_first_observation,
@@ -259,7 +305,7 @@ private:
      * Generates the Galileo Observation data header.
      * Example: bands("1B"), bands("1B 5X"), bands("5X"), ... Default: "1B".
      */
-    void rinex_obs_header(std::fstream& out,
+    void rinex_obs_header(std::ostream& out,
         const Galileo_Ephemeris& eph,
         double d_TOW_first_observation,
         const std::string& bands = "1B");
@@ -269,7 +315,7 @@ private:
      * Example: galileo_bands("1B"), galileo_bands("1B 5X"),
      * galileo_bands("5X"), ... Default: "1B".
      */
-    void rinex_obs_header(std::fstream& out,
+    void rinex_obs_header(std::ostream& out,
         const Gps_Ephemeris& gps_eph,
         const Galileo_Ephemeris& galileo_eph,
         double d_TOW_first_observation,
@@ -279,7 +325,7 @@ private:
      * Generates the Mixed (GPS/Galileo) Observation data header.
      * Example: galileo_bands("1B"), galileo_bands("1B 5X"), galileo_bands("5X"), ... Default: "1B".
      */
-    void rinex_obs_header(std::fstream& out,
+    void rinex_obs_header(std::ostream& out,
         const Gps_Ephemeris& gps_eph,
         const Gps_CNAV_Ephemeris& eph_cnav,
         const Galileo_Ephemeris& galileo_eph,
@@ -291,7 +337,7 @@ private:
      * Generates the Mixed (GPS/Galileo) Observation data header.
      * Example: galileo_bands("1B"), galileo_bands("1B 5X"), galileo_bands("5X"), ... Default: "1B".
      */
-    void rinex_obs_header(std::fstream& out,
+    void rinex_obs_header(std::ostream& out,
         const Gps_CNAV_Ephemeris& eph_cnav,
         const Galileo_Ephemeris& galileo_eph,
         double d_TOW_first_observation,
@@ -302,7 +348,7 @@ private:
      * Generates the GLONASS GNAV Observation data header.
      * Example: bands("1C"), bands("1C 2C"), bands("2C"), ... Default: "1C".
      */
-    void rinex_obs_header(std::fstream& out,
+    void rinex_obs_header(std::ostream& out,
         const Glonass_Gnav_Ephemeris& eph,
         double d_TOW_first_observation,
         const std::string& bands = "1G");
@@ -311,7 +357,7 @@ private:
      * Generates the Mixed (GPS L1 C/A /GLONASS) Observation data header.
      * Example: galileo_bands("1C"), galileo_bands("1B 5X"), galileo_bands("5X"), ... Default: "1B".
      */
-    void rinex_obs_header(std::fstream& out,
+    void rinex_obs_header(std::ostream& out,
         const Gps_Ephemeris& gps_eph,
         const Glonass_Gnav_Ephemeris& glonass_gnav_eph,
         double d_TOW_first_observation,
@@ -321,7 +367,7 @@ private:
      * Generates the Mixed (Galileo/GLONASS) Observation data header.
      * Example: galileo_bands("1C"), galileo_bands("1B 5X"), galileo_bands("5X"), ... Default: "1B".
      */
-    void rinex_obs_header(std::fstream& out,
+    void rinex_obs_header(std::ostream& out,
         const Galileo_Ephemeris& galileo_eph,
         const Glonass_Gnav_Ephemeris& glonass_gnav_eph,
         double d_TOW_first_observation,
@@ -332,7 +378,7 @@ private:
      * Generates the Mixed (GPS L2C/GLONASS) Observation data header.
      * Example: galileo_bands("1G")... Default: "1G".
      */
-    void rinex_obs_header(std::fstream& out,
+    void rinex_obs_header(std::ostream& out,
         const Gps_CNAV_Ephemeris& gps_cnav_eph,
         const Glonass_Gnav_Ephemeris& glonass_gnav_eph,
         double d_TOW_first_observation,
@@ -341,7 +387,7 @@ private:
     /*
      * Generates the a Beidou B1I Observation data header. Example: beidou_bands("B1")
      */
-    void rinex_obs_header(std::fstream& out,
+    void rinex_obs_header(std::ostream& out,
         const Beidou_Dnav_Ephemeris& eph,
         double d_TOW_first_observation,
         const std::string& bands);
@@ -354,7 +400,7 @@ private:
     /*
      * Writes GPS L1 observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables) const;
@@ -362,7 +408,7 @@ private:
     /*
      * Writes GPS L2 observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_CNAV_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables) const;
@@ -370,7 +416,7 @@ private:
     /*
      * Writes dual frequency GPS L1 and L2 observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& eph,
         const Gps_CNAV_Ephemeris& eph_cnav,
         double obs_time,
@@ -381,7 +427,7 @@ private:
      * Writes Galileo observables into the RINEX file.
      * Example: galileo_bands("1B"), galileo_bands("1B 5X"), galileo_bands("5X"), ... Default: "1B".
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Galileo_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
@@ -390,7 +436,7 @@ private:
     /*
      * Writes Mixed GPS / Galileo observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& gps_eph,
         const Galileo_Ephemeris& galileo_eph,
         double gps_obs_time,
@@ -399,7 +445,7 @@ private:
     /*
      * Writes Mixed GPS / Galileo observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_CNAV_Ephemeris& eph,
         const Galileo_Ephemeris& galileo_eph,
         double gps_obs_time,
@@ -408,7 +454,7 @@ private:
     /*
      * Writes Mixed GPS / Galileo observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& gps_eph,
         const Gps_CNAV_Ephemeris& gps_cnav_eph,
         const Galileo_Ephemeris& galileo_eph,
@@ -420,7 +466,7 @@ private:
      * Writes GLONASS GNAV observables into the RINEX file.
      * Example: glonass_bands("1C"), galileo_bands("1B 5X"), galileo_bands("5X"), ... Default: "1B".
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Glonass_Gnav_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
@@ -429,7 +475,7 @@ private:
     /*
      * Writes Mixed GPS L1 C/A - GLONASS observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_Ephemeris& gps_eph,
         const Glonass_Gnav_Ephemeris& glonass_gnav_eph,
         double gps_obs_time,
@@ -438,7 +484,7 @@ private:
     /*
      * Writes Mixed GPS L2C - GLONASS observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Gps_CNAV_Ephemeris& gps_eph,
         const Glonass_Gnav_Ephemeris& glonass_gnav_eph,
         double gps_obs_time,
@@ -447,7 +493,7 @@ private:
     /*
      * Writes Mixed Galileo/GLONASS observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Galileo_Ephemeris& galileo_eph,
         const Glonass_Gnav_Ephemeris& glonass_gnav_eph,
         double galileo_obs_time,
@@ -456,7 +502,7 @@ private:
     /*
      * Writes BDS B1I observables into the RINEX file
      */
-    void log_rinex_obs(std::fstream& out,
+    void log_rinex_obs(std::ostream& out,
         const Beidou_Dnav_Ephemeris& eph,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
@@ -760,21 +806,42 @@ private:
         const Beidou_Dnav_Utc_Model& utc_model,
         const Beidou_Dnav_Iono& beidou_dnav_iono) const;
 
-    void update_obs_header(std::fstream& out,
+    void update_obs_header(std::ostream& out,
         const Gps_Utc_Model& utc_model) const;
 
-    void update_obs_header(std::fstream& out,
+    void update_obs_header(std::ostream& out,
         const Gps_CNAV_Utc_Model& utc_model) const;
 
-    void update_obs_header(std::fstream& out,
+    void update_obs_header(std::ostream& out,
         const Galileo_Utc_Model& galileo_utc_model) const;
 
-    void update_obs_header(std::fstream& out,
+    void update_obs_header(std::ostream& out,
         const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model) const;
 
-    void update_obs_header(std::fstream& out,
+    void update_obs_header(std::ostream& out,
         const Beidou_Dnav_Utc_Model& utc_model) const;
 
+    /*
+     * Writes a blank COMMENT line in the observation header and remembers
+     * its position, so that update_obs_header can later overwrite it with
+     * the LEAP SECONDS line without rewriting the file
+     */
+    void reserve_obs_header_line(std::ostream& out);
+
+    /*
+     * Overwrites the observation header line reserved by
+     * reserve_obs_header_line and goes back to the end of the file.
+     * For compressed outputs, the line is written in a special event
+     * record (epoch flag 4) instead.
+     */
+    void patch_obs_header_line(std::ostream& out, const std::string& line) const;
+
+    /*
+     * Hands the observation text accumulated in d_obs_text to the
+     * Compact RINEX encoder (if enabled) and to the background writer
+     */
+    void flush_obs_text();
+
     /*
      * Generation of RINEX signal strength indicators
      */
@@ -857,21 +924,6 @@ private:
         std::string::size_type length,
         char pad = ' ') const;
 
-    /*
-     * Right-justifies the receiver in a string of the specified
-     * length (const version). If the receiver's data is shorter than the
-     * requested length (\a length), it is padded on the left with
-     * the pad character (\a pad). The default pad
-     * character is a blank.*/
-    inline std::string rightJustify(const std::string& s,
-        std::string::size_type length,
-        char pad = ' ') const
-    {
-        std::string t(s);
-        return rightJustify(t, length, pad);
-    }
-
-
     /*
      * Convert a double to a scientific notation number.
      * @param d the double to convert
@@ -952,16 +1004,6 @@ private:
     }
 
 
-    /*
-     * Convert a double to a string in fixed notation.
-     * @param x double.
-     * @param precision the number of decimal places you want displayed.
-     * @return string representation of \a x.
-     */
-    inline std::string asString(double x,
-        std::string::size_type precision = 17) const;
-
-
     /*
      * Convert a long double to a string in fixed notation.
      * @param x long double.
@@ -987,6 +1029,12 @@ private:
     std::map<std::string, std::string> observationType;  // PSEUDORANGE, CARRIER_PHASE, DOPPLER, SIGNAL_STRENGTH
     std::map<std::string, std::string> observationCode;  // GNSS observation descriptors
 
+    std::unique_ptr<Compact_Rinex_Encoder> d_crx_encoder;  // Compact RINEX encoder of the observation file, if enabled
+    std::unique_ptr<Compressed_File_Writer> d_obs_writer;  // Background writer of the observation file, if compressed
+    std::ostringstream d_obs_text;                         // Observation text waiting for the background writer
+
+    std::vector<char> d_obs_file_buffer;  // Output buffer of obsFile, declared before it so it outlives the stream
+
     std::fstream obsFile;     // Output file stream for RINEX observation file
     std::fstream navFile;     // Output file stream for RINEX navigation data file
     std::fstream sbsFile;     // Output file stream for RINEX SBAS raw data file
@@ -1006,6 +1054,8 @@ private:
 
     std::string d_stringVersion;  // RINEX version (2.10/2.11 or 3.01/3.02)
 
+    std::fstream::pos_type d_obs_header_patch_pos;  // Position of the observation header line reserved for LEAP SECONDS
+
     double d_fake_cnav_iode;
     int d_version;                  // RINEX version (2 for 2.10/2.11 and 3 for 3.01)
     int d_numberTypesObservations;  // Number of available types of observable in the system. Should be public?
@@ -1238,6 +1288,63 @@ inline std::string Rinex_Printer::asFixWidthString(int x, int width, char fill_d
 }
 
 
+inline std::string Rinex_Printer::asFixedField(double x,
+    std::string::size_type length,
+    int precision) const
+{
+    static const double pow10[10] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+    if (precision < 0 or precision > 9 or length > 32)
+        {
+            return rightJustify(asString(x, precision), length);
+        }
+    const double scaled = std::abs(x) * pow10[precision];
+    if (!(scaled < 1e15))  // also catches NaN and inf
+        {
+            return rightJustify(asString(x, precision), length);
+        }
+    const double integral = std::floor(scaled);
+    const double fraction = scaled - integral;
+    if (std::abs(fraction - 0.5) < scaled * 1e-15 + 1e-9)
+        {
+            // too close to a rounding tie to decide it here, let the standard library do it
+            return rightJustify(asString(x, precision), length);
+        }
+    auto digits = static_cast<uint64_t>(integral) + (fraction > 0.5 ? 1 : 0);
+
+    char buf[40];
+    char* p = buf + sizeof(buf);
+    for (int i = 0; i < precision; i++)
+        {
+            *--p = static_cast<char>('0' + digits % 10);
+            digits /= 10;
+        }
+    if (precision > 0)
+        {
+            *--p = '.';
+        }
+    do
+        {
+            *--p = static_cast<char>('0' + digits % 10);
+            digits /= 10;
+        }
+    while (digits != 0);
+    if (std::signbit(x))
+        {
+            *--p = '-';
+        }
+
+    const auto n = static_cast<std::string::size_type>(buf + sizeof(buf) - p);
+    if (n >= length)
+        {
+            // as rightJustify, truncate from the left
+            return std::string(buf + sizeof(buf) - length, length);
+        }
+    std::string s(length - n, ' ');
+    s.append(p, n);
+    return s;
+}
+
+
 inline int64_t asInt(const std::string& s)
 {
     return strtol(s.c_str(), nullptr, 10);
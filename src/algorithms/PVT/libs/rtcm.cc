@@ -28,20 +28,24 @@
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/exception/diagnostic_information.hpp>
-#include <algorithm>  // for std::reverse
+#include <algorithm>  // for std::max, std::reverse
 #include <cmath>      // for std::fmod, std::lround
 #include <cstdlib>    // for strtol
 #include <iostream>   // for cout
 #include <sstream>    // for std::stringstream
 
 
-Rtcm::Rtcm(uint16_t port) : RTCM_port(port), server_is_running(false)
+Rtcm::Rtcm(uint16_t port,
+    int32_t server_threads,
+    uint32_t max_client_backlog,
+    Rtcm_Backlog_Policy backlog_policy) : RTCM_port(port),
+                                          n_server_threads(std::max(server_threads, 1)),
+                                          server_is_running(false)
 {
     preamble = std::bitset<8>("11010011");
     reserved_field = std::bitset<6>("000000");
-    rtcm_message_queue = std::make_shared<Concurrent_Queue<std::string>>();
     boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), RTCM_port);
-    servers.emplace_back(io_context, endpoint);
+    servers.emplace_back(io_context, endpoint, std::max<std::size_t>(max_client_backlog, 1), backlog_policy);
 }
 
 
@@ -76,9 +80,17 @@ void Rtcm::run_server()
     std::cout << "Starting a TCP/IP server of RTCM messages on port " << RTCM_port << '\n';
     try
         {
-            tq = std::thread([&] { std::make_shared<Queue_Reader>(io_context, rtcm_message_queue, RTCM_port)->do_read_queue(); });
-            t = std::thread([&] { io_context.run(); });
+#if USE_BOOST_ASIO_IO_CONTEXT
+            io_context.restart();
+#else
+            io_context.reset();
+#endif
+            for (int32_t i = 0; i < n_server_threads; i++)
+                {
+                    server_threads.emplace_back([&] { io_context.run(); });
+                }
             server_is_running = true;
+            std::cout << "The TCP/IP server of RTCM messages is up and running. Accepting connections ...\n";
         }
     catch (const std::exception& e)
         {
@@ -97,17 +109,19 @@ void Rtcm::stop_server()
 {
     std::cout << "Stopping TCP/IP server on port " << RTCM_port << '\n';
     Rtcm::stop_service();
+    for (auto& thread : server_threads)
+        {
+            thread.join();
+        }
+    server_threads.clear();
     servers.front().close_server();
-    rtcm_message_queue->push("Goodbye");  // this terminates tq
-    tq.join();
-    t.join();
     server_is_running = false;
 }
 
 
 void Rtcm::send_message(const std::string& msg)
 {
-    rtcm_message_queue->push(msg);
+    servers.front().deliver(std::make_shared<const std::string>(msg));
 }
 
 
@@ -512,7 +526,7 @@ std::string Rtcm::print_MT1001(const Gps_Ephemeris& gps_eph, double obs_time, co
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -561,7 +575,7 @@ std::string Rtcm::print_MT1002(const Gps_Ephemeris& gps_eph, double obs_time, co
     const std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -664,7 +678,7 @@ std::string Rtcm::print_MT1003(const Gps_Ephemeris& ephL1, const Gps_CNAV_Epheme
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -773,7 +787,7 @@ std::string Rtcm::print_MT1004(const Gps_Ephemeris& ephL1, const Gps_CNAV_Epheme
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -908,7 +922,7 @@ std::string Rtcm::print_MT1005(uint32_t ref_id, double ecef_x, double ecef_y, do
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1030,7 +1044,7 @@ std::string Rtcm::print_MT1006(uint32_t ref_id, double ecef_x, double ecef_y, do
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1091,7 +1105,7 @@ std::string Rtcm::print_MT1008(uint32_t ref_id, const std::string& antenna_descr
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1190,7 +1204,7 @@ std::string Rtcm::print_MT1009(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, d
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1239,7 +1253,7 @@ std::string Rtcm::print_MT1010(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, d
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1346,7 +1360,7 @@ std::string Rtcm::print_MT1011(const Glonass_Gnav_Ephemeris& ephL1, const Glonas
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1457,7 +1471,7 @@ std::string Rtcm::print_MT1012(const Glonass_Gnav_Ephemeris& ephL1, const Glonas
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1581,7 +1595,7 @@ std::string Rtcm::print_MT1019(const Gps_Ephemeris& gps_eph)
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -1812,7 +1826,7 @@ std::string Rtcm::print_MT1020(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, c
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -2034,7 +2048,7 @@ std::string Rtcm::print_MT1029(uint32_t ref_id, const Gps_Ephemeris& gps_eph, do
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -2118,7 +2132,7 @@ std::string Rtcm::print_MT1045(const Galileo_Ephemeris& gal_eph)
     std::string msg = build_message(data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(msg);
+            Rtcm::send_message(msg);
         }
     return msg;
 }
@@ -2307,7 +2321,7 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
 
     if (server_is_running)
         {
-            rtcm_message_queue->push(message);
+            Rtcm::send_message(message);
         }
 
     return message;
@@ -2504,7 +2518,7 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
     std::string message = build_message(header + sat_data + signal_data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(message);
+            Rtcm::send_message(message);
         }
 
     return message;
@@ -2618,7 +2632,7 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
     std::string message = build_message(header + sat_data + signal_data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(message);
+            Rtcm::send_message(message);
         }
 
     return message;
@@ -2735,7 +2749,7 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
     std::string message = build_message(header + sat_data + signal_data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(message);
+            Rtcm::send_message(message);
         }
 
     return message;
@@ -2898,7 +2912,7 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
     std::string message = build_message(header + sat_data + signal_data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(message);
+            Rtcm::send_message(message);
         }
 
     return message;
@@ -3070,7 +3084,7 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
     std::string message = build_message(header + sat_data + signal_data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(message);
+            Rtcm::send_message(message);
         }
 
     return message;
@@ -3190,7 +3204,7 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
     std::string message = build_message(header + sat_data + signal_data);
     if (server_is_running)
         {
-            rtcm_message_queue->push(message);
+            Rtcm::send_message(message);
         }
 
     return message;
@@ -19,7 +19,6 @@
 #define GNSS_SDR_RTCM_H
 
 
-#include "concurrent_queue.h"
 #include "galileo_ephemeris.h"
 #include "glonass_gnav_ephemeris.h"
 #include "glonass_gnav_utc_model.h"
@@ -39,6 +38,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <thread>
@@ -53,8 +53,10 @@
 
 #if USE_BOOST_ASIO_IO_CONTEXT
 using b_io_context = boost::asio::io_context;
+using b_strand = boost::asio::strand<boost::asio::io_context::executor_type>;
 #else
 using b_io_context = boost::asio::io_service;
+using b_strand = boost::asio::io_service::strand;
 #endif
 
 
@@ -90,7 +92,29 @@ using b_io_context = boost::asio::io_service;
 class Rtcm
 {
 public:
-    explicit Rtcm(uint16_t port = 2101);  //!< Default constructor that sets TCP port of the RTCM message server and RTCM Station ID. 2101 is the standard RTCM port according to the Internet Assigned Numbers Authority (IANA). See https://www.iana.org/assignments/service-names-port-numbers/service-names-port-numbers.xml
+    /*!
+     * \brief What the TCP server does when a client does not keep up and
+     * its queue of pending messages is full
+     */
+    enum Rtcm_Backlog_Policy
+    {
+        DROP_OLDEST = 0,  //!< Discard the oldest message not yet being sent
+        DROP_NEWEST = 1,  //!< Discard the new message
+        DISCONNECT = 2    //!< Close the connection with the client
+    };
+
+    /*!
+     * \brief Default constructor that sets TCP port of the RTCM message server.
+     * 2101 is the standard RTCM port according to the Internet Assigned Numbers
+     * Authority (IANA). See https://www.iana.org/assignments/service-names-port-numbers/service-names-port-numbers.xml
+     * The server runs on server_threads threads, and queues at most
+     * max_client_backlog messages per client before applying backlog_policy.
+     */
+    explicit Rtcm(uint16_t port = 2101,
+        int32_t server_threads = 1,
+        uint32_t max_client_backlog = 256,
+        Rtcm_Backlog_Policy backlog_policy = DROP_OLDEST);
+
     ~Rtcm();
 
     /*!
@@ -368,7 +392,7 @@ public:
     void run_server();   //!< Starts running the server
     void stop_server();  //!< Stops the server
 
-    void send_message(const std::string& msg);  //!< Sends a message through the server to all connected clients
+    void send_message(const std::string& msg);  //!< Sends a message through the server to all connected clients. The message is stored once and shared by all of them.
     bool is_server_running() const;             //!< Returns true if the server is running, false otherwise
 
 private:
@@ -590,11 +614,14 @@ private:
     };
 
 
+    // Encoded message shared, without copies, by the send queues of all clients
+    using Rtcm_Buffer = std::shared_ptr<const std::string>;
+
     class RtcmListener
     {
     public:
         virtual ~RtcmListener() = default;
-        virtual void deliver(const Rtcm_Message& msg) = 0;
+        virtual void deliver(const Rtcm_Buffer& msg) = 0;
     };
 
 
@@ -603,8 +630,9 @@ private:
     public:
         inline void join(const std::shared_ptr<RtcmListener>& participant)
         {
+            std::lock_guard<std::mutex> lock(mutex_);
             participants_.insert(participant);
-            for (auto msg : recent_msgs_)
+            for (const auto& msg : recent_msgs_)
                 {
                     participant->deliver(msg);
                 }
@@ -612,11 +640,13 @@ private:
 
         inline void leave(const std::shared_ptr<RtcmListener>& participant)
         {
+            std::lock_guard<std::mutex> lock(mutex_);
             participants_.erase(participant);
         }
 
-        inline void deliver(const Rtcm_Message& msg)
+        inline void deliver(const Rtcm_Buffer& msg)
         {
+            std::lock_guard<std::mutex> lock(mutex_);
             recent_msgs_.push_back(msg);
             while (recent_msgs_.size() > max_recent_msgs)
                 {
@@ -629,13 +659,20 @@ private:
                 }
         }
 
+        inline void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            participants_.clear();
+        }
+
     private:
+        std::mutex mutex_;
         std::set<std::shared_ptr<RtcmListener>> participants_;
         enum
         {
             max_recent_msgs = 1
         };
-        std::deque<Rtcm_Message> recent_msgs_;
+        std::deque<Rtcm_Buffer> recent_msgs_;
     };
 
 
@@ -644,30 +681,99 @@ private:
           public std::enable_shared_from_this<Rtcm_Session>
     {
     public:
-        Rtcm_Session(boost::asio::ip::tcp::socket socket, Rtcm_Listener_Room& room) : socket_(std::move(socket)), room_(room) {}
+        Rtcm_Session(b_io_context& io_context,
+            boost::asio::ip::tcp::socket socket,
+            Rtcm_Listener_Room& room,
+            std::size_t max_backlog,
+            Rtcm_Backlog_Policy backlog_policy)
+            : socket_(std::move(socket)),
+#if USE_BOOST_ASIO_IO_CONTEXT
+              strand_(io_context.get_executor()),
+#else
+              strand_(io_context),
+#endif
+              room_(room),
+              max_backlog_(max_backlog),
+              backlog_policy_(backlog_policy)
+        {
+            write_buffers_.reserve(max_gathered_msgs);
+        }
+
         inline void start()
         {
-            room_.join(shared_from_this());
-            do_read_message_header();
+            auto self(shared_from_this());
+            post_to_strand([this, self]() {
+                room_.join(self);
+                do_read_message_header();
+            });
         }
 
-        inline void deliver(const Rtcm_Message& msg)
+        // Called from the thread producing the messages. Only the pointer
+        // is queued; the write itself is started in the session strand.
+        inline void deliver(const Rtcm_Buffer& msg) override
         {
-            bool write_in_progress = !write_msgs_.empty();
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closing_)
+                {
+                    return;
+                }
+            if (write_msgs_.size() - in_flight_ >= max_backlog_)
+                {
+                    dropped_msgs_++;
+                    if (backlog_policy_ == DROP_NEWEST)
+                        {
+                            return;
+                        }
+                    if (backlog_policy_ == DISCONNECT)
+                        {
+                            closing_ = true;
+                            auto self(shared_from_this());
+                            post_to_strand([this, self]() { close(); });
+                            return;
+                        }
+                    // DROP_OLDEST: messages already handed to the socket cannot be dropped
+                    write_msgs_.erase(write_msgs_.begin() + in_flight_);
+                }
             write_msgs_.push_back(msg);
-            if (!write_in_progress)
+            if (!write_in_progress_)
                 {
-                    do_write();
+                    write_in_progress_ = true;
+                    auto self(shared_from_this());
+                    post_to_strand([this, self]() { do_write(); });
                 }
         }
 
     private:
+        template <typename Handler>
+        inline void post_to_strand(Handler handler)
+        {
+#if USE_BOOST_ASIO_IO_CONTEXT
+            boost::asio::post(strand_, std::move(handler));
+#else
+            strand_.post(std::move(handler));
+#endif
+        }
+
+        template <typename Handler>
+        inline auto on_strand(Handler handler)
+#if USE_BOOST_ASIO_IO_CONTEXT
+            -> decltype(boost::asio::bind_executor(std::declval<b_strand&>(), handler))
+        {
+            return boost::asio::bind_executor(strand_, handler);
+        }
+#else
+            -> decltype(std::declval<b_strand&>().wrap(handler))
+        {
+            return strand_.wrap(handler);
+        }
+#endif
+
         inline void do_read_message_header()
         {
             auto self(shared_from_this());
             boost::asio::async_read(socket_,
                 boost::asio::buffer(read_msg_.data(), Rtcm_Message::header_length),
-                [this, self](boost::system::error_code ec, std::size_t /*length*/) {
+                on_strand([this, self](boost::system::error_code ec, std::size_t /*length*/) {
                     if (!ec and read_msg_.decode_header())
                         {
                             do_read_message_body();
@@ -690,10 +796,9 @@ private:
                         }
                     else
                         {
-                            std::cout << "Closing connection with RTCM client\n";
-                            room_.leave(shared_from_this());
+                            close();
                         }
-                });
+                }));
         }
 
         inline void do_read_message_body()
@@ -701,185 +806,113 @@ private:
             auto self(shared_from_this());
             boost::asio::async_read(socket_,
                 boost::asio::buffer(read_msg_.body(), read_msg_.body_length()),
-                [this, self](boost::system::error_code ec, std::size_t /*length*/) {
+                on_strand([this, self](boost::system::error_code ec, std::size_t /*length*/) {
                     if (!ec)
                         {
-                            room_.deliver(read_msg_);
-                            // std::cout << "Delivered message (session): ";
-                            // std::cout.write(read_msg_.body(), read_msg_.body_length());
-                            // std::cout << '\n';
+                            room_.deliver(std::make_shared<const std::string>(read_msg_.body(), read_msg_.body_length()));
                             do_read_message_header();
                         }
                     else
                         {
-                            std::cout << "Closing connection with RTCM client\n";
-                            room_.leave(shared_from_this());
+                            close();
                         }
-                });
+                }));
         }
 
+        // Sends all the queued messages (up to max_gathered_msgs) with a
+        // single scatter-gather write
         inline void do_write()
         {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                in_flight_ = std::min(write_msgs_.size(), static_cast<std::size_t>(max_gathered_msgs));
+                write_buffers_.clear();
+                for (std::size_t i = 0; i < in_flight_; i++)
+                    {
+                        write_buffers_.emplace_back(write_msgs_[i]->data(), write_msgs_[i]->size());
+                    }
+            }
             auto self(shared_from_this());
             boost::asio::async_write(socket_,
-                boost::asio::buffer(write_msgs_.front().body(), write_msgs_.front().body_length()),
-                [this, self](boost::system::error_code ec, std::size_t /*length*/) {
+                write_buffers_,
+                on_strand([this, self](boost::system::error_code ec, std::size_t /*length*/) {
                     if (!ec)
                         {
-                            write_msgs_.pop_front();
-                            if (!write_msgs_.empty())
+                            bool pending;
+                            {
+                                std::lock_guard<std::mutex> lock(mutex_);
+                                write_msgs_.erase(write_msgs_.begin(), write_msgs_.begin() + in_flight_);
+                                in_flight_ = 0;
+                                pending = !write_msgs_.empty();
+                                write_in_progress_ = pending;
+                            }
+                            if (pending)
                                 {
                                     do_write();
                                 }
                         }
                     else
                         {
-                            std::cout << "Closing connection with RTCM client\n";
-                            room_.leave(shared_from_this());
+                            close();
                         }
-                });
-        }
-
-        boost::asio::ip::tcp::socket socket_;
-        Rtcm_Listener_Room& room_;
-        Rtcm_Message read_msg_;
-        std::deque<Rtcm_Message> write_msgs_;
-        std::string client_says;
-    };
-
-
-    class Tcp_Internal_Client
-        : public std::enable_shared_from_this<Tcp_Internal_Client>
-    {
-    public:
-        Tcp_Internal_Client(b_io_context& io_context,
-            boost::asio::ip::tcp::resolver::iterator endpoint_iterator)
-            : io_context_(io_context), socket_(io_context)
-        {
-            do_connect(std::move(endpoint_iterator));
+                }));
         }
 
         inline void close()
         {
-            io_context_.post([this]() { socket_.close(); });
-        }
-
-        inline void write(const Rtcm_Message& msg)
-        {
-            io_context_.post(
-                [this, msg]() {
-                    bool write_in_progress = !write_msgs_.empty();
-                    write_msgs_.push_back(msg);
-                    if (!write_in_progress)
-                        {
-                            do_write();
-                        }
-                });
-        }
-
-    private:
-        inline void do_connect(boost::asio::ip::tcp::resolver::iterator endpoint_iterator)
-        {
-            boost::asio::async_connect(socket_, std::move(endpoint_iterator),
-                [this](boost::system::error_code ec, boost::asio::ip::tcp::resolver::iterator) {
-                    if (!ec)
-                        {
-                            do_read_message();
-                        }
-                    else
-                        {
-                            std::cout << "Server is down.\n";
-                        }
-                });
-        }
-
-        inline void do_read_message()
-        {
-            boost::asio::async_read(socket_,
-                boost::asio::buffer(read_msg_.data(), 1029),
-                [this](boost::system::error_code ec, std::size_t /*length*/) {
-                    if (!ec)
-                        {
-                            do_read_message();
-                        }
-                    else
-                        {
-                            std::cout << "Error in client\n";
-                            socket_.close();
-                        }
-                });
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (closed_)
+                    {
+                        return;
+                    }
+                closed_ = true;
+                closing_ = true;
+                write_msgs_.clear();
+                in_flight_ = 0;
+            }
+            if (dropped_msgs_ > 0)
+                {
+                    LOG(INFO) << "RTCM client was too slow, " << dropped_msgs_ << " messages were not sent";
+                }
+            std::cout << "Closing connection with RTCM client\n";
+            boost::system::error_code ec;
+            socket_.close(ec);
+            room_.leave(shared_from_this());
         }
 
-        inline void do_write()
+        enum
         {
-            boost::asio::async_write(socket_,
-                boost::asio::buffer(write_msgs_.front().data(), write_msgs_.front().length()),
-                [this](boost::system::error_code ec, std::size_t /*length*/) {
-                    if (!ec)
-                        {
-                            write_msgs_.pop_front();
-                            if (!write_msgs_.empty())
-                                {
-                                    do_write();
-                                }
-                        }
-                    else
-                        {
-                            socket_.close();
-                        }
-                });
-        }
+            max_gathered_msgs = 64
+        };
 
-        b_io_context& io_context_;
         boost::asio::ip::tcp::socket socket_;
+        b_strand strand_;
+        Rtcm_Listener_Room& room_;
         Rtcm_Message read_msg_;
-        std::deque<Rtcm_Message> write_msgs_;
-    };
-
-
-    class Queue_Reader
-    {
-    public:
-        Queue_Reader(b_io_context& io_context, std::shared_ptr<Concurrent_Queue<std::string>>& queue, int32_t port) : queue_(queue)
-        {
-            boost::asio::ip::tcp::resolver resolver(io_context);
-            std::string host("localhost");
-            std::string port_str = std::to_string(port);
-            auto queue_endpoint_iterator = resolver.resolve({host.c_str(), port_str.c_str()});
-            c = std::make_shared<Tcp_Internal_Client>(io_context, queue_endpoint_iterator);
-        }
-
-        inline void do_read_queue()
-        {
-            for (;;)
-                {
-                    std::string message;
-                    Rtcm_Message msg;
-                    queue_->wait_and_pop(message);  // message += '\n';
-                    if (message == "Goodbye")
-                        {
-                            break;
-                        }
-
-                    const char* char_msg = message.c_str();
-                    msg.body_length(message.length());
-                    std::memcpy(msg.body(), char_msg, msg.body_length());
-                    msg.encode_header();
-                    c->write(msg);
-                }
-        }
-
-    private:
-        std::shared_ptr<Tcp_Internal_Client> c;
-        std::shared_ptr<Concurrent_Queue<std::string>>& queue_;
+        std::mutex mutex_;                      // protects write_msgs_ and the flags below
+        std::deque<Rtcm_Buffer> write_msgs_;    // messages pending to be sent, the first in_flight_ ones are being written
+        std::vector<boost::asio::const_buffer> write_buffers_;
+        std::string client_says;
+        std::size_t max_backlog_;
+        std::size_t in_flight_{0};
+        uint64_t dropped_msgs_{0};
+        Rtcm_Backlog_Policy backlog_policy_;
+        bool write_in_progress_{false};
+        bool closing_{false};
+        bool closed_{false};
     };
 
 
     class Tcp_Server
     {
     public:
-        Tcp_Server(b_io_context& io_context, const boost::asio::ip::tcp::endpoint& endpoint)
-            : acceptor_(io_context), socket_(io_context)
+        Tcp_Server(b_io_context& io_context, const boost::asio::ip::tcp::endpoint& endpoint, std::size_t max_backlog, Rtcm_Backlog_Policy backlog_policy)
+            : io_context_(io_context),
+              acceptor_(io_context),
+              socket_(io_context),
+              max_backlog_(max_backlog),
+              backlog_policy_(backlog_policy)
         {
             acceptor_.open(endpoint.protocol());
             acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
@@ -888,10 +921,17 @@ private:
             do_accept();
         }
 
+        inline void deliver(const Rtcm_Buffer& msg)
+        {
+            room_.deliver(msg);
+        }
+
         inline void close_server()
         {
-            socket_.close();
-            acceptor_.close();
+            boost::system::error_code ec;
+            socket_.close(ec);
+            acceptor_.close(ec);
+            room_.clear();
         }
 
     private:
@@ -900,56 +940,58 @@ private:
             acceptor_.async_accept(socket_, [this](boost::system::error_code ec) {
                 if (!ec)
                     {
-                        if (first_client)
+                        bool start_session = true;
+                        std::cout << "Starting RTCM TCP/IP server session...\n";
+                        boost::system::error_code ec2;
+                        boost::asio::ip::tcp::endpoint endpoint = socket_.remote_endpoint(ec2);
+                        if (ec2)
                             {
-                                std::cout << "The TCP/IP server of RTCM messages is up and running. Accepting connections ...\n";
-                                first_client = false;
+                                // Error creating remote_endpoint
+                                std::cout << "Error getting remote IP address, closing session.\n";
+                                LOG(INFO) << "Error getting remote IP address";
+                                start_session = false;
                             }
                         else
                             {
-                                std::cout << "Starting RTCM TCP/IP server session...\n";
-                                boost::system::error_code ec2;
-                                boost::asio::ip::tcp::endpoint endpoint = socket_.remote_endpoint(ec2);
-                                if (ec2)
-                                    {
-                                        // Error creating remote_endpoint
-                                        std::cout << "Error getting remote IP address, closing session.\n";
-                                        LOG(INFO) << "Error getting remote IP address";
-                                        start_session = false;
-                                    }
-                                else
-                                    {
-                                        std::string remote_addr = endpoint.address().to_string();
-                                        std::cout << "Serving client from " << remote_addr << '\n';
-                                        LOG(INFO) << "Serving client from " << remote_addr;
-                                    }
+                                std::string remote_addr = endpoint.address().to_string();
+                                std::cout << "Serving client from " << remote_addr << '\n';
+                                LOG(INFO) << "Serving client from " << remote_addr;
                             }
                         if (start_session)
                             {
-                                std::make_shared<Rtcm_Session>(std::move(socket_), room_)->start();
+                                boost::system::error_code ec3;
+                                socket_.set_option(boost::asio::ip::tcp::no_delay(true), ec3);
+                                std::make_shared<Rtcm_Session>(io_context_, std::move(socket_), room_, max_backlog_, backlog_policy_)->start();
+                            }
+                        else
+                            {
+                                socket_.close(ec2);
                             }
                     }
+                else if (ec == boost::asio::error::operation_aborted)
+                    {
+                        return;
+                    }
                 else
                     {
                         std::cout << "Error when invoking a RTCM session. " << ec << '\n';
                     }
-                start_session = true;
                 do_accept();
             });
         }
 
+        b_io_context& io_context_;
         boost::asio::ip::tcp::acceptor acceptor_;
         boost::asio::ip::tcp::socket socket_;
         Rtcm_Listener_Room room_;
-        bool first_client = true;
-        bool start_session = true;
+        std::size_t max_backlog_;
+        Rtcm_Backlog_Policy backlog_policy_;
     };
 
     b_io_context io_context;
-    std::shared_ptr<Concurrent_Queue<std::string>> rtcm_message_queue;
-    std::thread t;
-    std::thread tq;
+    std::vector<std::thread> server_threads;
     std::list<Rtcm::Tcp_Server> servers;
+    int32_t n_server_threads;
     bool server_is_running;
     void stop_service();
 
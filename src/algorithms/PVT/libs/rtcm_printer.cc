@@ -30,6 +30,7 @@
 #include "rtklib_solver.h"
 #include <boost/exception/diagnostic_information.hpp>
 #include <glog/logging.h>
+#include <algorithm>  // for std::max
 #include <ctime>      // for tm
 #include <exception>  // for exception
 #include <fcntl.h>    // for O_RDWR
@@ -46,12 +47,15 @@ Rtcm_Printer::Rtcm_Printer(const std::string& filename,
     uint16_t rtcm_station_id,
     const std::string& rtcm_dump_devname,
     bool time_tag_name,
-    const std::string& base_path) : rtcm_base_path(base_path),
-                                    rtcm_devname(rtcm_dump_devname),
-                                    port(rtcm_tcp_port),
-                                    station_id(rtcm_station_id),
-                                    d_rtcm_writing_started(false),
-                                    d_rtcm_file_dump(flag_rtcm_file_dump)
+    const std::string& base_path,
+    int32_t rtcm_server_threads,
+    int32_t rtcm_server_max_backlog,
+    int32_t rtcm_server_backlog_policy) : rtcm_base_path(base_path),
+                                          rtcm_devname(rtcm_dump_devname),
+                                          port(rtcm_tcp_port),
+                                          station_id(rtcm_station_id),
+                                          d_rtcm_writing_started(false),
+                                          d_rtcm_file_dump(flag_rtcm_file_dump)
 {
     const boost::posix_time::ptime pt = boost::posix_time::second_clock::local_time();
     const tm timeinfo = boost::posix_time::to_tm(pt);
@@ -158,7 +162,16 @@ Rtcm_Printer::Rtcm_Printer(const std::string& filename,
             rtcm_dev_descriptor = -1;
         }
 
-    rtcm = std::make_unique<Rtcm>(port);
+    Rtcm::Rtcm_Backlog_Policy backlog_policy = Rtcm::DROP_OLDEST;
+    if (rtcm_server_backlog_policy == Rtcm::DROP_NEWEST)
+        {
+            backlog_policy = Rtcm::DROP_NEWEST;
+        }
+    else if (rtcm_server_backlog_policy == Rtcm::DISCONNECT)
+        {
+            backlog_policy = Rtcm::DISCONNECT;
+        }
+    rtcm = std::make_unique<Rtcm>(port, rtcm_server_threads, static_cast<uint32_t>(std::max(rtcm_server_max_backlog, 1)), backlog_policy);
 
     if (flag_rtcm_server)
         {
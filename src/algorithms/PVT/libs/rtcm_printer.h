@@ -58,7 +58,10 @@ public:
         uint16_t rtcm_station_id,
         const std::string& rtcm_dump_devname,
         bool time_tag_name = true,
-        const std::string& base_path = ".");
+        const std::string& base_path = ".",
+        int32_t rtcm_server_threads = 1,
+        int32_t rtcm_server_max_backlog = 256,
+        int32_t rtcm_server_backlog_policy = 0);
 
     /*!
      * \brief Default destructor.
@@ -34,6 +34,8 @@
 #include "Beidou_DNAV.h"
 #include "gnss_sdr_filesystem.h"
 #include "rtklib_conversions.h"
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
 #include "rtklib_rtkpos.h"
 #include "rtklib_solution.h"
 #include <glog/logging.h>
@@ -53,6 +55,10 @@ Rtklib_Solver::Rtklib_Solver(const rtk_t &rtk,
 {
     this->set_averaging_flag(false);
 
+    // each solver gets its own arena for the RTKLIB per-epoch temporaries,
+    // instead of sharing the one created by rtkinit() with other copies of rtk
+    d_rtk.arena = arena_new(0);
+
     // ############# ENABLE DATA FILE LOG #################
     if (d_flag_dump_enabled == true)
         {
@@ -76,6 +82,7 @@ Rtklib_Solver::Rtklib_Solver(const rtk_t &rtk,
 Rtklib_Solver::~Rtklib_Solver()
 {
     DLOG(INFO) << "Rtklib_Solver destructor called.";
+    arena_free(d_rtk.arena);
     if (d_dump_file.is_open() == true)
         {
             const auto pos = d_dump_file.tellp();
@@ -379,6 +386,13 @@ Monitor_Pvt Rtklib_Solver::get_monitor_pvt() const
 }
 
 
+void Rtklib_Solver::enable_satellite_states(bool enable)
+{
+    d_flag_sat_states = enable;
+    pvt_sat_states.clear();
+}
+
+
 bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_map, bool flag_averaging)
 {
     std::map<int, Gnss_Synchro>::const_iterator gnss_observables_iter;
@@ -904,6 +918,25 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                 {
                     this->set_num_valid_observations(d_rtk.sol.ns);  // record the number of valid satellites used by the PVT solver
                     pvt_sol = d_rtk.sol;
+                    if (d_flag_sat_states)
+                        {
+                            // satellite states at the transmission time of each observation
+                            const int n_obs = valid_obs + glo_valid_obs;
+                            std::vector<double> rs(6 * n_obs);
+                            std::vector<double> dts(2 * n_obs);
+                            std::vector<double> var(n_obs);
+                            std::vector<int> svh(n_obs);
+                            satposs(d_obs_data[0].time, d_obs_data.data(), n_obs, &nav_data, d_rtk.opt.sateph, rs.data(), dts.data(), var.data(), svh.data());
+                            pvt_sat_states.clear();
+                            for (int i = 0; i < n_obs; i++)
+                                {
+                                    if (norm_rtk(&rs[6 * i], 3) > 0.0)  // zero if there is no valid ephemeris
+                                        {
+                                            pvt_sat_states[d_obs_data[i].sat] = {rs[6 * i], rs[6 * i + 1], rs[6 * i + 2],
+                                                rs[6 * i + 3], rs[6 * i + 4], rs[6 * i + 5], dts[2 * i + 1]};
+                                        }
+                                }
+                        }
                     // DOP computation
                     unsigned int used_sats = 0;
                     for (unsigned int i = 0; i < MAXSAT; i++)
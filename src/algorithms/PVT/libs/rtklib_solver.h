@@ -78,6 +78,10 @@ public:
     Rtklib_Solver(const rtk_t& rtk, const std::string& dump_filename, bool flag_dump_to_file, bool flag_dump_to_mat);
     ~Rtklib_Solver();
 
+    // The solver owns the memory arena of d_rtk
+    Rtklib_Solver(const Rtklib_Solver&) = delete;
+    Rtklib_Solver& operator=(const Rtklib_Solver&) = delete;
+
     bool get_PVT(const std::map<int, Gnss_Synchro>& gnss_observables_map, bool flag_averaging);
 
     double get_hdop() const override;
@@ -86,8 +90,14 @@ public:
     double get_gdop() const override;
     Monitor_Pvt get_monitor_pvt() const;
 
+    /*!
+     * \brief Computes pvt_sat_states with each solution
+     */
+    void enable_satellite_states(bool enable);
+
     sol_t pvt_sol{};
     std::array<ssat_t, MAXSAT> pvt_ssat{};
+    std::map<int, std::array<double, 7>> pvt_sat_states;  //!< ECEF position [m], velocity [m/s] and clock drift [s/s] of the satellites of the last solution, by RTKLIB satellite number
 
     std::map<int, Galileo_Ephemeris> galileo_ephemeris_map;            //!< Map storing new Galileo_Ephemeris
     std::map<int, Gps_Ephemeris> gps_ephemeris_map;                    //!< Map storing new GPS_Ephemeris
@@ -124,6 +134,7 @@ private:
     std::ofstream d_dump_file;
     bool d_flag_dump_enabled;
     bool d_flag_dump_mat_enabled;
+    bool d_flag_sat_states{false};
 };
 
 
@@ -96,7 +96,7 @@ GalileoE1PcpsAmbiguousAcquisitionFpga::GalileoE1PcpsAmbiguousAcquisitionFpga(
 
     // compute all the GALILEO E1 PRN Codes (this is done only once in the class constructor in order to avoid re-computing the PRN codes every time
     // a channel is assigned)
-    auto fft_if = gnss_fft_fwd_make_unique(nsamples_total);          // Direct FFT
+    auto fft_if = gnss_fft_fwd_borrow(nsamples_total);               // Direct FFT
     volk_gnsssdr::vector<std::complex<float>> code(nsamples_total);  // buffer for the local code
     volk_gnsssdr::vector<gr_complex> fft_codes_padded(nsamples_total);
     d_all_fft_codes_ = volk_gnsssdr::vector<uint32_t>(nsamples_total * GALILEO_E1_NUMBER_OF_CODES);  // memory containing all the possible fft codes for PRN 0 to 32
@@ -96,7 +96,7 @@ GalileoE5bPcpsAcquisitionFpga::GalileoE5bPcpsAcquisitionFpga(const Configuration
 
     // compute all the GALILEO E5b PRN Codes (this is done only once in the class constructor in order to avoid re-computing the PRN codes every time
     // a channel is assigned)
-    auto fft_if = gnss_fft_fwd_make_unique(nsamples_total);          // Direct FFT
+    auto fft_if = gnss_fft_fwd_borrow(nsamples_total);               // Direct FFT
     volk_gnsssdr::vector<std::complex<float>> code(nsamples_total);  // Buffer for local code
     volk_gnsssdr::vector<std::complex<float>> fft_codes_padded(nsamples_total);
     d_all_fft_codes_ = volk_gnsssdr::vector<uint32_t>(nsamples_total * GALILEO_E5B_NUMBER_OF_CODES);  // memory containing all the possible fft codes for PRN 0 to 32
@@ -39,6 +39,7 @@
 #include <cstring>  // for memcpy
 #include <iostream>
 #include <map>
+#include <numeric>  // for accumulate
 
 
 pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_)
@@ -74,10 +75,14 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
       d_num_doppler_bins_step2(conf_.num_doppler_bins_step2),
       d_dump_channel(conf_.dump_channel),
       d_buffer_count(0U),
+      d_evaluated_doppler_bins(0U),
       d_active(false),
       d_worker_active(false),
       d_step_two(false),
       d_use_CFAR_algorithm_flag(conf_.use_CFAR_algorithm_flag),
+      d_sequential_detection(conf_.sequential_detection),
+      d_low_memory(conf_.low_memory),
+      d_low_memory_grid(conf_.low_memory and !conf_.dump and (conf_.max_dwells == 1 or conf_.bit_transition_flag)),
       d_dump(conf_.dump)
 {
     this->message_port_register_out(pmt::mp("events"));
@@ -90,7 +95,14 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
         {
             d_fft_size = d_consumed_samples * 2;
         }
-    // d_fft_size = next power of two?  ////
+    d_effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
+    if (d_acq_parameters.bit_transition_flag)
+        {
+            // Linear correlation: zero padding the FFT to a size with small prime
+            // factors does not change the results, which are still found at
+            // [d_effective_fft_size, 2 * d_effective_fft_size)
+            d_fft_size = gnss_fft_friendly_size(d_fft_size);
+        }
 
     // COD:
     // Experimenting with the overlap/save technique for handling bit trannsitions
@@ -111,8 +123,6 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
     d_tmp_buffer = volk_gnsssdr::vector<float>(d_fft_size);
     d_fft_codes = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
     d_input_signal = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
-    d_fft_if = gnss_fft_fwd_make_unique(d_fft_size);
-    d_ifft = gnss_fft_rev_make_unique(d_fft_size);
 
     d_grid = arma::fmat();
     d_narrow_grid = arma::fmat();
@@ -185,27 +195,28 @@ void pcps_acquisition::set_local_code(std::complex<float>* code)
     // [ 0 0 0 ... 0 c_0 c_1 ... c_L]
     // where c_i is the local code and there are L zeros and L chips
     gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    const auto fft_if = gnss_fft_fwd_borrow(d_fft_size);
     if (d_acq_parameters.bit_transition_flag)
         {
-            const int32_t offset = d_fft_size / 2;
-            std::fill_n(d_fft_if->get_inbuf(), offset, gr_complex(0.0, 0.0));
-            memcpy(d_fft_if->get_inbuf() + offset, code, sizeof(gr_complex) * offset);
+            const int32_t offset = d_fft_size - d_effective_fft_size;
+            std::fill_n(fft_if->get_inbuf(), offset, gr_complex(0.0, 0.0));
+            memcpy(fft_if->get_inbuf() + offset, code, sizeof(gr_complex) * d_effective_fft_size);
         }
     else
         {
             if (d_acq_parameters.sampled_ms == d_acq_parameters.ms_per_code)
                 {
-                    memcpy(d_fft_if->get_inbuf(), code, sizeof(gr_complex) * d_consumed_samples);
+                    memcpy(fft_if->get_inbuf(), code, sizeof(gr_complex) * d_consumed_samples);
                 }
             else
                 {
-                    std::fill_n(d_fft_if->get_inbuf(), d_fft_size - d_consumed_samples, gr_complex(0.0, 0.0));
-                    memcpy(d_fft_if->get_inbuf() + d_consumed_samples, code, sizeof(gr_complex) * d_consumed_samples);
+                    std::fill_n(fft_if->get_inbuf(), d_fft_size - d_consumed_samples, gr_complex(0.0, 0.0));
+                    memcpy(fft_if->get_inbuf() + d_consumed_samples, code, sizeof(gr_complex) * d_consumed_samples);
                 }
         }
 
-    d_fft_if->execute();  // We need the FFT of local code
-    volk_32fc_conjugate_32fc(d_fft_codes.data(), d_fft_if->get_outbuf(), d_fft_size);
+    fft_if->execute();  // We need the FFT of local code
+    volk_32fc_conjugate_32fc(d_fft_codes.data(), fft_if->get_outbuf(), d_fft_size);
 }
 
 
@@ -230,17 +241,29 @@ bool pcps_acquisition::is_fdma()
 }
 
 
-void pcps_acquisition::update_local_carrier(own::span<gr_complex> carrier_vector, float freq) const
+float pcps_acquisition::carrier_phase_step_rad(float freq) const
 {
-    float phase_step_rad;
     if (d_acq_parameters.use_automatic_resampler)
         {
-            phase_step_rad = static_cast<float>(TWO_PI) * freq / static_cast<float>(d_acq_parameters.resampled_fs);
+            return static_cast<float>(TWO_PI) * freq / static_cast<float>(d_acq_parameters.resampled_fs);
         }
-    else
+    return static_cast<float>(TWO_PI) * freq / static_cast<float>(d_acq_parameters.fs_in);
+}
+
+
+float pcps_acquisition::doppler_bin_hz(uint32_t doppler_index, bool step_two) const
+{
+    if (step_two)
         {
-            phase_step_rad = static_cast<float>(TWO_PI) * freq / static_cast<float>(d_acq_parameters.fs_in);
+            return d_doppler_center_step_two + (static_cast<float>(doppler_index) - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0))) * d_acq_parameters.doppler_step2;
         }
+    return static_cast<float>(-static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center + static_cast<int32_t>(d_doppler_step * doppler_index));
+}
+
+
+void pcps_acquisition::update_local_carrier(own::span<gr_complex> carrier_vector, float freq) const
+{
+    const float phase_step_rad = carrier_phase_step_rad(freq);
     std::array<float, 1> _phase{};
     volk_gnsssdr_s32f_sincos_32fc(carrier_vector.data(), -phase_step_rad, _phase.data(), carrier_vector.size());
 }
@@ -261,54 +284,85 @@ void pcps_acquisition::init()
 
     d_num_doppler_bins = static_cast<uint32_t>(std::ceil(static_cast<double>(static_cast<int32_t>(d_acq_parameters.doppler_max) - static_cast<int32_t>(-d_acq_parameters.doppler_max)) / static_cast<double>(d_doppler_step)));
 
-    // Create the carrier Doppler wipeoff signals
-    if (d_grid_doppler_wipeoffs.empty())
+    // Create the carrier Doppler wipeoff signals (generated on the fly in low memory mode)
+    if (d_grid_doppler_wipeoffs.empty() and !d_low_memory)
         {
             d_grid_doppler_wipeoffs = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(d_num_doppler_bins, volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
         }
-    if (d_acq_parameters.make_2_steps && (d_grid_doppler_wipeoffs_step_two.empty()))
+    if (d_acq_parameters.make_2_steps && (d_grid_doppler_wipeoffs_step_two.empty()) && !d_low_memory)
         {
             d_grid_doppler_wipeoffs_step_two = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(d_num_doppler_bins_step2, volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
         }
 
     if (d_magnitude_grid.empty())
         {
-            d_magnitude_grid = volk_gnsssdr::vector<volk_gnsssdr::vector<float>>(d_num_doppler_bins, volk_gnsssdr::vector<float>(d_fft_size));
+            // Without non-coherent integration nor dump, only the current bin and the one with the peak are kept
+            const uint32_t num_rows = (d_low_memory_grid ? 2 : d_num_doppler_bins);
+            d_magnitude_grid = volk_gnsssdr::vector<volk_gnsssdr::vector<float>>(num_rows, volk_gnsssdr::vector<float>(d_fft_size));
+        }
+    if (d_low_memory_grid)
+        {
+            d_doppler_bin_sums = std::vector<float>(std::max(d_num_doppler_bins, d_num_doppler_bins_step2), 0.0);
         }
 
-    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+    for (auto& magnitude : d_magnitude_grid)
         {
-            std::fill(d_magnitude_grid[doppler_index].begin(), d_magnitude_grid[doppler_index].end(), 0.0);
+            std::fill(magnitude.begin(), magnitude.end(), 0.0);
         }
 
     update_grid_doppler_wipeoffs();
     d_worker_active = false;
 
+    if (d_sequential_detection)
+        {
+            // Bins sorted by their distance to the center of the grid
+            const auto center_index = static_cast<int32_t>(d_num_doppler_bins / 2);
+            d_doppler_bin_order.clear();
+            d_doppler_bin_order.push_back(center_index);
+            for (int32_t offset = 1; d_doppler_bin_order.size() < d_num_doppler_bins; offset++)
+                {
+                    if (center_index + offset < static_cast<int32_t>(d_num_doppler_bins))
+                        {
+                            d_doppler_bin_order.push_back(center_index + offset);
+                        }
+                    if (center_index - offset >= 0)
+                        {
+                            d_doppler_bin_order.push_back(center_index - offset);
+                        }
+                }
+            calculate_sequential_thresholds();
+        }
+
     if (d_dump)
         {
-            const uint32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? (d_fft_size / 2) : d_fft_size);
-            d_grid = arma::fmat(effective_fft_size, d_num_doppler_bins, arma::fill::zeros);
-            d_narrow_grid = arma::fmat(effective_fft_size, d_num_doppler_bins_step2, arma::fill::zeros);
+            d_grid = arma::fmat(d_effective_fft_size, d_num_doppler_bins, arma::fill::zeros);
+            d_narrow_grid = arma::fmat(d_effective_fft_size, d_num_doppler_bins_step2, arma::fill::zeros);
         }
 }
 
 
 void pcps_acquisition::update_grid_doppler_wipeoffs()
 {
+    if (d_low_memory)
+        {
+            return;
+        }
     for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
         {
-            const int32_t doppler = -static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center + d_doppler_step * doppler_index;
-            update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], static_cast<float>(d_doppler_bias + doppler));
+            update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], static_cast<float>(d_doppler_bias) + doppler_bin_hz(doppler_index, false));
         }
 }
 
 
 void pcps_acquisition::update_grid_doppler_wipeoffs_step2()
 {
+    if (d_low_memory)
+        {
+            return;
+        }
     for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_step2; doppler_index++)
         {
-            const float doppler = (static_cast<float>(doppler_index) - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0))) * d_acq_parameters.doppler_step2;
-            update_local_carrier(d_grid_doppler_wipeoffs_step_two[doppler_index], d_doppler_center_step_two + doppler);
+            update_local_carrier(d_grid_doppler_wipeoffs_step_two[doppler_index], doppler_bin_hz(doppler_index, true));
         }
 }
 
@@ -500,7 +554,7 @@ float pcps_acquisition::max_to_input_power_statistic(uint32_t& indext, int32_t&
     uint32_t index_doppler = 0U;
     uint32_t tmp_intex_t = 0U;
     uint32_t index_time = 0U;
-    const int32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
+    const auto effective_fft_size = static_cast<int32_t>(d_effective_fft_size);
 
     // Find the correlation peak and the carrier frequency
     for (uint32_t i = 0; i < num_doppler_bins; i++)
@@ -562,6 +616,13 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
             doppler = static_cast<int32_t>(d_doppler_center_step_two + (static_cast<float>(index_doppler) - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0))) * d_acq_parameters.doppler_step2);
         }
 
+    // Compute the test statistics and compare to the threshold
+    return firstPeak / second_peak(d_magnitude_grid[index_doppler].data(), index_time);
+}
+
+
+float pcps_acquisition::second_peak(const float* magnitude, uint32_t index_time)
+{
     // Find 1 chip wide code phase exclude range around the peak
     int32_t excludeRangeIndex1 = index_time - d_samplesPerChip;
     int32_t excludeRangeIndex2 = index_time + d_samplesPerChip;
@@ -577,7 +638,7 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
         }
 
     int32_t idx = excludeRangeIndex1;
-    memcpy(d_tmp_buffer.data(), d_magnitude_grid[index_doppler].data(), d_fft_size * sizeof(float));
+    memcpy(d_tmp_buffer.data(), magnitude, d_fft_size * sizeof(float));
     do
         {
             d_tmp_buffer[idx] = 0.0;
@@ -590,11 +651,165 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
     while (idx != excludeRangeIndex2);
 
     // Find the second highest correlation peak in the same freq. bin ---
+    uint32_t tmp_intex_t = 0U;
     volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_tmp_buffer.data(), d_fft_size);
-    const float secondPeak = d_tmp_buffer[tmp_intex_t];
+    return d_tmp_buffer[tmp_intex_t];
+}
 
-    // Compute the test statistics and compare to the threshold
-    return firstPeak / secondPeak;
+
+void pcps_acquisition::correlate_doppler_bin(const gr_complex* in, uint32_t doppler_index, float* magnitude, int32_t effective_fft_size)
+{
+    // Remove Doppler
+    if (d_low_memory)
+        {
+            // Generate the carrier on the fly, fused with the multiplication
+            const float doppler_hz = (d_step_two ? doppler_bin_hz(doppler_index, true) : static_cast<float>(d_doppler_bias) + doppler_bin_hz(doppler_index, false));
+            const float phase_step_rad = carrier_phase_step_rad(doppler_hz);
+            const lv_32fc_t phase_increment = lv_cmake(std::cos(phase_step_rad), -std::sin(phase_step_rad));
+            lv_32fc_t phase = lv_cmake(1.0F, 0.0F);
+#if VOLK_HAS_ROTATOR2
+            volk_32fc_s32fc_x2_rotator2_32fc(d_fft_if->get_inbuf(), in, &phase_increment, &phase, d_fft_size);
+#else
+            volk_32fc_s32fc_x2_rotator_32fc(d_fft_if->get_inbuf(), in, phase_increment, &phase, d_fft_size);
+#endif
+        }
+    else
+        {
+            const auto& doppler_wipeoff = (d_step_two ? d_grid_doppler_wipeoffs_step_two[doppler_index] : d_grid_doppler_wipeoffs[doppler_index]);
+            volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, doppler_wipeoff.data(), d_fft_size);
+        }
+
+    // Perform the FFT-based convolution  (parallel time search)
+    // Compute the FFT of the carrier wiped--off incoming signal
+    d_fft_if->execute();
+
+    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
+    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
+
+    // Compute the inverse FFT
+    d_ifft->execute();
+
+    // Compute squared magnitude (and accumulate in case of non-coherent integration)
+    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
+    if (d_num_noncoherent_integrations_counter == 1)
+        {
+            volk_32fc_magnitude_squared_32f(magnitude, d_ifft->get_outbuf() + offset, effective_fft_size);
+        }
+    else
+        {
+            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
+            volk_32f_x2_add_32f(magnitude, magnitude, d_tmp_buffer.data(), effective_fft_size);
+        }
+}
+
+
+float pcps_acquisition::sequential_search_statistic(const gr_complex* in, uint32_t& indext, int32_t& doppler)
+{
+    // Same statistic as max_to_input_power_statistic, but the input power is
+    // estimated from all the evaluated bins except the one holding the peak,
+    // so that it can be tested after each bin
+    const float threshold = d_sequential_thresholds[std::min(d_num_noncoherent_integrations_counter, d_acq_parameters.max_dwells)];
+    float grid_maximum = 0.0;
+    float test_statistic = 0.0;
+    double noise_sum = 0.0;
+    double peak_bin_sum = 0.0;
+    uint32_t index_doppler = 0U;
+    uint32_t tmp_intex_t = 0U;
+    d_evaluated_doppler_bins = 0U;
+
+    for (const uint32_t doppler_index : d_doppler_bin_order)
+        {
+            float* magnitude = d_magnitude_grid[d_low_memory_grid ? 0 : doppler_index].data();
+            correlate_doppler_bin(in, doppler_index, magnitude, d_fft_size);
+            d_evaluated_doppler_bins++;
+
+            // Record results to file if required
+            if (d_dump and d_channel == d_dump_channel)
+                {
+                    memcpy(d_grid.colptr(doppler_index), magnitude, sizeof(float) * d_fft_size);
+                }
+
+            const double bin_sum = std::accumulate(magnitude, magnitude + d_fft_size, 0.0);
+            volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, magnitude, d_fft_size);
+            if (magnitude[tmp_intex_t] > grid_maximum or d_evaluated_doppler_bins == 1)
+                {
+                    noise_sum += peak_bin_sum;
+                    peak_bin_sum = bin_sum;
+                    grid_maximum = magnitude[tmp_intex_t];
+                    index_doppler = doppler_index;
+                    indext = tmp_intex_t;
+                }
+            else
+                {
+                    noise_sum += bin_sum;
+                }
+
+            const double noise_bins = (d_evaluated_doppler_bins > 1 ? d_evaluated_doppler_bins - 1 : 1);
+            const double noise = (d_evaluated_doppler_bins > 1 ? noise_sum : peak_bin_sum);
+            d_input_power = static_cast<float>(noise / noise_bins / d_fft_size / 2.0 / d_num_noncoherent_integrations_counter);
+            if (d_input_power > 0.0)
+                {
+                    test_statistic = grid_maximum / d_input_power;
+                    if (d_evaluated_doppler_bins > 1 and test_statistic > threshold)
+                        {
+                            break;
+                        }
+                }
+        }
+
+    // The dumped grid must not show the bins of a previous dwell
+    if (d_dump and d_channel == d_dump_channel)
+        {
+            for (auto it = d_doppler_bin_order.cbegin() + d_evaluated_doppler_bins; it != d_doppler_bin_order.cend(); ++it)
+                {
+                    d_grid.col(*it).zeros();
+                }
+        }
+
+    doppler = -static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center + static_cast<int32_t>(d_doppler_step) * static_cast<int32_t>(index_doppler);
+    return test_statistic;
+}
+
+
+float pcps_acquisition::low_memory_search_statistic(const gr_complex* in, uint32_t& indext, int32_t& doppler, int32_t effective_fft_size)
+{
+    // Same statistics as max_to_input_power_statistic and
+    // first_vs_second_peak_statistic, computed while the grid is swept. Only
+    // the current bin (row 0), the bin with the peak (row 1) and the sum of
+    // each bin are kept
+    const uint32_t num_doppler_bins = (d_step_two ? d_num_doppler_bins_step2 : d_num_doppler_bins);
+    float grid_maximum = 0.0;
+    uint32_t index_doppler = 0U;
+    uint32_t tmp_intex_t = 0U;
+
+    for (uint32_t doppler_index = 0; doppler_index < num_doppler_bins; doppler_index++)
+        {
+            correlate_doppler_bin(in, doppler_index, d_magnitude_grid[0].data(), effective_fft_size);
+            volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_magnitude_grid[0].data(), effective_fft_size);
+            if (d_use_CFAR_algorithm_flag)
+                {
+                    d_doppler_bin_sums[doppler_index] = std::accumulate(d_magnitude_grid[0].data(), d_magnitude_grid[0].data() + effective_fft_size, static_cast<float>(0.0));
+                }
+            if (d_magnitude_grid[0][tmp_intex_t] > grid_maximum)
+                {
+                    grid_maximum = d_magnitude_grid[0][tmp_intex_t];
+                    index_doppler = doppler_index;
+                    indext = tmp_intex_t;
+                    std::swap(d_magnitude_grid[0], d_magnitude_grid[1]);
+                }
+        }
+    doppler = static_cast<int32_t>(doppler_bin_hz(index_doppler, d_step_two));
+
+    if (!d_use_CFAR_algorithm_flag)
+        {
+            return grid_maximum / second_peak(d_magnitude_grid[1].data(), indext);
+        }
+    if (!d_step_two)
+        {
+            const auto index_opp = (index_doppler + d_num_doppler_bins / 2) % d_num_doppler_bins;
+            d_input_power = static_cast<float>(d_doppler_bin_sums[index_opp] / effective_fft_size / 2.0 / d_num_noncoherent_integrations_counter);
+        }
+    return grid_maximum / d_input_power;
 }
 
 
@@ -605,7 +820,7 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
     // Initialize acquisition algorithm
     int32_t doppler = 0;
     uint32_t indext = 0U;
-    const int32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
+    const auto effective_fft_size = static_cast<int32_t>(d_effective_fft_size);
     if (d_cshort)
         {
             volk_gnsssdr_16ic_convert_32fc(d_data_buffer.data(), d_data_buffer_sc.data(), d_consumed_samples);
@@ -620,6 +835,10 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
         }
     const gr_complex* in = d_input_signal.data();  // Get the input samples pointer
 
+    // The FFT objects are shared with other blocks, and only held while searching
+    d_fft_if = gnss_fft_fwd_borrow(d_fft_size);
+    d_ifft = gnss_fft_rev_borrow(d_fft_size);
+
     d_mag = 0.0;
     d_num_noncoherent_integrations_counter++;
 
@@ -638,48 +857,39 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
     // Doppler frequency grid loop
     if (!d_step_two)
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+            if (d_sequential_detection)
                 {
-                    // Remove Doppler
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
-
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
+                    d_test_statistics = sequential_search_statistic(in, indext, doppler);
+                    DLOG(INFO) << "Channel: " << d_channel << " , sequential detection evaluated "
+                               << d_evaluated_doppler_bins << " of " << d_num_doppler_bins << " Doppler bins";
+                }
+            else if (d_low_memory_grid)
+                {
+                    d_test_statistics = low_memory_search_statistic(in, indext, doppler, effective_fft_size);
+                }
+            else
+                {
+                    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+                        {
+                            correlate_doppler_bin(in, doppler_index, d_magnitude_grid[doppler_index].data(), effective_fft_size);
 
-                    // Compute the inverse FFT
-                    d_ifft->execute();
+                            // Record results to file if required
+                            if (d_dump and d_channel == d_dump_channel)
+                                {
+                                    memcpy(d_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
+                                }
+                        }
 
-                    // Compute squared magnitude (and accumulate in case of non-coherent integration)
-                    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
+                    // Compute the test statistic
+                    if (d_use_CFAR_algorithm_flag)
                         {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
+                            d_test_statistics = max_to_input_power_statistic(indext, doppler, d_num_doppler_bins, d_acq_parameters.doppler_max, d_doppler_step);
                         }
                     else
                         {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
-                        }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
-                        {
-                            memcpy(d_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
+                            d_test_statistics = first_vs_second_peak_statistic(indext, doppler, d_num_doppler_bins, d_acq_parameters.doppler_max, d_doppler_step);
                         }
                 }
-
-            // Compute the test statistic
-            if (d_use_CFAR_algorithm_flag)
-                {
-                    d_test_statistics = max_to_input_power_statistic(indext, doppler, d_num_doppler_bins, d_acq_parameters.doppler_max, d_doppler_step);
-                }
-            else
-                {
-                    d_test_statistics = first_vs_second_peak_statistic(indext, doppler, d_num_doppler_bins, d_acq_parameters.doppler_max, d_doppler_step);
-                }
             if (d_acq_parameters.use_automatic_resampler)
                 {
                     // take into account the acquisition resampler ratio
@@ -697,46 +907,32 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
         }
     else
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_step2; doppler_index++)
+            if (d_low_memory_grid)
                 {
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs_step_two[doppler_index].data(), d_fft_size);
-
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal
-                    // with the local FFT'd code reference using SIMD operations with VOLK library
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
-
-                    // compute the inverse FFT
-                    d_ifft->execute();
-
-                    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
+                    d_test_statistics = low_memory_search_statistic(in, indext, doppler, effective_fft_size);
+                }
+            else
+                {
+                    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_step2; doppler_index++)
                         {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
+                            correlate_doppler_bin(in, doppler_index, d_magnitude_grid[doppler_index].data(), effective_fft_size);
+
+                            // Record results to file if required
+                            if (d_dump and d_channel == d_dump_channel)
+                                {
+                                    memcpy(d_narrow_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
+                                }
                         }
-                    else
+                    // Compute the test statistic
+                    if (d_use_CFAR_algorithm_flag)
                         {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
+                            d_test_statistics = max_to_input_power_statistic(indext, doppler, d_num_doppler_bins_step2, static_cast<int32_t>(d_doppler_center_step_two - (static_cast<float>(d_num_doppler_bins_step2) / 2.0) * d_acq_parameters.doppler_step2), d_acq_parameters.doppler_step2);
                         }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
+                    else
                         {
-                            memcpy(d_narrow_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
+                            d_test_statistics = first_vs_second_peak_statistic(indext, doppler, d_num_doppler_bins_step2, static_cast<int32_t>(d_doppler_center_step_two - (static_cast<float>(d_num_doppler_bins_step2) / 2.0) * d_acq_parameters.doppler_step2), d_acq_parameters.doppler_step2);
                         }
                 }
-            // Compute the test statistic
-            if (d_use_CFAR_algorithm_flag)
-                {
-                    d_test_statistics = max_to_input_power_statistic(indext, doppler, d_num_doppler_bins_step2, static_cast<int32_t>(d_doppler_center_step_two - (static_cast<float>(d_num_doppler_bins_step2) / 2.0) * d_acq_parameters.doppler_step2), d_acq_parameters.doppler_step2);
-                }
-            else
-                {
-                    d_test_statistics = first_vs_second_peak_statistic(indext, doppler, d_num_doppler_bins_step2, static_cast<int32_t>(d_doppler_center_step_two - (static_cast<float>(d_num_doppler_bins_step2) / 2.0) * d_acq_parameters.doppler_step2), d_acq_parameters.doppler_step2);
-                }
 
             if (d_acq_parameters.use_automatic_resampler)
                 {
@@ -756,14 +952,22 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                 }
         }
 
+    d_fft_if.reset();
+    d_ifft.reset();
+
     if (d_acq_parameters.blocking)
         {
             lk.lock();
         }
 
+    // In sequential detection mode, each dwell of the first step has its own thresholds
+    const bool sequential_test = d_sequential_detection and !d_step_two;
+    const uint32_t dwell = std::min(d_num_noncoherent_integrations_counter, d_acq_parameters.max_dwells);
+    const float threshold = (sequential_test ? d_sequential_thresholds[dwell] : d_threshold);
+    bool dismissed = false;
     if (!d_acq_parameters.bit_transition_flag)
         {
-            if (d_test_statistics > d_threshold)
+            if (d_test_statistics > threshold)
                 {
                     d_active = false;
                     if (d_acq_parameters.make_2_steps)
@@ -793,9 +997,11 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                 {
                     d_buffer_count = 0;
                     d_state = 1;
+                    // Give up before max_dwells if the grid looks like noise only
+                    dismissed = sequential_test and (d_test_statistics < d_sequential_dismissal_thresholds[dwell]);
                 }
 
-            if (d_num_noncoherent_integrations_counter == d_acq_parameters.max_dwells)
+            if ((d_num_noncoherent_integrations_counter == d_acq_parameters.max_dwells) or dismissed)
                 {
                     if (d_state != 0)
                         {
@@ -852,7 +1058,7 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
         }
     d_worker_active = false;
 
-    if ((d_num_noncoherent_integrations_counter == d_acq_parameters.max_dwells) or (d_positive_acq == 1) or (d_acq_parameters.bit_transition_flag))
+    if ((d_num_noncoherent_integrations_counter == d_acq_parameters.max_dwells) or dismissed or (d_positive_acq == 1) or (d_acq_parameters.bit_transition_flag))
         {
             // Record results to file if required
             if (d_dump and d_channel == d_dump_channel)
@@ -883,7 +1089,7 @@ void pcps_acquisition::calculate_threshold()
             return;
         }
 
-    const auto effective_fft_size = static_cast<int>(d_acq_parameters.bit_transition_flag ? (d_fft_size / 2) : d_fft_size);
+    const auto effective_fft_size = static_cast<int>(d_effective_fft_size);
     const int num_doppler_bins = (d_step_two ? d_num_doppler_bins_step2 : d_num_doppler_bins);
 
     const int num_bins = effective_fft_size * num_doppler_bins;
@@ -892,6 +1098,34 @@ void pcps_acquisition::calculate_threshold()
 }
 
 
+void pcps_acquisition::calculate_sequential_thresholds()
+{
+    // The statistic is tested after each dwell, so the false alarm probability
+    // is shared among the max_dwells tests
+    const double pfa_per_test = d_acq_parameters.pfa / static_cast<double>(d_acq_parameters.max_dwells);
+    const double dismissal_prob = d_acq_parameters.sequential_dismissal_prob;
+    const double num_bins = static_cast<double>(d_fft_size) * static_cast<double>(d_num_doppler_bins);
+
+    d_sequential_thresholds = std::vector<float>(d_acq_parameters.max_dwells + 1, 0.0);
+    d_sequential_dismissal_thresholds = std::vector<float>(d_acq_parameters.max_dwells + 1, 0.0);
+    if (pfa_per_test <= 0.0 or num_bins == 0.0)
+        {
+            return;
+        }
+    for (uint32_t dwell = 1; dwell <= d_acq_parameters.max_dwells; dwell++)
+        {
+            // Same (conservative) expression as in calculate_threshold()
+            d_sequential_thresholds[dwell] = static_cast<float>(2.0 * boost::math::gamma_p_inv(2.0 * dwell, std::pow(1.0 - pfa_per_test, 1.0 / num_bins)));
+            if (dismissal_prob > 0.0 and dwell < d_acq_parameters.max_dwells)
+                {
+                    // Each noise-only cell is chi-square distributed with 2 * dwell degrees of freedom.
+                    // The peak of a noise-only grid stays below this value with probability dismissal_prob
+                    d_sequential_dismissal_thresholds[dwell] = static_cast<float>(2.0 * boost::math::gamma_p_inv(static_cast<double>(dwell), std::pow(dismissal_prob, 1.0 / num_bins)));
+                }
+        }
+}
+
+
 int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
     gr_vector_int& ninput_items,
     gr_vector_const_void_star& input_items,
@@ -908,12 +1142,35 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
      * 6. Declare positive or negative acquisition using a message port
      */
     gr::thread::scoped_lock lk(d_setlock);
+
+    // The first item after a gap in the input stream (see
+    // gnss_sdr_sample_ring_source) carries its absolute sample index. Samples
+    // from both sides of a gap never go to the same search.
+    int32_t ninput = ninput_items[0];
+    if (d_state != 2 or !d_active or d_worker_active)
+        {
+            get_tags_in_window(d_sample_counter_tags, 0, 0, ninput, pmt::mp("sample_counter"));
+            for (const auto& tag : d_sample_counter_tags)
+                {
+                    const auto offset = static_cast<int32_t>(tag.offset - nitems_read(0));
+                    if (offset == 0)
+                        {
+                            d_sample_counter = pmt::to_uint64(tag.value);
+                            d_buffer_count = 0U;
+                        }
+                    else
+                        {
+                            ninput = std::min(ninput, offset);
+                        }
+                }
+        }
+
     if (!d_active or d_worker_active)
         {
             if (!d_acq_parameters.blocking_on_standby)
                 {
-                    d_sample_counter += static_cast<uint64_t>(ninput_items[0]);
-                    consume_each(ninput_items[0]);
+                    d_sample_counter += static_cast<uint64_t>(ninput);
+                    consume_each(ninput);
                 }
             if (d_step_two)
                 {
@@ -939,8 +1196,8 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
                 d_buffer_count = 0U;
                 if (!d_acq_parameters.blocking_on_standby)
                     {
-                        d_sample_counter += static_cast<uint64_t>(ninput_items[0]);  // sample counter
-                        consume_each(ninput_items[0]);
+                        d_sample_counter += static_cast<uint64_t>(ninput);  // sample counter
+                        consume_each(ninput);
                     }
                 break;
             }
@@ -950,9 +1207,9 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
                 if (d_cshort)
                     {
                         const auto* in = reinterpret_cast<const lv_16sc_t*>(input_items[0]);  // Get the input samples pointer
-                        if ((ninput_items[0] + d_buffer_count) <= d_consumed_samples)
+                        if ((ninput + d_buffer_count) <= d_consumed_samples)
                             {
-                                buff_increment = ninput_items[0];
+                                buff_increment = ninput;
                             }
                         else
                             {
@@ -963,9 +1220,9 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
                 else
                     {
                         const auto* in = reinterpret_cast<const gr_complex*>(input_items[0]);  // Get the input samples pointer
-                        if ((ninput_items[0] + d_buffer_count) <= d_consumed_samples)
+                        if ((ninput + d_buffer_count) <= d_consumed_samples)
                             {
-                                buff_increment = ninput_items[0];
+                                buff_increment = ninput;
                             }
                         else
                             {
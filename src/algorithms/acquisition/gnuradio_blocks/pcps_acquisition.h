@@ -59,6 +59,7 @@
 #include <queue>
 #include <string>
 #include <utility>
+#include <vector>
 
 #if HAS_STD_SPAN
 #include <span>
@@ -88,6 +89,18 @@ pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_);
  *
  * Check \ref Navitec2012 "An Open Source Galileo E1 Software Receiver",
  * Algorithm 1, for a pseudocode description of this implementation.
+ *
+ * If sequential_detection is set, the Doppler bins of the first step are
+ * evaluated outwards from the center of the grid, and the test statistic is
+ * checked after each bin against a threshold computed for the current
+ * number of dwells. The search stops as soon as a satellite is detected, and
+ * it is dismissed before max_dwells if the grid is below the noise level
+ * given by sequential_dismissal_prob.
+ *
+ * If low_memory is set, the carrier Doppler wipeoffs are generated on the
+ * fly instead of being stored for each bin of the grid. Without non-coherent
+ * integration nor dump, the magnitude grid is not stored either: only the
+ * current bin and the one holding the peak are kept.
  */
 class pcps_acquisition : public gr::block
 {
@@ -133,6 +146,31 @@ public:
         return d_mag;
     }
 
+    /*!
+     * \brief Returns the test statistic of the last dwell.
+     */
+    inline float test_statistic() const
+    {
+        return d_test_statistics;
+    }
+
+    /*!
+     * \brief Returns the number of Doppler bins of the first step grid.
+     */
+    inline uint32_t num_doppler_bins() const
+    {
+        return d_num_doppler_bins;
+    }
+
+    /*!
+     * \brief Returns the number of Doppler bins evaluated in the last dwell
+     * of the first step, if sequential_detection is set.
+     */
+    inline uint32_t evaluated_doppler_bins() const
+    {
+        return d_evaluated_doppler_bins;
+    }
+
     /*!
      * \brief Starts acquisition algorithm, turning from standby mode to
      * active mode
@@ -219,6 +257,8 @@ private:
     explicit pcps_acquisition(const Acq_Conf& conf_);
 
     void update_local_carrier(own::span<gr_complex> carrier_vector, float freq) const;
+    float carrier_phase_step_rad(float freq) const;
+    float doppler_bin_hz(uint32_t doppler_index, bool step_two) const;
     void update_grid_doppler_wipeoffs();
     void update_grid_doppler_wipeoffs_step2();
     void acquisition_core(uint64_t samp_count);
@@ -228,6 +268,11 @@ private:
     bool is_fdma();
     bool start() override;
     void calculate_threshold(void);
+    void calculate_sequential_thresholds();
+    void correlate_doppler_bin(const gr_complex* in, uint32_t doppler_index, float* magnitude, int32_t effective_fft_size);
+    float sequential_search_statistic(const gr_complex* in, uint32_t& indext, int32_t& doppler);
+    float low_memory_search_statistic(const gr_complex* in, uint32_t& indext, int32_t& doppler, int32_t effective_fft_size);
+    float second_peak(const float* magnitude, uint32_t index_time);
     float first_vs_second_peak_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
     float max_to_input_power_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
 
@@ -240,8 +285,8 @@ private:
     volk_gnsssdr::vector<std::complex<float>> d_data_buffer;
     volk_gnsssdr::vector<lv_16sc_t> d_data_buffer_sc;
 
-    std::unique_ptr<gnss_fft_complex_fwd> d_fft_if;
-    std::unique_ptr<gnss_fft_complex_rev> d_ifft;
+    gnss_fft_fwd_borrowed_ptr d_fft_if;  // borrowed only while searching
+    gnss_fft_rev_borrowed_ptr d_ifft;    // borrowed only while searching
     std::weak_ptr<ChannelFsm> d_channel_fsm;
 
     Acq_Conf d_acq_parameters;
@@ -250,6 +295,11 @@ private:
     arma::fmat d_narrow_grid;
 
     std::queue<Gnss_Synchro> d_monitor_queue;
+    std::vector<gr::tag_t> d_sample_counter_tags;
+    std::vector<uint32_t> d_doppler_bin_order;
+    std::vector<float> d_sequential_thresholds;            // indexed by the number of dwells
+    std::vector<float> d_sequential_dismissal_thresholds;  // indexed by the number of dwells
+    std::vector<float> d_doppler_bin_sums;                 // only in low memory mode
     std::string d_dump_filename;
 
     int64_t d_dump_number;
@@ -270,17 +320,22 @@ private:
     uint32_t d_doppler_step;
     uint32_t d_num_noncoherent_integrations_counter;
     uint32_t d_fft_size;
+    uint32_t d_effective_fft_size;
     uint32_t d_consumed_samples;
     uint32_t d_num_doppler_bins;
     uint32_t d_num_doppler_bins_step2;
     uint32_t d_dump_channel;
     uint32_t d_buffer_count;
+    uint32_t d_evaluated_doppler_bins;
 
     bool d_active;
     bool d_worker_active;
     bool d_cshort;
     bool d_step_two;
     bool d_use_CFAR_algorithm_flag;
+    bool d_sequential_detection;
+    bool d_low_memory;
+    bool d_low_memory_grid;
     bool d_dump;
 };
 
@@ -352,7 +352,7 @@ int pcps_acquisition_fine_doppler_cc::estimate_Doppler()
     // int fft_size_extended = nextPowerOf2(signal_samples * zero_padding_factor);
     int fft_size_extended = signal_samples * zero_padding_factor;
 
-    auto fft_operator = gnss_fft_fwd_make_unique(fft_size_extended);
+    auto fft_operator = gnss_fft_fwd_borrow(fft_size_extended);
 
     // zero padding the entire vector
     std::fill_n(fft_operator->get_inbuf(), fft_size_extended, gr_complex(0.0, 0.0));
@@ -76,6 +76,7 @@ void Acq_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
         }
     make_2_steps = configuration->property(role + ".make_two_steps", make_2_steps);
     blocking_on_standby = configuration->property(role + ".blocking_on_standby", blocking_on_standby);
+    low_memory = configuration->property(role + ".low_memory", low_memory);
 
     if (pfa <= 0.0)
         {
@@ -83,6 +84,19 @@ void Acq_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
             use_CFAR_algorithm_flag = false;
         }
 
+    sequential_detection = configuration->property(role + ".sequential_detection", sequential_detection);
+    sequential_dismissal_prob = configuration->property(role + ".sequential_dismissal_prob", sequential_dismissal_prob);
+    if (sequential_detection and (!use_CFAR_algorithm_flag or bit_transition_flag))
+        {
+            LOG(WARNING) << "Parameter sequential_detection requires pfa > 0.0 and bit_transition_flag=false. Disabling it";
+            sequential_detection = false;
+        }
+    if ((sequential_dismissal_prob < 0.0) or (sequential_dismissal_prob >= 1.0))
+        {
+            LOG(WARNING) << "Parameter sequential_dismissal_prob should be between 0.0 and 1.0. Setting it to 0.0";
+            sequential_dismissal_prob = 0.0;
+        }
+
     enable_monitor_output = configuration->property("AcquisitionMonitor.enable_monitor", false);
 
     SetDerivedParams();
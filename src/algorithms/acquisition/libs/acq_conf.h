@@ -51,6 +51,7 @@ public:
     float doppler_step2{125.0};
     float pfa{0.0};
     float pfa2{0.0};
+    float sequential_dismissal_prob{0.5};
     float samples_per_code{0.0};
     float resampler_ratio{1.0};
 
@@ -73,6 +74,8 @@ public:
     bool make_2_steps{false};
     bool use_automatic_resampler{false};
     bool enable_monitor_output{false};
+    bool sequential_detection{false};
+    bool low_memory{false};
 
 private:
     void SetDerivedParams();
@@ -23,6 +23,7 @@
 #include "telemetry_decoder_interface.h"
 #include "tracking_interface.h"
 #include <glog/logging.h>
+#include <algorithm>  // for std::min
 #include <stdexcept>  // for std::invalid_argument
 #include <utility>    // for std::move
 
@@ -54,6 +55,23 @@ Channel::Channel(const ConfigurationInterface* configuration,
     acq_->set_gnss_synchro(&gnss_synchro_);
     trk_->set_gnss_synchro(&gnss_synchro_);
 
+    // In a fused channel, the telemetry decoder is called by the tracking
+    // block and does not take part in the flowgraph
+    fused_ = false;
+    if (!flag_enable_fpga_ and configuration->property("GNSS-SDR.fused_channels", false))
+        {
+            const auto decoder = nav_->get_symbol_decoder();
+            if (decoder and trk_->set_symbol_decoder(decoder, nav_->get_left_block()))
+                {
+                    fused_ = true;
+                }
+            else
+                {
+                    LOG(WARNING) << "Channel " << channel_ << ": " << trk_->implementation() << " and " << nav_->implementation()
+                                 << " cannot be fused, using separate blocks";
+                }
+        }
+
     // Provide a warning to the user about the change of parameter name
     if (channel_ == 0)
         {
@@ -80,6 +98,18 @@ Channel::Channel(const ConfigurationInterface* configuration,
 
     acq_->set_doppler_step(doppler_step);
 
+    // Configured Doppler span, the widest one the acquisition can be asked to search
+    doppler_max_ = configuration->property("Acquisition_" + signal_str + std::to_string(channel_) + ".doppler_max", 0);
+    if (doppler_max_ == 0)
+        {
+            doppler_max_ = configuration->property("Acquisition_" + signal_str + ".doppler_max", 5000);
+        }
+    if (FLAGS_doppler_max != 0)
+        {
+            doppler_max_ = static_cast<uint32_t>(FLAGS_doppler_max);
+        }
+    acq_doppler_max_ = doppler_max_;
+
     float threshold = configuration->property("Acquisition_" + signal_str + std::to_string(channel_) + ".threshold", static_cast<float>(0.0));
     if (threshold == 0.0)
         {
@@ -88,7 +118,16 @@ Channel::Channel(const ConfigurationInterface* configuration,
 
     acq_->set_threshold(threshold);
 
-    acq_->init();
+    // The Doppler grid of the acquisition is computed when the channel is
+    // first assigned a signal, so that unused channels do not slow down the
+    // receiver start. The tracking buffers are still allocated by the
+    // tracking block constructors.
+    acq_initialized_ = false;
+    if (flag_enable_fpga_)
+        {
+            acq_->init();
+            acq_initialized_ = true;
+        }
     repeat_ = configuration->property("Acquisition_" + signal_str + ".repeat_satellite", false);
     repeat_ = configuration->property("Acquisition_" + signal_str + std::to_string(channel_) + ".repeat_satellite", repeat_);
     DLOG(INFO) << "Channel " << channel_ << " satellite repeat = " << repeat_;
@@ -121,14 +160,17 @@ void Channel::connect(gr::top_block_sptr top_block)
             throw std::invalid_argument(msg);
         }
 
-    nav_->connect(top_block);
+    if (!fused_)
+        {
+            nav_->connect(top_block);
 
-    // Synchronous ports
-    top_block->connect(trk_->get_right_block(), 0, nav_->get_left_block(), 0);
+            // Synchronous ports
+            top_block->connect(trk_->get_right_block(), 0, nav_->get_left_block(), 0);
 
-    // Message ports
-    top_block->msg_connect(nav_->get_left_block(), pmt::mp("telemetry_to_trk"), trk_->get_right_block(), pmt::mp("telemetry_to_trk"));
-    DLOG(INFO) << "tracking -> telemetry_decoder";
+            // Message ports
+            top_block->msg_connect(nav_->get_left_block(), pmt::mp("telemetry_to_trk"), trk_->get_right_block(), pmt::mp("telemetry_to_trk"));
+            DLOG(INFO) << "tracking -> telemetry_decoder";
+        }
 
     // Message ports
     if (!flag_enable_fpga_)
@@ -149,15 +191,20 @@ void Channel::disconnect(gr::top_block_sptr top_block)
             return;
         }
 
-    top_block->disconnect(trk_->get_right_block(), 0, nav_->get_left_block(), 0);
+    if (!fused_)
+        {
+            top_block->disconnect(trk_->get_right_block(), 0, nav_->get_left_block(), 0);
+        }
     if (!flag_enable_fpga_)
         {
             acq_->disconnect(top_block);
         }
     trk_->disconnect(top_block);
-    nav_->disconnect(top_block);
-
-    top_block->msg_disconnect(nav_->get_left_block(), pmt::mp("telemetry_to_trk"), trk_->get_right_block(), pmt::mp("telemetry_to_trk"));
+    if (!fused_)
+        {
+            nav_->disconnect(top_block);
+            top_block->msg_disconnect(nav_->get_left_block(), pmt::mp("telemetry_to_trk"), trk_->get_right_block(), pmt::mp("telemetry_to_trk"));
+        }
     if (!flag_enable_fpga_)
         {
             top_block->msg_disconnect(acq_->get_right_block(), pmt::mp("events"), channel_msg_rx_, pmt::mp("events"));
@@ -200,6 +247,10 @@ gr::basic_block_sptr Channel::get_right_block_acq()
 
 gr::basic_block_sptr Channel::get_right_block()
 {
+    if (fused_)
+        {
+            return trk_->get_right_block();
+        }
     return nav_->get_right_block();
 }
 
@@ -214,6 +265,11 @@ void Channel::set_signal(const Gnss_Signal& gnss_signal)
     gnss_synchro_.Signal[2] = '\0';  // make sure that string length is only two characters
     gnss_synchro_.PRN = gnss_signal_.get_satellite().get_PRN();
     gnss_synchro_.System = gnss_signal_.get_satellite().get_system_short().c_str()[0];
+    if (!acq_initialized_)
+        {
+            acq_->init();
+            acq_initialized_ = true;
+        }
     acq_->set_local_code();
     if (flag_enable_fpga_)
         {
@@ -238,6 +294,22 @@ void Channel::stop_channel()
 
 void Channel::assist_acquisition_doppler(double Carrier_Doppler_hz)
 {
+    assist_acquisition_doppler_window(Carrier_Doppler_hz, doppler_max_);
+}
+
+
+void Channel::assist_acquisition_doppler_window(double Carrier_Doppler_hz, uint32_t doppler_max_hz)
+{
+    // The search window can be narrowed, but not widened beyond the configured one
+    doppler_max_hz = std::min(doppler_max_hz, doppler_max_);
+    if (doppler_max_hz != acq_doppler_max_)
+        {
+            DLOG(INFO) << "Channel " << channel_ << " Doppler window: +/- " << doppler_max_hz << " [Hz]";
+            acq_doppler_max_ = doppler_max_hz;
+            acq_->set_doppler_max(acq_doppler_max_);
+            acq_->init();
+            acq_initialized_ = true;
+        }
     acq_->set_doppler_center(static_cast<int>(Carrier_Doppler_hz));
 }
 
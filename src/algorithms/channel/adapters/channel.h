@@ -90,6 +90,7 @@ public:
     void set_signal(const Gnss_Signal& gnss_signal_) override;  //!< Sets the channel GNSS signal
 
     void assist_acquisition_doppler(double Carrier_Doppler_hz) override;
+    void assist_acquisition_doppler_window(double Carrier_Doppler_hz, uint32_t doppler_max_hz) override;
 
     inline std::shared_ptr<AcquisitionInterface> acquisition() const { return acq_; }
     inline std::shared_ptr<TrackingInterface> tracking() const { return trk_; }
@@ -106,9 +107,13 @@ private:
     std::string role_;
     std::mutex mx_;
     uint32_t channel_;
+    uint32_t doppler_max_;
+    uint32_t acq_doppler_max_;
     bool connected_;
     bool repeat_;
     bool flag_enable_fpga_;
+    bool fused_;  // telemetry decoder runs inside the tracking block
+    bool acq_initialized_;
 };
 
 
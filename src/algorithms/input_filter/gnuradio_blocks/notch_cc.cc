@@ -15,6 +15,7 @@
  */
 
 #include "notch_cc.h"
+#include "gnss_sdr_fft.h"
 #include <boost/math/distributions/chi_squared.hpp>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
@@ -57,7 +58,6 @@ Notch::Notch(float pfa,
     c_samples_ = volk_gnsssdr::vector<gr_complex>(length_);
     angle_ = volk_gnsssdr::vector<float>(length_);
     power_spect_ = volk_gnsssdr::vector<float>(length_);
-    d_fft_ = gnss_fft_fwd_make_unique(length_);
 }
 
 
@@ -75,9 +75,11 @@ int Notch::general_work(int noutput_items, gr_vector_int &ninput_items __attribu
         {
             if ((n_segments_ < n_segments_est_) && (filter_state_ == false))
                 {
-                    memcpy(d_fft_->get_inbuf(), in, sizeof(gr_complex) * length_);
-                    d_fft_->execute();
-                    volk_32fc_s32f_power_spectrum_32f(power_spect_.data(), d_fft_->get_outbuf(), 1.0, length_);
+                    // The FFT is only needed while estimating the noise floor
+                    const auto fft = gnss_fft_fwd_borrow(length_);
+                    memcpy(fft->get_inbuf(), in, sizeof(gr_complex) * length_);
+                    fft->execute();
+                    volk_32fc_s32f_power_spectrum_32f(power_spect_.data(), fft->get_outbuf(), 1.0, length_);
                     volk_32f_s32f_calc_spectral_noise_floor_32f(&sig2dB, power_spect_.data(), 15.0, length_);
                     sig2lin = std::pow(10.0F, (sig2dB / 10.0F)) / (static_cast<float>(n_deg_fred_));
                     noise_pow_est_ = (static_cast<float>(n_segments_) * noise_pow_est_ + sig2lin) / (static_cast<float>(n_segments_ + 1));
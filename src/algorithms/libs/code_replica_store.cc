@@ -0,0 +1,62 @@
+/*!
+ * \file code_replica_store.cc
+ * \brief Process-wide store of read-only sampled code replicas, shared by
+ * all the channels that track the same signal and PRN.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "code_replica_store.h"
+#include <utility>  // for std::move
+
+
+Code_Replica_Store& Code_Replica_Store::instance()
+{
+    static Code_Replica_Store store;
+    return store;
+}
+
+
+Code_Replica_Store::Replica_Ptr Code_Replica_Store::get(const std::string& key, size_t size, const Generator& generator)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        const auto it = d_replicas.find(key);
+        if (it != d_replicas.cend())
+            {
+                return it->second;
+            }
+    }
+
+    // Generate it without holding the lock, so that channels starting
+    // with other signals or PRNs are not delayed
+    auto replica = std::make_shared<Replica>(size, 0.0F);
+    generator(own::span<float>(replica->data(), replica->size()));
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    // If another channel stored the same replica meanwhile, keep that one
+    const auto result = d_replicas.emplace(key, std::move(replica));
+    return result.first->second;
+}
+
+
+size_t Code_Replica_Store::size() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_replicas.size();
+}
+
+
+void Code_Replica_Store::clear()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_replicas.clear();
+}
@@ -0,0 +1,93 @@
+/*!
+ * \file code_replica_store.h
+ * \brief Process-wide store of read-only sampled code replicas, shared by
+ * all the channels that track the same signal and PRN.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CODE_REPLICA_STORE_H
+#define GNSS_SDR_CODE_REPLICA_STORE_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstddef>                             // for size_t
+#include <functional>                          // for std::function
+#include <map>                                 // for std::map
+#include <memory>                              // for std::shared_ptr
+#include <mutex>                               // for std::mutex
+#include <string>                              // for std::string
+#if HAS_STD_SPAN
+#include <span>
+namespace own = std;
+#else
+#include <gsl/gsl-lite.hpp>
+namespace own = gsl;
+#endif
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Holds the local code replicas used by the tracking blocks.
+ *
+ * Each replica is generated the first time it is requested and then shared,
+ * read-only, by every channel that asks for the same key. A channel that
+ * (re)starts tracking a satellite whose replica is already in the store
+ * does not regenerate it, and N channels tracking the same signal and PRN
+ * (e.g., during reacquisition) keep a single copy in memory.
+ *
+ * The key must identify the replica completely: system, signal, component
+ * (data or pilot), PRN and number of samples.
+ */
+class Code_Replica_Store
+{
+public:
+    using Replica = volk_gnsssdr::vector<float>;
+    using Replica_Ptr = std::shared_ptr<const Replica>;
+    using Generator = std::function<void(own::span<float>)>;
+
+    /*!
+     * \brief Returns the process-wide store.
+     */
+    static Code_Replica_Store& instance();
+
+    /*!
+     * \brief Returns the replica identified by key. If it is not in the
+     * store yet, a zero-filled replica of the given size is passed to
+     * generator, and the result is stored.
+     */
+    Replica_Ptr get(const std::string& key, size_t size, const Generator& generator);
+
+    /*!
+     * \brief Number of replicas in the store.
+     */
+    size_t size() const;
+
+    /*!
+     * \brief Removes all the replicas from the store. Channels keep their
+     * current replicas until they release them.
+     */
+    void clear();
+
+private:
+    Code_Replica_Store() = default;
+
+    std::map<std::string, Replica_Ptr> d_replicas;
+    mutable std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CODE_REPLICA_STORE_H
@@ -20,7 +20,11 @@
 
 #include "gnss_sdr_make_unique.h"
 #include <gnuradio/fft/fft.h>
+#include <algorithm>
+#include <initializer_list>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #if GNURADIO_FFT_USES_TEMPLATES
@@ -62,4 +66,104 @@ gnss_fft_rev_unique_ptr<gr::fft::fft_complex> gnss_fft_rev_make_unique(Args&&...
 
 #endif
 
+
+/*!
+ * \brief Returns the smallest FFT size not lower than min_size with no prime
+ * factors other than 2, 3, 5 and 7, which are the ones with efficient FFTW
+ * codelets.
+ */
+inline int gnss_fft_friendly_size(int min_size)
+{
+    for (int size = std::max(min_size, 1);; size++)
+        {
+            int n = size;
+            for (const int factor : {2, 3, 5, 7})
+                {
+                    while (n % factor == 0)
+                        {
+                            n /= factor;
+                        }
+                }
+            if (n == 1)
+                {
+                    return size;
+                }
+        }
+}
+
+
+/*!
+ * \brief Process-wide pool of idle FFT objects, grouped by size.
+ *
+ * Each FFT object is planned when it is created. Blocks that only need an FFT
+ * from time to time (e.g., while searching for a satellite) can borrow one
+ * from the pool and give it back when released, so that the objects are
+ * planned once and shared by all the instances instead of being kept by each
+ * of them. The direction is a template parameter because old GNU Radio
+ * versions use the same type for forward and reverse transforms.
+ */
+template <typename T, bool Forward>
+class Gnss_Fft_Pool
+{
+public:
+    struct Releaser
+    {
+        void operator()(T* fft) const
+        {
+            Gnss_Fft_Pool<T, Forward>::instance().release(fft);
+        }
+    };
+
+    using borrowed_ptr = std::unique_ptr<T, Releaser>;
+
+    static Gnss_Fft_Pool<T, Forward>& instance()
+    {
+        // Never destroyed, so that FFT objects can be released at any time
+        static auto* pool = new Gnss_Fft_Pool<T, Forward>();
+        return *pool;
+    }
+
+    template <typename Factory>
+    borrowed_ptr borrow(int fft_size, Factory make_fft)
+    {
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            auto it = d_idle.find(fft_size);
+            if (it != d_idle.end())
+                {
+                    T* fft = it->second.release();
+                    d_idle.erase(it);
+                    return borrowed_ptr(fft);
+                }
+        }
+        // Planned outside the lock: GNU Radio serializes the planning anyway
+        return borrowed_ptr(make_fft(fft_size).release());
+    }
+
+private:
+    Gnss_Fft_Pool() = default;
+
+    void release(T* fft)
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_idle.emplace(fft->inbuf_length(), std::unique_ptr<T>(fft));
+    }
+
+    std::multimap<int, std::unique_ptr<T>> d_idle;
+    std::mutex d_mutex;
+};
+
+using gnss_fft_fwd_borrowed_ptr = Gnss_Fft_Pool<gnss_fft_complex_fwd, true>::borrowed_ptr;
+using gnss_fft_rev_borrowed_ptr = Gnss_Fft_Pool<gnss_fft_complex_rev, false>::borrowed_ptr;
+
+inline gnss_fft_fwd_borrowed_ptr gnss_fft_fwd_borrow(int fft_size)
+{
+    return Gnss_Fft_Pool<gnss_fft_complex_fwd, true>::instance().borrow(fft_size, [](int size) { return gnss_fft_fwd_make_unique(size); });
+}
+
+inline gnss_fft_rev_borrowed_ptr gnss_fft_rev_borrow(int fft_size)
+{
+    return Gnss_Fft_Pool<gnss_fft_complex_rev, false>::instance().borrow(fft_size, [](int size) { return gnss_fft_rev_make_unique(size); });
+}
+
 #endif  // GNSS_SDR_GNSS_SDR_FFT_H
@@ -18,7 +18,13 @@
 
 #include "gnss_sdr_flags.h"
 #include "gnss_sdr_filesystem.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 
 
@@ -65,6 +71,20 @@ DEFINE_string(RINEX_name, "-", "If defined, specifies the RINEX files base name"
 
 DEFINE_bool(keyboard, true, "If set to false, it disables the keyboard listener (so the receiver cannot be stopped with q+[Enter])");
 
+DEFINE_bool(benchmark, false, "If set to true, runs the receiver at increasing channel counts and sampling rates, and reports the load it can sustain in real time.");
+
+DEFINE_string(benchmark_channels, "4,8,16,32,64", "Comma-separated list of channel counts (per signal) tried by the benchmark.");
+
+DEFINE_string(benchmark_rates, "4000000", "Comma-separated list of sampling rates, in samples per second, tried by the benchmark.");
+
+DEFINE_double(benchmark_seconds, 5.0, "Signal time, in seconds, processed at each point of the benchmark.");
+
+DEFINE_double(benchmark_margin, 1.2, "Minimum ratio of signal time to run time for a point of the benchmark to be sustained.");
+
+DEFINE_int32(benchmark_require_channels, 0, "If greater than zero, the benchmark fails unless every sampling rate sustains this number of channels.");
+
+DEFINE_string(benchmark_json, "", "If defined, path to the JSON file where the benchmark results are written.");
+
 #if GFLAGS_GREATER_2_0
 
 static bool ValidateC(const char* flagname, const std::string& value)
@@ -207,6 +227,75 @@ static bool ValidatePllBw(const char* flagname, double value)
     return false;
 }
 
+static bool ValidateBenchmarkSeconds(const char* flagname, double value)
+{
+    if (value > 0.0)
+        {  // value is ok
+            return true;
+        }
+    std::cout << "Invalid value for flag -" << flagname << ": " << value << ". Allowed range is 0 < " << flagname << " s.\n";
+    std::cout << "GNSS-SDR program ended.\n";
+    return false;
+}
+
+static bool ValidateBenchmarkMargin(const char* flagname, double value)
+{
+    if (value > 0.0)
+        {  // value is ok
+            return true;
+        }
+    std::cout << "Invalid value for flag -" << flagname << ": " << value << ". Allowed range is 0 < " << flagname << ".\n";
+    std::cout << "GNSS-SDR program ended.\n";
+    return false;
+}
+
+// Comma-separated list of integers in [1, max_value], with at least one item
+static bool ValidateBenchmarkList(const char* flagname, const std::string& value, int64_t max_value)
+{
+    std::istringstream ss(value);
+    std::string item;
+    int32_t items = 0;
+    bool valid = true;
+    while (valid and std::getline(ss, item, ','))
+        {
+            if (item.empty())
+                {
+                    continue;
+                }
+            valid = std::all_of(item.cbegin(), item.cend(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; });
+            if (valid)
+                {
+                    try
+                        {
+                            const int64_t number = std::stoll(item);
+                            valid = number > 0 and number <= max_value;
+                        }
+                    catch (const std::out_of_range&)
+                        {
+                            valid = false;
+                        }
+                }
+            items++;
+        }
+    if (valid and items > 0)
+        {  // value is ok
+            return true;
+        }
+    std::cout << "Invalid value for flag -" << flagname << ": \"" << value << "\". It must be a comma-separated list of integers between 1 and " << max_value << ".\n";
+    std::cout << "GNSS-SDR program ended.\n";
+    return false;
+}
+
+static bool ValidateBenchmarkChannels(const char* flagname, const std::string& value)
+{
+    return ValidateBenchmarkList(flagname, value, std::numeric_limits<uint32_t>::max());
+}
+
+static bool ValidateBenchmarkRates(const char* flagname, const std::string& value)
+{
+    return ValidateBenchmarkList(flagname, value, std::numeric_limits<int64_t>::max());
+}
+
 static bool ValidateCarrierSmoothingFactor(const char* flagname, int32_t value)
 {
     const int32_t min_value = 1;
@@ -233,5 +322,9 @@ DEFINE_validator(carrier_lock_th, &ValidateCarrierLockTh);
 DEFINE_validator(dll_bw_hz, &ValidateDllBw);
 DEFINE_validator(pll_bw_hz, &ValidatePllBw);
 DEFINE_validator(carrier_smoothing_factor, &ValidateCarrierSmoothingFactor);
+DEFINE_validator(benchmark_channels, &ValidateBenchmarkChannels);
+DEFINE_validator(benchmark_rates, &ValidateBenchmarkRates);
+DEFINE_validator(benchmark_seconds, &ValidateBenchmarkSeconds);
+DEFINE_validator(benchmark_margin, &ValidateBenchmarkMargin);
 
 #endif
@@ -62,6 +62,15 @@ DECLARE_string(RINEX_version);  //!< If defined, specifies the RINEX version (2.
 DECLARE_string(RINEX_name);     //!< If defined, specifies the RINEX files base name
 DECLARE_bool(keyboard);         //!< If set to false, disables the keyboard listener. Only for debug purposes (e.g. ASAN mode termination)
 
+// Declare flags for the capacity benchmark
+DECLARE_bool(benchmark);                    //!< If set to true, runs the capacity benchmark instead of the receiver.
+DECLARE_string(benchmark_channels);         //!< Comma-separated list of channel counts tried by the benchmark.
+DECLARE_string(benchmark_rates);            //!< Comma-separated list of sampling rates tried by the benchmark, in samples per second.
+DECLARE_double(benchmark_seconds);          //!< Signal time processed at each point of the benchmark, in seconds.
+DECLARE_double(benchmark_margin);           //!< Minimum ratio of signal time to run time for a point to be sustained.
+DECLARE_int32(benchmark_require_channels);  //!< If greater than zero, channels that every sampling rate must sustain to pass.
+DECLARE_string(benchmark_json);             //!< If defined, path to the JSON file with the benchmark results.
+
 /** \} */
 /** \} */
 #endif  // GNSS_SDR_GNSS_SDR_FLAGS_H
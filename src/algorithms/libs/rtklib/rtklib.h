@@ -39,6 +39,7 @@
 #include <cctype>
 #include <cmath>
 #include <cstdarg>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <netinet/in.h>
@@ -264,6 +265,7 @@ const int MAXNGEO = 4;    //!<    max number of GEO satellites
 
 const int MAXSOLMSG = 8191;  //!<    max length of solution message
 const int MAXERRMSG = 4096;  //!<    max length of error/warning message
+const int ARENA_ALIGN = 16;  //!<    memory arena allocation alignment (bytes)
 
 const int IONOOPT_OFF = 0;   //!<    ionosphere option: correction off
 const int IONOOPT_BRDC = 1;  //!<    ionosphere option: broadcast model
@@ -1057,6 +1059,22 @@ typedef struct
 } ambc_t;
 
 
+typedef struct arena_blk_tag
+{                               /* memory arena overflow block type */
+    struct arena_blk_tag *next; /* next overflow block */
+} arena_blk_t;
+
+
+typedef struct
+{                        /* memory arena type */
+    unsigned char *buff; /* arena buffer */
+    size_t size;         /* size of arena buffer (bytes) */
+    size_t used;         /* bytes in use in arena buffer */
+    size_t need;         /* bytes requested since last reset */
+    arena_blk_t *ovf;    /* overflow blocks allocated since last reset */
+} arena_t;
+
+
 typedef struct
 {                           /* RTK control/result type */
     sol_t sol;              /* RTK solution */
@@ -1071,6 +1089,7 @@ typedef struct
     int neb;                /* bytes in error message buffer */
     char errbuf[MAXERRMSG]; /* error message buffer */
     prcopt_t opt;           /* processing options */
+    arena_t *arena;         /* memory arena for per-epoch temporaries */
 } rtk_t;
 
 
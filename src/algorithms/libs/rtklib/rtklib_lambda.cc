@@ -35,14 +35,14 @@
 #include <cstring>
 
 /* LD factorization (Q=L'*diag(D)*L) -----------------------------------------*/
-int LD(int n, const double *Q, double *L, double *D)
+int LD(int n, const double *Q, double *L, double *D, arena_t *arena)
 {
     int i;
     int j;
     int k;
     int info = 0;
     double a;
-    double *A = mat(n, n);
+    double *A = arena_mat(arena, n, n);
 
     memcpy(A, Q, sizeof(double) * n * n);
     for (i = n - 1; i >= 0; i--)
@@ -69,7 +69,7 @@ int LD(int n, const double *Q, double *L, double *D)
                     L[i + j * n] /= L[i + i * n];
                 }
         }
-    free(A);
+    arena_release(arena, A);
     if (info)
         {
             fprintf(stderr, "%s : LD factorization error\n", __FILE__);
@@ -166,7 +166,7 @@ void reduction(int n, double *L, double *D, double *Z)
 
 /* modified lambda (mlambda) search (ref. [2]) -------------------------------*/
 int search(int n, int m, const double *L, const double *D,
-    const double *zs, double *zn, double *s)
+    const double *zs, double *zn, double *s, arena_t *arena)
 {
     int i;
     int j;
@@ -177,11 +177,11 @@ int search(int n, int m, const double *L, const double *D,
     double newdist;
     double maxdist = 1E99;
     double y;
-    double *S = zeros(n, n);
-    double *dist = mat(n, 1);
-    double *zb = mat(n, 1);
-    double *z = mat(n, 1);
-    double *step = mat(n, 1);
+    double *S = arena_zeros(arena, n, n);
+    double *dist = arena_mat(arena, n, 1);
+    double *zb = arena_mat(arena, n, 1);
+    double *z = arena_mat(arena, n, 1);
+    double *step = arena_mat(arena, n, 1);
 
     k = n - 1;
     dist[k] = 0.0;
@@ -272,11 +272,11 @@ int search(int n, int m, const double *L, const double *D,
                         }
                 }
         }
-    free(S);
-    free(dist);
-    free(zb);
-    free(z);
-    free(step);
+    arena_release(arena, S);
+    arena_release(arena, dist);
+    arena_release(arena, zb);
+    arena_release(arena, z);
+    arena_release(arena, step);
 
     if (c >= LOOPMAX)
         {
@@ -296,11 +296,12 @@ int search(int n, int m, const double *L, const double *D,
  *          double *Q     I  covariance matrix of float parameters (n x n)
  *          double *F     O  fixed solutions (n x m)
  *          double *s     O  sum of squared residulas of fixed solutions (1 x m)
+ *          arena_t *arena IO memory arena for temporaries (NULL: heap)
  * return : status (0:ok,other:error)
  * notes  : matrix stored by column-major order (fortran convention)
  *-----------------------------------------------------------------------------*/
 int lambda(int n, int m, const double *a, const double *Q, double *F,
-    double *s)
+    double *s, arena_t *arena)
 {
     int info;
     double *L;
@@ -313,30 +314,30 @@ int lambda(int n, int m, const double *a, const double *Q, double *F,
         {
             return -1;
         }
-    L = zeros(n, n);
-    D = mat(n, 1);
-    Z = eye(n);
-    z = mat(n, 1);
-    E = mat(n, m);
+    L = arena_zeros(arena, n, n);
+    D = arena_mat(arena, n, 1);
+    Z = arena_eye(arena, n);
+    z = arena_mat(arena, n, 1);
+    E = arena_mat(arena, n, m);
 
     /* LD factorization */
-    if (!(info = LD(n, Q, L, D)))
+    if (!(info = LD(n, Q, L, D, arena)))
         {
             /* lambda reduction */
             reduction(n, L, D, Z);
             matmul("TN", n, 1, n, 1.0, Z, a, 0.0, z); /* z=Z'*a */
 
             /* mlambda search */
-            if (!(info = search(n, m, L, D, z, E, s)))
+            if (!(info = search(n, m, L, D, z, E, s, arena)))
                 {
                     info = solve("T", Z, E, n, m, F); /* F=Z'\E */
                 }
         }
-    free(L);
-    free(D);
-    free(Z);
-    free(z);
-    free(E);
+    arena_release(arena, L);
+    arena_release(arena, D);
+    arena_release(arena, Z);
+    arena_release(arena, z);
+    arena_release(arena, E);
     return info;
 }
 
@@ -346,9 +347,10 @@ int lambda(int n, int m, const double *a, const double *Q, double *F,
  * args   : int    n      I  number of float parameters
  *          double *Q     I  covariance matrix of float parameters (n x n)
  *          double *Z     O  lambda reduction matrix (n x n)
+ *          arena_t *arena IO memory arena for temporaries (NULL: heap)
  * return : status (0:ok,other:error)
  *-----------------------------------------------------------------------------*/
-int lambda_reduction(int n, const double *Q, double *Z)
+int lambda_reduction(int n, const double *Q, double *Z, arena_t *arena)
 {
     double *L;
     double *D;
@@ -361,8 +363,8 @@ int lambda_reduction(int n, const double *Q, double *Z)
             return -1;
         }
 
-    L = zeros(n, n);
-    D = mat(n, 1);
+    L = arena_zeros(arena, n, n);
+    D = arena_mat(arena, n, 1);
 
     for (i = 0; i < n; i++)
         {
@@ -372,17 +374,17 @@ int lambda_reduction(int n, const double *Q, double *Z)
                 }
         }
     /* LD factorization */
-    if ((info = LD(n, Q, L, D)))
+    if ((info = LD(n, Q, L, D, arena)))
         {
-            free(L);
-            free(D);
+            arena_release(arena, L);
+            arena_release(arena, D);
             return info;
         }
     /* lambda reduction */
     reduction(n, L, D, Z);
 
-    free(L);
-    free(D);
+    arena_release(arena, L);
+    arena_release(arena, D);
     return 0;
 }
 
@@ -395,10 +397,11 @@ int lambda_reduction(int n, const double *Q, double *Z)
  *          double *Q     I  covariance matrix of float parameters (n x n)
  *          double *F     O  fixed solutions (n x m)
  *          double *s     O  sum of squared residulas of fixed solutions (1 x m)
+ *          arena_t *arena IO memory arena for temporaries (NULL: heap)
  * return : status (0:ok,other:error)
  *-----------------------------------------------------------------------------*/
 int lambda_search(int n, int m, const double *a, const double *Q,
-    double *F, double *s)
+    double *F, double *s, arena_t *arena)
 {
     double *L;
     double *D;
@@ -409,20 +412,20 @@ int lambda_search(int n, int m, const double *a, const double *Q,
             return -1;
         }
 
-    L = zeros(n, n);
-    D = mat(n, 1);
+    L = arena_zeros(arena, n, n);
+    D = arena_mat(arena, n, 1);
 
     /* LD factorization */
-    if ((info = LD(n, Q, L, D)))
+    if ((info = LD(n, Q, L, D, arena)))
         {
-            free(L);
-            free(D);
+            arena_release(arena, L);
+            arena_release(arena, D);
             return info;
         }
     /* mlambda search */
-    info = search(n, m, L, D, a, F, s);
+    info = search(n, m, L, D, a, F, s, arena);
 
-    free(L);
-    free(D);
+    arena_release(arena, L);
+    arena_release(arena, D);
     return info;
 }
@@ -57,19 +57,20 @@ const int LOOPMAX = 10000; /* maximum count of search loop */
         }                 \
     while (0)
 
-int LD(int n, const double *Q, double *L, double *D);
+int LD(int n, const double *Q, double *L, double *D, arena_t *arena = nullptr);
 void gauss(int n, double *L, double *Z, int i, int j);
 void perm(int n, double *L, double *D, int j, double del, double *Z);
 void reduction(int n, double *L, double *D, double *Z);
 int search(int n, int m, const double *L, const double *D,
-    const double *zs, double *zn, double *s);
+    const double *zs, double *zn, double *s, arena_t *arena = nullptr);
 
-int lambda(int n, int m, const double *a, const double *Q, double *F, double *s);
+int lambda(int n, int m, const double *a, const double *Q, double *F, double *s,
+    arena_t *arena = nullptr);
 
-int lambda_reduction(int n, const double *Q, double *Z);
+int lambda_reduction(int n, const double *Q, double *Z, arena_t *arena = nullptr);
 
 int lambda_search(int n, int m, const double *a, const double *Q,
-    double *F, double *s);
+    double *F, double *s, arena_t *arena = nullptr);
 
 
 #endif
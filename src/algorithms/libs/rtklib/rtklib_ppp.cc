@@ -402,9 +402,9 @@ int fix_sol(rtk_t *rtk, const int *sat1, const int *sat2,
             return 0;
         }
 
-    v = zeros(n, 1);
-    H = zeros(rtk->nx, n);
-    R = zeros(n, n);
+    v = arena_zeros(rtk->arena, n, 1);
+    H = arena_zeros(rtk->arena, rtk->nx, n);
+    R = arena_zeros(rtk->arena, n, n);
 
     /* constraints to fixed ambiguities */
     for (i = 0; i < n; i++)
@@ -420,9 +420,9 @@ int fix_sol(rtk_t *rtk, const int *sat1, const int *sat2,
     if ((info = filter(rtk->x, rtk->P, H, v, R, rtk->nx, n)))
         {
             trace(1, "filter error (info=%d)\n", info);
-            free(v);
-            free(H);
-            free(R);
+            arena_release(rtk->arena, v);
+            arena_release(rtk->arena, H);
+            arena_release(rtk->arena, R);
             return 0;
         }
     /* set solution */
@@ -440,9 +440,9 @@ int fix_sol(rtk_t *rtk, const int *sat1, const int *sat2,
             rtk->ambc[sat1[i] - 1].flags[sat2[i] - 1] = 1;
             rtk->ambc[sat2[i] - 1].flags[sat1[i] - 1] = 1;
         }
-    free(v);
-    free(H);
-    free(R);
+    arena_release(rtk->arena, v);
+    arena_release(rtk->arena, H);
+    arena_release(rtk->arena, R);
     return 1;
 }
 
@@ -475,8 +475,8 @@ int fix_amb_ROUND(rtk_t *rtk, int *sat1, int *sat2, const int *NW, int n)
     C1 = std::pow(lam2, 2.0) / (std::pow(lam2, 2.0) - std::pow(lam1, 2.0));
     C2 = -std::pow(lam1, 2.0) / (std::pow(lam2, 2.0) - std::pow(lam1, 2.0));
 
-    NC = zeros(n, 1);
-    var = zeros(n, 1);
+    NC = arena_zeros(rtk->arena, n, 1);
+    var = arena_zeros(rtk->arena, n, 1);
 
     for (i = 0; i < n; i++)
         {
@@ -518,8 +518,8 @@ int fix_amb_ROUND(rtk_t *rtk, int *sat1, int *sat2, const int *NW, int n)
     /* fixed solution */
     stat = fix_sol(rtk, sat1, sat2, NC, m);
 
-    free(NC);
-    free(var);
+    arena_release(rtk->arena, NC);
+    arena_release(rtk->arena, var);
 
     return stat && m >= 3;
 }
@@ -555,12 +555,12 @@ int fix_amb_ILS(rtk_t *rtk, int *sat1, int *sat2, int *NW, int n)
     C1 = std::pow(lam2, 2.0) / (std::pow(lam2, 2.0) - std::pow(lam1, 2.0));
     C2 = -std::pow(lam1, 2.0) / (std::pow(lam2, 2.0) - std::pow(lam1, 2.0));
 
-    B1 = zeros(n, 1);
-    N1 = zeros(n, 2);
-    D = zeros(rtk->nx, n);
-    E = mat(n, rtk->nx);
-    Q = mat(n, n);
-    NC = mat(n, 1);
+    B1 = arena_zeros(rtk->arena, n, 1);
+    N1 = arena_zeros(rtk->arena, n, 2);
+    D = arena_zeros(rtk->arena, rtk->nx, n);
+    E = arena_mat(rtk->arena, n, rtk->nx);
+    Q = arena_mat(rtk->arena, n, n);
+    NC = arena_mat(rtk->arena, n, 1);
 
     for (i = 0; i < n; i++)
         {
@@ -593,12 +593,12 @@ int fix_amb_ILS(rtk_t *rtk, int *sat1, int *sat2, int *NW, int n)
         }
     if (m < 3)
         {
-            free(B1);
-            free(N1);
-            free(D);
-            free(E);
-            free(Q);
-            free(NC);
+            arena_release(rtk->arena, B1);
+            arena_release(rtk->arena, N1);
+            arena_release(rtk->arena, D);
+            arena_release(rtk->arena, E);
+            arena_release(rtk->arena, Q);
+            arena_release(rtk->arena, NC);
             return 0;
         }
 
@@ -607,25 +607,25 @@ int fix_amb_ILS(rtk_t *rtk, int *sat1, int *sat2, int *NW, int n)
     matmul("NN", m, m, rtk->nx, 1.0, E, D, 0.0, Q);
 
     /* integer least square */
-    if ((info = lambda(m, 2, B1, Q, N1, s)))
+    if ((info = lambda(m, 2, B1, Q, N1, s, rtk->arena)))
         {
             trace(2, "lambda error: info=%d\n", info);
-            free(B1);
-            free(N1);
-            free(D);
-            free(E);
-            free(Q);
-            free(NC);
+            arena_release(rtk->arena, B1);
+            arena_release(rtk->arena, N1);
+            arena_release(rtk->arena, D);
+            arena_release(rtk->arena, E);
+            arena_release(rtk->arena, Q);
+            arena_release(rtk->arena, NC);
             return 0;
         }
     if (s[0] <= 0.0)
         {
-            free(B1);
-            free(N1);
-            free(D);
-            free(E);
-            free(Q);
-            free(NC);
+            arena_release(rtk->arena, B1);
+            arena_release(rtk->arena, N1);
+            arena_release(rtk->arena, D);
+            arena_release(rtk->arena, E);
+            arena_release(rtk->arena, Q);
+            arena_release(rtk->arena, NC);
             return 0;
         }
 
@@ -635,12 +635,12 @@ int fix_amb_ILS(rtk_t *rtk, int *sat1, int *sat2, int *NW, int n)
     if (rtk->opt.thresar[0] > 0.0 && rtk->sol.ratio < rtk->opt.thresar[0])
         {
             trace(2, "varidation error: n=%2d ratio=%8.3f\n", m, rtk->sol.ratio);
-            free(B1);
-            free(N1);
-            free(D);
-            free(E);
-            free(Q);
-            free(NC);
+            arena_release(rtk->arena, B1);
+            arena_release(rtk->arena, N1);
+            arena_release(rtk->arena, D);
+            arena_release(rtk->arena, E);
+            arena_release(rtk->arena, Q);
+            arena_release(rtk->arena, NC);
             return 0;
         }
     trace(2, "varidation ok: %s n=%2d ratio=%8.3f\n", time_str(rtk->sol.time, 0), m,
@@ -654,12 +654,12 @@ int fix_amb_ILS(rtk_t *rtk, int *sat1, int *sat2, int *NW, int n)
     /* fixed solution */
     stat = fix_sol(rtk, sat1, sat2, NC, m);
 
-    free(B1);
-    free(N1);
-    free(D);
-    free(E);
-    free(Q);
-    free(NC);
+    arena_release(rtk->arena, B1);
+    arena_release(rtk->arena, N1);
+    arena_release(rtk->arena, D);
+    arena_release(rtk->arena, E);
+    arena_release(rtk->arena, Q);
+    arena_release(rtk->arena, NC);
 
     return stat;
 }
@@ -687,9 +687,9 @@ int pppamb(rtk_t *rtk, const obsd_t *obs, int n, const nav_t *nav,
 
     elmask = rtk->opt.elmaskar > 0.0 ? rtk->opt.elmaskar : rtk->opt.elmin;
 
-    sat1 = imat(n * n, 1);
-    sat2 = imat(n * n, 1);
-    NW = imat(n * n, 1);
+    sat1 = arena_imat(rtk->arena, n * n, 1);
+    sat2 = arena_imat(rtk->arena, n * n, 1);
+    NW = arena_imat(rtk->arena, n * n, 1);
 
     /* average LC */
     average_LC(rtk, obs, n, nav, azel);
@@ -727,9 +727,9 @@ int pppamb(rtk_t *rtk, const obsd_t *obs, int n, const nav_t *nav,
         {
             stat = fix_amb_ILS(rtk, sat1, sat2, NW, m);
         }
-    free(sat1);
-    free(sat2);
-    free(NW);
+    arena_release(rtk->arena, sat1);
+    arena_release(rtk->arena, sat2);
+    arena_release(rtk->arena, NW);
 
     return stat;
 }
@@ -1786,10 +1786,10 @@ void pppos(rtk_t *rtk, const obsd_t *obs, int n, const nav_t *nav)
 
     trace(3, "pppos   : nx=%d n=%d\n", rtk->nx, n);
 
-    rs = mat(6, n);
-    dts = mat(2, n);
-    var = mat(1, n);
-    azel = zeros(2, n);
+    rs = arena_mat(rtk->arena, 6, n);
+    dts = arena_mat(rtk->arena, 2, n);
+    var = arena_mat(rtk->arena, 1, n);
+    azel = arena_zeros(rtk->arena, 2, n);
 
     for (i = 0; i < MAXSAT; i++)
         {
@@ -1810,13 +1810,13 @@ void pppos(rtk_t *rtk, const obsd_t *obs, int n, const nav_t *nav)
         {
             testeclipse(obs, n, nav, rs);
         }
-    xp = mat(rtk->nx, 1);
-    Pp = zeros(rtk->nx, rtk->nx);
+    xp = arena_mat(rtk->arena, rtk->nx, 1);
+    Pp = arena_zeros(rtk->arena, rtk->nx, rtk->nx);
     matcpy(xp, rtk->x, rtk->nx, 1);
     nv = n * rtk->opt.nf * 2;
-    v = mat(nv, 1);
-    H = mat(rtk->nx, nv);
-    R = mat(nv, nv);
+    v = arena_mat(rtk->arena, nv, 1);
+    H = arena_mat(rtk->arena, rtk->nx, nv);
+    R = arena_mat(rtk->arena, nv, nv);
 
     for (i = 0; i < rtk->opt.niter; i++)
         {
@@ -1893,13 +1893,13 @@ void pppos(rtk_t *rtk, const obsd_t *obs, int n, const nav_t *nav)
                         }
                 }
         }
-    free(rs);
-    free(dts);
-    free(var);
-    free(azel);
-    free(xp);
-    free(Pp);
-    free(v);
-    free(H);
-    free(R);
+    arena_release(rtk->arena, rs);
+    arena_release(rtk->arena, dts);
+    arena_release(rtk->arena, var);
+    arena_release(rtk->arena, azel);
+    arena_release(rtk->arena, xp);
+    arena_release(rtk->arena, Pp);
+    arena_release(rtk->arena, v);
+    arena_release(rtk->arena, H);
+    arena_release(rtk->arena, R);
 }
@@ -30,6 +30,7 @@
  *----------------------------------------------------------------------------*/
 
 #include "rtklib_rtkcmn.h"
+#include "rtklib_smallmat.h"
 #include <glog/logging.h>
 #include <cassert>
 #include <cstring>
@@ -1050,6 +1051,190 @@ double *eye(int n)
 }
 
 
+/* new memory arena ------------------------------------------------------------
+ * allocate memory arena for temporaries released all at once by arena_reset()
+ * args   : size_t size      I   initial size of arena buffer (bytes)
+ * return : arena pointer
+ *-----------------------------------------------------------------------------*/
+arena_t *arena_new(size_t size)
+{
+    arena_t *arena;
+
+    if (!(arena = static_cast<arena_t *>(calloc(1, sizeof(arena_t)))))
+        {
+            fatalerr("arena memory allocation error\n");
+        }
+    if (size > 0)
+        {
+            if (!(arena->buff = static_cast<unsigned char *>(malloc(size))))
+                {
+                    fatalerr("arena memory allocation error: size=%lu\n", static_cast<unsigned long>(size));
+                }
+            arena->size = size;
+        }
+    return arena;
+}
+
+
+/* free memory arena -----------------------------------------------------------
+ * free memory arena and all the memory served by it
+ * args   : arena_t *arena   IO  memory arena (NULL: no operation)
+ * return : none
+ *-----------------------------------------------------------------------------*/
+void arena_free(arena_t *arena)
+{
+    if (!arena)
+        {
+            return;
+        }
+    arena_reset(arena);
+    free(arena->buff);
+    free(arena);
+}
+
+
+/* reset memory arena ----------------------------------------------------------
+ * release all the memory served by the arena since the last reset
+ * args   : arena_t *arena   IO  memory arena (NULL: no operation)
+ * return : none
+ * notes  : if the arena buffer overflowed since the last reset, it is enlarged
+ *          to the total requested size, so a stationary workload is served
+ *          without heap allocations after the first call
+ *-----------------------------------------------------------------------------*/
+void arena_reset(arena_t *arena)
+{
+    arena_blk_t *blk;
+    unsigned char *buff;
+
+    if (!arena)
+        {
+            return;
+        }
+    while ((blk = arena->ovf))
+        {
+            arena->ovf = blk->next;
+            free(blk);
+        }
+    if (arena->need > arena->size)
+        {
+            trace(4, "arena_reset: size=%lu->%lu\n", static_cast<unsigned long>(arena->size),
+                static_cast<unsigned long>(arena->need));
+            if (!(buff = static_cast<unsigned char *>(malloc(arena->need))))
+                {
+                    fatalerr("arena memory allocation error: size=%lu\n", static_cast<unsigned long>(arena->need));
+                }
+            free(arena->buff);
+            arena->buff = buff;
+            arena->size = arena->need;
+        }
+    arena->used = arena->need = 0;
+}
+
+
+/* allocate memory from arena --------------------------------------------------
+ * allocate memory from arena (released by arena_reset())
+ * args   : arena_t *arena   IO  memory arena
+ *          size_t size      I   size of memory (bytes)
+ * return : memory pointer (aligned to ARENA_ALIGN bytes)
+ *-----------------------------------------------------------------------------*/
+void *arena_alloc(arena_t *arena, size_t size)
+{
+    arena_blk_t *blk;
+    void *p;
+
+    size = (size + ARENA_ALIGN - 1) & ~static_cast<size_t>(ARENA_ALIGN - 1);
+    arena->need += size;
+    if (arena->used + size <= arena->size)
+        {
+            p = arena->buff + arena->used;
+            arena->used += size;
+            return p;
+        }
+    /* arena exhausted: serve from an overflow block until the next reset */
+    if (!(blk = static_cast<arena_blk_t *>(malloc(ARENA_ALIGN + size))))
+        {
+            fatalerr("arena memory allocation error: size=%lu\n", static_cast<unsigned long>(size));
+        }
+    blk->next = arena->ovf;
+    arena->ovf = blk;
+    return reinterpret_cast<unsigned char *>(blk) + ARENA_ALIGN;
+}
+
+
+/* new matrix from arena -------------------------------------------------------
+ * allocate memory of matrix from arena
+ * args   : arena_t *arena   IO  memory arena (NULL: allocate by mat())
+ *          int    n,m       I   number of rows and columns of matrix
+ * return : matrix pointer (if n<=0 or m<=0, return NULL)
+ * notes  : release with arena_release()
+ *-----------------------------------------------------------------------------*/
+double *arena_mat(arena_t *arena, int n, int m)
+{
+    if (!arena || n <= 0 || m <= 0)
+        {
+            return mat(n, m);
+        }
+    return static_cast<double *>(arena_alloc(arena, sizeof(double) * n * m));
+}
+
+
+int *arena_imat(arena_t *arena, int n, int m)
+{
+    if (!arena || n <= 0 || m <= 0)
+        {
+            return imat(n, m);
+        }
+    return static_cast<int *>(arena_alloc(arena, sizeof(int) * n * m));
+}
+
+
+double *arena_zeros(arena_t *arena, int n, int m)
+{
+    double *p;
+
+    if (!arena || n <= 0 || m <= 0)
+        {
+            return zeros(n, m);
+        }
+    p = arena_mat(arena, n, m);
+    memset(p, 0, sizeof(double) * n * m);
+    return p;
+}
+
+
+double *arena_eye(arena_t *arena, int n)
+{
+    double *p;
+    int i;
+
+    if ((p = arena_zeros(arena, n, n)))
+        {
+            for (i = 0; i < n; i++)
+                {
+                    p[i + i * n] = 1.0;
+                }
+        }
+    return p;
+}
+
+
+/* release matrix from arena ---------------------------------------------------
+ * release matrix allocated by arena_mat(), arena_imat(), arena_zeros() or
+ * arena_eye()
+ * args   : arena_t *arena   IO  memory arena (NULL: free memory)
+ *          void   *p        I   matrix pointer
+ * return : none
+ * notes  : memory served by an arena is only released by arena_reset()
+ *-----------------------------------------------------------------------------*/
+void arena_release(arena_t *arena, void *p)
+{
+    if (!arena)
+        {
+            free(p);
+        }
+}
+
+
 /* inner product ---------------------------------------------------------------
  * inner product of vectors
  * args   : double *a,*b     I   vector a,b (n x 1)
@@ -1142,6 +1327,13 @@ void matcpy(double *A, const double *B, int n, int m)
 void matmul(const char *tr, int n, int k, int m, double alpha,
     const double *A, const double *B, double beta, double *C)
 {
+#if RTKLIB_USE_SMALLMAT
+    if (smallmat_fits(n, k, m))
+        {
+            smallmat_mul(tr, n, k, m, alpha, A, B, beta, C);
+            return;
+        }
+#endif
     int lda = tr[0] == 'T' ? m : n;
     int ldb = tr[1] == 'T' ? k : m;
 
@@ -1161,16 +1353,28 @@ int matinv(double *A, int n)
     double *work;
     int info;
     int lwork = n * 16;
-    int *ipiv = imat(n, 1);
+    int *ipiv;
 
+#if RTKLIB_USE_SMALLMAT
+    if (smallmat_fits(n))
+        {
+            return smallmat_inv(A, n);
+        }
+    ipiv = smallmat_iwork(SMALLMAT_WORK_INV, n);
+    work = smallmat_work(SMALLMAT_WORK_INV, lwork);
+#else
+    ipiv = imat(n, 1);
     work = mat(lwork, 1);
+#endif
     dgetrf_(&n, &n, A, &n, ipiv, &info);
     if (!info)
         {
             dgetri_(&n, A, &n, ipiv, work, &lwork, &info);
         }
+#if !RTKLIB_USE_SMALLMAT
     free(ipiv);
     free(work);
+#endif
     return info;
 }
 
@@ -1189,6 +1393,12 @@ int matinv(double *A, int n)
 int solve(const char *tr, const double *A, const double *Y, int n,
     int m, double *X)
 {
+#if RTKLIB_USE_SMALLMAT
+    if (smallmat_fits(n))
+        {
+            return smallmat_solve(tr, A, Y, n, m, X);
+        }
+#endif
     double *B = mat(n, n);
     int info;
     int *ipiv = imat(n, 1);
@@ -1229,14 +1439,34 @@ int lsq(const double *A, const double *y, int n, int m, double *x,
         {
             return -1;
         }
+#if RTKLIB_USE_SMALLMAT
+    Ay = smallmat_work(SMALLMAT_WORK_LSQ, n);
+#else
     Ay = mat(n, 1);
+#endif
     matmul("NN", n, 1, m, 1.0, A, y, 0.0, Ay); /* Ay=A*y */
     matmul("NT", n, n, m, 1.0, A, A, 0.0, Q);  /* Q=A*A' */
+#if RTKLIB_USE_SMALLMAT
+    /* Q is symmetric: try Cholesky first, general inverse if not pos. def. */
+    if (!smallmat_fits(n) || smallmat_cholinv(Q, n))
+        {
+            info = matinv(Q, n);
+        }
+    else
+        {
+            info = 0;
+        }
+    if (!info)
+        {
+            matmul("NN", n, 1, n, 1.0, Q, Ay, 0.0, x); /* x=Q^-1*Ay */
+        }
+#else
     if (!(info = matinv(Q, n)))
         {
             matmul("NN", n, 1, n, 1.0, Q, Ay, 0.0, x); /* x=Q^-1*Ay */
         }
     free(Ay);
+#endif
     return info;
 }
 
@@ -1262,27 +1492,59 @@ int filter_(const double *x, const double *P, const double *H,
     const double *v, const double *R, int n, int m,
     double *xp, double *Pp)
 {
+    int info;
+#if RTKLIB_USE_SMALLMAT
+    double *F = smallmat_work(SMALLMAT_WORK_FILT, 2 * n * m + m * m + n * n);
+    double *Q = F + n * m;
+    double *K = Q + m * m;
+    double *I = K + n * m;
+    int i;
+
+    for (i = 0; i < n * n; i++)
+        {
+            I[i] = 0.0;
+        }
+    for (i = 0; i < n; i++)
+        {
+            I[i + i * n] = 1.0;
+        }
+#else
     double *F = mat(n, m);
     double *Q = mat(m, m);
     double *K = mat(n, m);
     double *I = eye(n);
-    int info;
+#endif
 
     matcpy(Q, R, m, m);
     matcpy(xp, x, n, 1);
     matmul("NN", n, m, n, 1.0, P, H, 0.0, F); /* Q=H'*P*H+R */
     matmul("TN", m, m, n, 1.0, H, F, 1.0, Q);
+#if RTKLIB_USE_SMALLMAT
+    /* Q is symmetric: try Cholesky first, general inverse if not pos. def. */
+    if (!smallmat_fits(m) || smallmat_cholinv(Q, m))
+        {
+            info = matinv(Q, m);
+        }
+    else
+        {
+            info = 0;
+        }
+    if (!info)
+#else
     if (!(info = matinv(Q, m)))
+#endif
         {
             matmul("NN", n, m, m, 1.0, F, Q, 0.0, K);  /* K=P*H*Q^-1 */
             matmul("NN", n, 1, m, 1.0, K, v, 1.0, xp); /* xp=x+K*v */
             matmul("NT", n, n, m, -1.0, K, H, 1.0, I); /* Pp=(I-K*H')*P */
             matmul("NN", n, n, n, 1.0, I, P, 0.0, Pp);
         }
+#if !RTKLIB_USE_SMALLMAT
     free(F);
     free(Q);
     free(K);
     free(I);
+#endif
     return info;
 }
 
@@ -1301,7 +1563,11 @@ int filter(double *x, double *P, const double *H, const double *v,
     int info;
     int *ix;
 
+#if RTKLIB_USE_SMALLMAT
+    ix = smallmat_iwork(SMALLMAT_WORK_FILTX, n);
+#else
     ix = imat(n, 1);
+#endif
     for (i = k = 0; i < n; i++)
         {
             if (x[i] != 0.0 && P[i + i * n] > 0.0)
@@ -1309,10 +1575,18 @@ int filter(double *x, double *P, const double *H, const double *v,
                     ix[k++] = i;
                 }
         }
+#if RTKLIB_USE_SMALLMAT
+    x_ = smallmat_work(SMALLMAT_WORK_FILTX, 2 * k + 2 * k * k + k * m);
+    xp_ = x_ + k;
+    P_ = xp_ + k;
+    Pp_ = P_ + k * k;
+    H_ = Pp_ + k * k;
+#else
     x_ = mat(k, 1);
     xp_ = mat(k, 1);
     P_ = mat(k, k);
     Pp_ = mat(k, k);
+#endif
     for (i = 0; i < k; i++)
         {
             for (j = 0; j < k; j++)
@@ -1320,7 +1594,9 @@ int filter(double *x, double *P, const double *H, const double *v,
                     Pp_[i * k + j] = 0.0;
                 }
         }
+#if !RTKLIB_USE_SMALLMAT
     H_ = mat(k, m);
+#endif
     for (i = 0; i < k; i++)
         {
             x_[i] = x[ix[i]];
@@ -1342,12 +1618,14 @@ int filter(double *x, double *P, const double *H, const double *v,
                     P[ix[i] + ix[j] * n] = Pp_[i + j * k];
                 }
         }
+#if !RTKLIB_USE_SMALLMAT
     free(ix);
     free(x_);
     free(xp_);
     free(P_);
     free(Pp_);
     free(H_);
+#endif
     return info;
 }
 
@@ -121,6 +121,15 @@ double *mat(int n, int m);
 int *imat(int n, int m);
 double *zeros(int n, int m);
 double *eye(int n);
+arena_t *arena_new(size_t size);
+void arena_free(arena_t *arena);
+void arena_reset(arena_t *arena);
+void *arena_alloc(arena_t *arena, size_t size);
+double *arena_mat(arena_t *arena, int n, int m);
+int *arena_imat(arena_t *arena, int n, int m);
+double *arena_zeros(arena_t *arena, int n, int m);
+double *arena_eye(arena_t *arena, int n);
+void arena_release(arena_t *arena, void *p);
 double dot(const double *a, const double *b, int n);
 double norm_rtk(const double *a, int n);
 void cross3(const double *a, const double *b, double *c);
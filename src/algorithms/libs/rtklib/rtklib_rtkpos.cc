@@ -731,9 +731,9 @@ void udpos(rtk_t *rtk, double tt)
             return;
         }
     /* state transition of position/velocity/acceleration */
-    F = eye(rtk->nx);
-    FP = mat(rtk->nx, rtk->nx);
-    xp = mat(rtk->nx, 1);
+    F = arena_eye(rtk->arena, rtk->nx);
+    FP = arena_mat(rtk->arena, rtk->nx, rtk->nx);
+    xp = arena_mat(rtk->arena, rtk->nx, 1);
 
     for (i = 0; i < 6; i++)
         {
@@ -757,9 +757,9 @@ void udpos(rtk_t *rtk, double tt)
                     rtk->P[i + 6 + (j + 6) * rtk->nx] += Qv[i + j * 3];
                 }
         }
-    free(F);
-    free(FP);
-    free(xp);
+    arena_release(rtk->arena, F);
+    arena_release(rtk->arena, FP);
+    arena_release(rtk->arena, xp);
 }
 
 
@@ -1125,7 +1125,7 @@ void udbias(rtk_t *rtk, double tt, const obsd_t *obs, const int *sat,
                     rtk->x[j] = 0.0;
                     rtk->ssat[sat[i] - 1].lock[f] = -rtk->opt.minlock;
                 }
-            bias = zeros(ns, 1);
+            bias = arena_zeros(rtk->arena, ns, 1);
 
             /* estimate approximate phase-bias by phase - code */
             for (i = j = 0, offset = 0.0; i < ns; i++)
@@ -1185,7 +1185,7 @@ void udbias(rtk_t *rtk, double tt, const obsd_t *obs, const int *sat,
                         }
                     initx_rtk(rtk, bias[i], std::pow(rtk->opt.std[0], 2.0), IB_RTK(sat[i], f, &rtk->opt));
                 }
-            free(bias);
+            arena_release(rtk->arena, bias);
         }
 }
 
@@ -1605,13 +1605,13 @@ int ddres(rtk_t *rtk, const nav_t *nav, double dt, const double *x,
     ecef2pos(x, posu);
     ecef2pos(rtk->rb, posr);
 
-    Ri = mat(ns * nf * 2 + 2, 1);
-    Rj = mat(ns * nf * 2 + 2, 1);
-    im = mat(ns, 1);
-    tropu = mat(ns, 1);
-    tropr = mat(ns, 1);
-    dtdxu = mat(ns, 3);
-    dtdxr = mat(ns, 3);
+    Ri = arena_mat(rtk->arena, ns * nf * 2 + 2, 1);
+    Rj = arena_mat(rtk->arena, ns * nf * 2 + 2, 1);
+    im = arena_mat(rtk->arena, ns, 1);
+    tropu = arena_mat(rtk->arena, ns, 1);
+    tropr = arena_mat(rtk->arena, ns, 1);
+    dtdxu = arena_mat(rtk->arena, ns, 3);
+    dtdxr = arena_mat(rtk->arena, ns, 3);
 
     for (i = 0; i < MAXSAT; i++)
         {
@@ -1854,13 +1854,13 @@ int ddres(rtk_t *rtk, const nav_t *nav, double dt, const double *x,
     /* double-differenced measurement error covariance */
     ddcov(nb, b, Ri, Rj, nv, R);
 
-    free(Ri);
-    free(Rj);
-    free(im);
-    free(tropu);
-    free(tropr);
-    free(dtdxu);
-    free(dtdxr);
+    arena_release(rtk->arena, Ri);
+    arena_release(rtk->arena, Rj);
+    arena_release(rtk->arena, im);
+    arena_release(rtk->arena, tropu);
+    arena_release(rtk->arena, tropr);
+    arena_release(rtk->arena, dtdxu);
+    arena_release(rtk->arena, dtdxr);
 
     return nv;
 }
@@ -2090,8 +2090,8 @@ void holdamb(rtk_t *rtk, const double *xa)
 
     trace(3, "holdamb :\n");
 
-    v = mat(nb, 1);
-    H = zeros(nb, rtk->nx);
+    v = arena_mat(rtk->arena, nb, 1);
+    H = arena_zeros(rtk->arena, nb, rtk->nx);
 
     for (m = 0; m < 4; m++)
         {
@@ -2120,7 +2120,7 @@ void holdamb(rtk_t *rtk, const double *xa)
         }
     if (nv > 0)
         {
-            R = zeros(nv, nv);
+            R = arena_zeros(rtk->arena, nv, nv);
             for (i = 0; i < nv; i++)
                 {
                     R[i + i * nv] = VAR_HOLDAMB;
@@ -2131,10 +2131,10 @@ void holdamb(rtk_t *rtk, const double *xa)
                 {
                     errmsg(rtk, "filter error (info=%d)\n", info);
                 }
-            free(R);
+            arena_release(rtk->arena, R);
         }
-    free(v);
-    free(H);
+    arena_release(rtk->arena, v);
+    arena_release(rtk->arena, H);
 }
 
 
@@ -2170,22 +2170,22 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
             return 0;
         }
     /* single to double-difference transformation matrix (D') */
-    D = zeros(nx, nx);
+    D = arena_zeros(rtk->arena, nx, nx);
     if ((nb = ddmat(rtk, D)) <= 0)
         {
             errmsg(rtk, "no valid double-difference\n");
-            free(D);
+            arena_release(rtk->arena, D);
             return 0;
         }
     ny = na + nb;
-    y = mat(ny, 1);
-    Qy = mat(ny, ny);
-    DP = mat(ny, nx);
-    b = mat(nb, 2);
-    db = mat(nb, 1);
-    Qb = mat(nb, nb);
-    Qab = mat(na, nb);
-    QQ = mat(na, nb);
+    y = arena_mat(rtk->arena, ny, 1);
+    Qy = arena_mat(rtk->arena, ny, ny);
+    DP = arena_mat(rtk->arena, ny, nx);
+    b = arena_mat(rtk->arena, nb, 2);
+    db = arena_mat(rtk->arena, nb, 1);
+    Qb = arena_mat(rtk->arena, nb, nb);
+    Qab = arena_mat(rtk->arena, na, nb);
+    QQ = arena_mat(rtk->arena, na, nb);
 
     /* transform single to double-differenced phase-bias (y=D'*x, Qy=D'*P*D) */
     matmul("TN", ny, 1, nx, 1.0, D, rtk->x, 0.0, y);
@@ -2212,7 +2212,7 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
     tracemat(4, y + na, 1, nb, 10, 3);
 
     /* lambda/mlambda integer least-square estimation */
-    if (!(info = lambda(nb, 2, y + na, Qb, b, s)))
+    if (!(info = lambda(nb, 2, y + na, Qb, b, s, rtk->arena)))
         {
             trace(4, "N(1)=");
             tracemat(4, b, 1, nb, 10, 3);
@@ -2273,15 +2273,15 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
         {
             errmsg(rtk, "lambda error (info=%d)\n", info);
         }
-    free(D);
-    free(y);
-    free(Qy);
-    free(DP);
-    free(b);
-    free(db);
-    free(Qb);
-    free(Qab);
-    free(QQ);
+    arena_release(rtk->arena, D);
+    arena_release(rtk->arena, y);
+    arena_release(rtk->arena, Qy);
+    arena_release(rtk->arena, DP);
+    arena_release(rtk->arena, b);
+    arena_release(rtk->arena, db);
+    arena_release(rtk->arena, Qb);
+    arena_release(rtk->arena, Qab);
+    arena_release(rtk->arena, QQ);
 
     return nb; /* number of ambiguities */
 }
@@ -2385,12 +2385,12 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
 
     dt = timediff(time, obs[nu].time);
 
-    rs = mat(6, n);
-    dts = mat(2, n);
-    var = mat(1, n);
-    y = mat(nf * 2, n);
-    e = mat(3, n);
-    azel = zeros(2, n);
+    rs = arena_mat(rtk->arena, 6, n);
+    dts = arena_mat(rtk->arena, 2, n);
+    var = arena_mat(rtk->arena, 1, n);
+    y = arena_mat(rtk->arena, nf * 2, n);
+    e = arena_mat(rtk->arena, 3, n);
+    azel = arena_zeros(rtk->arena, 2, n);
 
     for (i = 0; i < MAXSAT; i++)
         {
@@ -2409,12 +2409,12 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
         {
             errmsg(rtk, "initial base station position error\n");
 
-            free(rs);
-            free(dts);
-            free(var);
-            free(y);
-            free(e);
-            free(azel);
+            arena_release(rtk->arena, rs);
+            arena_release(rtk->arena, dts);
+            arena_release(rtk->arena, var);
+            arena_release(rtk->arena, y);
+            arena_release(rtk->arena, e);
+            arena_release(rtk->arena, azel);
             return 0;
         }
     /* time-interpolation of residuals (for post-processing) */
@@ -2427,12 +2427,12 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
         {
             errmsg(rtk, "no common satellite\n");
 
-            free(rs);
-            free(dts);
-            free(var);
-            free(y);
-            free(e);
-            free(azel);
+            arena_release(rtk->arena, rs);
+            arena_release(rtk->arena, dts);
+            arena_release(rtk->arena, var);
+            arena_release(rtk->arena, y);
+            arena_release(rtk->arena, e);
+            arena_release(rtk->arena, azel);
             return 0;
         }
     /* temporal update of states */
@@ -2441,16 +2441,16 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
     trace(4, "x(0)=");
     tracemat(4, rtk->x, 1, NR_RTK(opt), 13, 4);
 
-    xp = mat(rtk->nx, 1);
-    Pp = zeros(rtk->nx, rtk->nx);
-    xa = mat(rtk->nx, 1);
+    xp = arena_mat(rtk->arena, rtk->nx, 1);
+    Pp = arena_zeros(rtk->arena, rtk->nx, rtk->nx);
+    xa = arena_mat(rtk->arena, rtk->nx, 1);
     matcpy(xp, rtk->x, rtk->nx, 1);
 
     ny = ns * nf * 2 + 2;
-    v = mat(ny, 1);
-    H = zeros(rtk->nx, ny);
-    R = mat(ny, ny);
-    bias = mat(rtk->nx, 1);
+    v = arena_mat(rtk->arena, ny, 1);
+    H = arena_zeros(rtk->arena, rtk->nx, ny);
+    R = arena_mat(rtk->arena, ny, ny);
+    bias = arena_mat(rtk->arena, rtk->nx, 1);
 
     /* add 2 iterations for baseline-constraint moving-base */
     niter = opt->niter + (opt->mode == PMODE_MOVEB && opt->baseline[0] > 0.0 ? 2 : 0);
@@ -2619,19 +2619,19 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
                         }
                 }
         }
-    free(rs);
-    free(dts);
-    free(var);
-    free(y);
-    free(e);
-    free(azel);
-    free(xp);
-    free(Pp);
-    free(xa);
-    free(v);
-    free(H);
-    free(R);
-    free(bias);
+    arena_release(rtk->arena, rs);
+    arena_release(rtk->arena, dts);
+    arena_release(rtk->arena, var);
+    arena_release(rtk->arena, y);
+    arena_release(rtk->arena, e);
+    arena_release(rtk->arena, azel);
+    arena_release(rtk->arena, xp);
+    arena_release(rtk->arena, Pp);
+    arena_release(rtk->arena, xa);
+    arena_release(rtk->arena, v);
+    arena_release(rtk->arena, H);
+    arena_release(rtk->arena, R);
+    arena_release(rtk->arena, bias);
 
     if (stat != SOLQ_NONE)
         {
@@ -2680,6 +2680,7 @@ void rtkinit(rtk_t *rtk, const prcopt_t *opt)
             rtk->errbuf[i] = 0;
         }
     rtk->opt = *opt;
+    rtk->arena = arena_new(0);
 }
 
 
@@ -2701,6 +2702,8 @@ void rtkfree(rtk_t *rtk)
     rtk->xa = nullptr;
     free(rtk->Pa);
     rtk->Pa = nullptr;
+    arena_free(rtk->arena);
+    rtk->arena = nullptr;
 }
 
 
@@ -2751,6 +2754,7 @@ void rtkfree(rtk_t *rtk)
  *            rtk->nfix      IO  number of continuous fixes of ambiguity
  *            rtk->neb       IO  bytes of error message buffer
  *            rtk->errbuf    IO  error message buffer
+ *            rtk->arena     IO  memory arena for per-epoch temporaries (reset)
  *            rtk->tstr      O   time string for debug
  *            rtk->opt       I   processing options
  *          obsd_t *obs      I   observation data for an epoch
@@ -2777,6 +2781,9 @@ int rtkpos(rtk_t *rtk, const obsd_t *obs, int n, const nav_t *nav)
     traceobs(4, obs, n);
     /*trace(5,"nav=\n"); tracenav(5,nav);*/
 
+    /* release per-epoch temporaries of the previous epoch */
+    arena_reset(rtk->arena);
+
     /* set base station position */
     if (opt->refpos <= POSOPT_RINEX && opt->mode != PMODE_SINGLE &&
         opt->mode != PMODE_MOVEB)
@@ -0,0 +1,438 @@
+/*!
+ * \file rtklib_smallmat.cc
+ * \brief Dense linear algebra kernels for the small matrices used by RTKLIB
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_smallmat.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+
+namespace
+{
+/* inner dimension block size of the matrix product (keeps the active panel of
+ * the left operand in L1 cache for the matrix sizes used in PVT) */
+const int SMALLMAT_BLOCK = 16;
+
+/* thread-local scratch pool, grown on demand and never shrunk, so that
+ * repeated calls with the same dimensions do not touch the heap */
+thread_local std::array<std::vector<double>, SMALLMAT_WORK_NSLOT> work_pool;
+thread_local std::array<std::vector<int>, SMALLMAT_WORK_NSLOT> iwork_pool;
+}  // namespace
+
+
+/* scratch workspace -----------------------------------------------------------
+ * get a thread-local scratch buffer
+ * args   : smallmat_slot_t slot  I   workspace slot
+ *          int    n         I   number of elements
+ * return : pointer to (uninitialized) buffer of at least n elements
+ * notes  : the buffer is reused by the next request on the same slot and the
+ *          same thread, so callers must not keep it across calls
+ *-----------------------------------------------------------------------------*/
+double *smallmat_work(smallmat_slot_t slot, int n)
+{
+    auto &w = work_pool[slot];
+    if (w.size() < static_cast<size_t>(std::max(n, 1)))
+        {
+            w.resize(std::max(n, 1));
+        }
+    return w.data();
+}
+
+
+int *smallmat_iwork(smallmat_slot_t slot, int n)
+{
+    auto &w = iwork_pool[slot];
+    if (w.size() < static_cast<size_t>(std::max(n, 1)))
+        {
+            w.resize(std::max(n, 1));
+        }
+    return w.data();
+}
+
+
+/* multiply matrix -------------------------------------------------------------
+ * multiply matrix by matrix (C=alpha*A*B+beta*C), same interface as matmul()
+ * args   : char   *tr       I  transpose flags ("N":normal,"T":transpose)
+ *          int    n,k,m     I  size of (transposed) matrix A,B
+ *          double alpha     I  alpha
+ *          double *A,*B     I  (transposed) matrix A (n x m), B (m x k)
+ *          double beta      I  beta
+ *          double *C        IO matrix C (n x k)
+ * return : none
+ * notes  : the inner dimension is processed in blocks of SMALLMAT_BLOCK and
+ *          every case is ordered so that the innermost loop runs over
+ *          contiguous memory. zero elements are not skipped, so inf and nan
+ *          propagate as in dgemm (0*inf=nan)
+ *-----------------------------------------------------------------------------*/
+void smallmat_mul(const char *tr, int n, int k, int m, double alpha,
+    const double *A, const double *B, double beta, double *C)
+{
+    const bool ta = tr[0] == 'T';
+    const bool tb = tr[1] == 'T';
+    double d;
+    int i;
+    int j;
+    int l;
+    int l0;
+    int l1;
+
+    if (beta == 0.0)
+        {
+            std::fill(C, C + n * k, 0.0);
+        }
+    else if (beta != 1.0)
+        {
+            for (i = 0; i < n * k; i++)
+                {
+                    C[i] *= beta;
+                }
+        }
+    if (alpha == 0.0)
+        {
+            return;
+        }
+    for (l0 = 0; l0 < m; l0 += SMALLMAT_BLOCK)
+        {
+            l1 = std::min(l0 + SMALLMAT_BLOCK, m);
+            if (!ta && !tb)
+                {
+                    /* C(:,j)+=alpha*A(:,l)*B(l,j) */
+                    for (j = 0; j < k; j++)
+                        {
+                            double *c = C + j * n;
+                            for (l = l0; l < l1; l++)
+                                {
+                                    d = alpha * B[l + j * m];
+                                    const double *a = A + l * n;
+                                    for (i = 0; i < n; i++)
+                                        {
+                                            c[i] += d * a[i];
+                                        }
+                                }
+                        }
+                }
+            else if (ta && !tb)
+                {
+                    /* C(i,j)+=alpha*A(:,i)'*B(:,j) */
+                    for (j = 0; j < k; j++)
+                        {
+                            const double *b = B + j * m;
+                            for (i = 0; i < n; i++)
+                                {
+                                    const double *a = A + i * m;
+                                    d = 0.0;
+                                    for (l = l0; l < l1; l++)
+                                        {
+                                            d += a[l] * b[l];
+                                        }
+                                    C[i + j * n] += alpha * d;
+                                }
+                        }
+                }
+            else if (!ta && tb)
+                {
+                    /* C(:,j)+=alpha*A(:,l)*B(j,l) */
+                    for (l = l0; l < l1; l++)
+                        {
+                            const double *a = A + l * n;
+                            for (j = 0; j < k; j++)
+                                {
+                                    d = alpha * B[j + l * k];
+                                    double *c = C + j * n;
+                                    for (i = 0; i < n; i++)
+                                        {
+                                            c[i] += d * a[i];
+                                        }
+                                }
+                        }
+                }
+            else
+                {
+                    /* C(i,j)+=alpha*A(:,i)'*B(j,:)' */
+                    for (j = 0; j < k; j++)
+                        {
+                            for (i = 0; i < n; i++)
+                                {
+                                    const double *a = A + i * m;
+                                    d = 0.0;
+                                    for (l = l0; l < l1; l++)
+                                        {
+                                            d += a[l] * B[j + l * k];
+                                        }
+                                    C[i + j * n] += alpha * d;
+                                }
+                        }
+                }
+        }
+}
+
+
+/* inverse of matrix -----------------------------------------------------------
+ * inverse of matrix (A=A^-1) by Gauss-Jordan elimination with partial pivoting
+ * args   : double *A        IO  matrix (n x n)
+ *          int    n         I   size of matrix A
+ * return : status (0:ok,>0:singular, index of the zero pivot as in dgetrf)
+ *-----------------------------------------------------------------------------*/
+int smallmat_inv(double *A, int n)
+{
+    int *ipiv = smallmat_iwork(SMALLMAT_WORK_INV, n);
+    double *w = smallmat_work(SMALLMAT_WORK_INV, n);
+    double piv;
+    double t;
+    int c;
+    int i;
+    int j;
+    int p;
+
+    for (c = 0; c < n; c++)
+        {
+            for (i = c + 1, p = c; i < n; i++)
+                {
+                    if (std::fabs(A[i + c * n]) > std::fabs(A[p + c * n]))
+                        {
+                            p = i;
+                        }
+                }
+            if (A[p + c * n] == 0.0)
+                {
+                    return c + 1;
+                }
+            ipiv[c] = p;
+            if (p != c)
+                {
+                    for (j = 0; j < n; j++)
+                        {
+                            std::swap(A[c + j * n], A[p + j * n]);
+                        }
+                }
+            piv = 1.0 / A[c + c * n];
+            A[c + c * n] = 1.0;
+            for (j = 0; j < n; j++)
+                {
+                    A[c + j * n] *= piv;
+                }
+            for (i = 0; i < n; i++)
+                {
+                    w[i] = A[i + c * n];
+                    if (i != c)
+                        {
+                            A[i + c * n] = 0.0;
+                        }
+                }
+            w[c] = 0.0;
+            for (j = 0; j < n; j++)
+                {
+                    if ((t = A[c + j * n]) == 0.0)
+                        {
+                            continue;
+                        }
+                    for (i = 0; i < n; i++)
+                        {
+                            A[i + j * n] -= w[i] * t;
+                        }
+                }
+        }
+    /* undo the row interchanges as column interchanges */
+    for (c = n - 1; c >= 0; c--)
+        {
+            if (ipiv[c] != c)
+                {
+                    std::swap_ranges(A + c * n, A + (c + 1) * n, A + ipiv[c] * n);
+                }
+        }
+    return 0;
+}
+
+
+/* inverse of symmetric positive definite matrix -------------------------------
+ * inverse of symmetric positive definite matrix (A=A^-1) by Cholesky
+ * factorization (A=L*L', A^-1=L'^-1*L^-1)
+ * args   : double *A        IO  matrix (n x n), only lower triangle is read
+ *          int    n         I   size of matrix A
+ * return : status (0:ok,>0:not positive definite, index of the failing pivot)
+ * notes  : A is not modified if the factorization fails, so the caller can
+ *          fall back to a general inversion
+ *-----------------------------------------------------------------------------*/
+int smallmat_cholinv(double *A, int n)
+{
+    double *L = smallmat_work(SMALLMAT_WORK_CHOL, n * n);
+    double d;
+    int i;
+    int j;
+    int p;
+
+    /* L*L'=A */
+    for (j = 0; j < n; j++)
+        {
+            d = A[j + j * n];
+            for (p = 0; p < j; p++)
+                {
+                    d -= L[j + p * n] * L[j + p * n];
+                }
+            if (d <= 0.0 || std::isnan(d))
+                {
+                    return j + 1;
+                }
+            L[j + j * n] = std::sqrt(d);
+            for (i = j + 1; i < n; i++)
+                {
+                    d = A[i + j * n];
+                    for (p = 0; p < j; p++)
+                        {
+                            d -= L[i + p * n] * L[j + p * n];
+                        }
+                    L[i + j * n] = d / L[j + j * n];
+                }
+        }
+    /* L=L^-1 in place, column by column */
+    for (j = 0; j < n; j++)
+        {
+            L[j + j * n] = 1.0 / L[j + j * n];
+            for (i = j + 1; i < n; i++)
+                {
+                    d = L[i + j * n] * L[j + j * n];
+                    for (p = j + 1; p < i; p++)
+                        {
+                            d += L[i + p * n] * L[p + j * n];
+                        }
+                    L[i + j * n] = -d / L[i + i * n];
+                }
+        }
+    /* A^-1=L^-T*L^-1 */
+    for (j = 0; j < n; j++)
+        {
+            for (i = j; i < n; i++)
+                {
+                    d = 0.0;
+                    for (p = i; p < n; p++)
+                        {
+                            d += L[p + i * n] * L[p + j * n];
+                        }
+                    A[i + j * n] = A[j + i * n] = d;
+                }
+        }
+    return 0;
+}
+
+
+/* solve linear equation -------------------------------------------------------
+ * solve linear equation (X=A\Y or X=A'\Y) by LU decomposition with partial
+ * pivoting, same interface as solve()
+ * args   : char   *tr       I   transpose flag ("N":normal,"T":transpose)
+ *          double *A        I   input matrix A (n x n)
+ *          double *Y        I   input matrix Y (n x m)
+ *          int    n,m       I   size of matrix A,Y
+ *          double *X        O   X=A\Y or X=A'\Y (n x m)
+ * return : status (0:ok,>0:singular)
+ * notes  : X can be same as Y
+ *-----------------------------------------------------------------------------*/
+int smallmat_solve(const char *tr, const double *A, const double *Y, int n,
+    int m, double *X)
+{
+    double *B = smallmat_work(SMALLMAT_WORK_SOLVE, n * n);
+    double t;
+    int c;
+    int i;
+    int j;
+    int p;
+
+    if (tr[0] == 'T')
+        {
+            for (j = 0; j < n; j++)
+                {
+                    for (i = 0; i < n; i++)
+                        {
+                            B[i + j * n] = A[j + i * n];
+                        }
+                }
+        }
+    else
+        {
+            std::copy(A, A + n * n, B);
+        }
+    if (X != Y)
+        {
+            std::copy(Y, Y + n * m, X);
+        }
+    /* forward elimination, multipliers stored below the diagonal of B */
+    for (c = 0; c < n; c++)
+        {
+            for (i = c + 1, p = c; i < n; i++)
+                {
+                    if (std::fabs(B[i + c * n]) > std::fabs(B[p + c * n]))
+                        {
+                            p = i;
+                        }
+                }
+            if (B[p + c * n] == 0.0)
+                {
+                    return c + 1;
+                }
+            if (p != c)
+                {
+                    for (j = 0; j < n; j++)
+                        {
+                            std::swap(B[c + j * n], B[p + j * n]);
+                        }
+                    for (j = 0; j < m; j++)
+                        {
+                            std::swap(X[c + j * n], X[p + j * n]);
+                        }
+                }
+            for (i = c + 1; i < n; i++)
+                {
+                    B[i + c * n] /= B[c + c * n];
+                }
+            for (j = c + 1; j < n; j++)
+                {
+                    if ((t = B[c + j * n]) == 0.0)
+                        {
+                            continue;
+                        }
+                    for (i = c + 1; i < n; i++)
+                        {
+                            B[i + j * n] -= B[i + c * n] * t;
+                        }
+                }
+            for (j = 0; j < m; j++)
+                {
+                    if ((t = X[c + j * n]) == 0.0)
+                        {
+                            continue;
+                        }
+                    for (i = c + 1; i < n; i++)
+                        {
+                            X[i + j * n] -= B[i + c * n] * t;
+                        }
+                }
+        }
+    /* back substitution */
+    for (j = 0; j < m; j++)
+        {
+            double *x = X + j * n;
+            for (c = n - 1; c >= 0; c--)
+                {
+                    x[c] /= B[c + c * n];
+                    t = x[c];
+                    for (i = 0; i < c; i++)
+                        {
+                            x[i] -= B[i + c * n] * t;
+                        }
+                }
+        }
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*!
+ * \file rtklib_smallmat.h
+ * \brief Dense linear algebra kernels for the small matrices used by RTKLIB
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RTKLIB_SMALLMAT_H
+#define GNSS_SDR_RTKLIB_SMALLMAT_H
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup RTKLIB_Library
+ * \{ */
+
+
+/* maximum matrix dimension served by the small matrix kernels. Larger
+ * problems are dispatched to BLAS/LAPACK by the rtkcmn matrix routines */
+const int SMALLMAT_NMAX = 64;
+
+/* true if all the given dimensions are within the small matrix range */
+inline bool smallmat_fits(int n, int k = 1, int m = 1)
+{
+    return n <= SMALLMAT_NMAX && k <= SMALLMAT_NMAX && m <= SMALLMAT_NMAX;
+}
+
+/* workspace slots of the thread-local scratch pool */
+enum smallmat_slot_t
+{
+    SMALLMAT_WORK_INV = 0, /* matrix inversion */
+    SMALLMAT_WORK_CHOL,    /* cholesky factorization */
+    SMALLMAT_WORK_SOLVE,   /* linear equation solver */
+    SMALLMAT_WORK_LSQ,     /* least square estimation */
+    SMALLMAT_WORK_FILT,    /* kalman filter update (filter_) */
+    SMALLMAT_WORK_FILTX,   /* kalman filter state selection (filter) */
+    SMALLMAT_WORK_NSLOT
+};
+
+double *smallmat_work(smallmat_slot_t slot, int n);
+int *smallmat_iwork(smallmat_slot_t slot, int n);
+
+void smallmat_mul(const char *tr, int n, int k, int m, double alpha,
+    const double *A, const double *B, double beta, double *C);
+int smallmat_inv(double *A, int n);
+int smallmat_cholinv(double *A, int n);
+int smallmat_solve(const char *tr, const double *A, const double *Y, int n,
+    int m, double *X);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RTKLIB_SMALLMAT_H
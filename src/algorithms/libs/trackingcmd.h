@@ -28,13 +28,14 @@
 class TrackingCmd
 {
 public:
-    TrackingCmd();
+    TrackingCmd() = default;
 
     bool enable_carrier_nco_cmd = false;
     bool enable_code_nco_cmd = false;
     double code_freq_chips = 0.0;
     double carrier_freq_hz = 0.0;
     double carrier_freq_rate_hz_s = 0.0;
+    double code_phase_correction_chips = 0.0;
     uint64_t sample_counter = 0UL;
 };
 
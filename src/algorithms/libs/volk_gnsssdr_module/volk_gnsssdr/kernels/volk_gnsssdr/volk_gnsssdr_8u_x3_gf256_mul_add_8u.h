@@ -0,0 +1,189 @@
+/*!
+ * \file volk_gnsssdr_8u_x3_gf256_mul_add_8u.h
+ * \brief VOLK_GNSSSDR kernel: multiplies a vector by a constant in GF(2^8)
+ * and adds it to another vector.
+ *
+ * VOLK_GNSSSDR kernel that computes c = a + k * b in GF(2^8), where the
+ * product by the constant k is given by two 16-entry lookup tables, one for
+ * each nibble of b (split table multiplication).
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_x3_gf256_mul_add_8u
+ *
+ * \b Overview
+ *
+ * Multiplies the elements of bChar by a constant in GF(2^8) and adds (XOR)
+ * them to the elements of aChar, storing the result in cChar:
+ * cChar[i] = aChar[i] ^ tables[bChar[i] & 15] ^ tables[16 + (bChar[i] >> 4)]
+ *
+ * The first 16 elements of tables are the products of the constant by
+ * 0, 1, ..., 15, and the next 16 are its products by 0, 16, ..., 240. cChar
+ * can be the same vector as aChar.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_x3_gf256_mul_add_8u(unsigned char* cChar, const unsigned char* aChar, const unsigned char* bChar, const unsigned char* tables, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li aChar: Vector to which the product is added
+ * \li bChar: Vector to be multiplied by the constant
+ * \li tables: Low and high nibble product tables of the constant (32 values)
+ * \li num_points: The number of data points.
+ *
+ * \b Outputs
+ * \li cChar: The vector where the result will be stored
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_x3_gf256_mul_add_8u_H
+#define INCLUDED_volk_gnsssdr_8u_x3_gf256_mul_add_8u_H
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_x3_gf256_mul_add_8u_generic(unsigned char* cChar, const unsigned char* aChar, const unsigned char* bChar, const unsigned char* tables, unsigned int num_points)
+{
+    unsigned int i;
+    for (i = 0; i < num_points; ++i)
+        {
+            cChar[i] = aChar[i] ^ tables[bChar[i] & 0x0F] ^ tables[16 + (bChar[i] >> 4)];
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_x3_gf256_mul_add_8u_u_ssse3(unsigned char* cChar, const unsigned char* aChar, const unsigned char* bChar, const unsigned char* tables, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 16;
+    unsigned int number;
+    unsigned int i;
+
+    const __m128i table_lo = _mm_loadu_si128((const __m128i*)tables);
+    const __m128i table_hi = _mm_loadu_si128((const __m128i*)(tables + 16));
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    __m128i a, b, lo, hi;
+
+    unsigned char* c = cChar;
+    const unsigned char* _a = aChar;
+    const unsigned char* _b = bChar;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            a = _mm_loadu_si128((const __m128i*)_a);
+            b = _mm_loadu_si128((const __m128i*)_b);
+            lo = _mm_shuffle_epi8(table_lo, _mm_and_si128(b, mask));
+            hi = _mm_shuffle_epi8(table_hi, _mm_and_si128(_mm_srli_epi64(b, 4), mask));
+            _mm_storeu_si128((__m128i*)c, _mm_xor_si128(a, _mm_xor_si128(lo, hi)));
+            _a += 16;
+            _b += 16;
+            c += 16;
+        }
+
+    for (i = sse_iters * 16; i < num_points; ++i)
+        {
+            cChar[i] = aChar[i] ^ tables[bChar[i] & 0x0F] ^ tables[16 + (bChar[i] >> 4)];
+        }
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_x3_gf256_mul_add_8u_u_avx2(unsigned char* cChar, const unsigned char* aChar, const unsigned char* bChar, const unsigned char* tables, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 32;
+    unsigned int number;
+    unsigned int i;
+
+    // vpshufb works within each 128-bit lane, so both lanes get the tables
+    const __m256i table_lo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)tables));
+    const __m256i table_hi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(tables + 16)));
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    __m256i a, b, lo, hi;
+
+    unsigned char* c = cChar;
+    const unsigned char* _a = aChar;
+    const unsigned char* _b = bChar;
+
+    for (number = 0; number < avx2_iters; number++)
+        {
+            a = _mm256_loadu_si256((const __m256i*)_a);
+            b = _mm256_loadu_si256((const __m256i*)_b);
+            lo = _mm256_shuffle_epi8(table_lo, _mm256_and_si256(b, mask));
+            hi = _mm256_shuffle_epi8(table_hi, _mm256_and_si256(_mm256_srli_epi64(b, 4), mask));
+            _mm256_storeu_si256((__m256i*)c, _mm256_xor_si256(a, _mm256_xor_si256(lo, hi)));
+            _a += 32;
+            _b += 32;
+            c += 32;
+        }
+
+    for (i = avx2_iters * 32; i < num_points; ++i)
+        {
+            cChar[i] = aChar[i] ^ tables[bChar[i] & 0x0F] ^ tables[16 + (bChar[i] >> 4)];
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_x3_gf256_mul_add_8u_neon(unsigned char* cChar, const unsigned char* aChar, const unsigned char* bChar, const unsigned char* tables, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 8;
+    unsigned int number;
+    unsigned int i;
+
+    uint8x8x2_t table_lo;
+    uint8x8x2_t table_hi;
+    table_lo.val[0] = vld1_u8(tables);
+    table_lo.val[1] = vld1_u8(tables + 8);
+    table_hi.val[0] = vld1_u8(tables + 16);
+    table_hi.val[1] = vld1_u8(tables + 24);
+    const uint8x8_t mask = vdup_n_u8(0x0F);
+    uint8x8_t a, b, lo, hi;
+
+    unsigned char* c = cChar;
+    const unsigned char* _a = aChar;
+    const unsigned char* _b = bChar;
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            a = vld1_u8(_a);
+            b = vld1_u8(_b);
+            lo = vtbl2_u8(table_lo, vand_u8(b, mask));
+            hi = vtbl2_u8(table_hi, vshr_n_u8(b, 4));
+            vst1_u8(c, veor_u8(a, veor_u8(lo, hi)));
+            _a += 8;
+            _b += 8;
+            c += 8;
+        }
+
+    for (i = neon_iters * 8; i < num_points; ++i)
+        {
+            cChar[i] = aChar[i] ^ tables[bChar[i] & 0x0F] ^ tables[16 + (bChar[i] >> 4)];
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_x3_gf256_mul_add_8u_H */
@@ -0,0 +1,359 @@
+/*!
+ * \file vtl_engine.cc
+ * \brief Vector tracking engine: a single navigation-domain Kalman filter
+ * that drives the code and carrier NCOs of all the tracking channels.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "vtl_engine.h"
+#include "MATH_CONSTANTS.h"          // for SPEED_OF_LIGHT_M_S
+#include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
+#include <glog/logging.h>
+#include <algorithm>  // for std::min, std::max
+#include <cmath>      // for std::pow, std::fabs
+
+
+namespace
+{
+// state vector indexes
+constexpr arma::uword POS = 0;
+constexpr arma::uword VEL = 3;
+constexpr arma::uword BIAS = 6;
+constexpr arma::uword DRIFT = 7;
+constexpr arma::uword N_STATES = 8;
+
+// noise power relative to a 45 dB-Hz signal, within sensible limits
+double cn0_noise_scale(double cn0_db_hz)
+{
+    const double scale = std::pow(10.0, (45.0 - cn0_db_hz) / 10.0);
+    return std::min(std::max(scale, 0.1), 1000.0);
+}
+}  // namespace
+
+
+Vtl_Engine& Vtl_Engine::instance()
+{
+    static Vtl_Engine engine;
+    return engine;
+}
+
+
+void Vtl_Engine::configure(const Parameters& parameters)
+{
+    // the engine outlives the flowgraph, which can be rebuilt in the same process
+    reset();
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_parameters = parameters;
+}
+
+
+void Vtl_Engine::reset()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    for (auto& channel : d_channels)
+        {
+            channel->has_satellite = false;
+            channel->released.store(true, std::memory_order_relaxed);
+            channel->commanded.store(false, std::memory_order_release);
+        }
+    d_has_solution.store(false, std::memory_order_release);
+    d_steps.store(0, std::memory_order_relaxed);
+    d_state_sample_counter = 0;
+}
+
+
+void Vtl_Engine::register_channel(int32_t channel)
+{
+    if (channel < 0 or channel >= MAX_CHANNELS)
+        {
+            LOG(WARNING) << "Channel " << channel << " is out of the range of the vector tracking engine";
+            return;
+        }
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_channel_ptrs[channel].load(std::memory_order_relaxed) == nullptr)
+        {
+            d_channels.push_back(std::make_unique<Channel>());
+            d_channel_ptrs[channel].store(d_channels.back().get(), std::memory_order_release);
+        }
+}
+
+
+Vtl_Engine::Channel* Vtl_Engine::channel_slot(int32_t channel) const
+{
+    if (channel < 0 or channel >= MAX_CHANNELS)
+        {
+            return nullptr;
+        }
+    return d_channel_ptrs[channel].load(std::memory_order_acquire);
+}
+
+
+void Vtl_Engine::release_channel(int32_t channel)
+{
+    Channel* slot = channel_slot(channel);
+    if (slot != nullptr)
+        {
+            slot->released.store(true, std::memory_order_release);
+        }
+}
+
+
+void Vtl_Engine::post_measurement(int32_t channel, const Channel_Measurement& measurement)
+{
+    Channel* slot = channel_slot(channel);
+    if (slot != nullptr)
+        {
+            slot->measurement.store(measurement);
+            slot->released.store(false, std::memory_order_release);
+        }
+}
+
+
+uint32_t Vtl_Engine::read_command(int32_t channel, TrackingCmd& command) const
+{
+    const Channel* slot = channel_slot(channel);
+    if (slot == nullptr or slot->released.load(std::memory_order_acquire) or !slot->commanded.load(std::memory_order_acquire))
+        {
+            return 0;
+        }
+    return slot->command.load(command);
+}
+
+
+bool Vtl_Engine::has_solution() const
+{
+    return d_has_solution.load(std::memory_order_acquire);
+}
+
+
+arma::vec Vtl_Engine::state() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_x;
+}
+
+
+uint64_t Vtl_Engine::steps() const
+{
+    return d_steps.load(std::memory_order_relaxed);
+}
+
+
+void Vtl_Engine::set_navigation_solution(const Navigation_Solution& solution)
+{
+    if (solution.fs <= 0.0)
+        {
+            return;
+        }
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_fs = solution.fs;
+    for (const auto& sat : solution.satellites)
+        {
+            Channel* slot = channel_slot(sat.first);
+            if (slot != nullptr)
+                {
+                    slot->satellite = sat.second;
+                    slot->satellite_sample_counter = solution.sample_counter;
+                    slot->has_satellite = true;
+                }
+        }
+
+    const arma::vec pos = {solution.pos[0], solution.pos[1], solution.pos[2]};
+    bool initialize = !d_has_solution.load(std::memory_order_relaxed);
+    if (!initialize and solution.sample_counter < d_state_sample_counter)
+        {
+            LOG(WARNING) << "Vector tracking engine state is ahead of the PVT solution. Resetting it.";
+            initialize = true;
+        }
+    if (!initialize)
+        {
+            // compare with the engine position at the time of the fix
+            const double dt = (static_cast<double>(solution.sample_counter) - static_cast<double>(d_state_sample_counter)) / d_fs;
+            const arma::vec engine_pos = d_x.subvec(POS, POS + 2) + d_x.subvec(VEL, VEL + 2) * dt;
+            if (arma::norm(engine_pos - pos) > d_parameters.max_position_error_m)
+                {
+                    LOG(WARNING) << "Vector tracking engine diverged from the PVT solution by "
+                                 << arma::norm(engine_pos - pos) << " m. Resetting it.";
+                    initialize = true;
+                }
+        }
+    if (initialize)
+        {
+            d_x = arma::zeros<arma::vec>(N_STATES);
+            d_x.subvec(POS, POS + 2) = pos;
+            d_x.subvec(VEL, VEL + 2) = arma::vec({solution.vel[0], solution.vel[1], solution.vel[2]});
+            d_x(DRIFT) = solution.clock_drift_m_s;
+            const arma::vec sd = {10.0, 10.0, 10.0, 1.0, 1.0, 1.0, 10.0, 1.0};
+            d_P = arma::diagmat(sd % sd);
+            d_state_sample_counter = solution.sample_counter;
+            d_has_solution.store(true, std::memory_order_release);
+        }
+}
+
+
+void Vtl_Engine::predict(double dt_s)
+{
+    arma::mat F = arma::eye(N_STATES, N_STATES);
+    F.submat(POS, VEL, POS + 2, VEL + 2) = arma::eye(3, 3) * dt_s;
+    F(BIAS, DRIFT) = dt_s;
+
+    const double dt2 = dt_s * dt_s;
+    const double dt3 = dt2 * dt_s;
+    const double qa = d_parameters.accel_sd_m_s2 * d_parameters.accel_sd_m_s2;
+    const double qc = d_parameters.clock_drift_sd_m_s2 * d_parameters.clock_drift_sd_m_s2;
+    arma::mat Q = arma::zeros(N_STATES, N_STATES);
+    Q.submat(POS, POS, POS + 2, POS + 2) = arma::eye(3, 3) * qa * dt3 / 3.0;
+    Q.submat(POS, VEL, POS + 2, VEL + 2) = arma::eye(3, 3) * qa * dt2 / 2.0;
+    Q.submat(VEL, POS, VEL + 2, POS + 2) = arma::eye(3, 3) * qa * dt2 / 2.0;
+    Q.submat(VEL, VEL, VEL + 2, VEL + 2) = arma::eye(3, 3) * qa * dt_s;
+    Q(BIAS, BIAS) = qc * dt3 / 3.0;
+    Q(BIAS, DRIFT) = qc * dt2 / 2.0;
+    Q(DRIFT, BIAS) = qc * dt2 / 2.0;
+    Q(DRIFT, DRIFT) = qc * dt_s;
+
+    d_x = F * d_x;
+    d_P = F * d_P * F.t() + Q;
+}
+
+
+bool Vtl_Engine::update(uint64_t sample_counter)
+{
+    std::unique_lock<std::mutex> lock(d_mutex, std::try_to_lock);
+    if (!lock.owns_lock() or !d_has_solution.load(std::memory_order_relaxed) or sample_counter <= d_state_sample_counter)
+        {
+            return false;
+        }
+    const double dt = static_cast<double>(sample_counter - d_state_sample_counter) / d_fs;
+    if (dt < d_parameters.update_period_s)
+        {
+            return false;
+        }
+    predict(dt);
+    d_state_sample_counter = sample_counter;
+    const double t = static_cast<double>(sample_counter) / d_fs;
+    const auto max_age = static_cast<int64_t>(2.0 * d_parameters.update_period_s * d_fs);
+
+    // Channels with a known satellite, their line of sight and measurements
+    struct Commanded
+    {
+        Channel* slot;
+        Channel_Measurement signal;
+        arma::vec u;
+        arma::vec sat_vel;
+        double sat_clock_drift;
+    };
+    std::vector<Commanded> commanded;
+    commanded.reserve(d_channels.size());
+    std::vector<arma::rowvec> rows;
+    std::vector<double> z;
+    std::vector<double> r;
+    rows.reserve(2 * d_channels.size());
+    z.reserve(2 * d_channels.size());
+    r.reserve(2 * d_channels.size());
+
+    const arma::vec rx_pos = d_x.subvec(POS, POS + 2);
+    const arma::vec rx_vel = d_x.subvec(VEL, VEL + 2);
+    for (auto& channel : d_channels)
+        {
+            Channel* slot = channel.get();
+            if (!slot->has_satellite or slot->released.load(std::memory_order_acquire))
+                {
+                    continue;
+                }
+            const double age = (t - static_cast<double>(slot->satellite_sample_counter) / d_fs);
+            Channel_Measurement m{};
+            const uint32_t version = slot->measurement.load(m);
+            if (version == 0 or age > d_parameters.satellite_timeout_s or m.satellite != slot->satellite.satellite or m.carrier_freq_hz <= 0.0)
+                {
+                    continue;
+                }
+
+            const arma::vec sat_vel = {slot->satellite.vel[0], slot->satellite.vel[1], slot->satellite.vel[2]};
+            const arma::vec sat_pos = arma::vec({slot->satellite.pos[0], slot->satellite.pos[1], slot->satellite.pos[2]}) + sat_vel * age;
+            const arma::vec los = sat_pos - rx_pos;
+            const arma::vec u = los / arma::norm(los);
+            commanded.push_back({slot, m, u, sat_vel, slot->satellite.clock_drift});
+
+            const bool fresh = version != slot->last_measurement and
+                               static_cast<int64_t>(sample_counter - m.sample_counter) < max_age;
+            if (!fresh)
+                {
+                    continue;
+                }
+            slot->last_measurement = version;
+            const double noise_scale = cn0_noise_scale(m.cn0_db_hz);
+
+            // pseudorange rate
+            const double lambda = SPEED_OF_LIGHT_M_S / m.carrier_freq_hz;
+            const double rate_pred = arma::dot(u, sat_vel - rx_vel) + d_x(DRIFT) - SPEED_OF_LIGHT_M_S * slot->satellite.clock_drift;
+            arma::rowvec h_rate = arma::zeros<arma::rowvec>(N_STATES);
+            h_rate.subvec(VEL, VEL + 2) = -u.t();
+            h_rate(DRIFT) = 1.0;
+            rows.push_back(h_rate);
+            z.push_back(-lambda * (m.carrier_doppler_hz + m.carrier_freq_error_hz) - rate_pred);
+            r.push_back(d_parameters.range_rate_sd_m_s * d_parameters.range_rate_sd_m_s * noise_scale);
+
+            // pseudorange error of the replica, only if the engine drives it
+            if (m.vector_mode and std::fabs(m.code_error_chips) < 0.5)
+                {
+                    arma::rowvec h_code = arma::zeros<arma::rowvec>(N_STATES);
+                    h_code.subvec(POS, POS + 2) = -u.t();
+                    h_code(BIAS) = 1.0;
+                    rows.push_back(h_code);
+                    z.push_back(m.code_error_chips * SPEED_OF_LIGHT_M_S / m.code_chip_rate);
+                    r.push_back(d_parameters.code_sd_m * d_parameters.code_sd_m * noise_scale);
+                }
+        }
+
+    // One measurement update with all the channels
+    arma::vec dx = arma::zeros<arma::vec>(N_STATES);
+    if (!rows.empty())
+        {
+            const auto n_rows = static_cast<arma::uword>(rows.size());
+            arma::mat H(n_rows, N_STATES);
+            for (arma::uword i = 0; i < n_rows; i++)
+                {
+                    H.row(i) = rows[i];
+                }
+            const arma::vec innovation(z);
+            const arma::mat S = H * d_P * H.t() + arma::diagmat(arma::vec(r));
+            arma::mat Kt;  // transposed gain, K = P H' S^-1
+            if (arma::solve(Kt, S, H * d_P, arma::solve_opts::no_approx))
+                {
+                    dx = Kt.t() * innovation;
+                    d_x += dx;
+                    d_P = (arma::eye(N_STATES, N_STATES) - Kt.t() * H) * d_P;
+                    d_P = 0.5 * (d_P + d_P.t());
+                }
+        }
+
+    // NCO commands for all the channels with a known satellite
+    const arma::vec new_rx_vel = d_x.subvec(VEL, VEL + 2);
+    for (const auto& c : commanded)
+        {
+            const double rate = arma::dot(c.u, c.sat_vel - new_rx_vel) + d_x(DRIFT) - SPEED_OF_LIGHT_M_S * c.sat_clock_drift;
+            const double doppler_hz = -rate * c.signal.carrier_freq_hz / SPEED_OF_LIGHT_M_S;
+            const double range_correction_m = -arma::dot(c.u, dx.subvec(POS, POS + 2)) + dx(BIAS);
+            TrackingCmd cmd;
+            cmd.enable_carrier_nco_cmd = true;
+            cmd.enable_code_nco_cmd = true;
+            cmd.carrier_freq_hz = doppler_hz;
+            cmd.carrier_freq_rate_hz_s = 0.0;
+            cmd.code_freq_chips = c.signal.code_chip_rate * (1.0 + doppler_hz / c.signal.carrier_freq_hz);
+            cmd.code_phase_correction_chips = range_correction_m * c.signal.code_chip_rate / SPEED_OF_LIGHT_M_S;
+            cmd.sample_counter = sample_counter;
+            c.slot->command.store(cmd);
+            c.slot->commanded.store(true, std::memory_order_release);
+        }
+    d_steps.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,253 @@
+/*!
+ * \file vtl_engine.h
+ * \brief Vector tracking engine: a single navigation-domain Kalman filter
+ * that drives the code and carrier NCOs of all the tracking channels.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_VTL_ENGINE_H
+#define GNSS_SDR_VTL_ENGINE_H
+
+#if ARMA_NO_BOUND_CHECKING
+#define ARMA_NO_DEBUG 1
+#endif
+
+#include "trackingcmd.h"
+#include <armadillo>
+#include <array>        // for std::array
+#include <atomic>       // for std::atomic
+#include <cstdint>      // for uint64_t, int32_t
+#include <cstring>      // for std::memcpy
+#include <map>          // for std::map
+#include <memory>       // for std::unique_ptr
+#include <mutex>        // for std::mutex
+#include <type_traits>  // for std::is_trivially_copyable
+#include <vector>       // for std::vector
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Single writer, single reader slot. The writer never waits, and the
+ * reader retries if the value changed while it was being copied.
+ */
+template <typename T>
+class Vtl_Slot
+{
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "Vtl_Slot needs a trivially copyable type");
+
+    void store(const T& value)
+    {
+        const uint32_t seq = d_seq.load(std::memory_order_relaxed);
+        d_seq.store(seq + 1, std::memory_order_relaxed);  // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&d_value, &value, sizeof(T));
+        d_seq.store(seq + 2, std::memory_order_release);
+    }
+
+    /*!
+     * \brief Copies the value and returns its version, which is zero if
+     * nothing was stored yet.
+     */
+    uint32_t load(T& value) const
+    {
+        while (true)
+            {
+                const uint32_t seq = d_seq.load(std::memory_order_acquire);
+                if (seq & 1U)
+                    {
+                        continue;
+                    }
+                std::memcpy(&value, &d_value, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (d_seq.load(std::memory_order_relaxed) == seq)
+                    {
+                        return seq / 2;
+                    }
+            }
+    }
+
+private:
+    std::atomic<uint32_t> d_seq{0};
+    T d_value{};
+};
+
+
+/*!
+ * \brief Vector tracking loop (VTL) engine shared by all the channels.
+ *
+ * The navigation-domain state is the receiver ECEF position [m] and
+ * velocity [m/s], clock bias [m] and clock drift [m/s]. Each tracking
+ * channel posts its discriminator outputs to its slot after every
+ * integration period, and calls update(). The first channel whose epoch
+ * reaches the next update time runs a single filter step with the latest
+ * measurements of all the channels, and writes the NCO commands (carrier
+ * Doppler, code rate and code phase correction) of every channel to their
+ * command slots. Channels read them without locks.
+ *
+ * The PVT block provides the satellite positions, velocities and clock
+ * drifts, and the first fix, through set_navigation_solution().
+ *
+ * Code discriminator outputs are only used from channels whose code NCO is
+ * driven by the engine (vector mode), since they measure the error of the
+ * predicted range. Channels still running their own loops contribute their
+ * Doppler estimate, so that the engine converges before taking control.
+ */
+class Vtl_Engine
+{
+public:
+    static constexpr int32_t MAX_CHANNELS = 512;
+
+    struct Parameters
+    {
+        double update_period_s = 0.02;         // time between filter steps
+        double accel_sd_m_s2 = 2.0;            // receiver dynamics
+        double clock_drift_sd_m_s2 = 0.5;      // receiver clock frequency random walk
+        double code_sd_m = 3.0;                // code measurement at 45 dB-Hz
+        double range_rate_sd_m_s = 0.2;        // Doppler measurement at 45 dB-Hz
+        double max_position_error_m = 300.0;   // reset to the PVT fix beyond this
+        double satellite_timeout_s = 2.0;      // satellite states older than this are not used
+    };
+
+    struct Channel_Measurement
+    {
+        uint64_t sample_counter;       // end of the integration period
+        double fs;                     // sampling frequency [samples/s]
+        double carrier_freq_hz;        // nominal carrier frequency
+        double code_chip_rate;         // nominal chip rate [chips/s]
+        double carrier_doppler_hz;     // carrier NCO Doppler during the period
+        double carrier_freq_error_hz;  // frequency discriminator output
+        double code_error_chips;       // code discriminator output
+        double cn0_db_hz;
+        uint32_t satellite;            // system and PRN, see satellite_id()
+        bool vector_mode;              // the code NCO follows the engine commands
+    };
+
+    struct Satellite_State
+    {
+        std::array<double, 3> pos;  // ECEF [m]
+        std::array<double, 3> vel;  // ECEF [m/s]
+        double clock_drift;         // [s/s]
+        uint32_t satellite;         // system and PRN, see satellite_id()
+    };
+
+    struct Navigation_Solution
+    {
+        uint64_t sample_counter;    // sample at which the solution is valid
+        double fs;                  // sampling frequency [samples/s]
+        std::array<double, 3> pos;  // ECEF [m]
+        std::array<double, 3> vel;  // ECEF [m/s]
+        double clock_drift_m_s;
+        std::map<int32_t, Satellite_State> satellites;  // by channel
+    };
+
+    /*!
+     * \brief Returns the process-wide engine.
+     */
+    static Vtl_Engine& instance();
+
+    static inline uint32_t satellite_id(char system, uint32_t prn)
+    {
+        return (static_cast<uint32_t>(static_cast<unsigned char>(system)) << 16U) | prn;
+    }
+
+    /*!
+     * \brief Sets the parameters of a new run, and clears the state left by
+     * the previous one (see reset()). Called by the PVT block when the
+     * flowgraph is built.
+     */
+    void configure(const Parameters& parameters);
+
+    /*!
+     * \brief Clears the navigation state and all the channel slots. Commands
+     * of the previous run are no longer returned by read_command().
+     */
+    void reset();
+
+    /*!
+     * \brief Creates the slots of a channel. Called once per channel, before
+     * the flowgraph starts.
+     */
+    void register_channel(int32_t channel);
+
+    /*!
+     * \brief Stops using the measurements of a channel, and stops
+     * commanding it, until it posts a new measurement.
+     */
+    void release_channel(int32_t channel);
+
+    /*!
+     * \brief Lock-free: publishes the latest measurement of a channel.
+     */
+    void post_measurement(int32_t channel, const Channel_Measurement& measurement);
+
+    /*!
+     * \brief Lock-free: copies the latest command for a channel. Returns its
+     * version, which grows with each new command, or zero if there is none.
+     */
+    uint32_t read_command(int32_t channel, TrackingCmd& command) const;
+
+    /*!
+     * \brief Runs a filter step if the update period has elapsed at
+     * sample_counter. Returns without waiting if another channel is already
+     * running it. Returns true if a step was run.
+     */
+    bool update(uint64_t sample_counter);
+
+    /*!
+     * \brief Updates the satellite states and, on the first call or if the
+     * engine diverged from it, (re)initializes the receiver state.
+     */
+    void set_navigation_solution(const Navigation_Solution& solution);
+
+    bool has_solution() const;
+    arma::vec state() const;  // position, velocity, clock bias and drift
+    uint64_t steps() const;
+
+private:
+    struct Channel
+    {
+        Vtl_Slot<Channel_Measurement> measurement;
+        Vtl_Slot<TrackingCmd> command;
+        std::atomic<bool> released{false};
+        std::atomic<bool> commanded{false};  // the command slot holds a command of this run
+        // only accessed with the engine mutex held
+        Satellite_State satellite{};
+        uint64_t satellite_sample_counter{0};
+        uint32_t last_measurement{0};
+        bool has_satellite{false};
+    };
+
+    Vtl_Engine() = default;
+    Channel* channel_slot(int32_t channel) const;
+    void predict(double dt_s);
+
+    Parameters d_parameters;
+    std::array<std::atomic<Channel*>, MAX_CHANNELS> d_channel_ptrs{};
+    std::vector<std::unique_ptr<Channel>> d_channels;
+    arma::vec d_x;
+    arma::mat d_P;
+    double d_fs{0.0};
+    uint64_t d_state_sample_counter{0};
+    std::atomic<uint64_t> d_steps{0};
+    std::atomic<bool> d_has_solution{false};
+    mutable std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_VTL_ENGINE_H
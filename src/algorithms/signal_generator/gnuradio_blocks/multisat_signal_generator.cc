@@ -0,0 +1,65 @@
+/*!
+ * \file multisat_signal_generator.cc
+ * \brief GNU Radio source block that synthesizes the signals of many GNSS
+ * satellites at once, for load testing.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "multisat_signal_generator.h"
+#include <gnuradio/io_signature.h>
+#include <algorithm>  // for std::max
+#include <complex>
+
+
+Multisat_Signal_Generator::sptr Multisat_Signal_Generator::make(const std::vector<Synthesized_Satellite> &satellites,
+    double fs_hz,
+    double if_hz,
+    bool data_flag,
+    bool noise_flag,
+    uint32_t threads,
+    uint32_t seed)
+{
+    return gnuradio::get_initial_sptr(new Multisat_Signal_Generator(satellites,
+        fs_hz,
+        if_hz,
+        data_flag,
+        noise_flag,
+        threads,
+        seed));
+}
+
+
+Multisat_Signal_Generator::Multisat_Signal_Generator(const std::vector<Synthesized_Satellite> &satellites,
+    double fs_hz,
+    double if_hz,
+    bool data_flag,
+    bool noise_flag,
+    uint32_t threads,
+    uint32_t seed)
+    : gr::sync_block("multisat_signal_generator",
+          gr::io_signature::make(0, 0, 0),
+          gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      d_synthesizer(satellites, fs_hz, if_hz, data_flag, noise_flag, threads, seed)
+{
+    // Large calls amortize the handoff to the worker threads
+    set_output_multiple(std::max(1, static_cast<int>(fs_hz / 1000.0)));
+}
+
+
+int Multisat_Signal_Generator::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
+    d_synthesizer.generate(out, static_cast<uint32_t>(noutput_items));
+    return noutput_items;
+}
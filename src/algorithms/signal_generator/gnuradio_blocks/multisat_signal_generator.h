@@ -0,0 +1,71 @@
+/*!
+ * \file multisat_signal_generator.h
+ * \brief GNU Radio source block that synthesizes the signals of many GNSS
+ * satellites at once, for load testing.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MULTISAT_SIGNAL_GENERATOR_H
+#define GNSS_SDR_MULTISAT_SIGNAL_GENERATOR_H
+
+#include "gnss_block_interface.h"
+#include "multisat_signal_synthesizer.h"
+#include <gnuradio/sync_block.h>
+#include <cstdint>
+#include <vector>
+
+
+/*!
+ * \brief Source of gr_complex samples with the signals of a set of
+ * satellites, as produced by Multisat_Signal_Synthesizer.
+ *
+ * The samples are generated as fast as the flowgraph consumes them, so
+ * that a receiver can be run faster than real time. The output is
+ * deterministic for a given seed and set of satellites, whatever the
+ * number of threads.
+ */
+class Multisat_Signal_Generator : virtual public gr::sync_block
+{
+public:
+    using sptr = gnss_shared_ptr<Multisat_Signal_Generator>;
+    static sptr make(const std::vector<Synthesized_Satellite> &satellites,
+        double fs_hz,
+        double if_hz,
+        bool data_flag,
+        bool noise_flag,
+        uint32_t threads,
+        uint32_t seed);
+
+    ~Multisat_Signal_Generator() = default;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+    inline const Multisat_Signal_Synthesizer &synthesizer() const
+    {
+        return d_synthesizer;
+    }
+
+private:
+    Multisat_Signal_Generator(const std::vector<Synthesized_Satellite> &satellites,
+        double fs_hz,
+        double if_hz,
+        bool data_flag,
+        bool noise_flag,
+        uint32_t threads,
+        uint32_t seed);
+
+    Multisat_Signal_Synthesizer d_synthesizer;
+};
+
+#endif  // GNSS_SDR_MULTISAT_SIGNAL_GENERATOR_H
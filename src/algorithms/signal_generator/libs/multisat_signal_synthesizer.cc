@@ -0,0 +1,496 @@
+/*!
+ * \file multisat_signal_synthesizer.cc
+ * \brief Synthesizes the baseband signal of many GNSS satellites at once,
+ * with orbit-driven code and carrier dynamics, spread among worker threads.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "multisat_signal_synthesizer.h"
+#include "Beidou_B1I.h"
+#include "GLONASS_L1_L2_CA.h"
+#include "GPS_L1_CA.h"
+#include "Galileo_E1.h"
+#include "MATH_CONSTANTS.h"
+#include "beidou_b1i_signal_replica.h"
+#include "galileo_e1_signal_replica.h"
+#include "glonass_l1_signal_replica.h"
+#include "gps_sdr_signal_replica.h"
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+
+namespace
+{
+constexpr double EARTH_RADIUS_M = 6378137.0;
+constexpr uint32_t NOISE_TABLE_SAMPLES = 1U << 20U;
+constexpr uint32_t CARRIER_RUN_SAMPLES = 128;
+
+
+uint64_t splitmix64(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27U)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31U);
+}
+
+
+int64_t floor_div(int64_t a, int64_t b)
+{
+    const int64_t q = a / b;
+    return (a % b != 0 and ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+}  // namespace
+
+
+Multisat_Signal_Synthesizer::Multisat_Signal_Synthesizer(const std::vector<Synthesized_Satellite>& satellites,
+    double fs_hz,
+    double if_hz,
+    bool data_flag,
+    bool noise_flag,
+    uint32_t threads,
+    uint32_t seed)
+    : d_noise_offset_gen(seed),
+      d_fs_hz(fs_hz),
+      d_block_samples(std::max(1U, static_cast<uint32_t>(std::round(fs_hz / 1000.0)))),
+      d_data_flag(data_flag),
+      d_noise_flag(noise_flag)
+{
+    if (fs_hz <= 0.0)
+        {
+            throw std::invalid_argument("Multisat_Signal_Synthesizer: the sampling rate must be positive");
+        }
+    d_sats.resize(satellites.size());
+    for (size_t n = 0; n < satellites.size(); n++)
+        {
+            init_satellite(satellites[n], d_sats[n]);
+            d_sats[n].offset_hz += if_hz;
+            d_sats[n].bit_seed = splitmix64((static_cast<uint64_t>(seed) << 32U) ^ (static_cast<uint64_t>(satellites[n].system) << 8U) ^ satellites[n].PRN);
+        }
+
+    if (d_noise_flag)
+        {
+            // Unit power, split between I and Q
+            std::mt19937 gen(seed);
+            std::normal_distribution<float> normal_dist(0.0F, static_cast<float>(std::sqrt(0.5)));
+            d_noise.resize(NOISE_TABLE_SAMPLES);
+            for (auto& sample : d_noise)
+                {
+                    sample = std::complex<float>(normal_dist(gen), normal_dist(gen));
+                }
+        }
+
+    if (threads == 0)
+        {
+            threads = std::max(1U, std::thread::hardware_concurrency());
+        }
+    threads = std::max(1U, std::min(threads, static_cast<uint32_t>(std::max<size_t>(1, d_sats.size()))));
+    d_buffers.resize(threads);
+    for (auto& buffers : d_buffers)
+        {
+            buffers.carrier.resize(d_block_samples);
+            buffers.product.resize(d_block_samples);
+            buffers.code.resize(d_block_samples);
+        }
+    for (uint32_t worker = 1; worker < threads; worker++)
+        {
+            d_workers.emplace_back(&Multisat_Signal_Synthesizer::worker_loop, this, worker);
+        }
+}
+
+
+Multisat_Signal_Synthesizer::~Multisat_Signal_Synthesizer()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cv.notify_all();
+    for (auto& worker : d_workers)
+        {
+            worker.join();
+        }
+}
+
+
+void Multisat_Signal_Synthesizer::init_satellite(const Synthesized_Satellite& config, Satellite& sat) const
+{
+    const float amplitude = static_cast<float>(std::sqrt(std::pow(10.0, config.CN0_dB / 10.0) / d_fs_hz));
+    std::vector<float> data_code;
+    std::vector<float> pilot_code;
+    float data_weight = 1.0F;
+    float pilot_weight = 0.0F;
+    double gm = GPS_GM;
+    double inclination_deg = 55.0;
+
+    sat.system = config.system;
+    switch (config.system)
+        {
+        case 'G':
+            sat.radius_m = 26559.7e3;
+            sat.carrier_hz = GPS_L1_FREQ_HZ;
+            sat.replica_rate = GPS_L1_CA_CODE_RATE_CPS;
+            sat.chips_per_code = static_cast<uint32_t>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+            sat.replica_length = sat.chips_per_code;
+            sat.codes_per_bit = GPS_L1_CA_BIT_PERIOD_MS;
+            data_code.resize(sat.replica_length);
+            gps_l1_ca_code_gen_float(data_code, static_cast<int32_t>(config.PRN), 0);
+            break;
+        case 'E':
+            {
+                const std::array<char, 3> signal_1b = {{'1', 'B', '\0'}};
+                const std::array<char, 3> signal_1c = {{'1', 'C', '\0'}};
+                sat.radius_m = 29600.318e3;
+                inclination_deg = 56.0;
+                gm = GALILEO_GM;
+                sat.carrier_hz = GALILEO_E1_FREQ_HZ;
+                // Two samples per chip, to keep the BOC(1,1) subcarrier
+                sat.replica_rate = 2.0 * GALILEO_E1_CODE_CHIP_RATE_CPS;
+                sat.chips_per_code = static_cast<uint32_t>(GALILEO_E1_B_CODE_LENGTH_CHIPS);
+                sat.replica_length = 2 * sat.chips_per_code;
+                sat.codes_per_bit = 1;
+                sat.secondary_code = GALILEO_E1_C_SECONDARY_CODE;
+                data_code.resize(sat.replica_length);
+                pilot_code.resize(sat.replica_length);
+                galileo_e1_code_gen_sinboc11_float(data_code, signal_1b, config.PRN);
+                galileo_e1_code_gen_sinboc11_float(pilot_code, signal_1c, config.PRN);
+                data_weight = static_cast<float>(1.0 / std::sqrt(2.0));
+                pilot_weight = -data_weight;
+            }
+            break;
+        case 'C':
+            sat.radius_m = 27906.1e3;
+            gm = BEIDOU_GM;
+            sat.carrier_hz = BEIDOU_B1I_FREQ_HZ;
+            sat.replica_rate = BEIDOU_B1I_CODE_RATE_CPS;
+            sat.chips_per_code = static_cast<uint32_t>(BEIDOU_B1I_CODE_LENGTH_CHIPS);
+            sat.replica_length = sat.chips_per_code;
+            if (config.PRN > 5)
+                {
+                    // D1 message, with the NH code on the data
+                    sat.codes_per_bit = static_cast<uint32_t>(BEIDOU_B1I_SECONDARY_CODE_LENGTH);
+                    sat.secondary_code = BEIDOU_B1I_SECONDARY_CODE_STR;
+                    sat.secondary_on_data = true;
+                }
+            else
+                {
+                    // D2 message (GEO satellites)
+                    sat.codes_per_bit = 2;
+                }
+            data_code.resize(sat.replica_length);
+            beidou_b1i_code_gen_float(data_code, static_cast<int32_t>(config.PRN), 0);
+            break;
+        case 'R':
+            {
+                sat.radius_m = 25508.0e3;
+                inclination_deg = 64.8;
+                gm = GLONASS_GM;
+                const auto channel = GLONASS_PRN.find(config.PRN);
+                const int32_t k = (channel != GLONASS_PRN.cend()) ? channel->second : 0;
+                sat.carrier_hz = GLONASS_L1_CA_FREQ_HZ + k * GLONASS_L1_CA_DFREQ_HZ;
+                sat.offset_hz = k * GLONASS_L1_CA_DFREQ_HZ;
+                sat.replica_rate = GLONASS_L1_CA_CODE_RATE_CPS;
+                sat.chips_per_code = static_cast<uint32_t>(GLONASS_L1_CA_CODE_LENGTH_CHIPS);
+                sat.replica_length = sat.chips_per_code;
+                sat.codes_per_bit = static_cast<uint32_t>(1000 / GLONASS_GNAV_TELEMETRY_RATE_BITS_SECOND);
+                std::vector<std::complex<float>> code(sat.replica_length);
+                glonass_l1_ca_code_gen_complex(code, 0);
+                data_code.resize(sat.replica_length);
+                std::transform(code.cbegin(), code.cend(), data_code.begin(), [](const std::complex<float>& c) { return c.real(); });
+            }
+            break;
+        default:
+            throw std::invalid_argument(std::string("Multisat_Signal_Synthesizer: unsupported system ") + config.system);
+        }
+    if (pilot_code.empty())
+        {
+            pilot_code.assign(sat.replica_length, 0.0F);
+        }
+
+    for (uint32_t variant = 0; variant < 4; variant++)
+        {
+            const float data_sign = (variant & 1U) ? -1.0F : 1.0F;
+            const float pilot_sign = (variant & 2U) ? -1.0F : 1.0F;
+            sat.variants[variant].resize(sat.replica_length);
+            for (uint32_t k = 0; k < sat.replica_length; k++)
+                {
+                    sat.variants[variant][k] = amplitude * (data_sign * data_weight * data_code[k] + pilot_sign * pilot_weight * pilot_code[k]);
+                }
+        }
+
+    // Receiver on the Equator, at longitude 0. East, North and Up are the
+    // ECEF Y, Z and X axes.
+    sat.rx_ecef = {EARTH_RADIUS_M, 0.0, 0.0};
+    const double el = config.elevation_deg * GNSS_PI / 180.0;
+    const double az = config.azimuth_deg * GNSS_PI / 180.0;
+    const std::array<double, 3> los = {std::sin(el), std::cos(el) * std::sin(az), std::cos(el) * std::cos(az)};
+    // Distance along the line of sight to the orbit sphere
+    const double r_dot_los = EARTH_RADIUS_M * los[0];
+    const double rho = -r_dot_los + std::sqrt(r_dot_los * r_dot_los - (EARTH_RADIUS_M * EARTH_RADIUS_M - sat.radius_m * sat.radius_m));
+    std::array<double, 3> p{};
+    for (int i = 0; i < 3; i++)
+        {
+            p[i] = (sat.rx_ecef[i] + rho * los[i]) / sat.radius_m;
+        }
+
+    // Circular orbit through p (ECI and ECEF are aligned at t = 0). Odd PRNs
+    // are ascending and even PRNs descending, for a variety of Dopplers.
+    sat.sin_i = std::sin(inclination_deg * GNSS_PI / 180.0);
+    sat.cos_i = std::cos(inclination_deg * GNSS_PI / 180.0);
+    const double sin_u0 = std::max(-1.0, std::min(1.0, p[2] / sat.sin_i));
+    sat.u0 = (config.PRN % 2 == 1) ? std::asin(sin_u0) : GNSS_PI - std::asin(sin_u0);
+    sat.raan = std::atan2(p[1], p[0]) - std::atan2(std::sin(sat.u0) * sat.cos_i, std::cos(sat.u0));
+    sat.mean_motion = std::sqrt(gm / (sat.radius_m * sat.radius_m * sat.radius_m));
+}
+
+
+std::array<double, 3> Multisat_Signal_Synthesizer::satellite_ecef(const Satellite& sat, double t) const
+{
+    const double u = sat.u0 + sat.mean_motion * t;
+    const double xp = std::cos(u);
+    const double yp = std::sin(u) * sat.cos_i;
+    const double cos_raan = std::cos(sat.raan);
+    const double sin_raan = std::sin(sat.raan);
+    const double x = sat.radius_m * (xp * cos_raan - yp * sin_raan);
+    const double y = sat.radius_m * (xp * sin_raan + yp * cos_raan);
+    const double z = sat.radius_m * std::sin(u) * sat.sin_i;
+    const double theta = GNSS_OMEGA_EARTH_DOT * t;
+    return {x * std::cos(theta) + y * std::sin(theta), -x * std::sin(theta) + y * std::cos(theta), z};
+}
+
+
+double Multisat_Signal_Synthesizer::range_m(const Satellite& sat, double t) const
+{
+    const std::array<double, 3> pos = satellite_ecef(sat, t);
+    const double dx = pos[0] - sat.rx_ecef[0];
+    const double dy = pos[1] - sat.rx_ecef[1];
+    const double dz = pos[2] - sat.rx_ecef[2];
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+
+double Multisat_Signal_Synthesizer::doppler_hz(uint32_t sat, double t) const
+{
+    const Satellite& s = d_sats.at(sat);
+    const double h = 1e-3;
+    const double range_rate = (range_m(s, t + h) - range_m(s, t - h)) / (2.0 * h);
+    return s.offset_hz - s.carrier_hz * range_rate / SPEED_OF_LIGHT_M_S;
+}
+
+
+double Multisat_Signal_Synthesizer::code_phase_chips(uint32_t sat, double t) const
+{
+    const Satellite& s = d_sats.at(sat);
+    const double phase = s.replica_rate * (t - range_m(s, t) / SPEED_OF_LIGHT_M_S);
+    const double length = static_cast<double>(s.replica_length);
+    const double to_next_epoch = std::ceil(phase / length) * length - phase;
+    return to_next_epoch * static_cast<double>(s.chips_per_code) / length;
+}
+
+
+double Multisat_Signal_Synthesizer::elevation_deg(uint32_t sat, double t) const
+{
+    const Satellite& s = d_sats.at(sat);
+    const std::array<double, 3> pos = satellite_ecef(s, t);
+    const double up = pos[0] - s.rx_ecef[0];
+    return std::asin(up / range_m(s, t)) * 180.0 / GNSS_PI;
+}
+
+
+int32_t Multisat_Signal_Synthesizer::data_bit(const Satellite& sat, int64_t epoch) const
+{
+    if (not d_data_flag)
+        {
+            return 1;
+        }
+    const int64_t bit = floor_div(epoch, sat.codes_per_bit);
+    return (splitmix64(sat.bit_seed + static_cast<uint64_t>(bit)) & 1U) ? -1 : 1;
+}
+
+
+void Multisat_Signal_Synthesizer::synthesize_block(const Satellite& sat,
+    uint64_t first_sample,
+    uint32_t num_samples,
+    Worker_Buffers& buffers,
+    std::complex<float>* acc) const
+{
+    const double t0 = static_cast<double>(first_sample) / d_fs_hz;
+    const double t1 = static_cast<double>(first_sample + num_samples) / d_fs_hz;
+    const double tau0 = range_m(sat, t0) / SPEED_OF_LIGHT_M_S;
+    const double tau1 = range_m(sat, t1) / SPEED_OF_LIGHT_M_S;
+
+    // Code phase, in replica samples, of the signal transmitted at t - tau
+    const double code_phase0 = sat.replica_rate * (t0 - tau0);
+    const double code_step = (sat.replica_rate * (t1 - tau1) - code_phase0) / num_samples;
+    const double length = static_cast<double>(sat.replica_length);
+
+    // Split the block at the code epochs, where the data and secondary code
+    // signs can change
+    uint32_t first = 0;
+    float shift = 0.0;
+    while (first < num_samples)
+        {
+            const double phase = code_phase0 + code_step * first;
+            const double epoch_start = std::floor(phase / length);
+            const auto epoch = static_cast<int64_t>(epoch_start);
+            const double samples_to_boundary = ((epoch_start + 1.0) * length - code_phase0) / code_step;
+            uint32_t last = num_samples;
+            if (samples_to_boundary < static_cast<double>(num_samples))
+                {
+                    last = std::max(first + 1, static_cast<uint32_t>(std::ceil(samples_to_boundary)));
+                }
+
+            int32_t data_sign = data_bit(sat, epoch);
+            int32_t pilot_sign = 1;
+            if (not sat.secondary_code.empty())
+                {
+                    const auto secondary_length = static_cast<int64_t>(sat.secondary_code.size());
+                    const int64_t chip = epoch - floor_div(epoch, secondary_length) * secondary_length;
+                    const int32_t secondary = (sat.secondary_code[chip] == '0') ? 1 : -1;
+                    if (sat.secondary_on_data)
+                        {
+                            data_sign *= secondary;
+                        }
+                    else
+                        {
+                            pilot_sign = secondary;
+                        }
+                }
+            const Replica& replica = sat.variants[(data_sign < 0 ? 1U : 0U) | (pilot_sign < 0 ? 2U : 0U)];
+
+            // The resampler takes the index floor(step * n - rem)
+            float* result = buffers.code.data() + first;
+            const auto rem = static_cast<float>(-(phase - epoch_start * length));
+            volk_gnsssdr_32f_xn_resampler_32f_xn_u(&result, replica.data(), rem, static_cast<float>(code_step), &shift, sat.replica_length, 1, last - first);
+            first = last;
+        }
+
+    // Carrier, from the phase at both ends of the block. The kernel
+    // accumulates the phase in single precision, so it is restarted every
+    // CARRIER_RUN_SAMPLES from the phase computed in double precision.
+    const double carrier_phase0 = TWO_PI * (sat.offset_hz * t0 - sat.carrier_hz * tau0);
+    const double carrier_phase1 = TWO_PI * (sat.offset_hz * t1 - sat.carrier_hz * tau1);
+    double phase_step = std::fmod((carrier_phase1 - carrier_phase0) / num_samples, TWO_PI);
+    if (phase_step > GNSS_PI)
+        {
+            phase_step -= TWO_PI;
+        }
+    else if (phase_step < -GNSS_PI)
+        {
+            phase_step += TWO_PI;
+        }
+    const double start_phase = std::fmod(carrier_phase0, TWO_PI);
+    for (uint32_t run = 0; run < num_samples; run += CARRIER_RUN_SAMPLES)
+        {
+            auto phase = static_cast<float>(std::fmod(start_phase + phase_step * run, TWO_PI));
+            volk_gnsssdr_s32f_sincos_32fc(buffers.carrier.data() + run, static_cast<float>(phase_step), &phase, std::min(CARRIER_RUN_SAMPLES, num_samples - run));
+        }
+    volk_32fc_32f_multiply_32fc(buffers.product.data(), buffers.carrier.data(), buffers.code.data(), num_samples);
+    volk_32f_x2_add_32f(reinterpret_cast<float*>(acc), reinterpret_cast<const float*>(acc), reinterpret_cast<const float*>(buffers.product.data()), 2 * num_samples);
+}
+
+
+void Multisat_Signal_Synthesizer::synthesize(uint32_t worker)
+{
+    Worker_Buffers& buffers = d_buffers[worker];
+    std::complex<float>* acc = buffers.accumulator.data();
+    std::fill(acc, acc + d_job_samples, std::complex<float>(0.0, 0.0));
+    const auto threads = static_cast<uint32_t>(d_buffers.size());
+    for (size_t sat = worker; sat < d_sats.size(); sat += threads)
+        {
+            for (uint32_t offset = 0; offset < d_job_samples; offset += d_block_samples)
+                {
+                    const uint32_t samples = std::min(d_block_samples, d_job_samples - offset);
+                    synthesize_block(d_sats[sat], d_sample_counter + offset, samples, buffers, acc + offset);
+                }
+        }
+}
+
+
+void Multisat_Signal_Synthesizer::worker_loop(uint32_t worker)
+{
+    uint64_t job = 0;
+    while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cv.wait(lock, [&] { return d_stop or d_job != job; });
+                if (d_stop)
+                    {
+                        return;
+                    }
+                job = d_job;
+            }
+            synthesize(worker);
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_pending--;
+                if (d_pending == 0)
+                    {
+                        d_done_cv.notify_one();
+                    }
+            }
+        }
+}
+
+
+void Multisat_Signal_Synthesizer::generate(std::complex<float>* out, uint32_t num_samples)
+{
+    if (num_samples == 0)
+        {
+            return;
+        }
+    // Workers are idle here, so their buffers can be resized
+    for (auto& buffers : d_buffers)
+        {
+            if (buffers.accumulator.size() < num_samples)
+                {
+                    buffers.accumulator.resize(num_samples);
+                }
+        }
+
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_job_samples = num_samples;
+        d_pending = static_cast<uint32_t>(d_workers.size());
+        d_job++;
+    }
+    d_cv.notify_all();
+    synthesize(0);
+    {
+        std::unique_lock<std::mutex> lock(d_mutex);
+        d_done_cv.wait(lock, [&] { return d_pending == 0; });
+    }
+
+    std::copy(d_buffers[0].accumulator.cbegin(), d_buffers[0].accumulator.cbegin() + num_samples, out);
+    for (size_t worker = 1; worker < d_buffers.size(); worker++)
+        {
+            volk_32f_x2_add_32f(reinterpret_cast<float*>(out), reinterpret_cast<const float*>(out), reinterpret_cast<const float*>(d_buffers[worker].accumulator.data()), 2 * num_samples);
+        }
+
+    if (d_noise_flag)
+        {
+            uint32_t offset = d_noise_offset_gen() % NOISE_TABLE_SAMPLES;
+            uint32_t done = 0;
+            while (done < num_samples)
+                {
+                    const uint32_t samples = std::min(num_samples - done, NOISE_TABLE_SAMPLES - offset);
+                    volk_32f_x2_add_32f(reinterpret_cast<float*>(out + done), reinterpret_cast<const float*>(out + done), reinterpret_cast<const float*>(d_noise.data() + offset), 2 * samples);
+                    done += samples;
+                    offset = 0;
+                }
+        }
+    d_sample_counter += num_samples;
+}
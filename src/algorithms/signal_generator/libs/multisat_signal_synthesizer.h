@@ -0,0 +1,188 @@
+/*!
+ * \file multisat_signal_synthesizer.h
+ * \brief Synthesizes the baseband signal of many GNSS satellites at once,
+ * with orbit-driven code and carrier dynamics, spread among worker threads.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MULTISAT_SIGNAL_SYNTHESIZER_H
+#define GNSS_SDR_MULTISAT_SIGNAL_SYNTHESIZER_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <array>
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/*!
+ * \brief Satellite to be synthesized. The system is 'G' (GPS L1 C/A), 'E'
+ * (Galileo E1 B/C), 'C' (BeiDou B1I) or 'R' (GLONASS L1 C/A). The elevation
+ * and azimuth set the position of the satellite, as seen from the receiver,
+ * at the first sample.
+ */
+struct Synthesized_Satellite
+{
+    char system{'G'};
+    uint32_t PRN{1};
+    float CN0_dB{45.0};
+    double elevation_deg{45.0};
+    double azimuth_deg{0.0};
+};
+
+
+/*!
+ * \brief Generates the sum of the signals of a set of satellites plus
+ * white Gaussian noise of unit power.
+ *
+ * Each satellite follows a circular orbit of its constellation, and the
+ * receiver stays at a fixed point of the Equator. The code and carrier
+ * phases of every block of samples (at most 1 ms) are computed from the
+ * geometric range at its first and last samples, so the code Doppler, the
+ * carrier Doppler and its rate follow the orbit. Random navigation data
+ * bits and the secondary codes are applied at code epoch boundaries.
+ *
+ * The code of each epoch is taken from one of four precomputed replicas
+ * (one per combination of data and pilot signs) already scaled to the
+ * C/N0 of the satellite, and resampled with the VOLK_GNSSSDR resampler.
+ * The carrier is generated with volk_gnsssdr_s32f_sincos_32fc and applied
+ * and accumulated with VOLK. Satellites are dealt among a pool of worker
+ * threads, each one adding its satellites into its own buffer, and the
+ * buffers and the noise are summed at the end of each call. Noise samples
+ * are read at a random offset of a precomputed table.
+ *
+ * Every system is synthesized around its own carrier frequency (plus
+ * if_hz), GLONASS satellites being shifted by their FDMA channel offset.
+ */
+class Multisat_Signal_Synthesizer
+{
+public:
+    /*!
+     * \brief If threads is zero, one thread per hardware core is used.
+     */
+    Multisat_Signal_Synthesizer(const std::vector<Synthesized_Satellite>& satellites,
+        double fs_hz,
+        double if_hz,
+        bool data_flag,
+        bool noise_flag,
+        uint32_t threads,
+        uint32_t seed);
+
+    ~Multisat_Signal_Synthesizer();
+
+    Multisat_Signal_Synthesizer(const Multisat_Signal_Synthesizer&) = delete;
+    Multisat_Signal_Synthesizer& operator=(const Multisat_Signal_Synthesizer&) = delete;
+
+    /*!
+     * \brief Writes the next num_samples samples.
+     */
+    void generate(std::complex<float>* out, uint32_t num_samples);
+
+    /*!
+     * \brief Carrier Doppler [Hz] of a satellite at time t [s] since the
+     * first sample.
+     */
+    double doppler_hz(uint32_t sat, double t) const;
+
+    /*!
+     * \brief Code delay [chips] of a satellite at time t [s] since the first
+     * sample, that is, the chips until the next start of its primary code
+     * (the code phase reported by the acquisition).
+     */
+    double code_phase_chips(uint32_t sat, double t) const;
+
+    /*!
+     * \brief Elevation [deg] of a satellite at time t [s].
+     */
+    double elevation_deg(uint32_t sat, double t) const;
+
+    inline uint32_t satellites() const
+    {
+        return static_cast<uint32_t>(d_sats.size());
+    }
+
+    inline uint32_t threads() const
+    {
+        return static_cast<uint32_t>(d_workers.size()) + 1;
+    }
+
+    inline uint64_t sample_counter() const
+    {
+        return d_sample_counter;
+    }
+
+private:
+    using Replica = volk_gnsssdr::vector<float>;
+
+    struct Satellite
+    {
+        std::array<Replica, 4> variants;  // by data sign (bit 0) and pilot sign (bit 1)
+        std::string secondary_code;       // applied to the data component if secondary_on_data
+        std::array<double, 3> rx_ecef{};
+        double radius_m{};
+        double mean_motion{};  // [rad/s]
+        double cos_i{};
+        double sin_i{};
+        double raan{};
+        double u0{};
+        double carrier_hz{};
+        double offset_hz{};         // IF and FDMA offset
+        double replica_rate{};      // replica samples per second
+        uint32_t replica_length{};  // replica samples per code period
+        uint32_t codes_per_bit{};
+        uint32_t chips_per_code{};
+        uint64_t bit_seed{};
+        bool secondary_on_data{};
+        char system{};
+    };
+
+    struct Worker_Buffers
+    {
+        volk_gnsssdr::vector<std::complex<float>> accumulator;
+        volk_gnsssdr::vector<std::complex<float>> carrier;
+        volk_gnsssdr::vector<std::complex<float>> product;
+        volk_gnsssdr::vector<float> code;
+    };
+
+    void init_satellite(const Synthesized_Satellite& config, Satellite& sat) const;
+    std::array<double, 3> satellite_ecef(const Satellite& sat, double t) const;
+    double range_m(const Satellite& sat, double t) const;
+    int32_t data_bit(const Satellite& sat, int64_t epoch) const;
+    void synthesize(uint32_t worker);
+    void synthesize_block(const Satellite& sat, uint64_t first_sample, uint32_t num_samples, Worker_Buffers& buffers, std::complex<float>* acc) const;
+    void worker_loop(uint32_t worker);
+
+    std::vector<Satellite> d_sats;
+    std::vector<Worker_Buffers> d_buffers;
+    std::vector<std::thread> d_workers;
+    volk_gnsssdr::vector<std::complex<float>> d_noise;
+    std::mt19937 d_noise_offset_gen;
+    std::mutex d_mutex;
+    std::condition_variable d_cv;
+    std::condition_variable d_done_cv;
+    double d_fs_hz;
+    uint64_t d_sample_counter{};
+    uint64_t d_job{};  // incremented for each call to generate()
+    uint32_t d_job_samples{};
+    uint32_t d_pending{};
+    uint32_t d_block_samples;  // samples with constant Doppler
+    bool d_data_flag;
+    bool d_noise_flag;
+    bool d_stop{};
+};
+
+#endif  // GNSS_SDR_MULTISAT_SIGNAL_SYNTHESIZER_H
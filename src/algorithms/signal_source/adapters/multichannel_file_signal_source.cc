@@ -52,6 +52,9 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
     item_type_ = configuration->property(role + ".item_type", default_item_type);
     repeat_ = configuration->property(role + ".repeat", false);
     enable_throttle_control_ = configuration->property(role + ".enable_throttle_control", false);
+    coalesced_reads_ = configuration->property(role + ".coalesced_reads", false);
+    const auto prefetch_chunk_bytes = static_cast<size_t>(configuration->property(role + ".prefetch_chunk_bytes", 8 * 1024 * 1024));
+    const int prefetch_chunks = configuration->property(role + ".prefetch_chunks", 4);
 
     const double seconds_to_skip = configuration->property(role + ".seconds_to_skip", default_seconds_to_skip);
     size_t header_size = configuration->property(role + ".header_size", 0);
@@ -91,32 +94,42 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
                          << " unrecognized item type. Using gr_complex.";
             item_size_ = sizeof(gr_complex);
         }
-    try
+    if (seconds_to_skip > 0)
         {
-            for (int32_t n = 0; n < n_channels_; n++)
-                {
-                    file_source_vec_.push_back(gr::blocks::file_source::make(item_size_, filename_vec_.at(n).c_str(), repeat_));
+            samples_to_skip = static_cast<int64_t>(seconds_to_skip * sampling_frequency_);
 
-                    if (seconds_to_skip > 0)
-                        {
-                            samples_to_skip = static_cast<int64_t>(seconds_to_skip * sampling_frequency_);
+            if (is_complex)
+                {
+                    samples_to_skip *= 2;
+                }
+        }
+    if (header_size > 0)
+        {
+            samples_to_skip += header_size;
+        }
 
-                            if (is_complex)
-                                {
-                                    samples_to_skip *= 2;
-                                }
-                        }
-                    if (header_size > 0)
+    try
+        {
+            if (coalesced_reads_)
+                {
+                    // All the files are read from a single I/O thread
+                    LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input files";
+                    file_reader_ = Multichannel_File_Reader::make(item_size_, filename_vec_, samples_to_skip, repeat_, prefetch_chunk_bytes, prefetch_chunks);
+                    DLOG(INFO) << "multichannel_file_reader(" << file_reader_->unique_id() << ")";
+                }
+            else
+                {
+                    for (int32_t n = 0; n < n_channels_; n++)
                         {
-                            samples_to_skip += header_size;
-                        }
+                            file_source_vec_.push_back(gr::blocks::file_source::make(item_size_, filename_vec_.at(n).c_str(), repeat_));
 
-                    if (samples_to_skip > 0)
-                        {
-                            LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file #" << n;
-                            if (not file_source_vec_.back()->seek(samples_to_skip, SEEK_SET))
+                            if (samples_to_skip > 0)
                                 {
-                                    LOG(INFO) << "Error skipping bytes!";
+                                    LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file #" << n;
+                                    if (not file_source_vec_.back()->seek(samples_to_skip, SEEK_SET))
+                                        {
+                                            LOG(INFO) << "Error skipping bytes!";
+                                        }
                                 }
                         }
                 }
@@ -228,7 +241,23 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
 
 void MultichannelFileSignalSource::connect(gr::top_block_sptr top_block)
 {
-    if (enable_throttle_control_ == true)
+    if (coalesced_reads_)
+        {
+            for (int32_t n = 0; n < n_channels_; n++)
+                {
+                    if (enable_throttle_control_ == true)
+                        {
+                            top_block->connect(file_reader_, n, throttle_vec_.at(n), 0);
+                            top_block->connect(throttle_vec_.at(n), 0, valve_, n);
+                        }
+                    else
+                        {
+                            top_block->connect(file_reader_, n, valve_, n);
+                        }
+                    DLOG(INFO) << "connected multichannel_file_reader output #" << n << " to valve_";
+                }
+        }
+    else if (enable_throttle_control_ == true)
         {
             for (int32_t n = 0; n < n_channels_; n++)
                 {
@@ -251,7 +280,23 @@ void MultichannelFileSignalSource::connect(gr::top_block_sptr top_block)
 
 void MultichannelFileSignalSource::disconnect(gr::top_block_sptr top_block)
 {
-    if (enable_throttle_control_ == true)
+    if (coalesced_reads_)
+        {
+            for (int32_t n = 0; n < n_channels_; n++)
+                {
+                    if (enable_throttle_control_ == true)
+                        {
+                            top_block->disconnect(file_reader_, n, throttle_vec_.at(n), 0);
+                            top_block->disconnect(throttle_vec_.at(n), 0, valve_, n);
+                        }
+                    else
+                        {
+                            top_block->disconnect(file_reader_, n, valve_, n);
+                        }
+                    DLOG(INFO) << "disconnected multichannel_file_reader output #" << n << " to valve_";
+                }
+        }
+    else if (enable_throttle_control_ == true)
         {
             for (int32_t n = 0; n < n_channels_; n++)
                 {
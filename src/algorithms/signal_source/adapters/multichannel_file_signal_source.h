@@ -23,6 +23,7 @@
 
 #include "concurrent_queue.h"
 #include "gnss_block_interface.h"
+#include "multichannel_file_reader.h"
 #include "signal_source_base.h"
 #include <gnuradio/blocks/file_sink.h>
 #include <gnuradio/blocks/file_source.h>
@@ -92,6 +93,7 @@ public:
 
 private:
     std::vector<gr::blocks::file_source::sptr> file_source_vec_;
+    Multichannel_File_Reader::sptr file_reader_;
     gnss_shared_ptr<gr::block> valve_;
     gr::blocks::file_sink::sptr sink_;
     std::vector<gr::blocks::throttle::sptr> throttle_vec_;
@@ -106,6 +108,7 @@ private:
     bool repeat_;
     // Throttle control
     bool enable_throttle_control_;
+    bool coalesced_reads_;
 };
 
 
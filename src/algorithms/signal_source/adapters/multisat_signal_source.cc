@@ -0,0 +1,145 @@
+/*!
+ * \file multisat_signal_source.cc
+ * \brief Signal source that synthesizes the signals of many GNSS satellites,
+ * for load and capacity testing of the receiver.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "multisat_signal_source.h"
+#include "configuration_interface.h"
+#include "gnss_sdr_string_literals.h"
+#include "gnss_sdr_valve.h"
+#include <glog/logging.h>
+#include <gnuradio/blocks/file_sink.h>
+#include <gnuradio/blocks/file_source.h>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+
+using namespace std::string_literals;
+
+MultisatSignalSource::MultisatSignalSource(const ConfigurationInterface* configuration,
+    const std::string& role, unsigned int in_streams, unsigned int out_streams,
+    Concurrent_Queue<pmt::pmt_t>* queue)
+    : SignalSourceBase(configuration, role, "Multisat_Signal_Source"s),
+      dump_filename_(configuration->property(role + ".dump_filename"s, "./data/signal_source.dat"s)),
+      samples_(configuration->property(role + ".samples"s, static_cast<uint64_t>(0))),
+      item_size_(sizeof(gr_complex)),
+      dump_(configuration->property(role + ".dump"s, false))
+{
+    const double fs_hz = configuration->property(role + ".sampling_frequency"s, 4e6);
+    const double if_hz = configuration->property(role + ".IF_hz"s, 0.0);
+    const uint32_t num_satellites = configuration->property(role + ".num_satellites"s, static_cast<uint32_t>(8));
+    const std::string systems = configuration->property(role + ".systems"s, "G"s);
+    const bool data_flag = configuration->property(role + ".data_flag"s, true);
+    const bool noise_flag = configuration->property(role + ".noise_flag"s, true);
+    const uint32_t threads = configuration->property(role + ".threads"s, static_cast<uint32_t>(0));
+    const uint32_t seed = configuration->property(role + ".seed"s, static_cast<uint32_t>(1));
+
+    if (systems.empty())
+        {
+            throw std::invalid_argument(role + ".systems must not be empty");
+        }
+    const std::map<char, uint32_t> max_prn = {{'G', 32}, {'E', 36}, {'C', 63}, {'R', 24}};
+    std::map<char, uint32_t> next_prn;
+    for (uint32_t n = 0; n < num_satellites; n++)
+        {
+            const std::string suffix = "_" + std::to_string(n);
+            Synthesized_Satellite sat;
+            sat.system = configuration->property(role + ".system" + suffix, std::string(1, systems[n % systems.size()])).at(0);
+            const auto max = max_prn.find(sat.system);
+            if (max == max_prn.cend())
+                {
+                    throw std::invalid_argument(role + ".system" + suffix + ": unsupported system " + sat.system);
+                }
+            const uint32_t default_prn = 1 + (next_prn[sat.system]++ % max->second);
+            sat.PRN = configuration->property(role + ".PRN" + suffix, default_prn);
+            sat.CN0_dB = configuration->property(role + ".CN0_dB" + suffix, 45.0F);
+            // Spread the satellites over the sky by default
+            sat.elevation_deg = configuration->property(role + ".elevation_deg" + suffix, 10.0 + 75.0 * ((n * 7) % 16) / 15.0);
+            sat.azimuth_deg = configuration->property(role + ".azimuth_deg" + suffix, 360.0 * n / num_satellites);
+            satellites_.push_back(sat);
+        }
+
+    generator_ = Multisat_Signal_Generator::make(satellites_, fs_hz, if_hz, data_flag, noise_flag, threads, seed);
+    DLOG(INFO) << "multisat_signal_generator(" << generator_->unique_id() << ")";
+    std::cout << "Synthesizing " << num_satellites << " satellites with "
+              << generator_->synthesizer().threads() << " threads\n";
+
+    if (samples_ > 0)
+        {
+            valve_ = gnss_sdr_make_valve(item_size_, samples_, queue);
+            DLOG(INFO) << "valve(" << valve_->unique_id() << ")";
+        }
+    if (dump_)
+        {
+            DLOG(INFO) << "Dumping output into file " << dump_filename_;
+            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+        }
+
+    if (in_streams > 0)
+        {
+            LOG(ERROR) << "A signal source does not have an input stream";
+        }
+    if (out_streams > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void MultisatSignalSource::connect(gr::top_block_sptr top_block)
+{
+    if (valve_)
+        {
+            top_block->connect(generator_, 0, valve_, 0);
+            DLOG(INFO) << "connected multisat_signal_generator to valve";
+        }
+    if (dump_)
+        {
+            top_block->connect(get_right_block(), 0, file_sink_, 0);
+            DLOG(INFO) << "connected source to file sink";
+        }
+}
+
+
+void MultisatSignalSource::disconnect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->disconnect(get_right_block(), 0, file_sink_, 0);
+            DLOG(INFO) << "disconnected source from file sink";
+        }
+    if (valve_)
+        {
+            top_block->disconnect(generator_, 0, valve_, 0);
+            DLOG(INFO) << "disconnected multisat_signal_generator from valve";
+        }
+}
+
+
+gr::basic_block_sptr MultisatSignalSource::get_left_block()
+{
+    LOG(WARNING) << "Left block of a signal source should not be retrieved";
+    return gr::blocks::file_source::sptr();
+}
+
+
+gr::basic_block_sptr MultisatSignalSource::get_right_block()
+{
+    if (valve_)
+        {
+            return valve_;
+        }
+    return generator_;
+}
@@ -0,0 +1,110 @@
+/*!
+ * \file multisat_signal_source.h
+ * \brief Signal source that synthesizes the signals of many GNSS satellites,
+ * for load and capacity testing of the receiver.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MULTISAT_SIGNAL_SOURCE_H
+#define GNSS_SDR_MULTISAT_SIGNAL_SOURCE_H
+
+#include "concurrent_queue.h"
+#include "multisat_signal_generator.h"
+#include "signal_source_base.h"
+#include <pmt/pmt.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_adapters
+ * \{ */
+
+// forward declaration to avoid include in header
+class ConfigurationInterface;
+
+//! \brief Class that synthesizes the signals of a set of GPS, Galileo,
+//! BeiDou and GLONASS satellites, faster than real time.
+//!
+//! This class supports the following properties:
+//!
+//!   .sampling_frequency - sampling rate [Hz], default 4000000
+//!
+//!   .IF_hz - intermediate frequency [Hz], default 0
+//!
+//!   .num_satellites - number of satellites, default 8
+//!
+//!   .systems - system letters (G, E, C, R) assigned in turn to the
+//!              satellites, default "G". Overridden by .system_N
+//!
+//!   .PRN_N, .CN0_dB_N, .elevation_deg_N, .azimuth_deg_N - parameters of
+//!              the N-th satellite. By default, PRNs are consecutive within
+//!              each system and satellites are spread over the sky at 45 dB-Hz
+//!
+//!   .data_flag, .noise_flag - modulate navigation data bits and add noise,
+//!              default true
+//!
+//!   .threads - synthesis threads, default 0 (one per core)
+//!
+//!   .seed - seed of the data bits and the noise, default 1
+//!
+//!   .samples - samples to deliver before stopping the receiver,
+//!              default 0 (never stop)
+//!
+//!   .dump, .dump_filename - whether to archive the samples, and where
+//!
+//! The output is always gr_complex.
+class MultisatSignalSource : public SignalSourceBase
+{
+public:
+    MultisatSignalSource(const ConfigurationInterface* configuration, const std::string& role,
+        unsigned int in_streams, unsigned int out_streams,
+        Concurrent_Queue<pmt::pmt_t>* queue);
+
+    ~MultisatSignalSource() = default;
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+    inline size_t item_size() override
+    {
+        return item_size_;
+    }
+
+    inline const std::vector<Synthesized_Satellite>& satellites() const
+    {
+        return satellites_;
+    }
+
+    inline uint64_t samples() const
+    {
+        return samples_;
+    }
+
+private:
+    std::vector<Synthesized_Satellite> satellites_;
+    Multisat_Signal_Generator::sptr generator_;
+    gnss_shared_ptr<gr::block> valve_;
+    gnss_shared_ptr<gr::block> file_sink_;
+    std::string dump_filename_;
+    uint64_t samples_;
+    size_t item_size_;
+    bool dump_;
+};
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MULTISAT_SIGNAL_SOURCE_H
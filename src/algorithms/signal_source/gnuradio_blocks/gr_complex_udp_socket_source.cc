@@ -0,0 +1,567 @@
+/*!
+ * \file gr_complex_udp_socket_source.cc
+ *
+ * \brief Receives UDP packets carrying baseband samples through a plain UDP
+ * socket, using recvmmsg() batches and a lock-free packet ring.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#include "gr_complex_udp_socket_source.h"
+#include <arpa/inet.h>
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <algorithm>  // for std::min
+#include <cerrno>     // for errno
+#include <chrono>     // for std::chrono
+#include <cstring>    // for memcpy, memset, strerror
+#include <iostream>   // for std::cout
+#include <vector>     // for std::vector
+
+// Gaps longer than this number of packets are not zero-filled: the sender
+// has most likely been restarted, so the sequence is just resynchronized
+const uint64_t MAX_ZERO_FILL_PACKETS = 65536;
+
+// Packets older than the expected one by more than this are taken as a
+// sequence restart instead of as late (reordered or duplicated) packets
+const uint64_t MAX_LATE_PACKETS = 1024;
+
+
+Gr_Complex_Udp_Socket_Source::sptr
+Gr_Complex_Udp_Socket_Source::make(const std::string &address,
+    int udp_port,
+    int udp_packet_size,
+    int n_baseband_channels,
+    const std::string &wire_sample_type,
+    size_t item_size,
+    bool IQ_swap_,
+    int sequence_header_bytes,
+    int ring_packets,
+    int batch_packets,
+    int socket_buffer_bytes,
+    int busy_poll_us)
+{
+    return gnuradio::get_initial_sptr(new Gr_Complex_Udp_Socket_Source(address,
+        udp_port,
+        udp_packet_size,
+        n_baseband_channels,
+        wire_sample_type,
+        item_size,
+        IQ_swap_,
+        sequence_header_bytes,
+        ring_packets,
+        batch_packets,
+        socket_buffer_bytes,
+        busy_poll_us));
+}
+
+
+Gr_Complex_Udp_Socket_Source::Gr_Complex_Udp_Socket_Source(const std::string &address,
+    int udp_port,
+    int udp_packet_size,
+    int n_baseband_channels,
+    const std::string &wire_sample_type,
+    size_t item_size,
+    bool IQ_swap_,
+    int sequence_header_bytes,
+    int ring_packets,
+    int batch_packets,
+    int socket_buffer_bytes,
+    int busy_poll_us)
+    : gr::sync_block("gr_complex_udp_socket_source",
+          gr::io_signature::make(0, 0, 0),
+          gr::io_signature::make(1, 4, item_size)),  // 1 to 4 baseband complex channels
+      d_gap_tag_key(pmt::mp("udp_gap")),
+      d_address(address),
+      d_expected_sequence(0),
+      d_pending_zeros(0),
+      d_front_offset(0),
+      d_socket(-1),
+      d_udp_port(udp_port),
+      d_udp_packet_size(udp_packet_size),
+      d_n_baseband_channels(n_baseband_channels),
+      d_sequence_header_bytes(sequence_header_bytes),
+      d_batch_packets(std::max(batch_packets, 1)),
+      d_socket_buffer_bytes(socket_buffer_bytes),
+      d_busy_poll_us(busy_poll_us),
+      d_IQ_swap(IQ_swap_),
+      d_sequence_locked(false),
+      d_front_checked(false)
+{
+    if (wire_sample_type == "cbyte")
+        {
+            d_wire_sample_type = 1;
+            d_bytes_per_sample = d_n_baseband_channels * 2;
+        }
+    else if (wire_sample_type == "c4bits")
+        {
+            d_wire_sample_type = 2;
+            d_bytes_per_sample = d_n_baseband_channels;
+        }
+    else if (wire_sample_type == "cfloat")
+        {
+            d_wire_sample_type = 3;
+            d_bytes_per_sample = d_n_baseband_channels * 8;
+        }
+    else if (wire_sample_type == "ishort")
+        {
+            d_wire_sample_type = 4;
+            d_bytes_per_sample = d_n_baseband_channels * 4;
+        }
+    else
+        {
+            std::cout << "Unknown wire sample type\n";
+            exit(0);
+        }
+
+    if (d_sequence_header_bytes != 0 and d_sequence_header_bytes != 4 and d_sequence_header_bytes != 8)
+        {
+            std::cout << "The UDP sequence header must be 0, 4 or 8 bytes long. It will not be used.\n";
+            d_sequence_header_bytes = 0;
+        }
+
+    const int payload_bytes = d_udp_packet_size - d_sequence_header_bytes;
+    d_samples_per_packet = payload_bytes / d_bytes_per_sample;
+    if (d_samples_per_packet <= 0)
+        {
+            std::cout << "The UDP packet size is too small for the configured sample type\n";
+            exit(0);
+        }
+    d_ring = std::make_unique<Spsc_Packet_Ring>(static_cast<size_t>(std::max(ring_packets, 2 * d_batch_packets)), static_cast<size_t>(payload_bytes));
+}
+
+
+Gr_Complex_Udp_Socket_Source::~Gr_Complex_Udp_Socket_Source()
+{
+    Gr_Complex_Udp_Socket_Source::stop();
+}
+
+
+bool Gr_Complex_Udp_Socket_Source::open()
+{
+    d_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (d_socket == -1)
+        {
+            std::cout << "Error opening UDP socket: " << strerror(errno) << '\n';
+            return false;
+        }
+
+    const int reuse = 1;
+    setsockopt(d_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    if (d_socket_buffer_bytes > 0)
+        {
+            // SO_RCVBUFFORCE overrides net.core.rmem_max, but needs CAP_NET_ADMIN
+            if (setsockopt(d_socket, SOL_SOCKET, SO_RCVBUFFORCE, &d_socket_buffer_bytes, sizeof(d_socket_buffer_bytes)) != 0)
+                {
+                    setsockopt(d_socket, SOL_SOCKET, SO_RCVBUF, &d_socket_buffer_bytes, sizeof(d_socket_buffer_bytes));
+                }
+            int actual = 0;
+            socklen_t len = sizeof(actual);
+            getsockopt(d_socket, SOL_SOCKET, SO_RCVBUF, &actual, &len);
+            if (actual < d_socket_buffer_bytes)  // the kernel reports twice the requested value
+                {
+                    std::cout << "UDP socket receive buffer limited to " << actual / 2 << " bytes. "
+                              << "Raise net.core.rmem_max to get the requested " << d_socket_buffer_bytes << " bytes.\n";
+                }
+        }
+
+    if (d_busy_poll_us > 0)
+        {
+#ifdef SO_BUSY_POLL
+            if (setsockopt(d_socket, SOL_SOCKET, SO_BUSY_POLL, &d_busy_poll_us, sizeof(d_busy_poll_us)) != 0)
+                {
+                    LOG(WARNING) << "SO_BUSY_POLL could not be set: " << strerror(errno);
+                }
+#else
+            LOG(WARNING) << "SO_BUSY_POLL is not available in this system";
+#endif
+        }
+
+    // Wake up periodically to check if the block has been stopped
+    struct timeval timeout
+    {
+    };
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 100000;
+    setsockopt(d_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    struct sockaddr_in si_me
+    {
+    };
+    si_me.sin_family = AF_INET;
+    si_me.sin_port = htons(d_udp_port);
+    si_me.sin_addr.s_addr = htonl(INADDR_ANY);
+    struct in_addr group
+    {
+    };
+    const bool valid_address = inet_pton(AF_INET, d_address.c_str(), &group) == 1;
+    const bool is_multicast = valid_address and IN_MULTICAST(ntohl(group.s_addr));
+    if (valid_address and !is_multicast)
+        {
+            si_me.sin_addr = group;
+        }
+
+    if (bind(d_socket, reinterpret_cast<struct sockaddr *>(&si_me), sizeof(si_me)) == -1)
+        {
+            std::cout << "Error binding UDP socket to port " << d_udp_port << ": " << strerror(errno) << '\n';
+            close(d_socket);
+            d_socket = -1;
+            return false;
+        }
+
+    if (is_multicast)
+        {
+            struct ip_mreq mreq
+            {
+            };
+            mreq.imr_multiaddr = group;
+            mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+            if (setsockopt(d_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0)
+                {
+                    std::cout << "Error joining multicast group " << d_address << ": " << strerror(errno) << '\n';
+                }
+        }
+    return true;
+}
+
+
+bool Gr_Complex_Udp_Socket_Source::start()
+{
+    if (!open())
+        {
+            return false;
+        }
+    d_stop = false;
+    d_receive_thread = std::thread(&Gr_Complex_Udp_Socket_Source::receive_loop, this);
+    return true;
+}
+
+
+bool Gr_Complex_Udp_Socket_Source::stop()
+{
+    d_stop = true;
+    if (d_receive_thread.joinable())
+        {
+            d_receive_thread.join();
+        }
+    if (d_socket != -1)
+        {
+            close(d_socket);
+            d_socket = -1;
+            LOG(INFO) << "UDP socket source on port " << d_udp_port << ": "
+                      << d_received_packets.load() << " packets received, "
+                      << d_overflow_packets.load() << " dropped because of ring overflow, "
+                      << d_truncated_packets.load() << " dropped because they were truncated, "
+                      << d_lost_packets.load() << " lost in the network, "
+                      << d_late_packets.load() << " discarded as late";
+        }
+    return true;
+}
+
+
+void Gr_Complex_Udp_Socket_Source::receive_loop()
+{
+    const int batch = d_batch_packets;
+    const size_t payload_bytes = d_ring->slot_size();
+    std::vector<struct mmsghdr> msgs(batch);
+    std::vector<struct iovec> iovecs(2 * batch);
+    std::vector<uint8_t> headers(batch * 8);
+    std::vector<uint8_t> overflow_buffer(payload_bytes);
+    const int iov_per_packet = d_sequence_header_bytes > 0 ? 2 : 1;
+    bool overflow_reported = false;
+
+    while (!d_stop.load(std::memory_order_relaxed))
+        {
+            int n = static_cast<int>(std::min(d_ring->free_slots(), static_cast<size_t>(batch)));
+            const bool overflow = (n == 0);
+            if (overflow)
+                {
+                    // The ring is full: keep draining the socket so that the
+                    // kernel buffer does not fill up too, and count the loss
+                    n = batch;
+                }
+            for (int i = 0; i < n; i++)
+                {
+                    struct iovec *iov = &iovecs[2 * i];
+                    int k = 0;
+                    if (d_sequence_header_bytes > 0)
+                        {
+                            iov[k].iov_base = &headers[8 * i];
+                            iov[k].iov_len = d_sequence_header_bytes;
+                            k++;
+                        }
+                    iov[k].iov_base = overflow ? overflow_buffer.data() : d_ring->producer_slot(i).data;
+                    iov[k].iov_len = payload_bytes;
+                    std::memset(&msgs[i], 0, sizeof(struct mmsghdr));
+                    msgs[i].msg_hdr.msg_iov = iov;
+                    msgs[i].msg_hdr.msg_iovlen = iov_per_packet;
+                }
+
+            const int received = recvmmsg(d_socket, msgs.data(), n, MSG_WAITFORONE, nullptr);
+            if (received < 0)
+                {
+                    if (errno == EAGAIN or errno == EWOULDBLOCK or errno == EINTR)
+                        {
+                            continue;
+                        }
+                    LOG(ERROR) << "Error receiving from UDP socket: " << strerror(errno);
+                    break;
+                }
+
+            if (overflow)
+                {
+                    d_overflow_packets += received;
+                    if (!overflow_reported)
+                        {
+                            // notify overflow, once per episode
+                            std::cout << "o" << std::flush;
+                            overflow_reported = true;
+                        }
+                    continue;
+                }
+            overflow_reported = false;
+
+            for (int i = 0; i < received; i++)
+                {
+                    Spsc_Packet_Ring::Slot &slot = d_ring->producer_slot(i);
+                    const auto length = static_cast<int>(msgs[i].msg_len) - d_sequence_header_bytes;
+                    slot.sequence = 0;
+                    if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC)
+                        {
+                            // Longer than the configured packet size: the tail has
+                            // been cut by the kernel, so the packet is dropped
+                            slot.length = 0;
+                            if (d_truncated_packets++ == 0)
+                                {
+                                    LOG(WARNING) << "UDP packets on port " << d_udp_port << " are longer than "
+                                                 << d_udp_packet_size << " bytes, dropping them";
+                                }
+                            continue;
+                        }
+                    if (length <= 0)
+                        {
+                            slot.length = 0;  // runt packet, skipped by the consumer
+                            continue;
+                        }
+                    slot.length = static_cast<size_t>(length);
+                    for (int b = 0; b < d_sequence_header_bytes; b++)
+                        {
+                            slot.sequence = (slot.sequence << 8) | headers[8 * i + b];
+                        }
+                }
+            d_ring->commit(received);
+            d_received_packets += received;
+        }
+}
+
+
+bool Gr_Complex_Udp_Socket_Source::check_sequence(const Spsc_Packet_Ring::Slot &slot, const gr_vector_void_star &output_items, int offset)
+{
+    if (d_sequence_header_bytes == 0)
+        {
+            return true;
+        }
+    if (!d_sequence_locked)
+        {
+            d_sequence_locked = true;
+            d_expected_sequence = slot.sequence + 1;
+            return true;
+        }
+    if (slot.sequence == d_expected_sequence)
+        {
+            d_expected_sequence++;
+            return true;
+        }
+
+    if (slot.sequence < d_expected_sequence)
+        {
+            if (d_expected_sequence - slot.sequence <= MAX_LATE_PACKETS)
+                {
+                    // Reordered or duplicated: its place has already been zero-filled
+                    d_late_packets++;
+                    return false;
+                }
+            LOG(INFO) << "UDP packet sequence restarted at " << slot.sequence;
+            d_expected_sequence = slot.sequence + 1;
+            return true;
+        }
+
+    const uint64_t lost = slot.sequence - d_expected_sequence;
+    d_lost_packets += lost;
+    d_expected_sequence = slot.sequence + 1;
+    if (lost > MAX_ZERO_FILL_PACKETS)
+        {
+            LOG(WARNING) << "UDP packet sequence jumped by " << lost << " packets, not zero-filled";
+            return true;
+        }
+    d_pending_zeros = lost * static_cast<uint64_t>(d_samples_per_packet);
+    const pmt::pmt_t value = pmt::from_uint64(lost);
+    for (size_t n = 0; n < output_items.size(); n++)
+        {
+            add_item_tag(static_cast<unsigned int>(n), nitems_written(n) + offset, d_gap_tag_key, value);
+        }
+    return true;
+}
+
+
+void Gr_Complex_Udp_Socket_Source::zero_fill(const gr_vector_void_star &output_items, int offset, int num_samples) const
+{
+    for (const auto &output_item : output_items)
+        {
+            std::fill_n(static_cast<gr_complex *>(output_item) + offset, num_samples, gr_complex(0.0, 0.0));
+        }
+}
+
+
+void Gr_Complex_Udp_Socket_Source::demux_samples(const gr_vector_void_star &output_items, const uint8_t *buffer, int offset, int num_samples) const
+{
+    // The wire carries all the baseband channels of a sample together;
+    // channels beyond the connected outputs are skipped.
+    const int n_outputs = static_cast<int>(output_items.size());
+    switch (d_wire_sample_type)
+        {
+        case 1:  // interleaved byte samples
+            for (int n = 0; n < num_samples; n++)
+                {
+                    const auto *sample = reinterpret_cast<const int8_t *>(buffer + n * d_bytes_per_sample);
+                    for (int ch = 0; ch < n_outputs; ch++)
+                        {
+                            const float first = sample[2 * ch];
+                            const float second = sample[2 * ch + 1];
+                            static_cast<gr_complex *>(output_items[ch])[offset + n] = d_IQ_swap ? gr_complex(first, second) : gr_complex(second, first);
+                        }
+                }
+            break;
+        case 2:  // 4-bit samples
+            for (int n = 0; n < num_samples; n++)
+                {
+                    const uint8_t *sample = buffer + n * d_bytes_per_sample;
+                    for (int ch = 0; ch < n_outputs; ch++)
+                        {
+                            const int low = sample[ch] & 0x0F;
+                            const int high = (sample[ch] >> 4) & 0x0F;
+                            const auto real = static_cast<float>(low >= 8 ? 2 * (low - 16) + 1 : 2 * low + 1);
+                            const auto imag = static_cast<float>(high >= 8 ? 2 * (high - 16) + 1 : 2 * high + 1);
+                            static_cast<gr_complex *>(output_items[ch])[offset + n] = d_IQ_swap ? gr_complex(imag, real) : gr_complex(real, imag);
+                        }
+                }
+            break;
+        case 3:  // interleaved float samples
+            for (int n = 0; n < num_samples; n++)
+                {
+                    const uint8_t *sample = buffer + n * d_bytes_per_sample;
+                    for (int ch = 0; ch < n_outputs; ch++)
+                        {
+                            float first;
+                            float second;
+                            memcpy(&first, sample + 8 * ch, sizeof(first));
+                            memcpy(&second, sample + 8 * ch + 4, sizeof(second));
+                            static_cast<gr_complex *>(output_items[ch])[offset + n] = d_IQ_swap ? gr_complex(first, second) : gr_complex(second, first);
+                        }
+                }
+            break;
+        case 4:  // interleaved short samples
+            for (int n = 0; n < num_samples; n++)
+                {
+                    const uint8_t *sample = buffer + n * d_bytes_per_sample;
+                    for (int ch = 0; ch < n_outputs; ch++)
+                        {
+                            int16_t first;
+                            int16_t second;
+                            memcpy(&first, sample + 4 * ch, sizeof(first));
+                            memcpy(&second, sample + 4 * ch + 2, sizeof(second));
+                            static_cast<gr_complex *>(output_items[ch])[offset + n] = d_IQ_swap ? gr_complex(first, second) : gr_complex(second, first);
+                        }
+                }
+            break;
+        default:
+            break;
+        }
+}
+
+
+int Gr_Complex_Udp_Socket_Source::work(int noutput_items,
+    __attribute__((unused)) gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    if (output_items.size() > static_cast<uint64_t>(d_n_baseband_channels))
+        {
+            std::cout << "Configuration error: more baseband channels connected than available in the UDP source\n";
+            exit(0);
+        }
+
+    if (d_pending_zeros == 0 and d_ring->used_slots() == 0)
+        {
+            // Nothing to do yet: yield for a while instead of spinning
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            if (d_ring->used_slots() == 0)
+                {
+                    return 0;
+                }
+        }
+
+    int produced = 0;
+    size_t available = d_ring->used_slots();
+    while (produced < noutput_items)
+        {
+            if (d_pending_zeros > 0)
+                {
+                    const int n = static_cast<int>(std::min(d_pending_zeros, static_cast<uint64_t>(noutput_items - produced)));
+                    zero_fill(output_items, produced, n);
+                    d_pending_zeros -= n;
+                    produced += n;
+                    continue;
+                }
+            if (available == 0)
+                {
+                    break;
+                }
+
+            Spsc_Packet_Ring::Slot &slot = d_ring->consumer_slot();
+            if (!d_front_checked)
+                {
+                    if (slot.length < static_cast<size_t>(d_bytes_per_sample) or !check_sequence(slot, output_items, produced))
+                        {
+                            d_ring->release(1);
+                            available--;
+                            continue;
+                        }
+                    d_front_checked = true;
+                    d_front_offset = 0;
+                    if (d_pending_zeros > 0)
+                        {
+                            continue;  // the gap goes first, this packet is read afterwards
+                        }
+                }
+
+            const int samples_left = static_cast<int>((slot.length - d_front_offset) / d_bytes_per_sample);
+            const int n = std::min(samples_left, noutput_items - produced);
+            demux_samples(output_items, slot.data + d_front_offset, produced, n);
+            produced += n;
+            if (n == samples_left)
+                {
+                    d_ring->release(1);
+                    available--;
+                    d_front_checked = false;
+                }
+            else
+                {
+                    d_front_offset += static_cast<size_t>(n) * d_bytes_per_sample;
+                }
+        }
+    return produced;
+}
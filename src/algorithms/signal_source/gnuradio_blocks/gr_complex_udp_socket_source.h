@@ -0,0 +1,164 @@
+/*!
+ * \file gr_complex_udp_socket_source.h
+ *
+ * \brief Receives UDP packets carrying baseband samples through a plain UDP
+ * socket, using recvmmsg() batches and a lock-free packet ring.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_GR_COMPLEX_UDP_SOCKET_SOURCE_H
+#define GNSS_SDR_GR_COMPLEX_UDP_SOCKET_SOURCE_H
+
+#include "gnss_block_interface.h"
+#include "spsc_packet_ring.h"
+#include <gnuradio/sync_block.h>
+#include <pmt/pmt.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+/*!
+ * \brief GNU Radio source block that reads interleaved I/Q samples from UDP
+ * packets.
+ *
+ * A receiver thread pulls packets from the socket in batches with
+ * recvmmsg(), writing the payloads straight into the slots of a
+ * single-producer / single-consumer lock-free ring, and work() demultiplexes
+ * them into up to four gr_complex output streams.
+ *
+ * If sequence_header_bytes is 4 or 8, each packet starts with a big-endian
+ * packet counter of that size. Missing packets are then replaced by zeros,
+ * so that the sample count (and thus the receiver time) is preserved, and
+ * a "udp_gap" stream tag with the number of lost packets is added at the
+ * first zero-filled sample of each output.
+ */
+class Gr_Complex_Udp_Socket_Source : virtual public gr::sync_block
+{
+public:
+    using sptr = gnss_shared_ptr<Gr_Complex_Udp_Socket_Source>;
+    static sptr make(const std::string &address,
+        int udp_port,
+        int udp_packet_size,
+        int n_baseband_channels,
+        const std::string &wire_sample_type,
+        size_t item_size,
+        bool IQ_swap_,
+        int sequence_header_bytes,
+        int ring_packets,
+        int batch_packets,
+        int socket_buffer_bytes,
+        int busy_poll_us);
+
+    ~Gr_Complex_Udp_Socket_Source();
+
+    // Called by gnuradio to enable drivers, etc for i/o devices.
+    bool start() override;
+
+    // Called by gnuradio to disable drivers, etc for i/o devices.
+    bool stop() override;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items) override;
+
+    inline uint64_t received_packets() const
+    {
+        return d_received_packets.load();
+    }
+
+    inline uint64_t overflow_packets() const
+    {
+        return d_overflow_packets.load();
+    }
+
+    // Packets longer than udp_packet_size. They are dropped, and with a
+    // sequence header their place is zero-filled as a lost packet.
+    inline uint64_t truncated_packets() const
+    {
+        return d_truncated_packets.load();
+    }
+
+    inline uint64_t lost_packets() const
+    {
+        return d_lost_packets.load();
+    }
+
+    inline uint64_t late_packets() const
+    {
+        return d_late_packets.load();
+    }
+
+private:
+    Gr_Complex_Udp_Socket_Source(const std::string &address,
+        int udp_port,
+        int udp_packet_size,
+        int n_baseband_channels,
+        const std::string &wire_sample_type,
+        size_t item_size,
+        bool IQ_swap_,
+        int sequence_header_bytes,
+        int ring_packets,
+        int batch_packets,
+        int socket_buffer_bytes,
+        int busy_poll_us);
+
+    bool open();
+    void receive_loop();
+    void demux_samples(const gr_vector_void_star &output_items, const uint8_t *buffer, int offset, int num_samples) const;
+    void zero_fill(const gr_vector_void_star &output_items, int offset, int num_samples) const;
+    bool check_sequence(const Spsc_Packet_Ring::Slot &slot, const gr_vector_void_star &output_items, int offset);
+
+    std::unique_ptr<Spsc_Packet_Ring> d_ring;
+    std::thread d_receive_thread;
+    pmt::pmt_t d_gap_tag_key;
+    std::string d_address;
+
+    std::atomic<uint64_t> d_received_packets{0};
+    std::atomic<uint64_t> d_overflow_packets{0};
+    std::atomic<uint64_t> d_truncated_packets{0};
+    std::atomic<uint64_t> d_lost_packets{0};
+    std::atomic<uint64_t> d_late_packets{0};
+    std::atomic<bool> d_stop{false};
+
+    uint64_t d_expected_sequence;
+    uint64_t d_pending_zeros;
+    size_t d_front_offset;  // bytes of the oldest ring slot already read
+    int d_socket;
+    int d_udp_port;
+    int d_udp_packet_size;
+    int d_n_baseband_channels;
+    int d_wire_sample_type;
+    int d_bytes_per_sample;
+    int d_samples_per_packet;
+    int d_sequence_header_bytes;
+    int d_batch_packets;
+    int d_socket_buffer_bytes;
+    int d_busy_poll_us;
+    bool d_IQ_swap;
+    bool d_sequence_locked;
+    bool d_front_checked;  // sequence of the oldest ring slot already checked
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GR_COMPLEX_UDP_SOCKET_SOURCE_H
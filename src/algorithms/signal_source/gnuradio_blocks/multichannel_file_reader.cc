@@ -0,0 +1,265 @@
+/*!
+ * \file multichannel_file_reader.cc
+ * \brief GNU Radio block that reads several sample files (e.g., one per
+ * frequency band) from a single I/O thread, with large reads that keep all
+ * the output streams sample-aligned.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "multichannel_file_reader.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <sys/types.h>  // for off_t
+#include <algorithm>    // for std::min, std::max
+#include <chrono>       // for std::chrono::milliseconds
+#include <cstring>      // for memcpy
+#include <stdexcept>    // for std::runtime_error
+
+
+Multichannel_File_Reader::sptr Multichannel_File_Reader::make(size_t item_size,
+    const std::vector<std::string> &filenames,
+    uint64_t items_to_skip,
+    bool repeat,
+    size_t chunk_bytes,
+    int prefetch_chunks)
+{
+    return gnuradio::get_initial_sptr(new Multichannel_File_Reader(item_size,
+        filenames,
+        items_to_skip,
+        repeat,
+        chunk_bytes,
+        prefetch_chunks));
+}
+
+
+Multichannel_File_Reader::Multichannel_File_Reader(size_t item_size,
+    const std::vector<std::string> &filenames,
+    uint64_t items_to_skip,
+    bool repeat,
+    size_t chunk_bytes,
+    int prefetch_chunks)
+    : gr::sync_block("multichannel_file_reader",
+          gr::io_signature::make(0, 0, 0),
+          gr::io_signature::make(1, static_cast<int>(filenames.size()), item_size)),
+      d_filenames(filenames),
+      d_tag_key(pmt::mp("file_sample")),
+      d_current_chunk(nullptr),
+      d_current_offset(0),
+      d_item_size(item_size),
+      d_chunk_items(std::max<size_t>(chunk_bytes / item_size, 1)),
+      d_items_to_skip(items_to_skip),
+      d_next_item(items_to_skip),
+      d_repeat(repeat),
+      d_stop(false),
+      d_end_of_files(false)
+{
+    for (const auto &filename : d_filenames)
+        {
+            std::FILE *file = std::fopen(filename.c_str(), "rb");
+            if (file == nullptr)
+                {
+                    for (auto *f : d_files)
+                        {
+                            std::fclose(f);
+                        }
+                    throw std::runtime_error("can't open file " + filename);
+                }
+            // Reads are already large, stdio buffering would only add a copy
+            std::setvbuf(file, nullptr, _IONBF, 0);
+            d_files.push_back(file);
+        }
+    if (!rewind())
+        {
+            LOG(WARNING) << "Error skipping " << d_items_to_skip << " items of the input files";
+        }
+
+    const int num_chunks = std::max(prefetch_chunks, 2);
+    for (int i = 0; i < num_chunks; i++)
+        {
+            d_chunks.push_back(std::make_unique<Chunk>());
+            d_chunks.back()->buffers.resize(d_files.size(), std::vector<char>(d_chunk_items * d_item_size));
+            d_free_chunks.push_back(d_chunks.back().get());
+        }
+}
+
+
+Multichannel_File_Reader::~Multichannel_File_Reader()
+{
+    Multichannel_File_Reader::stop();
+    for (auto *file : d_files)
+        {
+            std::fclose(file);
+        }
+}
+
+
+bool Multichannel_File_Reader::start()
+{
+    d_stop = false;
+    if (!d_read_thread.joinable())
+        {
+            d_read_thread = std::thread(&Multichannel_File_Reader::read_loop, this);
+        }
+    return true;
+}
+
+
+bool Multichannel_File_Reader::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cv.notify_all();
+    if (d_read_thread.joinable())
+        {
+            d_read_thread.join();
+        }
+    return true;
+}
+
+
+bool Multichannel_File_Reader::rewind()
+{
+    bool success = true;
+    for (auto *file : d_files)
+        {
+            if (fseeko(file, static_cast<off_t>(d_items_to_skip * d_item_size), SEEK_SET) != 0)
+                {
+                    success = false;
+                }
+        }
+    d_next_item = d_items_to_skip;
+    return success;
+}
+
+
+size_t Multichannel_File_Reader::read_items(std::FILE *file, char *buffer, size_t items) const
+{
+    size_t bytes = 0;
+    const size_t bytes_requested = items * d_item_size;
+    while (bytes < bytes_requested)
+        {
+            const size_t n = std::fread(buffer + bytes, 1, bytes_requested - bytes, file);
+            if (n == 0)
+                {
+                    break;
+                }
+            bytes += n;
+        }
+    return bytes / d_item_size;
+}
+
+
+void Multichannel_File_Reader::read_loop()
+{
+    while (true)
+        {
+            Chunk *chunk;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cv.wait(lock, [this] { return d_stop or !d_free_chunks.empty(); });
+                if (d_stop)
+                    {
+                        return;
+                    }
+                chunk = d_free_chunks.front();
+                d_free_chunks.pop_front();
+            }
+
+            // One large read per file, all of them for the same span of items
+            size_t items = d_chunk_items;
+            for (size_t f = 0; f < d_files.size(); f++)
+                {
+                    items = std::min(items, read_items(d_files[f], chunk->buffers[f].data(), d_chunk_items));
+                }
+            chunk->first_item = d_next_item;
+            chunk->items = items;
+            chunk->tag = (d_next_item == d_items_to_skip);
+            d_next_item += items;
+
+            // The shortest file sets the end of all of them
+            bool end_of_files = items < d_chunk_items;
+            if (end_of_files and d_repeat and d_next_item > d_items_to_skip)
+                {
+                    end_of_files = !rewind();
+                }
+
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                if (items > 0)
+                    {
+                        d_ready_chunks.push_back(chunk);
+                    }
+                else
+                    {
+                        d_free_chunks.push_back(chunk);
+                    }
+                d_end_of_files = end_of_files;
+            }
+            d_cv.notify_all();
+            if (end_of_files)
+                {
+                    return;
+                }
+        }
+}
+
+
+int Multichannel_File_Reader::work(int noutput_items,
+    __attribute__((unused)) gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    if (d_current_chunk == nullptr)
+        {
+            std::unique_lock<std::mutex> lock(d_mutex);
+            // Do not block forever, so that the flowgraph can be stopped
+            if (!d_cv.wait_for(lock, std::chrono::milliseconds(100), [this] { return !d_ready_chunks.empty() or d_end_of_files or d_stop; }))
+                {
+                    return 0;
+                }
+            if (d_ready_chunks.empty())
+                {
+                    return d_end_of_files ? WORK_DONE : 0;
+                }
+            d_current_chunk = d_ready_chunks.front();
+            d_ready_chunks.pop_front();
+            d_current_offset = 0;
+        }
+
+    if (d_current_offset == 0 and d_current_chunk->tag)
+        {
+            const pmt::pmt_t value = pmt::from_uint64(d_current_chunk->first_item);
+            for (size_t n = 0; n < output_items.size(); n++)
+                {
+                    add_item_tag(static_cast<unsigned int>(n), nitems_written(n), d_tag_key, value);
+                }
+        }
+
+    const size_t items = std::min(static_cast<size_t>(noutput_items), d_current_chunk->items - d_current_offset);
+    for (size_t n = 0; n < output_items.size(); n++)
+        {
+            memcpy(output_items[n], d_current_chunk->buffers[n].data() + d_current_offset * d_item_size, items * d_item_size);
+        }
+    d_current_offset += items;
+
+    if (d_current_offset == d_current_chunk->items)
+        {
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_free_chunks.push_back(d_current_chunk);
+            }
+            d_cv.notify_all();
+            d_current_chunk = nullptr;
+        }
+    return static_cast<int>(items);
+}
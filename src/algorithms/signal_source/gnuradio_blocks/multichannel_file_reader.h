@@ -0,0 +1,118 @@
+/*!
+ * \file multichannel_file_reader.h
+ * \brief GNU Radio block that reads several sample files (e.g., one per
+ * frequency band) from a single I/O thread, with large reads that keep all
+ * the output streams sample-aligned.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MULTICHANNEL_FILE_READER_H
+#define GNSS_SDR_MULTICHANNEL_FILE_READER_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <pmt/pmt.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+/*!
+ * \brief Reads N files into N aligned output streams.
+ *
+ * Instead of one gr::blocks::file_source per file, each one issuing its own
+ * small reads, a single I/O thread reads chunk_bytes from each file in turn
+ * and queues the chunks of all the files together, up to prefetch_chunks
+ * chunks ahead of the consumer. Reads are thus large and sequential, and
+ * the streams cannot drift apart: every output gets the same number of
+ * items from each chunk.
+ *
+ * A "file_sample" stream tag carrying the index of the item within the
+ * files is added to all the outputs at the first item, and again each time
+ * the files are rewound in repeat mode.
+ */
+class Multichannel_File_Reader : virtual public gr::sync_block
+{
+public:
+    using sptr = gnss_shared_ptr<Multichannel_File_Reader>;
+    static sptr make(size_t item_size,
+        const std::vector<std::string> &filenames,
+        uint64_t items_to_skip,
+        bool repeat,
+        size_t chunk_bytes,
+        int prefetch_chunks);
+
+    ~Multichannel_File_Reader();
+
+    bool start() override;
+    bool stop() override;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    struct Chunk
+    {
+        std::vector<std::vector<char>> buffers;  // one per file
+        uint64_t first_item;                     // index of the first item in the files
+        size_t items;
+        bool tag;
+    };
+
+    Multichannel_File_Reader(size_t item_size,
+        const std::vector<std::string> &filenames,
+        uint64_t items_to_skip,
+        bool repeat,
+        size_t chunk_bytes,
+        int prefetch_chunks);
+
+    void read_loop();
+    bool rewind();
+    size_t read_items(std::FILE *file, char *buffer, size_t items) const;
+
+    std::vector<std::unique_ptr<Chunk>> d_chunks;
+    std::deque<Chunk *> d_free_chunks;
+    std::deque<Chunk *> d_ready_chunks;
+    std::vector<std::FILE *> d_files;
+    std::vector<std::string> d_filenames;
+    std::thread d_read_thread;
+    std::mutex d_mutex;
+    std::condition_variable d_cv;
+    pmt::pmt_t d_tag_key;
+    Chunk *d_current_chunk;
+    size_t d_current_offset;  // items of the current chunk already delivered
+    size_t d_item_size;
+    size_t d_chunk_items;
+    uint64_t d_items_to_skip;
+    uint64_t d_next_item;
+    bool d_repeat;
+    bool d_stop;
+    bool d_end_of_files;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MULTICHANNEL_FILE_READER_H
@@ -0,0 +1,80 @@
+/*!
+ * \file spsc_packet_ring.cc
+ * \brief Implementation of a lock-free single-producer / single-consumer
+ * ring of fixed-size packet slots.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "spsc_packet_ring.h"
+
+
+Spsc_Packet_Ring::Spsc_Packet_Ring(size_t num_slots, size_t slot_size)
+    : d_slot_size(slot_size)
+{
+    size_t n = 1;
+    while (n < num_slots)
+        {
+            n <<= 1;
+        }
+    d_mask = n - 1;
+
+    // Slots start on cache line boundaries
+    const size_t stride = ((slot_size + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE;
+    d_storage.resize(n * stride + CACHE_LINE_SIZE);
+    const auto base = reinterpret_cast<uintptr_t>(d_storage.data());
+    const size_t align_offset = (CACHE_LINE_SIZE - base % CACHE_LINE_SIZE) % CACHE_LINE_SIZE;
+    d_slots.resize(n);
+    for (size_t i = 0; i < n; i++)
+        {
+            d_slots[i] = Slot{d_storage.data() + align_offset + i * stride, 0, 0};
+        }
+}
+
+
+size_t Spsc_Packet_Ring::free_slots() const
+{
+    const uint64_t write_index = d_write_index.load(std::memory_order_relaxed);
+    const uint64_t read_index = d_read_index.load(std::memory_order_acquire);
+    return d_slots.size() - static_cast<size_t>(write_index - read_index);
+}
+
+
+Spsc_Packet_Ring::Slot& Spsc_Packet_Ring::producer_slot(size_t offset)
+{
+    return d_slots[(d_write_index.load(std::memory_order_relaxed) + offset) & d_mask];
+}
+
+
+void Spsc_Packet_Ring::commit(size_t n)
+{
+    d_write_index.store(d_write_index.load(std::memory_order_relaxed) + n, std::memory_order_release);
+}
+
+
+size_t Spsc_Packet_Ring::used_slots() const
+{
+    const uint64_t read_index = d_read_index.load(std::memory_order_relaxed);
+    const uint64_t write_index = d_write_index.load(std::memory_order_acquire);
+    return static_cast<size_t>(write_index - read_index);
+}
+
+
+Spsc_Packet_Ring::Slot& Spsc_Packet_Ring::consumer_slot(size_t offset)
+{
+    return d_slots[(d_read_index.load(std::memory_order_relaxed) + offset) & d_mask];
+}
+
+
+void Spsc_Packet_Ring::release(size_t n)
+{
+    d_read_index.store(d_read_index.load(std::memory_order_relaxed) + n, std::memory_order_release);
+}
@@ -0,0 +1,124 @@
+/*!
+ * \file spsc_packet_ring.h
+ * \brief Interface of a lock-free single-producer / single-consumer ring of
+ * fixed-size packet slots.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_SPSC_PACKET_RING_H
+#define GNSS_SDR_SPSC_PACKET_RING_H
+
+#include <atomic>   // for std::atomic
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t, uint64_t
+#include <vector>   // for std::vector
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+/*!
+ * \brief Lock-free ring of fixed-size packet slots shared by exactly one
+ * producer thread and one consumer thread.
+ *
+ * The producer fills the slots returned by producer_slot() in place (for
+ * instance, by pointing the buffers of a recvmmsg() call to them) and makes
+ * them visible with commit(). The consumer reads them through
+ * consumer_slot() and gives them back with release(). No locks are taken
+ * and no memory is allocated after construction.
+ */
+class Spsc_Packet_Ring
+{
+public:
+    struct Slot
+    {
+        uint8_t* data;      // slot_size() bytes of payload storage
+        size_t length;      // number of valid payload bytes
+        uint64_t sequence;  // packet sequence number, if any
+    };
+
+    /*!
+     * \brief Creates a ring of at least num_slots slots (rounded up to a
+     * power of two) of slot_size bytes each.
+     */
+    Spsc_Packet_Ring(size_t num_slots, size_t slot_size);
+
+    inline size_t capacity() const
+    {
+        return d_slots.size();
+    }
+
+    inline size_t slot_size() const
+    {
+        return d_slot_size;
+    }
+
+    // Producer side
+
+    /*!
+     * \brief Number of slots that the producer can fill right now.
+     */
+    size_t free_slots() const;
+
+    /*!
+     * \brief Returns the offset-th free slot. offset must be lower than
+     * free_slots().
+     */
+    Slot& producer_slot(size_t offset);
+
+    /*!
+     * \brief Publishes the first n free slots to the consumer.
+     */
+    void commit(size_t n);
+
+    // Consumer side
+
+    /*!
+     * \brief Number of slots ready to be read.
+     */
+    size_t used_slots() const;
+
+    /*!
+     * \brief Returns the offset-th slot ready to be read. offset must be
+     * lower than used_slots().
+     */
+    Slot& consumer_slot(size_t offset = 0);
+
+    /*!
+     * \brief Gives the n oldest slots back to the producer.
+     */
+    void release(size_t n);
+
+private:
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    std::vector<uint8_t> d_storage;
+    std::vector<Slot> d_slots;
+    size_t d_mask;
+    size_t d_slot_size;
+
+    // Keep each index in its own cache line, so that the producer and the
+    // consumer do not invalidate each other's cache on every update
+    char d_pad0[CACHE_LINE_SIZE]{};
+    std::atomic<uint64_t> d_write_index{0};
+    char d_pad1[CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)]{};
+    std::atomic<uint64_t> d_read_index{0};
+    char d_pad2[CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)]{};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SPSC_PACKET_RING_H
@@ -25,6 +25,7 @@
 #include "tlm_conf.h"
 #include <gnuradio/runtime_types.h>  // for basic_block_sptr, top_block_sptr
 #include <cstddef>                   // for size_t
+#include <functional>
 #include <string>
 
 
@@ -72,6 +73,12 @@ public:
         telemetry_decoder_->reset();
     }
 
+    inline std::function<bool(Gnss_Synchro&)> get_symbol_decoder() override
+    {
+        const auto decoder = telemetry_decoder_;
+        return [decoder](Gnss_Synchro& symbol) { return decoder->decode_symbol(symbol); };
+    }
+
     inline size_t item_size() override { return sizeof(Gnss_Synchro); }
 
 private:
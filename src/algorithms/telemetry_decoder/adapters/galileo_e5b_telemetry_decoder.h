@@ -28,6 +28,7 @@
 #include "tlm_conf.h"
 #include <gnuradio/runtime_types.h>  // for basic_block_sptr, top_block_sptr
 #include <cstddef>                   // for size_t
+#include <functional>
 #include <string>
 
 /** \addtogroup Telemetry_Decoder
@@ -92,6 +93,12 @@ public:
         telemetry_decoder_->reset();
     }
 
+    inline std::function<bool(Gnss_Synchro&)> get_symbol_decoder() override
+    {
+        const auto decoder = telemetry_decoder_;
+        return [decoder](Gnss_Synchro& symbol) { return decoder->decode_symbol(symbol); };
+    }
+
     inline size_t item_size() override
     {
         return sizeof(Gnss_Synchro);
@@ -30,6 +30,7 @@
 #include <gnuradio/io_signature.h>
 #include <pmt/pmt.h>        // for make_any
 #include <pmt/pmt_sugar.h>  // for mp
+#include <algorithm>        // for std::min
 #include <cstddef>          // for size_t
 #include <cstdlib>          // for abs
 #include <exception>        // for exception
@@ -76,8 +77,6 @@ beidou_b1i_telemetry_decoder_gs::beidou_b1i_telemetry_decoder_gs(
                             d_enable_navdata_monitor(conf.enable_navdata_monitor),
                             d_dump_crc_stats(conf.dump_crc_stats)
 {
-    // prevent telemetry symbols accumulation in output buffers
-    this->set_max_noutput_items(1);
     // Ephemeris data port out
     this->message_port_register_out(pmt::mp("telemetry"));
     // Control messages to tracking block
@@ -108,6 +107,7 @@ beidou_b1i_telemetry_decoder_gs::beidou_b1i_telemetry_decoder_gs(
         }
 
     d_symbol_history.set_capacity(d_required_symbols);
+    d_preamble_correlator.set_preamble(d_preamble_samples.data(), d_samples_per_preamble);
 
     if (d_dump_crc_stats)
         {
@@ -328,6 +328,7 @@ void beidou_b1i_telemetry_decoder_gs::decode_subframe(float *frame_symbols)
 
 void beidou_b1i_telemetry_decoder_gs::set_satellite(const Gnss_Satellite &satellite)
 {
+    gr::thread::scoped_lock lock(d_setlock);
     uint32_t sat_prn = 0;
     d_satellite = Gnss_Satellite(satellite.get_system(), satellite.get_PRN());
     DLOG(INFO) << "Setting decoder Finite State Machine to satellite " << d_satellite;
@@ -361,6 +362,7 @@ void beidou_b1i_telemetry_decoder_gs::set_satellite(const Gnss_Satellite &satell
             d_symbol_duration_ms = BEIDOU_B1I_GEO_TELEMETRY_SYMBOLS_PER_BIT * BEIDOU_B1I_CODE_PERIOD_MS;
             d_required_symbols = BEIDOU_DNAV_SUBFRAME_SYMBOLS + d_samples_per_preamble;
             d_symbol_history.set_capacity(d_required_symbols);
+            d_preamble_correlator.set_preamble(d_preamble_samples.data(), d_samples_per_preamble);
         }
     else
         {
@@ -385,6 +387,7 @@ void beidou_b1i_telemetry_decoder_gs::set_satellite(const Gnss_Satellite &satell
 
             d_required_symbols = BEIDOU_DNAV_SUBFRAME_SYMBOLS + d_samples_per_preamble;
             d_symbol_history.set_capacity(d_required_symbols);
+            d_preamble_correlator.set_preamble(d_preamble_samples.data(), d_samples_per_preamble);
         }
 }
 
@@ -423,6 +426,7 @@ void beidou_b1i_telemetry_decoder_gs::set_channel(int32_t channel)
 
 void beidou_b1i_telemetry_decoder_gs::reset()
 {
+    gr::thread::scoped_lock lock(d_setlock);
     d_last_valid_preamble = d_sample_counter;
     d_TOW_at_current_symbol_ms = 0;
     d_sent_tlm_failed_msg = false;
@@ -431,38 +435,29 @@ void beidou_b1i_telemetry_decoder_gs::reset()
 }
 
 
-int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+bool beidou_b1i_telemetry_decoder_gs::decode_symbol(Gnss_Synchro &symbol)
 {
-    int32_t corr_value = 0;
-    int32_t preamble_diff = 0;
+    gr::thread::scoped_lock lock(d_setlock);
+    const Gnss_Synchro current_symbol = symbol;
+    return process_symbol(current_symbol, symbol);
+}
 
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
-    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
+
+bool beidou_b1i_telemetry_decoder_gs::process_symbol(const Gnss_Synchro &symbol, Gnss_Synchro &output)
+{
+    int32_t preamble_diff = 0;
 
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0][0];
+    current_symbol = symbol;
     d_symbol_history.push_back(current_symbol.Prompt_I);  // add new symbol to the symbol queue
     d_sample_counter++;                                   // count for the processed samples
-    consume_each(1);
+    d_preamble_correlator.update(d_symbol_history);
     d_flag_preamble = false;
 
-    if (d_symbol_history.size() >= d_required_symbols)
-        {
-            // ******* preamble correlation ********
-            for (int32_t i = 0; i < d_samples_per_preamble; i++)
-                {
-                    if (d_symbol_history[i] < 0)  // symbols clipping
-                        {
-                            corr_value -= d_preamble_samples[i];
-                        }
-                    else
-                        {
-                            corr_value += d_preamble_samples[i];
-                        }
-                }
-        }
+    // ******* preamble correlation ********
+    const int32_t corr_value = d_preamble_correlator.correlation();
+
     // ******* frame sync ******************
     if (d_stat == 0)  // no preamble information
         {
@@ -670,8 +665,30 @@ int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items __attribute_
                 }
 
             // 3. Make the output (copy the object contents to the GNURadio reserved memory)
-            *out[0] = current_symbol;
-            return 1;
+            output = current_symbol;
+            return true;
+        }
+    return false;
+}
+
+
+int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
+    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
+
+    // Decode all the available symbols. Each one produces at most one output item
+    const int32_t n_symbols = std::min(ninput_items[0], noutput_items);
+    int32_t produced = 0;
+    for (int32_t i = 0; i < n_symbols; i++)
+        {
+            gr::thread::scoped_lock lock(d_setlock);
+            if (process_symbol(in[i], out[produced]))
+                {
+                    produced++;
+                }
         }
-    return 0;
+    consume_each(n_symbols);
+    return produced;
 }
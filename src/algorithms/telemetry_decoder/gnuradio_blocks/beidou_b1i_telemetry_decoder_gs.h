@@ -23,9 +23,11 @@
 #include "beidou_dnav_navigation_message.h"
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
+#include "gnss_synchro.h"
 #include "nav_message_packet.h"
 #include "tlm_conf.h"
 #include "tlm_crc_stats.h"
+#include "tlm_preamble_correlator.h"
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>  // for block
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
@@ -63,7 +65,13 @@ public:
     void reset();
 
     /*!
-     * \brief This is where all signal processing takes place
+     * \brief Decodes, in place, one symbol handed over by the tracking block
+     * of a fused channel. Returns true if the symbol has to be delivered.
+     */
+    bool decode_symbol(Gnss_Synchro &symbol);
+
+    /*!
+     * \brief Decodes all the symbols available at the input
      */
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items) override;
@@ -75,6 +83,7 @@ private:
 
     beidou_b1i_telemetry_decoder_gs(const Gnss_Satellite &satellite, const Tlm_Conf &conf);
 
+    bool process_symbol(const Gnss_Synchro &symbol, Gnss_Synchro &output);
     void decode_subframe(float *symbols);
     void decode_word(int32_t word_counter, const float *enc_word_symbols, int32_t *dec_word_symbols);
     void decode_bch15_11_01(const int32_t *bits, std::array<int32_t, 15> &decbits);
@@ -86,6 +95,7 @@ private:
 
     // Storage for incoming data
     boost::circular_buffer<float> d_symbol_history;
+    Tlm_Preamble_Correlator d_preamble_correlator;
 
     // Navigation Message variable
     Beidou_Dnav_Navigation_Message d_nav;
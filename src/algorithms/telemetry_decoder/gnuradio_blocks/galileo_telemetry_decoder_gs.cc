@@ -38,6 +38,7 @@
 #include <gnuradio/io_signature.h>   // for gr::io_signature::make
 #include <pmt/pmt.h>                 // for pmt::make_any
 #include <pmt/pmt_sugar.h>           // for pmt::mp
+#include <algorithm>                 // for std::min
 #include <array>                     // for std::array
 #include <cmath>                     // for std::fmod, std::abs
 #include <cstddef>                   // for size_t
@@ -87,8 +88,6 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
                       d_enable_reed_solomon_inav(false),
                       d_valid_timetag(false)
 {
-    // prevent telemetry symbols accumulation in output buffers
-    this->set_max_noutput_items(1);
     // Ephemeris data port out
     this->message_port_register_out(pmt::mp("telemetry"));
     // Control messages to tracking block
@@ -235,6 +234,7 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
         }
 
     d_symbol_history.set_capacity(d_required_symbols + 1);
+    d_preamble_correlator.set_preamble(d_preamble_samples.data(), d_samples_per_preamble);
 
     d_inav_nav.init_PRN(d_satellite.get_PRN());
 
@@ -650,25 +650,28 @@ void galileo_telemetry_decoder_gs::set_channel(int32_t channel)
 }
 
 
-int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+bool galileo_telemetry_decoder_gs::decode_symbol(Gnss_Synchro &symbol)
 {
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
-    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
+    gr::thread::scoped_lock lock(d_setlock);
+    const Gnss_Synchro current_symbol = symbol;
+    return process_symbol(current_symbol, std::vector<gr::tag_t>(), symbol) > 0;
+}
+
 
+int galileo_telemetry_decoder_gs::process_symbol(const Gnss_Synchro &symbol, const std::vector<gr::tag_t> &tags_vec, Gnss_Synchro &output)
+{
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0][0];
+    current_symbol = symbol;
     d_band = current_symbol.Signal[0];
 
     // add new symbol to the symbol queue
     d_symbol_history.push_back(current_symbol.Prompt_I);
+    d_preamble_correlator.update(d_symbol_history);
 
     d_sample_counter++;  // count for the processed symbols
 
     // Time Tags from signal source (optional feature)
-    std::vector<gr::tag_t> tags_vec;
-    this->get_tags_in_range(tags_vec, 0, this->nitems_read(0), this->nitems_read(0) + 1);  // telemetry decoder consumes symbols one-by-one
     if (!tags_vec.empty())
         {
             for (const auto &it : tags_vec)
@@ -709,7 +712,6 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                 }
         }
 
-    consume_each(1);
     d_flag_preamble = false;
 
     // check if there is a problem with the telemetry of the current satellite
@@ -730,21 +732,10 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
         case 0:  // no preamble information
             {
                 // correlate with preamble
-                int32_t corr_value = 0;
                 if (d_symbol_history.size() > d_required_symbols)
                     {
                         // ******* preamble correlation ********
-                        for (int32_t i = 0; i < d_samples_per_preamble; i++)
-                            {
-                                if (d_symbol_history[i] < 0.0)  // symbols clipping
-                                    {
-                                        corr_value -= d_preamble_samples[i];
-                                    }
-                                else
-                                    {
-                                        corr_value += d_preamble_samples[i];
-                                    }
-                            }
+                        const int32_t corr_value = d_preamble_correlator.correlation();
                         if (std::abs(corr_value) >= d_samples_per_preamble)
                             {
                                 d_preamble_index = d_sample_counter;  // record the preamble sample stamp
@@ -758,21 +749,10 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
         case 1:  // possible preamble lock
             {
                 // correlate with preamble
-                int32_t corr_value = 0;
                 if (d_symbol_history.size() > d_required_symbols)
                     {
                         // ******* preamble correlation ********
-                        for (int32_t i = 0; i < d_samples_per_preamble; i++)
-                            {
-                                if (d_symbol_history[i] < 0.0)  // symbols clipping
-                                    {
-                                        corr_value -= d_preamble_samples[i];
-                                    }
-                                else
-                                    {
-                                        corr_value += d_preamble_samples[i];
-                                    }
-                            }
+                        const int32_t corr_value = d_preamble_correlator.correlation();
                         if (std::abs(corr_value) >= d_samples_per_preamble)
                             {
                                 // check preamble separation
@@ -852,7 +832,6 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                             {
                                 d_CRC_error_counter = 0;
                                 d_flag_preamble = true;  // valid preamble indicator (initialized to false every work())
-                                gr::thread::scoped_lock lock(d_setlock);
                                 d_last_valid_preamble = d_sample_counter;
                                 if (!d_flag_frame_sync)
                                     {
@@ -866,7 +845,6 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                                 if ((d_CRC_error_counter > CRC_ERROR_LIMIT) && (d_frame_type != 3))
                                     {
                                         DLOG(INFO) << "Lost of frame sync SAT " << this->d_satellite;
-                                        gr::thread::scoped_lock lock(d_setlock);
                                         d_flag_frame_sync = false;
                                         d_stat = 0;
                                         d_TOW_at_current_symbol_ms = 0;
@@ -1138,8 +1116,34 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                         }
                 }
             // 3. Make the output (copy the object contents to the GNURadio reserved memory)
-            *out[0] = current_symbol;
+            output = current_symbol;
             return 1;
         }
     return 0;
 }
+
+
+int galileo_telemetry_decoder_gs::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
+    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
+
+    // Decode all the available symbols. Each one produces at most one output item
+    const int32_t n_symbols = std::min(ninput_items[0], noutput_items);
+    int32_t produced = 0;
+    std::vector<gr::tag_t> tags_vec;
+    for (int32_t i = 0; i < n_symbols; i++)
+        {
+            gr::thread::scoped_lock lock(d_setlock);
+            this->get_tags_in_range(tags_vec, 0, this->nitems_read(0) + i, this->nitems_read(0) + i + 1);
+            const int32_t result = process_symbol(in[i], tags_vec, out[produced]);
+            if (result < 0)
+                {
+                    return result;
+                }
+            produced += result;
+        }
+    consume_each(n_symbols);
+    return produced;
+}
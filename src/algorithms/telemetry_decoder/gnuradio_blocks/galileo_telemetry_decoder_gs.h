@@ -26,9 +26,11 @@
 #include "galileo_inav_message.h"     // for Galileo_Inav_Message
 #include "gnss_block_interface.h"     // for gnss_shared_ptr (adapts smart pointer type to GNU Radio version)
 #include "gnss_satellite.h"           // for Gnss_Satellite
+#include "gnss_synchro.h"             // for Gnss_Synchro
 #include "gnss_time.h"                // for GnssTime
 #include "nav_message_packet.h"       // for Nav_Message_Packet
 #include "tlm_conf.h"                 // for Tlm_Conf
+#include "tlm_preamble_correlator.h"  // for Tlm_Preamble_Correlator
 #include <boost/circular_buffer.hpp>  // for boost::circular_buffer
 #include <gnuradio/block.h>           // for block
 #include <gnuradio/types.h>           // for gr_vector_const_void_star
@@ -66,7 +68,13 @@ public:
     void reset();
 
     /*!
-     * \brief This is where all signal processing takes place
+     * \brief Decodes, in place, one symbol handed over by the tracking block
+     * of a fused channel. Returns true if the symbol has to be delivered.
+     */
+    bool decode_symbol(Gnss_Synchro &symbol);
+
+    /*!
+     * \brief Decodes all the symbols available at the input
      */
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items) override;
@@ -84,6 +92,7 @@ private:
     void decode_INAV_word(float *page_part_symbols, int32_t frame_length);
     void decode_FNAV_word(float *page_symbols, int32_t frame_length);
     void decode_CNAV_word(float *page_symbols, int32_t page_length);
+    int32_t process_symbol(const Gnss_Synchro &symbol, const std::vector<gr::tag_t> &tags_vec, Gnss_Synchro &output);  // returns the number of output items, or -1
 
     std::unique_ptr<Viterbi_Decoder> d_viterbi;
     std::vector<int32_t> d_preamble_samples;
@@ -93,6 +102,7 @@ private:
     std::ofstream d_dump_file;
 
     boost::circular_buffer<float> d_symbol_history;
+    Tlm_Preamble_Correlator d_preamble_correlator;
 
     Gnss_Satellite d_satellite;
 
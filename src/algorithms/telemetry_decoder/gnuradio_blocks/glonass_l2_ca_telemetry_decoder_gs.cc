@@ -26,6 +26,7 @@
 #include <gnuradio/io_signature.h>
 #include <pmt/pmt.h>        // for make_any
 #include <pmt/pmt_sugar.h>  // for mp
+#include <algorithm>        // for std::min
 #include <cmath>            // for floor, round
 #include <cstddef>          // for size_t
 #include <cstdlib>          // for abs
@@ -63,8 +64,6 @@ glonass_l2_ca_telemetry_decoder_gs::glonass_l2_ca_telemetry_decoder_gs(
                             d_enable_navdata_monitor(conf.enable_navdata_monitor),
                             d_dump_crc_stats(conf.dump_crc_stats)
 {
-    // prevent telemetry symbols accumulation in output buffers
-    this->set_max_noutput_items(1);
     // Ephemeris data port out
     this->message_port_register_out(pmt::mp("telemetry"));
     // Control messages to tracking block
@@ -268,6 +267,7 @@ void glonass_l2_ca_telemetry_decoder_gs::decode_string(const double *frame_symbo
 
 void glonass_l2_ca_telemetry_decoder_gs::set_satellite(const Gnss_Satellite &satellite)
 {
+    gr::thread::scoped_lock lock(d_setlock);
     d_satellite = Gnss_Satellite(satellite.get_system(), satellite.get_PRN());
     DLOG(INFO) << "Setting decoder Finite State Machine to satellite " << d_satellite;
     DLOG(INFO) << "Navigation Satellite set to " << d_satellite;
@@ -306,21 +306,24 @@ void glonass_l2_ca_telemetry_decoder_gs::set_channel(int32_t channel)
 }
 
 
-int glonass_l2_ca_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+bool glonass_l2_ca_telemetry_decoder_gs::decode_symbol(Gnss_Synchro &symbol)
+{
+    gr::thread::scoped_lock lock(d_setlock);
+    const Gnss_Synchro current_symbol = symbol;
+    return process_symbol(current_symbol, symbol);
+}
+
+
+bool glonass_l2_ca_telemetry_decoder_gs::process_symbol(const Gnss_Synchro &symbol, Gnss_Synchro &output)
 {
     int32_t corr_value = 0;
     int32_t preamble_diff = 0;
 
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
-    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
-
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0][0];
+    current_symbol = symbol;
     d_symbol_history.push_back(current_symbol);  // add new symbol to the symbol queue
     d_sample_counter++;                          // count for the processed samples
-    consume_each(1);
 
     d_flag_preamble = false;
 
@@ -502,7 +505,29 @@ int glonass_l2_ca_telemetry_decoder_gs::general_work(int noutput_items __attribu
         }
 
     // 3. Make the output (copy the object contents to the GNURadio reserved memory)
-    *out[0] = current_symbol;
+    output = current_symbol;
+
+    return true;
+}
 
-    return 1;
+
+int glonass_l2_ca_telemetry_decoder_gs::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
+    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
+
+    // Decode all the available symbols. Each one produces at most one output item
+    const int32_t n_symbols = std::min(ninput_items[0], noutput_items);
+    int32_t produced = 0;
+    for (int32_t i = 0; i < n_symbols; i++)
+        {
+            gr::thread::scoped_lock lock(d_setlock);
+            if (process_symbol(in[i], out[produced]))
+                {
+                    produced++;
+                }
+        }
+    consume_each(n_symbols);
+    return produced;
 }
@@ -63,7 +63,13 @@ public:
     inline void reset(){};
 
     /*!
-     * \brief This is where all signal processing takes place
+     * \brief Decodes, in place, one symbol handed over by the tracking block
+     * of a fused channel. Returns true if the symbol has to be delivered.
+     */
+    bool decode_symbol(Gnss_Synchro &symbol);
+
+    /*!
+     * \brief Decodes all the symbols available at the input
      */
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items) override;
@@ -75,6 +81,8 @@ private:
 
     glonass_l2_ca_telemetry_decoder_gs(const Gnss_Satellite &satellite, const Tlm_Conf &conf);
 
+    bool process_symbol(const Gnss_Synchro &symbol, Gnss_Synchro &output);
+
     const std::array<uint16_t, GLONASS_GNAV_PREAMBLE_LENGTH_BITS> d_preambles_bits{GLONASS_GNAV_PREAMBLE};
 
     const int32_t d_symbols_per_preamble = GLONASS_GNAV_PREAMBLE_LENGTH_SYMBOLS;
@@ -25,6 +25,7 @@
 #include "nav_message_packet.h"
 #include "tlm_conf.h"
 #include "tlm_crc_stats.h"
+#include "tlm_preamble_correlator.h"
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>  // for block
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
@@ -33,6 +34,7 @@
 #include <fstream>           // for ofstream
 #include <memory>            // for std::unique_ptr
 #include <string>            // for string
+#include <vector>            // for vector
 
 /** \addtogroup Telemetry_Decoder
  * \{ */
@@ -61,7 +63,13 @@ public:
     void reset();
 
     /*!
-     * \brief This is where all signal processing takes place
+     * \brief Decodes, in place, one symbol handed over by the tracking block
+     * of a fused channel. Returns true if the symbol has to be delivered.
+     */
+    bool decode_symbol(Gnss_Synchro &symbol);
+
+    /*!
+     * \brief Decodes all the symbols available at the input
      */
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items) override;
@@ -73,6 +81,7 @@ private:
 
     gps_l1_ca_telemetry_decoder_gs(const Gnss_Satellite &satellite, const Tlm_Conf &conf);
 
+    bool process_symbol(const Gnss_Synchro &symbol, const std::vector<gr::tag_t> &tags_vec, uint64_t output_item, Gnss_Synchro &output);
     bool gps_word_parityCheck(uint32_t gpsword);
     bool decode_subframe(bool flag_invert);
 
@@ -87,6 +96,7 @@ private:
     std::ofstream d_dump_file;
 
     boost::circular_buffer<float> d_symbol_history;
+    Tlm_Preamble_Correlator d_preamble_correlator;
 
     uint64_t d_sample_counter;
     uint64_t d_preamble_index;
@@ -28,6 +28,7 @@
 #include <gnuradio/io_signature.h>
 #include <pmt/pmt.h>        // for make_any
 #include <pmt/pmt_sugar.h>  // for mp
+#include <algorithm>        // for std::min
 #include <bitset>           // for bitset
 #include <cmath>            // for round
 #include <cstddef>          // for size_t
@@ -63,8 +64,6 @@ gps_l2c_telemetry_decoder_gs::gps_l2c_telemetry_decoder_gs(
                             d_enable_navdata_monitor(conf.enable_navdata_monitor),
                             d_dump_crc_stats(conf.dump_crc_stats)
 {
-    // prevent telemetry symbols accumulation in output buffers
-    this->set_max_noutput_items(1);
     // Ephemeris data port out
     this->message_port_register_out(pmt::mp("telemetry"));
     // Control messages to tracking block
@@ -138,6 +137,7 @@ gps_l2c_telemetry_decoder_gs::~gps_l2c_telemetry_decoder_gs()
 
 void gps_l2c_telemetry_decoder_gs::set_satellite(const Gnss_Satellite &satellite)
 {
+    gr::thread::scoped_lock lock(d_setlock);
     d_satellite = Gnss_Satellite(satellite.get_system(), satellite.get_PRN());
     DLOG(INFO) << "GPS L2C CNAV telemetry decoder in channel " << this->d_channel << " set to satellite " << d_satellite;
 }
@@ -178,25 +178,29 @@ void gps_l2c_telemetry_decoder_gs::set_channel(int channel)
 
 void gps_l2c_telemetry_decoder_gs::reset()
 {
+    gr::thread::scoped_lock lock(d_setlock);
     d_last_valid_preamble = d_sample_counter;
     d_sent_tlm_failed_msg = false;
     DLOG(INFO) << "Telemetry decoder reset for satellite " << d_satellite;
 }
 
 
-int gps_l2c_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+bool gps_l2c_telemetry_decoder_gs::decode_symbol(Gnss_Synchro &symbol)
 {
-    // get pointers on in- and output gnss-synchro objects
-    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
-    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
+    gr::thread::scoped_lock lock(d_setlock);
+    const Gnss_Synchro current_symbol = symbol;
+    return process_symbol(current_symbol, symbol);
+}
+
 
+bool gps_l2c_telemetry_decoder_gs::process_symbol(const Gnss_Synchro &symbol, Gnss_Synchro &output)
+{
     bool flag_new_cnav_frame = false;
     cnav_msg_t msg;
     uint32_t delay = 0;
 
     // add the symbol to the decoder
-    const uint8_t symbol_clip = static_cast<uint8_t>(in[0].Prompt_I > 0) * 255;
+    const uint8_t symbol_clip = static_cast<uint8_t>(symbol.Prompt_I > 0) * 255;
     flag_new_cnav_frame = cnav_msg_decoder_add_symbol(&d_cnav_decoder, symbol_clip, &msg, &delay);
     if (d_dump_crc_stats && (d_cnav_decoder.part1.message_lock || d_cnav_decoder.part2.message_lock))
         {
@@ -206,8 +210,6 @@ int gps_l2c_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
             d_cnav_decoder.part2.message_lock = false;
         }
 
-    consume_each(1);  // one by one
-
     // check if there is a problem with the telemetry of the current satellite
     d_sample_counter++;  // count for the processed symbols
     if (d_sent_tlm_failed_msg == false)
@@ -224,7 +226,7 @@ int gps_l2c_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
     Gnss_Synchro current_synchro_data{};  // structure to save the synchronization information and send the output object to the next block
 
     // 1. Copy the current tracking output
-    current_synchro_data = in[0];
+    current_synchro_data = symbol;
 
     // 2. Add the telemetry decoder information
     // check if new CNAV frame is available
@@ -343,6 +345,29 @@ int gps_l2c_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
         }
 
     // 3. Make the output (copy the object contents to the GNURadio reserved memory)
-    out[0] = current_synchro_data;
-    return 1;
+    output = current_synchro_data;
+    return true;
+}
+
+
+int gps_l2c_telemetry_decoder_gs::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    // get pointers on in- and output gnss-synchro objects
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
+    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
+
+    // Decode all the available symbols. Each one produces at most one output item
+    const int32_t n_symbols = std::min(ninput_items[0], noutput_items);
+    int32_t produced = 0;
+    for (int32_t i = 0; i < n_symbols; i++)
+        {
+            gr::thread::scoped_lock lock(d_setlock);
+            if (process_symbol(in[i], out[produced]))
+                {
+                    produced++;
+                }
+        }
+    consume_each(n_symbols);
+    return produced;
 }
@@ -20,6 +20,7 @@
 
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
+#include "gnss_synchro.h"
 #include "gps_cnav_navigation_message.h"
 #include "nav_message_packet.h"
 #include "tlm_conf.h"
@@ -62,7 +63,13 @@ public:
     void reset();
 
     /*!
-     * \brief This is where all signal processing takes place
+     * \brief Decodes, in place, one symbol handed over by the tracking block
+     * of a fused channel. Returns true if the symbol has to be delivered.
+     */
+    bool decode_symbol(Gnss_Synchro &symbol);
+
+    /*!
+     * \brief Decodes all the symbols available at the input
      */
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items) override;
@@ -74,6 +81,8 @@ private:
 
     gps_l2c_telemetry_decoder_gs(const Gnss_Satellite &satellite, const Tlm_Conf &conf);
 
+    bool process_symbol(const Gnss_Synchro &symbol, Gnss_Synchro &output);
+
     Gnss_Satellite d_satellite;
 
     cnav_msg_decoder_t d_cnav_decoder{};
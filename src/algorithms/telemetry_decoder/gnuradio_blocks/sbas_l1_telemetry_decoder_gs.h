@@ -19,6 +19,7 @@
 
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
+#include "gnss_synchro.h"
 #include <boost/crc.hpp>  // for crc_optimal
 #include <gnuradio/block.h>
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
@@ -60,7 +61,13 @@ public:
     inline void reset(){};
 
     /*!
-     * \brief This is where all signal processing takes place
+     * \brief Decodes, in place, one symbol handed over by the tracking block
+     * of a fused channel. Returns true if the symbol has to be delivered.
+     */
+    bool decode_symbol(Gnss_Synchro &symbol);
+
+    /*!
+     * \brief Decodes all the symbols available at the input
      */
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items) override;
@@ -72,6 +79,8 @@ private:
 
     sbas_l1_telemetry_decoder_gs(const Gnss_Satellite &satellite, bool dump);
 
+    bool process_symbol(const Gnss_Synchro &symbol, Gnss_Synchro &output);
+
     void viterbi_decoder(double *page_part_symbols, int32_t *page_part_bits);
     void align_samples();
 
@@ -0,0 +1,92 @@
+/*!
+ * \file tlm_preamble_correlator.cc
+ * \brief Incremental correlator of the navigation message preamble against
+ * the oldest symbols of a telemetry decoder symbol history.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_preamble_correlator.h"
+#include <bitset>     // for std::bitset
+#include <stdexcept>  // for std::invalid_argument
+
+
+void Tlm_Preamble_Correlator::set_preamble(const int32_t* preamble_samples, int32_t length)
+{
+    if (length < 0 or length > 64)
+        {
+            throw std::invalid_argument("Tlm_Preamble_Correlator: unsupported preamble length");
+        }
+    d_length = length;
+    d_pattern = 0ULL;
+    for (int32_t i = 0; i < d_length; i++)
+        {
+            if (preamble_samples[i] < 0)
+                {
+                    d_pattern |= (1ULL << i);
+                }
+        }
+    reset();
+}
+
+
+void Tlm_Preamble_Correlator::reset()
+{
+    d_register = 0ULL;
+    d_valid = false;
+}
+
+
+void Tlm_Preamble_Correlator::update(const boost::circular_buffer<float>& symbol_history)
+{
+    if (!symbol_history.full() or static_cast<int32_t>(symbol_history.size()) < d_length)
+        {
+            d_valid = false;
+            return;
+        }
+    if (d_length == 0)
+        {
+            d_valid = true;
+            return;
+        }
+    if (d_valid)
+        {
+            // the history was already full: the window moved by one symbol
+            d_register >>= 1U;
+            if (symbol_history[d_length - 1] < 0.0)
+                {
+                    d_register |= (1ULL << (d_length - 1));
+                }
+        }
+    else
+        {
+            d_register = 0ULL;
+            for (int32_t i = 0; i < d_length; i++)
+                {
+                    if (symbol_history[i] < 0.0)
+                        {
+                            d_register |= (1ULL << i);
+                        }
+                }
+            d_valid = true;
+        }
+}
+
+
+int32_t Tlm_Preamble_Correlator::correlation() const
+{
+    if (!d_valid)
+        {
+            return 0;
+        }
+    const auto mismatches = static_cast<int32_t>(std::bitset<64>(d_register ^ d_pattern).count());
+    return d_length - 2 * mismatches;
+}
@@ -0,0 +1,74 @@
+/*!
+ * \file tlm_preamble_correlator.h
+ * \brief Incremental correlator of the navigation message preamble against
+ * the oldest symbols of a telemetry decoder symbol history.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TLM_PREAMBLE_CORRELATOR_H
+#define GNSS_SDR_TLM_PREAMBLE_CORRELATOR_H
+
+#include <boost/circular_buffer.hpp>
+#include <cstdint>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs
+ * \{ */
+
+/*!
+ * \brief Correlates the sign of the first symbols of a full symbol history
+ * with the preamble samples.
+ *
+ * The hard decisions of the correlation window are kept packed in a shift
+ * register, so each new symbol costs a shift and a bit count instead of a
+ * loop over the whole preamble. The result is the same as
+ * sum_i (history[i] < 0 ? -preamble[i] : preamble[i]), and zero when the
+ * history is not full yet.
+ */
+class Tlm_Preamble_Correlator
+{
+public:
+    Tlm_Preamble_Correlator() = default;
+
+    /*!
+     * \brief Set the preamble samples (+1 / -1), at most 64 of them
+     */
+    void set_preamble(const int32_t* preamble_samples, int32_t length);
+
+    /*!
+     * \brief Forget the symbols seen so far
+     */
+    void reset();
+
+    /*!
+     * \brief Slide the correlation window. Call it after each push_back() to
+     * the symbol history, and call reset() if the history is resized.
+     */
+    void update(const boost::circular_buffer<float>& symbol_history);
+
+    /*!
+     * \brief Correlation of the window with the preamble
+     */
+    int32_t correlation() const;
+
+private:
+    uint64_t d_pattern{0ULL};   // bit i set if preamble sample i is negative
+    uint64_t d_register{0ULL};  // bit i set if history[i] is negative
+    int32_t d_length{0};
+    bool d_valid{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TLM_PREAMBLE_CORRELATOR_H
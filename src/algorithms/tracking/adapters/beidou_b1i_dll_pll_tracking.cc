@@ -26,6 +26,7 @@
 #include "display.h"
 #include "dll_pll_conf.h"
 #include "gnss_sdr_flags.h"
+#include "item_type_helpers.h"
 #include <glog/logging.h>
 #include <array>
 
@@ -65,9 +66,9 @@ BeidouB1iDllPllTracking::BeidouB1iDllPllTracking(
     std::memcpy(trk_params.signal, sig_.data(), 3);
 
     // ################# Make a GNU Radio Tracking block object ################
-    if (trk_params.item_type == "gr_complex")
+    if (trk_params.item_type == "gr_complex" or trk_params.item_type == "cshort" or trk_params.item_type == "cbyte")
         {
-            item_size_ = sizeof(gr_complex);
+            item_size_ = item_type_size(trk_params.item_type);
             tracking_ = dll_pll_veml_make_tracking(trk_params);
         }
     else
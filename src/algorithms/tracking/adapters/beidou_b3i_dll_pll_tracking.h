@@ -23,8 +23,7 @@
 #ifndef GNSS_SDR_BEIDOU_B3I_DLL_PLL_TRACKING_H
 #define GNSS_SDR_BEIDOU_B3I_DLL_PLL_TRACKING_H
 
-#include "dll_pll_veml_tracking.h"
-#include "tracking_interface.h"
+#include "dll_pll_veml_tracking_adapter.h"
 #include <string>
 
 /** \addtogroup Tracking
@@ -38,7 +37,7 @@ class ConfigurationInterface;
 /*!
  * \brief This class implements a code DLL + carrier PLL tracking loop
  */
-class BeidouB3iDllPllTracking : public TrackingInterface
+class BeidouB3iDllPllTracking : public DllPllVemlTrackingAdapter
 {
 public:
     BeidouB3iDllPllTracking(
@@ -88,7 +87,6 @@ public:
     void stop_tracking() override;
 
 private:
-    dll_pll_veml_tracking_sptr tracking_;
     size_t item_size_;
     unsigned int channel_;
     std::string role_;
@@ -0,0 +1,25 @@
+/*!
+ * \file dll_pll_veml_tracking_adapter.cc
+ * \brief Base class of the adapters of the DLL+PLL VEML tracking block to a
+ * TrackingInterface
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "dll_pll_veml_tracking_adapter.h"
+#include <utility>
+
+
+bool DllPllVemlTrackingAdapter::set_symbol_decoder(std::function<bool(Gnss_Synchro&)> decoder, gr::basic_block_sptr decoder_block)
+{
+    tracking_->set_symbol_decoder(std::move(decoder), decoder_block);
+    return true;
+}
@@ -0,0 +1,49 @@
+/*!
+ * \file dll_pll_veml_tracking_adapter.h
+ * \brief Base class of the adapters of the DLL+PLL VEML tracking block to a
+ * TrackingInterface
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_DLL_PLL_VEML_TRACKING_ADAPTER_H
+#define GNSS_SDR_DLL_PLL_VEML_TRACKING_ADAPTER_H
+
+#include "dll_pll_veml_tracking.h"
+#include "tracking_interface.h"
+#include <functional>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_adapters
+ * \{ */
+
+
+/*!
+ * \brief Holds the dll_pll_veml_tracking block of the signal-specific
+ * adapters, and implements what they have in common with it
+ */
+class DllPllVemlTrackingAdapter : public TrackingInterface
+{
+public:
+    /*!
+     * \brief Runs the telemetry decoder of a fused channel in the tracking block
+     */
+    bool set_symbol_decoder(std::function<bool(Gnss_Synchro&)> decoder, gr::basic_block_sptr decoder_block) override;
+
+protected:
+    dll_pll_veml_tracking_sptr tracking_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_DLL_PLL_VEML_TRACKING_ADAPTER_H
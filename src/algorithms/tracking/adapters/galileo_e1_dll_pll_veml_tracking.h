@@ -23,8 +23,7 @@
 #ifndef GNSS_SDR_GALILEO_E1_DLL_PLL_VEML_TRACKING_H
 #define GNSS_SDR_GALILEO_E1_DLL_PLL_VEML_TRACKING_H
 
-#include "dll_pll_veml_tracking.h"
-#include "tracking_interface.h"
+#include "dll_pll_veml_tracking_adapter.h"
 #include <string>
 
 /** \addtogroup Tracking
@@ -39,7 +38,7 @@ class ConfigurationInterface;
  * \brief This class Adapts a DLL+PLL VEML (Very Early Minus Late) tracking
  * loop block to a TrackingInterface for Galileo E1 signals
  */
-class GalileoE1DllPllVemlTracking : public TrackingInterface
+class GalileoE1DllPllVemlTracking : public DllPllVemlTrackingAdapter
 {
 public:
     GalileoE1DllPllVemlTracking(
@@ -91,7 +90,6 @@ public:
     void stop_tracking() override;
 
 private:
-    dll_pll_veml_tracking_sptr tracking_;
     size_t item_size_;
     unsigned int channel_;
     std::string role_;
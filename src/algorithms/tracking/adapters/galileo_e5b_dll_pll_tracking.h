@@ -24,8 +24,7 @@
 #ifndef GNSS_SDR_GALILEO_E5B_DLL_PLL_TRACKING_H
 #define GNSS_SDR_GALILEO_E5B_DLL_PLL_TRACKING_H
 
-#include "dll_pll_veml_tracking.h"
-#include "tracking_interface.h"
+#include "dll_pll_veml_tracking_adapter.h"
 #include <string>
 
 /** \addtogroup Tracking
@@ -39,7 +38,7 @@ class ConfigurationInterface;
 /*!
  * \brief This class implements a code DLL + carrier PLL tracking loop
  */
-class GalileoE5bDllPllTracking : public TrackingInterface
+class GalileoE5bDllPllTracking : public DllPllVemlTrackingAdapter
 {
 public:
     GalileoE5bDllPllTracking(
@@ -105,7 +104,6 @@ public:
     void stop_tracking() override;
 
 private:
-    dll_pll_veml_tracking_sptr tracking_;
     size_t item_size_;
     unsigned int channel_;
     std::string role_;
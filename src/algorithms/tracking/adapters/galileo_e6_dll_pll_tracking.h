@@ -19,8 +19,7 @@
 #ifndef GNSS_SDR_GALILEO_E6_DLL_PLL_TRACKING_H
 #define GNSS_SDR_GALILEO_E6_DLL_PLL_TRACKING_H
 
-#include "dll_pll_veml_tracking.h"
-#include "tracking_interface.h"
+#include "dll_pll_veml_tracking_adapter.h"
 #include <string>
 
 /** \addtogroup Tracking
@@ -34,7 +33,7 @@ class ConfigurationInterface;
 /*!
  * \brief This class implements a code DLL + carrier PLL tracking loop
  */
-class GalileoE6DllPllTracking : public TrackingInterface
+class GalileoE6DllPllTracking : public DllPllVemlTrackingAdapter
 {
 public:
     GalileoE6DllPllTracking(
@@ -100,7 +99,6 @@ public:
     void stop_tracking() override;
 
 private:
-    dll_pll_veml_tracking_sptr tracking_;
     size_t item_size_;
     unsigned int channel_;
     std::string role_;
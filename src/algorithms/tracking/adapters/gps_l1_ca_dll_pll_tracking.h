@@ -24,8 +24,7 @@
 #ifndef GNSS_SDR_GPS_L1_CA_DLL_PLL_TRACKING_H
 #define GNSS_SDR_GPS_L1_CA_DLL_PLL_TRACKING_H
 
-#include "dll_pll_veml_tracking.h"
-#include "tracking_interface.h"
+#include "dll_pll_veml_tracking_adapter.h"
 #include <string>
 
 /** \addtogroup Tracking
@@ -41,7 +40,7 @@ class ConfigurationInterface;
 /*!
  * \brief This class implements a code DLL + carrier PLL tracking loop
  */
-class GpsL1CaDllPllTracking : public TrackingInterface
+class GpsL1CaDllPllTracking : public DllPllVemlTrackingAdapter
 {
 public:
     GpsL1CaDllPllTracking(
@@ -92,7 +91,6 @@ public:
     void stop_tracking() override;
 
 private:
-    dll_pll_veml_tracking_sptr tracking_;
     size_t item_size_;
     unsigned int channel_;
     std::string role_;
@@ -59,6 +59,8 @@
 #include <map>
 #include <memory>
 #include <numeric>
+#include <stdexcept>  // for invalid_argument
+#include <utility>  // for std::move
 #include <vector>
 
 #if HAS_GENERIC_LAMBDA
@@ -81,7 +83,7 @@ dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_)
 
 
 dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
-    : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, sizeof(gr_complex)),
+    : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, item_type_size(conf_.item_type)),
           gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
       d_trk_parameters(conf_),
       d_acquisition_gnss_synchro(nullptr),
@@ -104,6 +106,8 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
       d_code_phase_step_chips(0.0),
       d_code_phase_rate_step_chips(0.0),
       d_rem_code_phase_samples(0.0),  // Residual code phase (in chips)
+      d_item_size(item_type_size(conf_.item_type)),
+      d_sample_counter(0ULL),
       d_acq_sample_stamp(0ULL),
       d_rem_carr_phase_rad(0.0),  // Residual carrier phase
       d_state(0),                 // initial state: standby
@@ -125,8 +129,8 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
       d_acc_carrier_phase_initialized(false),
       d_Flag_PLL_180_deg_phase_locked(false)
 {
-    // prevent telemetry symbols accumulation in output buffers
-    this->set_max_noutput_items(1);
+    // prevent telemetry symbols accumulation in output buffers beyond one batch
+    this->set_max_noutput_items(static_cast<int>(d_trk_parameters.max_batch_epochs));
 
     // Telemetry bit synchronization message port input
     this->message_port_register_out(pmt::mp("events"));
@@ -453,6 +457,13 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
             d_symbols_per_bit = 0;
         }
 
+    // start_tracking() has no local code replica for any other combination
+    if (d_code_length_chips == 0)
+        {
+            LOG(ERROR) << "Tracking block not created: no local code replica for system " << d_trk_parameters.system << " and signal " << d_signal_type;
+            throw std::invalid_argument("Invalid System or Signal argument when instantiating tracking blocks");
+        }
+
     // Initial code frequency basis of NCO
     d_code_freq_chips = d_code_chip_rate;
 
@@ -460,9 +471,7 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
     d_code_loop_filter = Tracking_loop_filter(static_cast<float>(d_code_period), d_trk_parameters.dll_bw_hz, d_trk_parameters.dll_filter_order, false);
     d_carrier_loop_filter.set_params(d_trk_parameters.fll_bw_hz, d_trk_parameters.pll_bw_hz, d_trk_parameters.pll_filter_order);
 
-    // Initialization of local code replica
-    // Get space for a vector with the sinboc(1,1) replica sampled 2x/chip
-    d_tracking_code.resize(2 * d_code_length_chips, 0.0);
+    // Local code replicas are taken from the replica store when tracking starts
     // correlator outputs (scalar)
     if (d_veml)
         {
@@ -507,6 +516,14 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
 
     d_multicorrelator_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), d_n_correlator_taps);
 
+    if (d_trk_parameters.item_type != "gr_complex")
+        {
+            // Integer samples are converted right before the correlation, so
+            // the flowgraph buffers keep 2 or 4 bytes per sample instead of 8
+            d_input_converter = make_vector_converter(d_trk_parameters.item_type, "gr_complex");
+            d_input_samples = volk_gnsssdr::vector<gr_complex>(2 * d_trk_parameters.vector_length);
+        }
+
     if (d_trk_parameters.extend_correlation_symbols > 1)
         {
             d_enable_extended_integration = true;
@@ -523,7 +540,6 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
             // Extra correlator for the data component
             d_correlator_data_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), 1);
             d_correlator_data_cpu.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
-            d_data_code.resize(2 * d_code_length_chips, 0.0);
         }
 
     // --- Initializations ---
@@ -635,6 +651,15 @@ void dll_pll_veml_tracking::msg_handler_telemetry_to_trk(const pmt::pmt_t &msg)
 }
 
 
+Code_Replica_Store::Replica_Ptr dll_pll_veml_tracking::get_code_replica(const std::string &component, const Code_Replica_Store::Generator &generator) const
+{
+    // The replica is sized for the sinboc(1,1) case, sampled 2x/chip
+    const size_t size = 2 * static_cast<size_t>(d_code_length_chips);
+    const std::string key = d_systemName + " " + d_signal_type + " " + component + " PRN " + std::to_string(d_acquisition_gnss_synchro->PRN) + " " + std::to_string(size);
+    return Code_Replica_Store::instance().get(key, size, generator);
+}
+
+
 void dll_pll_veml_tracking::start_tracking()
 {
     gr::thread::scoped_lock l(d_setlock);
@@ -653,26 +678,28 @@ void dll_pll_veml_tracking::start_tracking()
     Signal_[1] = d_acquisition_gnss_synchro->Signal[1];
     Signal_[2] = d_acquisition_gnss_synchro->Signal[2];
 
+    // Local code replicas are shared by all the channels through the replica store
+    const uint32_t PRN = d_acquisition_gnss_synchro->PRN;
     if (d_systemName == "GPS" and d_signal_type == "1C")
         {
-            gps_l1_ca_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN, 0);
+            d_tracking_code = get_code_replica("C/A", [PRN](own::span<float> code) { gps_l1_ca_code_gen_float(code, PRN, 0); });
         }
     else if (d_systemName == "GPS" and d_signal_type == "2S")
         {
-            gps_l2c_m_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN);
+            d_tracking_code = get_code_replica("CM", [PRN](own::span<float> code) { gps_l2c_m_code_gen_float(code, PRN); });
         }
     else if (d_systemName == "GPS" and d_signal_type == "L5")
         {
             if (d_trk_parameters.track_pilot)
                 {
-                    gps_l5q_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN);
-                    gps_l5i_code_gen_float(d_data_code, d_acquisition_gnss_synchro->PRN);
+                    d_tracking_code = get_code_replica("Q", [PRN](own::span<float> code) { gps_l5q_code_gen_float(code, PRN); });
+                    d_data_code = get_code_replica("I", [PRN](own::span<float> code) { gps_l5i_code_gen_float(code, PRN); });
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code->data(), d_prompt_data_shift);
                 }
             else
                 {
-                    gps_l5i_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN);
+                    d_tracking_code = get_code_replica("I", [PRN](own::span<float> code) { gps_l5i_code_gen_float(code, PRN); });
                 }
         }
     else if (d_systemName == "Galileo" and d_signal_type == "1B")
@@ -680,82 +707,69 @@ void dll_pll_veml_tracking::start_tracking()
             if (d_trk_parameters.track_pilot)
                 {
                     const std::array<char, 3> pilot_signal = {{'1', 'C', '\0'}};
-                    galileo_e1_code_gen_sinboc11_float(d_tracking_code, pilot_signal, d_acquisition_gnss_synchro->PRN);
-                    galileo_e1_code_gen_sinboc11_float(d_data_code, Signal_, d_acquisition_gnss_synchro->PRN);
-                    d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
-                }
-            else
-                {
-                    galileo_e1_code_gen_sinboc11_float(d_tracking_code, Signal_, d_acquisition_gnss_synchro->PRN);
-                }
-        }
-    else if (d_systemName == "Galileo" and d_signal_type == "5X")
-        {
-            volk_gnsssdr::vector<gr_complex> aux_code(d_code_length_chips);
-            const std::array<char, 3> signal_type_ = {{'5', 'X', '\0'}};
-            galileo_e5_a_code_gen_complex_primary(aux_code, d_acquisition_gnss_synchro->PRN, signal_type_);
-            if (d_trk_parameters.track_pilot)
-                {
-                    d_secondary_code_string = GALILEO_E5A_Q_SECONDARY_CODE[d_acquisition_gnss_synchro->PRN - 1];
-                    for (int32_t i = 0; i < d_code_length_chips; i++)
-                        {
-                            d_tracking_code[i] = aux_code[i].imag();
-                            d_data_code[i] = aux_code[i].real();  // the same because it is generated the full signal (E5aI + E5aQ)
-                        }
+                    d_tracking_code = get_code_replica("1C", [PRN, pilot_signal](own::span<float> code) { galileo_e1_code_gen_sinboc11_float(code, pilot_signal, PRN); });
+                    d_data_code = get_code_replica("1B", [PRN, Signal_](own::span<float> code) { galileo_e1_code_gen_sinboc11_float(code, Signal_, PRN); });
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code->data(), d_prompt_data_shift);
                 }
             else
                 {
-                    for (int32_t i = 0; i < d_code_length_chips; i++)
-                        {
-                            d_tracking_code[i] = aux_code[i].real();
-                        }
+                    d_tracking_code = get_code_replica("1B", [PRN, Signal_](own::span<float> code) { galileo_e1_code_gen_sinboc11_float(code, Signal_, PRN); });
                 }
         }
-    else if (d_systemName == "Galileo" and d_signal_type == "7X")
+    else if (d_systemName == "Galileo" and (d_signal_type == "5X" or d_signal_type == "7X"))
         {
-            volk_gnsssdr::vector<gr_complex> aux_code(d_code_length_chips);
-            const std::array<char, 3> signal_type_ = {{'7', 'X', '\0'}};
-            galileo_e5_b_code_gen_complex_primary(aux_code, d_acquisition_gnss_synchro->PRN, signal_type_);
+            // The primary codes of both components are generated together
+            const bool e5a = (d_signal_type == "5X");
+            const int32_t code_length_chips = d_code_length_chips;
+            const auto e5_component = [PRN, e5a, code_length_chips](own::span<float> code, bool imag) {
+                volk_gnsssdr::vector<gr_complex> aux_code(code_length_chips);
+                if (e5a)
+                    {
+                        const std::array<char, 3> signal_type_ = {{'5', 'X', '\0'}};
+                        galileo_e5_a_code_gen_complex_primary(aux_code, PRN, signal_type_);
+                    }
+                else
+                    {
+                        const std::array<char, 3> signal_type_ = {{'7', 'X', '\0'}};
+                        galileo_e5_b_code_gen_complex_primary(aux_code, PRN, signal_type_);
+                    }
+                for (int32_t i = 0; i < code_length_chips; i++)
+                    {
+                        code[i] = imag ? aux_code[i].imag() : aux_code[i].real();
+                    }
+            };
             if (d_trk_parameters.track_pilot)
                 {
-                    d_secondary_code_string = GALILEO_E5B_Q_SECONDARY_CODE[d_acquisition_gnss_synchro->PRN - 1];
-                    for (int32_t i = 0; i < d_code_length_chips; i++)
-                        {
-                            d_tracking_code[i] = aux_code[i].imag();
-                            d_data_code[i] = aux_code[i].real();  // the same because it is generated the full signal (E5bI + E5bsQ)
-                        }
+                    d_secondary_code_string = e5a ? GALILEO_E5A_Q_SECONDARY_CODE[PRN - 1] : GALILEO_E5B_Q_SECONDARY_CODE[PRN - 1];
+                    d_tracking_code = get_code_replica("Q", [&e5_component](own::span<float> code) { e5_component(code, true); });
+                    d_data_code = get_code_replica("I", [&e5_component](own::span<float> code) { e5_component(code, false); });
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code->data(), d_prompt_data_shift);
                 }
             else
                 {
-                    for (int32_t i = 0; i < d_code_length_chips; i++)
-                        {
-                            d_tracking_code[i] = aux_code[i].real();
-                        }
+                    d_tracking_code = get_code_replica("I", [&e5_component](own::span<float> code) { e5_component(code, false); });
                 }
         }
     else if (d_systemName == "Galileo" and d_signal_type == "E6")
         {
             if (d_trk_parameters.track_pilot)
                 {
-                    d_secondary_code_string = galileo_e6_c_secondary_code(d_acquisition_gnss_synchro->PRN);
-                    galileo_e6_b_code_gen_float_primary(d_data_code, d_acquisition_gnss_synchro->PRN);
-                    galileo_e6_c_code_gen_float_primary(d_tracking_code, d_acquisition_gnss_synchro->PRN);
+                    d_secondary_code_string = galileo_e6_c_secondary_code(PRN);
+                    d_data_code = get_code_replica("B", [PRN](own::span<float> code) { galileo_e6_b_code_gen_float_primary(code, PRN); });
+                    d_tracking_code = get_code_replica("C", [PRN](own::span<float> code) { galileo_e6_c_code_gen_float_primary(code, PRN); });
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code->data(), d_prompt_data_shift);
                 }
             else
                 {
-                    galileo_e6_b_code_gen_float_primary(d_tracking_code, d_acquisition_gnss_synchro->PRN);
+                    d_tracking_code = get_code_replica("B", [PRN](own::span<float> code) { galileo_e6_b_code_gen_float_primary(code, PRN); });
                 }
         }
     else if (d_systemName == "Beidou" and d_signal_type == "B1")
         {
-            beidou_b1i_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN, 0);
+            d_tracking_code = get_code_replica("B1I", [PRN](own::span<float> code) { beidou_b1i_code_gen_float(code, PRN, 0); });
             // GEO Satellites use different secondary code
             if (d_acquisition_gnss_synchro->PRN > 0 and d_acquisition_gnss_synchro->PRN < 6)
                 {
@@ -788,7 +802,7 @@ void dll_pll_veml_tracking::start_tracking()
 
     else if (d_systemName == "Beidou" and d_signal_type == "B3")
         {
-            beidou_b3i_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN, 0);
+            d_tracking_code = get_code_replica("B3I", [PRN](own::span<float> code) { beidou_b3i_code_gen_float(code, PRN, 0); });
             // Update secondary code settings for geo satellites
             if (d_acquisition_gnss_synchro->PRN > 0 and d_acquisition_gnss_synchro->PRN < 6)
                 {
@@ -819,7 +833,7 @@ void dll_pll_veml_tracking::start_tracking()
                 }
         }
 
-    d_multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code.data(), d_local_code_shift_chips.data());
+    d_multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code->data(), d_local_code_shift_chips.data());
     std::fill_n(d_correlator_outs.begin(), d_n_correlator_taps, gr_complex(0.0, 0.0));
 
     d_carrier_lock_fail_counter = 0;
@@ -1020,8 +1034,15 @@ bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_
 // - updated remnant code phase in samples (d_rem_code_phase_samples)
 // - d_code_freq_chips
 // - d_carrier_doppler_hz
-void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
+void dll_pll_veml_tracking::do_correlation_step(const void *input_items)
 {
+    const gr_complex *input_samples = reinterpret_cast<const gr_complex *>(input_items);
+    if (d_input_converter)
+        {
+            d_input_converter(d_input_samples.data(), input_items, static_cast<uint32_t>(d_trk_parameters.vector_length));
+            input_samples = d_input_samples.data();
+        }
+
     // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
     // perform carrier wipe-off and compute Early, Prompt and Late correlation
     d_multicorrelator_cpu.set_input_output_vectors(d_correlator_outs.data(), input_samples);
@@ -1410,7 +1431,7 @@ void dll_pll_veml_tracking::log_data()
                     d_dump_file.write(reinterpret_cast<char *>(&prompt_I), sizeof(float));
                     d_dump_file.write(reinterpret_cast<char *>(&prompt_Q), sizeof(float));
                     // PRN start sample stamp
-                    tmp_long_int = this->nitems_read(0) + static_cast<uint64_t>(d_current_prn_length_samples);
+                    tmp_long_int = d_sample_counter + static_cast<uint64_t>(d_current_prn_length_samples);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_long_int), sizeof(uint64_t));
                     // accumulated carrier phase
                     tmp_float = static_cast<float>(d_acc_carrier_phase_rad);
@@ -1444,7 +1465,7 @@ void dll_pll_veml_tracking::log_data()
                     // AUX vars (for debug purposes)
                     tmp_float = static_cast<float>(d_rem_code_phase_samples);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_double = static_cast<double>(this->nitems_read(0) + d_current_prn_length_samples);
+                    tmp_double = static_cast<double>(d_sample_counter + d_current_prn_length_samples);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
                     // PRN
                     uint32_t prn_ = d_acquisition_gnss_synchro->PRN;
@@ -1696,6 +1717,31 @@ void dll_pll_veml_tracking::set_gnss_synchro(Gnss_Synchro *p_gnss_synchro)
 }
 
 
+void dll_pll_veml_tracking::set_symbol_decoder(std::function<bool(Gnss_Synchro &)> decoder, const gr::basic_block_sptr &decoder_block)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_symbol_decoder = std::move(decoder);
+
+    const pmt::pmt_t decoder_ports = decoder_block->message_ports_out();
+    for (size_t i = 0; i < pmt::length(decoder_ports); i++)
+        {
+            const pmt::pmt_t port = pmt::vector_ref(decoder_ports, i);
+            if (pmt::eqv(port, pmt::mp("telemetry_to_trk")))
+                {
+                    decoder_block->message_port_sub(port, pmt::cons(this->alias_pmt(), port));
+                    continue;
+                }
+            // Messages reach this block through an input port, and its
+            // scheduler thread publishes them again
+            const pmt::pmt_t forward_port = pmt::mp("fused_" + pmt::symbol_to_string(port));
+            this->message_port_register_out(port);
+            this->message_port_register_in(forward_port);
+            this->set_msg_handler(forward_port, [this, port](const pmt::pmt_t &msg) { this->message_port_pub(port, msg); });
+            decoder_block->message_port_sub(port, pmt::cons(this->alias_pmt(), forward_port));
+        }
+}
+
+
 void dll_pll_veml_tracking::stop_tracking()
 {
     gr::thread::scoped_lock l(d_setlock);
@@ -1711,20 +1757,15 @@ int64_t dll_pll_veml_tracking::uint64diff(uint64_t first, uint64_t second)
 }
 
 
-int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items,
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+bool dll_pll_veml_tracking::track_epoch(const void *in, int32_t available_samples, uint64_t output_item, Gnss_Synchro &output, int32_t &consumed_samples)
 {
-    gr::thread::scoped_lock l(d_setlock);
-    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
     Gnss_Synchro current_synchro_data = Gnss_Synchro();
     current_synchro_data.Flag_valid_symbol_output = false;
     bool loss_of_lock = false;
 
     if (d_pull_in_transitory == true)
         {
-            // if (d_trk_parameters.pull_in_time_s < (d_sample_counter - d_acq_sample_stamp) / static_cast<int>(d_trk_parameters.fs_in))
-            if (d_trk_parameters.pull_in_time_s < (this->nitems_read(0) - d_acq_sample_stamp) / static_cast<int>(d_trk_parameters.fs_in))
+            if (d_trk_parameters.pull_in_time_s < (d_sample_counter - d_acq_sample_stamp) / static_cast<int>(d_trk_parameters.fs_in))
                 {
                     d_pull_in_transitory = false;
                     d_carrier_lock_fail_counter = 0;
@@ -1735,16 +1776,13 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
         {
         case 0:  // Standby - Consume samples at full throttle, do nothing
             {
-                // d_sample_counter += static_cast<uint64_t>(ninput_items[0]);
-                consume_each(ninput_items[0]);
-                return 0;
-                break;
+                consumed_samples = available_samples;
+                return false;
             }
         case 1:  // Pull-in
             {
                 // Signal alignment (skip samples until the incoming signal is aligned with local replica)
-                // const int64_t acq_trk_diff_samples = static_cast<int64_t>(d_sample_counter) - static_cast<int64_t>(d_acq_sample_stamp);
-                const int64_t acq_trk_diff_samples = static_cast<int64_t>(this->nitems_read(0)) - static_cast<int64_t>(d_acq_sample_stamp);
+                const int64_t acq_trk_diff_samples = static_cast<int64_t>(d_sample_counter) - static_cast<int64_t>(d_acq_sample_stamp);
                 const double acq_trk_diff_seconds = static_cast<double>(acq_trk_diff_samples) / d_trk_parameters.fs_in;
                 const double delta_trk_to_acq_prn_start_samples = static_cast<double>(acq_trk_diff_samples) - d_acq_code_phase_samples;
 
@@ -1761,7 +1799,6 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 const int32_t samples_offset = round(d_acq_code_phase_samples);
                 d_acc_carrier_phase_rad -= d_carrier_phase_step_rad * static_cast<double>(samples_offset);
                 d_state = 2;
-                // d_sample_counter += samples_offset;  // count for the processed samples
                 d_cn0_smoother.reset();
                 d_carrier_lock_test_smoother.reset();
 
@@ -1769,8 +1806,8 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 DLOG(INFO) << "PULL-IN Doppler [Hz] = " << d_carrier_doppler_hz
                            << ". PULL-IN Code Phase [samples] = " << d_acq_code_phase_samples;
 
-                consume_each(samples_offset);  // shift input to perform alignment with local replica
-                return 0;
+                consumed_samples = samples_offset;  // shift input to perform alignment with local replica
+                return false;
             }
         case 2:  // Wide tracking and symbol synchronization
             {
@@ -1792,8 +1829,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 //    }
 
                 // fail-safe: check if the secondary code or bit synchronization has not succeeded in a limited time period
-                // if (d_trk_parameters.bit_synchronization_time_limit_s < (d_sample_counter - d_acq_sample_stamp) / static_cast<int>(d_trk_parameters.fs_in))
-                if (d_trk_parameters.bit_synchronization_time_limit_s < (this->nitems_read(0) - d_acq_sample_stamp) / static_cast<int>(d_trk_parameters.fs_in))
+                if (d_trk_parameters.bit_synchronization_time_limit_s < (d_sample_counter - d_acq_sample_stamp) / static_cast<int>(d_trk_parameters.fs_in))
                     {
                         d_carrier_lock_fail_counter = 300000;  // force loss-of-lock condition
                         LOG(INFO) << d_systemName << " " << d_signal_pretty_name << " tracking synchronization time limit reached in channel " << d_channel
@@ -2015,7 +2051,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
 
     // time tags
     std::vector<gr::tag_t> tags_vec;
-    this->get_tags_in_range(tags_vec, 0, this->nitems_read(0), this->nitems_read(0) + d_current_prn_length_samples);
+    this->get_tags_in_range(tags_vec, 0, d_sample_counter, d_sample_counter + d_current_prn_length_samples);
     for (const auto &it : tags_vec)
         {
             try
@@ -2044,15 +2080,18 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 }
         }
 
-    consume_each(d_current_prn_length_samples);
-    // d_sample_counter += static_cast<uint64_t>(d_current_prn_length_samples);
+    consumed_samples = d_current_prn_length_samples;
     if (current_synchro_data.Flag_valid_symbol_output || loss_of_lock)
         {
             current_synchro_data.fs = static_cast<int64_t>(d_trk_parameters.fs_in);
-            current_synchro_data.Tracking_sample_counter = this->nitems_read(0);
+            current_synchro_data.Tracking_sample_counter = d_sample_counter + static_cast<uint64_t>(d_current_prn_length_samples);
             current_synchro_data.Flag_valid_symbol_output = !loss_of_lock;
             current_synchro_data.Flag_PLL_180_deg_phase_locked = d_Flag_PLL_180_deg_phase_locked;
-            *out[0] = current_synchro_data;
+            output = current_synchro_data;
+            if (d_symbol_decoder and !d_symbol_decoder(output))
+                {
+                    return false;  // held back by the telemetry decoder, the time tag goes with the next item
+                }
 
             // generate new tag associated with gnss-synchro object
 
@@ -2068,13 +2107,51 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                     tmp_obj->tow_ms = d_last_timetag.tow_ms + static_cast<int>(intpart);
                     tmp_obj->tow_ms_fraction = d_last_timetag.tow_ms_fraction;
                     tmp_obj->rx_time = static_cast<double>(current_synchro_data.Tracking_sample_counter) / d_trk_parameters.fs_in;
-                    add_item_tag(0, this->nitems_written(0) + 1, pmt::mp("timetag"), pmt::make_any(tmp_obj));
+                    add_item_tag(0, output_item + 1, pmt::mp("timetag"), pmt::make_any(tmp_obj));
 
                     // std::cout << "[" << this->nitems_written(0) + 1 << "][diff_time: " << 1000.0 * static_cast<double>(diff_samplecount) / d_trk_parameters.fs_in << "] Sent TimeTag Week: " << d_last_timetag.week << ", TOW: " << d_last_timetag.tow_ms << " [ms], TOW fraction: " << d_last_timetag.tow_ms_fraction << " [ms] \n";
                     d_timetag_waiting = false;
                 }
 
-            return 1;
+            return true;
         }
-    return 0;
+    return false;
+}
+
+
+int dll_pll_veml_tracking::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    const auto *in = reinterpret_cast<const uint8_t *>(input_items[0]);
+    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);
+    const auto min_input_samples = static_cast<int32_t>(d_trk_parameters.vector_length) * 2;
+
+    // Process several integration periods per call, as long as the input
+    // holds as many samples as forecast() requires for each of them
+    d_sample_counter = this->nitems_read(0);
+    int32_t consumed_samples = 0;
+    int32_t produced_items = 0;
+    for (uint32_t epoch = 0; epoch < d_trk_parameters.max_batch_epochs; epoch++)
+        {
+            if (produced_items == noutput_items or (epoch > 0 and ninput_items[0] - consumed_samples < min_input_samples))
+                {
+                    break;
+                }
+            const int32_t state = d_state;
+            int32_t epoch_samples = 0;
+            if (track_epoch(in + static_cast<size_t>(consumed_samples) * d_item_size, ninput_items[0] - consumed_samples,
+                    this->nitems_written(0) + produced_items, out[produced_items], epoch_samples))
+                {
+                    produced_items++;
+                }
+            consumed_samples += epoch_samples;
+            d_sample_counter += static_cast<uint64_t>(epoch_samples);
+            if (state < 2)
+                {
+                    break;  // standby and pull-in do not produce outputs
+                }
+        }
+    consume_each(consumed_samples);
+    return produced_items;
 }
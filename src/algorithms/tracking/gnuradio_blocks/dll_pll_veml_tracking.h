@@ -18,11 +18,13 @@
 #ifndef GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 #define GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 
+#include "code_replica_store.h"
 #include "cpu_multicorrelator_real_codes.h"
 #include "dll_pll_conf.h"
 #include "exponential_smoother.h"
 #include "gnss_block_interface.h"
 #include "gnss_time.h"                // for timetags produced by File_Timestamp_Signal_Source
+#include "item_type_helpers.h"        // for item_type_converter_t
 #include "tracking_FLL_PLL_filter.h"  // for PLL/FLL filter
 #include "tracking_loop_filter.h"     // for DLL filter
 #include <boost/circular_buffer.hpp>
@@ -34,6 +36,7 @@
 #include <cstddef>                            // for size_t
 #include <cstdint>                            // for int32_t
 #include <fstream>                            // for ofstream
+#include <functional>                         // for function
 #include <string>                             // for string
 #include <typeinfo>                           // for typeid
 #include <utility>                            // for pair
@@ -63,6 +66,13 @@ public:
     void set_channel(uint32_t channel);
     void set_gnss_synchro(Gnss_Synchro *p_gnss_synchro);
     void start_tracking();
+
+    /*!
+     * \brief Runs a telemetry decoder on each output item (fused channel).
+     * The output messages of the decoder block, which is not part of the
+     * flowgraph, are published by this block on ports with the same names.
+     */
+    void set_symbol_decoder(std::function<bool(Gnss_Synchro &)> decoder, const gr::basic_block_sptr &decoder_block);
     void stop_tracking();
 
     int general_work(int noutput_items, gr_vector_int &ninput_items,
@@ -75,7 +85,8 @@ private:
     explicit dll_pll_veml_tracking(const Dll_Pll_Conf &conf_);
 
     void msg_handler_telemetry_to_trk(const pmt::pmt_t &msg);
-    void do_correlation_step(const gr_complex *input_samples);
+    bool track_epoch(const void *in, int32_t available_samples, uint64_t output_item, Gnss_Synchro &output, int32_t &consumed_samples);
+    void do_correlation_step(const void *input_items);
     void run_dll_pll();
     void check_carrier_phase_coherent_initialization();
     void update_tracking_vars();
@@ -86,6 +97,7 @@ private:
     bool acquire_secondary();
     int64_t uint64diff(uint64_t first, uint64_t second);
     int32_t save_matfile() const;
+    Code_Replica_Store::Replica_Ptr get_code_replica(const std::string &component, const Code_Replica_Store::Generator &generator) const;
 
     Cpu_Multicorrelator_Real_Codes d_multicorrelator_cpu;
     Cpu_Multicorrelator_Real_Codes d_correlator_data_cpu;  // for data channel
@@ -100,12 +112,17 @@ private:
 
     Gnss_Synchro *d_acquisition_gnss_synchro;
 
-    volk_gnsssdr::vector<float> d_tracking_code;
-    volk_gnsssdr::vector<float> d_data_code;
+    std::function<bool(Gnss_Synchro &)> d_symbol_decoder;  // empty unless the channel is fused
+
+    item_type_converter_t d_input_converter;  // empty if the input is already gr_complex
+
+    Code_Replica_Store::Replica_Ptr d_tracking_code;  // shared with other channels, read-only
+    Code_Replica_Store::Replica_Ptr d_data_code;
     volk_gnsssdr::vector<float> d_local_code_shift_chips;
     volk_gnsssdr::vector<gr_complex> d_correlator_outs;
     volk_gnsssdr::vector<gr_complex> d_Prompt_Data;
     volk_gnsssdr::vector<gr_complex> d_Prompt_buffer;
+    volk_gnsssdr::vector<gr_complex> d_input_samples;  // cshort or cbyte input converted to gr_complex
 
     boost::circular_buffer<float> d_dll_filt_history;
     boost::circular_buffer<std::pair<double, double>> d_code_ph_history;
@@ -165,7 +182,8 @@ private:
 
     std::ofstream d_dump_file;
 
-    // uint64_t d_sample_counter;
+    size_t d_item_size;
+    uint64_t d_sample_counter;  // first sample of the current integration period
     uint64_t d_acq_sample_stamp;
     GnssTime d_last_timetag{};
     uint64_t d_last_timetag_samplecounter;
@@ -43,6 +43,7 @@
 #include "lock_detectors.h"
 #include "tracking_discriminators.h"
 #include "trackingcmd.h"
+#include "vtl_engine.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>   // for io_signature
 #include <gnuradio/thread/thread.h>  // for scoped_lock
@@ -71,6 +72,12 @@ namespace wht = boost;
 namespace wht = std;
 #endif
 
+namespace
+{
+// Vector tracking falls back to the channel filter if no commands arrive
+constexpr double VTL_COMMAND_TIMEOUT_S = 1.0;
+}  // namespace
+
 kf_vtl_tracking_sptr kf_vtl_make_tracking(const Kf_Conf &conf_)
 {
     return kf_vtl_tracking_sptr(new kf_vtl_tracking(conf_));
@@ -83,6 +90,7 @@ kf_vtl_tracking::kf_vtl_tracking(const Kf_Conf &conf_)
           gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
       d_trk_parameters(conf_),
       d_acquisition_gnss_synchro(nullptr),
+      d_vtl_engine(d_trk_parameters.vector_tracking ? &Vtl_Engine::instance() : nullptr),
       d_signal_type(d_trk_parameters.signal),
       d_code_chip_rate(0.0),
       d_acq_code_phase_samples(0.0),
@@ -103,6 +111,10 @@ kf_vtl_tracking::kf_vtl_tracking(const Kf_Conf &conf_)
       d_carrier_lock_test(1.0),
       d_CN0_SNV_dB_Hz(0.0),
       d_carrier_lock_threshold(d_trk_parameters.carrier_lock_th),
+      d_vtl_cmd_doppler_hz(0.0),
+      d_vtl_cmd_code_freq_chips_s(0.0),
+      d_vtl_carrier_offset_hz(0.0),
+      d_vtl_prev_phase_error_cycles(0.0),
       d_carrier_phase_step_rad(0.0),
       d_carrier_phase_rate_step_rad(0.0),
       d_code_phase_step_chips(0.0),
@@ -111,10 +123,12 @@ kf_vtl_tracking::kf_vtl_tracking(const Kf_Conf &conf_)
       d_rem_code_phase_samples(0.0),
       d_sample_counter(0ULL),
       d_acq_sample_stamp(0ULL),
+      d_vtl_cmd_sample_counter(0ULL),
       d_rem_carr_phase_rad(0.0),
       d_channel(0U),
       d_secondary_code_length(0U),
       d_data_secondary_code_length(0U),
+      d_vtl_cmd_version(0U),
       d_state(0),
       d_current_prn_length_samples(static_cast<int32_t>(d_trk_parameters.vector_length)),
       d_extend_correlation_symbols_count(0),
@@ -128,7 +142,8 @@ kf_vtl_tracking::kf_vtl_tracking(const Kf_Conf &conf_)
       d_cloop(true),
       d_dump(d_trk_parameters.dump),
       d_dump_mat(d_trk_parameters.dump_mat && d_dump),
-      d_acc_carrier_phase_initialized(false)
+      d_acc_carrier_phase_initialized(false),
+      d_vtl_active(false)
 {
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
@@ -835,6 +850,7 @@ void kf_vtl_tracking::start_tracking()
     d_Prompt_circular_buffer.clear();
     d_corrected_doppler = false;
     d_acc_carrier_phase_initialized = false;
+    release_vector_tracking();
 }
 
 
@@ -1125,7 +1141,7 @@ void kf_vtl_tracking::do_correlation_step(const gr_complex *input_samples)
 }
 
 
-void kf_vtl_tracking::run_Kf()
+void kf_vtl_tracking::compute_discriminators()
 {
     // Carrier discriminator
     if (d_cloop)
@@ -1148,6 +1164,12 @@ void kf_vtl_tracking::run_Kf()
         {
             d_code_error_disc_chips = dll_nc_e_minus_l_normalized(d_E_accu, d_L_accu, d_trk_parameters.spc, d_trk_parameters.slope, d_trk_parameters.y_intercept);  // [chips/Ti]
         }
+}
+
+
+void kf_vtl_tracking::run_Kf()
+{
+    compute_discriminators();
 
     // Kalman loop
 
@@ -1208,6 +1230,94 @@ void kf_vtl_tracking::run_Kf()
 }
 
 
+void kf_vtl_tracking::run_vector_tracking(double coh_integration_time_s, bool allow_vector_mode)
+{
+    const auto channel = static_cast<int32_t>(d_channel);
+    Vtl_Engine::Channel_Measurement measurement{};
+    measurement.sample_counter = d_sample_counter;
+    measurement.fs = d_trk_parameters.fs_in;
+    measurement.carrier_freq_hz = d_signal_carrier_freq;
+    measurement.code_chip_rate = d_code_chip_rate;
+    measurement.carrier_doppler_hz = d_carrier_doppler_kf_hz;
+    measurement.cn0_db_hz = d_CN0_SNV_dB_Hz;
+    measurement.satellite = Vtl_Engine::satellite_id(d_acquisition_gnss_synchro->System, d_acquisition_gnss_synchro->PRN);
+    measurement.vector_mode = d_vtl_active;
+    double phase_error_rad = 0.0;
+    if (d_vtl_active)
+        {
+            // frequency error from the change of the carrier phase error
+            const double ambiguity_cycles = d_cloop ? 0.5 : 1.0;
+            double phase_change_cycles = d_carr_phase_error_disc_hz - d_vtl_prev_phase_error_cycles;
+            phase_change_cycles -= ambiguity_cycles * std::round(phase_change_cycles / ambiguity_cycles);
+            d_vtl_prev_phase_error_cycles = d_carr_phase_error_disc_hz;
+            measurement.carrier_freq_error_hz = phase_change_cycles / coh_integration_time_s;
+            measurement.code_error_chips = d_code_error_disc_chips;
+            phase_error_rad = d_carr_phase_error_disc_hz * TWO_PI;
+        }
+    d_vtl_engine->post_measurement(channel, measurement);
+    d_vtl_engine->update(d_sample_counter);
+
+    TrackingCmd cmd;
+    const uint32_t version = d_vtl_engine->read_command(channel, cmd);
+    if (version != 0 and version != d_vtl_cmd_version and cmd.sample_counter >= d_acq_sample_stamp)
+        {
+            d_vtl_cmd_version = version;
+            d_vtl_cmd_sample_counter = cmd.sample_counter;
+            if (d_vtl_active)
+                {
+                    // the replica follows the range correction of the engine
+                    d_rem_code_phase_samples += d_trk_parameters.fs_in * cmd.code_phase_correction_chips / d_code_freq_kf_chips_s;
+                }
+            else if (allow_vector_mode)
+                {
+                    // the local carrier loop keeps the Doppler difference
+                    d_vtl_carrier_offset_hz = d_carrier_doppler_kf_hz - cmd.carrier_freq_hz;
+                    d_vtl_prev_phase_error_cycles = d_carr_phase_error_disc_hz;
+                    d_vtl_active = true;
+                    LOG(INFO) << "Vector tracking enabled in channel " << d_channel
+                              << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN);
+                }
+            d_vtl_cmd_doppler_hz = cmd.carrier_freq_hz;
+            d_vtl_cmd_code_freq_chips_s = cmd.code_freq_chips;
+        }
+    if (!d_vtl_active)
+        {
+            return;
+        }
+
+    if (d_sample_counter > d_vtl_cmd_sample_counter and
+        static_cast<double>(d_sample_counter - d_vtl_cmd_sample_counter) > VTL_COMMAND_TIMEOUT_S * d_trk_parameters.fs_in)
+        {
+            LOG(INFO) << "No vector tracking commands for channel " << d_channel << ". Back to its own Kalman filter";
+            d_vtl_active = false;
+            init_kf(0.0, d_carrier_doppler_kf_hz);
+            if (d_enable_extended_integration)
+                {
+                    update_kf_narrow_integration_time();
+                }
+            return;
+        }
+
+    // second order carrier loop around the Doppler commanded by the engine
+    const double wn = d_trk_parameters.vtl_pll_bw_hz / 0.53;
+    d_vtl_carrier_offset_hz += wn * wn * coh_integration_time_s * phase_error_rad / TWO_PI;
+    d_rem_carr_phase_rad += static_cast<float>(1.414 * wn * coh_integration_time_s * phase_error_rad);
+    d_carrier_doppler_kf_hz = d_vtl_cmd_doppler_hz + d_vtl_carrier_offset_hz;
+    d_carrier_doppler_rate_kf_hz_s = 0.0;
+    d_code_freq_kf_chips_s = d_vtl_cmd_code_freq_chips_s + d_vtl_carrier_offset_hz * d_code_chip_rate / d_signal_carrier_freq;
+}
+
+
+void kf_vtl_tracking::release_vector_tracking()
+{
+    d_vtl_active = false;
+    if (d_vtl_engine != nullptr)
+        {
+            d_vtl_engine->release_channel(static_cast<int32_t>(d_channel));
+        }
+}
+
+
 void kf_vtl_tracking::check_carrier_phase_coherent_initialization()
 {
     if (d_acc_carrier_phase_initialized == false)
@@ -1709,6 +1819,10 @@ void kf_vtl_tracking::set_channel(uint32_t channel)
     gr::thread::scoped_lock l(d_setlock);
     d_channel = channel;
     LOG(INFO) << "Tracking Channel set to " << d_channel;
+    if (d_vtl_engine != nullptr)
+        {
+            d_vtl_engine->register_channel(static_cast<int32_t>(d_channel));
+        }
     // ############# ENABLE DATA FILE LOG #################
     if (d_dump)
         {
@@ -1746,6 +1860,7 @@ void kf_vtl_tracking::stop_tracking()
 {
     gr::thread::scoped_lock l(d_setlock);
     d_state = 0;
+    release_vector_tracking();
 }
 
 
@@ -1850,6 +1965,7 @@ int kf_vtl_tracking::general_work(int noutput_items __attribute__((unused)), gr_
                 if (!cn0_and_tracking_lock_status(d_code_period))
                     {
                         clear_tracking_vars();
+                        release_vector_tracking();
                         d_state = 0;  // loss-of-lock detected
                     }
                 else
@@ -1857,6 +1973,11 @@ int kf_vtl_tracking::general_work(int noutput_items __attribute__((unused)), gr_
                         bool next_state = false;
                         // Perform DLL/PLL tracking loop computations. Costas Loop enabled
                         run_Kf();
+                        if (d_vtl_engine != nullptr)
+                            {
+                                // contributes its Doppler to the engine until synchronized
+                                run_vector_tracking(d_code_period, false);
+                            }
                         update_tracking_vars();
 
                         // enable write dump file this cycle (valid DLL/PLL cycle)
@@ -2007,6 +2128,7 @@ int kf_vtl_tracking::general_work(int noutput_items __attribute__((unused)), gr_
                 if (!cn0_and_tracking_lock_status(d_code_period * static_cast<double>(d_trk_parameters.extend_correlation_symbols)))
                     {
                         clear_tracking_vars();
+                        release_vector_tracking();
                         d_state = 0;  // loss-of-lock detected
                     }
                 else
@@ -2018,7 +2140,19 @@ int kf_vtl_tracking::general_work(int noutput_items __attribute__((unused)), gr_
                                         update_kf_cn0(d_CN0_SNV_dB_Hz);
                                     }
                             }
-                        run_Kf();
+                        if (d_vtl_active)
+                            {
+                                // the vector tracking engine replaces the channel Kalman filter
+                                compute_discriminators();
+                            }
+                        else
+                            {
+                                run_Kf();
+                            }
+                        if (d_vtl_engine != nullptr)
+                            {
+                                run_vector_tracking(d_code_period * static_cast<double>(d_trk_parameters.extend_correlation_symbols), !d_pull_in_transitory);
+                            }
                         update_tracking_vars();
                         check_carrier_phase_coherent_initialization();
                         if (d_current_data_symbol == 0)
@@ -48,6 +48,7 @@
 #include <utility>   // for pair
 
 class Gnss_Synchro;
+class Vtl_Engine;
 class kf_vtl_tracking;
 
 using kf_vtl_tracking_sptr = gnss_shared_ptr<kf_vtl_tracking>;
@@ -80,6 +81,9 @@ private:
     void update_kf_narrow_integration_time();
     void update_kf_cn0(double current_cn0_dbhz);
     void run_Kf();
+    void compute_discriminators();
+    void run_vector_tracking(double coh_integration_time_s, bool allow_vector_mode);
+    void release_vector_tracking();
 
     void msg_handler_telemetry_to_trk(const pmt::pmt_t &msg);
     void msg_handler_pvt_to_trk(const pmt::pmt_t &msg);
@@ -103,6 +107,7 @@ private:
     Exponential_Smoother d_carrier_lock_test_smoother;
 
     Gnss_Synchro *d_acquisition_gnss_synchro;
+    Vtl_Engine *d_vtl_engine;  // nullptr if vector tracking is disabled
 
     volk_gnsssdr::vector<float> d_tracking_code;
     volk_gnsssdr::vector<float> d_data_code;
@@ -183,6 +188,12 @@ private:
     double d_CN0_SNV_dB_Hz;
     double d_carrier_lock_threshold;
 
+    // vector tracking: last engine command and local carrier loop
+    double d_vtl_cmd_doppler_hz;
+    double d_vtl_cmd_code_freq_chips_s;
+    double d_vtl_carrier_offset_hz;
+    double d_vtl_prev_phase_error_cycles;
+
     // carrier NCO
     double d_carrier_phase_step_rad;
     double d_carrier_phase_rate_step_rad;
@@ -195,6 +206,7 @@ private:
 
     uint64_t d_sample_counter;
     uint64_t d_acq_sample_stamp;
+    uint64_t d_vtl_cmd_sample_counter;
 
     float *d_prompt_data_shift;
     float d_rem_carr_phase_rad;
@@ -202,6 +214,7 @@ private:
     uint32_t d_channel;
     uint32_t d_secondary_code_length;
     uint32_t d_data_secondary_code_length;
+    uint32_t d_vtl_cmd_version;
 
     int32_t d_symbols_per_bit;
     int32_t d_state;
@@ -226,6 +239,7 @@ private:
     bool d_dump;
     bool d_dump_mat;
     bool d_acc_carrier_phase_initialized;
+    bool d_vtl_active;  // NCOs driven by the vector tracking engine
     bool d_enable_extended_integration;
 };
 
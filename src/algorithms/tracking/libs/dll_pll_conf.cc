@@ -111,6 +111,12 @@ void Dll_Pll_Conf::SetFromConfiguration(const ConfigurationInterface *configurat
     max_carrier_lock_fail = configuration->property(role + ".max_carrier_lock_fail", max_carrier_lock_fail);
     carrier_lock_th = configuration->property(role + ".carrier_lock_th", carrier_lock_th);
     carrier_aiding = configuration->property(role + ".carrier_aiding", carrier_aiding);
+    max_batch_epochs = configuration->property(role + ".max_batch_epochs", max_batch_epochs);
+    if (max_batch_epochs < 1)
+        {
+            max_batch_epochs = 1;
+            LOG(WARNING) << "max_batch_epochs must be bigger than 0. It has been set to 1";
+        }
 
     // tracking lock tests smoother parameters
     cn0_smoother_samples = configuration->property(role + ".cn0_smoother_samples", cn0_smoother_samples);
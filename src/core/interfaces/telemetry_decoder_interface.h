@@ -25,6 +25,8 @@
 
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
+#include "gnss_synchro.h"
+#include <functional>
 
 /** \addtogroup Core
  * \{ */
@@ -46,6 +48,17 @@ public:
     virtual void reset() = 0;
     virtual void set_satellite(const Gnss_Satellite& sat) = 0;
     virtual void set_channel(int channel) = 0;
+
+    /*!
+     * \brief Returns a function that decodes one symbol in place, to be
+     * called by the tracking block of a fused channel. The function returns
+     * true if the symbol has to be delivered downstream. It is empty if the
+     * implementation cannot be fused.
+     */
+    virtual std::function<bool(Gnss_Synchro&)> get_symbol_decoder()
+    {
+        return nullptr;
+    }
 };
 
 
@@ -25,6 +25,7 @@
 
 #include "gnss_block_interface.h"
 #include "gnss_synchro.h"
+#include <functional>
 
 /** \addtogroup Core
  * \{ */
@@ -51,6 +52,17 @@ public:
     virtual void stop_tracking() = 0;
     virtual void set_gnss_synchro(Gnss_Synchro* gnss_synchro) = 0;
     virtual void set_channel(unsigned int channel) = 0;
+
+    /*!
+     * \brief Hands each output item over to a telemetry decoder that runs
+     * in the tracking block (fused channel), and forwards the output messages
+     * of the decoder block. Returns false if the implementation cannot be
+     * fused.
+     */
+    virtual bool set_symbol_decoder(std::function<bool(Gnss_Synchro&)> /* decoder */, gr::basic_block_sptr /* decoder_block */)
+    {
+        return false;
+    }
 };
 
 
@@ -101,3 +101,15 @@ bool INIReader::HasValue(const std::string& section, const std::string& name) co
     std::string key = MakeKey(section, name);
     return _values.count(key);
 }
+
+
+std::map<std::string, std::string> INIReader::GetSection(const std::string& section) const
+{
+    std::map<std::string, std::string> values;
+    const std::string key = MakeKey(section, "");
+    for (auto pos = _values.lower_bound(key); pos != _values.end() and pos->first.compare(0, key.length(), key) == 0; ++pos)
+        {
+            values.emplace(pos->first.substr(key.length()), pos->second);
+        }
+    return values;
+}
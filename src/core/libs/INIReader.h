@@ -64,6 +64,9 @@ public:
     //! Return true if a value exists with the given section and field names.
     bool HasValue(const std::string& section, const std::string& name) const;
 
+    //! Return all the name/value pairs of the given section. Names are in lower case.
+    std::map<std::string, std::string> GetSection(const std::string& section) const;
+
 private:
     static std::string MakeKey(const std::string& section, const std::string& name);
     static int ValueHandler(void* user, const char* section, const char* name,
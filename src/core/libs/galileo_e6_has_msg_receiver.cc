@@ -75,8 +75,8 @@ galileo_e6_has_msg_receiver::galileo_e6_has_msg_receiver() : gr::block("galileo_
     d_rs = std::make_unique<ReedSolomon>();
 
     // Reserve memory for decoding matrices and received PIDs
-    d_C_matrix = std::vector<std::vector<std::vector<uint8_t>>>(GALILEO_CNAV_INFORMATION_VECTOR_LENGTH, std::vector<std::vector<uint8_t>>(GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE)));  // 32 x 255 x 53
-    d_M_matrix = std::vector<std::vector<uint8_t>>(GALILEO_CNAV_INFORMATION_VECTOR_LENGTH, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE));                                                                                                 // HAS message matrix 32 x 53
+    d_C_matrix = std::vector<std::vector<uint8_t>>(GALILEO_CNAV_INFORMATION_VECTOR_LENGTH, std::vector<uint8_t>(GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK * GALILEO_CNAV_OCTETS_IN_SUBPAGE));  // 32 x (255 x 53)
+    d_M_matrix = std::vector<uint8_t>(GALILEO_CNAV_INFORMATION_VECTOR_LENGTH * GALILEO_CNAV_OCTETS_IN_SUBPAGE);                                                                                   // HAS message matrix 32 x 53
     d_received_pids = std::vector<std::vector<uint8_t>>(HAS_MSG_NUMBER_MESSAGE_IDS, std::vector<uint8_t>());
 
     // Reserve memory to store masks
@@ -166,7 +166,7 @@ void galileo_e6_has_msg_receiver::process_HAS_page(const Galileo_HAS_page& has_p
                                                     constexpr int bits_in_octet = 8;
                                                     std::string bits8 = page_string.substr(k * bits_in_octet, bits_in_octet);
                                                     std::bitset<bits_in_octet> bs(bits8);
-                                                    d_C_matrix[has_page.message_id][has_page.message_page_id - 1][k] = static_cast<uint8_t>(bs.to_ulong());
+                                                    d_C_matrix[has_page.message_id][(has_page.message_page_id - 1) * GALILEO_CNAV_OCTETS_IN_SUBPAGE + k] = static_cast<uint8_t>(bs.to_ulong());
                                                 }
                                         }
                                 }
@@ -234,45 +234,31 @@ int galileo_e6_has_msg_receiver::decode_message_type1(uint8_t message_id, uint8_
             msg += ss.str();
             LOG(ERROR) << msg;
             d_received_pids[message_id].clear();
-            d_C_matrix[message_id] = {GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE)};
+            std::fill(d_C_matrix[message_id].begin(), d_C_matrix[message_id].end(), 0);
             return -1;
         }
 
     DLOG(INFO) << debug_print_vector("List of received PIDs", d_received_pids[message_id]);
     DLOG(INFO) << debug_print_vector("erasure_positions", erasure_positions);
-    DLOG(INFO) << debug_print_matrix("C_matrix", d_C_matrix[message_id]);
+    DLOG(INFO) << debug_print_matrix("C_matrix", d_C_matrix[message_id], GALILEO_CNAV_OCTETS_IN_SUBPAGE);
 
-    // Reset HAS decoded message matrix
-    d_M_matrix = std::vector<std::vector<uint8_t>>(GALILEO_CNAV_INFORMATION_VECTOR_LENGTH, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE));
-
-    // Vertical decoding of d_C_matrix
-    for (int col = 0; col < GALILEO_CNAV_OCTETS_IN_SUBPAGE; col++)
+    // Vertical decoding of d_C_matrix. All the columns share the erasure
+    // positions, so they are decoded at once with the inverse of the received
+    // rows of the generator matrix. Pages are erasures, not errors: they come
+    // with a valid CRC.
+    int result = d_rs->decode_erasures(d_C_matrix[message_id], GALILEO_CNAV_OCTETS_IN_SUBPAGE, erasure_positions);
+    if (result < 0)
         {
-            std::vector<uint8_t> C_column(GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK);
-            for (auto pid : d_received_pids[message_id])
-                {
-                    C_column[pid - 1] = d_C_matrix[message_id][pid - 1][col];
-                }
-
-            int result = d_rs->decode(C_column, erasure_positions);
-
-            if (result < 0)
-                {
-                    DLOG(ERROR) << "Decoding of HAS page failed";
-                    return -1;
-                }
-
-            std::vector<uint8_t> M_column(C_column.begin(), C_column.begin() + GALILEO_CNAV_INFORMATION_VECTOR_LENGTH);
-            for (int i = 0; i < GALILEO_CNAV_INFORMATION_VECTOR_LENGTH; i++)
-                {
-                    d_M_matrix[i][col] = M_column[i];
-                }
-
-            DLOG(INFO) << debug_print_vector("C_column entering the decoder", C_column);
-            DLOG(INFO) << "Successful HAS page decoding";
+            DLOG(ERROR) << "Decoding of HAS page failed";
+            d_received_pids[message_id].clear();
+            std::fill(d_C_matrix[message_id].begin(), d_C_matrix[message_id].end(), 0);
+            return -1;
         }
+    DLOG(INFO) << "Successful HAS page decoding";
+
+    std::copy(d_C_matrix[message_id].begin(), d_C_matrix[message_id].begin() + d_M_matrix.size(), d_M_matrix.begin());
 
-    DLOG(INFO) << debug_print_matrix("M_matrix", d_M_matrix);
+    DLOG(INFO) << debug_print_matrix("M_matrix", d_M_matrix, GALILEO_CNAV_OCTETS_IN_SUBPAGE);
 
     // Form the decoded HAS message by reading rows of d_M_matrix
     std::string decoded_message_type_1;
@@ -281,7 +267,7 @@ int galileo_e6_has_msg_receiver::decode_message_type1(uint8_t message_id, uint8_
         {
             for (int col = 0; col < GALILEO_CNAV_OCTETS_IN_SUBPAGE; col++)
                 {
-                    std::bitset<8> bs(d_M_matrix[row][col]);
+                    std::bitset<8> bs(d_M_matrix[row * GALILEO_CNAV_OCTETS_IN_SUBPAGE + col]);
                     decoded_message_type_1 += bs.to_string();
                 }
         }
@@ -300,7 +286,7 @@ int galileo_e6_has_msg_receiver::decode_message_type1(uint8_t message_id, uint8_
         }
 
     // reset data for next decoding
-    d_C_matrix[message_id] = std::vector<std::vector<uint8_t>>(GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE));
+    std::fill(d_C_matrix[message_id].begin(), d_C_matrix[message_id].end(), 0);
     d_received_pids[message_id].clear();
 
     // Trigger HAS message content reading and fill the d_HAS_data object
@@ -961,3 +947,22 @@ std::string galileo_e6_has_msg_receiver::debug_print_matrix(const std::string& t
     msg += ss.str();
     return msg;
 }
+
+
+template <class T>
+std::string galileo_e6_has_msg_receiver::debug_print_matrix(const std::string& title, const std::vector<T>& mat, size_t columns) const
+{
+    std::string msg(title);
+    msg += ": \n";
+    std::stringstream ss;
+    for (size_t i = 0; i < mat.size(); i++)
+        {
+            ss << static_cast<float>(mat[i]) << ((i + 1) % columns == 0 ? '\n' : ' ');
+        }
+    if (mat.empty())
+        {
+            ss << '\n';
+        }
+    msg += ss.str();
+    return msg;
+}
@@ -84,13 +84,16 @@ private:
     template <class T>
     std::string debug_print_matrix(const std::string& title, const std::vector<std::vector<T>>& mat) const;  // only for debug purposes
 
+    template <class T>
+    std::string debug_print_matrix(const std::string& title, const std::vector<T>& mat, size_t columns) const;  // only for debug purposes
+
     std::unique_ptr<ReedSolomon> d_rs;
     Galileo_HAS_data d_HAS_data{};
     Nav_Message_Packet d_nav_msg_packet;
 
-    // Store decoding matrices and received PIDs
-    std::vector<std::vector<std::vector<uint8_t>>> d_C_matrix;
-    std::vector<std::vector<uint8_t>> d_M_matrix;
+    // Store decoding matrices (flat, row-major) and received PIDs
+    std::vector<std::vector<uint8_t>> d_C_matrix;
+    std::vector<uint8_t> d_M_matrix;
     std::vector<std::vector<uint8_t>> d_received_pids;
 
     // Store masks
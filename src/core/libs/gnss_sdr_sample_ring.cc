@@ -0,0 +1,141 @@
+/*!
+ * \file gnss_sdr_sample_ring.cc
+ * \brief Ring buffer that distributes the samples of a signal conditioner to
+ * many readers, each one with its own read cursor.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_sample_ring.h"
+#include <sys/mman.h>  // for mmap, munmap
+#include <algorithm>   // for std::min
+#include <cstring>     // for memcpy
+#include <stdexcept>   // for std::invalid_argument, std::runtime_error
+
+
+namespace
+{
+constexpr size_t HUGE_PAGE_BYTES = 2 * 1024 * 1024;
+}
+
+
+Gnss_Sdr_Sample_Ring::Gnss_Sdr_Sample_Ring(size_t item_size, size_t capacity_items) : d_item_size(item_size),
+                                                                                      d_capacity(capacity_items)
+{
+    if (d_item_size == 0 or d_capacity == 0)
+        {
+            throw std::invalid_argument("Gnss_Sdr_Sample_Ring: item size and capacity must be positive");
+        }
+    // Round up to whole huge pages, and use all of them
+    d_mapped_bytes = ((d_item_size * d_capacity + HUGE_PAGE_BYTES - 1) / HUGE_PAGE_BYTES) * HUGE_PAGE_BYTES;
+    d_capacity = d_mapped_bytes / d_item_size;
+
+    void* buffer = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    buffer = mmap(nullptr, d_mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    d_huge_pages = (buffer != MAP_FAILED);
+#endif
+    if (buffer == MAP_FAILED)
+        {
+            buffer = mmap(nullptr, d_mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        }
+    if (buffer == MAP_FAILED)
+        {
+            throw std::runtime_error("Gnss_Sdr_Sample_Ring: unable to allocate the sample buffer");
+        }
+#ifdef MADV_HUGEPAGE
+    if (!d_huge_pages)
+        {
+            // transparent huge pages, if enabled
+            madvise(buffer, d_mapped_bytes, MADV_HUGEPAGE);
+        }
+#endif
+    d_buffer = static_cast<uint8_t*>(buffer);
+}
+
+
+Gnss_Sdr_Sample_Ring::~Gnss_Sdr_Sample_Ring()
+{
+    munmap(d_buffer, d_mapped_bytes);
+}
+
+
+void Gnss_Sdr_Sample_Ring::write(const void* items, size_t nitems)
+{
+    const uint64_t first = d_written.load(std::memory_order_relaxed);
+    const auto* in = static_cast<const uint8_t*>(items);
+    size_t skipped = 0;
+    if (nitems > d_capacity)
+        {
+            // only the newest samples fit
+            skipped = nitems - d_capacity;
+        }
+
+    // Readers check d_writing_end to detect samples overwritten while they
+    // were copying them
+    d_writing_end.store(first + nitems, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    size_t remaining = nitems - skipped;
+    uint64_t index = first + skipped;
+    in += skipped * d_item_size;
+    while (remaining > 0)
+        {
+            const size_t slot = static_cast<size_t>(index % d_capacity);
+            const size_t chunk = std::min(remaining, d_capacity - slot);
+            std::memcpy(d_buffer + slot * d_item_size, in, chunk * d_item_size);
+            in += chunk * d_item_size;
+            index += chunk;
+            remaining -= chunk;
+        }
+    d_written.store(first + nitems, std::memory_order_release);
+
+    {
+        // Taking the lock avoids missing a reader that is about to wait
+        std::lock_guard<std::mutex> lk(d_mutex);
+    }
+    d_cond.notify_all();
+}
+
+
+bool Gnss_Sdr_Sample_Ring::read(uint64_t first, void* items, size_t nitems) const
+{
+    const uint64_t written_now = written();
+    if (written_now > d_capacity and first < written_now - d_capacity)
+        {
+            return false;
+        }
+    copy_out(first, static_cast<uint8_t*>(items), nitems);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t writing_end = d_writing_end.load(std::memory_order_relaxed);
+    return !(writing_end > d_capacity and first < writing_end - d_capacity);
+}
+
+
+bool Gnss_Sdr_Sample_Ring::wait_for(uint64_t first, std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lk(d_mutex);
+    return d_cond.wait_for(lk, timeout, [this, first] { return written() > first; });
+}
+
+
+void Gnss_Sdr_Sample_Ring::copy_out(uint64_t first, uint8_t* items, size_t nitems) const
+{
+    while (nitems > 0)
+        {
+            const size_t slot = static_cast<size_t>(first % d_capacity);
+            const size_t chunk = std::min(nitems, d_capacity - slot);
+            std::memcpy(items, d_buffer + slot * d_item_size, chunk * d_item_size);
+            items += chunk * d_item_size;
+            first += chunk;
+            nitems -= chunk;
+        }
+}
@@ -0,0 +1,102 @@
+/*!
+ * \file gnss_sdr_sample_ring.h
+ * \brief Ring buffer that distributes the samples of a signal conditioner to
+ * many readers, each one with its own read cursor.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_SAMPLE_RING_H
+#define GNSS_SDR_GNSS_SDR_SAMPLE_RING_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+
+/*!
+ * \brief Single writer, multiple reader ring of samples.
+ *
+ * The writer never waits for the readers: once the ring is full, new samples
+ * overwrite the oldest ones. Samples are addressed by their absolute index
+ * since the first write, so each reader keeps its own cursor and finds out by
+ * itself if it fell behind by more than the ring capacity.
+ *
+ * The memory is backed by huge pages when the system provides them.
+ */
+class Gnss_Sdr_Sample_Ring
+{
+public:
+    Gnss_Sdr_Sample_Ring(size_t item_size, size_t capacity_items);
+    ~Gnss_Sdr_Sample_Ring();
+
+    Gnss_Sdr_Sample_Ring(const Gnss_Sdr_Sample_Ring&) = delete;
+    Gnss_Sdr_Sample_Ring& operator=(const Gnss_Sdr_Sample_Ring&) = delete;
+
+    /*!
+     * \brief Appends nitems samples, overwriting the oldest ones if needed
+     */
+    void write(const void* items, size_t nitems);
+
+    /*!
+     * \brief Copies nitems samples, starting at the absolute index first.
+     * Returns false if some of them were overwritten before or during the copy.
+     * first + nitems must not be greater than written().
+     */
+    bool read(uint64_t first, void* items, size_t nitems) const;
+
+    /*!
+     * \brief Waits until the sample at index first is written, or the timeout
+     * expires. Returns true if the sample is available.
+     */
+    bool wait_for(uint64_t first, std::chrono::milliseconds timeout);
+
+    inline uint64_t written() const
+    {
+        return d_written.load(std::memory_order_acquire);
+    }
+
+    inline size_t capacity() const
+    {
+        return d_capacity;
+    }
+
+    inline bool huge_pages() const
+    {
+        return d_huge_pages;
+    }
+
+private:
+    void copy_out(uint64_t first, uint8_t* items, size_t nitems) const;
+
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::atomic<uint64_t> d_written{0};      // items published to the readers
+    std::atomic<uint64_t> d_writing_end{0};  // items written when the write in progress ends
+    uint8_t* d_buffer{nullptr};
+    size_t d_item_size;
+    size_t d_capacity;
+    size_t d_mapped_bytes{0};
+    bool d_huge_pages{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_SAMPLE_RING_H
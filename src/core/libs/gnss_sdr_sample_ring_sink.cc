@@ -0,0 +1,46 @@
+/*!
+ * \file gnss_sdr_sample_ring_sink.cc
+ * \brief GNU Radio block that writes the samples of a signal conditioner
+ * into a Gnss_Sdr_Sample_Ring.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_sample_ring_sink.h"
+#include <gnuradio/io_signature.h>
+#include <utility>  // for std::move
+
+
+gnss_sdr_sample_ring_sink::gnss_sdr_sample_ring_sink(
+    std::shared_ptr<Gnss_Sdr_Sample_Ring> ring,
+    size_t item_size)
+    : gr::sync_block("sample_ring_sink",
+          gr::io_signature::make(1, 1, item_size),
+          gr::io_signature::make(0, 0, 0)),
+      d_ring(std::move(ring))
+{
+}
+
+
+gnss_sdr_sample_ring_sink_sptr gnss_sdr_make_sample_ring_sink(std::shared_ptr<Gnss_Sdr_Sample_Ring> ring, size_t item_size)
+{
+    gnss_sdr_sample_ring_sink_sptr sample_ring_sink_(new gnss_sdr_sample_ring_sink(std::move(ring), item_size));
+    return sample_ring_sink_;
+}
+
+
+int gnss_sdr_sample_ring_sink::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items __attribute__((unused)))
+{
+    d_ring->write(input_items[0], static_cast<size_t>(noutput_items));
+    return noutput_items;
+}
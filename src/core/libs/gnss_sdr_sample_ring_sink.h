@@ -0,0 +1,66 @@
+/*!
+ * \file gnss_sdr_sample_ring_sink.h
+ * \brief GNU Radio block that writes the samples of a signal conditioner
+ * into a Gnss_Sdr_Sample_Ring.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_SAMPLE_RING_SINK_H
+#define GNSS_SDR_GNSS_SDR_SAMPLE_RING_SINK_H
+
+#include "gnss_block_interface.h"
+#include "gnss_sdr_sample_ring.h"
+#include <gnuradio/sync_block.h>
+#include <gnuradio/types.h>  // for gr_vector_const_void_star
+#include <cstddef>           // for size_t
+#include <memory>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+
+class gnss_sdr_sample_ring_sink;
+
+using gnss_sdr_sample_ring_sink_sptr = gnss_shared_ptr<gnss_sdr_sample_ring_sink>;
+
+gnss_sdr_sample_ring_sink_sptr gnss_sdr_make_sample_ring_sink(
+    std::shared_ptr<Gnss_Sdr_Sample_Ring> ring,
+    size_t item_size);
+
+/*!
+ * \brief Copies its input into the ring, without ever waiting for the readers
+ */
+class gnss_sdr_sample_ring_sink : public gr::sync_block
+{
+public:
+    ~gnss_sdr_sample_ring_sink() = default;
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend gnss_sdr_sample_ring_sink_sptr gnss_sdr_make_sample_ring_sink(
+        std::shared_ptr<Gnss_Sdr_Sample_Ring> ring,
+        size_t item_size);
+
+    gnss_sdr_sample_ring_sink(std::shared_ptr<Gnss_Sdr_Sample_Ring> ring,
+        size_t item_size);
+
+    std::shared_ptr<Gnss_Sdr_Sample_Ring> d_ring;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_SAMPLE_RING_SINK_H
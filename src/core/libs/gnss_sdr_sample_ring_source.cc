@@ -0,0 +1,115 @@
+/*!
+ * \file gnss_sdr_sample_ring_source.cc
+ * \brief GNU Radio block that reads the samples of a Gnss_Sdr_Sample_Ring
+ * for one channel, skipping ahead if the channel falls behind.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_sample_ring_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <pmt/pmt.h>        // for from_uint64
+#include <pmt/pmt_sugar.h>  // for mp
+#include <algorithm>        // for std::min, std::max
+#include <chrono>           // for std::chrono::milliseconds
+#include <utility>          // for std::move
+
+
+gnss_sdr_sample_ring_source::gnss_sdr_sample_ring_source(
+    std::shared_ptr<Gnss_Sdr_Sample_Ring> ring,
+    size_t item_size,
+    uint64_t max_lag_items,
+    int32_t channel)
+    : gr::sync_block("sample_ring_source",
+          gr::io_signature::make(0, 0, 0),
+          gr::io_signature::make(1, 1, item_size)),
+      d_ring(std::move(ring)),
+      d_cursor(0ULL),
+      d_max_lag_items(max_lag_items),
+      d_peak_lag(0ULL),
+      d_skipped_samples(0ULL),
+      d_skips(0ULL),
+      d_channel(channel),
+      d_tag_pending(false)
+{
+    // Samples beyond the ring capacity are lost anyway
+    d_max_lag_items = std::min(d_max_lag_items, static_cast<uint64_t>(d_ring->capacity()));
+}
+
+
+gnss_sdr_sample_ring_source_sptr gnss_sdr_make_sample_ring_source(std::shared_ptr<Gnss_Sdr_Sample_Ring> ring,
+    size_t item_size,
+    uint64_t max_lag_items,
+    int32_t channel)
+{
+    gnss_sdr_sample_ring_source_sptr sample_ring_source_(new gnss_sdr_sample_ring_source(std::move(ring), item_size, max_lag_items, channel));
+    return sample_ring_source_;
+}
+
+
+bool gnss_sdr_sample_ring_source::stop()
+{
+    LOG(INFO) << "Channel " << d_channel << " sample ring reader: maximum lag of " << d_peak_lag
+              << " samples, " << d_skipped_samples << " samples skipped in " << d_skips << " events";
+    return true;
+}
+
+
+void gnss_sdr_sample_ring_source::skip_to(uint64_t index)
+{
+    d_skipped_samples += index - d_cursor;
+    d_skips++;
+    LOG(WARNING) << "Channel " << d_channel << " fell behind the signal conditioner, skipping "
+                 << index - d_cursor << " samples";
+    d_cursor = index;
+    d_tag_pending = true;
+}
+
+
+int gnss_sdr_sample_ring_source::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    uint64_t written = d_ring->written();
+    if (written <= d_cursor)
+        {
+            // a bounded wait, so that the flowgraph can be stopped
+            if (!d_ring->wait_for(d_cursor, std::chrono::milliseconds(100)))
+                {
+                    return 0;
+                }
+            written = d_ring->written();
+        }
+
+    const uint64_t lag = written - d_cursor;
+    d_peak_lag = std::max(d_peak_lag, lag);
+    if (lag > d_max_lag_items)
+        {
+            skip_to(written);
+            return 0;
+        }
+
+    const auto nitems = static_cast<int>(std::min(static_cast<uint64_t>(noutput_items), lag));
+    if (!d_ring->read(d_cursor, output_items[0], static_cast<size_t>(nitems)))
+        {
+            // overwritten while being copied
+            skip_to(d_ring->written());
+            return 0;
+        }
+    if (d_tag_pending)
+        {
+            add_item_tag(0, nitems_written(0), pmt::mp("sample_counter"), pmt::from_uint64(d_cursor));
+            d_tag_pending = false;
+        }
+    d_cursor += static_cast<uint64_t>(nitems);
+    return nitems;
+}
@@ -0,0 +1,105 @@
+/*!
+ * \file gnss_sdr_sample_ring_source.h
+ * \brief GNU Radio block that reads the samples of a Gnss_Sdr_Sample_Ring
+ * for one channel, skipping ahead if the channel falls behind.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_SAMPLE_RING_SOURCE_H
+#define GNSS_SDR_GNSS_SDR_SAMPLE_RING_SOURCE_H
+
+#include "gnss_block_interface.h"
+#include "gnss_sdr_sample_ring.h"
+#include <gnuradio/sync_block.h>
+#include <gnuradio/types.h>  // for gr_vector_const_void_star
+#include <atomic>
+#include <cstddef>  // for size_t
+#include <cstdint>
+#include <memory>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+
+class gnss_sdr_sample_ring_source;
+
+using gnss_sdr_sample_ring_source_sptr = gnss_shared_ptr<gnss_sdr_sample_ring_source>;
+
+gnss_sdr_sample_ring_source_sptr gnss_sdr_make_sample_ring_source(
+    std::shared_ptr<Gnss_Sdr_Sample_Ring> ring,
+    size_t item_size,
+    uint64_t max_lag_items,
+    int32_t channel);
+
+/*!
+ * \brief Per-channel reader of a Gnss_Sdr_Sample_Ring.
+ *
+ * If the channel lags behind the writer by more than max_lag_items, the
+ * pending samples are skipped and the next output item carries a
+ * "sample_counter" tag with its absolute sample index, so that the consumer
+ * can keep its sample stamps aligned with the rest of the receiver.
+ */
+class gnss_sdr_sample_ring_source : public gr::sync_block
+{
+public:
+    ~gnss_sdr_sample_ring_source() = default;
+    bool stop() override;
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+    /*!
+     * \brief Number of times the reader skipped ahead
+     */
+    inline uint64_t skips() const
+    {
+        return d_skips.load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief Total number of samples skipped
+     */
+    inline uint64_t skipped_samples() const
+    {
+        return d_skipped_samples.load(std::memory_order_relaxed);
+    }
+
+private:
+    friend gnss_sdr_sample_ring_source_sptr gnss_sdr_make_sample_ring_source(
+        std::shared_ptr<Gnss_Sdr_Sample_Ring> ring,
+        size_t item_size,
+        uint64_t max_lag_items,
+        int32_t channel);
+
+    gnss_sdr_sample_ring_source(std::shared_ptr<Gnss_Sdr_Sample_Ring> ring,
+        size_t item_size,
+        uint64_t max_lag_items,
+        int32_t channel);
+
+    void skip_to(uint64_t index);
+
+    std::shared_ptr<Gnss_Sdr_Sample_Ring> d_ring;
+    uint64_t d_cursor;
+    uint64_t d_max_lag_items;
+    uint64_t d_peak_lag;
+    std::atomic<uint64_t> d_skipped_samples;  // read by other threads for the statistics
+    std::atomic<uint64_t> d_skips;
+    int32_t d_channel;
+    bool d_tag_pending;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_SAMPLE_RING_SOURCE_H
@@ -20,144 +20,159 @@
 #include <sstream>
 
 
-bool StringConverter::convert(const std::string& value, bool default_value)
+namespace
 {
-    if (value == "true")
-        {
-            return true;
-        }
-    if (value == "false")
+template <typename T>
+bool stream_convert(const std::string& value, T& result)
+{
+    std::stringstream stream(value);
+
+    T converted;
+    stream >> converted;
+
+    if (stream.fail())
         {
             return false;
         }
 
-    return default_value;
+    result = converted;
+    return true;
 }
+}  // namespace
 
 
-int64_t StringConverter::convert(const std::string& value, int64_t default_value)
+bool StringConverter::convert(const std::string& value, bool default_value)
 {
-    std::stringstream stream(value);
-
-    int64_t result;
-    stream >> result;
+    bool result = default_value;
+    try_convert(value, result);
+    return result;
+}
 
-    if (stream.fail())
-        {
-            return default_value;
-        }
 
+int64_t StringConverter::convert(const std::string& value, int64_t default_value)
+{
+    int64_t result = default_value;
+    try_convert(value, result);
     return result;
 }
 
 
 uint64_t StringConverter::convert(const std::string& value, uint64_t default_value)
 {
-    std::stringstream stream(value);
-
-    uint64_t result;
-    stream >> result;
-
-    if (stream.fail())
-        {
-            return default_value;
-        }
-
+    uint64_t result = default_value;
+    try_convert(value, result);
     return result;
 }
 
 
 int32_t StringConverter::convert(const std::string& value, int32_t default_value)
 {
-    std::stringstream stream(value);
-
-    int result;
-    stream >> result;
+    int32_t result = default_value;
+    try_convert(value, result);
+    return result;
+}
 
-    if (stream.fail())
-        {
-            return default_value;
-        }
 
+uint32_t StringConverter::convert(const std::string& value, uint32_t default_value)
+{
+    uint32_t result = default_value;
+    try_convert(value, result);
     return result;
 }
 
 
-uint32_t StringConverter::convert(const std::string& value, uint32_t default_value)
+uint16_t StringConverter::convert(const std::string& value, uint16_t default_value)
 {
-    std::stringstream stream(value);
+    uint16_t result = default_value;
+    try_convert(value, result);
+    return result;
+}
 
-    uint32_t result;
-    stream >> result;
 
-    if (stream.fail())
-        {
-            return default_value;
-        }
+int16_t StringConverter::convert(const std::string& value, int16_t default_value)
+{
+    int16_t result = default_value;
+    try_convert(value, result);
+    return result;
+}
+
 
+float StringConverter::convert(const std::string& value, float default_value)
+{
+    float result = default_value;
+    try_convert(value, result);
     return result;
 }
 
 
-uint16_t StringConverter::convert(const std::string& value, uint16_t default_value)
+double StringConverter::convert(const std::string& value, double default_value)
 {
-    std::stringstream stream(value);
+    double result = default_value;
+    try_convert(value, result);
+    return result;
+}
 
-    uint16_t result;
-    stream >> result;
 
-    if (stream.fail())
+bool StringConverter::try_convert(const std::string& value, bool& result)
+{
+    if (value == "true")
         {
-            return default_value;
+            result = true;
+            return true;
+        }
+    if (value == "false")
+        {
+            result = false;
+            return true;
         }
 
-    return result;
+    return false;
 }
 
 
-int16_t StringConverter::convert(const std::string& value, int16_t default_value)
+bool StringConverter::try_convert(const std::string& value, int64_t& result)
 {
-    std::stringstream stream(value);
-
-    int16_t result;
-    stream >> result;
+    return stream_convert(value, result);
+}
 
-    if (stream.fail())
-        {
-            return default_value;
-        }
 
-    return result;
+bool StringConverter::try_convert(const std::string& value, uint64_t& result)
+{
+    return stream_convert(value, result);
 }
 
 
-float StringConverter::convert(const std::string& value, float default_value)
+bool StringConverter::try_convert(const std::string& value, int32_t& result)
 {
-    std::stringstream stream(value);
+    return stream_convert(value, result);
+}
 
-    float result;
-    stream >> result;
 
-    if (stream.fail())
-        {
-            return default_value;
-        }
+bool StringConverter::try_convert(const std::string& value, uint32_t& result)
+{
+    return stream_convert(value, result);
+}
 
-    return result;
+
+bool StringConverter::try_convert(const std::string& value, uint16_t& result)
+{
+    return stream_convert(value, result);
 }
 
 
-double StringConverter::convert(const std::string& value, double default_value)
+bool StringConverter::try_convert(const std::string& value, int16_t& result)
 {
-    std::stringstream stream(value);
+    return stream_convert(value, result);
+}
 
-    double result;
-    stream >> result;
 
-    if (stream.fail())
-        {
-            return default_value;
-        }
+bool StringConverter::try_convert(const std::string& value, float& result)
+{
+    return stream_convert(value, result);
+}
 
-    return result;
+
+bool StringConverter::try_convert(const std::string& value, double& result)
+{
+    return stream_convert(value, result);
 }
@@ -47,6 +47,20 @@ public:
     uint16_t convert(const std::string& value, uint16_t default_value);
     float convert(const std::string& value, float default_value);
     double convert(const std::string& value, double default_value);
+
+    /*!
+     * \brief Converts value into result. Returns false, leaving result
+     * untouched, if value cannot be interpreted as the type of result.
+     */
+    bool try_convert(const std::string& value, bool& result);
+    bool try_convert(const std::string& value, int64_t& result);
+    bool try_convert(const std::string& value, uint64_t& result);
+    bool try_convert(const std::string& value, int32_t& result);
+    bool try_convert(const std::string& value, uint32_t& result);
+    bool try_convert(const std::string& value, int16_t& result);
+    bool try_convert(const std::string& value, uint16_t& result);
+    bool try_convert(const std::string& value, float& result);
+    bool try_convert(const std::string& value, double& result);
 };
 
 
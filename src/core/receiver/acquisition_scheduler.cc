@@ -0,0 +1,236 @@
+/*!
+ * \file acquisition_scheduler.cc
+ * \brief Predicts the visibility and the Doppler shift of each satellite from
+ * the available ephemeris and almanac data, in order to rank the satellite
+ * search and to narrow the acquisition Doppler windows.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#if ARMA_NO_BOUND_CHECKING
+#define ARMA_NO_DEBUG 1
+#endif
+
+#include "acquisition_scheduler.h"
+#include "MATH_CONSTANTS.h"       // for SPEED_OF_LIGHT_M_S
+#include "galileo_almanac.h"      // for Galileo_Almanac
+#include "galileo_ephemeris.h"    // for Galileo_Ephemeris
+#include "geofunctions.h"         // for Geo_to_ECEF, topocent
+#include "gnss_frequencies.h"     // for FREQ1
+#include "gps_almanac.h"          // for Gps_Almanac
+#include "gps_ephemeris.h"        // for Gps_Ephemeris
+#include "rtklib.h"               // for gtime_t, eph_t, alm_t
+#include "rtklib_conversions.h"   // for eph_to_rtklib, alm_to_rtklib
+#include "rtklib_ephemeris.h"     // for eph2pos, alm2pos
+#include "rtklib_rtkcmn.h"        // for utc2gpst, timeadd
+#include <armadillo>              // for interaction with geofunctions
+#include <algorithm>              // for std::stable_sort
+#include <cmath>                  // for std::fmod, std::floor, std::sqrt
+
+
+Acquisition_Scheduler::Acquisition_Scheduler(double eph_doppler_margin_hz,
+    double alm_doppler_margin_hz,
+    double elevation_mask_deg,
+    bool pre_2009_file) : d_eph_doppler_margin_hz(eph_doppler_margin_hz),
+                          d_alm_doppler_margin_hz(alm_doppler_margin_hz),
+                          d_elevation_mask_deg(elevation_mask_deg),
+                          d_last_update(0),
+                          d_pre_2009_file(pre_2009_file)
+{
+}
+
+
+void Acquisition_Scheduler::update(const std::array<float, 3>& LLH,
+    time_t rx_utc_time,
+    double clock_drift_ppm,
+    double clock_drift_uncertainty_ppm,
+    const std::map<int, Gps_Ephemeris>& gps_eph_map,
+    const std::map<int, Galileo_Ephemeris>& gal_eph_map,
+    const std::map<int, Gps_Almanac>& gps_alm_map,
+    const std::map<int, Galileo_Almanac>& gal_alm_map)
+{
+    d_predictions.clear();
+    d_last_update = rx_utc_time;
+
+    // Receiver ECEF position from LLH WGS84
+    const arma::vec LLH_rad = arma::vec{degtorad(LLH[0]), degtorad(LLH[1]), LLH[2]};
+    arma::mat C_tmp = arma::zeros(3, 3);
+    arma::vec r_eb_e = arma::zeros(3, 1);
+    arma::vec v_eb_e = arma::zeros(3, 1);
+    Geo_to_ECEF(LLH_rad, arma::vec{0, 0, 0}, C_tmp, r_eb_e, v_eb_e, C_tmp);
+    const std::array<double, 3> rx_pos_ecef = {r_eb_e(0), r_eb_e(1), r_eb_e(2)};
+
+    gtime_t utc_gtime;
+    utc_gtime.time = rx_utc_time;
+    utc_gtime.sec = 0.0;
+    const gtime_t gps_gtime = utc2gpst(utc_gtime);
+
+    // An unknown receiver clock drift widens all the Doppler windows
+    const double clock_uncertainty_hz = clock_drift_uncertainty_ppm * 1e-6 * FREQ1;
+    const double eph_uncertainty_hz = d_eph_doppler_margin_hz + clock_uncertainty_hz;
+    const double alm_uncertainty_hz = d_alm_doppler_margin_hz + clock_uncertainty_hz;
+
+    // Satellite positions half a second before and after rx time give the range rate
+    const gtime_t gps_before = timeadd(gps_gtime, -0.5);
+    const gtime_t gps_after = timeadd(gps_gtime, 0.5);
+    double clock_bias_s;
+    double sat_pos_variance_m2;
+    std::array<double, 3> sat_pos_before{};
+    std::array<double, 3> sat_pos_after{};
+
+    for (const auto& it : gps_eph_map)
+        {
+            const eph_t rtklib_eph = eph_to_rtklib(it.second, d_pre_2009_file);
+            eph2pos(gps_before, &rtklib_eph, sat_pos_before.data(), &clock_bias_s, &sat_pos_variance_m2);
+            eph2pos(gps_after, &rtklib_eph, sat_pos_after.data(), &clock_bias_s, &sat_pos_variance_m2);
+            add_prediction(Gnss_Satellite(std::string("GPS"), it.second.PRN), rx_pos_ecef, sat_pos_before, sat_pos_after, clock_drift_ppm, eph_uncertainty_hz);
+        }
+
+    for (const auto& it : gal_eph_map)
+        {
+            const eph_t rtklib_eph = eph_to_rtklib(it.second);
+            eph2pos(gps_before, &rtklib_eph, sat_pos_before.data(), &clock_bias_s, &sat_pos_variance_m2);
+            eph2pos(gps_after, &rtklib_eph, sat_pos_after.data(), &clock_bias_s, &sat_pos_variance_m2);
+            add_prediction(Gnss_Satellite(std::string("Galileo"), it.second.PRN), rx_pos_ecef, sat_pos_before, sat_pos_after, clock_drift_ppm, eph_uncertainty_hz);
+        }
+
+    // Almanacs are referred to the time of week. Satellites with ephemeris are not overwritten
+    gtime_t tow_before;
+    tow_before.time = static_cast<time_t>(std::fmod(static_cast<double>(gps_gtime.time) + 345600.0, 604800.0));
+    tow_before.sec = -0.5;
+    gtime_t tow_after = tow_before;
+    tow_after.sec = 0.5;
+
+    for (const auto& it : gps_alm_map)
+        {
+            const Gnss_Satellite satellite(std::string("GPS"), it.second.PRN);
+            if (d_predictions.count(satellite_key(satellite)) == 0)
+                {
+                    const alm_t rtklib_alm = alm_to_rtklib(it.second);
+                    alm2pos(tow_before, &rtklib_alm, sat_pos_before.data(), &clock_bias_s);
+                    alm2pos(tow_after, &rtklib_alm, sat_pos_after.data(), &clock_bias_s);
+                    add_prediction(satellite, rx_pos_ecef, sat_pos_before, sat_pos_after, clock_drift_ppm, alm_uncertainty_hz);
+                }
+        }
+
+    for (const auto& it : gal_alm_map)
+        {
+            const Gnss_Satellite satellite(std::string("Galileo"), it.second.PRN);
+            if (d_predictions.count(satellite_key(satellite)) == 0)
+                {
+                    const alm_t rtklib_alm = alm_to_rtklib(it.second);
+                    alm2pos(tow_before, &rtklib_alm, sat_pos_before.data(), &clock_bias_s);
+                    alm2pos(tow_after, &rtklib_alm, sat_pos_after.data(), &clock_bias_s);
+                    add_prediction(satellite, rx_pos_ecef, sat_pos_before, sat_pos_after, clock_drift_ppm, alm_uncertainty_hz);
+                }
+        }
+}
+
+
+void Acquisition_Scheduler::add_prediction(const Gnss_Satellite& satellite,
+    const std::array<double, 3>& rx_pos_ecef,
+    const std::array<double, 3>& sat_pos_before,
+    const std::array<double, 3>& sat_pos_after,
+    double clock_drift_ppm,
+    double uncertainty_hz)
+{
+    if (sat_pos_before == std::array<double, 3>{} or sat_pos_after == std::array<double, 3>{})
+        {
+            return;  // invalid orbit parameters
+        }
+    double range_before = 0.0;
+    double range_after = 0.0;
+    arma::vec dx = arma::zeros(3, 1);
+    for (int i = 0; i < 3; i++)
+        {
+            range_before += (sat_pos_before[i] - rx_pos_ecef[i]) * (sat_pos_before[i] - rx_pos_ecef[i]);
+            range_after += (sat_pos_after[i] - rx_pos_ecef[i]) * (sat_pos_after[i] - rx_pos_ecef[i]);
+            dx(i) = (sat_pos_before[i] + sat_pos_after[i]) / 2.0 - rx_pos_ecef[i];
+        }
+
+    double Az;
+    double El;
+    double dist_m;
+    topocent(&Az, &El, &dist_m, arma::vec{rx_pos_ecef[0], rx_pos_ecef[1], rx_pos_ecef[2]}, dx);
+    if (El < d_elevation_mask_deg)
+        {
+            return;
+        }
+
+    // The receiver clock drift adds to the range rate seen by the receiver
+    const double range_rate_m_s = std::sqrt(range_after) - std::sqrt(range_before);
+    const double doppler_hz = -(range_rate_m_s / SPEED_OF_LIGHT_M_S + clock_drift_ppm * 1e-6) * FREQ1;
+    d_predictions[satellite_key(satellite)] = Prediction{satellite, El, doppler_hz, uncertainty_hz};
+}
+
+
+std::vector<std::pair<int, Gnss_Satellite>> Acquisition_Scheduler::visible_satellites() const
+{
+    std::vector<std::pair<int, Gnss_Satellite>> visible;
+    visible.reserve(d_predictions.size());
+    for (const auto& it : d_predictions)
+        {
+            visible.emplace_back(static_cast<int>(std::floor(it.second.elevation_deg)), it.second.satellite);
+        }
+    std::stable_sort(visible.begin(), visible.end(), [](const std::pair<int, Gnss_Satellite>& a, const std::pair<int, Gnss_Satellite>& b) {
+        return a.first > b.first;
+    });
+    return visible;
+}
+
+
+bool Acquisition_Scheduler::predicted_doppler(const Gnss_Signal& gnss_signal, double& doppler_hz, double& uncertainty_hz) const
+{
+    if (d_missed_signals.count(signal_key(gnss_signal)) != 0)
+        {
+            return false;
+        }
+    const auto it = d_predictions.find(satellite_key(gnss_signal.get_satellite()));
+    if (it == d_predictions.end())
+        {
+            return false;
+        }
+    doppler_hz = it->second.doppler_hz;
+    uncertainty_hz = it->second.uncertainty_hz;
+    return true;
+}
+
+
+void Acquisition_Scheduler::report_miss(const Gnss_Signal& gnss_signal)
+{
+    if (d_predictions.count(satellite_key(gnss_signal.get_satellite())) == 0)
+        {
+            return;  // it was a full search already
+        }
+    const std::string key = signal_key(gnss_signal);
+    if (d_missed_signals.erase(key) == 0)
+        {
+            d_missed_signals.insert(key);
+        }
+}
+
+
+void Acquisition_Scheduler::report_hit(const Gnss_Signal& gnss_signal)
+{
+    d_missed_signals.erase(signal_key(gnss_signal));
+}
+
+
+std::string Acquisition_Scheduler::satellite_key(const Gnss_Satellite& satellite) const
+{
+    return satellite.get_system() + " " + std::to_string(satellite.get_PRN());
+}
+
+
+std::string Acquisition_Scheduler::signal_key(const Gnss_Signal& gnss_signal) const
+{
+    return satellite_key(gnss_signal.get_satellite()) + " " + gnss_signal.get_signal_str();
+}
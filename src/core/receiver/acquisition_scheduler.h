@@ -0,0 +1,135 @@
+/*!
+ * \file acquisition_scheduler.h
+ * \brief Predicts the visibility and the Doppler shift of each satellite from
+ * the available ephemeris and almanac data, in order to rank the satellite
+ * search and to narrow the acquisition Doppler windows.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQUISITION_SCHEDULER_H
+#define GNSS_SDR_ACQUISITION_SCHEDULER_H
+
+#include "gnss_satellite.h"
+#include "gnss_signal.h"
+#include <array>
+#include <ctime>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+class Galileo_Almanac;
+class Galileo_Ephemeris;
+class Gps_Almanac;
+class Gps_Ephemeris;
+
+
+/*!
+ * \brief Ranks the satellites to be searched and predicts their Doppler.
+ *
+ * Given a receiver position, a time and the estimated receiver clock drift,
+ * update() computes the elevation and the L1/E1 Doppler shift of every
+ * satellite with ephemeris or almanac data. Satellites above the elevation
+ * mask are returned by visible_satellites(), highest first, and
+ * predicted_doppler() provides the center and the half-width of a narrowed
+ * Doppler search window for each of their signals.
+ *
+ * If a search with a narrowed window fails, report_miss() makes the next
+ * search of that signal span the full Doppler range. A further miss restores
+ * the narrowed window, since the prediction may have been refreshed by then.
+ */
+class Acquisition_Scheduler
+{
+public:
+    Acquisition_Scheduler(double eph_doppler_margin_hz,
+        double alm_doppler_margin_hz,
+        double elevation_mask_deg,
+        bool pre_2009_file);
+
+    /*!
+     * \brief Computes the predictions at rx_utc_time for a receiver at
+     * LLH ([deg], [deg], [m]) with the given clock drift and clock drift
+     * uncertainty [ppm]
+     */
+    void update(const std::array<float, 3>& LLH,
+        time_t rx_utc_time,
+        double clock_drift_ppm,
+        double clock_drift_uncertainty_ppm,
+        const std::map<int, Gps_Ephemeris>& gps_eph_map,
+        const std::map<int, Galileo_Ephemeris>& gal_eph_map,
+        const std::map<int, Gps_Almanac>& gps_alm_map,
+        const std::map<int, Galileo_Almanac>& gal_alm_map);
+
+    /*!
+     * \brief Visible satellites and their elevation [deg], highest first
+     */
+    std::vector<std::pair<int, Gnss_Satellite>> visible_satellites() const;
+
+    /*!
+     * \brief Predicted Doppler at the L1/E1 frequency [Hz] and its
+     * uncertainty [Hz]. Returns false if the full Doppler range has to be
+     * searched.
+     */
+    bool predicted_doppler(const Gnss_Signal& gnss_signal, double& doppler_hz, double& uncertainty_hz) const;
+
+    void report_miss(const Gnss_Signal& gnss_signal);  //!< The acquisition of gnss_signal failed
+    void report_hit(const Gnss_Signal& gnss_signal);   //!< The acquisition of gnss_signal succeeded
+
+    inline time_t last_update() const
+    {
+        return d_last_update;
+    }
+
+    inline bool has_predictions() const
+    {
+        return !d_predictions.empty();
+    }
+
+private:
+    struct Prediction
+    {
+        Gnss_Satellite satellite;
+        double elevation_deg;
+        double doppler_hz;
+        double uncertainty_hz;
+    };
+
+    void add_prediction(const Gnss_Satellite& satellite,
+        const std::array<double, 3>& rx_pos_ecef,
+        const std::array<double, 3>& sat_pos_before,
+        const std::array<double, 3>& sat_pos_after,
+        double clock_drift_ppm,
+        double uncertainty_hz);
+
+    std::string satellite_key(const Gnss_Satellite& satellite) const;
+    std::string signal_key(const Gnss_Signal& gnss_signal) const;
+
+    std::map<std::string, Prediction> d_predictions;
+    std::set<std::string> d_missed_signals;
+    double d_eph_doppler_margin_hz;
+    double d_alm_doppler_margin_hz;
+    double d_elevation_mask_deg;
+    time_t d_last_update;
+    bool d_pre_2009_file;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQUISITION_SCHEDULER_H
@@ -0,0 +1,238 @@
+/*!
+ * \file block_placement_policy.cc
+ * \brief Pins the threads of the flowgraph blocks to processor cores or NUMA
+ * nodes, sets their output buffer sizes and their real-time priority, as
+ * configured for each block role.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "block_placement_policy.h"
+#include "configuration_interface.h"
+#include <glog/logging.h>
+#include <gnuradio/block.h>        // for block
+#include <gnuradio/hier_block2.h>  // for hier_block2
+#include <sched.h>                 // for sched_getscheduler, SCHED_FIFO
+#include <algorithm>               // for std::remove_if
+#include <array>                   // for std::array
+#include <exception>               // for std::exception
+#include <fstream>                 // for std::ifstream
+#include <sstream>                 // for std::stringstream
+#include <thread>                  // for std::thread
+
+
+Block_Placement_Policy::Block_Placement_Policy(const ConfigurationInterface* configuration,
+    int32_t channels_count) : d_channels_count(channels_count)
+{
+    const std::array<std::string, 5> roles = {"SignalSource", "SignalConditioner", "Channels", "Observables", "PVT"};
+
+    for (const auto& role : roles)
+        {
+            std::vector<int> role_cores = parse_cpu_list(configuration->property("GNSS-SDR.cpu_affinity." + role, std::string("")));
+            if (role_cores.empty())
+                {
+                    role_cores = numa_node_cores(parse_cpu_list(configuration->property("GNSS-SDR.numa_node." + role, std::string(""))));
+                }
+            if (!role_cores.empty())
+                {
+                    d_role_cores[role] = role_cores;
+                }
+
+            const int64_t min_buffer = configuration->property("GNSS-SDR.min_output_buffer." + role, static_cast<int64_t>(0));
+            if (min_buffer > 0)
+                {
+                    d_min_output_buffer[role] = min_buffer;
+                }
+            const int64_t max_buffer = configuration->property("GNSS-SDR.max_output_buffer." + role, static_cast<int64_t>(0));
+            if (max_buffer > 0)
+                {
+                    d_max_output_buffer[role] = max_buffer;
+                }
+
+            const int32_t priority = configuration->property("GNSS-SDR.realtime_priority." + role, 0);
+            if (priority > 0)
+                {
+                    d_realtime_priority[role] = std::min(priority, sched_get_priority_max(SCHED_FIFO));
+                }
+        }
+
+    if (!d_realtime_priority.empty() and sched_getscheduler(0) == SCHED_OTHER)
+        {
+            // GNU Radio sets the priority of the block threads within the
+            // scheduling policy they inherit from the process
+            LOG(WARNING) << "Block placement: real-time priorities require running GNSS-SDR with a real-time scheduling policy (e.g., chrt --fifo 1 gnss-sdr ...)";
+        }
+
+    for (int32_t channel = 0; channel < d_channels_count; channel++)
+        {
+            std::vector<int> channel_cores = parse_cpu_list(configuration->property("Channel" + std::to_string(channel) + ".cpu_affinity", std::string("")));
+            if (!channel_cores.empty())
+                {
+                    d_channel_cores[channel] = channel_cores;
+                }
+        }
+}
+
+
+std::vector<int> Block_Placement_Policy::cores(const std::string& role, int32_t channel) const
+{
+    if (role == "Channels")
+        {
+            const auto channel_it = d_channel_cores.find(channel);
+            if (channel_it != d_channel_cores.cend())
+                {
+                    return channel_it->second;
+                }
+        }
+    const auto it = d_role_cores.find(role);
+    if (it == d_role_cores.cend())
+        {
+            return {};
+        }
+    if (role == "Channels" and channel >= 0 and channel < d_channels_count)
+        {
+            // contiguous ranges of channels share a core
+            const auto n_cores = static_cast<int64_t>(it->second.size());
+            return {it->second[static_cast<size_t>((channel * n_cores) / d_channels_count)]};
+        }
+    return it->second;
+}
+
+
+void Block_Placement_Policy::place(const std::string& role, const gr::basic_block_sptr& block, int32_t channel)
+{
+    if (block == nullptr)
+        {
+            return;
+        }
+    auto* gr_block = dynamic_cast<gr::block*>(block.get());
+    auto* hier_block = dynamic_cast<gr::hier_block2*>(block.get());
+    if (gr_block == nullptr and hier_block == nullptr)
+        {
+            return;
+        }
+
+    // Cores missing in this host are left out
+    std::vector<int> block_cores = cores(role, channel);
+    const auto available_cores = static_cast<int>(std::thread::hardware_concurrency());
+    if (available_cores > 0)
+        {
+            block_cores.erase(std::remove_if(block_cores.begin(), block_cores.end(), [available_cores](int core) { return core >= available_cores; }), block_cores.end());
+        }
+    const auto min_buffer = d_min_output_buffer.find(role);
+    const auto max_buffer = d_max_output_buffer.find(role);
+    try
+        {
+            if (!block_cores.empty())
+                {
+                    block->set_processor_affinity(block_cores);
+                }
+            if (gr_block != nullptr)
+                {
+                    if (min_buffer != d_min_output_buffer.cend())
+                        {
+                            gr_block->set_min_output_buffer(static_cast<long>(min_buffer->second));
+                        }
+                    if (max_buffer != d_max_output_buffer.cend())
+                        {
+                            gr_block->set_max_output_buffer(static_cast<long>(max_buffer->second));
+                        }
+                }
+            else
+                {
+                    if (min_buffer != d_min_output_buffer.cend())
+                        {
+                            hier_block->set_min_output_buffer(static_cast<int>(min_buffer->second));
+                        }
+                    if (max_buffer != d_max_output_buffer.cend())
+                        {
+                            hier_block->set_max_output_buffer(static_cast<int>(max_buffer->second));
+                        }
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Block placement of " << block->name() << ": " << e.what();
+        }
+
+    const auto priority = d_realtime_priority.find(role);
+    if (priority != d_realtime_priority.cend())
+        {
+            if (gr_block != nullptr)
+                {
+                    // applied by the thread of the block as soon as it starts
+                    gr_block->set_thread_priority(priority->second);
+                }
+            else
+                {
+                    LOG(WARNING) << "Block placement: the threads of the hierarchical block " << block->name() << " cannot be given a real-time priority";
+                }
+        }
+
+    DLOG(INFO) << "Block placement: " << block->name() << " (" << role << ") on " << block_cores.size() << " core(s)";
+}
+
+
+std::vector<int> Block_Placement_Policy::parse_cpu_list(const std::string& cpu_list)
+{
+    std::vector<int> list;
+    std::stringstream ss(cpu_list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        {
+            item.erase(std::remove_if(item.begin(), item.end(), [](char c) { return c == ' ' or c == '\t' or c == '\n'; }), item.end());
+            if (item.empty())
+                {
+                    continue;
+                }
+            try
+                {
+                    const auto dash = item.find('-');
+                    if (dash == std::string::npos)
+                        {
+                            list.push_back(std::stoi(item));
+                        }
+                    else
+                        {
+                            const int first = std::stoi(item.substr(0, dash));
+                            const int last = std::stoi(item.substr(dash + 1));
+                            for (int core = first; core <= last; core++)
+                                {
+                                    list.push_back(core);
+                                }
+                        }
+                }
+            catch (const std::exception&)
+                {
+                    LOG(WARNING) << "Block placement: invalid item '" << item << "' in list '" << cpu_list << "'";
+                }
+        }
+    return list;
+}
+
+
+std::vector<int> Block_Placement_Policy::numa_node_cores(const std::vector<int>& nodes) const
+{
+    std::vector<int> node_cores;
+    for (const auto node : nodes)
+        {
+            std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            std::string line;
+            if (!cpulist.is_open() or !std::getline(cpulist, line))
+                {
+                    LOG(WARNING) << "Block placement: unknown NUMA node " << node;
+                    continue;
+                }
+            const std::vector<int> cores_in_node = parse_cpu_list(line);
+            node_cores.insert(node_cores.end(), cores_in_node.begin(), cores_in_node.end());
+        }
+    return node_cores;
+}
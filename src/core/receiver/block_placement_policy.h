@@ -0,0 +1,99 @@
+/*!
+ * \file block_placement_policy.h
+ * \brief Pins the threads of the flowgraph blocks to processor cores or NUMA
+ * nodes, sets their output buffer sizes and their real-time priority, as
+ * configured for each block role.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_BLOCK_PLACEMENT_POLICY_H
+#define GNSS_SDR_BLOCK_PLACEMENT_POLICY_H
+
+#include <gnuradio/runtime_types.h>  // for basic_block_sptr
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+class ConfigurationInterface;
+
+
+/*!
+ * \brief Placement of the block threads of the flowgraph.
+ *
+ * The role of a block is one of SignalSource, SignalConditioner, Channels,
+ * Observables or PVT, and is configured with the parameters:
+ *
+ * - GNSS-SDR.cpu_affinity.<role>: list of cores, such as "0,2,4-7"
+ * - GNSS-SDR.numa_node.<role>: list of NUMA nodes, whose cores are used
+ *   when no cpu_affinity is given for the role
+ * - GNSS-SDR.min_output_buffer.<role>, GNSS-SDR.max_output_buffer.<role>:
+ *   output buffer size [items]
+ * - GNSS-SDR.realtime_priority.<role>: real-time priority (1 to 99) of the
+ *   block threads, which each thread sets as it starts. Only the priority is
+ *   set per role: the threads keep the scheduling policy of the process, so
+ *   GNSS-SDR has to run under SCHED_FIFO or SCHED_RR (e.g., started with
+ *   chrt) for the priority to take effect, and no role is switched to
+ *   SCHED_FIFO on its own
+ *
+ * The blocks of a role share all its cores, except for the channels: channel
+ * i of N is pinned to core (i * K / N) of the K listed cores, so that
+ * consecutive channels, which usually share a signal conditioner, stay on the
+ * same core or NUMA node. This is a heuristic based on the channel index
+ * only: the node of the signal conditioner that feeds each channel is not
+ * checked, and memory is not bound to the nodes. Channel<i>.cpu_affinity
+ * overrides the core of a single channel. Cores not present in the host are
+ * left out when placing.
+ */
+class Block_Placement_Policy
+{
+public:
+    Block_Placement_Policy(const ConfigurationInterface* configuration, int32_t channels_count);
+
+    /*!
+     * \brief Applies the placement of role to block. Must be called before
+     * the flowgraph starts. channel is only used by the Channels role.
+     */
+    void place(const std::string& role, const gr::basic_block_sptr& block, int32_t channel = -1);
+
+    /*!
+     * \brief Cores assigned to role, and to the given channel for the
+     * Channels role. Empty if the threads are not pinned.
+     */
+    std::vector<int> cores(const std::string& role, int32_t channel = -1) const;
+
+    /*!
+     * \brief Parses a list of cores or nodes, such as "0,2,4-7"
+     */
+    static std::vector<int> parse_cpu_list(const std::string& cpu_list);
+
+private:
+    std::vector<int> numa_node_cores(const std::vector<int>& nodes) const;
+
+    std::map<std::string, std::vector<int>> d_role_cores;
+    std::map<int32_t, std::vector<int>> d_channel_cores;
+    std::map<std::string, int64_t> d_min_output_buffer;
+    std::map<std::string, int64_t> d_max_output_buffer;
+    std::map<std::string, int32_t> d_realtime_priority;
+    int32_t d_channels_count;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_BLOCK_PLACEMENT_POLICY_H
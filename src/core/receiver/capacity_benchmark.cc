@@ -0,0 +1,336 @@
+/*!
+ * \file capacity_benchmark.cc
+ * \brief Finds the number of channels that the host can process in real
+ * time at each sampling rate, by running the receiver on a synthetic or
+ * looped signal source.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "capacity_benchmark.h"
+#include "control_thread.h"
+#include "file_configuration.h"
+#include "gnss_sdr_flags.h"
+#include "gnss_sdr_make_unique.h"  // for std::make_unique in C++14
+#include <glog/logging.h>
+#include <gnuradio/prefs.h>  // for prefs
+#include <algorithm>         // for sort, unique, all_of, find_if
+#include <array>             // for array
+#include <cmath>             // for llround
+#include <exception>         // for exception
+#include <fstream>           // for ofstream
+#include <iomanip>           // for setw, setprecision
+#include <iostream>          // for cout
+#include <memory>            // for make_shared
+#include <sstream>           // for istringstream
+#include <utility>           // for move
+
+
+namespace
+{
+const std::array<std::string, 11> SIGNAL_NAMES = {"1C", "2S", "L5", "1B", "5X", "7X", "E6", "1G", "2G", "B1", "B3"};
+constexpr size_t REPORTED_BLOCKS = 3;  // busiest blocks shown for each sampling rate
+
+
+std::string json_string(const std::string& s)
+{
+    std::string escaped("\"");
+    for (const char c : s)
+        {
+            if (c == '"' or c == '\\')
+                {
+                    escaped += '\\';
+                }
+            escaped += c;
+        }
+    return escaped + '"';
+}
+
+
+template <typename T>
+std::vector<T> parse_list(const std::string& list)
+{
+    std::vector<T> values;
+    std::istringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        {
+            if (not item.empty())
+                {
+                    values.push_back(static_cast<T>(std::stoll(item)));
+                }
+        }
+    return values;
+}
+}  // namespace
+
+
+Capacity_Benchmark::Capacity_Benchmark(std::vector<uint32_t> channels,
+    std::vector<int64_t> sampling_rates,
+    double required_margin,
+    Runner runner)
+    : d_channels(std::move(channels)),
+      d_sampling_rates(std::move(sampling_rates)),
+      d_runner(std::move(runner)),
+      d_required_margin(required_margin)
+{
+    std::sort(d_channels.begin(), d_channels.end());
+    d_channels.erase(std::unique(d_channels.begin(), d_channels.end()), d_channels.end());
+}
+
+
+void Capacity_Benchmark::run()
+{
+    d_results.clear();
+    d_failed = false;
+    for (const auto rate : d_sampling_rates)
+        {
+            for (const auto channels : d_channels)
+                {
+                    const Benchmark_Point point{channels, rate};
+                    std::cout << "Benchmark: " << channels << " channels at " << rate << " sps ... " << std::flush;
+                    Benchmark_Result result = d_runner(point);
+                    result.point = point;
+                    if (result.failed)
+                        {
+                            // a misconfigured receiver fails at any other point as well
+                            std::cout << "failed: " << result.error << '\n';
+                            LOG(ERROR) << "Benchmark: " << channels << " channels at " << rate << " sps failed: " << result.error;
+                            d_results.push_back(std::move(result));
+                            d_failed = true;
+                            return;
+                        }
+                    const bool keeps_up = sustained(result);
+                    std::cout << std::fixed << std::setprecision(2) << realtime_factor(result)
+                              << "x real time" << (keeps_up ? "" : ", not sustained") << std::defaultfloat << '\n';
+                    LOG(INFO) << "Benchmark: " << channels << " channels at " << rate << " sps, real-time factor " << realtime_factor(result);
+                    d_results.push_back(std::move(result));
+                    if (not keeps_up)
+                        {
+                            break;
+                        }
+                }
+        }
+}
+
+
+std::vector<Benchmark_Point> Capacity_Benchmark::envelope() const
+{
+    std::vector<Benchmark_Point> envelope;
+    for (const auto rate : d_sampling_rates)
+        {
+            Benchmark_Point max_point{0, rate};
+            for (const auto& result : d_results)
+                {
+                    if (result.point.sampling_rate_sps == rate and sustained(result))
+                        {
+                            max_point.channels = std::max(max_point.channels, result.point.channels);
+                        }
+                }
+            envelope.push_back(max_point);
+        }
+    return envelope;
+}
+
+
+bool Capacity_Benchmark::passed(uint32_t required_channels) const
+{
+    const auto points = envelope();
+    if (d_failed or points.empty())
+        {
+            return false;
+        }
+    return std::all_of(points.cbegin(), points.cend(), [required_channels](const Benchmark_Point& p) { return p.channels >= required_channels; });
+}
+
+
+void Capacity_Benchmark::print_report(std::ostream& out) const
+{
+    out << "\nCapacity benchmark (required real-time factor " << std::fixed << std::setprecision(2) << d_required_margin << ")\n";
+    out << std::setw(16) << "Rate [sps]" << std::setw(10) << "Channels" << std::setw(14) << "Real time" << "  Status\n";
+    for (const auto& result : d_results)
+        {
+            out << std::setw(16) << result.point.sampling_rate_sps
+                << std::setw(10) << result.point.channels;
+            if (result.failed)
+                {
+                    out << std::setw(14) << "-" << "  FAILED: " << result.error << '\n';
+                    continue;
+                }
+            out << std::setw(13) << std::setprecision(2) << realtime_factor(result) << 'x'
+                << (sustained(result) ? "  sustained\n" : "  NOT sustained\n");
+        }
+    if (d_failed)
+        {
+            out << "\nThe benchmark stopped at a failed run, no sustainable envelope\n" << std::defaultfloat;
+            return;
+        }
+
+    out << "\nSustainable envelope:\n";
+    for (const auto& point : envelope())
+        {
+            out << "  " << point.sampling_rate_sps << " sps: " << point.channels << " channels per signal\n";
+            // the limiting blocks are those of the last run at this rate
+            const auto last = std::find_if(d_results.crbegin(), d_results.crend(), [&point](const Benchmark_Result& r) { return r.point.sampling_rate_sps == point.sampling_rate_sps; });
+            if (last == d_results.crend())
+                {
+                    continue;
+                }
+            auto blocks = last->blocks;
+            std::sort(blocks.begin(), blocks.end(), [](const Flowgraph_Block_Load& a, const Flowgraph_Block_Load& b) { return a.work_time_s > b.work_time_s; });
+            if (blocks.empty() or blocks.front().work_time_s <= 0.0)
+                {
+                    continue;  // GNU Radio performance counters not available
+                }
+            out << "    busiest blocks with " << last->point.channels << " channels:\n";
+            for (size_t i = 0; i < std::min(REPORTED_BLOCKS, blocks.size()); i++)
+                {
+                    out << "      " << blocks[i].name << ": " << std::setprecision(1)
+                        << 100.0 * blocks[i].work_time_s / last->wall_s << " % of the run time\n";
+                }
+        }
+    out << std::defaultfloat;
+}
+
+
+void Capacity_Benchmark::write_json(std::ostream& out) const
+{
+    out << std::defaultfloat << std::setprecision(6) << "{\n  \"required_realtime_factor\": " << d_required_margin
+        << ",\n  \"failed\": " << (d_failed ? "true" : "false") << ",\n  \"envelope\": [";
+    const auto points = envelope();
+    for (size_t i = 0; i < points.size(); i++)
+        {
+            out << (i == 0 ? "\n" : ",\n") << "    {\"sampling_rate_sps\": " << points[i].sampling_rate_sps
+                << ", \"channels\": " << points[i].channels << "}";
+        }
+    out << "\n  ],\n  \"runs\": [";
+    for (size_t i = 0; i < d_results.size(); i++)
+        {
+            const auto& result = d_results[i];
+            out << (i == 0 ? "\n" : ",\n") << "    {\"sampling_rate_sps\": " << result.point.sampling_rate_sps
+                << ", \"channels\": " << result.point.channels
+                << ", \"signal_s\": " << result.signal_s
+                << ", \"wall_s\": " << result.wall_s
+                << ", \"realtime_factor\": " << realtime_factor(result)
+                << ", \"sustained\": " << (sustained(result) ? "true" : "false")
+                << ", \"failed\": " << (result.failed ? "true" : "false")
+                << ", \"error\": " << json_string(result.error)
+                << ",\n     \"blocks\": [";
+            for (size_t j = 0; j < result.blocks.size(); j++)
+                {
+                    const auto& block = result.blocks[j];
+                    out << (j == 0 ? "\n" : ",\n") << "       {\"name\": " << json_string(block.name)
+                        << ", \"items_read\": " << block.items_read
+                        << ", \"items_written\": " << block.items_written
+                        << ", \"work_time_s\": " << block.work_time_s << "}";
+                }
+            out << (result.blocks.empty() ? "]}" : "\n     ]}");
+        }
+    out << "\n  ]\n}\n";
+}
+
+
+Benchmark_Result Capacity_Benchmark::run_receiver(const std::string& config_file,
+    const Benchmark_Point& point,
+    double signal_s)
+{
+    auto configuration = std::make_shared<FileConfiguration>(config_file);
+    const auto fs = std::to_string(point.sampling_rate_sps);
+    configuration->set_property("GNSS-SDR.internal_fs_sps", fs);
+    configuration->set_property("SignalSource.sampling_frequency", fs);
+    configuration->set_property("SignalSource.samples", std::to_string(std::llround(signal_s * static_cast<double>(point.sampling_rate_sps))));
+    for (const auto& signal : SIGNAL_NAMES)
+        {
+            if (configuration->property("Channels_" + signal + ".count", 0) > 0)
+                {
+                    configuration->set_property("Channels_" + signal + ".count", std::to_string(point.channels));
+                }
+        }
+
+    // the work time of each block is only measured with performance counters
+    gr::prefs::singleton()->set_bool("PerfCounters", "on", true);
+    FLAGS_keyboard = false;
+
+    Benchmark_Result result{point, 0.0, 0.0, {}, false, ""};
+    try
+        {
+            auto control_thread = std::make_unique<ControlThread>(configuration);
+            const int run_code = control_thread->run();
+            const auto flowgraph = control_thread->flowgraph();
+            // ControlThread::run() also returns 0 when the flowgraph cannot be connected or started
+            if (not flowgraph)
+                {
+                    result.error = "the receiver flowgraph could not be created";
+                }
+            else if (run_code != 0)
+                {
+                    result.error = "the receiver returned " + std::to_string(run_code);
+                }
+            else if (flowgraph->processed_samples() == 0)
+                {
+                    result.error = "the receiver flowgraph did not process any sample";
+                }
+            else
+                {
+                    result.signal_s = static_cast<double>(flowgraph->processed_samples()) / static_cast<double>(point.sampling_rate_sps);
+                    result.wall_s = flowgraph->run_time_s();
+                    result.blocks = flowgraph->block_load();
+                }
+        }
+    catch (const std::exception& e)
+        {
+            result.error = e.what();
+        }
+    result.failed = not result.error.empty();
+    return result;
+}
+
+
+int run_capacity_benchmark(const std::string& config_file)
+{
+    const double signal_s = FLAGS_benchmark_seconds;
+    Capacity_Benchmark benchmark(parse_list<uint32_t>(FLAGS_benchmark_channels),
+        parse_list<int64_t>(FLAGS_benchmark_rates),
+        FLAGS_benchmark_margin,
+        [&config_file, signal_s](const Benchmark_Point& point) { return Capacity_Benchmark::run_receiver(config_file, point, signal_s); });
+    benchmark.run();
+    benchmark.print_report(std::cout);
+
+    if (not FLAGS_benchmark_json.empty())
+        {
+            std::ofstream json_file(FLAGS_benchmark_json);
+            if (json_file.is_open())
+                {
+                    benchmark.write_json(json_file);
+                    std::cout << "Benchmark results written to " << FLAGS_benchmark_json << '\n';
+                }
+            else
+                {
+                    std::cerr << "Could not open " << FLAGS_benchmark_json << " for writing\n";
+                }
+        }
+
+    if (benchmark.failed())
+        {
+            std::cerr << "Benchmark FAILED: the receiver could not run, see the report above\n";
+            return 1;
+        }
+
+    const auto required_channels = static_cast<uint32_t>(std::max(FLAGS_benchmark_require_channels, 0));
+    if (required_channels > 0)
+        {
+            const bool passed = benchmark.passed(required_channels);
+            std::cout << "Benchmark " << (passed ? "PASSED" : "FAILED") << ": " << required_channels
+                      << " channels required at every sampling rate\n";
+            return passed ? 0 : 1;
+        }
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*!
+ * \file capacity_benchmark.h
+ * \brief Finds the number of channels that the host can process in real
+ * time at each sampling rate, by running the receiver on a synthetic or
+ * looped signal source.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CAPACITY_BENCHMARK_H
+#define GNSS_SDR_CAPACITY_BENCHMARK_H
+
+#include "gnss_flowgraph.h"  // for Flowgraph_Block_Load
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Operating point of a benchmark run.
+ */
+struct Benchmark_Point
+{
+    uint32_t channels;          // channels of each signal
+    int64_t sampling_rate_sps;  // sampling rate of the source [samples/s]
+};
+
+
+/*!
+ * \brief Outcome of the run of the receiver at an operating point.
+ */
+struct Benchmark_Result
+{
+    Benchmark_Point point;
+    double signal_s;  // signal time processed by the channels [s]
+    double wall_s;    // wall time of the run [s]
+    std::vector<Flowgraph_Block_Load> blocks;
+    bool failed;        // the receiver could not run at this operating point
+    std::string error;  // reason of the failure
+};
+
+
+/*!
+ * \brief Ramps the channel count at each sampling rate until the receiver
+ * no longer keeps up with real time, and reports the sustainable envelope.
+ *
+ * For every sampling rate, the channel counts are tried in increasing order
+ * and the ramp stops at the first one whose real-time factor (signal time
+ * over wall time) is below the required margin. The runner is called once
+ * per operating point; run_receiver() runs the full receiver from a
+ * configuration file. A run that fails stops the whole benchmark, and is
+ * never counted as sustained.
+ */
+class Capacity_Benchmark
+{
+public:
+    using Runner = std::function<Benchmark_Result(const Benchmark_Point&)>;
+
+    Capacity_Benchmark(std::vector<uint32_t> channels,
+        std::vector<int64_t> sampling_rates,
+        double required_margin,
+        Runner runner);
+
+    /*!
+     * \brief Runs the operating points, until one of them fails.
+     */
+    void run();
+
+    /*!
+     * \brief True if the run of an operating point failed.
+     */
+    inline bool failed() const
+    {
+        return d_failed;
+    }
+
+    /*!
+     * \brief Maximum channel count sustained at each sampling rate (zero
+     * if not even the smallest one is).
+     */
+    std::vector<Benchmark_Point> envelope() const;
+
+    /*!
+     * \brief True if at least one sampling rate was tried, no run failed
+     * and every sampling rate sustains at least required_channels channels.
+     */
+    bool passed(uint32_t required_channels) const;
+
+    /*!
+     * \brief Human-readable report, with the busiest blocks of the last
+     * run at each sampling rate (the first one not sustained, if the ramp
+     * stopped there).
+     */
+    void print_report(std::ostream& out) const;
+
+    /*!
+     * \brief Results and envelope in JSON format.
+     */
+    void write_json(std::ostream& out) const;
+
+    inline const std::vector<Benchmark_Result>& results() const
+    {
+        return d_results;
+    }
+
+    inline double realtime_factor(const Benchmark_Result& result) const
+    {
+        return result.wall_s > 0.0 ? result.signal_s / result.wall_s : 0.0;
+    }
+
+    inline bool sustained(const Benchmark_Result& result) const
+    {
+        return not result.failed and realtime_factor(result) >= d_required_margin;
+    }
+
+    /*!
+     * \brief Runs the receiver configured by config_file at the given
+     * operating point, during signal_s seconds of signal.
+     *
+     * The configuration is overridden to set the sampling rate of the
+     * source and of the receiver, the number of samples to process and the
+     * count of every signal with channels in the configuration file.
+     * The result is marked as failed if the receiver cannot be built, if
+     * it returns an error or if its flowgraph does not process any sample.
+     */
+    static Benchmark_Result run_receiver(const std::string& config_file,
+        const Benchmark_Point& point,
+        double signal_s);
+
+private:
+    std::vector<Benchmark_Result> d_results;
+    std::vector<uint32_t> d_channels;
+    std::vector<int64_t> d_sampling_rates;
+    Runner d_runner;
+    double d_required_margin;
+    bool d_failed{false};
+};
+
+
+/*!
+ * \brief Runs the capacity benchmark of the receiver configured by
+ * config_file, as set by the --benchmark_* flags, prints the report and
+ * writes the JSON file. Returns 1 if a run failed or if the required
+ * channels are not sustained, and 0 otherwise.
+ */
+int run_capacity_benchmark(const std::string& config_file);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CAPACITY_BENCHMARK_H
@@ -145,6 +145,7 @@ ControlThread::ControlThread(std::shared_ptr<ConfigurationInterface> configurati
 void ControlThread::init()
 {
     telecommand_enabled_ = configuration_->property("GNSS-SDR.telecommand_enabled", false);
+    telecommand_tcp_port_ = configuration_->property("GNSS-SDR.telecommand_tcp_port", 3333);
     // OPTIONAL: specify a custom year to override the system time in order to postprocess old gnss records and avoid wrong week rollover
     pre_2009_file_ = configuration_->property("GNSS-SDR.pre_2009_file", false);
     // Instantiates a control queue, a GNSS flowgraph, and a control message factory
@@ -173,6 +174,7 @@ void ControlThread::init()
     supl_mns_ = 0;
     supl_lac_ = 0;
     supl_ci_ = 0;
+    supl_read_gps_assistance_xml_ = false;
     msqid_ = -1;
     agnss_ref_location_ = Agnss_Ref_Location();
     agnss_ref_time_ = Agnss_Ref_Time();
@@ -241,6 +243,7 @@ void ControlThread::init()
                     agnss_ref_time_.valid = false;
                 }
         }
+    read_assistance_configuration();
 
     receiver_on_standby_ = false;
 }
@@ -270,8 +273,7 @@ void ControlThread::telecommand_listener()
 {
     if (telecommand_enabled_)
         {
-            const int tcp_cmd_port = configuration_->property("GNSS-SDR.telecommand_tcp_port", 3333);
-            cmd_interface_.run_cmd_server(tcp_cmd_port);
+            cmd_interface_.run_cmd_server(telecommand_tcp_port_);
         }
 }
 
@@ -361,6 +363,16 @@ int ControlThread::run()
         {
             return 0;
         }
+    // The blocks have read their parameters by now, and the control thread
+    // read its own ones (assistance, telecommand) in init()
+    const auto file_configuration = std::dynamic_pointer_cast<FileConfiguration>(configuration_);
+    if (file_configuration)
+        {
+            for (const auto &property_name : file_configuration->unused_properties())
+                {
+                    LOG(WARNING) << "Configuration parameter " << property_name << " is not used by any block";
+                }
+        }
     // Start the flowgraph
     flowgraph_->start();
     if (flowgraph_->running())
@@ -467,45 +479,11 @@ bool ControlThread::read_assistance_from_XML()
 {
     // return variable (true == succeeded)
     bool ret = false;
-    // getting names from the config file, if available
-    std::string eph_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_ephemeris_xml", eph_default_xml_filename_);
-    std::string utc_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_utc_model_xml", utc_default_xml_filename_);
-    std::string iono_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_iono_xml", iono_default_xml_filename_);
-    std::string gal_iono_xml_filename = configuration_->property("GNSS-SDR.SUPL_gal_iono_xml", gal_iono_default_xml_filename_);
-    std::string ref_time_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_ref_time_xml", ref_time_default_xml_filename_);
-    std::string ref_location_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_ref_location_xml", ref_location_default_xml_filename_);
-    std::string eph_gal_xml_filename = configuration_->property("GNSS-SDR.SUPL_gal_ephemeris_xml", eph_gal_default_xml_filename_);
-    std::string eph_cnav_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_cnav_ephemeris_xml", eph_cnav_default_xml_filename_);
-    std::string gal_utc_xml_filename = configuration_->property("GNSS-SDR.SUPL_gal_utc_model_xml", gal_utc_default_xml_filename_);
-    std::string cnav_utc_xml_filename = configuration_->property("GNSS-SDR.SUPL_cnav_utc_model_xml", cnav_utc_default_xml_filename_);
-    std::string eph_glo_xml_filename = configuration_->property("GNSS-SDR.SUPL_glo_ephemeris_xml", eph_glo_gnav_default_xml_filename_);
-    std::string glo_utc_xml_filename = configuration_->property("GNSS-SDR.SUPL_glo_utc_model_xml", glo_utc_default_xml_filename_);
-    std::string gal_almanac_xml_filename = configuration_->property("GNSS-SDR.SUPL_gal_almanac_xml", gal_almanac_default_xml_filename_);
-    std::string gps_almanac_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_almanac_xml", gps_almanac_default_xml_filename_);
-
-    if (configuration_->property("GNSS-SDR.AGNSS_XML_enabled", false) == true)
-        {
-            eph_xml_filename = configuration_->property("GNSS-SDR.AGNSS_gps_ephemeris_xml", eph_default_xml_filename_);
-            utc_xml_filename = configuration_->property("GNSS-SDR.AGNSS_gps_utc_model_xml", utc_default_xml_filename_);
-            iono_xml_filename = configuration_->property("GNSS-SDR.AGNSS_gps_iono_xml", iono_default_xml_filename_);
-            gal_iono_xml_filename = configuration_->property("GNSS-SDR.AGNSS_gal_iono_xml", gal_iono_default_xml_filename_);
-            ref_time_xml_filename = configuration_->property("GNSS-SDR.AGNSS_gps_ref_time_xml", ref_time_default_xml_filename_);
-            ref_location_xml_filename = configuration_->property("GNSS-SDR.AGNSS_gps_ref_location_xml", ref_location_default_xml_filename_);
-            eph_gal_xml_filename = configuration_->property("GNSS-SDR.AGNSS_gal_ephemeris_xml", eph_gal_default_xml_filename_);
-            eph_cnav_xml_filename = configuration_->property("GNSS-SDR.AGNSS_gps_cnav_ephemeris_xml", eph_cnav_default_xml_filename_);
-            gal_utc_xml_filename = configuration_->property("GNSS-SDR.AGNSS_gal_utc_model_xml", gal_utc_default_xml_filename_);
-            cnav_utc_xml_filename = configuration_->property("GNSS-SDR.AGNSS_cnav_utc_model_xml", cnav_utc_default_xml_filename_);
-            eph_glo_xml_filename = configuration_->property("GNSS-SDR.AGNSS_glo_ephemeris_xml", eph_glo_gnav_default_xml_filename_);
-            glo_utc_xml_filename = configuration_->property("GNSS-SDR.AGNSS_glo_utc_model_xml", glo_utc_default_xml_filename_);
-            gal_almanac_xml_filename = configuration_->property("GNSS-SDR.AGNSS_gal_almanac_xml", gal_almanac_default_xml_filename_);
-            gps_almanac_xml_filename = configuration_->property("GNSS-SDR.AGNSS_gps_almanac_xml", gps_almanac_default_xml_filename_);
-        }
-
     std::cout << "Trying to read GNSS ephemeris from XML file(s)...\n";
 
     if (configuration_->property("Channels_1C.count", 0) > 0)
         {
-            if (supl_client_ephemeris_.load_ephemeris_xml(eph_xml_filename) == true)
+            if (supl_client_ephemeris_.load_ephemeris_xml(eph_xml_filename_) == true)
                 {
                     std::map<int, Gps_Ephemeris>::const_iterator gps_eph_iter;
                     for (gps_eph_iter = supl_client_ephemeris_.gps_ephemeris_map.cbegin();
@@ -519,7 +497,7 @@ bool ControlThread::read_assistance_from_XML()
                     ret = true;
                 }
 
-            if (supl_client_acquisition_.load_utc_xml(utc_xml_filename) == true)
+            if (supl_client_acquisition_.load_utc_xml(utc_xml_filename_) == true)
                 {
                     const std::shared_ptr<Gps_Utc_Model> tmp_obj = std::make_shared<Gps_Utc_Model>(supl_client_acquisition_.gps_utc);
                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
@@ -527,7 +505,7 @@ bool ControlThread::read_assistance_from_XML()
                     ret = true;
                 }
 
-            if (supl_client_acquisition_.load_iono_xml(iono_xml_filename) == true)
+            if (supl_client_acquisition_.load_iono_xml(iono_xml_filename_) == true)
                 {
                     const std::shared_ptr<Gps_Iono> tmp_obj = std::make_shared<Gps_Iono>(supl_client_acquisition_.gps_iono);
                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
@@ -535,7 +513,7 @@ bool ControlThread::read_assistance_from_XML()
                     ret = true;
                 }
 
-            if (supl_client_ephemeris_.load_gps_almanac_xml(gps_almanac_xml_filename) == true)
+            if (supl_client_ephemeris_.load_gps_almanac_xml(gps_almanac_xml_filename_) == true)
                 {
                     std::map<int, Gps_Almanac>::const_iterator gps_alm_iter;
                     for (gps_alm_iter = supl_client_ephemeris_.gps_almanac_map.cbegin();
@@ -552,7 +530,7 @@ bool ControlThread::read_assistance_from_XML()
 
     if ((configuration_->property("Channels_1B.count", 0) > 0) or (configuration_->property("Channels_5X.count", 0) > 0))
         {
-            if (supl_client_ephemeris_.load_gal_ephemeris_xml(eph_gal_xml_filename) == true)
+            if (supl_client_ephemeris_.load_gal_ephemeris_xml(eph_gal_xml_filename_) == true)
                 {
                     std::map<int, Galileo_Ephemeris>::const_iterator gal_eph_iter;
                     for (gal_eph_iter = supl_client_ephemeris_.gal_ephemeris_map.cbegin();
@@ -566,7 +544,7 @@ bool ControlThread::read_assistance_from_XML()
                     ret = true;
                 }
 
-            if (supl_client_acquisition_.load_gal_iono_xml(gal_iono_xml_filename) == true)
+            if (supl_client_acquisition_.load_gal_iono_xml(gal_iono_xml_filename_) == true)
                 {
                     const std::shared_ptr<Galileo_Iono> tmp_obj = std::make_shared<Galileo_Iono>(supl_client_acquisition_.gal_iono);
                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
@@ -574,7 +552,7 @@ bool ControlThread::read_assistance_from_XML()
                     ret = true;
                 }
 
-            if (supl_client_acquisition_.load_gal_utc_xml(gal_utc_xml_filename) == true)
+            if (supl_client_acquisition_.load_gal_utc_xml(gal_utc_xml_filename_) == true)
                 {
                     const std::shared_ptr<Galileo_Utc_Model> tmp_obj = std::make_shared<Galileo_Utc_Model>(supl_client_acquisition_.gal_utc);
                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
@@ -582,7 +560,7 @@ bool ControlThread::read_assistance_from_XML()
                     ret = true;
                 }
 
-            if (supl_client_ephemeris_.load_gal_almanac_xml(gal_almanac_xml_filename) == true)
+            if (supl_client_ephemeris_.load_gal_almanac_xml(gal_almanac_xml_filename_) == true)
                 {
                     std::map<int, Galileo_Almanac>::const_iterator gal_alm_iter;
                     for (gal_alm_iter = supl_client_ephemeris_.gal_almanac_map.cbegin();
@@ -599,7 +577,7 @@ bool ControlThread::read_assistance_from_XML()
 
     if ((configuration_->property("Channels_2S.count", 0) > 0) or (configuration_->property("Channels_L5.count", 0) > 0))
         {
-            if (supl_client_ephemeris_.load_cnav_ephemeris_xml(eph_cnav_xml_filename) == true)
+            if (supl_client_ephemeris_.load_cnav_ephemeris_xml(eph_cnav_xml_filename_) == true)
                 {
                     std::map<int, Gps_CNAV_Ephemeris>::const_iterator gps_cnav_eph_iter;
                     for (gps_cnav_eph_iter = supl_client_ephemeris_.gps_cnav_ephemeris_map.cbegin();
@@ -613,7 +591,7 @@ bool ControlThread::read_assistance_from_XML()
                     ret = true;
                 }
 
-            if (supl_client_acquisition_.load_cnav_utc_xml(cnav_utc_xml_filename) == true)
+            if (supl_client_acquisition_.load_cnav_utc_xml(cnav_utc_xml_filename_) == true)
                 {
                     const std::shared_ptr<Gps_CNAV_Utc_Model> tmp_obj = std::make_shared<Gps_CNAV_Utc_Model>(supl_client_acquisition_.gps_cnav_utc);
                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
@@ -624,7 +602,7 @@ bool ControlThread::read_assistance_from_XML()
 
     if ((configuration_->property("Channels_1G.count", 0) > 0) or (configuration_->property("Channels_2G.count", 0) > 0))
         {
-            if (supl_client_ephemeris_.load_gnav_ephemeris_xml(eph_glo_xml_filename) == true)
+            if (supl_client_ephemeris_.load_gnav_ephemeris_xml(eph_glo_xml_filename_) == true)
                 {
                     std::map<int, Glonass_Gnav_Ephemeris>::const_iterator glo_gnav_eph_iter;
                     for (glo_gnav_eph_iter = supl_client_ephemeris_.glonass_gnav_ephemeris_map.cbegin();
@@ -638,7 +616,7 @@ bool ControlThread::read_assistance_from_XML()
                     ret = true;
                 }
 
-            if (supl_client_acquisition_.load_glo_utc_xml(glo_utc_xml_filename) == true)
+            if (supl_client_acquisition_.load_glo_utc_xml(glo_utc_xml_filename_) == true)
                 {
                     const std::shared_ptr<Glonass_Gnav_Utc_Model> tmp_obj = std::make_shared<Glonass_Gnav_Utc_Model>(supl_client_acquisition_.glo_gnav_utc);
                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
@@ -654,11 +632,10 @@ bool ControlThread::read_assistance_from_XML()
         }
 
     // Only look for {ref time, ref location} if SUPL is enabled
-    const bool enable_gps_supl_assistance = configuration_->property("GNSS-SDR.SUPL_gps_enabled", false);
-    if (enable_gps_supl_assistance == true)
+    if (enable_gps_supl_assistance_ == true)
         {
             // Try to read Ref Time from XML
-            if (supl_client_acquisition_.load_ref_time_xml(ref_time_xml_filename) == true)
+            if (supl_client_acquisition_.load_ref_time_xml(ref_time_xml_filename_) == true)
                 {
                     LOG(INFO) << "SUPL: Read XML Ref Time";
                     const std::shared_ptr<Agnss_Ref_Time> tmp_obj = std::make_shared<Agnss_Ref_Time>(supl_client_acquisition_.gps_time);
@@ -670,7 +647,7 @@ bool ControlThread::read_assistance_from_XML()
                 }
 
             // Try to read Ref Location from XML
-            if (supl_client_acquisition_.load_ref_location_xml(ref_location_xml_filename) == true)
+            if (supl_client_acquisition_.load_ref_location_xml(ref_location_xml_filename_) == true)
                 {
                     LOG(INFO) << "SUPL: Read XML Ref Location";
                     const std::shared_ptr<Agnss_Ref_Location> tmp_obj = std::make_shared<Agnss_Ref_Location>(supl_client_acquisition_.gps_ref_loc);
@@ -686,15 +663,48 @@ bool ControlThread::read_assistance_from_XML()
 }
 
 
-void ControlThread::assist_GNSS()
+void ControlThread::read_assistance_configuration()
 {
-    // ######### GNSS Assistance #################################
-    // GNSS Assistance configuration
-    const bool enable_gps_supl_assistance = configuration_->property("GNSS-SDR.SUPL_gps_enabled", false);
-    const bool enable_agnss_xml = configuration_->property("GNSS-SDR.AGNSS_XML_enabled", false);
-    if ((enable_gps_supl_assistance == true) and (enable_agnss_xml == false))
+    enable_gps_supl_assistance_ = configuration_->property("GNSS-SDR.SUPL_gps_enabled", false);
+    enable_agnss_xml_ = configuration_->property("GNSS-SDR.AGNSS_XML_enabled", false);
+
+    // getting names from the config file, if available
+    eph_xml_filename_ = configuration_->property("GNSS-SDR.SUPL_gps_ephemeris_xml", eph_default_xml_filename_);
+    utc_xml_filename_ = configuration_->property("GNSS-SDR.SUPL_gps_utc_model_xml", utc_default_xml_filename_);
+    iono_xml_filename_ = configuration_->property("GNSS-SDR.SUPL_gps_iono_xml", iono_default_xml_filename_);
+    gal_iono_xml_filename_ = configuration_->property("GNSS-SDR.SUPL_gal_iono_xml", gal_iono_default_xml_filename_);
+    ref_time_xml_filename_ = configuration_->property("GNSS-SDR.SUPL_gps_ref_time_xml", ref_time_default_xml_filename_);
+    ref_location_xml_filename_ = configuration_->property("GNSS-SDR.SUPL_gps_ref_location_xml", ref_location_default_xml_filename_);
+    eph_gal_xml_filename_ = configuration_->property("GNSS-SDR.SUPL_gal_ephemeris_xml", eph_gal_default_xml_filename_);
+    eph_cnav_xml_filename_ = configuration_->property("GNSS-SDR.SUPL_gps_cnav_ephemeris_xml", eph_cnav_default_xml_filename_);
+    gal_utc_xml_filename_ = configuration_->property("GNSS-SDR.SUPL_gal_utc_model_xml", gal_utc_default_xml_filename_);
+    cnav_utc_xml_filename_ = configuration_->property("GNSS-SDR.SUPL_cnav_utc_model_xml", cnav_utc_default_xml_filename_);
+    eph_glo_xml_filename_ = configuration_->property("GNSS-SDR.SUPL_glo_ephemeris_xml", eph_glo_gnav_default_xml_filename_);
+    glo_utc_xml_filename_ = configuration_->property("GNSS-SDR.SUPL_glo_utc_model_xml", glo_utc_default_xml_filename_);
+    gal_almanac_xml_filename_ = configuration_->property("GNSS-SDR.SUPL_gal_almanac_xml", gal_almanac_default_xml_filename_);
+    gps_almanac_xml_filename_ = configuration_->property("GNSS-SDR.SUPL_gps_almanac_xml", gps_almanac_default_xml_filename_);
+
+    if (enable_agnss_xml_ == true)
         {
-            std::cout << "SUPL RRLP GPS assistance enabled!\n";
+            eph_xml_filename_ = configuration_->property("GNSS-SDR.AGNSS_gps_ephemeris_xml", eph_default_xml_filename_);
+            utc_xml_filename_ = configuration_->property("GNSS-SDR.AGNSS_gps_utc_model_xml", utc_default_xml_filename_);
+            iono_xml_filename_ = configuration_->property("GNSS-SDR.AGNSS_gps_iono_xml", iono_default_xml_filename_);
+            gal_iono_xml_filename_ = configuration_->property("GNSS-SDR.AGNSS_gal_iono_xml", gal_iono_default_xml_filename_);
+            ref_time_xml_filename_ = configuration_->property("GNSS-SDR.AGNSS_gps_ref_time_xml", ref_time_default_xml_filename_);
+            ref_location_xml_filename_ = configuration_->property("GNSS-SDR.AGNSS_gps_ref_location_xml", ref_location_default_xml_filename_);
+            eph_gal_xml_filename_ = configuration_->property("GNSS-SDR.AGNSS_gal_ephemeris_xml", eph_gal_default_xml_filename_);
+            eph_cnav_xml_filename_ = configuration_->property("GNSS-SDR.AGNSS_gps_cnav_ephemeris_xml", eph_cnav_default_xml_filename_);
+            gal_utc_xml_filename_ = configuration_->property("GNSS-SDR.AGNSS_gal_utc_model_xml", gal_utc_default_xml_filename_);
+            cnav_utc_xml_filename_ = configuration_->property("GNSS-SDR.AGNSS_cnav_utc_model_xml", cnav_utc_default_xml_filename_);
+            eph_glo_xml_filename_ = configuration_->property("GNSS-SDR.AGNSS_glo_ephemeris_xml", eph_glo_gnav_default_xml_filename_);
+            glo_utc_xml_filename_ = configuration_->property("GNSS-SDR.AGNSS_glo_utc_model_xml", glo_utc_default_xml_filename_);
+            gal_almanac_xml_filename_ = configuration_->property("GNSS-SDR.AGNSS_gal_almanac_xml", gal_almanac_default_xml_filename_);
+            gps_almanac_xml_filename_ = configuration_->property("GNSS-SDR.AGNSS_gps_almanac_xml", gps_almanac_default_xml_filename_);
+        }
+
+    if ((enable_gps_supl_assistance_ == true) and (enable_agnss_xml_ == false))
+        {
+            supl_read_gps_assistance_xml_ = configuration_->property("GNSS-SDR.SUPL_read_gps_assistance_xml", false);
             const std::string default_acq_server("supl.google.com");
             const std::string default_eph_server("supl.google.com");
             supl_client_ephemeris_.server_name = configuration_->property("GNSS-SDR.SUPL_gps_ephemeris_server", default_acq_server);
@@ -736,9 +746,17 @@ void ControlThread::assist_GNSS()
                 {
                     supl_ci_ = 0x31b0;
                 }
+        }
+}
 
-            const bool SUPL_read_gps_assistance_xml = configuration_->property("GNSS-SDR.SUPL_read_gps_assistance_xml", false);
-            if (SUPL_read_gps_assistance_xml == true)
+
+void ControlThread::assist_GNSS()
+{
+    // ######### GNSS Assistance #################################
+    if ((enable_gps_supl_assistance_ == true) and (enable_agnss_xml_ == false))
+        {
+            std::cout << "SUPL RRLP GPS assistance enabled!\n";
+            if (supl_read_gps_assistance_xml_ == true)
                 {
                     // Read assistance from file
                     if (read_assistance_from_XML())
@@ -765,8 +783,7 @@ void ControlThread::assist_GNSS()
                                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
                                 }
                             // Save ephemeris to XML file
-                            const std::string eph_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_ephemeris_xml", eph_default_xml_filename_);
-                            if (supl_client_ephemeris_.save_ephemeris_map_xml(eph_xml_filename, supl_client_ephemeris_.gps_ephemeris_map) == true)
+                            if (supl_client_ephemeris_.save_ephemeris_map_xml(eph_xml_filename_, supl_client_ephemeris_.gps_ephemeris_map) == true)
                                 {
                                     std::cout << "SUPL: XML ephemeris data file created\n";
                                 }
@@ -815,8 +832,7 @@ void ControlThread::assist_GNSS()
                                     flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
                                 }
                             // Save iono and UTC model data to xml file
-                            const std::string iono_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_iono_xml", iono_default_xml_filename_);
-                            if (supl_client_ephemeris_.save_iono_xml(iono_xml_filename, supl_client_ephemeris_.gps_iono) == true)
+                            if (supl_client_ephemeris_.save_iono_xml(iono_xml_filename_, supl_client_ephemeris_.gps_iono) == true)
                                 {
                                     std::cout << "SUPL: Iono data file created\n";
                                 }
@@ -824,8 +840,7 @@ void ControlThread::assist_GNSS()
                                 {
                                     std::cout << "SUPL: Failed to create Iono data file\n";
                                 }
-                            const std::string utc_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_utc_model_xml", utc_default_xml_filename_);
-                            if (supl_client_ephemeris_.save_utc_xml(utc_xml_filename, supl_client_ephemeris_.gps_utc) == true)
+                            if (supl_client_ephemeris_.save_utc_xml(utc_xml_filename_, supl_client_ephemeris_.gps_utc) == true)
                                 {
                                     std::cout << "SUPL: UTC model data file created\n";
                                 }
@@ -880,7 +895,7 @@ void ControlThread::assist_GNSS()
                 }
         }
 
-    if ((enable_gps_supl_assistance == false) and (enable_agnss_xml == true))
+    if ((enable_gps_supl_assistance_ == false) and (enable_agnss_xml_ == true))
         {
             // read assistance from file
             if (read_assistance_from_XML())
@@ -890,7 +905,7 @@ void ControlThread::assist_GNSS()
         }
 
     // If AGNSS is enabled, make use of it
-    if ((agnss_ref_location_.valid == true) and ((enable_gps_supl_assistance == true) or (enable_agnss_xml == true)))
+    if ((agnss_ref_location_.valid == true) and ((enable_gps_supl_assistance_ == true) or (enable_agnss_xml_ == true)))
         {
             // Get the list of visible satellites
             std::array<float, 3> ref_LLH{};
@@ -907,6 +922,7 @@ void ControlThread::assist_GNSS()
             flowgraph_->apply_action(0, 10);
             // Give priority to visible satellites in the search list
             flowgraph_->priorize_satellites(visible_sats);
+            flowgraph_->set_acquisition_reference(ref_LLH, ref_rx_utc_time);
             // Hot Start
             flowgraph_->apply_action(0, 12);
         }
@@ -948,6 +964,7 @@ void ControlThread::apply_action(unsigned int what)
             visible_satellites = get_visible_sats(cmd_interface_.get_utc_time(), cmd_interface_.get_LLH());
             // reorder the satellite queue to acquire first those visible satellites
             flowgraph_->priorize_satellites(visible_satellites);
+            flowgraph_->set_acquisition_reference(cmd_interface_.get_LLH(), cmd_interface_.get_utc_time());
             // start again the satellite acquisitions
             receiver_on_standby_ = false;
             break;
@@ -963,6 +980,7 @@ void ControlThread::apply_action(unsigned int what)
             get_visible_sats(cmd_interface_.get_utc_time(), cmd_interface_.get_LLH());
             // reorder the satellite queue to acquire first those visible satellites
             flowgraph_->priorize_satellites(visible_satellites);
+            flowgraph_->set_acquisition_reference(cmd_interface_.get_LLH(), cmd_interface_.get_utc_time());
             // start again the satellite acquisitions
             receiver_on_standby_ = false;
             break;
@@ -150,6 +150,12 @@ private:
      */
     void assist_GNSS();
 
+    /*
+     * Read the GNSS assistance parameters, so that they are known before
+     * the flowgraph runs and the unused parameters are reported
+     */
+    void read_assistance_configuration();
+
     void telecommand_listener();
     void keyboard_listener();
     void sysv_queue_listener();
@@ -197,12 +203,29 @@ private:
     int supl_lac_;  // Current network LAC (Location area code),16 bits, 1-65520 are valid values.
     int supl_ci_;   // Cell Identity (16 bits, 0-65535 are valid values).
 
+    // assistance data filenames, as read from the configuration
+    std::string eph_xml_filename_;
+    std::string utc_xml_filename_;
+    std::string iono_xml_filename_;
+    std::string ref_time_xml_filename_;
+    std::string ref_location_xml_filename_;
+    std::string eph_gal_xml_filename_;
+    std::string eph_cnav_xml_filename_;
+    std::string gal_iono_xml_filename_;
+    std::string gal_utc_xml_filename_;
+    std::string cnav_utc_xml_filename_;
+    std::string eph_glo_xml_filename_;
+    std::string glo_utc_xml_filename_;
+    std::string gal_almanac_xml_filename_;
+    std::string gps_almanac_xml_filename_;
+
     Agnss_Ref_Location agnss_ref_location_;
     Agnss_Ref_Time agnss_ref_time_;
 
     unsigned int processed_control_messages_;
     unsigned int applied_actions_;
     int msqid_;
+    int telecommand_tcp_port_;
 
     bool well_formatted_configuration_;
     bool conf_file_has_section_;
@@ -214,6 +237,9 @@ private:
     bool stop_;
     bool restart_;
     bool telecommand_enabled_;
+    bool enable_gps_supl_assistance_;
+    bool enable_agnss_xml_;
+    bool supl_read_gps_assistance_xml_;
     bool pre_2009_file_;  // to override the system time to postprocess old gnss records and avoid wrong week rollover
 };
 
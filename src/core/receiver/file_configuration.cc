@@ -22,10 +22,38 @@
 #include "file_configuration.h"
 #include "gnss_sdr_make_unique.h"
 #include <glog/logging.h>
+#include <algorithm>  // for std::sort
+#include <cctype>     // for tolower
 #include <iostream>
 #include <utility>
 
 
+namespace
+{
+// Type flags of the cached conversions
+const uint16_t BOOL_TYPE = 0x0001;
+const uint16_t INT64_TYPE = 0x0002;
+const uint16_t UINT64_TYPE = 0x0004;
+const uint16_t INT32_TYPE = 0x0008;
+const uint16_t UINT32_TYPE = 0x0010;
+const uint16_t INT16_TYPE = 0x0020;
+const uint16_t UINT16_TYPE = 0x0040;
+const uint16_t FLOAT_TYPE = 0x0080;
+const uint16_t DOUBLE_TYPE = 0x0100;
+
+// INIReader names are case-insensitive
+std::string lower_case(const std::string& name)
+{
+    std::string key(name);
+    for (char& c : key)
+        {
+            c = static_cast<char>(tolower(c));
+        }
+    return key;
+}
+}  // namespace
+
+
 FileConfiguration::FileConfiguration(std::string filename)
     : filename_(std::move(filename))
 {
@@ -58,6 +86,10 @@ void FileConfiguration::init()
         {
             std::cerr << "Unable to open configuration file " << filename_ << '\n';
         }
+    for (const auto& it : ini_reader_->GetSection("GNSS-SDR"))
+        {
+            properties_[it.first].value = it.second;
+        }
 }
 
 
@@ -67,13 +99,51 @@ bool FileConfiguration::has_section() const
 }
 
 
+FileConfiguration::Property_Entry* FileConfiguration::find_entry(const std::string& property_name) const
+{
+    const auto it = properties_.find(lower_case(property_name));
+    if (it == properties_.end())
+        {
+            return nullptr;
+        }
+    it->second.used = true;
+    return &it->second;
+}
+
+
+template <typename T>
+T FileConfiguration::converted_property(const std::string& property_name,
+    T default_value,
+    T Property_Entry::*cached_value,
+    uint16_t type_flag) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Property_Entry* entry = find_entry(property_name);
+    if (entry == nullptr)
+        {
+            return default_value;
+        }
+    if ((entry->converted_types & type_flag) == 0)
+        {
+            entry->converted_types |= type_flag;
+            if (converter_->try_convert(entry->value, entry->*cached_value))
+                {
+                    entry->valid_types |= type_flag;
+                }
+        }
+    return (entry->valid_types & type_flag) ? entry->*cached_value : default_value;
+}
+
+
 std::string FileConfiguration::property(std::string property_name, std::string default_value) const
 {
     if (overrided_->is_present(property_name))
         {
             return overrided_->property(property_name, default_value);
         }
-    return ini_reader_->Get("GNSS-SDR", property_name, default_value);
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Property_Entry* entry = find_entry(property_name);
+    return entry == nullptr ? default_value : entry->value;
 }
 
 
@@ -83,8 +153,7 @@ bool FileConfiguration::property(std::string property_name, bool default_value)
         {
             return overrided_->property(property_name, default_value);
         }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return converted_property(property_name, default_value, &Property_Entry::bool_value, BOOL_TYPE);
 }
 
 
@@ -94,8 +163,7 @@ int64_t FileConfiguration::property(std::string property_name, int64_t default_v
         {
             return overrided_->property(property_name, default_value);
         }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return converted_property(property_name, default_value, &Property_Entry::int64_value, INT64_TYPE);
 }
 
 
@@ -105,8 +173,7 @@ uint64_t FileConfiguration::property(std::string property_name, uint64_t default
         {
             return overrided_->property(property_name, default_value);
         }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return converted_property(property_name, default_value, &Property_Entry::uint64_value, UINT64_TYPE);
 }
 
 
@@ -116,8 +183,7 @@ int FileConfiguration::property(std::string property_name, int default_value) co
         {
             return overrided_->property(property_name, default_value);
         }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return converted_property(property_name, default_value, &Property_Entry::int32_value, INT32_TYPE);
 }
 
 
@@ -127,8 +193,7 @@ unsigned int FileConfiguration::property(std::string property_name, unsigned int
         {
             return overrided_->property(property_name, default_value);
         }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return converted_property(property_name, default_value, &Property_Entry::uint32_value, UINT32_TYPE);
 }
 
 
@@ -138,8 +203,7 @@ uint16_t FileConfiguration::property(std::string property_name, uint16_t default
         {
             return overrided_->property(property_name, default_value);
         }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return converted_property(property_name, default_value, &Property_Entry::uint16_value, UINT16_TYPE);
 }
 
 
@@ -149,8 +213,7 @@ int16_t FileConfiguration::property(std::string property_name, int16_t default_v
         {
             return overrided_->property(property_name, default_value);
         }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return converted_property(property_name, default_value, &Property_Entry::int16_value, INT16_TYPE);
 }
 
 
@@ -160,8 +223,7 @@ float FileConfiguration::property(std::string property_name, float default_value
         {
             return overrided_->property(property_name, default_value);
         }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return converted_property(property_name, default_value, &Property_Entry::float_value, FLOAT_TYPE);
 }
 
 
@@ -171,8 +233,7 @@ double FileConfiguration::property(std::string property_name, double default_val
         {
             return overrided_->property(property_name, default_value);
         }
-    const std::string empty;
-    return converter_->convert(property(property_name, empty), default_value);
+    return converted_property(property_name, default_value, &Property_Entry::double_value, DOUBLE_TYPE);
 }
 
 
@@ -186,3 +247,19 @@ bool FileConfiguration::is_present(const std::string& property_name) const
 {
     return (overrided_->is_present(property_name));
 }
+
+
+std::vector<std::string> FileConfiguration::unused_properties() const
+{
+    std::vector<std::string> unused;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& it : properties_)
+        {
+            if (!it.second.used)
+                {
+                    unused.push_back(it.first);
+                }
+        }
+    std::sort(unused.begin(), unused.end());
+    return unused;
+}
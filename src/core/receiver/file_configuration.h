@@ -28,7 +28,10 @@
 #include "string_converter.h"
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 /** \addtogroup Core
  * \{ */
@@ -44,6 +47,11 @@
  * for the values of the parameters.
  * The file is in the INI format, containing sections and pairs of names and values.
  * For more information about the INI format, see https://en.wikipedia.org/wiki/INI_file
+ *
+ * The file is parsed once into a table of values. Each value is converted to
+ * a given type only the first time it is requested as that type, and the
+ * table keeps track of the values that have been requested, so that
+ * unused_properties() can report misspelled or obsolete parameters.
  */
 class FileConfiguration : public ConfigurationInterface
 {
@@ -65,8 +73,41 @@ public:
     bool is_present(const std::string& property_name) const;
     bool has_section() const;
 
+    /*!
+     * \brief Parameters in the configuration file that have not been
+     * requested so far
+     */
+    std::vector<std::string> unused_properties() const;
+
 private:
+    struct Property_Entry
+    {
+        std::string value;
+        uint16_t converted_types{0};  // types whose conversion has been attempted
+        uint16_t valid_types{0};      // types whose conversion succeeded
+        bool used{false};
+        bool bool_value{};
+        int64_t int64_value{};
+        uint64_t uint64_value{};
+        int32_t int32_value{};
+        uint32_t uint32_value{};
+        int16_t int16_value{};
+        uint16_t uint16_value{};
+        float float_value{};
+        double double_value{};
+    };
+
     void init();
+    Property_Entry* find_entry(const std::string& property_name) const;
+
+    template <typename T>
+    T converted_property(const std::string& property_name,
+        T default_value,
+        T Property_Entry::*cached_value,
+        uint16_t type_flag) const;
+
+    mutable std::unordered_map<std::string, Property_Entry> properties_;  // keyed by lower case name
+    mutable std::mutex mutex_;
     std::string filename_;
     std::unique_ptr<INIReader> ini_reader_;
     std::unique_ptr<InMemoryConfiguration> overrided_;
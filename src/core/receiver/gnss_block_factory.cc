@@ -97,6 +97,7 @@
 #include "labsat_signal_source.h"
 #include "mmse_resampler_conditioner.h"
 #include "multichannel_file_signal_source.h"
+#include "multisat_signal_source.h"
 #include "notch_filter.h"
 #include "notch_filter_lite.h"
 #include "nsr_file_signal_source.h"
@@ -121,6 +122,10 @@
 #include "custom_udp_signal_source.h"
 #endif
 
+#if UDP_SOCKET
+#include "udp_socket_signal_source.h"
+#endif
+
 #if ENABLE_FPGA
 #include "galileo_e1_dll_pll_veml_tracking_fpga.h"
 #include "galileo_e1_pcps_ambiguous_acquisition_fpga.h"
@@ -674,6 +679,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                         out_streams, queue);
                     block = std::move(block_);
                 }
+            else if (implementation == "Multisat_Signal_Source")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<MultisatSignalSource>(configuration, role, in_streams,
+                        out_streams, queue);
+                    block = std::move(block_);
+                }
 #if RAW_UDP
             else if (implementation == "Custom_UDP_Signal_Source")
                 {
@@ -681,6 +692,14 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                         out_streams, queue);
                     block = std::move(block_);
                 }
+#endif
+#if UDP_SOCKET
+            else if (implementation == "UDP_Socket_Signal_Source")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<UdpSocketSignalSource>(configuration, role, in_streams,
+                        out_streams, queue);
+                    block = std::move(block_);
+                }
 #endif
             else if (implementation == "Nsr_File_Signal_Source")
                 {
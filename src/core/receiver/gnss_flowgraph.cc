@@ -35,29 +35,35 @@
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_make_unique.h"
+#include "gnss_sdr_sample_ring_sink.h"
+#include "gnss_sdr_sample_ring_source.h"
 #include "gnss_synchro_monitor.h"
 #include "nav_message_monitor.h"
+#include "pcps_acquisition.h"
 #include "signal_source_interface.h"
-#include <boost/lexical_cast.hpp>    // for boost::lexical_cast
-#include <boost/tokenizer.hpp>       // for boost::tokenizer
-#include <glog/logging.h>            // for LOG
-#include <gnuradio/basic_block.h>    // for basic_block
-#include <gnuradio/filter/firdes.h>  // for gr::filter::firdes
-#include <gnuradio/io_signature.h>   // for io_signature
-#include <gnuradio/top_block.h>      // for top_block, make_top_block
-#include <pmt/pmt_sugar.h>           // for mp
-#include <algorithm>                 // for transform, sort, unique
-#include <cmath>                     // for floor
-#include <cstddef>                   // for size_t
-#include <exception>                 // for exception
-#include <iostream>                  // for operator<<
-#include <iterator>                  // for insert_iterator, inserter
-#include <memory>                    // for std::shared_ptr
-#include <set>                       // for set
-#include <sstream>                   // for std::stringstream
-#include <stdexcept>                 // for invalid_argument
-#include <thread>                    // for std::thread
-#include <utility>                   // for std::move
+#include <boost/lexical_cast.hpp>     // for boost::lexical_cast
+#include <boost/tokenizer.hpp>        // for boost::tokenizer
+#include <glog/logging.h>             // for LOG
+#include <gnuradio/basic_block.h>     // for basic_block
+#include <gnuradio/block.h>           // for block
+#include <gnuradio/block_detail.h>    // for block_detail
+#include <gnuradio/filter/firdes.h>   // for gr::filter::firdes
+#include <gnuradio/high_res_timer.h>  // for high_res_timer_tps
+#include <gnuradio/io_signature.h>    // for io_signature
+#include <gnuradio/top_block.h>       // for top_block, make_top_block
+#include <pmt/pmt_sugar.h>            // for mp
+#include <algorithm>                  // for transform, sort, unique
+#include <cmath>                      // for floor, ceil
+#include <cstddef>                    // for size_t
+#include <exception>                  // for exception
+#include <iostream>                   // for operator<<
+#include <iterator>                   // for insert_iterator, inserter
+#include <memory>                     // for std::shared_ptr
+#include <set>                        // for set
+#include <sstream>                    // for std::stringstream
+#include <stdexcept>                  // for invalid_argument
+#include <thread>                     // for std::thread
+#include <utility>                    // for std::move
 
 #ifdef GR_GREATER_38
 #include <gnuradio/filter/fir_filter_blk.h>
@@ -150,6 +156,16 @@ void GNSSFlowgraph::init()
 
     pvt_ = block_factory->GetPVT(configuration_.get());
 
+    // Almanac and ephemeris aided satellite search
+    acq_scheduler_update_period_s_ = configuration_->property("GNSS-SDR.acquisition_scheduler_update_period_s", 10);
+    if (configuration_->property("GNSS-SDR.acquisition_scheduler", false))
+        {
+            acq_scheduler_ = std::make_unique<Acquisition_Scheduler>(configuration_->property("GNSS-SDR.acquisition_scheduler_eph_doppler_margin_hz", 250.0),
+                configuration_->property("GNSS-SDR.acquisition_scheduler_alm_doppler_margin_hz", 1000.0),
+                configuration_->property("GNSS-SDR.acquisition_scheduler_elevation_mask_deg", 5.0),
+                configuration_->property("GNSS-SDR.pre_2009_file", false));
+        }
+
     auto channels = block_factory->GetChannels(configuration_.get(), queue_.get());
 
     channels_count_ = static_cast<int>(channels->size());
@@ -161,6 +177,12 @@ void GNSSFlowgraph::init()
 
     top_block_ = gr::make_top_block("GNSSFlowgraph");
 
+    // Processor cores, buffer sizes and priorities of the block threads
+    if (configuration_->property("GNSS-SDR.block_placement", false))
+        {
+            block_placement_ = std::make_unique<Block_Placement_Policy>(configuration_.get(), channels_count_);
+        }
+
     mapStringValues_["1C"] = evGPS_1C;
     mapStringValues_["2S"] = evGPS_2S;
     mapStringValues_["L5"] = evGPS_L5;
@@ -272,6 +294,9 @@ void GNSSFlowgraph::start()
             return;
         }
 
+    block_load_.clear();
+    processed_samples_ = 0;
+    start_time_ = std::chrono::steady_clock::now();
     try
         {
             top_block_->start();
@@ -309,6 +334,10 @@ void GNSSFlowgraph::stop()
             top_block_->wait();
         }
 
+    if (running_)
+        {
+            capture_block_load();
+        }
     running_ = false;
 }
 
@@ -322,6 +351,7 @@ void GNSSFlowgraph::wait()
         }
     top_block_->wait();
     DLOG(INFO) << "Flowgraph finished calculations";
+    capture_block_load();
     running_ = false;
 }
 
@@ -475,6 +505,9 @@ int GNSSFlowgraph::connect_desktop_flowgraph()
                     return 1;
                 }
         }
+
+    apply_block_placement();
+
     // Activate acquisition in enabled channels
     for (int i = 0; i < channels_count_; i++)
         {
@@ -942,6 +975,7 @@ int GNSSFlowgraph::connect_signal_sources_to_signal_conditioners()
 
 int GNSSFlowgraph::connect_signal_conditioners_to_channels()
 {
+    sample_rings_.clear();
     for (int i = 0; i < channels_count_; i++)
         {
             int selected_signal_conditioner_ID = 0;
@@ -1050,21 +1084,18 @@ int GNSSFlowgraph::connect_signal_conditioners_to_channels()
                                         {
                                             LOG(INFO) << "Disabled acquisition resampler because the input sampling frequency is too low";
                                             // resampler not required!
-                                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
-                                                channels_.at(i)->get_left_block_acq(), 0);
+                                            connect_acquisition_input(i, selected_signal_conditioner_ID);
                                         }
                                 }
                             else
                                 {
                                     LOG(INFO) << "Disabled acquisition resampler because the input sampling frequency is too low";
-                                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
-                                        channels_.at(i)->get_left_block_acq(), 0);
+                                    connect_acquisition_input(i, selected_signal_conditioner_ID);
                                 }
                         }
                     else
                         {
-                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
-                                channels_.at(i)->get_left_block_acq(), 0);
+                            connect_acquisition_input(i, selected_signal_conditioner_ID);
                         }
                     top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
                         channels_.at(i)->get_left_block_trk(), 0);
@@ -1083,6 +1114,44 @@ int GNSSFlowgraph::connect_signal_conditioners_to_channels()
 }
 
 
+void GNSSFlowgraph::connect_acquisition_input(int channel, int signal_conditioner_ID)
+{
+    const auto conditioner_block = sig_conditioner_.at(signal_conditioner_ID)->get_right_block();
+    // Only pcps_acquisition keeps its sample stamps across skipped samples
+    const bool tolerates_gaps = dynamic_cast<pcps_acquisition*>(channels_.at(channel)->get_left_block_acq().get()) != nullptr;
+    if (!tolerates_gaps or !configuration_->property("GNSS-SDR.sample_distribution", false))
+        {
+            top_block_->connect(conditioner_block, 0, channels_.at(channel)->get_left_block_acq(), 0);
+            return;
+        }
+
+    // The acquisition reads the samples from a ring with its own cursor, so a
+    // slow search does not hold back the signal conditioner and the tracking
+    const size_t item_size = conditioner_block->output_signature()->sizeof_stream_item(0);
+    const double fs = configuration_->property("GNSS-SDR.internal_fs_sps", 0.0);
+    if (fs <= 0.0)
+        {
+            LOG(WARNING) << "GNSS-SDR.sample_distribution requires GNSS-SDR.internal_fs_sps";
+            top_block_->connect(conditioner_block, 0, channels_.at(channel)->get_left_block_acq(), 0);
+            return;
+        }
+    auto ring = sample_rings_.find(signal_conditioner_ID);
+    if (ring == sample_rings_.end())
+        {
+            const auto buffer_ms = configuration_->property("GNSS-SDR.sample_distribution_buffer_ms", 1000.0);
+            const auto capacity = static_cast<size_t>(std::ceil(fs * buffer_ms / 1000.0));
+            ring = sample_rings_.emplace(signal_conditioner_ID, std::make_shared<Gnss_Sdr_Sample_Ring>(item_size, std::max(capacity, static_cast<size_t>(1)))).first;
+            top_block_->connect(conditioner_block, 0, gnss_sdr_make_sample_ring_sink(ring->second, item_size), 0);
+            LOG(INFO) << "Sample distribution ring of " << ring->second->capacity() << " samples for signal conditioner "
+                      << signal_conditioner_ID << (ring->second->huge_pages() ? ", backed by huge pages" : "");
+        }
+    const auto max_lag_ms = configuration_->property("GNSS-SDR.sample_distribution_max_lag_ms", 750.0);
+    const auto max_lag_items = static_cast<uint64_t>(std::ceil(fs * max_lag_ms / 1000.0));
+    top_block_->connect(gnss_sdr_make_sample_ring_source(ring->second, item_size, max_lag_items, channel), 0,
+        channels_.at(channel)->get_left_block_acq(), 0);
+}
+
+
 int GNSSFlowgraph::connect_channels_to_observables()
 {
     for (int i = 0; i < channels_count_; i++)
@@ -1305,6 +1374,47 @@ int GNSSFlowgraph::connect_gal_e6_has()
 }
 
 
+void GNSSFlowgraph::apply_block_placement()
+{
+    if (!block_placement_)
+        {
+            return;
+        }
+    const auto place_adapter = [this](const std::string& role, const std::shared_ptr<GNSSBlockInterface>& adapter) {
+        const auto left_block = adapter->get_left_block();
+        const auto right_block = adapter->get_right_block();
+        block_placement_->place(role, left_block);
+        if (right_block != left_block)
+            {
+                block_placement_->place(role, right_block);
+            }
+    };
+
+    for (const auto& source : sig_source_)
+        {
+            block_placement_->place("SignalSource", source->get_right_block());
+        }
+    for (const auto& conditioner : sig_conditioner_)
+        {
+            place_adapter("SignalConditioner", conditioner);
+        }
+    for (int i = 0; i < channels_count_; i++)
+        {
+            std::set<gr::basic_block_sptr> channel_blocks = {channels_.at(i)->get_left_block_acq(),
+                channels_.at(i)->get_right_block_acq(),
+                channels_.at(i)->get_left_block_trk(),
+                channels_.at(i)->get_right_block_trk(),
+                channels_.at(i)->get_right_block()};
+            for (const auto& block : channel_blocks)
+                {
+                    block_placement_->place("Channels", block, i);
+                }
+        }
+    place_adapter("Observables", observables_);
+    place_adapter("PVT", pvt_);
+}
+
+
 void GNSSFlowgraph::check_signal_conditioners()
 {
     // check for unconnected signal conditioners and connect null_sinks
@@ -1322,6 +1432,59 @@ void GNSSFlowgraph::check_signal_conditioners()
 }
 
 
+void GNSSFlowgraph::capture_block_load()
+{
+    run_time_s_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+    block_load_.clear();
+    const auto ticks_per_second = static_cast<double>(gr::high_res_timer_tps());
+    const auto add_block = [this, ticks_per_second](const std::string& role, const gr::basic_block_sptr& block) {
+        auto* gr_block = dynamic_cast<gr::block*>(block.get());
+        if (gr_block == nullptr or gr_block->detail() == nullptr)
+            {
+                return;
+            }
+        Flowgraph_Block_Load load{};
+        load.name = role + " " + gr_block->name();
+        load.items_read = gr_block->detail()->ninputs() > 0 ? gr_block->nitems_read(0) : 0;
+        load.items_written = gr_block->detail()->noutputs() > 0 ? gr_block->nitems_written(0) : 0;
+        load.work_time_s = static_cast<double>(gr_block->pc_work_time_total()) / ticks_per_second;
+        block_load_.push_back(load);
+    };
+
+    for (const auto& source : sig_source_)
+        {
+            add_block(source->role(), source->get_right_block());
+        }
+    for (const auto& conditioner : sig_conditioner_)
+        {
+            add_block(conditioner->role(), conditioner->get_right_block());
+        }
+    for (const auto& channel : channels_)
+        {
+            std::set<gr::basic_block_sptr> channel_blocks = {channel->get_right_block_acq(),
+                channel->get_right_block_trk(),
+                channel->get_right_block()};
+            for (const auto& block : channel_blocks)
+                {
+                    add_block(channel->role(), block);
+                }
+        }
+    if (ch_out_sample_counter_)
+        {
+            add_block("Sample_Counter", ch_out_sample_counter_);
+            processed_samples_ = ch_out_sample_counter_->detail() ? ch_out_sample_counter_->nitems_read(0) : 0;
+        }
+    if (observables_)
+        {
+            add_block(observables_->role(), observables_->get_left_block());
+        }
+    if (pvt_)
+        {
+            add_block(pvt_->role(), pvt_->get_left_block());
+        }
+}
+
+
 int GNSSFlowgraph::assign_channels()
 {
     // Put channels fixed to a given satellite at the beginning of the vector, then the rest
@@ -1704,6 +1867,82 @@ void GNSSFlowgraph::remove_signal(const Gnss_Signal& gs)
 }
 
 
+// set the Doppler search window of the next acquisition in a channel
+void GNSSFlowgraph::assist_acquisition(unsigned int channel_id, bool assistance_available, float estimated_doppler)
+{
+    const std::string signal_str = channels_[channel_id]->get_signal().get_signal_str();
+    double predicted_doppler_hz = 0.0;
+    double uncertainty_hz = 0.0;
+    if (assistance_available == true and configuration_->property("GNSS-SDR.assist_dual_frequency_acq", multiband_))
+        {
+            channels_[channel_id]->assist_acquisition_doppler(project_doppler(signal_str, estimated_doppler));
+        }
+    else if (acq_scheduler_ and acq_scheduler_->predicted_doppler(channels_[channel_id]->get_signal(), predicted_doppler_hz, uncertainty_hz))
+        {
+            // narrowed search around the Doppler predicted from ephemeris or almanac data
+            channels_[channel_id]->assist_acquisition_doppler_window(project_doppler(signal_str, predicted_doppler_hz),
+                static_cast<uint32_t>(std::ceil(project_doppler(signal_str, uncertainty_hz))));
+        }
+    else
+        {
+            // set Doppler center to 0 Hz
+            channels_[channel_id]->assist_acquisition_doppler(0);
+        }
+}
+
+
+// refresh the acquisition scheduler predictions with the latest PVT solution
+void GNSSFlowgraph::update_acquisition_scheduler()
+{
+    const std::shared_ptr<PvtInterface> pvt_ptr = get_pvt();
+    double longitude_deg;
+    double latitude_deg;
+    double height_m;
+    double ground_speed_kmh;
+    double course_over_ground_deg;
+    time_t UTC_time;
+    if (pvt_ptr == nullptr or !pvt_ptr->get_latest_PVT(&longitude_deg, &latitude_deg, &height_m, &ground_speed_kmh, &course_over_ground_deg, &UTC_time))
+        {
+            // keep the last predictions
+            return;
+        }
+    const time_t elapsed_s = UTC_time - acq_scheduler_->last_update();
+    if (acq_scheduler_->last_update() != 0 and elapsed_s >= 0 and elapsed_s < acq_scheduler_update_period_s_)
+        {
+            return;
+        }
+    double clock_drift_ppm = 0.0;
+    pvt_ptr->get_latest_clock_drift(&clock_drift_ppm);
+    const std::array<float, 3> LLH = {static_cast<float>(latitude_deg), static_cast<float>(longitude_deg), static_cast<float>(height_m)};
+    update_acquisition_scheduler(LLH, UTC_time, clock_drift_ppm, 0.0);
+}
+
+
+void GNSSFlowgraph::update_acquisition_scheduler(const std::array<float, 3>& LLH, time_t rx_utc_time, double clock_drift_ppm, double clock_drift_uncertainty_ppm)
+{
+    const std::shared_ptr<PvtInterface> pvt_ptr = get_pvt();
+    acq_scheduler_->update(LLH, rx_utc_time, clock_drift_ppm, clock_drift_uncertainty_ppm,
+        pvt_ptr->get_gps_ephemeris(),
+        pvt_ptr->get_galileo_ephemeris(),
+        pvt_ptr->get_gps_almanac(),
+        pvt_ptr->get_galileo_almanac());
+    const std::vector<std::pair<int, Gnss_Satellite>> visible_satellites = acq_scheduler_->visible_satellites();
+    DLOG(INFO) << "Acquisition scheduler: " << visible_satellites.size() << " satellites predicted visible";
+    priorize_satellites(visible_satellites);
+}
+
+
+void GNSSFlowgraph::set_acquisition_reference(const std::array<float, 3>& LLH, time_t rx_utc_time)
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
+    if (acq_scheduler_ and get_pvt() != nullptr)
+        {
+            // the receiver clock drift is not known yet
+            update_acquisition_scheduler(LLH, rx_utc_time, 0.0, configuration_->property("GNSS-SDR.acquisition_scheduler_clock_drift_uncertainty_ppm", 1.0));
+        }
+}
+
+
 // project Doppler from primary frequency to secondary frequency
 double GNSSFlowgraph::project_doppler(const std::string& searched_signal, double primary_freq_doppler_hz)
 {
@@ -1730,6 +1969,10 @@ double GNSSFlowgraph::project_doppler(const std::string& searched_signal, double
 
 void GNSSFlowgraph::acquisition_manager(unsigned int who)
 {
+    if (acq_scheduler_)
+        {
+            update_acquisition_scheduler();
+        }
     unsigned int current_channel;
     for (int i = 0; i < channels_count_; i++)
         {
@@ -1775,15 +2018,7 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
                             DLOG(INFO) << "Channel " << current_channel
                                        << " Starting acquisition " << channels_[current_channel]->get_signal().get_satellite()
                                        << ", Signal " << channels_[current_channel]->get_signal().get_signal_str();
-                            if (assistance_available == true and configuration_->property("GNSS-SDR.assist_dual_frequency_acq", multiband_))
-                                {
-                                    channels_[current_channel]->assist_acquisition_doppler(project_doppler(channels_[current_channel]->get_signal().get_signal_str(), estimated_doppler));
-                                }
-                            else
-                                {
-                                    // set Doppler center to 0 Hz
-                                    channels_[current_channel]->assist_acquisition_doppler(0);
-                                }
+                            assist_acquisition(current_channel, assistance_available, estimated_doppler);
 #if ENABLE_FPGA
                             // create a task for the FPGA such that it doesn't stop the flow
                             std::thread tmp_thread(&ChannelInterface::start_acquisition, channels_[current_channel]);
@@ -1851,6 +2086,10 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
         case 0:
             gs = channels_[who]->get_signal();
             DLOG(INFO) << "Channel " << who << " ACQ FAILED satellite " << gs.get_satellite() << ", Signal " << gs.get_signal_str();
+            if (acq_scheduler_)
+                {
+                    acq_scheduler_->report_miss(gs);
+                }
             channels_state_[who] = 0;
             if (acq_channels_count_ > 0)
                 {
@@ -1867,6 +2106,10 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
         case 1:
             gs = channels_[who]->get_signal();
             DLOG(INFO) << "Channel " << who << " ACQ SUCCESS satellite " << gs.get_satellite();
+            if (acq_scheduler_)
+                {
+                    acq_scheduler_->report_hit(gs);
+                }
             // If the satellite is in the list of available ones, remove it.
             remove_signal(gs);
 
@@ -1889,6 +2132,10 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                     acq_channels_count_++;
                     DLOG(INFO) << "Channel " << who << " Starting acquisition " << gs.get_satellite() << ", Signal " << gs.get_signal_str();
                     channels_[who]->set_signal(channels_[who]->get_signal());
+                    if (acq_scheduler_)
+                        {
+                            assist_acquisition(who, false, 0.0);
+                        }
 
 #if ENABLE_FPGA
                     // create a task for the FPGA such that it doesn't stop the flow
@@ -1933,8 +2180,10 @@ void GNSSFlowgraph::priorize_satellites(const std::vector<std::pair<int, Gnss_Sa
 {
     size_t old_size;
     Gnss_Signal gs;
-    for (const auto& visible_satellite : visible_satellites)
+    // The list is sorted by priority: push it to the front of the queues from its end
+    for (auto it = visible_satellites.rbegin(); it != visible_satellites.rend(); ++it)
         {
+            const auto& visible_satellite = *it;
             if (visible_satellite.second.get_system() == "GPS")
                 {
                     gs = Gnss_Signal(visible_satellite.second, "1C");
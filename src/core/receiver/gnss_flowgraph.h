@@ -24,15 +24,22 @@
 #ifndef GNSS_SDR_GNSS_FLOWGRAPH_H
 #define GNSS_SDR_GNSS_FLOWGRAPH_H
 
+#include "acquisition_scheduler.h"
+#include "block_placement_policy.h"
 #include "channel_status_msg_receiver.h"
 #include "concurrent_queue.h"
 #include "galileo_e6_has_msg_receiver.h"
 #include "gnss_sdr_sample_counter.h"
+#include "gnss_sdr_sample_ring.h"
 #include "gnss_signal.h"
 #include "pvt_interface.h"
 #include <gnuradio/blocks/null_sink.h>  // for null_sink
 #include <gnuradio/runtime_types.h>     // for basic_block_sptr, top_block_sptr
 #include <pmt/pmt.h>                    // for pmt_t
+#include <array>                        // for array
+#include <chrono>                       // for steady_clock
+#include <cstdint>                      // for uint64_t
+#include <ctime>                        // for time_t
 #include <list>                         // for list
 #include <map>                          // for map
 #include <memory>                       // for for shared_ptr, dynamic_pointer_cast
@@ -56,6 +63,18 @@ class GNSSBlockInterface;
 class Gnss_Satellite;
 class SignalSourceInterface;
 
+/*!
+ * \brief Work done by a GNU Radio block of the flowgraph during a run.
+ */
+struct Flowgraph_Block_Load
+{
+    std::string name;        // role of the block and name of the GNU Radio block
+    uint64_t items_read;     // items consumed from the first input
+    uint64_t items_written;  // items produced on the first output
+    double work_time_s;      // time spent in work(), zero without GNU Radio performance counters
+};
+
+
 /*! \brief This class represents a GNSS flow graph.
  *
  * It contains a signal source,
@@ -155,6 +174,41 @@ public:
      */
     void priorize_satellites(const std::vector<std::pair<int, Gnss_Satellite>>& visible_satellites);
 
+    /*!
+     * \brief Refreshes the acquisition scheduler predictions for a receiver
+     * at LLH ([deg], [deg], [m]) at the given UTC time, and reorders the
+     * satellite search accordingly. It has no effect if
+     * GNSS-SDR.acquisition_scheduler is not enabled.
+     */
+    void set_acquisition_reference(const std::array<float, 3>& LLH, time_t rx_utc_time);
+
+    /*!
+     * \brief Items processed and time spent in work() by the blocks of the
+     * flowgraph during the last run, captured when it stops. The work time
+     * is only measured if GNU Radio performance counters are enabled.
+     */
+    const std::vector<Flowgraph_Block_Load>& block_load() const
+    {
+        return block_load_;
+    }
+
+    /*!
+     * \brief Samples delivered to the channels during the last run, as
+     * counted by the sample counter.
+     */
+    uint64_t processed_samples() const
+    {
+        return processed_samples_;
+    }
+
+    /*!
+     * \brief Wall time [s] of the last run, from start() to its end.
+     */
+    double run_time_s() const
+    {
+        return run_time_s_;
+    }
+
 #if ENABLE_FPGA
     void start_acquisition_helper();
 
@@ -175,6 +229,7 @@ private:
     int connect_signal_sources_to_signal_conditioners();
     int connect_signal_conditioners_to_channels();
     int connect_channels_to_observables();
+    void connect_acquisition_input(int channel, int signal_conditioner_ID);
     int connect_observables_to_pvt();
     int connect_monitors();
     int connect_gal_e6_has();
@@ -189,7 +244,9 @@ private:
 #endif
 
     int assign_channels();
+    void apply_block_placement();
     void check_signal_conditioners();
+    void capture_block_load();
 
     void set_signals_list();
     void set_channels_state();  // Initializes the channels state (start acquisition or keep standby)
@@ -206,6 +263,9 @@ private:
     void check_desktop_conf_in_fpga_env();
 
     double project_doppler(const std::string& searched_signal, double primary_freq_doppler_hz);
+    void assist_acquisition(unsigned int channel_id, bool assistance_available, float estimated_doppler);
+    void update_acquisition_scheduler();
+    void update_acquisition_scheduler(const std::array<float, 3>& LLH, time_t rx_utc_time, double clock_drift_ppm, double clock_drift_uncertainty_ppm);
     bool is_multiband() const;
 
     std::vector<std::string> split_string(const std::string& s, char delim);
@@ -223,12 +283,15 @@ private:
     std::shared_ptr<GNSSBlockInterface> pvt_;
 
     std::map<std::string, gr::basic_block_sptr> acq_resamplers_;
+    std::map<int, std::shared_ptr<Gnss_Sdr_Sample_Ring>> sample_rings_;  // one per signal conditioner
     std::vector<gr::blocks::null_sink::sptr> null_sinks_;
 
     gr::basic_block_sptr GnssSynchroMonitor_;
     gr::basic_block_sptr GnssSynchroAcquisitionMonitor_;
     gr::basic_block_sptr GnssSynchroTrackingMonitor_;
     gr::basic_block_sptr NavDataMonitor_;
+    std::unique_ptr<Acquisition_Scheduler> acq_scheduler_;
+    std::unique_ptr<Block_Placement_Policy> block_placement_;
     channel_status_msg_receiver_sptr channels_status_;  // class that receives and stores the current status of the receiver channels
     galileo_e6_has_msg_receiver_sptr gal_e6_has_rx_;
 
@@ -238,6 +301,8 @@ private:
 #endif
 
     std::vector<unsigned int> channels_state_;
+    std::vector<Flowgraph_Block_Load> block_load_;
+    std::chrono::steady_clock::time_point start_time_;
 
     std::list<Gnss_Signal> available_GPS_1C_signals_;
     std::list<Gnss_Signal> available_GPS_2S_signals_;
@@ -274,10 +339,13 @@ private:
 
     std::mutex signal_list_mutex_;
 
+    uint64_t processed_samples_{};
+    double run_time_s_{};
     int sources_count_;
     int channels_count_;
     int acq_channels_count_;
     int max_acq_channels_;
+    int acq_scheduler_update_period_s_;
 
     bool connected_;
     bool running_;
@@ -34,8 +34,8 @@ using CRC_Galileo_INAV_type = boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false
 Galileo_Inav_Message::Galileo_Inav_Message()
 {
     rs_buffer = std::vector<uint8_t>(INAV_RS_BUFFER_LENGTH, 0);
-    // Instantiate ReedSolomon without encoding capabilities, saves some memory
-    rs = std::make_unique<ReedSolomon>(60, 29, 1, 195, 0, 137);
+    // The generator matrix is used for erasure decoding
+    rs = std::make_unique<ReedSolomon>("E1B");
     inav_rs_pages = std::vector<int>(8, 0);
 }
 
@@ -323,8 +323,9 @@ bool Galileo_Inav_Message::have_new_ephemeris()  // Check if we have a new ephem
                                 }
                         }
 
-                    // Decode rs_buffer
-                    int result = rs->decode(rs_buffer, erasure_positions);
+                    // Decode rs_buffer. Received pages passed the CRC check,
+                    // so the missing ones are recovered as erasures
+                    int result = rs->decode_erasures(rs_buffer, erasure_positions);
 
                     // if decoding ok
                     if (result >= 0)
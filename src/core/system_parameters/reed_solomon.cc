@@ -16,9 +16,11 @@
  */
 
 #include "reed_solomon.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <utility>
 
 
 ReedSolomon::ReedSolomon(const std::string& gnss_signal)
@@ -482,6 +484,7 @@ ReedSolomon::ReedSolomon(const std::string& gnss_signal)
 
     init_log_tables();
     init_alpha_tables();
+    init_split_tables();
 }
 
 
@@ -571,6 +574,7 @@ ReedSolomon::ReedSolomon(int nroots,
 
     init_log_tables();
     init_alpha_tables();
+    init_split_tables();
 }
 
 
@@ -635,6 +639,69 @@ uint8_t ReedSolomon::galois_mul_table(uint8_t a, uint8_t b) const
 }
 
 
+uint8_t ReedSolomon::galois_inv(uint8_t a) const
+{
+    return d_alpha_to[mod255(d_symbols_per_block - d_index_of[a])];
+}
+
+
+void ReedSolomon::galois_mul_add(uint8_t k, const uint8_t* in, uint8_t* out, size_t length) const
+{
+    volk_gnsssdr_8u_x3_gf256_mul_add_8u(out, out, in, &d_split_tables[static_cast<size_t>(k) * 32], static_cast<unsigned int>(length));
+}
+
+
+bool ReedSolomon::galois_invert_matrix(std::vector<uint8_t>& matrix, size_t n) const
+{
+    // Gauss-Jordan elimination, with row operations on contiguous rows
+    std::vector<uint8_t> inverse(n * n, 0);
+    std::vector<uint8_t> scaled(2 * n);
+    for (size_t i = 0; i < n; i++)
+        {
+            inverse[i * n + i] = 1;
+        }
+
+    for (size_t col = 0; col < n; col++)
+        {
+            size_t pivot = col;
+            while (pivot < n && matrix[pivot * n + col] == 0)
+                {
+                    pivot++;
+                }
+            if (pivot == n)
+                {
+                    return false;
+                }
+            if (pivot != col)
+                {
+                    std::swap_ranges(matrix.begin() + pivot * n, matrix.begin() + (pivot + 1) * n, matrix.begin() + col * n);
+                    std::swap_ranges(inverse.begin() + pivot * n, inverse.begin() + (pivot + 1) * n, inverse.begin() + col * n);
+                }
+
+            // normalize the pivot row
+            const uint8_t k = galois_inv(matrix[col * n + col]);
+            std::fill(scaled.begin(), scaled.end(), 0);
+            galois_mul_add(k, &matrix[col * n], scaled.data(), n);
+            galois_mul_add(k, &inverse[col * n], scaled.data() + n, n);
+            std::copy(scaled.begin(), scaled.begin() + n, matrix.begin() + col * n);
+            std::copy(scaled.begin() + n, scaled.end(), inverse.begin() + col * n);
+
+            // and eliminate its column from the other rows
+            for (size_t row = 0; row < n; row++)
+                {
+                    const uint8_t factor = matrix[row * n + col];
+                    if (row != col && factor != 0)
+                        {
+                            galois_mul_add(factor, &matrix[col * n], &matrix[row * n], n);
+                            galois_mul_add(factor, &inverse[col * n], &inverse[row * n], n);
+                        }
+                }
+        }
+    matrix = std::move(inverse);
+    return true;
+}
+
+
 void ReedSolomon::init_log_tables()
 {
     d_log_table[0] = 0;  // dummy value
@@ -685,6 +752,21 @@ void ReedSolomon::init_alpha_tables()
 }
 
 
+void ReedSolomon::init_split_tables()
+{
+    // products of each field element by the 16 low nibbles and the 16 high nibbles
+    d_split_tables = std::vector<uint8_t>(256 * 32);
+    for (int k = 0; k < 256; k++)
+        {
+            for (int x = 0; x < 16; x++)
+                {
+                    d_split_tables[k * 32 + x] = galois_mul(k, x);
+                    d_split_tables[k * 32 + 16 + x] = galois_mul(k, x << 4);
+                }
+        }
+}
+
+
 std::vector<uint8_t> ReedSolomon::encode_with_generator_matrix(const std::vector<uint8_t>& data_to_encode) const
 {
     std::vector<uint8_t> encoded_output(d_data_symbols_shortened, 0);
@@ -808,6 +890,146 @@ int ReedSolomon::decode(std::vector<uint8_t>& data_to_decode, const std::vector<
 }
 
 
+int ReedSolomon::decode_erasures(std::vector<uint8_t>& data_to_decode, const std::vector<int>& erasure_positions) const
+{
+    return decode_erasures(data_to_decode, 1, erasure_positions);
+}
+
+
+int ReedSolomon::decode_erasures(std::vector<uint8_t>& block, size_t columns, const std::vector<int>& erasure_positions) const
+{
+    if (columns == 0 || block.size() != d_data_symbols_shortened * columns)
+        {
+            std::cerr << "Reed Solomon usage error: wrong block size in decode_erasures method.\n";
+            return -1;
+        }
+    const std::shared_ptr<const Erasure_Decoder> decoder = get_erasure_decoder(erasure_positions);
+    if (decoder == nullptr)
+        {
+            return -1;
+        }
+
+    const size_t k = d_info_symbols_shortened;
+    std::vector<uint8_t> info(k * columns, 0);
+    if (columns == 1)
+        {
+            // info += received symbol j * column j of the inverse
+            for (size_t j = 0; j < k; j++)
+                {
+                    const uint8_t symbol = block[decoder->known_rows[j]];
+                    if (symbol != 0)
+                        {
+                            galois_mul_add(symbol, &decoder->inverse_t[j * k], info.data(), k);
+                        }
+                }
+        }
+    else
+        {
+            // info row i += inverse(i, j) * received row j
+            for (size_t i = 0; i < k; i++)
+                {
+                    for (size_t j = 0; j < k; j++)
+                        {
+                            const uint8_t coefficient = decoder->inverse[i * k + j];
+                            if (coefficient != 0)
+                                {
+                                    galois_mul_add(coefficient, &block[decoder->known_rows[j] * columns], &info[i * columns], columns);
+                                }
+                        }
+                }
+        }
+    std::copy(info.begin(), info.end(), block.begin());
+    return static_cast<int>(erasure_positions.size());
+}
+
+
+std::shared_ptr<const ReedSolomon::Erasure_Decoder> ReedSolomon::get_erasure_decoder(const std::vector<int>& erasure_positions) const
+{
+    if (d_rows_G == 0)
+        {
+            std::cerr << "Reed Solomon usage problem: Generator matrix is not defined.\n";
+            return nullptr;
+        }
+
+    // Erasure positions refer to the unshortened code
+    std::vector<bool> erased(d_rows_G, false);
+    for (int position : erasure_positions)
+        {
+            int row = position;
+            if (position >= static_cast<int>(d_data_in_block))
+                {
+                    row = position - d_shortening;
+                }
+            else if (position >= static_cast<int>(d_info_symbols_shortened))
+                {
+                    row = -1;
+                }
+            if (row < 0 || row >= static_cast<int>(d_rows_G))
+                {
+                    std::cerr << "Reed Solomon usage error: wrong erasure position " << position << " in decode_erasures method.\n";
+                    return nullptr;
+                }
+            erased[row] = true;
+        }
+
+    const size_t k = d_columns_G;
+    std::vector<int> known_rows;
+    known_rows.reserve(k);
+    for (size_t row = 0; row < d_rows_G && known_rows.size() < k; row++)
+        {
+            if (!erased[row])
+                {
+                    known_rows.push_back(static_cast<int>(row));
+                }
+        }
+    if (known_rows.size() < k)
+        {
+            std::cerr << "Reed Solomon usage error: too much erasure positions.\n";
+            return nullptr;
+        }
+
+    {
+        std::lock_guard<std::mutex> lock(d_erasure_decoders_mutex);
+        const auto it = d_erasure_decoders.find(known_rows);
+        if (it != d_erasure_decoders.end())
+            {
+                return it->second;
+            }
+    }
+
+    std::vector<uint8_t> matrix(k * k);
+    for (size_t i = 0; i < k; i++)
+        {
+            std::copy(d_genmatrix[known_rows[i]].begin(), d_genmatrix[known_rows[i]].end(), matrix.begin() + i * k);
+        }
+    if (!galois_invert_matrix(matrix, k))
+        {
+            std::cerr << "Reed Solomon decoding error: singular generator submatrix.\n";
+            return nullptr;
+        }
+
+    auto decoder = std::make_shared<Erasure_Decoder>();
+    decoder->inverse_t = std::vector<uint8_t>(k * k);
+    for (size_t i = 0; i < k; i++)
+        {
+            for (size_t j = 0; j < k; j++)
+                {
+                    decoder->inverse_t[j * k + i] = matrix[i * k + j];
+                }
+        }
+    decoder->inverse = std::move(matrix);
+    decoder->known_rows = known_rows;
+
+    std::lock_guard<std::mutex> lock(d_erasure_decoders_mutex);
+    if (d_erasure_decoders.size() >= d_max_cached_inverses)
+        {
+            d_erasure_decoders.clear();
+        }
+    d_erasure_decoders[known_rows] = decoder;
+    return decoder;
+}
+
+
 int ReedSolomon::decode_rs_8(uint8_t* data, const int* eras_pos, int no_eras) const
 {
     int deg_lambda;
@@ -22,6 +22,9 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -101,6 +104,34 @@ public:
     int decode(std::vector<uint8_t>& data_to_decode,
         const std::vector<int>& erasure_positions = std::vector<int>{}) const;
 
+    /*!
+     * \brief Erasure-only decoding with the generator matrix.
+     *
+     * The information symbols are obtained from the first 255-nroots-shortening
+     * non-erased symbols, by inverting the corresponding rows of the generator
+     * matrix. Errors in the non-erased symbols are not corrected. Inverses are
+     * cached by erasure pattern, so that blocks with the same erasure
+     * positions only need a matrix product.
+     *
+     * The erasure positions follow the same convention as in decode(), and
+     * data_to_decode must have 255-shortening elements. Only the information
+     * symbols are written.
+     *
+     * Returns the number of erasures, or -1 if decoding failed or the
+     * generator matrix is not defined.
+     */
+    int decode_erasures(std::vector<uint8_t>& data_to_decode,
+        const std::vector<int>& erasure_positions) const;
+
+    /*!
+     * \brief Erasure-only decoding of several codewords with the same erasure
+     * positions, stored as the columns of a flat row-major matrix of
+     * (255-shortening) rows. The information rows are written.
+     */
+    int decode_erasures(std::vector<uint8_t>& block,
+        size_t columns,
+        const std::vector<int>& erasure_positions) const;
+
     /*!
      * \brief Encode data with the generator matrix (for testing purposes)
      *
@@ -120,6 +151,14 @@ public:
 private:
     static const int d_symbols_per_block = 255;  // the total number of symbols in a RS block.
     static const int d_symsize = 8;              // symbol size, in bits.
+    static const size_t d_max_cached_inverses = 256;
+
+    struct Erasure_Decoder
+    {
+        std::vector<int> known_rows;     // rows of the shortened code used for decoding
+        std::vector<uint8_t> inverse;    // inverse of their generator rows, row-major
+        std::vector<uint8_t> inverse_t;  // same, transposed
+    };
 
     int mod255(int x) const;
     int rs_min(int a, int b) const;
@@ -129,9 +168,15 @@ private:
     uint8_t galois_add(uint8_t a, uint8_t b) const;
     uint8_t galois_mul_table(uint8_t a, uint8_t b) const;
 
+    uint8_t galois_inv(uint8_t a) const;
+    void galois_mul_add(uint8_t k, const uint8_t* in, uint8_t* out, size_t length) const;  // out += k * in
+    bool galois_invert_matrix(std::vector<uint8_t>& matrix, size_t n) const;
+    std::shared_ptr<const Erasure_Decoder> get_erasure_decoder(const std::vector<int>& erasure_positions) const;
+
     void encode_rs_8(const uint8_t* data, uint8_t* parity) const;
     void init_log_tables();    // initialize d_log_table and d_antilog
     void init_alpha_tables();  // initialize d_alpha_to, d_index_of
+    void init_split_tables();  // initialize d_split_tables
 
     std::array<uint8_t, 256> d_alpha_to{};   // used for decoding
     std::array<uint8_t, 256> d_index_of{};   // used for decoding
@@ -141,6 +186,10 @@ private:
     std::vector<std::vector<uint8_t>> d_genmatrix;  // used for encoding
     std::vector<uint8_t> d_genpoly_coeff;           // used for encoding
     std::vector<uint8_t> d_genpoly_index;           // used for encoding
+    std::vector<uint8_t> d_split_tables;            // 256 x 32 nibble product tables, used for erasure decoding
+
+    mutable std::map<std::vector<int>, std::shared_ptr<const Erasure_Decoder>> d_erasure_decoders;
+    mutable std::mutex d_erasure_decoders_mutex;
 
     size_t d_data_in_block{};           // number of information symbols in a block
     size_t d_rows_G{};                  // number of rows of the generator matrix
@@ -25,10 +25,12 @@
 #define GOOGLE_STRIP_LOG 0
 #endif
 
+#include "capacity_benchmark.h"
 #include "concurrent_map.h"
 #include "concurrent_queue.h"
 #include "control_thread.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_flags.h"
 #include "gnss_sdr_make_unique.h"
 #include "gps_acq_assist.h"
 #include <boost/exception/diagnostic_information.hpp>  // for diagnostic_information
@@ -124,10 +126,17 @@ int main(int argc, char** argv)
     int return_code = 0;
     try
         {
-            auto control_thread = std::make_unique<ControlThread>();
-            // record startup time
-            start = std::chrono::system_clock::now();
-            return_code = control_thread->run();
+            if (FLAGS_benchmark)
+                {
+                    return_code = run_capacity_benchmark(FLAGS_c == "-" ? FLAGS_config_file : FLAGS_c);
+                }
+            else
+                {
+                    auto control_thread = std::make_unique<ControlThread>();
+                    // record startup time
+                    start = std::chrono::system_clock::now();
+                    return_code = control_thread->run();
+                }
         }
     catch (const boost::thread_resource_error& e)
         {
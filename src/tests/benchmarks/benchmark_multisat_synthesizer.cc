@@ -0,0 +1,60 @@
+/*!
+ * \file benchmark_multisat_synthesizer.cc
+ * \brief Benchmark for the multi-satellite signal synthesizer
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "multisat_signal_synthesizer.h"
+#include <benchmark/benchmark.h>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+constexpr double FS_HZ = 4e6;
+constexpr uint32_t BLOCK = 4000;
+
+std::vector<Synthesized_Satellite> mixed_constellation(uint32_t num_satellites)
+{
+    const char systems[] = "GECR";
+    std::vector<Synthesized_Satellite> satellites;
+    for (uint32_t n = 0; n < num_satellites; n++)
+        {
+            Synthesized_Satellite sat;
+            sat.system = systems[n % 4];
+            sat.PRN = 1 + (n / 4) % 24;
+            sat.elevation_deg = 10.0 + (n * 7) % 80;
+            sat.azimuth_deg = (n * 37) % 360;
+            satellites.push_back(sat);
+        }
+    return satellites;
+}
+
+
+// Arguments: number of satellites and of threads (0 for one per core)
+void bm_multisat_synthesizer(benchmark::State& state)
+{
+    Multisat_Signal_Synthesizer synthesizer(mixed_constellation(static_cast<uint32_t>(state.range(0))), FS_HZ, 0.0, true, true, static_cast<uint32_t>(state.range(1)), 1);
+    std::vector<std::complex<float>> signal(BLOCK);
+
+    while (state.KeepRunning())
+        {
+            synthesizer.generate(signal.data(), BLOCK);
+        }
+    state.SetItemsProcessed(state.iterations() * BLOCK);
+    // seconds of signal per second of wall time
+    state.counters["realtime_factor"] = benchmark::Counter(static_cast<double>(state.iterations()) * BLOCK / FS_HZ, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(bm_multisat_synthesizer)->Args({10, 1})->Args({100, 1})->Args({100, 0})->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -18,6 +18,7 @@
 #include "gnss_sdr_make_unique.h"  // for std::unique_ptr in C++11
 #include "reed_solomon.h"
 #include <benchmark/benchmark.h>
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -295,8 +296,150 @@ void bm_e6b_erasure(benchmark::State& state)
 }
 
 
+void bm_e1b_erasure_matrix(benchmark::State& state)
+{
+    std::vector<uint8_t> code_vector = {147, 109, 66, 23, 234, 140, 74, 234, 49,
+        89, 241, 253, 169, 161, 89, 93, 75, 142, 83, 102, 98, 218, 14, 197, 155,
+        151, 43, 181, 9, 163, 142, 111, 8, 118, 21, 47, 135, 139, 108, 215, 51,
+        147, 185, 52, 17, 151, 97, 102, 238, 71, 83, 114, 47, 80, 67, 199, 215,
+        162, 238, 77, 12, 72, 235, 21, 148, 213, 230, 54, 183, 82, 49, 104, 12,
+        228, 150, 157, 220, 112, 236, 187, 63, 31, 175, 47, 210, 164, 17, 104,
+        98, 46, 252, 165, 194, 57, 26, 213, 14, 133, 176, 148, 34, 9, 167, 43,
+        204, 198, 25, 164, 233, 55, 153, 31, 237, 84, 212, 76, 137, 242};
+
+    auto rs = std::make_unique<ReedSolomon>("E1B");
+
+    // Same use case as above: we have received c_0, c_2, g_1, g_3
+    std::vector<int> erasure_positions;
+    erasure_positions.reserve(60);
+    for (int i = 16; i < 30; i++)
+        {
+            code_vector[i] = 0;
+            erasure_positions.push_back(i);
+        }
+    for (int i = 44; i < 58; i++)
+        {
+            code_vector[i] = 0;
+            erasure_positions.push_back(i);
+        }
+    for (int i = 58; i < 73; i++)
+        {
+            code_vector[i] = 0;
+            erasure_positions.push_back(i + 137);
+        }
+    for (int i = 88; i < 103; i++)
+        {
+            code_vector[i] = 0;
+            erasure_positions.push_back(i + 137);
+        }
+
+    std::vector<uint8_t> code_vector_missing = code_vector;
+
+    while (state.KeepRunning())
+        {
+            int result = rs->decode_erasures(code_vector, erasure_positions);
+            if (result < 0)
+                {
+                    state.SkipWithError("Failed to decode data!");
+                    break;
+                }
+            state.PauseTiming();
+            code_vector = code_vector_missing;
+            state.ResumeTiming();
+        }
+}
+
+
+// A full HAS message: 53 codewords (one per octet of the pages) sharing the
+// erasure positions. Pages 1 to 10 of a 15-page message are missing.
+std::vector<uint8_t> has_test_block(const ReedSolomon& rs, std::vector<int>& erasure_positions)
+{
+    constexpr size_t columns = 53;
+    constexpr size_t message_size = 15;
+    std::vector<uint8_t> block(255 * columns, 0);
+    for (size_t col = 0; col < columns; col++)
+        {
+            std::vector<uint8_t> information(32, 0);
+            for (size_t row = 0; row < message_size; row++)
+                {
+                    information[row] = static_cast<uint8_t>((row * 31 + col * 7 + 1) % 256);
+                }
+            const std::vector<uint8_t> codeword = rs.encode_with_generator_matrix(information);
+            for (size_t row = 0; row < 255; row++)
+                {
+                    block[row * columns + col] = codeword[row];
+                }
+        }
+    const std::vector<int> received_pages = {11, 12, 13, 14, 15, 40, 52, 77, 90, 101, 133, 150, 181, 200, 240};
+    erasure_positions.clear();
+    for (int pid = 1; pid <= 255; pid++)
+        {
+            const bool known_zero = pid > static_cast<int>(message_size) && pid <= 32;
+            if (!known_zero && std::find(received_pages.begin(), received_pages.end(), pid) == received_pages.end())
+                {
+                    erasure_positions.push_back(pid - 1);
+                    std::fill(block.begin() + (pid - 1) * columns, block.begin() + pid * columns, 0);
+                }
+        }
+    return block;
+}
+
+
+void bm_e6b_has_message_columns(benchmark::State& state)
+{
+    constexpr size_t columns = 53;
+    auto rs = std::make_unique<ReedSolomon>();
+    std::vector<int> erasure_positions;
+    const std::vector<uint8_t> block = has_test_block(*rs, erasure_positions);
+
+    while (state.KeepRunning())
+        {
+            for (size_t col = 0; col < columns; col++)
+                {
+                    std::vector<uint8_t> column(255);
+                    for (size_t row = 0; row < 255; row++)
+                        {
+                            column[row] = block[row * columns + col];
+                        }
+                    int result = rs->decode(column, erasure_positions);
+                    if (result < 0)
+                        {
+                            state.SkipWithError("Failed to decode data!");
+                            break;
+                        }
+                }
+        }
+}
+
+
+void bm_e6b_has_message_matrix(benchmark::State& state)
+{
+    constexpr size_t columns = 53;
+    auto rs = std::make_unique<ReedSolomon>();
+    std::vector<int> erasure_positions;
+    const std::vector<uint8_t> block_missing = has_test_block(*rs, erasure_positions);
+    std::vector<uint8_t> block = block_missing;
+
+    while (state.KeepRunning())
+        {
+            int result = rs->decode_erasures(block, columns, erasure_positions);
+            if (result < 0)
+                {
+                    state.SkipWithError("Failed to decode data!");
+                    break;
+                }
+            state.PauseTiming();
+            block = block_missing;
+            state.ResumeTiming();
+        }
+}
+
+
 BENCHMARK(bm_e1b_erasurecorrection_shortened);
 BENCHMARK(bm_e1b_erasurecorrection_unshortened);
 BENCHMARK(bm_e6b_correction);
 BENCHMARK(bm_e6b_erasure);
+BENCHMARK(bm_e1b_erasure_matrix);
+BENCHMARK(bm_e6b_has_message_columns);
+BENCHMARK(bm_e6b_has_message_matrix);
 BENCHMARK_MAIN();
@@ -74,6 +74,7 @@ DEFINE_double(skip_trk_transitory_s, 1.0, "Skip the initial tracking output sign
 DEFINE_int32(extend_correlation_symbols, 1, "Set the tracking coherent correlation to N symbols (up to 20 for GPS L1 C/A)");
 DEFINE_int32(smoother_length, 10, "Set the moving average size for the carrier phase and code phase in case of high dynamics");
 DEFINE_bool(high_dyn, false, "Activates the code resampler and NCO generator for high dynamics");
+DEFINE_int32(max_batch_epochs, 1, "Set the maximum number of integration periods processed by each call to the tracking block");
 
 // Test output configuration
 DEFINE_bool(plot_gps_l1_tracking_test, false, "Plots results of GpsL1CADllPllTrackingTest with gnuplot");
@@ -146,3 +146,44 @@ TEST(FFTLengthTest, MeasureExecutionTime)
                 }
         }
 }
+
+
+TEST(FFTLengthTest, FriendlySize)
+{
+    EXPECT_EQ(gnss_fft_friendly_size(1), 1);
+    EXPECT_EQ(gnss_fft_friendly_size(1024), 1024);
+    EXPECT_EQ(gnss_fft_friendly_size(1297), 1323);  // 3^3 * 7^2
+    EXPECT_EQ(gnss_fft_friendly_size(2221), 2240);  // 2^6 * 5 * 7
+    EXPECT_EQ(gnss_fft_friendly_size(4000), 4000);
+    for (int size = 1; size < 20000; size += 37)
+        {
+            int remainder = gnss_fft_friendly_size(size);
+            EXPECT_GE(remainder, size);
+            for (int factor : {2, 3, 5, 7})
+                {
+                    while (remainder % factor == 0)
+                        {
+                            remainder /= factor;
+                        }
+                }
+            EXPECT_EQ(remainder, 1);
+        }
+}
+
+
+TEST(FFTLengthTest, BorrowReusesFFTObjects)
+{
+    auto fft = gnss_fft_fwd_borrow(2048);
+    ASSERT_EQ(fft->inbuf_length(), 2048);
+    const gnss_fft_complex_fwd* first = fft.get();
+
+    // Two objects of the same size are never shared at the same time
+    auto other = gnss_fft_fwd_borrow(2048);
+    EXPECT_NE(other.get(), first);
+
+    fft.reset();
+    auto again = gnss_fft_fwd_borrow(2048);
+    EXPECT_EQ(again.get(), first);
+    auto rev = gnss_fft_rev_borrow(2048);
+    EXPECT_EQ(rev->inbuf_length(), 2048);
+}
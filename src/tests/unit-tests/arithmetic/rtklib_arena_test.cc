@@ -0,0 +1,184 @@
+/*!
+ * \file rtklib_arena_test.cc
+ * \brief  This file implements tests for the memory arena of the RTKLIB
+ * per-epoch temporaries.
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_lambda.h"
+#include "rtklib_rtkcmn.h"
+#include "rtklib_solver.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+
+namespace
+{
+bool is_aligned(const void* p)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % ARENA_ALIGN == 0;
+}
+
+
+bool in_buffer(const arena_t* arena, const void* p)
+{
+    const auto* c = static_cast<const unsigned char*>(p);
+    return c >= arena->buff and c < arena->buff + arena->size;
+}
+}  // namespace
+
+
+TEST(RtklibArenaTest, OverflowGrowsBufferOnReset)
+{
+    arena_t* arena = arena_new(64);
+    ASSERT_NE(arena, nullptr);
+    EXPECT_EQ(arena->size, 64U);
+
+    for (int epoch = 0; epoch < 3; epoch++)
+        {
+            void* p1 = arena_alloc(arena, 10);
+            void* p2 = arena_alloc(arena, 200);
+            EXPECT_TRUE(is_aligned(p1));
+            EXPECT_TRUE(is_aligned(p2));
+            EXPECT_TRUE(in_buffer(arena, p1));
+            EXPECT_EQ(arena->need, 16U + 208U);
+            if (epoch == 0)
+                {
+                    // the first epoch does not fit and is served from the heap
+                    EXPECT_FALSE(in_buffer(arena, p2));
+                    EXPECT_NE(arena->ovf, nullptr);
+                }
+            else
+                {
+                    // later epochs with the same demand fit in the grown buffer
+                    EXPECT_TRUE(in_buffer(arena, p2));
+                    EXPECT_EQ(arena->ovf, nullptr);
+                }
+            std::fill_n(static_cast<unsigned char*>(p2), 200, 0xAA);
+
+            arena_reset(arena);
+            EXPECT_EQ(arena->size, 16U + 208U);
+            EXPECT_EQ(arena->used, 0U);
+            EXPECT_EQ(arena->need, 0U);
+            EXPECT_EQ(arena->ovf, nullptr);
+        }
+    arena_free(arena);
+}
+
+
+TEST(RtklibArenaTest, MatricesAfterReset)
+{
+    arena_t* arena = arena_new(0);
+    for (int epoch = 0; epoch < 2; epoch++)
+        {
+            double* A = arena_mat(arena, 5, 3);
+            std::fill_n(A, 15, 1.0);
+            double* Z = arena_zeros(arena, 4, 4);
+            double* I = arena_eye(arena, 4);
+            int* N = arena_imat(arena, 3, 1);
+            ASSERT_NE(Z, nullptr);
+            ASSERT_NE(N, nullptr);
+            EXPECT_TRUE(is_aligned(A));
+            EXPECT_TRUE(is_aligned(N));
+            for (int i = 0; i < 16; i++)
+                {
+                    EXPECT_EQ(Z[i], 0.0);
+                    EXPECT_EQ(I[i], (i % 5 == 0) ? 1.0 : 0.0);
+                    Z[i] = 2.0;
+                }
+            arena_release(arena, A);
+            arena_release(arena, Z);
+            arena_release(arena, I);
+            arena_release(arena, N);
+            arena_reset(arena);
+        }
+    // empty matrices are not allocated
+    EXPECT_EQ(arena_mat(arena, 0, 3), nullptr);
+    arena_free(arena);
+
+    // without an arena, matrices come from the heap
+    double* H = arena_zeros(nullptr, 3, 3);
+    ASSERT_NE(H, nullptr);
+    EXPECT_EQ(H[8], 0.0);
+    arena_release(nullptr, H);
+    arena_free(nullptr);
+}
+
+
+TEST(RtklibArenaTest, LambdaAcrossEpochs)
+{
+    const int n = 8;
+    const int m = 2;
+    std::default_random_engine e(1234);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    arena_t* arena = arena_new(0);
+    size_t steady_size = 0;
+
+    for (int epoch = 0; epoch < 5; epoch++)
+        {
+            // random float ambiguities and positive definite covariance
+            std::vector<double> a(n);
+            std::vector<double> M(n * n);
+            std::vector<double> Q(n * n, 0.0);
+            for (auto& v : a)
+                {
+                    v = 10.0 * dist(e);
+                }
+            for (auto& v : M)
+                {
+                    v = dist(e);
+                }
+            for (int i = 0; i < n; i++)
+                {
+                    for (int j = 0; j < n; j++)
+                        {
+                            for (int k = 0; k < n; k++)
+                                {
+                                    Q[i + j * n] += 0.01 * M[i + k * n] * M[j + k * n];
+                                }
+                        }
+                    Q[i + i * n] += 0.01;
+                }
+
+            std::vector<double> F_heap(n * m);
+            std::vector<double> s_heap(m);
+            std::vector<double> F_arena(n * m);
+            std::vector<double> s_arena(m);
+            ASSERT_EQ(lambda(n, m, a.data(), Q.data(), F_heap.data(), s_heap.data()), 0);
+            ASSERT_EQ(lambda(n, m, a.data(), Q.data(), F_arena.data(), s_arena.data(), arena), 0);
+            EXPECT_EQ(F_heap, F_arena);
+            EXPECT_EQ(s_heap, s_arena);
+
+            if (epoch > 0)
+                {
+                    // steady state: no overflow blocks and no buffer growth
+                    EXPECT_EQ(arena->ovf, nullptr);
+                    EXPECT_EQ(arena->size, steady_size);
+                }
+            arena_reset(arena);
+            steady_size = arena->size;
+            EXPECT_GT(steady_size, 0U);
+        }
+    arena_free(arena);
+}
+
+
+TEST(RtklibArenaTest, SolverIsNotCopyable)
+{
+    // a copy would free the arena of the original solver on destruction
+    EXPECT_FALSE(std::is_copy_constructible<Rtklib_Solver>::value);
+    EXPECT_FALSE(std::is_copy_assignable<Rtklib_Solver>::value);
+}
@@ -0,0 +1,209 @@
+/*!
+ * \file rtklib_smallmat_test.cc
+ * \brief  This file implements tests for the RTKLIB small matrix kernels.
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_smallmat.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+// column-major reference product C = alpha * op(A) * op(B) + beta * C
+void reference_matmul(const std::string& tr, int n, int k, int m, double alpha,
+    const std::vector<double>& A, const std::vector<double>& B, double beta, std::vector<double>& C)
+{
+    for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < k; j++)
+                {
+                    double d = 0.0;
+                    for (int l = 0; l < m; l++)
+                        {
+                            const double a = tr[0] == 'T' ? A[l + i * m] : A[i + l * n];
+                            const double b = tr[1] == 'T' ? B[j + l * k] : B[l + j * m];
+                            d += a * b;
+                        }
+                    C[i + j * n] = alpha * d + beta * C[i + j * n];
+                }
+        }
+}
+
+
+std::vector<double> random_spd(int n, std::default_random_engine& e)
+{
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> M(n * n);
+    std::vector<double> S(n * n, 0.0);
+    std::generate(M.begin(), M.end(), [&dist, &e]() { return dist(e); });
+    reference_matmul("NT", n, n, n, 1.0, M, M, 0.0, S);
+    for (int i = 0; i < n; i++)
+        {
+            S[i + i * n] += n;
+        }
+    return S;
+}
+}  // namespace
+
+
+TEST(RtklibSmallmatTest, MatmulAllTransposes)
+{
+    std::default_random_engine e(1234);
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+    const std::vector<std::string> flags = {"NN", "NT", "TN", "TT"};
+    const std::vector<std::vector<int>> dims = {{1, 1, 1}, {3, 1, 3}, {4, 4, 4}, {7, 5, 33}, {40, 17, 21}};
+
+    for (const auto& tr : flags)
+        {
+            for (const auto& d : dims)
+                {
+                    const int n = d[0];
+                    const int k = d[1];
+                    const int m = d[2];
+                    std::vector<double> A(n * m);
+                    std::vector<double> B(m * k);
+                    std::vector<double> C(n * k);
+                    std::generate(A.begin(), A.end(), [&dist, &e]() { return dist(e); });
+                    std::generate(B.begin(), B.end(), [&dist, &e]() { return dist(e); });
+                    std::generate(C.begin(), C.end(), [&dist, &e]() { return dist(e); });
+                    std::vector<double> C_ref = C;
+
+                    smallmat_mul(tr.c_str(), n, k, m, 1.5, A.data(), B.data(), -0.5, C.data());
+                    reference_matmul(tr, n, k, m, 1.5, A, B, -0.5, C_ref);
+                    for (int i = 0; i < n * k; i++)
+                        {
+                            EXPECT_NEAR(C[i], C_ref[i], 1e-9) << tr << " n=" << n << " k=" << k << " m=" << m;
+                        }
+                }
+        }
+}
+
+
+TEST(RtklibSmallmatTest, MatmulPropagatesNonFinite)
+{
+    // inf and nan in A, multiplied by zeros of B, must give nan as in dgemm
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const int n = 3;
+    const int k = 2;
+    const int m = 4;
+    for (const std::string tr : {"NN", "NT", "TN", "TT"})
+        {
+            std::vector<double> A(n * m, 1.0);
+            std::vector<double> B(m * k, 0.0);
+            A[tr[0] == 'T' ? 1 + 0 * m : 0 + 1 * n] = inf;  // op(A)(0,1)
+            A[tr[0] == 'T' ? 3 + 2 * m : 2 + 3 * n] = nan;  // op(A)(2,3)
+            std::vector<double> C(n * k, 0.0);
+            std::vector<double> C_ref = C;
+
+            smallmat_mul(tr.c_str(), n, k, m, 1.0, A.data(), B.data(), 1.0, C.data());
+            reference_matmul(tr, n, k, m, 1.0, A, B, 1.0, C_ref);
+            for (int i = 0; i < n * k; i++)
+                {
+                    EXPECT_EQ(std::isnan(C[i]), std::isnan(C_ref[i])) << tr << " element " << i;
+                    if (!std::isnan(C_ref[i]))
+                        {
+                            EXPECT_EQ(C[i], C_ref[i]) << tr << " element " << i;
+                        }
+                }
+            EXPECT_TRUE(std::isnan(C[0]));
+            EXPECT_TRUE(std::isnan(C[2]));
+            EXPECT_FALSE(std::isnan(C[1]));
+        }
+}
+
+
+TEST(RtklibSmallmatTest, InverseAndCholesky)
+{
+    std::default_random_engine e(4321);
+    for (int n : {1, 4, 11, 30, SMALLMAT_NMAX})
+        {
+            const std::vector<double> S = random_spd(n, e);
+            std::vector<double> lu = S;
+            std::vector<double> ch = S;
+            std::vector<double> I(n * n, 0.0);
+
+            ASSERT_EQ(smallmat_inv(lu.data(), n), 0);
+            ASSERT_EQ(smallmat_cholinv(ch.data(), n), 0);
+            reference_matmul("NN", n, n, n, 1.0, S, lu, 0.0, I);
+            for (int i = 0; i < n; i++)
+                {
+                    for (int j = 0; j < n; j++)
+                        {
+                            EXPECT_NEAR(I[i + j * n], i == j ? 1.0 : 0.0, 1e-9);
+                            EXPECT_NEAR(ch[i + j * n], lu[i + j * n], 1e-9);
+                        }
+                }
+        }
+}
+
+
+TEST(RtklibSmallmatTest, SingularAndIndefinite)
+{
+    std::vector<double> A = {1.0, 2.0, 2.0, 4.0};
+    EXPECT_GT(smallmat_inv(A.data(), 2), 0);
+
+    // symmetric, invertible but not positive definite: Cholesky must fail and leave A untouched
+    std::vector<double> B = {0.0, 1.0, 1.0, 0.0};
+    const std::vector<double> B_orig = B;
+    EXPECT_GT(smallmat_cholinv(B.data(), 2), 0);
+    EXPECT_EQ(B, B_orig);
+    EXPECT_EQ(smallmat_inv(B.data(), 2), 0);
+    EXPECT_DOUBLE_EQ(B[1], 1.0);
+    EXPECT_DOUBLE_EQ(B[2], 1.0);
+}
+
+
+TEST(RtklibSmallmatTest, Solve)
+{
+    std::default_random_engine e(777);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    const int n = 9;
+    const int m = 2;
+    std::vector<double> A(n * n);
+    std::generate(A.begin(), A.end(), [&dist, &e]() { return dist(e); });
+    for (int i = 0; i < n; i++)
+        {
+            A[i + i * n] += 4.0;
+        }
+    std::vector<double> Y(n * m);
+    std::generate(Y.begin(), Y.end(), [&dist, &e]() { return dist(e); });
+
+    for (const std::string tr : {"N", "T"})
+        {
+            std::vector<double> X(n * m);
+            std::vector<double> AX(n * m, 0.0);
+            ASSERT_EQ(smallmat_solve(tr.c_str(), A.data(), Y.data(), n, m, X.data()), 0);
+            reference_matmul(tr + "N", n, m, n, 1.0, A, X, 0.0, AX);
+            for (int i = 0; i < n * m; i++)
+                {
+                    EXPECT_NEAR(AX[i], Y[i], 1e-12);
+                }
+        }
+
+    // in-place solution (X same as Y)
+    std::vector<double> XY = Y;
+    std::vector<double> AX(n * m, 0.0);
+    ASSERT_EQ(smallmat_solve("N", A.data(), XY.data(), n, m, XY.data()), 0);
+    reference_matmul("NN", n, m, n, 1.0, A, XY, 0.0, AX);
+    for (int i = 0; i < n * m; i++)
+        {
+            EXPECT_NEAR(AX[i], Y[i], 1e-12);
+        }
+}
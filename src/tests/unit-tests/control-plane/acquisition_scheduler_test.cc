@@ -0,0 +1,129 @@
+/*!
+ * \file acquisition_scheduler_test.cc
+ * \brief Unit tests for the almanac and ephemeris aided acquisition scheduler.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acquisition_scheduler.h"
+#include "galileo_almanac.h"
+#include "galileo_ephemeris.h"
+#include "gnss_frequencies.h"
+#include "gps_almanac.h"
+#include "gps_ephemeris.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <ctime>
+#include <map>
+
+
+namespace
+{
+// 24 GPS satellites in 6 circular orbital planes
+std::map<int, Gps_Almanac> acqsch_gps_constellation()
+{
+    std::map<int, Gps_Almanac> almanacs;
+    for (int plane = 0; plane < 6; plane++)
+        {
+            for (int slot = 0; slot < 4; slot++)
+                {
+                    Gps_Almanac almanac;
+                    almanac.PRN = 1 + plane * 4 + slot;
+                    almanac.sqrtA = 5153.6;
+                    almanac.ecc = 0.0;
+                    almanac.delta_i = 0.0133;  // 55 deg of inclination
+                    almanac.OMEGA_0 = -1.0 + plane / 3.0;
+                    almanac.OMEGAdot = -2.6e-9;
+                    almanac.omega = 0.0;
+                    almanac.M_0 = -1.0 + slot / 2.0 + plane / 12.0;
+                    almanac.toa = 61440;
+                    almanac.WNa = 160;
+                    almanacs[almanac.PRN] = almanac;
+                }
+        }
+    return almanacs;
+}
+}  // namespace
+
+
+TEST(AcquisitionSchedulerTest, PredictsVisibleSatellites)
+{
+    const double alm_margin_hz = 1000.0;
+    const double elevation_mask_deg = 5.0;
+    Acquisition_Scheduler scheduler(250.0, alm_margin_hz, elevation_mask_deg, false);
+    const std::array<float, 3> LLH = {41.27F, 1.99F, 10.0F};
+    const time_t rx_utc_time = 1650000000;
+
+    scheduler.update(LLH, rx_utc_time, 0.0, 0.0, std::map<int, Gps_Ephemeris>(), std::map<int, Galileo_Ephemeris>(), acqsch_gps_constellation(), std::map<int, Galileo_Almanac>());
+    EXPECT_EQ(scheduler.last_update(), rx_utc_time);
+
+    const std::vector<std::pair<int, Gnss_Satellite>> visible = scheduler.visible_satellites();
+    ASSERT_GT(visible.size(), 3U);
+    EXPECT_LT(visible.size(), 24U);
+    std::map<uint32_t, double> doppler_no_drift;
+    for (size_t i = 0; i < visible.size(); i++)
+        {
+            EXPECT_GE(visible[i].first, static_cast<int>(elevation_mask_deg));
+            if (i > 0)
+                {
+                    EXPECT_LE(visible[i].first, visible[i - 1].first);  // highest first
+                }
+            double doppler_hz = 0.0;
+            double uncertainty_hz = 0.0;
+            ASSERT_TRUE(scheduler.predicted_doppler(Gnss_Signal(visible[i].second, "1C"), doppler_hz, uncertainty_hz));
+            EXPECT_LT(std::abs(doppler_hz), 5000.0);  // static receiver
+            EXPECT_DOUBLE_EQ(uncertainty_hz, alm_margin_hz);
+            doppler_no_drift[visible[i].second.get_PRN()] = doppler_hz;
+        }
+
+    // A receiver clock running fast lowers all the measured Doppler shifts
+    const double clock_drift_ppm = 1.0;
+    scheduler.update(LLH, rx_utc_time, clock_drift_ppm, 0.5, std::map<int, Gps_Ephemeris>(), std::map<int, Galileo_Ephemeris>(), acqsch_gps_constellation(), std::map<int, Galileo_Almanac>());
+    for (const auto& satellite : scheduler.visible_satellites())
+        {
+            double doppler_hz = 0.0;
+            double uncertainty_hz = 0.0;
+            ASSERT_TRUE(scheduler.predicted_doppler(Gnss_Signal(satellite.second, "1C"), doppler_hz, uncertainty_hz));
+            EXPECT_NEAR(doppler_hz, doppler_no_drift[satellite.second.get_PRN()] - clock_drift_ppm * 1e-6 * FREQ1, 1e-3);
+            EXPECT_NEAR(uncertainty_hz, alm_margin_hz + 0.5e-6 * FREQ1, 1e-6);
+        }
+}
+
+
+TEST(AcquisitionSchedulerTest, FallsBackToFullSearchOnMiss)
+{
+    Acquisition_Scheduler scheduler(250.0, 1000.0, 5.0, false);
+    scheduler.update({41.27F, 1.99F, 10.0F}, 1650000000, 0.0, 0.0, std::map<int, Gps_Ephemeris>(), std::map<int, Galileo_Ephemeris>(), acqsch_gps_constellation(), std::map<int, Galileo_Almanac>());
+    const std::vector<std::pair<int, Gnss_Satellite>> visible = scheduler.visible_satellites();
+    ASSERT_FALSE(visible.empty());
+
+    const Gnss_Signal signal(visible[0].second, "1C");
+    const Gnss_Signal other_band(visible[0].second, "L5");
+    double doppler_hz = 0.0;
+    double uncertainty_hz = 0.0;
+    EXPECT_TRUE(scheduler.predicted_doppler(signal, doppler_hz, uncertainty_hz));
+
+    scheduler.report_miss(signal);
+    EXPECT_FALSE(scheduler.predicted_doppler(signal, doppler_hz, uncertainty_hz));
+    EXPECT_TRUE(scheduler.predicted_doppler(other_band, doppler_hz, uncertainty_hz));
+
+    // The full search failed too: back to the narrowed window
+    scheduler.report_miss(signal);
+    EXPECT_TRUE(scheduler.predicted_doppler(signal, doppler_hz, uncertainty_hz));
+
+    scheduler.report_miss(signal);
+    scheduler.report_hit(signal);
+    EXPECT_TRUE(scheduler.predicted_doppler(signal, doppler_hz, uncertainty_hz));
+
+    // Satellites without almanac or ephemeris are always searched in full
+    EXPECT_FALSE(scheduler.predicted_doppler(Gnss_Signal(Gnss_Satellite("GPS", 30), "1C"), doppler_hz, uncertainty_hz));
+}
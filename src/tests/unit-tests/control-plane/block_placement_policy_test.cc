@@ -0,0 +1,71 @@
+/*!
+ * \file block_placement_policy_test.cc
+ * \brief Unit tests for the placement of the flowgraph block threads.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "block_placement_policy.h"
+#include "in_memory_configuration.h"
+#include <gnuradio/blocks/null_sink.h>
+#include <gtest/gtest.h>
+#include <sched.h>
+#include <memory>
+#include <vector>
+
+
+TEST(BlockPlacementPolicyTest, ParsesCpuLists)
+{
+    EXPECT_EQ(Block_Placement_Policy::parse_cpu_list("0,2,4-7"), std::vector<int>({0, 2, 4, 5, 6, 7}));
+    EXPECT_EQ(Block_Placement_Policy::parse_cpu_list(" 3 , 1-2\n"), std::vector<int>({3, 1, 2}));
+    EXPECT_TRUE(Block_Placement_Policy::parse_cpu_list("").empty());
+    EXPECT_EQ(Block_Placement_Policy::parse_cpu_list("1,x,2"), std::vector<int>({1, 2}));
+}
+
+
+TEST(BlockPlacementPolicyTest, SpreadsChannelRangesOverCores)
+{
+    auto configuration = std::make_shared<InMemoryConfiguration>();
+    configuration->set_property("GNSS-SDR.cpu_affinity.SignalSource", "0");
+    configuration->set_property("GNSS-SDR.cpu_affinity.Channels", "0,1");
+    configuration->set_property("Channel3.cpu_affinity", "0");
+
+    const Block_Placement_Policy policy(configuration.get(), 4);
+
+    EXPECT_EQ(policy.cores("SignalSource"), std::vector<int>({0}));
+    EXPECT_TRUE(policy.cores("PVT").empty());
+    EXPECT_EQ(policy.cores("Channels", 0), std::vector<int>({0}));
+    EXPECT_EQ(policy.cores("Channels", 1), std::vector<int>({0}));
+    EXPECT_EQ(policy.cores("Channels", 2), std::vector<int>({1}));
+    EXPECT_EQ(policy.cores("Channels", 3), std::vector<int>({0}));  // Channel3.cpu_affinity
+}
+
+
+TEST(BlockPlacementPolicyTest, RequestsRealtimePriorityOnBlocks)
+{
+    auto configuration = std::make_shared<InMemoryConfiguration>();
+    configuration->set_property("GNSS-SDR.realtime_priority.Channels", "10");
+    configuration->set_property("GNSS-SDR.realtime_priority.PVT", "500");
+
+    Block_Placement_Policy policy(configuration.get(), 2);
+    const auto channel = gr::blocks::null_sink::make(sizeof(gr_complex));
+    const auto pvt = gr::blocks::null_sink::make(sizeof(gr_complex));
+    const auto observables = gr::blocks::null_sink::make(sizeof(gr_complex));
+    const int default_priority = observables->thread_priority();
+    policy.place("Channels", channel, 1);
+    policy.place("PVT", pvt);
+    policy.place("Observables", observables);
+
+    // the block threads set these priorities as they start
+    EXPECT_EQ(channel->thread_priority(), 10);
+    EXPECT_EQ(pvt->thread_priority(), sched_get_priority_max(SCHED_FIFO));
+    EXPECT_EQ(observables->thread_priority(), default_priority);
+}
@@ -0,0 +1,146 @@
+/*!
+ * \file capacity_benchmark_test.cc
+ * \brief Unit tests for the ramp and the report of the capacity benchmark.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "capacity_benchmark.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+// Host that processes 30 channel-seconds of a 4 Msps signal per second of
+// run time, with the load proportional to the sampling rate.
+Benchmark_Result fake_run(const Benchmark_Point& point, std::vector<Benchmark_Point>& calls)
+{
+    calls.push_back(point);
+    const double signal_s = 2.0;
+    const double load = static_cast<double>(point.channels) * static_cast<double>(point.sampling_rate_sps) / 4e6;
+    Benchmark_Result result{point, signal_s, signal_s * load / 30.0, {}, false, ""};
+    result.blocks.push_back({"Channel0 tracking_block", 1000, 10, 0.5 * result.wall_s});
+    result.blocks.push_back({"SignalSource \"multisat\"", 0, 2000, 0.1 * result.wall_s});
+    return result;
+}
+}  // namespace
+
+
+TEST(CapacityBenchmarkTest, RampStopsAtFirstUnsustainedPoint)
+{
+    std::vector<Benchmark_Point> calls;
+    Capacity_Benchmark benchmark({32, 4, 16, 8, 64}, {4000000, 8000000}, 1.2,
+        [&calls](const Benchmark_Point& point) { return fake_run(point, calls); });
+    benchmark.run();
+
+    // 4 Msps: 4, 8, 16 and 32 (fails); 8 Msps: 4, 8 and 16 (fails)
+    ASSERT_EQ(calls.size(), 7U);
+    EXPECT_EQ(calls[0].channels, 4U);
+    EXPECT_EQ(calls[3].channels, 32U);
+    EXPECT_EQ(calls[4].sampling_rate_sps, 8000000);
+    EXPECT_EQ(calls[6].channels, 16U);
+    EXPECT_EQ(benchmark.results().size(), 7U);
+    EXPECT_TRUE(benchmark.sustained(benchmark.results()[2]));
+    EXPECT_FALSE(benchmark.sustained(benchmark.results()[3]));
+
+    const auto envelope = benchmark.envelope();
+    ASSERT_EQ(envelope.size(), 2U);
+    EXPECT_EQ(envelope[0].channels, 16U);
+    EXPECT_EQ(envelope[1].channels, 8U);
+    EXPECT_TRUE(benchmark.passed(8));
+    EXPECT_FALSE(benchmark.passed(16));
+}
+
+
+TEST(CapacityBenchmarkTest, NothingSustained)
+{
+    std::vector<Benchmark_Point> calls;
+    Capacity_Benchmark benchmark({4, 8}, {4000000}, 20.0,
+        [&calls](const Benchmark_Point& point) { return fake_run(point, calls); });
+    benchmark.run();
+
+    EXPECT_EQ(calls.size(), 1U);
+    EXPECT_EQ(benchmark.envelope()[0].channels, 0U);
+    EXPECT_FALSE(benchmark.passed(1));
+    EXPECT_TRUE(benchmark.passed(0));
+}
+
+
+TEST(CapacityBenchmarkTest, ReportsEnvelopeAndBusiestBlocks)
+{
+    std::vector<Benchmark_Point> calls;
+    Capacity_Benchmark benchmark({4, 8, 16, 32}, {4000000}, 1.2,
+        [&calls](const Benchmark_Point& point) { return fake_run(point, calls); });
+    benchmark.run();
+
+    std::ostringstream report;
+    benchmark.print_report(report);
+    EXPECT_NE(report.str().find("4000000 sps: 16 channels per signal"), std::string::npos);
+    EXPECT_NE(report.str().find("busiest blocks with 32 channels"), std::string::npos);
+    EXPECT_NE(report.str().find("Channel0 tracking_block: 50.0 %"), std::string::npos);
+
+    std::ostringstream json;
+    benchmark.write_json(json);
+    const std::string s = json.str();
+    EXPECT_EQ(s.front(), '{');
+    EXPECT_NE(s.find("\"envelope\": [\n    {\"sampling_rate_sps\": 4000000, \"channels\": 16}\n  ]"), std::string::npos);
+    EXPECT_NE(s.find("\"sustained\": false"), std::string::npos);
+    EXPECT_NE(s.find("\"name\": \"SignalSource \\\"multisat\\\"\""), std::string::npos);
+    EXPECT_NE(s.find("\"realtime_factor\": 1.875"), std::string::npos);
+}
+
+
+TEST(CapacityBenchmarkTest, RampStopsAtFailedRun)
+{
+    std::vector<Benchmark_Point> calls;
+    Capacity_Benchmark benchmark({4, 8, 16, 32}, {4000000, 8000000}, 1.2,
+        [&calls](const Benchmark_Point& point) {
+            if (point.channels == 16)
+                {
+                    calls.push_back(point);
+                    return Benchmark_Result{point, 0.0, 0.0, {}, true, "the receiver returned 42"};
+                }
+            return fake_run(point, calls);
+        });
+    benchmark.run();
+
+    // 4 Msps: 4, 8 and 16 (fails); 8 Msps is never run
+    ASSERT_EQ(calls.size(), 3U);
+    EXPECT_EQ(calls[2].sampling_rate_sps, 4000000);
+    EXPECT_TRUE(benchmark.failed());
+    EXPECT_FALSE(benchmark.sustained(benchmark.results()[2]));
+    EXPECT_FALSE(benchmark.passed(0));
+
+    std::ostringstream report;
+    benchmark.print_report(report);
+    EXPECT_NE(report.str().find("FAILED: the receiver returned 42"), std::string::npos);
+    EXPECT_EQ(report.str().find("channels per signal"), std::string::npos);
+
+    std::ostringstream json;
+    benchmark.write_json(json);
+    EXPECT_NE(json.str().find("\"failed\": true,\n  \"envelope\""), std::string::npos);
+    EXPECT_NE(json.str().find("\"failed\": true, \"error\": \"the receiver returned 42\""), std::string::npos);
+}
+
+
+TEST(CapacityBenchmarkTest, NoSamplingRatesDoesNotPass)
+{
+    std::vector<Benchmark_Point> calls;
+    Capacity_Benchmark benchmark({4, 8}, {}, 1.2,
+        [&calls](const Benchmark_Point& point) { return fake_run(point, calls); });
+    benchmark.run();
+
+    EXPECT_TRUE(calls.empty());
+    EXPECT_FALSE(benchmark.passed(0));
+}
@@ -18,7 +18,9 @@
 
 #include "file_configuration.h"
 #include "gnss_sdr_make_unique.h"
+#include <algorithm>
 #include <string>
+#include <vector>
 
 
 TEST(FileConfigurationTest, OverridedProperties)
@@ -54,3 +56,38 @@ TEST(FileConfigurationTest, PropertyDoesNotExist)
     std::string value = configuration->property("whatever.whatever", default_value);
     EXPECT_STREQ("default_value", value.c_str());
 }
+
+
+TEST(FileConfigurationTest, TypedProperties)
+{
+    std::string path = std::string(TEST_PATH);
+    std::string filename = path + "data/config_file_sample.txt";
+    std::unique_ptr<ConfigurationInterface> configuration = std::make_unique<FileConfiguration>(filename);
+    for (int i = 0; i < 2; i++)  // the second round reads the cached values
+        {
+            EXPECT_EQ(4, configuration->property("SignalSource.item_size", 0));
+            EXPECT_EQ(4U, configuration->property("signalsource.ITEM_SIZE", static_cast<uint64_t>(0)));
+            EXPECT_DOUBLE_EQ(4.0, configuration->property("SignalSource.item_size", 0.0));
+            EXPECT_FALSE(configuration->property("SignalSource.repeat", true));
+            EXPECT_EQ(7, configuration->property("SignalSource.repeat", 7));  // not a number
+            EXPECT_EQ(9, configuration->property("SignalSource.repeat", 9));
+            EXPECT_TRUE(configuration->property("SignalSource.item_size", true));  // not a bool
+        }
+}
+
+
+TEST(FileConfigurationTest, UnusedProperties)
+{
+    std::string path = std::string(TEST_PATH);
+    std::string filename = path + "data/config_file_sample.txt";
+    auto configuration = std::make_unique<FileConfiguration>(filename);
+    const std::vector<std::string> all_properties = configuration->unused_properties();
+    EXPECT_FALSE(all_properties.empty());
+    EXPECT_NE(std::find(all_properties.begin(), all_properties.end(), "signalsource.repeat"), all_properties.end());
+
+    configuration->property("SignalSource.repeat", true);
+    configuration->property("NotThere", 0.0);
+    const std::vector<std::string> unused = configuration->unused_properties();
+    EXPECT_EQ(unused.size(), all_properties.size() - 1);
+    EXPECT_EQ(std::find(unused.begin(), unused.end(), "signalsource.repeat"), unused.end());
+}
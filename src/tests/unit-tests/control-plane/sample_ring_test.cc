@@ -0,0 +1,160 @@
+/*!
+ * \file sample_ring_test.cc
+ * \brief Unit tests for the ring that distributes samples to the channels.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_sample_ring.h"
+#include "gnss_sdr_sample_ring_source.h"
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <pmt/pmt.h>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#else
+#include <gnuradio/blocks/vector_sink_c.h>
+#endif
+
+
+namespace
+{
+// Waits until condition() holds, for at most 10 s
+bool sample_ring_wait_until(const std::function<bool()>& condition)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (not condition())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                {
+                    return false;
+                }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    return true;
+}
+
+
+// Writes nitems samples whose real part is their absolute index in the ring
+void write_indexed_samples(Gnss_Sdr_Sample_Ring& ring, uint64_t first, size_t nitems)
+{
+    std::vector<gr_complex> samples(nitems);
+    for (size_t i = 0; i < nitems; i++)
+        {
+            samples[i] = gr_complex(static_cast<float>(first + i), 0.0F);
+        }
+    ring.write(samples.data(), samples.size());
+}
+}  // namespace
+
+
+TEST(SampleRingTest, ReadsBackAcrossTheWrapAround)
+{
+    Gnss_Sdr_Sample_Ring ring(sizeof(int32_t), 1000);
+    const auto capacity = ring.capacity();
+    ASSERT_GE(capacity, 1000U);
+
+    std::vector<int32_t> samples(capacity / 3);
+    uint64_t written = 0;
+    for (int32_t block = 0; block < 7; block++)
+        {
+            std::iota(samples.begin(), samples.end(), static_cast<int32_t>(written));
+            ring.write(samples.data(), samples.size());
+            written += samples.size();
+        }
+    EXPECT_EQ(ring.written(), written);
+
+    // the newest capacity samples are still there
+    std::vector<int32_t> read_back(capacity);
+    const uint64_t first = written - capacity;
+    ASSERT_TRUE(ring.read(first, read_back.data(), read_back.size()));
+    for (size_t i = 0; i < read_back.size(); i++)
+        {
+            ASSERT_EQ(read_back[i], static_cast<int32_t>(first + i));
+        }
+
+    // older ones have been overwritten
+    EXPECT_FALSE(ring.read(first - 1, read_back.data(), 1));
+}
+
+
+TEST(SampleRingTest, WaitsForNewSamples)
+{
+    Gnss_Sdr_Sample_Ring ring(sizeof(int32_t), 1000);
+    EXPECT_FALSE(ring.wait_for(0, std::chrono::milliseconds(1)));
+    const int32_t sample = 42;
+    ring.write(&sample, 1);
+    EXPECT_TRUE(ring.wait_for(0, std::chrono::milliseconds(1)));
+    EXPECT_FALSE(ring.wait_for(1, std::chrono::milliseconds(1)));
+}
+
+
+TEST(SampleRingTest, LaggingReaderSkipsAhead)
+{
+    auto ring = std::make_shared<Gnss_Sdr_Sample_Ring>(sizeof(gr_complex), 10000);
+    auto source = gnss_sdr_make_sample_ring_source(ring, sizeof(gr_complex), 100, 0);
+    auto head = gr::blocks::head::make(sizeof(gr_complex), 200);
+    auto sink = gr::blocks::vector_sink_c::make();
+    auto top_block = gr::make_top_block("Sample ring test");
+    top_block->connect(source, 0, head, 0);
+    top_block->connect(head, 0, sink, 0);
+
+    // the reader starts 5000 samples behind the writer
+    write_indexed_samples(*ring, 0, 5000);
+    top_block->start();
+    ASSERT_TRUE(sample_ring_wait_until([&source]() { return source->skips() == 1; }));
+
+    // within the maximum lag, every sample is read
+    write_indexed_samples(*ring, 5000, 100);
+    ASSERT_TRUE(sample_ring_wait_until([&source]() { return source->nitems_written(0) == 100; }));
+
+    // beyond it, the reader skips again
+    write_indexed_samples(*ring, 5100, 300);
+    ASSERT_TRUE(sample_ring_wait_until([&source]() { return source->skips() == 2; }));
+    write_indexed_samples(*ring, 5400, 100);
+    top_block->wait();
+
+    const auto data = sink->data();
+    ASSERT_EQ(data.size(), 200U);
+    for (size_t i = 0; i < data.size(); i++)
+        {
+            ASSERT_EQ(data[i].real(), static_cast<float>(i < 100 ? 5000 + i : 5300 + i));
+        }
+
+    // each gap is marked by a tag with the absolute index of the next
+    // sample, and the gaps add up to the samples skipped by the reader
+    const auto tags = sink->tags();
+    ASSERT_EQ(tags.size(), 2U);
+    EXPECT_EQ(tags[0].offset, 0U);
+    EXPECT_EQ(tags[1].offset, 100U);
+    for (const auto& tag : tags)
+        {
+            EXPECT_TRUE(pmt::eqv(tag.key, pmt::mp("sample_counter")));
+            EXPECT_EQ(static_cast<float>(pmt::to_uint64(tag.value)), data[tag.offset].real());
+        }
+    auto gaps = static_cast<uint64_t>(data[0].real());
+    for (size_t i = 1; i < data.size(); i++)
+        {
+            gaps += static_cast<uint64_t>(data[i].real() - data[i - 1].real()) - 1;
+        }
+    EXPECT_EQ(source->skips(), tags.size());
+    EXPECT_EQ(source->skipped_samples(), 5300U);
+    EXPECT_EQ(gaps, source->skipped_samples());
+}
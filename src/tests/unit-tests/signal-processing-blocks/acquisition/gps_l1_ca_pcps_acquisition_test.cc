@@ -22,11 +22,15 @@
 #include "concurrent_queue.h"
 #include "gnss_block_interface.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_sample_ring.h"
+#include "gnss_sdr_sample_ring_source.h"
 #include "gnss_sdr_valve.h"
 #include "gnss_synchro.h"
 #include "gnuplot_i.h"
 #include "gps_l1_ca_pcps_acquisition.h"
 #include "in_memory_configuration.h"
+#include "multisat_signal_synthesizer.h"
+#include "pcps_acquisition.h"
 #include "test_flags.h"
 #include <glog/logging.h>
 #include <gnuradio/analog/sig_source_waveform.h>
@@ -34,10 +38,17 @@
 #include <gnuradio/blocks/null_sink.h>
 #include <gnuradio/top_block.h>
 #include <gtest/gtest.h>
+#include <matio.h>
 #include <pmt/pmt.h>
 #include <chrono>
+#include <cmath>
+#include <fstream>
 #include <memory>
+#include <random>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #if HAS_GENERIC_LAMBDA
 #else
@@ -46,8 +57,10 @@
 
 #ifdef GR_GREATER_38
 #include <gnuradio/analog/sig_source.h>
+#include <gnuradio/blocks/vector_source.h>
 #else
 #include <gnuradio/analog/sig_source_c.h>
+#include <gnuradio/blocks/vector_source_c.h>
 #endif
 
 #if PMT_USES_BOOST_ANY
@@ -133,8 +146,19 @@ protected:
 
     ~GpsL1CaPcpsAcquisitionTest() override = default;
 
+    struct Acquisition_Run
+    {
+        int message{0};
+        uint32_t num_doppler_bins{0};
+        uint32_t evaluated_doppler_bins{0};
+        float test_statistic{0.0};
+    };
+
     void init();
     void plot_grid() const;
+    gnss_shared_ptr<GpsL1CaPcpsAcquisition> connect_acquisition(const gr::basic_block_sptr &source, Gnss_Synchro *synchro, const GpsL1CaPcpsAcquisitionTest_msg_rx_sptr &msg_rx);
+    Acquisition_Run run_acquisition(const std::vector<gr_complex> &samples, Gnss_Synchro *synchro);
+    std::vector<gr_complex> synthesize(float cn0_db, uint32_t noise_dwells, uint32_t num_dwells, Gnss_Synchro &expected) const;
 
     gr::top_block_sptr top_block;
     std::shared_ptr<InMemoryConfiguration> config;
@@ -142,6 +166,7 @@ protected:
     size_t item_size;
     unsigned int doppler_max{5000};
     unsigned int doppler_step{100};
+    const uint32_t samples_per_dwell{4000};  // 1 ms at 4 Msps
 };
 
 
@@ -240,6 +265,66 @@ void GpsL1CaPcpsAcquisitionTest::plot_grid() const
 }
 
 
+gnss_shared_ptr<GpsL1CaPcpsAcquisition> GpsL1CaPcpsAcquisitionTest::connect_acquisition(const gr::basic_block_sptr &source, Gnss_Synchro *synchro, const GpsL1CaPcpsAcquisitionTest_msg_rx_sptr &msg_rx)
+{
+    auto acquisition = gnss_make_shared<GpsL1CaPcpsAcquisition>(config.get(), "Acquisition_1C", 1, 0);
+    acquisition->set_channel(1);
+    acquisition->set_gnss_synchro(synchro);
+    acquisition->set_threshold(0.001);
+    acquisition->set_doppler_max(doppler_max);
+    acquisition->set_doppler_step(doppler_step);
+    acquisition->connect(top_block);
+    top_block->connect(source, 0, acquisition->get_left_block(), 0);
+    top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+    acquisition->set_local_code();
+    acquisition->set_state(1);  // Ensure that acquisition starts at the first sample
+    acquisition->init();
+    return acquisition;
+}
+
+
+GpsL1CaPcpsAcquisitionTest::Acquisition_Run GpsL1CaPcpsAcquisitionTest::run_acquisition(const std::vector<gr_complex> &samples, Gnss_Synchro *synchro)
+{
+    top_block = gr::make_top_block("Acquisition test");
+    auto msg_rx = GpsL1CaPcpsAcquisitionTest_msg_rx_make();
+    auto acquisition = connect_acquisition(gr::blocks::vector_source_c::make(samples, false), synchro, msg_rx);
+    top_block->run();
+
+    Acquisition_Run run;
+    run.message = msg_rx->rx_message;
+    const auto *pcps = dynamic_cast<pcps_acquisition *>(acquisition->get_left_block().get());
+    if (pcps != nullptr)
+        {
+            run.num_doppler_bins = pcps->num_doppler_bins();
+            run.evaluated_doppler_bins = pcps->evaluated_doppler_bins();
+            run.test_statistic = pcps->test_statistic();
+        }
+    return run;
+}
+
+
+// PRN 1 at cn0_db, after noise_dwells dwells of noise only. The noise has
+// unit power.
+std::vector<gr_complex> GpsL1CaPcpsAcquisitionTest::synthesize(float cn0_db, uint32_t noise_dwells, uint32_t num_dwells, Gnss_Synchro &expected) const
+{
+    std::vector<Synthesized_Satellite> satellites(1);
+    satellites[0].PRN = 1;
+    satellites[0].CN0_dB = cn0_db;
+    Multisat_Signal_Synthesizer synthesizer(satellites, 4e6, 0.0, false, true, 1, 1);
+    std::vector<gr_complex> samples(num_dwells * samples_per_dwell);
+    synthesizer.generate(samples.data(), static_cast<uint32_t>(samples.size()));
+    std::default_random_engine e(1);
+    std::normal_distribution<float> noise(0.0F, std::sqrt(0.5F));
+    for (size_t n = 0; n < noise_dwells * samples_per_dwell; n++)
+        {
+            samples[n] = gr_complex(noise(e), noise(e));
+        }
+    expected.Acq_delay_samples = synthesizer.code_phase_chips(0, 0.0) / GPS_L1_CA_CODE_RATE_CPS * 4e6;
+    expected.Acq_doppler_hz = synthesizer.doppler_hz(0, 0.0);
+    return samples;
+}
+
+
 TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, Instantiate /*unused*/)
 {
     std::shared_ptr<GpsL1CaPcpsAcquisition> acquisition = std::make_shared<GpsL1CaPcpsAcquisition>(config.get(), "Acquisition_1C", 1, 0);
@@ -365,3 +450,214 @@ TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ValidationOfResults /*unused*/)
             plot_grid();
         }
 }
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, SequentialDetectionStopsEarly /*unused*/)
+{
+    init();
+    config->supersede_property("Acquisition_1C.dump", "false");
+    config->set_property("Acquisition_1C.pfa", "0.001");
+    config->set_property("Acquisition_1C.max_dwells", "2");
+    config->set_property("Acquisition_1C.sequential_detection", "true");
+
+    Gnss_Synchro expected{};
+    const std::vector<gr_complex> samples = synthesize(47.0, 0, 4, expected);
+    const Acquisition_Run run = run_acquisition(samples, &gnss_synchro);
+    ASSERT_EQ(1, run.message) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+
+    // the search stopped before the end of the grid
+    EXPECT_GT(run.evaluated_doppler_bins, 1U);
+    EXPECT_LT(run.evaluated_doppler_bins, run.num_doppler_bins);
+
+    const double delay_error_chips = std::abs(expected.Acq_delay_samples - gnss_synchro.Acq_delay_samples) * GPS_L1_CA_CODE_RATE_CPS / 4e6;
+    const double doppler_error_hz = std::abs(expected.Acq_doppler_hz - gnss_synchro.Acq_doppler_hz);
+    EXPECT_LE(doppler_error_hz, 666) << "Doppler error exceeds the expected value: 666 Hz = 2/(3*integration period)";
+    EXPECT_LT(delay_error_chips, 0.5) << "Delay error exceeds the expected value: 0.5 chips";
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, SequentialDetectionDismissesNoise /*unused*/)
+{
+    const uint32_t max_dwells = 10;
+    init();
+    config->supersede_property("Acquisition_1C.dump", "false");
+    config->set_property("Acquisition_1C.pfa", "0.001");
+    config->set_property("Acquisition_1C.max_dwells", std::to_string(max_dwells));
+    config->set_property("Acquisition_1C.sequential_dismissal_prob", "0.9");
+
+    std::vector<gr_complex> noise((max_dwells + 2) * samples_per_dwell);
+    std::default_random_engine e(2);
+    std::normal_distribution<float> dist(0.0F, std::sqrt(0.5F));
+    for (auto &sample : noise)
+        {
+            sample = gr_complex(dist(e), dist(e));
+        }
+
+    // Without sequential detection, noise is dismissed after max_dwells
+    config->set_property("Acquisition_1C.sequential_detection", "false");
+    Gnss_Synchro reference_synchro = gnss_synchro;
+    const Acquisition_Run reference = run_acquisition(noise, &reference_synchro);
+    ASSERT_EQ(2, reference.message) << "Expected message: 2=ACQ FAIL.";
+    EXPECT_GE(reference_synchro.Acq_samplestamp_samples, (max_dwells - 1) * samples_per_dwell);
+
+    // The grid of a dwell stays below the dismissal threshold with
+    // probability 0.9, so the search gives up within a few dwells
+    config->supersede_property("Acquisition_1C.sequential_detection", "true");
+    const Acquisition_Run run = run_acquisition(noise, &gnss_synchro);
+    ASSERT_EQ(2, run.message) << "Expected message: 2=ACQ FAIL.";
+    EXPECT_EQ(run.evaluated_doppler_bins, run.num_doppler_bins);
+    EXPECT_LE(gnss_synchro.Acq_samplestamp_samples, 4 * samples_per_dwell);
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, SequentialDetectionDumpsOnlyEvaluatedBins /*unused*/)
+{
+    const std::string dump_dir = "./tmp-acq-gps1-sequential";
+    if (fs::exists(dump_dir))
+        {
+            fs::remove_all(dump_dir);
+        }
+    fs::create_directory(dump_dir);
+
+    init();
+    config->supersede_property("Acquisition_1C.dump", "true");
+    config->supersede_property("Acquisition_1C.dump_filename", dump_dir + "/acquisition");
+    config->set_property("Acquisition_1C.pfa", "0.001");
+    config->set_property("Acquisition_1C.max_dwells", "2");
+    config->set_property("Acquisition_1C.sequential_detection", "true");
+
+    // The first dwell only has noise and evaluates the whole grid. The
+    // second one finds the satellite and stops early
+    Gnss_Synchro expected{};
+    const std::vector<gr_complex> samples = synthesize(47.0, 1, 4, expected);
+    const Acquisition_Run run = run_acquisition(samples, &gnss_synchro);
+    ASSERT_EQ(1, run.message) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+    ASSERT_LT(run.evaluated_doppler_bins, run.num_doppler_bins);
+
+    std::string dump_file;
+    for (const auto &entry : fs::directory_iterator(dump_dir))
+        {
+            if (entry.path().extension() == ".mat")
+                {
+                    dump_file = entry.path().string();
+                }
+        }
+    ASSERT_FALSE(dump_file.empty()) << "No acquisition dump file in " << dump_dir;
+    mat_t *matfp = Mat_Open(dump_file.c_str(), MAT_ACC_RDONLY);
+    ASSERT_NE(matfp, nullptr);
+    matvar_t *grid = Mat_VarRead(matfp, "acq_grid");
+    ASSERT_NE(grid, nullptr);
+    ASSERT_EQ(grid->dims[1], run.num_doppler_bins);
+
+    // the bins left out of the second dwell hold no value of the first one
+    const auto *magnitude = static_cast<const float *>(grid->data);
+    uint32_t zero_bins = 0;
+    for (size_t bin = 0; bin < grid->dims[1]; bin++)
+        {
+            bool zero = true;
+            for (size_t n = 0; n < grid->dims[0] and zero; n++)
+                {
+                    zero = magnitude[bin * grid->dims[0] + n] == 0.0F;
+                }
+            zero_bins += zero ? 1 : 0;
+        }
+    EXPECT_EQ(zero_bins, run.num_doppler_bins - run.evaluated_doppler_bins);
+    Mat_VarFree(grid);
+    Mat_Close(matfp);
+    fs::remove_all(dump_dir);
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, LowMemorySameAsFullGrid /*unused*/)
+{
+    Gnss_Synchro expected{};
+    const std::vector<gr_complex> samples = synthesize(45.0, 0, 4, expected);
+
+    // CFAR and peak ratio statistics with the reduced grid, and non-coherent
+    // integration, where only the Doppler wipeoffs are generated on the fly
+    const std::vector<std::pair<std::string, std::string>> cases = {{"0.001", "1"}, {"0.0", "1"}, {"0.001", "2"}};
+    for (const auto &test_case : cases)
+        {
+            const std::string name = "pfa " + test_case.first + ", max_dwells " + test_case.second;
+            config = std::make_shared<InMemoryConfiguration>();
+            init();
+            config->supersede_property("Acquisition_1C.dump", "false");
+            config->supersede_property("Acquisition_1C.pfa", test_case.first);
+            config->supersede_property("Acquisition_1C.max_dwells", test_case.second);
+
+            config->supersede_property("Acquisition_1C.low_memory", "false");
+            Gnss_Synchro full_synchro = gnss_synchro;
+            const Acquisition_Run full = run_acquisition(samples, &full_synchro);
+            ASSERT_EQ(1, full.message) << name;
+
+            config->supersede_property("Acquisition_1C.low_memory", "true");
+            Gnss_Synchro low_memory_synchro = gnss_synchro;
+            const Acquisition_Run low_memory = run_acquisition(samples, &low_memory_synchro);
+            ASSERT_EQ(1, low_memory.message) << name;
+
+            // the carrier generated by the rotator differs from the stored
+            // wipeoffs only by rounding errors
+            EXPECT_NEAR(low_memory.test_statistic, full.test_statistic, 1e-3 * full.test_statistic) << name;
+            EXPECT_EQ(low_memory_synchro.Acq_doppler_hz, full_synchro.Acq_doppler_hz) << name;
+            EXPECT_EQ(low_memory_synchro.Acq_delay_samples, full_synchro.Acq_delay_samples) << name;
+            EXPECT_EQ(low_memory_synchro.Acq_samplestamp_samples, full_synchro.Acq_samplestamp_samples) << name;
+
+            EXPECT_LE(std::abs(expected.Acq_doppler_hz - low_memory_synchro.Acq_doppler_hz), 666) << name;
+            EXPECT_LT(std::abs(expected.Acq_delay_samples - low_memory_synchro.Acq_delay_samples) * GPS_L1_CA_CODE_RATE_CPS / 4e6, 0.5) << name;
+        }
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ValidationOfResultsAfterSampleRingGap /*unused*/)
+{
+    init();
+    config->supersede_property("Acquisition_1C.dump", "false");
+    const std::string file = std::string(TEST_PATH) + "signal_samples/GPS_L1_CA_ID_1_Fs_4Msps_2ms.dat";
+
+    // Reference: the samples of the file, from the first one
+    Gnss_Synchro reference_synchro = gnss_synchro;
+    auto reference_msg_rx = GpsL1CaPcpsAcquisitionTest_msg_rx_make();
+    top_block = gr::make_top_block("Acquisition test");
+    auto file_source = gr::blocks::file_source::make(sizeof(gr_complex), file.c_str(), false);
+    auto reference_acquisition = connect_acquisition(file_source, &reference_synchro, reference_msg_rx);
+    top_block->run();
+    ASSERT_EQ(1, reference_msg_rx->rx_message) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+
+    // The same samples through a sample ring, whose reader starts 20000
+    // samples behind the writer, beyond its maximum lag
+    std::vector<gr_complex> samples(8000);
+    std::ifstream samples_file(file, std::ios::binary);
+    ASSERT_TRUE(samples_file.read(reinterpret_cast<char *>(samples.data()), static_cast<std::streamsize>(samples.size() * sizeof(gr_complex))));
+    auto ring = std::make_shared<Gnss_Sdr_Sample_Ring>(sizeof(gr_complex), 16000);
+    auto ring_source = gnss_sdr_make_sample_ring_source(ring, sizeof(gr_complex), 10000, 0);
+    Gnss_Synchro ring_synchro = gnss_synchro;
+    auto ring_msg_rx = GpsL1CaPcpsAcquisitionTest_msg_rx_make();
+    top_block = gr::make_top_block("Acquisition test");
+    auto ring_acquisition = connect_acquisition(ring_source, &ring_synchro, ring_msg_rx);
+
+    const std::vector<gr_complex> lost_samples(20000);
+    ring->write(lost_samples.data(), lost_samples.size());
+    top_block->start();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (ring_source->skips() == 0 and std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    ring->write(samples.data(), samples.size());
+    while (ring_msg_rx->rx_message == 0 and std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    top_block->stop();
+    top_block->wait();
+
+    ASSERT_EQ(1, ring_msg_rx->rx_message) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+    EXPECT_EQ(ring_source->skips(), 1U);
+    EXPECT_EQ(ring_source->skipped_samples(), lost_samples.size());
+
+    // The sample stamp handed over to tracking accounts for the skipped
+    // samples, and the search sees exactly the same samples
+    EXPECT_EQ(ring_synchro.Acq_samplestamp_samples, reference_synchro.Acq_samplestamp_samples + ring_source->skipped_samples());
+    EXPECT_EQ(ring_synchro.Acq_delay_samples, reference_synchro.Acq_delay_samples);
+    EXPECT_EQ(ring_synchro.Acq_doppler_hz, reference_synchro.Acq_doppler_hz);
+}
@@ -0,0 +1,56 @@
+/*!
+ * \file code_replica_store_test.cc
+ * \brief Unit tests for the process-wide store of sampled code replicas.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "code_replica_store.h"
+#include "gps_sdr_signal_replica.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+
+TEST(CodeReplicaStoreTest, GeneratesEachReplicaOnce)
+{
+    Code_Replica_Store& store = Code_Replica_Store::instance();
+    store.clear();
+
+    int calls = 0;
+    const auto generator = [&calls](own::span<float> code) {
+        calls++;
+        gps_l1_ca_code_gen_float(code, 1, 0);
+    };
+    const Code_Replica_Store::Replica_Ptr first = store.get("GPS 1C C/A PRN 1 2046", 2046, generator);
+    const Code_Replica_Store::Replica_Ptr second = store.get("GPS 1C C/A PRN 1 2046", 2046, generator);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(store.size(), 1U);
+
+    std::vector<float> expected(2046, 0.0);
+    gps_l1_ca_code_gen_float(expected, 1, 0);
+    ASSERT_EQ(first->size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++)
+        {
+            EXPECT_EQ((*first)[i], expected[i]);
+        }
+
+    // Other PRNs get their own replica
+    const Code_Replica_Store::Replica_Ptr other = store.get("GPS 1C C/A PRN 2 2046", 2046, [](own::span<float> code) { gps_l1_ca_code_gen_float(code, 2, 0); });
+    EXPECT_NE(first.get(), other.get());
+    EXPECT_EQ(store.size(), 2U);
+
+    // Replicas in use survive clearing the store
+    store.clear();
+    EXPECT_EQ(store.size(), 0U);
+    EXPECT_EQ((*first)[0], expected[0]);
+}
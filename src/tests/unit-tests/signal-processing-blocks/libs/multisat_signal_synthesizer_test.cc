@@ -0,0 +1,332 @@
+/*!
+ * \file multisat_signal_synthesizer_test.cc
+ * \brief Unit tests for the multi-satellite signal synthesizer.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Beidou_B1I.h"
+#include "GLONASS_L1_L2_CA.h"
+#include "GPS_L1_CA.h"
+#include "Galileo_E1.h"
+#include "MATH_CONSTANTS.h"
+#include "beidou_b1i_signal_replica.h"
+#include "galileo_e1_signal_replica.h"
+#include "glonass_l1_signal_replica.h"
+#include "gps_sdr_signal_replica.h"
+#include "multisat_signal_synthesizer.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+std::vector<Synthesized_Satellite> mixed_constellation(uint32_t num_satellites)
+{
+    const char systems[] = "GECR";
+    std::vector<Synthesized_Satellite> satellites;
+    for (uint32_t n = 0; n < num_satellites; n++)
+        {
+            Synthesized_Satellite sat;
+            sat.system = systems[n % 4];
+            sat.PRN = 1 + (n / 4) % 24;
+            sat.elevation_deg = 10.0 + (n * 7) % 80;
+            sat.azimuth_deg = (n * 37) % 360;
+            satellites.push_back(sat);
+        }
+    return satellites;
+}
+
+
+// Correlation of count samples of the signal, starting at first, with a
+// replica holding one value per replica sample. The replica advances
+// code_rate samples per second, and its first epoch starts delay replica
+// samples after the first sample of the signal.
+std::complex<double> correlate_replica(const std::vector<std::complex<float>>& signal, const std::vector<float>& replica, double fs_hz,
+    double doppler_hz, double code_rate, double delay, size_t first, size_t count)
+{
+    const auto length = static_cast<double>(replica.size());
+    std::complex<double> acc(0.0, 0.0);
+    for (size_t n = first; n < first + count; n++)
+        {
+            const double t = static_cast<double>(n) / fs_hz;
+            const double sample = std::floor(code_rate * t - delay);
+            const auto index = static_cast<size_t>(sample - std::floor(sample / length) * length);
+            acc += std::complex<double>(signal[n]) * std::polar(1.0, -TWO_PI * doppler_hz * t) * static_cast<double>(replica[index]);
+        }
+    return acc;
+}
+
+
+// Correlations over each of the first epochs code periods, leaving out the
+// samples next to the epoch edges
+std::vector<std::complex<double>> correlate_epochs(const std::vector<std::complex<float>>& signal, const std::vector<float>& replica, double fs_hz,
+    double doppler_hz, double code_rate, double delay, uint32_t epochs)
+{
+    const auto length = static_cast<double>(replica.size());
+    std::vector<std::complex<double>> correlations;
+    for (uint32_t k = 0; k < epochs; k++)
+        {
+            const auto first = static_cast<size_t>(std::ceil((delay + k * length) / code_rate * fs_hz)) + 1;
+            const auto last = static_cast<size_t>(std::floor((delay + (k + 1) * length) / code_rate * fs_hz)) - 1;
+            correlations.push_back(correlate_replica(signal, replica, fs_hz, doppler_hz, code_rate, delay, first, last - first));
+        }
+    return correlations;
+}
+
+
+// Sign of each correlation relative to the first one
+std::vector<int32_t> relative_signs(const std::vector<std::complex<double>>& correlations)
+{
+    std::vector<int32_t> signs;
+    for (const auto& c : correlations)
+        {
+            signs.push_back(std::real(c * std::conj(correlations[0])) < 0.0 ? -1 : 1);
+        }
+    return signs;
+}
+
+
+int32_t secondary_chip(const std::string& code, int64_t k)
+{
+    const auto length = static_cast<int64_t>(code.size());
+    return code[((k % length) + length) % length] == '0' ? 1 : -1;
+}
+
+
+// Correlation with a GPS L1 C/A replica delayed delay_chips, with the given Doppler
+double correlate_gps(const std::vector<std::complex<float>>& signal, int32_t prn, double fs_hz, double doppler_hz, double delay_chips)
+{
+    std::vector<float> code(static_cast<size_t>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    gps_l1_ca_code_gen_float(code, prn, 0);
+    const double code_rate = GPS_L1_CA_CODE_RATE_CPS * (1.0 + doppler_hz / GPS_L1_FREQ_HZ);
+    return std::abs(correlate_replica(signal, code, fs_hz, doppler_hz, code_rate, delay_chips, 0, signal.size()));
+}
+}  // namespace
+
+
+TEST(MultisatSignalSynthesizerTest, CorrelatesAtModelDelayAndDoppler)
+{
+    const double fs_hz = 4e6;
+    std::vector<Synthesized_Satellite> satellites(1);
+    satellites[0].PRN = 7;
+    satellites[0].elevation_deg = 40.0;
+    satellites[0].azimuth_deg = 30.0;
+    Multisat_Signal_Synthesizer synthesizer(satellites, fs_hz, 0.0, false, false, 1, 1);
+    EXPECT_NEAR(synthesizer.elevation_deg(0, 0.0), 40.0, 1e-6);
+
+    std::vector<std::complex<float>> signal(4000);
+    synthesizer.generate(signal.data(), static_cast<uint32_t>(signal.size()));
+
+    const double doppler_hz = synthesizer.doppler_hz(0, 0.0005);
+    const double delay_chips = synthesizer.code_phase_chips(0, 0.0);
+    EXPECT_LT(std::abs(doppler_hz), 5000.0);
+
+    const double amplitude = std::sqrt(std::pow(10.0, 45.0 / 10.0) / fs_hz);
+    const double peak = correlate_gps(signal, 7, fs_hz, doppler_hz, delay_chips);
+    EXPECT_GT(peak, 0.9 * amplitude * static_cast<double>(signal.size()));
+    EXPECT_LT(correlate_gps(signal, 7, fs_hz, doppler_hz, delay_chips + 2.0), 0.2 * peak);
+    EXPECT_LT(correlate_gps(signal, 7, fs_hz, doppler_hz + 1000.0, delay_chips), 0.2 * peak);
+    EXPECT_LT(correlate_gps(signal, 8, fs_hz, doppler_hz, delay_chips), 0.2 * peak);
+}
+
+
+TEST(MultisatSignalSynthesizerTest, OutputDoesNotDependOnThreadsOrCallSize)
+{
+    const double fs_hz = 4e6;
+    const std::vector<Synthesized_Satellite> satellites = mixed_constellation(12);
+    Multisat_Signal_Synthesizer single(satellites, fs_hz, 0.0, true, false, 1, 3);
+    Multisat_Signal_Synthesizer multi(satellites, fs_hz, 0.0, true, false, 3, 3);
+    Multisat_Signal_Synthesizer split(satellites, fs_hz, 0.0, true, false, 3, 3);
+    EXPECT_EQ(multi.threads(), 3U);
+
+    std::vector<std::complex<float>> expected(10000);
+    std::vector<std::complex<float>> actual(10000);
+    std::vector<std::complex<float>> actual_split(10000);
+    single.generate(expected.data(), 10000);
+    multi.generate(actual.data(), 10000);
+    // Calls not aligned with the code epochs or the 1 ms blocks
+    split.generate(actual_split.data(), 3333);
+    split.generate(actual_split.data() + 3333, 6667);
+    EXPECT_EQ(split.sample_counter(), 10000U);
+
+    double power = 0.0;
+    int32_t chip_edge_mismatches = 0;
+    for (size_t n = 0; n < expected.size(); n++)
+        {
+            // Only the order of the sums differs
+            EXPECT_NEAR(std::abs(expected[n] - actual[n]), 0.0, 1e-5) << "at sample " << n;
+            // Samples lying on a chip edge may fall on either side of it
+            if (std::abs(expected[n] - actual_split[n]) > 5e-3)
+                {
+                    chip_edge_mismatches++;
+                }
+            power += std::norm(expected[n]);
+        }
+    EXPECT_LT(chip_edge_mismatches, 10);
+    EXPECT_GT(power, 0.0);
+}
+
+
+
+TEST(MultisatSignalSynthesizerTest, GalileoE1PilotWithBocAndSecondaryCode)
+{
+    const double fs_hz = 4e6;
+    std::vector<Synthesized_Satellite> satellites(1);
+    satellites[0].system = 'E';
+    satellites[0].PRN = 11;
+    satellites[0].CN0_dB = 50.0;
+    Multisat_Signal_Synthesizer synthesizer(satellites, fs_hz, 0.0, true, false, 1, 1);
+
+    // one full period of the secondary code, plus the initial delay
+    const uint32_t epochs = GALILEO_E1_C_SECONDARY_CODE_LENGTH;
+    std::vector<std::complex<float>> signal(static_cast<size_t>(fs_hz * GALILEO_E1_CODE_PERIOD_S * (epochs + 1)));
+    synthesizer.generate(signal.data(), static_cast<uint32_t>(signal.size()));
+
+    // BOC(1,1) pilot replica, with two samples per chip
+    std::vector<float> pilot(2 * static_cast<size_t>(GALILEO_E1_B_CODE_LENGTH_CHIPS));
+    const std::array<char, 3> signal_1c = {{'1', 'C', '\0'}};
+    galileo_e1_code_gen_sinboc11_float(pilot, signal_1c, 11);
+    const double doppler_hz = synthesizer.doppler_hz(0, 0.05);
+    const double code_rate = 2.0 * GALILEO_E1_CODE_CHIP_RATE_CPS * (1.0 + doppler_hz / GALILEO_E1_FREQ_HZ);
+    const double delay = 2.0 * synthesizer.code_phase_chips(0, 0.0);
+    const auto correlations = correlate_epochs(signal, pilot, fs_hz, doppler_hz, code_rate, delay, epochs);
+
+    // the pilot carries half of the power
+    const double amplitude = std::sqrt(std::pow(10.0, 50.0 / 10.0) / fs_hz / 2.0);
+    const double epoch_samples = fs_hz * GALILEO_E1_CODE_PERIOD_S;
+    for (const auto& c : correlations)
+        {
+            EXPECT_GT(std::abs(c), 0.85 * amplitude * epoch_samples);
+        }
+
+    // BOC(1,1) correlation: negative at half a chip, null at one chip
+    const size_t first = static_cast<size_t>(std::ceil(delay / code_rate * fs_hz)) + 1;
+    const auto count = static_cast<size_t>(epoch_samples) - 2;
+    const std::complex<double> peak = correlate_replica(signal, pilot, fs_hz, doppler_hz, code_rate, delay, first, count);
+    const std::complex<double> half_chip = correlate_replica(signal, pilot, fs_hz, doppler_hz, code_rate, delay + 1.0, first, count);
+    const std::complex<double> one_chip = correlate_replica(signal, pilot, fs_hz, doppler_hz, code_rate, delay + 2.0, first, count);
+    EXPECT_LT(std::real(half_chip * std::conj(peak)), -0.3 * std::norm(peak));
+    EXPECT_LT(std::abs(one_chip), 0.2 * std::abs(peak));
+
+    // The pilot signs follow the secondary code, from some chip on
+    const std::vector<int32_t> signs = relative_signs(correlations);
+    bool found = false;
+    for (int64_t shift = 0; shift < epochs and not found; shift++)
+        {
+            found = true;
+            for (int64_t k = 0; k < epochs; k++)
+                {
+                    if (signs[k] != secondary_chip(GALILEO_E1_C_SECONDARY_CODE, k + shift) * secondary_chip(GALILEO_E1_C_SECONDARY_CODE, shift))
+                        {
+                            found = false;
+                        }
+                }
+        }
+    EXPECT_TRUE(found);
+}
+
+
+TEST(MultisatSignalSynthesizerTest, BeidouB1IDataWithNeumannHoffmanCode)
+{
+    const double fs_hz = 4e6;
+    std::vector<Synthesized_Satellite> satellites(1);
+    satellites[0].system = 'C';
+    satellites[0].PRN = 10;  // MEO/IGSO satellite, D1 message
+    satellites[0].CN0_dB = 50.0;
+    Multisat_Signal_Synthesizer synthesizer(satellites, fs_hz, 0.0, true, false, 1, 1);
+
+    const uint32_t epochs = 40;  // two data bits
+    std::vector<std::complex<float>> signal(static_cast<size_t>(fs_hz * BEIDOU_B1I_CODE_PERIOD_S * (epochs + 1)));
+    synthesizer.generate(signal.data(), static_cast<uint32_t>(signal.size()));
+
+    std::vector<float> code(static_cast<size_t>(BEIDOU_B1I_CODE_LENGTH_CHIPS));
+    beidou_b1i_code_gen_float(code, 10, 0);
+    const double doppler_hz = synthesizer.doppler_hz(0, 0.02);
+    const double code_rate = BEIDOU_B1I_CODE_RATE_CPS * (1.0 + doppler_hz / BEIDOU_B1I_FREQ_HZ);
+    const auto correlations = correlate_epochs(signal, code, fs_hz, doppler_hz, code_rate, synthesizer.code_phase_chips(0, 0.0), epochs);
+
+    const double amplitude = std::sqrt(std::pow(10.0, 50.0 / 10.0) / fs_hz);
+    for (const auto& c : correlations)
+        {
+            EXPECT_GT(std::abs(c), 0.9 * amplitude * fs_hz * BEIDOU_B1I_CODE_PERIOD_S);
+        }
+
+    // Once the NH code is removed, the sign only changes at bit edges, which
+    // are aligned with the start of the NH code
+    const std::vector<int32_t> signs = relative_signs(correlations);
+    const int64_t nh_length = BEIDOU_B1I_SECONDARY_CODE_LENGTH;
+    bool found = false;
+    for (int64_t shift = 0; shift < nh_length and not found; shift++)
+        {
+            found = true;
+            for (int64_t k = 1; k < epochs; k++)
+                {
+                    const bool bit_edge = (k + shift) % nh_length == 0;
+                    const int32_t bit = signs[k] * secondary_chip(BEIDOU_B1I_SECONDARY_CODE_STR, k + shift);
+                    const int32_t previous_bit = signs[k - 1] * secondary_chip(BEIDOU_B1I_SECONDARY_CODE_STR, k - 1 + shift);
+                    if (not bit_edge and bit != previous_bit)
+                        {
+                            found = false;
+                        }
+                }
+        }
+    EXPECT_TRUE(found);
+
+    // without the NH code there would be at most two sign changes
+    int32_t sign_changes = 0;
+    for (size_t k = 1; k < signs.size(); k++)
+        {
+            sign_changes += (signs[k] != signs[k - 1]) ? 1 : 0;
+        }
+    EXPECT_GT(sign_changes, 2);
+}
+
+
+TEST(MultisatSignalSynthesizerTest, GlonassL1CAAtChannelFrequency)
+{
+    const double fs_hz = 4e6;
+    std::vector<Synthesized_Satellite> satellites(1);
+    satellites[0].system = 'R';
+    satellites[0].PRN = 1;
+    satellites[0].CN0_dB = 50.0;
+    Multisat_Signal_Synthesizer synthesizer(satellites, fs_hz, 0.0, false, false, 1, 1);
+
+    std::vector<std::complex<float>> signal(8000);
+    synthesizer.generate(signal.data(), static_cast<uint32_t>(signal.size()));
+
+    // The Doppler includes the FDMA offset of the frequency channel
+    const int32_t k = GLONASS_PRN.at(1);
+    ASSERT_NE(k, 0);
+    const double offset_hz = k * GLONASS_L1_CA_DFREQ_HZ;
+    const double doppler_hz = synthesizer.doppler_hz(0, 0.001);
+    EXPECT_NEAR(doppler_hz, offset_hz, 5000.0);
+
+    std::vector<std::complex<float>> complex_code(static_cast<size_t>(GLONASS_L1_CA_CODE_LENGTH_CHIPS));
+    glonass_l1_ca_code_gen_complex(complex_code, 0);
+    std::vector<float> code(complex_code.size());
+    std::transform(complex_code.cbegin(), complex_code.cend(), code.begin(), [](const std::complex<float>& c) { return c.real(); });
+    const double code_rate = GLONASS_L1_CA_CODE_RATE_CPS * (1.0 + (doppler_hz - offset_hz) / (GLONASS_L1_CA_FREQ_HZ + offset_hz));
+    const double delay = synthesizer.code_phase_chips(0, 0.0);
+
+    const double amplitude = std::sqrt(std::pow(10.0, 50.0 / 10.0) / fs_hz);
+    const double peak = std::abs(correlate_replica(signal, code, fs_hz, doppler_hz, code_rate, delay, 0, signal.size()));
+    EXPECT_GT(peak, 0.9 * amplitude * static_cast<double>(signal.size()));
+    EXPECT_LT(std::abs(correlate_replica(signal, code, fs_hz, doppler_hz, code_rate, delay + 2.0, 0, signal.size())), 0.2 * peak);
+    // nothing at the Doppler without the channel offset
+    EXPECT_LT(std::abs(correlate_replica(signal, code, fs_hz, doppler_hz - offset_hz, code_rate, delay, 0, signal.size())), 0.2 * peak);
+}
@@ -0,0 +1,355 @@
+/*!
+ * \file vtl_engine_test.cc
+ * \brief Unit tests for the vector tracking engine shared by the channels.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "vtl_engine.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+
+namespace
+{
+constexpr double VTL_TEST_FS = 4e6;
+constexpr double VTL_TEST_L1_HZ = 1575.42e6;
+constexpr double VTL_TEST_CHIP_RATE = 1.023e6;
+constexpr int32_t VTL_TEST_CHANNELS = 6;
+
+const std::array<double, 3> VTL_TEST_RX_POS = {4.0e6, 0.5e6, 4.9e6};
+const std::array<std::array<double, 3>, VTL_TEST_CHANNELS> VTL_TEST_SAT_POS = {{{2.0e7, 0.3e7, 1.6e7},
+    {0.8e7, 1.8e7, 1.7e7},
+    {1.5e7, -1.2e7, 1.8e7},
+    {2.5e7, 0.5e7, 0.2e7},
+    {0.3e7, 0.6e7, 2.6e7},
+    {1.9e7, 1.6e7, 0.5e7}}};
+const std::array<std::array<double, 3>, VTL_TEST_CHANNELS> VTL_TEST_SAT_VEL = {{{-1500.0, 2500.0, 1200.0},
+    {2000.0, -1000.0, 1500.0},
+    {-2500.0, -1800.0, 900.0},
+    {300.0, 3000.0, -1500.0},
+    {2800.0, -900.0, -300.0},
+    {-1200.0, 600.0, 3100.0}}};
+
+double vtl_test_doppler(int32_t ch, double t, const std::array<double, 3>& rx_vel, double drift)
+{
+    std::array<double, 3> los{};
+    double range = 0.0;
+    for (int i = 0; i < 3; i++)
+        {
+            los[i] = VTL_TEST_SAT_POS[ch][i] + VTL_TEST_SAT_VEL[ch][i] * t - (VTL_TEST_RX_POS[i] + rx_vel[i] * t);
+            range += los[i] * los[i];
+        }
+    range = std::sqrt(range);
+    double rate = drift;
+    for (int i = 0; i < 3; i++)
+        {
+            rate += los[i] / range * (VTL_TEST_SAT_VEL[ch][i] - rx_vel[i]);
+        }
+    return -rate * VTL_TEST_L1_HZ / SPEED_OF_LIGHT_M_S;
+}
+
+
+double vtl_test_range(int32_t ch, double t, const arma::vec& rx_pos)
+{
+    double range = 0.0;
+    for (arma::uword i = 0; i < 3; i++)
+        {
+            const double d = VTL_TEST_SAT_POS[ch][i] + VTL_TEST_SAT_VEL[ch][i] * t - rx_pos(i);
+            range += d * d;
+        }
+    return std::sqrt(range);
+}
+
+
+// PVT fix of a receiver at pos, with the states of all the test satellites
+Vtl_Engine::Navigation_Solution vtl_test_solution(uint64_t sample_counter, const std::array<double, 3>& pos)
+{
+    Vtl_Engine::Navigation_Solution solution{};
+    solution.sample_counter = sample_counter;
+    solution.fs = VTL_TEST_FS;
+    solution.pos = pos;
+    const double t = static_cast<double>(sample_counter) / VTL_TEST_FS;
+    for (int32_t ch = 0; ch < VTL_TEST_CHANNELS; ch++)
+        {
+            Vtl_Engine::Satellite_State sat{};
+            for (int i = 0; i < 3; i++)
+                {
+                    sat.pos[i] = VTL_TEST_SAT_POS[ch][i] + VTL_TEST_SAT_VEL[ch][i] * t;
+                }
+            sat.vel = VTL_TEST_SAT_VEL[ch];
+            sat.satellite = Vtl_Engine::satellite_id('G', ch + 1);
+            solution.satellites[ch] = sat;
+        }
+    return solution;
+}
+
+
+// Doppler of a static receiver, and no code error
+Vtl_Engine::Channel_Measurement vtl_test_measurement(int32_t ch, uint64_t sample_counter)
+{
+    Vtl_Engine::Channel_Measurement m{};
+    m.sample_counter = sample_counter;
+    m.fs = VTL_TEST_FS;
+    m.carrier_freq_hz = VTL_TEST_L1_HZ;
+    m.code_chip_rate = VTL_TEST_CHIP_RATE;
+    m.carrier_doppler_hz = vtl_test_doppler(ch, static_cast<double>(sample_counter) / VTL_TEST_FS, {0.0, 0.0, 0.0}, 0.0);
+    m.cn0_db_hz = 45.0;
+    m.satellite = Vtl_Engine::satellite_id('G', ch + 1);
+    return m;
+}
+}  // namespace
+
+
+TEST(VtlEngineTest, CommandsNeedASolution)
+{
+    Vtl_Engine& engine = Vtl_Engine::instance();
+    engine.reset();
+    engine.register_channel(0);
+
+    Vtl_Engine::Channel_Measurement m{};
+    m.sample_counter = 100000;
+    m.fs = VTL_TEST_FS;
+    m.carrier_freq_hz = VTL_TEST_L1_HZ;
+    m.code_chip_rate = VTL_TEST_CHIP_RATE;
+    m.satellite = Vtl_Engine::satellite_id('G', 1);
+    engine.post_measurement(0, m);
+    EXPECT_FALSE(engine.update(100000));
+    EXPECT_FALSE(engine.has_solution());
+    TrackingCmd cmd;
+    EXPECT_EQ(engine.read_command(0, cmd), 0U);
+
+    // unregistered and out of range channels are ignored
+    engine.post_measurement(Vtl_Engine::MAX_CHANNELS, m);
+    EXPECT_EQ(engine.read_command(Vtl_Engine::MAX_CHANNELS, cmd), 0U);
+}
+
+
+TEST(VtlEngineTest, EstimatesVelocityAndDriftFromAllChannels)
+{
+    Vtl_Engine& engine = Vtl_Engine::instance();
+    engine.reset();
+    Vtl_Engine::Parameters parameters;
+    parameters.update_period_s = 0.02;
+    engine.configure(parameters);
+
+    const std::array<double, 3> rx_vel = {5.0, -3.0, 1.0};
+    const double drift = 100.0;
+
+    // the PVT fix knows the position, but not the velocity nor the drift
+    Vtl_Engine::Navigation_Solution solution{};
+    solution.sample_counter = 0;
+    solution.fs = VTL_TEST_FS;
+    solution.pos = VTL_TEST_RX_POS;
+    for (int32_t ch = 0; ch < VTL_TEST_CHANNELS; ch++)
+        {
+            engine.register_channel(ch);
+            Vtl_Engine::Satellite_State sat{};
+            sat.pos = VTL_TEST_SAT_POS[ch];
+            sat.vel = VTL_TEST_SAT_VEL[ch];
+            sat.satellite = Vtl_Engine::satellite_id('G', ch + 1);
+            solution.satellites[ch] = sat;
+        }
+    engine.set_navigation_solution(solution);
+    ASSERT_TRUE(engine.has_solution());
+
+    const auto period_samples = static_cast<uint64_t>(parameters.update_period_s * VTL_TEST_FS);
+    uint64_t sample_counter = 0;
+    for (int epoch = 0; epoch < 50; epoch++)
+        {
+            sample_counter += period_samples;
+            const double t = static_cast<double>(sample_counter) / VTL_TEST_FS;
+            for (int32_t ch = 0; ch < VTL_TEST_CHANNELS; ch++)
+                {
+                    Vtl_Engine::Channel_Measurement m{};
+                    m.sample_counter = sample_counter;
+                    m.fs = VTL_TEST_FS;
+                    m.carrier_freq_hz = VTL_TEST_L1_HZ;
+                    m.code_chip_rate = VTL_TEST_CHIP_RATE;
+                    m.carrier_doppler_hz = vtl_test_doppler(ch, t, rx_vel, drift);
+                    m.cn0_db_hz = 45.0;
+                    m.satellite = Vtl_Engine::satellite_id('G', ch + 1);
+                    engine.post_measurement(ch, m);
+                }
+            // only the first channel reaching the epoch runs the filter step
+            EXPECT_TRUE(engine.update(sample_counter));
+            EXPECT_FALSE(engine.update(sample_counter));
+        }
+    EXPECT_EQ(engine.steps(), 50U);
+
+    const arma::vec x = engine.state();
+    EXPECT_NEAR(x(3), rx_vel[0], 0.05);
+    EXPECT_NEAR(x(4), rx_vel[1], 0.05);
+    EXPECT_NEAR(x(5), rx_vel[2], 0.05);
+    EXPECT_NEAR(x(7), drift, 0.05);
+
+    const double t = static_cast<double>(sample_counter) / VTL_TEST_FS;
+    for (int32_t ch = 0; ch < VTL_TEST_CHANNELS; ch++)
+        {
+            TrackingCmd cmd;
+            EXPECT_GT(engine.read_command(ch, cmd), 0U);
+            EXPECT_EQ(cmd.sample_counter, sample_counter);
+            EXPECT_NEAR(cmd.carrier_freq_hz, vtl_test_doppler(ch, t, rx_vel, drift), 0.5);
+            EXPECT_NEAR(cmd.code_freq_chips, VTL_TEST_CHIP_RATE * (1.0 + cmd.carrier_freq_hz / VTL_TEST_L1_HZ), 1e-6);
+        }
+
+    // a released channel is not commanded until it posts again
+    engine.release_channel(0);
+    TrackingCmd cmd;
+    EXPECT_EQ(engine.read_command(0, cmd), 0U);
+}
+
+
+TEST(VtlEngineTest, ReconfiguredEngineCommandsTheNextRun)
+{
+    Vtl_Engine& engine = Vtl_Engine::instance();
+    Vtl_Engine::Parameters parameters;
+    parameters.update_period_s = 0.02;
+    const auto period_samples = static_cast<uint64_t>(parameters.update_period_s * VTL_TEST_FS);
+    for (int32_t ch = 0; ch < VTL_TEST_CHANNELS; ch++)
+        {
+            engine.register_channel(ch);
+        }
+
+    // a first run of the flowgraph, which ends at 100 s
+    engine.configure(parameters);
+    uint64_t sample_counter = static_cast<uint64_t>(100.0 * VTL_TEST_FS) - 10 * period_samples;
+    engine.set_navigation_solution(vtl_test_solution(sample_counter, VTL_TEST_RX_POS));
+    for (int epoch = 0; epoch < 10; epoch++)
+        {
+            sample_counter += period_samples;
+            for (int32_t ch = 0; ch < VTL_TEST_CHANNELS; ch++)
+                {
+                    engine.post_measurement(ch, vtl_test_measurement(ch, sample_counter));
+                }
+            EXPECT_TRUE(engine.update(sample_counter));
+        }
+    TrackingCmd cmd;
+    EXPECT_GT(engine.read_command(0, cmd), 0U);
+
+    // the next run starts from sample zero, and the PVT block configures the
+    // engine again when it is built
+    engine.configure(parameters);
+    EXPECT_FALSE(engine.has_solution());
+    EXPECT_EQ(engine.steps(), 0U);
+    sample_counter = period_samples;
+    engine.post_measurement(0, vtl_test_measurement(0, sample_counter));
+    EXPECT_FALSE(engine.update(sample_counter));
+    EXPECT_EQ(engine.read_command(0, cmd), 0U) << "command of the previous run";
+
+    sample_counter = 0;
+    engine.set_navigation_solution(vtl_test_solution(sample_counter, VTL_TEST_RX_POS));
+    for (int epoch = 0; epoch < 10; epoch++)
+        {
+            sample_counter += period_samples;
+            for (int32_t ch = 0; ch < VTL_TEST_CHANNELS; ch++)
+                {
+                    engine.post_measurement(ch, vtl_test_measurement(ch, sample_counter));
+                }
+            EXPECT_TRUE(engine.update(sample_counter)) << "epoch " << epoch;
+            for (int32_t ch = 0; ch < VTL_TEST_CHANNELS; ch++)
+                {
+                    ASSERT_GT(engine.read_command(ch, cmd), 0U);
+                    EXPECT_EQ(cmd.sample_counter, sample_counter);
+                    EXPECT_TRUE(cmd.enable_code_nco_cmd);
+                    EXPECT_NEAR(cmd.carrier_freq_hz, vtl_test_doppler(ch, static_cast<double>(sample_counter) / VTL_TEST_FS, {0.0, 0.0, 0.0}, 0.0), 0.5);
+                }
+        }
+    EXPECT_EQ(engine.steps(), 10U);
+
+    // a fix older than the engine state, as if the flowgraph restarted
+    // without configuring the engine, reinitializes it
+    engine.set_navigation_solution(vtl_test_solution(0, VTL_TEST_RX_POS));
+    EXPECT_TRUE(engine.update(period_samples));
+}
+
+
+TEST(VtlEngineTest, VectorModeCorrectsTheCodePhase)
+{
+    Vtl_Engine& engine = Vtl_Engine::instance();
+    Vtl_Engine::Parameters parameters;
+    parameters.update_period_s = 0.02;
+    engine.configure(parameters);
+    const auto period_samples = static_cast<uint64_t>(parameters.update_period_s * VTL_TEST_FS);
+
+    // the PVT fix is 20 m away from the receiver
+    const arma::vec rx_pos = {VTL_TEST_RX_POS[0], VTL_TEST_RX_POS[1], VTL_TEST_RX_POS[2]};
+    const arma::vec fix_error = {12.0, -9.0, 13.0};
+    const arma::vec fix = rx_pos + fix_error;
+    for (int32_t ch = 0; ch < VTL_TEST_CHANNELS; ch++)
+        {
+            engine.register_channel(ch);
+        }
+    engine.set_navigation_solution(vtl_test_solution(0, {fix(0), fix(1), fix(2)}));
+
+    // The replica of each channel follows the range predicted by the engine,
+    // plus the code phase corrections it commands
+    std::array<double, VTL_TEST_CHANNELS> replica_range_m{};
+    for (int32_t ch = 0; ch < VTL_TEST_CHANNELS; ch++)
+        {
+            replica_range_m[ch] = vtl_test_range(ch, 0.0, fix);
+        }
+    uint64_t sample_counter = 0;
+    for (int epoch = 0; epoch < 100; epoch++)
+        {
+            // code errors are only used from the channels in vector mode
+            const bool vector_mode = epoch >= 5;
+            sample_counter += period_samples;
+            const double t = static_cast<double>(sample_counter) / VTL_TEST_FS;
+            for (int32_t ch = 0; ch < VTL_TEST_CHANNELS; ch++)
+                {
+                    // the replica moves with the satellite, which the engine knows
+                    replica_range_m[ch] += vtl_test_range(ch, t, fix) - vtl_test_range(ch, t - parameters.update_period_s, fix);
+                    Vtl_Engine::Channel_Measurement m = vtl_test_measurement(ch, sample_counter);
+                    m.vector_mode = vector_mode;
+                    m.code_error_chips = (vtl_test_range(ch, t, rx_pos) - replica_range_m[ch]) * VTL_TEST_CHIP_RATE / SPEED_OF_LIGHT_M_S;
+                    engine.post_measurement(ch, m);
+                }
+            ASSERT_TRUE(engine.update(sample_counter));
+            for (int32_t ch = 0; ch < VTL_TEST_CHANNELS; ch++)
+                {
+                    TrackingCmd cmd;
+                    ASSERT_GT(engine.read_command(ch, cmd), 0U);
+                    if (!vector_mode)
+                        {
+                            EXPECT_NEAR(cmd.code_phase_correction_chips, 0.0, 1e-3) << "epoch " << epoch << ", channel " << ch;
+                        }
+                    replica_range_m[ch] += cmd.code_phase_correction_chips * SPEED_OF_LIGHT_M_S / VTL_TEST_CHIP_RATE;
+                }
+        }
+
+    // the engine found the receiver, and the replicas are aligned with the signals
+    const arma::vec x = engine.state();
+    EXPECT_LT(arma::norm(x.subvec(0, 2) - rx_pos), 1.0);
+    EXPECT_NEAR(x(6), 0.0, 1.0);
+    const double t = static_cast<double>(sample_counter) / VTL_TEST_FS;
+    for (int32_t ch = 0; ch < VTL_TEST_CHANNELS; ch++)
+        {
+            EXPECT_NEAR(replica_range_m[ch], vtl_test_range(ch, t, rx_pos), 1.0) << "channel " << ch;
+        }
+
+    // code errors of half a chip or more are outliers
+    sample_counter += period_samples;
+    for (int32_t ch = 0; ch < VTL_TEST_CHANNELS; ch++)
+        {
+            Vtl_Engine::Channel_Measurement m = vtl_test_measurement(ch, sample_counter);
+            m.vector_mode = true;
+            m.code_error_chips = 0.6;
+            engine.post_measurement(ch, m);
+        }
+    ASSERT_TRUE(engine.update(sample_counter));
+    TrackingCmd cmd;
+    ASSERT_GT(engine.read_command(0, cmd), 0U);
+    EXPECT_NEAR(cmd.code_phase_correction_chips, 0.0, 1e-3);
+}
@@ -41,6 +41,7 @@
 #include "in_memory_configuration.h"
 #include "observable_tests_flags.h"
 #include "observables_dump_reader.h"
+#include "rinex_reader.h"
 #include "signal_generator_flags.h"
 #include "telemetry_decoder_interface.h"
 #include "test_flags.h"
@@ -57,17 +58,14 @@
 #include <gnuradio/blocks/null_sink.h>
 #include <gnuradio/filter/firdes.h>
 #include <gnuradio/top_block.h>
-#include <gpstk/Rinex3ObsBase.hpp>
-#include <gpstk/Rinex3ObsData.hpp>
-#include <gpstk/Rinex3ObsHeader.hpp>
-#include <gpstk/Rinex3ObsStream.hpp>
-#include <gpstk/RinexUtilities.hpp>
 #include <gtest/gtest.h>
 #include <matio.h>
 #include <pmt/pmt.h>
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <exception>
+#include <string>
 #include <unistd.h>
 #include <utility>
 
@@ -1553,148 +1551,68 @@ void HybridObservablesTest::check_results_code_pseudorange(
 
 bool HybridObservablesTest::ReadRinexObs(std::vector<arma::mat>* obs_vec, Gnss_Synchro gnss)
 {
-    // Open and read reference RINEX observables file
-    try
+    // Pseudorange, carrier Doppler and carrier phase codes of the signal
+    const std::string signal(gnss.Signal);
+    std::array<std::string, 3> codes;
+    if (signal == "1C")
         {
-            gpstk::Rinex3ObsStream r_ref(FLAGS_filename_rinex_obs);
-            r_ref.exceptions(std::ios::failbit);
-            gpstk::Rinex3ObsData r_ref_data;
-            gpstk::Rinex3ObsHeader r_ref_header;
-
-            gpstk::RinexDatum dataobj;
+            codes = {"C1C", "D1C", "L1C"};
+        }
+    else if (signal == "1B")
+        {
+            codes = {"C1B", "D1B", "L1B"};
+        }
+    else if (signal == "2S")  // L2M
+        {
+            codes = {"C2S", "D2S", "L2S"};
+        }
+    else if (signal == "L5")
+        {
+            codes = {"C5I", "D5I", "L5I"};
+        }
+    else if (signal == "5X")  // Simulator gives RINEX with E5a+E5b. Doppler and accumulated Carrier phase WILL differ
+        {
+            codes = {"C8I", "D8I", "L8I"};
+        }
+    else
+        {
+            std::cout << "ReadRinexObs unknown signal requested: " << gnss.Signal << '\n';
+            return false;
+        }
 
-            r_ref >> r_ref_header;
+    // Open and read reference RINEX observables file
+    Rinex_Obs_File rinex;
+    if (not rinex.read(FLAGS_filename_rinex_obs))
+        {
+            return false;
+        }
+    const char system = (gnss.System == 'E') ? 'E' : 'G';
+    std::array<int32_t, 3> columns{};
+    for (size_t k = 0; k < codes.size(); k++)
+        {
+            columns[k] = rinex.obs_index(system, codes[k]);
+        }
 
-            std::vector<bool> first_row;
-            gpstk::SatID prn;
-            for (unsigned int n = 0; n < gnss_synchro_vec.size(); n++)
+    // Columns: [sow, pseudorange, carrier Doppler, carrier phase]
+    for (unsigned int n = 0; n < gnss_synchro_vec.size(); n++)
+        {
+            const Rinex_Obs_Series* series = rinex.series(system, gnss_synchro_vec.at(n).PRN);
+            if (series == nullptr)
                 {
-                    first_row.push_back(true);
+                    // PRN not present
                     obs_vec->push_back(arma::zeros<arma::mat>(1, 4));
+                    continue;
                 }
-            while (r_ref >> r_ref_data)
+            arma::mat obs(series->tow.size(), 4, arma::fill::zeros);
+            obs.col(0) = arma::vec(series->tow);
+            for (size_t k = 0; k < columns.size(); k++)
                 {
-                    for (unsigned int n = 0; n < gnss_synchro_vec.size(); n++)
+                    if (columns[k] >= 0)
                         {
-                            int myprn = gnss_synchro_vec.at(n).PRN;
-
-                            switch (gnss.System)
-                                {
-                                case 'G':
-#if OLD_GPSTK
-                                    prn = gpstk::SatID(myprn, gpstk::SatID::systemGPS);
-#else
-                                    prn = gpstk::SatID(myprn, gpstk::SatelliteSystem::GPS);
-#endif
-                                    break;
-                                case 'E':
-#if OLD_GPSTK
-                                    prn = gpstk::SatID(myprn, gpstk::SatID::systemGalileo);
-#else
-                                    prn = gpstk::SatID(myprn, gpstk::SatelliteSystem::Galileo);
-#endif
-                                    break;
-                                default:
-#if OLD_GPSTK
-                                    prn = gpstk::SatID(myprn, gpstk::SatID::systemGPS);
-#else
-                                    prn = gpstk::SatID(myprn, gpstk::SatelliteSystem::GPS);
-#endif
-                                }
-
-                            gpstk::CommonTime time = r_ref_data.time;
-                            double sow(static_cast<gpstk::GPSWeekSecond>(time).sow);
-
-                            auto pointer = r_ref_data.obs.find(prn);
-                            if (pointer == r_ref_data.obs.end())
-                                {
-                                    // PRN not present; do nothing
-                                }
-                            else
-                                {
-                                    if (first_row.at(n) == false)
-                                        {
-                                            // insert next column
-                                            obs_vec->at(n).insert_rows(obs_vec->at(n).n_rows, 1);
-                                        }
-                                    else
-                                        {
-                                            first_row.at(n) = false;
-                                        }
-                                    if (strcmp("1C\0", gnss.Signal) == 0)
-                                        {
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 0) = sow;
-                                            dataobj = r_ref_data.getObs(prn, "C1C", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 1) = dataobj.data;  // C1C P1 (psudorange L1)
-                                            dataobj = r_ref_data.getObs(prn, "D1C", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 2) = dataobj.data;  // D1C Carrier Doppler
-                                            dataobj = r_ref_data.getObs(prn, "L1C", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 3) = dataobj.data;  // L1C Carrier Phase
-                                        }
-                                    else if (strcmp("1B\0", gnss.Signal) == 0)
-                                        {
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 0) = sow;
-                                            dataobj = r_ref_data.getObs(prn, "C1B", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 1) = dataobj.data;
-                                            dataobj = r_ref_data.getObs(prn, "D1B", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 2) = dataobj.data;
-                                            dataobj = r_ref_data.getObs(prn, "L1B", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 3) = dataobj.data;
-                                        }
-                                    else if (strcmp("2S\0", gnss.Signal) == 0)  // L2M
-                                        {
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 0) = sow;
-                                            dataobj = r_ref_data.getObs(prn, "C2S", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 1) = dataobj.data;
-                                            dataobj = r_ref_data.getObs(prn, "D2S", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 2) = dataobj.data;
-                                            dataobj = r_ref_data.getObs(prn, "L2S", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 3) = dataobj.data;
-                                        }
-                                    else if (strcmp("L5\0", gnss.Signal) == 0)
-                                        {
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 0) = sow;
-                                            dataobj = r_ref_data.getObs(prn, "C5I", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 1) = dataobj.data;
-                                            dataobj = r_ref_data.getObs(prn, "D5I", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 2) = dataobj.data;
-                                            dataobj = r_ref_data.getObs(prn, "L5I", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 3) = dataobj.data;
-                                        }
-                                    else if (strcmp("5X\0", gnss.Signal) == 0)  // Simulator gives RINEX with E5a+E5b. Doppler and accumulated Carrier phase WILL differ
-                                        {
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 0) = sow;
-                                            dataobj = r_ref_data.getObs(prn, "C8I", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 1) = dataobj.data;
-                                            dataobj = r_ref_data.getObs(prn, "D8I", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 2) = dataobj.data;
-                                            dataobj = r_ref_data.getObs(prn, "L8I", r_ref_header);
-                                            obs_vec->at(n)(obs_vec->at(n).n_rows - 1, 3) = dataobj.data;
-                                        }
-                                    else
-                                        {
-                                            std::cout << "ReadRinexObs unknown signal requested: " << gnss.Signal << '\n';
-                                            return false;
-                                        }
-                                }
+                            obs.col(k + 1) = arma::vec(series->obs[columns[k]]);
                         }
-                }  // end while
-        }          // End of 'try' block
-    catch (const gpstk::FFStreamError& e)
-        {
-            std::cout << e;
-            return false;
-        }
-    catch (const gpstk::Exception& e)
-        {
-            std::cout << e;
-            return false;
-        }
-    catch (const std::exception& e)
-        {
-            std::cout << "Exception: " << e.what();
-            std::cout << "unknown error.  I don't feel so well...\n";
-            return false;
+                }
+            obs_vec->push_back(obs);
         }
     std::cout << "ReadRinexObs info:\n";
     for (unsigned int n = 0; n < gnss_synchro_vec.size(); n++)
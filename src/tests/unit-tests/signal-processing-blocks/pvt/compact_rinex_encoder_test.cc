@@ -0,0 +1,298 @@
+/*!
+ * \file compact_rinex_encoder_test.cc
+ * \brief Implements Unit Tests for the Compact_Rinex_Encoder class.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "compact_rinex_encoder.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+std::string crx_pad80(const std::string& s)
+{
+    std::string t(s);
+    t.resize(80, ' ');
+    return t;
+}
+
+
+std::string crx_rtrim(const std::string& s)
+{
+    const auto last = s.find_last_not_of(' ');
+    return last == std::string::npos ? std::string() : s.substr(0, last + 1);
+}
+
+
+std::vector<std::string> crx_split_lines(const std::string& text)
+{
+    std::vector<std::string> lines;
+    std::istringstream ss(text);
+    std::string line;
+    while (std::getline(ss, line))
+        {
+            lines.push_back(line);
+        }
+    return lines;
+}
+
+
+std::string crx_repair(const std::string& old_str, const std::string& diff)
+{
+    std::string s(old_str);
+    if (s.size() < diff.size())
+        {
+            s.resize(diff.size(), ' ');
+        }
+    for (std::size_t i = 0; i < diff.size(); i++)
+        {
+            if (diff[i] == '&')
+                {
+                    s[i] = ' ';
+                }
+            else if (diff[i] != ' ')
+                {
+                    s[i] = diff[i];
+                }
+        }
+    return s;
+}
+
+
+// Minimal Compact RINEX 3 decoder, enough to check the encoder output
+std::vector<std::string> crx_decode(const std::string& crx, int num_obs)
+{
+    struct Arc
+    {
+        std::array<int64_t, 4> u{};
+        int order{-1};
+    };
+    std::vector<std::string> lines = crx_split_lines(crx);
+    std::vector<std::string> rinex;
+    std::map<std::string, std::vector<Arc>> arcs;
+    std::map<std::string, std::string> flags;
+    std::string epoch;
+    std::size_t i = 2;  // skip the CRINEX lines
+    while (i < lines.size())
+        {
+            rinex.push_back(lines[i]);
+            if (lines[i].find("END OF HEADER") != std::string::npos)
+                {
+                    i++;
+                    break;
+                }
+            i++;
+        }
+    while (i < lines.size())
+        {
+            const std::string& line = lines[i++];
+            if (!line.empty() and line[0] == '>')
+                {
+                    epoch = line;
+                    if (line.size() > 31 and line[31] >= '2' and line[31] <= '5')
+                        {
+                            rinex.push_back(line);
+                            const int n = std::stoi(line.substr(32, 3));
+                            for (int k = 0; k < n; k++)
+                                {
+                                    rinex.push_back(lines[i++]);
+                                }
+                            continue;
+                        }
+                }
+            else
+                {
+                    epoch = crx_repair(epoch, line);
+                }
+            i++;  // clock line, always empty in these tests
+            epoch.resize(std::max<std::size_t>(epoch.size(), 41), ' ');
+            const std::string sats = crx_rtrim(epoch.substr(41));
+            const int num_sats = static_cast<int>((sats.size() + 2) / 3);
+            rinex.push_back(epoch.substr(0, 41));
+            std::map<std::string, std::vector<Arc>> new_arcs;
+            std::map<std::string, std::string> new_flags;
+            for (int s = 0; s < num_sats; s++)
+                {
+                    std::string sat = sats.substr(3 * s, 3);
+                    const std::string& data = lines[i++];
+                    std::vector<Arc> sat_arcs = arcs.count(sat) ? arcs[sat] : std::vector<Arc>(num_obs);
+                    std::string sat_flags = flags.count(sat) ? flags[sat] : std::string(2 * num_obs, ' ');
+                    std::string record = sat;
+                    std::size_t pos = 0;
+                    for (int j = 0; j < num_obs; j++)
+                        {
+                            std::string token;
+                            if (pos <= data.size())
+                                {
+                                    const auto end = data.find(' ', pos);
+                                    token = data.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+                                    pos = end == std::string::npos ? data.size() + 1 : end + 1;
+                                }
+                            Arc& arc = sat_arcs[j];
+                            if (token.empty())
+                                {
+                                    arc.order = -1;
+                                    record += std::string(14, ' ');
+                                }
+                            else
+                                {
+                                    const auto amp = token.find('&');
+                                    if (amp != std::string::npos)
+                                        {
+                                            arc.order = 0;
+                                            arc.u[0] = std::stoll(token.substr(amp + 1));
+                                        }
+                                    else
+                                        {
+                                            const Arc prev = arc;
+                                            arc.order = std::min(prev.order + 1, 3);
+                                            arc.u[arc.order] = std::stoll(token);
+                                            for (int k = arc.order - 1; k >= 0; k--)
+                                                {
+                                                    arc.u[k] = arc.u[k + 1] + prev.u[k];
+                                                }
+                                        }
+                                    char buf[32];
+                                    std::snprintf(buf, sizeof(buf), "%14.3f", static_cast<double>(arc.u[0]) / 1000.0);
+                                    record += buf;
+                                }
+                            record += "  ";
+                        }
+                    const std::string flags_diff = pos <= data.size() ? data.substr(pos) : std::string();
+                    sat_flags = crx_repair(sat_flags, flags_diff);
+                    for (int j = 0; j < num_obs; j++)
+                        {
+                            record[3 + 16 * j + 14] = sat_flags[2 * j];
+                            record[3 + 16 * j + 15] = sat_flags[2 * j + 1];
+                        }
+                    rinex.push_back(record);
+                    new_arcs[sat] = sat_arcs;
+                    new_flags[sat] = sat_flags;
+                }
+            arcs.swap(new_arcs);
+            flags.swap(new_flags);
+        }
+    return rinex;
+}
+
+
+std::string crx_obs_record(const std::string& sat, const std::vector<double>& values, int ssi)
+{
+    std::string record = sat;
+    for (const double v : values)
+        {
+            if (std::isnan(v))
+                {
+                    record += std::string(16, ' ');
+                }
+            else
+                {
+                    char buf[32];
+                    std::snprintf(buf, sizeof(buf), "%14.3f %d", v, ssi);
+                    record += buf;
+                }
+        }
+    return crx_pad80(record);
+}
+
+
+std::string crx_epoch_record(int second, int num_sats)
+{
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "> 2022 01 01 00 00 %010.7f  0%3d", static_cast<double>(second), num_sats);
+    return crx_pad80(buf);
+}
+}  // namespace
+
+
+TEST(CompactRinexEncoderTest, RoundTrip)
+{
+    std::vector<std::string> rinex;
+    rinex.push_back(crx_pad80("     3.02           OBSERVATION DATA    M (MIXED)") + "");
+    rinex.back().replace(60, 20, "RINEX VERSION / TYPE");
+    rinex.push_back(crx_pad80("G    4 C1C L1C D1C S1C"));
+    rinex.back().replace(60, 20, "SYS / # / OBS TYPES ");
+    rinex.push_back(crx_pad80("E    4 C1B L1B D1B S1B"));
+    rinex.back().replace(60, 20, "SYS / # / OBS TYPES ");
+    rinex.push_back(crx_pad80(""));
+    rinex.back().replace(60, 20, "END OF HEADER       ");
+
+    const std::vector<std::string> sats = {"G01", "G07", "E11", "E22"};
+    for (int t = 0; t < 20; t++)
+        {
+            std::vector<std::string> records;
+            for (std::size_t s = 0; s < sats.size(); s++)
+                {
+                    if (sats[s] == "G07" and t >= 8 and t < 11)
+                        {
+                            continue;  // satellite lost for a while
+                        }
+                    const double range = 2.1e7 + 1e5 * static_cast<double>(s) + 750.123 * t + 0.37 * t * t;
+                    const double phase = range / 0.19 + 0.001 * t * t * t;
+                    const double doppler = -1234.5 + 0.25 * t;
+                    const double cn0 = (t == 5 and s == 2) ? std::nan("") : 42.0 + (t % 3);
+                    records.push_back(crx_obs_record(sats[s], {range, phase, doppler, cn0}, t == 12 ? 6 : 7));
+                }
+            rinex.push_back(crx_epoch_record(t, static_cast<int>(records.size())));
+            rinex.insert(rinex.end(), records.begin(), records.end());
+            if (t == 10)
+                {
+                    std::string event(">");
+                    event += std::string(30, ' ') + "4  1";
+                    rinex.push_back(crx_pad80(event));
+                    std::string leap("    18    18  2185     7");
+                    leap.resize(60, ' ');
+                    leap += "LEAP SECONDS        ";
+                    rinex.push_back(leap);
+                }
+        }
+
+    std::string text;
+    for (const auto& line : rinex)
+        {
+            text += line + '\n';
+        }
+
+    // feed the encoder with chunks that split lines at arbitrary points
+    Compact_Rinex_Encoder encoder;
+    std::string crx;
+    std::size_t pos = 0;
+    std::size_t chunk = 1;
+    while (pos < text.size())
+        {
+            crx += encoder.encode(text.substr(pos, chunk));
+            pos += chunk;
+            chunk = (chunk * 7 + 13) % 500 + 1;
+        }
+
+    const std::vector<std::string> crx_lines = crx_split_lines(crx);
+    ASSERT_GT(crx_lines.size(), 2U);
+    EXPECT_EQ(0, crx_lines[0].compare(0, 3, "3.0"));
+    EXPECT_EQ(0, crx_lines[0].compare(60, 20, "CRINEX VERS   / TYPE"));
+    EXPECT_EQ(0, crx_lines[1].compare(60, 18, "CRINEX PROG / DATE"));
+    EXPECT_LT(crx.size(), text.size() / 2);
+
+    const std::vector<std::string> decoded = crx_decode(crx, 4);
+    ASSERT_EQ(decoded.size(), rinex.size());
+    for (std::size_t i = 0; i < rinex.size(); i++)
+        {
+            EXPECT_EQ(crx_rtrim(decoded[i]), crx_rtrim(rinex[i])) << "line " << i;
+        }
+}
@@ -18,8 +18,12 @@
 #include "rinex_printer.h"
 #include "rtklib_rtkpos.h"
 #include "rtklib_solver.h"
+#include <cmath>
 #include <fstream>
+#include <limits>
+#include <random>
 #include <string>
+#include <vector>
 
 
 class RinexPrinterTest : public ::testing::Test
@@ -497,6 +501,90 @@ TEST_F(RinexPrinterTest, GalileoObsLog)
 }
 
 
+TEST_F(RinexPrinterTest, GalileoObsHeaderUpdate)
+{
+    auto eph = Galileo_Ephemeris();
+    eph.PRN = 1;
+    auto pvt_solution = std::make_shared<Rtklib_Solver>(rtk, "filename", false, false);
+    pvt_solution->galileo_ephemeris_map[1] = eph;
+    pvt_solution->galileo_utc_model.A0 = 1e-9;
+    pvt_solution->galileo_utc_model.Delta_tLS = 18;
+    pvt_solution->galileo_utc_model.Delta_tLSF = 18;
+    pvt_solution->galileo_utc_model.WN_LSF = 137;
+    pvt_solution->galileo_utc_model.DN = 7;
+
+    std::map<int, Gnss_Synchro> gnss_observables_map;
+    Gnss_Synchro gs = Gnss_Synchro();
+    std::string sys = "E";
+    gs.System = *sys.c_str();
+    std::string sig = "1B";
+    std::memcpy(static_cast<void*>(gs.Signal), sig.c_str(), 3);
+    gs.PRN = 22;
+    gs.Pseudorange_m = 22000000;
+    gs.CN0_dB_hz = 42;
+    gnss_observables_map[1] = gs;
+
+    auto rp = std::make_shared<Rinex_Printer>();
+    rp->print_rinex_annotation(pvt_solution.get(),
+        gnss_observables_map,
+        0.0,
+        4,
+        true);
+    rp->print_rinex_annotation(pvt_solution.get(),
+        gnss_observables_map,
+        1.0,
+        4,
+        true);
+
+    std::string obsfile = rp->get_obsfilename();
+    std::string navfile = rp->get_navfilename()[0];
+
+    rp = nullptr;  // close the RINEX files so we can inspect them
+
+    std::fstream fstr(obsfile.c_str(), std::fstream::in);
+    std::vector<std::string> lines;
+    std::string line_str;
+    while (std::getline(fstr, line_str))
+        {
+            lines.push_back(line_str);
+        }
+    fstr.close();
+
+    // The LEAP SECONDS line is written in place, right after TIME OF FIRST OBS
+    std::size_t first_obs = lines.size();
+    std::size_t end_of_header = lines.size();
+    for (std::size_t i = 0; i < lines.size(); i++)
+        {
+            if (lines[i].find("TIME OF FIRST OBS", 59) != std::string::npos)
+                {
+                    first_obs = i;
+                }
+            if (lines[i].find("END OF HEADER", 59) != std::string::npos)
+                {
+                    end_of_header = i;
+                }
+        }
+    ASSERT_LT(first_obs + 2, lines.size());
+    std::string expected_str("    18    18   137     7                                    LEAP SECONDS        ");
+    EXPECT_EQ(0, expected_str.compare(lines[first_obs + 1]));
+    EXPECT_EQ(first_obs + 2, end_of_header);
+
+    // Both epochs follow the header untouched
+    int records = 0;
+    for (std::size_t i = end_of_header + 1; i < lines.size(); i++)
+        {
+            EXPECT_EQ(lines[i].size(), 80U);
+            if (lines[i].find("E22  22000000.000", 0) == 0)
+                {
+                    records++;
+                }
+        }
+    EXPECT_EQ(records, 2);
+    fs::remove(obsfile);
+    fs::remove(navfile);
+}
+
+
 TEST_F(RinexPrinterTest, GlonassObsLog)
 {
     std::string line_aux;
@@ -1010,3 +1098,39 @@ TEST_F(RinexPrinterTest, MixedObsLogGpsGlo)
     fs::remove(navfile);
     fs::remove(obsfile);
 }
+
+
+TEST(RinexPrinterFormatTest, FixedFieldMatchesStreamFormatting)
+{
+    const Rinex_Printer rp;
+    const std::vector<double> values = {0.0, -0.0, -0.0004, 0.0005, 0.0015, 0.5, 2.5, -2.5,
+        -1234.5678, 1234.5678, 9.9995, 9.9996, -9.9996, 22000000.0, -22000000.123456,
+        999999999.9999, 123456789012.345, 1e12, -1e12, 1e15, -1e16,
+        std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity()};
+    // widths below the length of the number are truncated from the left
+    for (const double x : values)
+        {
+            for (const std::string::size_type length : {14, 10, 5, 1, 0})
+                {
+                    for (const int precision : {0, 1, 3, 9})
+                        {
+                            EXPECT_EQ(rp.asFixedField(x, length, precision), rp.rightJustify(rp.asString(x, precision), length))
+                                << "x = " << x << ", length " << length << ", precision " << precision;
+                        }
+                }
+        }
+    EXPECT_EQ(rp.asFixedField(9.9995, 14, 3), "         9.999");
+    EXPECT_EQ(rp.asFixedField(9.9996, 14, 3), "        10.000");
+    EXPECT_EQ(rp.asFixedField(-0.0, 14, 3), "        -0.000");
+    EXPECT_EQ(rp.asFixedField(1e12, 14, 3), "0000000000.000");
+
+    std::mt19937 generator(28);
+    std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-4, 13);
+    for (int i = 0; i < 100000; i++)
+        {
+            const double x = mantissa(generator) * std::pow(10.0, exponent(generator));
+            ASSERT_EQ(rp.asFixedField(x, 14, 3), rp.rightJustify(rp.asString(x, 3), 14)) << "x = " << x;
+        }
+}
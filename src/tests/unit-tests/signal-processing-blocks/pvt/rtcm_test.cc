@@ -18,8 +18,14 @@
 
 #include "Galileo_INAV.h"
 #include "rtcm.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <string>
 #include <thread>
+#include <vector>
 
 TEST(RtcmTest, HexToBin)
 {
@@ -628,3 +634,310 @@ TEST(RtcmTest, InstantiateServerWithoutClosing)
     std::string test3_bin = rtcm->hex_to_bin(test3);
     EXPECT_EQ(0, test3_bin.compare("11111111"));
 }
+
+
+namespace
+{
+enum class Rtcm_Poll_Result
+{
+    DONE,
+    CLOSED,
+    TIMEOUT
+};
+
+
+// Appends to received the data available at the client until done(received)
+// holds, the server closes the connection or 10 s have passed. idle() is
+// called whenever there is no data to read.
+Rtcm_Poll_Result rtcm_poll_client(boost::asio::ip::tcp::socket& client,
+    std::string& received,
+    const std::function<bool(const std::string&)>& done,
+    const std::function<void()>& idle = nullptr)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    std::array<char, 65536> buffer{};
+    client.non_blocking(true);
+    while (not done(received))
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                {
+                    return Rtcm_Poll_Result::TIMEOUT;
+                }
+            boost::system::error_code ec;
+            const std::size_t length = client.read_some(boost::asio::buffer(buffer), ec);
+            if (ec == boost::asio::error::would_block)
+                {
+                    if (idle)
+                        {
+                            idle();
+                        }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            else if (ec)
+                {
+                    return Rtcm_Poll_Result::CLOSED;
+                }
+            else
+                {
+                    received.append(buffer.data(), length);
+                }
+        }
+    return Rtcm_Poll_Result::DONE;
+}
+
+
+std::function<bool(const std::string&)> rtcm_has_bytes(std::size_t length)
+{
+    return [length](const std::string& received) { return received.size() >= length; };
+}
+
+
+// Fixed-length numbered messages, so the client can tell which ones were dropped
+constexpr std::size_t RTCM_NUMBERED_MSG_LENGTH = 1000;
+
+
+std::string rtcm_numbered_message(int32_t number)
+{
+    std::string msg = std::to_string(number) + ";";
+    msg.resize(RTCM_NUMBERED_MSG_LENGTH, 'x');
+    return msg;
+}
+
+
+std::vector<int32_t> rtcm_message_numbers(const std::string& received)
+{
+    std::vector<int32_t> numbers;
+    for (std::size_t pos = 0; pos + RTCM_NUMBERED_MSG_LENGTH <= received.size(); pos += RTCM_NUMBERED_MSG_LENGTH)
+        {
+            numbers.push_back(std::stoi(received.substr(pos, RTCM_NUMBERED_MSG_LENGTH)));
+        }
+    return numbers;
+}
+
+
+// True if the last complete message received has the given number
+std::function<bool(const std::string&)> rtcm_last_message_is(int32_t number)
+{
+    return [number](const std::string& received) {
+        const std::size_t complete = received.size() / RTCM_NUMBERED_MSG_LENGTH;
+        return complete > 0 and std::stoi(received.substr((complete - 1) * RTCM_NUMBERED_MSG_LENGTH, RTCM_NUMBERED_MSG_LENGTH)) == number;
+    };
+}
+
+
+// Server with a single client that stops reading, so its socket buffers
+// fill up and the messages pile up in its session queue
+class Rtcm_Slow_Client_Test
+{
+public:
+    static constexpr int32_t sent_msgs = 30000;  // 30 MB, well above the socket buffers
+
+    Rtcm_Slow_Client_Test(uint16_t port, uint32_t max_backlog, Rtcm::Rtcm_Backlog_Policy policy)
+        : rtcm(port, 1, max_backlog, policy),
+          endpoint(boost::asio::ip::address_v4::loopback(), port)
+    {
+        rtcm.run_server();
+        connect();
+    }
+
+    ~Rtcm_Slow_Client_Test()
+    {
+        boost::system::error_code ec;
+        for (auto& client : clients)
+            {
+                client->close(ec);
+            }
+        rtcm.stop_server();
+    }
+
+    // Connects a new client, and waits for its session to join the server
+    // (it then gets the last message sent)
+    boost::asio::ip::tcp::socket& connect()
+    {
+        rtcm.send_message(rtcm_numbered_message(-1));
+        clients.emplace_back(new boost::asio::ip::tcp::socket(io_context));
+        auto& client = *clients.back();
+        client.open(boost::asio::ip::tcp::v4());
+        client.set_option(boost::asio::socket_base::receive_buffer_size(4096));
+        client.connect(endpoint);
+        std::string received;
+        EXPECT_EQ(rtcm_poll_client(client, received, rtcm_has_bytes(RTCM_NUMBERED_MSG_LENGTH)), Rtcm_Poll_Result::DONE);
+        return client;
+    }
+
+    // Sends all the messages while the first client is not reading
+    void flood()
+    {
+        for (int32_t i = 0; i < sent_msgs; i++)
+            {
+                rtcm.send_message(rtcm_numbered_message(i));
+            }
+    }
+
+    boost::asio::ip::tcp::socket& slow_client()
+    {
+        return *clients.front();
+    }
+
+    Rtcm rtcm;
+    b_io_context io_context;
+    boost::asio::ip::tcp::endpoint endpoint;
+    std::vector<std::unique_ptr<boost::asio::ip::tcp::socket>> clients;
+};
+
+
+// Number of consecutive messages at the end of the sequence
+std::size_t rtcm_tail_length(const std::vector<int32_t>& numbers)
+{
+    std::size_t length = numbers.empty() ? 0 : 1;
+    while (length < numbers.size() and numbers[numbers.size() - length - 1] + 1 == numbers[numbers.size() - length])
+        {
+            length++;
+        }
+    return length;
+}
+
+
+bool rtcm_strictly_increasing(const std::vector<int32_t>& numbers)
+{
+    return std::adjacent_find(numbers.cbegin(), numbers.cend(), [](int32_t a, int32_t b) { return a >= b; }) == numbers.cend();
+}
+}  // namespace
+
+
+TEST(RtcmTest, ServerFanOut)
+{
+    const uint16_t port = 2102;
+    auto rtcm = std::make_shared<Rtcm>(port, 2);
+    rtcm->run_server();
+
+    // the last message is sent to each client when its session joins
+    const std::string hello("hello;");
+    rtcm->send_message(hello);
+
+    b_io_context io_context;
+    std::vector<std::unique_ptr<boost::asio::ip::tcp::socket>> clients;
+    const boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), port);
+    for (int i = 0; i < 3; i++)
+        {
+            clients.emplace_back(new boost::asio::ip::tcp::socket(io_context));
+            clients.back()->connect(endpoint);
+        }
+    for (auto& client : clients)
+        {
+            std::string received;
+            ASSERT_EQ(rtcm_poll_client(*client, received, rtcm_has_bytes(hello.size())), Rtcm_Poll_Result::DONE);
+            EXPECT_EQ(hello, received);
+        }
+
+    std::string expected;
+    for (int i = 0; i < 200; i++)
+        {
+            const std::string msg = "message " + std::to_string(i) + ";";
+            expected += msg;
+            rtcm->send_message(msg);
+        }
+
+    for (auto& client : clients)
+        {
+            std::string received;
+            EXPECT_EQ(rtcm_poll_client(*client, received, rtcm_has_bytes(expected.size())), Rtcm_Poll_Result::DONE);
+            EXPECT_EQ(expected, received);
+            client->close();
+        }
+    rtcm->stop_server();
+}
+
+
+TEST(RtcmTest, ServerSlowClientDropOldest)
+{
+    const uint32_t max_backlog = 16;
+    Rtcm_Slow_Client_Test test(2103, max_backlog, Rtcm::DROP_OLDEST);
+    test.flood();
+
+    // old messages are dropped, but the last max_backlog ones are kept
+    std::string received;
+    ASSERT_EQ(rtcm_poll_client(test.slow_client(), received, rtcm_last_message_is(test.sent_msgs - 1)), Rtcm_Poll_Result::DONE);
+    const auto numbers = rtcm_message_numbers(received);
+    EXPECT_TRUE(rtcm_strictly_increasing(numbers));
+    EXPECT_LT(numbers.size(), static_cast<std::size_t>(test.sent_msgs));
+    EXPECT_GE(rtcm_tail_length(numbers), static_cast<std::size_t>(max_backlog));
+
+    // once it has caught up, the client gets the new messages again
+    test.rtcm.send_message(rtcm_numbered_message(test.sent_msgs));
+    EXPECT_EQ(rtcm_poll_client(test.slow_client(), received, rtcm_last_message_is(test.sent_msgs)), Rtcm_Poll_Result::DONE);
+}
+
+
+TEST(RtcmTest, ServerSlowClientDropNewest)
+{
+    const uint32_t max_backlog = 16;
+    Rtcm_Slow_Client_Test test(2104, max_backlog, Rtcm::DROP_NEWEST);
+    test.flood();
+
+    // a marker is sent while the client catches up, and is queued as soon
+    // as there is room again, so the connection is kept
+    const int32_t marker = test.sent_msgs;
+    std::string received;
+    ASSERT_EQ(rtcm_poll_client(test.slow_client(), received, rtcm_last_message_is(marker), [&test, marker]() { test.rtcm.send_message(rtcm_numbered_message(marker)); }), Rtcm_Poll_Result::DONE);
+    auto numbers = rtcm_message_numbers(received);
+    numbers.erase(std::find(numbers.begin(), numbers.end(), marker), numbers.end());
+
+    // new messages are dropped, but the first max_backlog ones are kept
+    ASSERT_GE(numbers.size(), static_cast<std::size_t>(max_backlog));
+    EXPECT_TRUE(rtcm_strictly_increasing(numbers));
+    EXPECT_LT(numbers.size(), static_cast<std::size_t>(test.sent_msgs));
+    EXPECT_EQ(numbers.front(), 0);
+    EXPECT_EQ(numbers[max_backlog - 1], static_cast<int32_t>(max_backlog) - 1);
+}
+
+
+TEST(RtcmTest, ServerSlowClientDisconnect)
+{
+    Rtcm_Slow_Client_Test test(2105, 16, Rtcm::DISCONNECT);
+    test.flood();
+
+    // the client gets at most the messages already written to the socket
+    // before the overflow, and then the server closes the connection
+    std::string received;
+    ASSERT_EQ(rtcm_poll_client(test.slow_client(), received, [](const std::string&) { return false; }), Rtcm_Poll_Result::CLOSED);
+    const auto numbers = rtcm_message_numbers(received);
+    if (not numbers.empty())
+        {
+            EXPECT_EQ(numbers.front(), 0);
+            EXPECT_EQ(rtcm_tail_length(numbers), numbers.size());
+        }
+    EXPECT_LT(numbers.size(), static_cast<std::size_t>(test.sent_msgs));
+
+    // the server keeps serving other clients
+    auto& client = test.connect();
+    test.rtcm.send_message(rtcm_numbered_message(test.sent_msgs));
+    received.clear();
+    EXPECT_EQ(rtcm_poll_client(client, received, rtcm_last_message_is(test.sent_msgs)), Rtcm_Poll_Result::DONE);
+}
+
+
+TEST(RtcmTest, ServerSlowClientBacklogLimit)
+{
+    uint16_t port = 2106;
+    for (const uint32_t max_backlog : {1, 100, 30000})
+        {
+            Rtcm_Slow_Client_Test test(port++, max_backlog, Rtcm::DROP_OLDEST);
+            test.flood();
+
+            std::string received;
+            ASSERT_EQ(rtcm_poll_client(test.slow_client(), received, rtcm_last_message_is(test.sent_msgs - 1)), Rtcm_Poll_Result::DONE);
+            const auto numbers = rtcm_message_numbers(received);
+            EXPECT_TRUE(rtcm_strictly_increasing(numbers));
+            EXPECT_GE(rtcm_tail_length(numbers), static_cast<std::size_t>(max_backlog));
+            if (max_backlog < static_cast<uint32_t>(test.sent_msgs))
+                {
+                    EXPECT_LT(numbers.size(), static_cast<std::size_t>(test.sent_msgs));
+                }
+            else
+                {
+                    // a queue that holds the whole flood loses nothing
+                    EXPECT_EQ(numbers.size(), static_cast<std::size_t>(test.sent_msgs));
+                }
+        }
+}
@@ -0,0 +1,141 @@
+/*!
+ * \file multichannel_file_reader_test.cc
+ * \brief Unit tests for the Multichannel_File_Reader block.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#include "multichannel_file_reader.h"
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <pmt/pmt.h>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#else
+#include <gnuradio/blocks/vector_sink_s.h>
+#endif
+
+
+namespace
+{
+// Writes num_items shorts; item i of file f holds 3 * i + f
+std::vector<std::string> mcfr_write_files(int num_files, int num_items)
+{
+    std::vector<std::string> filenames;
+    for (int f = 0; f < num_files; f++)
+        {
+            filenames.push_back("./multichannel_file_reader_test_" + std::to_string(f) + ".dat");
+            std::FILE* file = std::fopen(filenames.back().c_str(), "wb");
+            const int length = num_items + 37 * f;  // files of different length
+            for (int i = 0; i < length; i++)
+                {
+                    const auto value = static_cast<int16_t>(3 * i + f);
+                    std::fwrite(&value, sizeof(value), 1, file);
+                }
+            std::fclose(file);
+        }
+    return filenames;
+}
+}  // namespace
+
+
+TEST(MultichannelFileReaderTest, AlignedOutputs)
+{
+    const int num_files = 3;
+    const int num_items = 10000;
+    const uint64_t items_to_skip = 10;
+    const std::vector<std::string> filenames = mcfr_write_files(num_files, num_items);
+
+    // Small chunks, so that the files are read in many pieces
+    auto reader = Multichannel_File_Reader::make(sizeof(int16_t), filenames, items_to_skip, false, 1000, 3);
+    auto top_block = gr::make_top_block("multichannel_file_reader_test");
+    std::vector<gr::blocks::vector_sink_s::sptr> sinks;
+    for (int f = 0; f < num_files; f++)
+        {
+            sinks.push_back(gr::blocks::vector_sink_s::make());
+            top_block->connect(reader, f, sinks.back(), 0);
+        }
+    top_block->run();
+
+    for (int f = 0; f < num_files; f++)
+        {
+            const std::vector<int16_t> data = sinks[f]->data();
+            // The shortest file sets the length of all the streams
+            ASSERT_EQ(data.size(), num_items - items_to_skip);
+            int errors = 0;
+            for (size_t i = 0; i < data.size(); i++)
+                {
+                    if (data[i] != static_cast<int16_t>(3 * (i + items_to_skip) + f))
+                        {
+                            errors++;
+                        }
+                }
+            EXPECT_EQ(errors, 0);
+            const std::vector<gr::tag_t> tags = sinks[f]->tags();
+            ASSERT_EQ(tags.size(), 1U);
+            EXPECT_EQ(tags[0].offset, 0U);
+            EXPECT_EQ(pmt::to_uint64(tags[0].value), items_to_skip);
+        }
+
+    for (const auto& filename : filenames)
+        {
+            std::remove(filename.c_str());
+        }
+}
+
+
+TEST(MultichannelFileReaderTest, Repeat)
+{
+    const int num_files = 2;
+    const int num_items = 1000;
+    const int items_to_read = 3500;
+    const std::vector<std::string> filenames = mcfr_write_files(num_files, num_items);
+
+    auto reader = Multichannel_File_Reader::make(sizeof(int16_t), filenames, 0, true, 512, 2);
+    auto top_block = gr::make_top_block("multichannel_file_reader_repeat_test");
+    std::vector<gr::blocks::vector_sink_s::sptr> sinks;
+    for (int f = 0; f < num_files; f++)
+        {
+            auto head = gr::blocks::head::make(sizeof(int16_t), items_to_read);
+            sinks.push_back(gr::blocks::vector_sink_s::make());
+            top_block->connect(reader, f, head, 0);
+            top_block->connect(head, 0, sinks.back(), 0);
+        }
+    top_block->run();
+
+    for (int f = 0; f < num_files; f++)
+        {
+            const std::vector<int16_t> data = sinks[f]->data();
+            ASSERT_EQ(data.size(), static_cast<size_t>(items_to_read));
+            int errors = 0;
+            for (size_t i = 0; i < data.size(); i++)
+                {
+                    if (data[i] != static_cast<int16_t>(3 * (i % num_items) + f))
+                        {
+                            errors++;
+                        }
+                }
+            EXPECT_EQ(errors, 0);
+            EXPECT_EQ(sinks[f]->tags().size(), 4U);  // start, plus three rewinds
+        }
+
+    for (const auto& filename : filenames)
+        {
+            std::remove(filename.c_str());
+        }
+}
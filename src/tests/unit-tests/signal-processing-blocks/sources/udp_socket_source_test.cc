@@ -0,0 +1,240 @@
+/*!
+ * \file udp_socket_source_test.cc
+ * \brief Unit tests for the lock-free packet ring and the UDP socket source,
+ * using the loopback interface.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#include "gr_complex_udp_socket_source.h"
+#include "spsc_packet_ring.h"
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <pmt/pmt.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#else
+#include <gnuradio/blocks/vector_sink_c.h>
+#endif
+
+
+namespace
+{
+// Polls condition until it holds or the timeout expires
+bool udp_test_wait_for(const std::function<bool()>& condition, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000))
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                {
+                    return false;
+                }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    return true;
+}
+
+
+// Sends a packet with a 4-byte counter and samples_per_packet cbyte samples
+// (sequence + 1, -(sequence + 1)), followed by extra_bytes of padding
+void udp_test_send(int sock, const struct sockaddr_in& destination, uint32_t sequence, int samples_per_packet, int extra_bytes = 0)
+{
+    std::vector<uint8_t> packet(4 + 2 * samples_per_packet + extra_bytes, 0);
+    const uint32_t header = htonl(sequence);
+    std::memcpy(packet.data(), &header, 4);
+    for (int n = 0; n < samples_per_packet; n++)
+        {
+            packet[4 + 2 * n] = static_cast<uint8_t>(sequence + 1);
+            packet[4 + 2 * n + 1] = static_cast<uint8_t>(-static_cast<int8_t>(sequence + 1));
+        }
+    sendto(sock, packet.data(), packet.size(), 0, reinterpret_cast<const struct sockaddr*>(&destination), sizeof(destination));
+}
+
+
+// The source binds its socket from the scheduler thread, so the first
+// packet is repeated until it arrives. Repetitions are discarded as late.
+bool udp_test_send_first(int sock, const struct sockaddr_in& destination, int samples_per_packet, const Gr_Complex_Udp_Socket_Source::sptr& source)
+{
+    return udp_test_wait_for([&]() {
+        udp_test_send(sock, destination, 0, samples_per_packet);
+        return udp_test_wait_for([&]() { return source->received_packets() > 0; }, std::chrono::milliseconds(10));
+    });
+}
+}  // namespace
+
+
+TEST(SpscPacketRingTest, ProducerConsumer)
+{
+    const uint64_t num_packets = 200000;
+    Spsc_Packet_Ring ring(100, 16);
+    EXPECT_EQ(ring.capacity(), 128U);
+    EXPECT_EQ(ring.free_slots(), 128U);
+
+    std::thread producer([&] {
+        uint64_t sequence = 0;
+        while (sequence < num_packets)
+            {
+                const size_t n = std::min<uint64_t>(ring.free_slots(), num_packets - sequence);
+                for (size_t i = 0; i < n; i++)
+                    {
+                        Spsc_Packet_Ring::Slot& slot = ring.producer_slot(i);
+                        slot.sequence = sequence;
+                        slot.length = 1 + sequence % 16;
+                        std::memset(slot.data, static_cast<int>(sequence & 0xFF), slot.length);
+                        sequence++;
+                    }
+                ring.commit(n);
+            }
+    });
+
+    uint64_t expected = 0;
+    uint64_t errors = 0;
+    while (expected < num_packets)
+        {
+            const size_t n = ring.used_slots();
+            for (size_t i = 0; i < n; i++)
+                {
+                    const Spsc_Packet_Ring::Slot& slot = ring.consumer_slot(i);
+                    if (slot.sequence != expected or slot.length != 1 + expected % 16 or
+                        slot.data[slot.length - 1] != static_cast<uint8_t>(expected & 0xFF))
+                        {
+                            errors++;
+                        }
+                    expected++;
+                }
+            ring.release(n);
+        }
+    producer.join();
+    EXPECT_EQ(errors, 0U);
+    EXPECT_EQ(ring.used_slots(), 0U);
+}
+
+
+TEST(UdpSocketSourceTest, LoopbackZeroFillsLostPackets)
+{
+    const int port = 23457;
+    const int samples_per_packet = 32;
+    const int packets_to_read = 20;
+    const uint32_t lost_first = 5;
+    const uint32_t lost_last = 6;
+
+    // cbyte samples, one channel, preceded by a 4-byte packet counter
+    auto source = Gr_Complex_Udp_Socket_Source::make("127.0.0.1", port, 4 + 2 * samples_per_packet, 1, "cbyte",
+        sizeof(gr_complex), true, 4, 1024, 16, 1 << 20, 0);
+    auto head = gr::blocks::head::make(sizeof(gr_complex), packets_to_read * samples_per_packet);
+    auto sink = gr::blocks::vector_sink_c::make();
+    auto top_block = gr::make_top_block("udp_socket_source_test");
+    top_block->connect(source, 0, head, 0);
+    top_block->connect(head, 0, sink, 0);
+    top_block->start();
+
+    const int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_NE(sock, -1);
+    struct sockaddr_in destination
+    {
+    };
+    destination.sin_family = AF_INET;
+    destination.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &destination.sin_addr);
+    ASSERT_TRUE(udp_test_send_first(sock, destination, samples_per_packet, source));
+    for (uint32_t sequence = 1; sequence < packets_to_read; sequence++)
+        {
+            if (sequence >= lost_first and sequence <= lost_last)
+                {
+                    continue;
+                }
+            udp_test_send(sock, destination, sequence, samples_per_packet);
+        }
+    EXPECT_TRUE(udp_test_wait_for([&]() { return head->nitems_written(0) >= static_cast<uint64_t>(packets_to_read * samples_per_packet); }));
+    top_block->stop();
+    top_block->wait();
+    close(sock);
+
+    // With IQ_swap, the first byte of each sample is the real part
+    const std::vector<gr_complex> data = sink->data();
+    ASSERT_EQ(data.size(), static_cast<size_t>(packets_to_read * samples_per_packet));
+    for (size_t i = 0; i < data.size(); i++)
+        {
+            const uint32_t sequence = i / samples_per_packet;
+            const float expected = (sequence >= lost_first and sequence <= lost_last) ? 0.0 : static_cast<float>(sequence + 1);
+            EXPECT_EQ(data[i], gr_complex(expected, -expected)) << "sample " << i;
+        }
+
+    const std::vector<gr::tag_t> tags = sink->tags();
+    ASSERT_EQ(tags.size(), 1U);
+    EXPECT_EQ(tags[0].offset, static_cast<uint64_t>(lost_first * samples_per_packet));
+    EXPECT_EQ(pmt::symbol_to_string(tags[0].key), "udp_gap");
+    EXPECT_EQ(pmt::to_uint64(tags[0].value), lost_last - lost_first + 1);
+    EXPECT_EQ(source->lost_packets(), lost_last - lost_first + 1);
+    EXPECT_EQ(source->truncated_packets(), 0U);
+}
+
+
+TEST(UdpSocketSourceTest, LoopbackDropsTruncatedPackets)
+{
+    const int port = 23458;
+    const int samples_per_packet = 32;
+    const int packets_to_read = 10;
+    const uint32_t truncated = 4;
+
+    // Without IQ_swap, the first byte of each sample is the imaginary part
+    auto source = Gr_Complex_Udp_Socket_Source::make("127.0.0.1", port, 4 + 2 * samples_per_packet, 1, "cbyte",
+        sizeof(gr_complex), false, 4, 1024, 16, 1 << 20, 0);
+    auto head = gr::blocks::head::make(sizeof(gr_complex), packets_to_read * samples_per_packet);
+    auto sink = gr::blocks::vector_sink_c::make();
+    auto top_block = gr::make_top_block("udp_socket_source_truncation_test");
+    top_block->connect(source, 0, head, 0);
+    top_block->connect(head, 0, sink, 0);
+    top_block->start();
+
+    const int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_NE(sock, -1);
+    struct sockaddr_in destination
+    {
+    };
+    destination.sin_family = AF_INET;
+    destination.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &destination.sin_addr);
+    ASSERT_TRUE(udp_test_send_first(sock, destination, samples_per_packet, source));
+    for (uint32_t sequence = 1; sequence < packets_to_read; sequence++)
+        {
+            udp_test_send(sock, destination, sequence, samples_per_packet, sequence == truncated ? 6 : 0);
+        }
+    EXPECT_TRUE(udp_test_wait_for([&]() { return head->nitems_written(0) >= static_cast<uint64_t>(packets_to_read * samples_per_packet); }));
+    top_block->stop();
+    top_block->wait();
+    close(sock);
+
+    const std::vector<gr_complex> data = sink->data();
+    ASSERT_EQ(data.size(), static_cast<size_t>(packets_to_read * samples_per_packet));
+    for (size_t i = 0; i < data.size(); i++)
+        {
+            const uint32_t sequence = i / samples_per_packet;
+            const float expected = sequence == truncated ? 0.0 : static_cast<float>(sequence + 1);
+            EXPECT_EQ(data[i], gr_complex(-expected, expected)) << "sample " << i;
+        }
+    EXPECT_EQ(source->truncated_packets(), 1U);
+    EXPECT_EQ(source->lost_packets(), 1U);
+}
@@ -23,6 +23,7 @@
 #include <chrono>
 #include <exception>
 #include <string>
+#include <thread>
 #include <unistd.h>
 #include <utility>
 #ifdef GR_GREATER_38
@@ -32,6 +33,7 @@
 #endif
 #include "GPS_L1_CA.h"
 #include "gnss_block_interface.h"
+#include "gnss_satellite.h"
 #include "gnss_synchro.h"
 #include "gps_l1_ca_dll_pll_tracking.h"
 #include "gps_l1_ca_telemetry_decoder.h"
@@ -208,6 +210,15 @@ public:
 
     void configure_receiver();
 
+    /*
+     * Tracks and decodes the test satellite in the generated signal, and
+     * checks the TOW of the decoded symbols against the true observables.
+     * If fused is true, the telemetry decoder runs inside the tracking block.
+     * If disturb_decoder is true, reset() and set_satellite() are called on
+     * the decoder while it is decoding.
+     */
+    void run_and_check(bool fused, bool disturb_decoder);
+
     gr::top_block_sptr top_block;
     std::shared_ptr<InMemoryConfiguration> config;
     Gnss_Synchro gnss_synchro;
@@ -333,7 +344,7 @@ void GpsL1CATelemetryDecoderTest::check_results(arma::vec& true_time_s,
 }
 
 
-TEST_F(GpsL1CATelemetryDecoderTest, ValidationOfResults)
+void GpsL1CATelemetryDecoderTest::run_and_check(bool fused, bool disturb_decoder)
 {
     // Configure the signal generator
     configure_generator();
@@ -410,8 +421,19 @@ TEST_F(GpsL1CATelemetryDecoderTest, ValidationOfResults)
         gr::blocks::null_sink::sptr sink = gr::blocks::null_sink::make(sizeof(Gnss_Synchro));
         top_block->connect(file_source, 0, gr_interleaved_char_to_complex, 0);
         top_block->connect(gr_interleaved_char_to_complex, 0, tracking->get_left_block(), 0);
-        top_block->connect(tracking->get_right_block(), 0, tlm->get_left_block(), 0);
-        top_block->connect(tlm->get_right_block(), 0, sink, 0);
+        if (fused)
+            {
+                if (!tracking->set_symbol_decoder(tlm->get_symbol_decoder(), tlm->get_left_block()))
+                    {
+                        throw std::exception();
+                    }
+                top_block->connect(tracking->get_right_block(), 0, sink, 0);
+            }
+        else
+            {
+                top_block->connect(tracking->get_right_block(), 0, tlm->get_left_block(), 0);
+                top_block->connect(tlm->get_right_block(), 0, sink, 0);
+            }
         top_block->msg_connect(tracking->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
     }) << "Failure connecting the blocks.";
 
@@ -419,7 +441,19 @@ TEST_F(GpsL1CATelemetryDecoderTest, ValidationOfResults)
 
     EXPECT_NO_THROW({
         start = std::chrono::system_clock::now();
-        top_block->run();  // Start threads and wait
+        top_block->start();
+        if (disturb_decoder)
+            {
+                // the channel does this when the satellite is reassigned
+                const Gnss_Satellite satellite("GPS", gnss_synchro.PRN);
+                for (int i = 0; i < 50; i++)
+                    {
+                        tlm->reset();
+                        tlm->set_satellite(satellite);
+                        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                    }
+            }
+        top_block->wait();
         end = std::chrono::system_clock::now();
         elapsed_seconds = end - start;
     }) << "Failure running the top_block.";
@@ -457,6 +491,7 @@ TEST_F(GpsL1CATelemetryDecoderTest, ValidationOfResults)
 
     nepoch = tlm_dump.num_epochs();
     std::cout << "Measured observation epochs=" << nepoch << '\n';
+    ASSERT_GT(nepoch, 0) << "No symbol was decoded";
 
     arma::vec tlm_timestamp_s = arma::zeros(nepoch, 1);
     arma::vec tlm_TOW_at_Preamble = arma::zeros(nepoch, 1);
@@ -481,3 +516,21 @@ TEST_F(GpsL1CATelemetryDecoderTest, ValidationOfResults)
 
     std::cout << "Test completed in " << elapsed_seconds.count() * 1e6 << " microseconds\n";
 }
+
+
+TEST_F(GpsL1CATelemetryDecoderTest, ValidationOfResults)
+{
+    run_and_check(false, false);
+}
+
+
+TEST_F(GpsL1CATelemetryDecoderTest, FusedChannelValidationOfResults)
+{
+    run_and_check(true, false);
+}
+
+
+TEST_F(GpsL1CATelemetryDecoderTest, FusedChannelResetWhileDecoding)
+{
+    run_and_check(true, true);
+}
@@ -0,0 +1,87 @@
+/*!
+ * \file tlm_preamble_correlator_test.cc
+ * \brief Tests the incremental preamble correlator of the telemetry decoders
+ * against the direct computation.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_preamble_correlator.h"
+#include <boost/circular_buffer.hpp>
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdlib>
+#include <random>
+
+
+namespace
+{
+int32_t tlm_direct_correlation(const boost::circular_buffer<float>& history, const int32_t* preamble, int32_t length)
+{
+    int32_t corr_value = 0;
+    if (history.full())
+        {
+            for (int32_t i = 0; i < length; i++)
+                {
+                    if (history[i] < 0.0)
+                        {
+                            corr_value -= preamble[i];
+                        }
+                    else
+                        {
+                            corr_value += preamble[i];
+                        }
+                }
+        }
+    return corr_value;
+}
+}  // namespace
+
+
+TEST(TlmPreambleCorrelatorTest, MatchesDirectCorrelation)
+{
+    // GPS L1 C/A preamble, 10001011
+    const std::array<int32_t, 8> preamble = {1, -1, -1, -1, 1, -1, 1, 1};
+    Tlm_Preamble_Correlator correlator;
+    correlator.set_preamble(preamble.data(), static_cast<int32_t>(preamble.size()));
+
+    boost::circular_buffer<float> history(40);
+    std::mt19937 gen(1234);
+    std::normal_distribution<float> symbol(0.0, 1.0);
+
+    int32_t detections = 0;
+    for (int32_t n = 0; n < 2000; n++)
+        {
+            if (n == 700)
+                {
+                    history.clear();  // as in a telemetry decoder reset
+                }
+            if (n % 300 == 0)
+                {
+                    // insert a preamble, sometimes inverted
+                    const float sign = (n % 600 == 0) ? 1.0 : -1.0;
+                    for (const auto& p : preamble)
+                        {
+                            history.push_back(sign * static_cast<float>(p));
+                            correlator.update(history);
+                        }
+                }
+            history.push_back(symbol(gen));
+            correlator.update(history);
+            const int32_t expected = tlm_direct_correlation(history, preamble.data(), static_cast<int32_t>(preamble.size()));
+            ASSERT_EQ(correlator.correlation(), expected) << "at symbol " << n;
+            if (std::abs(expected) == static_cast<int32_t>(preamble.size()))
+                {
+                    detections++;
+                }
+        }
+    EXPECT_GT(detections, 0);
+}
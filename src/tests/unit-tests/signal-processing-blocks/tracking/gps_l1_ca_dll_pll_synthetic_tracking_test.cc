@@ -0,0 +1,333 @@
+/*!
+ * \file gps_l1_ca_dll_pll_synthetic_tracking_test.cc
+ * \brief  Tracks a synthesized GPS L1 C/A signal with several integration
+ * periods per call (Tracking_1C.max_batch_epochs > 1) and with cshort and
+ * cbyte samples, and compares the results with those of the default
+ * gr_complex, one period per call, configuration. Also checks that the
+ * KF VTL tracking keeps its own filter while the vector tracking engine has
+ * no solution.
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "gnss_block_factory.h"
+#include "gnss_block_interface.h"
+#include "gnss_synchro.h"
+#include "in_memory_configuration.h"
+#include "multisat_signal_synthesizer.h"
+#include "tracking_interface.h"
+#include "vtl_engine.h"
+#include <gnuradio/block.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#else
+#include <gnuradio/blocks/vector_sink_b.h>
+#include <gnuradio/blocks/vector_source_b.h>
+#include <gnuradio/blocks/vector_source_c.h>
+#include <gnuradio/blocks/vector_source_s.h>
+#endif
+
+
+namespace
+{
+constexpr double SYNTHETIC_TRK_FS_HZ = 2e6;
+constexpr double SYNTHETIC_TRK_SIGNAL_S = 2.0;  // then noise only, until loss of lock
+constexpr double SYNTHETIC_TRK_NOISE_S = 1.0;
+constexpr uint32_t SYNTHETIC_TRK_PRN = 7;
+
+
+struct Synthetic_Tracking_Run
+{
+    std::vector<Gnss_Synchro> outputs;
+    uint64_t items_read{};
+    uint64_t items_written{};
+};
+
+
+// 50 dB-Hz GPS L1 C/A signal with navigation data, followed by noise only
+std::vector<gr_complex> synthetic_trk_signal(Gnss_Synchro& acquisition)
+{
+    std::vector<Synthesized_Satellite> satellites(1);
+    satellites[0].PRN = SYNTHETIC_TRK_PRN;
+    satellites[0].CN0_dB = 50.0;
+    Multisat_Signal_Synthesizer synthesizer(satellites, SYNTHETIC_TRK_FS_HZ, 0.0, true, true, 1, 1);
+
+    const auto signal_samples = static_cast<uint32_t>(SYNTHETIC_TRK_SIGNAL_S * SYNTHETIC_TRK_FS_HZ);
+    const auto noise_samples = static_cast<uint32_t>(SYNTHETIC_TRK_NOISE_S * SYNTHETIC_TRK_FS_HZ);
+    std::vector<gr_complex> samples(signal_samples + noise_samples);
+    synthesizer.generate(samples.data(), signal_samples);
+    std::default_random_engine e(1);
+    std::normal_distribution<float> noise(0.0F, std::sqrt(0.5F));
+    for (size_t n = signal_samples; n < samples.size(); n++)
+        {
+            samples[n] = gr_complex(noise(e), noise(e));
+        }
+
+    acquisition = Gnss_Synchro();
+    acquisition.Channel_ID = 0;
+    acquisition.System = 'G';
+    std::string signal = "1C";
+    signal.copy(acquisition.Signal, 2, 0);
+    acquisition.PRN = SYNTHETIC_TRK_PRN;
+    acquisition.Acq_delay_samples = synthesizer.code_phase_chips(0, 0.0) / GPS_L1_CA_CODE_RATE_CPS * SYNTHETIC_TRK_FS_HZ;
+    acquisition.Acq_doppler_hz = synthesizer.doppler_hz(0, 0.0);
+    acquisition.Acq_samplestamp_samples = 0;
+    return samples;
+}
+
+
+// Samples scaled and rounded to integers, as interleaved I/Q components
+template <typename T>
+std::vector<T> synthetic_trk_quantize(const std::vector<gr_complex>& samples, float scale)
+{
+    const auto limit = static_cast<float>(std::numeric_limits<T>::max());
+    std::vector<T> components(2 * samples.size());
+    for (size_t n = 0; n < samples.size(); n++)
+        {
+            components[2 * n] = static_cast<T>(std::max(-limit, std::min(limit, std::round(scale * samples[n].real()))));
+            components[2 * n + 1] = static_cast<T>(std::max(-limit, std::min(limit, std::round(scale * samples[n].imag()))));
+        }
+    return components;
+}
+
+
+Synthetic_Tracking_Run synthetic_trk_run(const gr::basic_block_sptr& source, const std::shared_ptr<InMemoryConfiguration>& config, const Gnss_Synchro& acquisition)
+{
+    Gnss_Synchro gnss_synchro = acquisition;
+    auto factory = std::make_shared<GNSSBlockFactory>();
+    std::shared_ptr<GNSSBlockInterface> trk_ = factory->GetBlock(config.get(), "Tracking_1C", 1, 1);
+    std::shared_ptr<TrackingInterface> tracking = std::dynamic_pointer_cast<TrackingInterface>(trk_);
+    tracking->set_channel(gnss_synchro.Channel_ID);
+    tracking->set_gnss_synchro(&gnss_synchro);
+
+    auto top_block = gr::make_top_block("Synthetic signal tracking test");
+    auto sink = gr::blocks::vector_sink_b::make(sizeof(Gnss_Synchro));
+    tracking->connect(top_block);
+    top_block->connect(source, 0, tracking->get_left_block(), 0);
+    top_block->connect(tracking->get_right_block(), 0, sink, 0);
+    tracking->start_tracking();
+    top_block->run();
+
+    Synthetic_Tracking_Run run;
+    const std::vector<unsigned char> data = sink->data();
+    run.outputs.resize(data.size() / sizeof(Gnss_Synchro));
+    for (size_t n = 0; n < run.outputs.size(); n++)
+        {
+            std::memcpy(&run.outputs[n], &data[n * sizeof(Gnss_Synchro)], sizeof(Gnss_Synchro));
+        }
+    // the tracking block is both the left and the right block
+    const auto* trk_block = dynamic_cast<gr::block*>(tracking->get_left_block().get());
+    run.items_read = trk_block->nitems_read(0);
+    run.items_written = trk_block->nitems_written(0);
+    return run;
+}
+
+
+Synthetic_Tracking_Run synthetic_trk_run(const gr::basic_block_sptr& source, const std::string& item_type, const Gnss_Synchro& acquisition, uint32_t max_batch_epochs)
+{
+    auto config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", std::to_string(static_cast<int64_t>(SYNTHETIC_TRK_FS_HZ)));
+    config->set_property("Tracking_1C.implementation", "GPS_L1_CA_DLL_PLL_Tracking");
+    config->set_property("Tracking_1C.item_type", item_type);
+    config->set_property("Tracking_1C.pll_bw_hz", "35.0");
+    config->set_property("Tracking_1C.dll_bw_hz", "2.0");
+    config->set_property("Tracking_1C.early_late_space_chips", "0.5");
+    config->set_property("Tracking_1C.pull_in_time_s", "0");
+    config->set_property("Tracking_1C.max_batch_epochs", std::to_string(max_batch_epochs));
+    config->set_property("Tracking_1C.dump", "false");
+    return synthetic_trk_run(source, config, acquisition);
+}
+
+
+Synthetic_Tracking_Run synthetic_trk_kf_vtl_run(const std::vector<gr_complex>& samples, const Gnss_Synchro& acquisition, bool vector_tracking)
+{
+    auto config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", std::to_string(static_cast<int64_t>(SYNTHETIC_TRK_FS_HZ)));
+    config->set_property("Tracking_1C.implementation", "GPS_L1_CA_KF_VTL_Tracking");
+    config->set_property("Tracking_1C.item_type", "gr_complex");
+    config->set_property("Tracking_1C.vector_tracking", vector_tracking ? "true" : "false");
+    config->set_property("Tracking_1C.dump", "false");
+    return synthetic_trk_run(gr::blocks::vector_source_c::make(samples, false), config, acquisition);
+}
+}  // namespace
+
+
+TEST(GpsL1CADllPllSyntheticTrackingTest, BatchedSameAsUnbatched)
+{
+    Gnss_Synchro acquisition{};
+    const std::vector<gr_complex> samples = synthetic_trk_signal(acquisition);
+    const auto signal_end = static_cast<uint64_t>(SYNTHETIC_TRK_SIGNAL_S * SYNTHETIC_TRK_FS_HZ);
+
+    const Synthetic_Tracking_Run reference = synthetic_trk_run(gr::blocks::vector_source_c::make(samples, false), "gr_complex", acquisition, 1);
+
+    // the signal is tracked until it ends, and the lock is lost in the noise
+    ASSERT_GT(reference.outputs.size(), 500U);
+    EXPECT_EQ(reference.items_read, samples.size());
+    EXPECT_EQ(reference.items_written, reference.outputs.size());
+    const Gnss_Synchro& last = reference.outputs.back();
+    EXPECT_FALSE(last.Flag_valid_symbol_output);
+    EXPECT_GT(last.Tracking_sample_counter, signal_end);
+    for (size_t n = 0; n + 1 < reference.outputs.size(); n++)
+        {
+            EXPECT_TRUE(reference.outputs[n].Flag_valid_symbol_output) << "at output " << n;
+        }
+    EXPECT_NEAR(reference.outputs[reference.outputs.size() / 4].CN0_dB_hz, 50.0, 5.0);
+
+    // Batch sizes that do not divide the number of tracked periods, so that
+    // the loss of lock falls in the middle of a batch for some of them
+    for (const uint32_t batch : {3U, 7U, 20U})
+        {
+            const Synthetic_Tracking_Run run = synthetic_trk_run(gr::blocks::vector_source_c::make(samples, false), "gr_complex", acquisition, batch);
+            EXPECT_EQ(run.items_read, reference.items_read) << "batch of " << batch;
+            EXPECT_EQ(run.items_written, reference.items_written) << "batch of " << batch;
+            ASSERT_EQ(run.outputs.size(), reference.outputs.size()) << "batch of " << batch;
+            for (size_t n = 0; n < run.outputs.size(); n++)
+                {
+                    const Gnss_Synchro& expected = reference.outputs[n];
+                    const Gnss_Synchro& actual = run.outputs[n];
+                    ASSERT_EQ(actual.Tracking_sample_counter, expected.Tracking_sample_counter) << "batch of " << batch << ", output " << n;
+                    ASSERT_EQ(actual.Flag_valid_symbol_output, expected.Flag_valid_symbol_output) << "batch of " << batch << ", output " << n;
+                    EXPECT_EQ(actual.PRN, expected.PRN);
+                    EXPECT_EQ(actual.fs, expected.fs);
+                    EXPECT_NEAR(actual.Carrier_Doppler_hz, expected.Carrier_Doppler_hz, 1e-3) << "batch of " << batch << ", output " << n;
+                    EXPECT_NEAR(actual.Code_phase_samples, expected.Code_phase_samples, 1e-4) << "batch of " << batch << ", output " << n;
+                    EXPECT_NEAR(actual.Carrier_phase_rads, expected.Carrier_phase_rads, 1e-3) << "batch of " << batch << ", output " << n;
+                    const double prompt_tolerance = 1e-3 * std::hypot(expected.Prompt_I, expected.Prompt_Q) + 1e-6;
+                    EXPECT_NEAR(actual.Prompt_I, expected.Prompt_I, prompt_tolerance) << "batch of " << batch << ", output " << n;
+                    EXPECT_NEAR(actual.Prompt_Q, expected.Prompt_Q, prompt_tolerance) << "batch of " << batch << ", output " << n;
+                    EXPECT_NEAR(actual.CN0_dB_hz, expected.CN0_dB_hz, 1e-3) << "batch of " << batch << ", output " << n;
+                }
+        }
+}
+
+
+TEST(GpsL1CADllPllSyntheticTrackingTest, IntegerSamples)
+{
+    Gnss_Synchro acquisition{};
+    const std::vector<gr_complex> samples = synthetic_trk_signal(acquisition);
+    const auto signal_end = static_cast<uint64_t>(SYNTHETIC_TRK_SIGNAL_S * SYNTHETIC_TRK_FS_HZ);
+    const Synthetic_Tracking_Run reference = synthetic_trk_run(gr::blocks::vector_source_c::make(samples, false), "gr_complex", acquisition, 1);
+    ASSERT_GT(reference.outputs.size(), 500U);
+
+    // The noise has unit power: cshort samples keep 9 bits below the noise
+    // standard deviation, cbyte samples about 4, without clipping
+    const std::vector<int16_t> shorts = synthetic_trk_quantize<int16_t>(samples, 512.0F);
+    const std::vector<int8_t> bytes = synthetic_trk_quantize<int8_t>(samples, 16.0F);
+    const Synthetic_Tracking_Run cshort_run = synthetic_trk_run(gr::blocks::vector_source_s::make(std::vector<short>(shorts.cbegin(), shorts.cend()), false, 2), "cshort", acquisition, 1);
+    const Synthetic_Tracking_Run cbyte_run = synthetic_trk_run(gr::blocks::vector_source_b::make(std::vector<unsigned char>(bytes.cbegin(), bytes.cend()), false, 2), "cbyte", acquisition, 1);
+
+    const auto tracked_outputs = [signal_end](const Synthetic_Tracking_Run& run) {
+        return std::count_if(run.outputs.cbegin(), run.outputs.cend(), [signal_end](const Gnss_Synchro& s) { return s.Tracking_sample_counter <= signal_end; });
+    };
+    const auto expected_outputs = tracked_outputs(reference);
+    for (const auto& test_case : {std::make_pair(std::string("cshort"), &cshort_run), std::make_pair(std::string("cbyte"), &cbyte_run)})
+        {
+            const Synthetic_Tracking_Run& run = *test_case.second;
+            const double max_mean_doppler_error_hz = test_case.first == "cshort" ? 1.0 : 5.0;
+            EXPECT_EQ(run.items_read, samples.size()) << test_case.first;
+            ASSERT_GT(run.outputs.size(), 1U) << test_case.first;
+
+            // locked while the signal lasts, and the lock is lost in the noise
+            const auto outputs = tracked_outputs(run);
+            EXPECT_NEAR(outputs, expected_outputs, 1) << test_case.first;
+            for (size_t n = 0; n + 1 < run.outputs.size(); n++)
+                {
+                    ASSERT_TRUE(run.outputs[n].Flag_valid_symbol_output) << test_case.first << ", output " << n;
+                }
+            EXPECT_FALSE(run.outputs.back().Flag_valid_symbol_output) << test_case.first;
+            EXPECT_GT(run.outputs.back().Tracking_sample_counter, signal_end) << test_case.first;
+
+            // same Doppler and C/N0 as the gr_complex run
+            double doppler_error_hz = 0.0;
+            double cn0_error_db = 0.0;
+            const auto compared = static_cast<size_t>(std::min(outputs, expected_outputs));
+            for (size_t n = 0; n < compared; n++)
+                {
+                    doppler_error_hz += std::abs(run.outputs[n].Carrier_Doppler_hz - reference.outputs[n].Carrier_Doppler_hz);
+                    cn0_error_db += run.outputs[n].CN0_dB_hz - reference.outputs[n].CN0_dB_hz;
+                }
+            ASSERT_GT(compared, 0U);
+            EXPECT_LT(doppler_error_hz / static_cast<double>(compared), max_mean_doppler_error_hz) << test_case.first;
+            EXPECT_NEAR(cn0_error_db / static_cast<double>(compared), 0.0, 1.0) << test_case.first;
+        }
+}
+
+
+TEST(GpsL1CAKfVtlSyntheticTrackingTest, OwnFilterWithoutEngineSolution)
+{
+    Gnss_Synchro acquisition{};
+    const std::vector<gr_complex> samples = synthetic_trk_signal(acquisition);
+    const Synthetic_Tracking_Run reference = synthetic_trk_kf_vtl_run(samples, acquisition, false);
+    ASSERT_GT(reference.outputs.size(), 500U);
+
+    // Commands left for this channel by a previous run of the engine
+    Vtl_Engine& engine = Vtl_Engine::instance();
+    engine.configure(Vtl_Engine::Parameters());
+    engine.register_channel(acquisition.Channel_ID);
+    Vtl_Engine::Navigation_Solution solution{};
+    solution.fs = SYNTHETIC_TRK_FS_HZ;
+    solution.pos = {4.0e6, 0.5e6, 4.9e6};
+    Vtl_Engine::Satellite_State sat{};
+    sat.pos = {2.0e7, 0.3e7, 1.6e7};
+    sat.satellite = Vtl_Engine::satellite_id('G', SYNTHETIC_TRK_PRN);
+    solution.satellites[acquisition.Channel_ID] = sat;
+    engine.set_navigation_solution(solution);
+    Vtl_Engine::Channel_Measurement m{};
+    m.sample_counter = static_cast<uint64_t>(SYNTHETIC_TRK_FS_HZ);
+    m.fs = SYNTHETIC_TRK_FS_HZ;
+    m.carrier_freq_hz = GPS_L1_FREQ_HZ;
+    m.code_chip_rate = GPS_L1_CA_CODE_RATE_CPS;
+    m.satellite = sat.satellite;
+    engine.post_measurement(acquisition.Channel_ID, m);
+    ASSERT_TRUE(engine.update(m.sample_counter));
+    TrackingCmd cmd;
+    ASSERT_GT(engine.read_command(acquisition.Channel_ID, cmd), 0U);
+
+    // The PVT block configures the engine for the new run, which never gets
+    // a solution: the channel contributes its measurements, is never
+    // commanded and tracks exactly as without vector tracking
+    engine.configure(Vtl_Engine::Parameters());
+    const Synthetic_Tracking_Run run = synthetic_trk_kf_vtl_run(samples, acquisition, true);
+    EXPECT_FALSE(engine.has_solution());
+    EXPECT_EQ(engine.steps(), 0U);
+    EXPECT_EQ(engine.read_command(acquisition.Channel_ID, cmd), 0U);
+
+    EXPECT_EQ(run.items_read, reference.items_read);
+    ASSERT_EQ(run.outputs.size(), reference.outputs.size());
+    for (size_t n = 0; n < run.outputs.size(); n++)
+        {
+            const Gnss_Synchro& expected = reference.outputs[n];
+            const Gnss_Synchro& actual = run.outputs[n];
+            ASSERT_EQ(actual.Tracking_sample_counter, expected.Tracking_sample_counter) << "output " << n;
+            ASSERT_EQ(actual.Flag_valid_symbol_output, expected.Flag_valid_symbol_output) << "output " << n;
+            EXPECT_DOUBLE_EQ(actual.Carrier_Doppler_hz, expected.Carrier_Doppler_hz) << "output " << n;
+            EXPECT_DOUBLE_EQ(actual.Code_phase_samples, expected.Code_phase_samples) << "output " << n;
+            EXPECT_DOUBLE_EQ(actual.Prompt_I, expected.Prompt_I) << "output " << n;
+            EXPECT_DOUBLE_EQ(actual.Prompt_Q, expected.Prompt_Q) << "output " << n;
+        }
+}
@@ -262,6 +262,7 @@ void GpsL1CADllPllTrackingTest::configure_receiver(
     config->set_property("Tracking_1C.pll_bw_narrow_hz", std::to_string(PLL_narrow_bw_hz));
     config->set_property("Tracking_1C.dll_bw_narrow_hz", std::to_string(DLL_narrow_bw_hz));
     config->set_property("Tracking_1C.early_late_space_narrow_chips", "0.5");
+    config->set_property("Tracking_1C.max_batch_epochs", std::to_string(FLAGS_max_batch_epochs));
     config->set_property("Tracking_1C.dump", "true");
     config->set_property("Tracking_1C.dump_filename", "./tracking_ch_");
 
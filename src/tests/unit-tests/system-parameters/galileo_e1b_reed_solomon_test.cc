@@ -624,3 +624,68 @@ TEST(ReedSolomonE1BTest, DecodeErasureCorrectionCase4)
 
     EXPECT_TRUE(information_vector == decoded);
 }
+
+
+TEST(ReedSolomonE1BTest, DecodeErasuresWithMatrix)
+{
+    const std::vector<uint8_t> information_vector = {147, 109, 66, 23, 234, 140,
+        74, 234, 49, 89, 241, 253, 169, 161, 89, 93, 75, 142, 83, 102, 98, 218,
+        14, 197, 155, 151, 43, 181, 9, 163, 142, 111, 8, 118, 21, 47, 135, 139,
+        108, 215, 51, 147, 185, 52, 17, 151, 97, 102, 238, 71, 83, 114, 47, 80,
+        67, 199, 215, 162};
+
+    const std::vector<uint8_t> full_code_vector = {147, 109, 66, 23, 234, 140,
+        74, 234, 49, 89, 241, 253, 169, 161, 89, 93, 75, 142, 83, 102, 98, 218,
+        14, 197, 155, 151, 43, 181, 9, 163, 142, 111, 8, 118, 21, 47, 135, 139,
+        108, 215, 51, 147, 185, 52, 17, 151, 97, 102, 238, 71, 83, 114, 47, 80,
+        67, 199, 215, 162, 238, 77, 12, 72, 235, 21, 148, 213, 230, 54, 183, 82,
+        49, 104, 12, 228, 150, 157, 220, 112, 236, 187, 63, 31, 175, 47, 210,
+        164, 17, 104, 98, 46, 252, 165, 194, 57, 26, 213, 14, 133, 176, 148, 34,
+        9, 167, 43, 204, 198, 25, 164, 233, 55, 153, 31, 237, 84, 212, 76, 137,
+        242};
+
+    // We have received Word 2, Word 4, Word 18, Word 20
+    std::vector<uint8_t> code_vector = full_code_vector;
+    std::vector<int> erasure_positions;
+    for (int i = 1; i < 16; i++)
+        {
+            code_vector[i] = 0;
+            erasure_positions.push_back(i);
+        }
+    for (int i = 30; i < 44; i++)
+        {
+            code_vector[i] = 0;
+            erasure_positions.push_back(i);
+        }
+    for (int i = 58; i < 73; i++)
+        {
+            code_vector[i] = 0;
+            erasure_positions.push_back(i + 137);
+        }
+    for (int i = 88; i < 103; i++)
+        {
+            code_vector[i] = 0;
+            erasure_positions.push_back(i + 137);
+        }
+
+    auto rs = std::make_unique<ReedSolomon>("E1B");
+
+    // the second time, the inverse comes from the cache
+    for (int n = 0; n < 2; n++)
+        {
+            std::vector<uint8_t> received = code_vector;
+            int result = rs->decode_erasures(received, erasure_positions);
+            EXPECT_EQ(result, 59);
+            std::vector<uint8_t> decoded(received.begin(), received.begin() + 58);
+            EXPECT_TRUE(information_vector == decoded);
+        }
+
+    // without a generator matrix, erasure decoding is not available
+    auto rs_no_matrix = std::make_unique<ReedSolomon>(60, 29, 1, 195, 0, 137);
+    EXPECT_EQ(rs_no_matrix->decode_erasures(code_vector, erasure_positions), -1);
+
+    // more erasures than parity symbols
+    erasure_positions.push_back(0);
+    erasure_positions.push_back(16);
+    EXPECT_EQ(rs->decode_erasures(code_vector, erasure_positions), -1);
+}
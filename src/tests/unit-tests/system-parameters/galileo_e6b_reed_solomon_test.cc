@@ -760,3 +760,53 @@ TEST(ReedSolomonE6BTest, DecodeErasure)
     std::vector<uint8_t> decoded(encoded_input.begin(), encoded_input.begin() + 32);
     EXPECT_TRUE(expected_output == decoded);
 }
+
+
+TEST(ReedSolomonE6BTest, DecodeErasuresBlock)
+{
+    // Several codewords in the columns of a matrix, as the HAS pages
+    constexpr size_t columns = 53;
+    auto rs = std::make_unique<ReedSolomon>();
+
+    std::vector<uint8_t> information(32 * columns);
+    for (size_t i = 0; i < information.size(); i++)
+        {
+            information[i] = static_cast<uint8_t>((i * 37 + 11) % 256);
+        }
+    std::vector<uint8_t> block(255 * columns, 0);
+    for (size_t col = 0; col < columns; col++)
+        {
+            std::vector<uint8_t> info_column(32);
+            for (size_t row = 0; row < 32; row++)
+                {
+                    info_column[row] = information[row * columns + col];
+                }
+            const std::vector<uint8_t> codeword = rs->encode_with_generator_matrix(info_column);
+            for (size_t row = 0; row < 255; row++)
+                {
+                    block[row * columns + col] = codeword[row];
+                }
+        }
+
+    // Keep 32 rows: 5 information rows and 27 parity rows
+    std::vector<int> erasure_positions;
+    for (int row = 0; row < 255; row++)
+        {
+            const bool received = (row < 32 && row % 7 == 0) || (row >= 40 && row % 8 == 1);
+            if (!received)
+                {
+                    erasure_positions.push_back(row);
+                    std::fill(block.begin() + row * columns, block.begin() + (row + 1) * columns, 0);
+                }
+        }
+    ASSERT_EQ(erasure_positions.size(), 223U);
+
+    int result = rs->decode_erasures(block, columns, erasure_positions);
+    EXPECT_EQ(result, 223);
+    std::vector<uint8_t> decoded(block.begin(), block.begin() + 32 * columns);
+    EXPECT_TRUE(information == decoded);
+
+    // wrong block size
+    block.resize(254 * columns);
+    EXPECT_EQ(rs->decode_erasures(block, columns, erasure_positions), -1);
+}
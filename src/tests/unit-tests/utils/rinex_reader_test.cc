@@ -0,0 +1,341 @@
+/*!
+ * \file rinex_reader_test.cc
+ * \brief Tests for the RINEX observation and navigation file readers.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gps_ephemeris.h"
+#include "rinex_reader.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+
+namespace
+{
+std::string rinex_header_line(const std::string& content, const std::string& label)
+{
+    std::string line = content;
+    line.resize(60, ' ');
+    return line + label + '\n';
+}
+
+
+std::string rinex_d_format(double value)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%19.12E", value);
+    std::string s(buffer);
+    std::replace(s.begin(), s.end(), 'E', 'D');
+    return s;
+}
+
+
+double rinex_test_obs(int32_t prn, int32_t epoch, int32_t k)
+{
+    return 2.0e7 + prn * 1.0e5 + epoch * 123.456 + k * 1000.125;
+}
+
+
+// RINEX 3.04 file with GPS and Galileo satellites, and an event record
+std::string rinex3_obs_file(int32_t epochs)
+{
+    std::string s = rinex_header_line("     3.04           OBSERVATION DATA    M (MIXED)", "RINEX VERSION / TYPE");
+    s += rinex_header_line("G    3 C1C L1C D1C", "SYS / # / OBS TYPES");
+    s += rinex_header_line("E    2 C1B L1B", "SYS / # / OBS TYPES");
+    s += rinex_header_line("     0.100", "INTERVAL");
+    s += rinex_header_line("", "END OF HEADER");
+    char buffer[128];
+    for (int32_t e = 0; e < epochs; e++)
+        {
+            const double second = (e % 600) * 0.1;
+            const int32_t minute = e / 600;
+            snprintf(buffer, sizeof(buffer), "> 2022 01 05 10 %02d%11.7f  0  3\n", minute % 60, second);
+            s += buffer;
+            for (int32_t prn : {5, 12})
+                {
+                    snprintf(buffer, sizeof(buffer), "G%02d", prn);
+                    s += buffer;
+                    for (int32_t k = 0; k < 3; k++)
+                        {
+                            snprintf(buffer, sizeof(buffer), "%14.3f  ", rinex_test_obs(prn, e, k));
+                            s += buffer;
+                        }
+                    s += '\n';
+                }
+            snprintf(buffer, sizeof(buffer), "E07%14.3f  \n", rinex_test_obs(7, e, 0));  // blank L1B
+            s += buffer;
+            if (e == 1)
+                {
+                    s += ">                              4  1\n";
+                    s += rinex_header_line("EVENT", "COMMENT");
+                }
+        }
+    return s;
+}
+
+
+std::string write_test_file(const std::string& name, const std::string& content)
+{
+    std::ofstream file(name, std::ios::binary);
+    file << content;
+    return name;
+}
+}  // namespace
+
+
+TEST(RinexReaderTest, ReadsRinex3Observations)
+{
+    const std::string filename = write_test_file("rinex_reader_test.22o", rinex3_obs_file(3));
+    Rinex_Obs_File obs;
+    ASSERT_TRUE(obs.read(filename, 1));
+    std::remove(filename.c_str());
+
+    EXPECT_DOUBLE_EQ(obs.version, 3.04);
+    EXPECT_EQ(obs.file_system, 'M');
+    EXPECT_DOUBLE_EQ(obs.interval_s, 0.1);
+    EXPECT_EQ(obs.epochs, 3U);
+    EXPECT_EQ(obs.obs_index('G', "D1C"), 2);
+    EXPECT_EQ(obs.obs_index('E', "L1B"), 1);
+    EXPECT_EQ(obs.obs_index('E', "D1B"), -1);
+    EXPECT_EQ(obs.obs_index('R', "C1C"), -1);
+    EXPECT_EQ(obs.series('G', 1), nullptr);
+
+    const Rinex_Obs_Series* g12 = obs.series('G', 12);
+    ASSERT_NE(g12, nullptr);
+    ASSERT_EQ(g12->tow.size(), 3U);
+    ASSERT_EQ(g12->obs.size(), 3U);
+    EXPECT_EQ(g12->week[0], 2191);
+    EXPECT_DOUBLE_EQ(g12->tow[0], 3 * 86400.0 + 10 * 3600.0);
+    EXPECT_DOUBLE_EQ(g12->tow[2], 3 * 86400.0 + 10 * 3600.0 + 0.2);
+    for (int32_t e = 0; e < 3; e++)
+        {
+            for (int32_t k = 0; k < 3; k++)
+                {
+                    EXPECT_DOUBLE_EQ(g12->obs[k][e], rinex_test_obs(12, e, k));
+                }
+        }
+    const Rinex_Obs_Series* e07 = obs.series('E', 7);
+    ASSERT_NE(e07, nullptr);
+    EXPECT_DOUBLE_EQ(e07->obs[0][1], rinex_test_obs(7, 1, 0));
+    EXPECT_DOUBLE_EQ(e07->obs[1][1], 0.0);
+}
+
+
+TEST(RinexReaderTest, ReadsRinex2Observations)
+{
+    std::string s = rinex_header_line("     2.11           OBSERVATION DATA    G (GPS)", "RINEX VERSION / TYPE");
+    s += rinex_header_line("    10    C1    L1    D1    S1    P2    L2    C2    P1    S2", "# / TYPES OF OBSERV");
+    s += rinex_header_line("          L5", "# / TYPES OF OBSERV");
+    s += rinex_header_line("", "END OF HEADER");
+    char buffer[128];
+    for (int32_t e = 0; e < 2; e++)
+        {
+            // 13 satellites, so that the list takes two lines
+            snprintf(buffer, sizeof(buffer), " 22  1  5 10  0%11.7f  0 13", e * 1.0);
+            s += buffer;
+            for (int32_t prn = 1; prn <= 13; prn++)
+                {
+                    if (prn == 13)
+                        {
+                            s += '\n' + std::string(32, ' ');
+                        }
+                    snprintf(buffer, sizeof(buffer), "G%02d", prn);
+                    s += buffer;
+                }
+            s += '\n';
+            for (int32_t prn = 1; prn <= 13; prn++)
+                {
+                    for (int32_t k = 0; k < 10; k++)
+                        {
+                            snprintf(buffer, sizeof(buffer), "%14.3f  ", rinex_test_obs(prn, e, k));
+                            s += buffer;
+                            if (k == 4 or k == 9)
+                                {
+                                    s += '\n';
+                                }
+                        }
+                }
+        }
+    const std::string filename = write_test_file("rinex_reader_test.22o", s);
+    Rinex_Obs_File obs;
+    ASSERT_TRUE(obs.read(filename));
+    std::remove(filename.c_str());
+
+    EXPECT_EQ(obs.epochs, 2U);
+    EXPECT_EQ(obs.obs_index('G', "C1C"), 0);
+    EXPECT_EQ(obs.obs_index('G', "L2W"), 5);
+    EXPECT_EQ(obs.obs_index('G', "L5X"), 9);
+    ASSERT_EQ(obs.satellites['G'].size(), 13U);
+    const Rinex_Obs_Series* g13 = obs.series('G', 13);
+    ASSERT_NE(g13, nullptr);
+    ASSERT_EQ(g13->tow.size(), 2U);
+    EXPECT_DOUBLE_EQ(g13->tow[1], 3 * 86400.0 + 10 * 3600.0 + 1.0);
+    EXPECT_DOUBLE_EQ(g13->obs[9][1], rinex_test_obs(13, 1, 9));
+    EXPECT_DOUBLE_EQ(obs.series('G', 4)->obs[2][0], rinex_test_obs(4, 0, 2));
+}
+
+
+TEST(RinexReaderTest, ReadsBlankSystemAsGpsInMixedRinex2)
+{
+    std::string s = rinex_header_line("     2.11           OBSERVATION DATA    M (MIXED)", "RINEX VERSION / TYPE");
+    s += rinex_header_line("     2    C1    L1", "# / TYPES OF OBSERV");
+    s += rinex_header_line("", "END OF HEADER");
+    s += " 22  1  5 10  0  0.0000000  0  2 05R07\n";
+    char buffer[128];
+    for (int32_t prn : {5, 7})
+        {
+            snprintf(buffer, sizeof(buffer), "%14.3f  %14.3f  \n", rinex_test_obs(prn, 0, 0), rinex_test_obs(prn, 0, 1));
+            s += buffer;
+        }
+    const std::string filename = write_test_file("rinex_reader_test.22o", s);
+    Rinex_Obs_File obs;
+    ASSERT_TRUE(obs.read(filename));
+    std::remove(filename.c_str());
+
+    const Rinex_Obs_Series* g05 = obs.series('G', 5);
+    ASSERT_NE(g05, nullptr);
+    EXPECT_DOUBLE_EQ(g05->obs[1][0], rinex_test_obs(5, 0, 1));
+    const Rinex_Obs_Series* r07 = obs.series('R', 7);
+    ASSERT_NE(r07, nullptr);
+    EXPECT_DOUBLE_EQ(r07->obs[0][0], rinex_test_obs(7, 0, 0));
+}
+
+
+TEST(RinexReaderTest, ParallelParsingKeepsTheEpochOrder)
+{
+    // about 3 MB, so that it is split into several chunks
+    const std::string filename = write_test_file("rinex_reader_test.22o", rinex3_obs_file(20000));
+    Rinex_Obs_File single;
+    Rinex_Obs_File parallel;
+    ASSERT_TRUE(single.read(filename, 1));
+    ASSERT_TRUE(parallel.read(filename, 4));
+    std::remove(filename.c_str());
+
+    EXPECT_EQ(single.epochs, 20000U);
+    EXPECT_EQ(parallel.epochs, 20000U);
+    for (int32_t prn : {5, 12})
+        {
+            const Rinex_Obs_Series* a = single.series('G', prn);
+            const Rinex_Obs_Series* b = parallel.series('G', prn);
+            ASSERT_NE(a, nullptr);
+            ASSERT_NE(b, nullptr);
+            EXPECT_EQ(a->tow, b->tow);
+            EXPECT_EQ(a->obs, b->obs);
+            EXPECT_DOUBLE_EQ(b->obs[1][19999], rinex_test_obs(prn, 19999, 1));
+        }
+}
+
+
+TEST(RinexReaderTest, ReadsNavigationRecords)
+{
+    std::string s = rinex_header_line("     3.04           N: GNSS NAV DATA    M: MIXED", "RINEX VERSION / TYPE");
+    s += rinex_header_line("GPSA   1.1176D-08  1.4901D-08 -5.9605D-08 -1.1921D-07", "IONOSPHERIC CORR");
+    s += rinex_header_line("GPUT -1.8626451492D-09-1.509903313D-14 405504 2191", "TIME SYSTEM CORR");
+    s += rinex_header_line("    18    18  2185     7", "LEAP SECONDS");
+    s += rinex_header_line("", "END OF HEADER");
+    const double values[29] = {-1.0e-4, -2.5e-12, 0.0, 42.0, -51.25, 4.5e-9, 1.25, -2.6e-6, 0.0123,
+        7.8e-6, 5153.6, 381600.0, 1.1e-7, -2.9, -3.5e-8, 0.96, 230.0, 0.75, -8.1e-9, 2.1e-10, 1.0,
+        2191.0, 0.0, 2.0, 0.0, -1.1e-8, 42.0, 378000.0, 4.0};
+    s += "G05 2022 01 05 10 00 00" + rinex_d_format(values[0]) + rinex_d_format(values[1]) + rinex_d_format(values[2]) + '\n';
+    for (size_t n = 3; n < 29; n += 4)
+        {
+            s += "    ";
+            for (size_t k = n; k < std::min<size_t>(n + 4, 29); k++)
+                {
+                    s += rinex_d_format(values[k]);
+                }
+            s += '\n';
+        }
+    s += "E11 2022 01 05 10 10 00" + rinex_d_format(1.0e-3) + rinex_d_format(0.0) + rinex_d_format(0.0) + '\n';
+    for (int32_t n = 0; n < 7; n++)
+        {
+            s += "    " + rinex_d_format(n) + rinex_d_format(n) + rinex_d_format(n) + rinex_d_format(n) + '\n';
+        }
+    const std::string filename = write_test_file("rinex_reader_test.22n", s);
+    Rinex_Nav_File nav;
+    ASSERT_TRUE(nav.read(filename));
+    std::remove(filename.c_str());
+
+    EXPECT_EQ(nav.file_system, 'M');
+    EXPECT_EQ(nav.leap_seconds, 18);
+    EXPECT_EQ(nav.leap_week, 2185);
+    EXPECT_DOUBLE_EQ(nav.iono_corrections["GPSA"][2], -5.9605e-08);
+    EXPECT_DOUBLE_EQ(nav.time_corrections["GPUT"].A1, -1.509903313e-14);
+    EXPECT_EQ(nav.time_corrections["GPUT"].ref_tow, 405504);
+    ASSERT_EQ(nav.records.size(), 2U);
+    EXPECT_EQ(nav.records[1].system, 'E');
+    EXPECT_EQ(nav.records[1].prn, 11);
+    EXPECT_EQ(nav.records[1].data.size(), 31U);
+    EXPECT_DOUBLE_EQ(nav.records[1].tow, 3 * 86400.0 + 10 * 3600.0 + 600.0);
+
+    const Rinex_Nav_Record& record = nav.records[0];
+    ASSERT_EQ(record.data.size(), 31U);
+    for (size_t n = 0; n < 29; n++)
+        {
+            EXPECT_DOUBLE_EQ(record.data[n], values[n]);
+        }
+    const Gps_Ephemeris eph = rinex_to_gps_ephemeris(record);
+    EXPECT_EQ(eph.PRN, 5U);
+    EXPECT_EQ(eph.toc, 3 * 86400 + 10 * 3600);
+    EXPECT_EQ(eph.toe, 381600);
+    EXPECT_EQ(eph.IODE_SF2, 42);
+    EXPECT_EQ(eph.WN, 2191);
+    EXPECT_DOUBLE_EQ(eph.sqrtA, 5153.6);
+    EXPECT_DOUBLE_EQ(eph.TGD, -1.1e-8);
+    EXPECT_EQ(eph.tow, 378000);
+}
+
+
+TEST(RinexReaderTest, ReadsRinex2Navigation)
+{
+    std::string s = rinex_header_line("     2.10           N: GPS NAV DATA", "RINEX VERSION / TYPE");
+    s += rinex_header_line("    0.1118D-07  0.1490D-07 -0.5960D-07 -0.1192D-06", "ION ALPHA");
+    s += rinex_header_line("", "END OF HEADER");
+    s += " 9 14 12 20  2  0  0.0" + rinex_d_format(1.5e-4) + rinex_d_format(0.0) + rinex_d_format(0.0) + '\n';
+    for (int32_t n = 0; n < 7; n++)
+        {
+            s += "   " + rinex_d_format(n + 1) + rinex_d_format(n + 2) + rinex_d_format(n + 3) + rinex_d_format(n + 4) + '\n';
+        }
+    s += "12 14 12 20  4  0  0.0" + rinex_d_format(2.5e-4) + rinex_d_format(0.0) + rinex_d_format(0.0) + '\n';
+    s += "   " + rinex_d_format(1.0) + '\n';
+    const std::string filename = write_test_file("rinex_reader_test.14n", s);
+    Rinex_Nav_File nav;
+    ASSERT_TRUE(nav.read(filename));
+    std::remove(filename.c_str());
+
+    EXPECT_EQ(nav.file_system, 'G');
+    EXPECT_DOUBLE_EQ(nav.iono_corrections["GPSA"][0], 0.1118e-07);
+    ASSERT_EQ(nav.records.size(), 2U);
+    EXPECT_EQ(nav.records[0].prn, 9);
+    EXPECT_EQ(nav.records[0].epoch[0], 2014);
+    EXPECT_EQ(nav.records[0].data.size(), 31U);
+    EXPECT_DOUBLE_EQ(nav.records[0].data[0], 1.5e-4);
+    EXPECT_DOUBLE_EQ(nav.records[0].data[30], 10.0);
+    EXPECT_EQ(nav.records[1].prn, 12);
+    EXPECT_EQ(nav.records[1].data.size(), 7U);
+    EXPECT_EQ(nav.records[1].week, 1823);
+}
+
+
+TEST(RinexReaderTest, RejectsRinex2ObservationsAsNavigation)
+{
+    std::string s = rinex_header_line("     2.11           OBSERVATION DATA    G (GPS)", "RINEX VERSION / TYPE");
+    s += rinex_header_line("     1    C1", "# / TYPES OF OBSERV");
+    s += rinex_header_line("", "END OF HEADER");
+    const std::string filename = write_test_file("rinex_reader_test.22o", s);
+    Rinex_Nav_File nav;
+    EXPECT_FALSE(nav.read(filename));
+    std::remove(filename.c_str());
+}
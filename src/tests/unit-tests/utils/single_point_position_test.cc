@@ -0,0 +1,178 @@
+/*!
+ * \file single_point_position_test.cc
+ * \brief Compares the receiver clock estimation of obsdiff with the RTKLIB
+ * single point solution.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "gnss_obs_codes.h"
+#include "gps_ephemeris.h"
+#include "rtklib_conversions.h"
+#include "rtklib_ephemeris.h"
+#include "rtklib_pntpos.h"
+#include "rtklib_rtkcmn.h"
+#include "single_point_position.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+const int32_t spp_test_week = 2191;
+const double spp_test_toe = 381600.0;
+
+
+// 24 satellites in six orbital planes
+std::vector<Gps_Ephemeris> spp_test_constellation()
+{
+    std::vector<Gps_Ephemeris> constellation;
+    for (int32_t prn = 1; prn <= 24; prn++)
+        {
+            const int32_t plane = (prn - 1) / 4;
+            const int32_t slot = (prn - 1) % 4;
+            Gps_Ephemeris eph;
+            eph.PRN = prn;
+            eph.sqrtA = 5153.7;
+            eph.ecc = 0.005;
+            eph.i_0 = 0.96;
+            eph.OMEGA_0 = plane * GNSS_PI / 3.0;
+            eph.OMEGAdot = -8.0e-9;
+            eph.omega = 0.5;
+            eph.M_0 = slot * GNSS_PI / 2.0 + plane * 0.4;
+            eph.delta_n = 4.5e-9;
+            eph.toe = static_cast<int32_t>(spp_test_toe);
+            eph.toc = static_cast<int32_t>(spp_test_toe);
+            eph.tow = static_cast<int32_t>(spp_test_toe) - 3600;
+            eph.WN = spp_test_week;
+            eph.af0 = (prn - 12) * 2.0e-5;
+            eph.af1 = 1.0e-12;
+            eph.IODE_SF2 = 42;
+            eph.IODE_SF3 = 42;
+            eph.IODC = 42;
+            constellation.push_back(eph);
+        }
+    return constellation;
+}
+
+
+// Pseudorange from the receiver position rr at the true reception time t,
+// with the RTKLIB orbit and clock models
+double spp_test_pseudorange(const eph_t& eph, gtime_t t, const double* rr, double rx_clock_bias_m)
+{
+    double rs[6] = {0.0};
+    double dts = 0.0;
+    double var = 0.0;
+    double e[3];
+    double range = 0.0;
+    for (int iter = 0; iter < 5; iter++)
+        {
+            eph2pos(timeadd(t, -range / SPEED_OF_LIGHT_M_S), &eph, rs, &dts, &var);
+            range = geodist(rs, rr, e);
+        }
+    return range + rx_clock_bias_m - SPEED_OF_LIGHT_M_S * dts;
+}
+}  // namespace
+
+
+TEST(SinglePointPositionTest, ClockBiasMatchesRtklib)
+{
+    const double tow = spp_test_toe + 600.0;
+    const gtime_t rx_time = gpst2time(spp_test_week, tow);
+    const double llh[3] = {41.27 * D2R, 1.99 * D2R, 100.0};
+    double rr[3];
+    pos2ecef(llh, rr);
+
+    std::unique_ptr<nav_t> nav(new nav_t{});
+    std::vector<eph_t> rtklib_eph;
+    for (const auto& eph : spp_test_constellation())
+        {
+            rtklib_eph.push_back(eph_to_rtklib(eph, false));
+            nav->lam[eph.PRN - 1][0] = SPEED_OF_LIGHT_M_S / FREQ1;
+            nav->lam[eph.PRN - 1][1] = SPEED_OF_LIGHT_M_S / FREQ2;
+        }
+    nav->eph = rtklib_eph.data();
+    nav->n = static_cast<int>(rtklib_eph.size());
+    nav->nmax = nav->n;
+
+    prcopt_t opt{};
+    opt.mode = PMODE_SINGLE;
+    opt.navsys = SYS_GPS;
+    opt.nf = 1;
+    opt.elmin = 10.0 * D2R;
+    opt.sateph = EPHOPT_BRDC;
+    opt.ionoopt = IONOOPT_OFF;
+    opt.tropopt = TROPOPT_OFF;
+    opt.maxgdop = 30.0;
+    // equal weights for all the satellites, as in obsdiff
+    opt.err[0] = 100.0;
+    opt.err[1] = 0.003;
+
+    std::mt19937 generator(7);
+    std::normal_distribution<double> noise(0.0, 3.0);
+    // a few ms of receiver clock bias are usual in the RINEX files of
+    // the receiver, so the Sagnac correction must not depend on it
+    for (const double rx_clock_bias_s : {0.0, 2.5e-3, -7.0e-3})
+        {
+            const double rx_clock_bias_m = rx_clock_bias_s * SPEED_OF_LIGHT_M_S;
+            const gtime_t true_time = timeadd(rx_time, -rx_clock_bias_s);
+            std::vector<obsd_t> obs;
+            std::vector<std::pair<Gps_Ephemeris, double>> sats;
+            for (const auto& eph : spp_test_constellation())
+                {
+                    const eph_t& rtklib_sat = rtklib_eph[eph.PRN - 1];
+                    double rs[6] = {0.0};
+                    double dts = 0.0;
+                    double var = 0.0;
+                    double e[3];
+                    double azel[2];
+                    eph2pos(true_time, &rtklib_sat, rs, &dts, &var);
+                    geodist(rs, rr, e);
+                    if (satazel(llh, e, azel) < 15.0 * D2R)
+                        {
+                            continue;
+                        }
+                    const double pseudorange = spp_test_pseudorange(rtklib_sat, true_time, rr, rx_clock_bias_m) + noise(generator);
+                    obsd_t o{};
+                    o.time = rx_time;
+                    o.sat = static_cast<unsigned char>(eph.PRN);
+                    o.code[0] = CODE_L1C;
+                    o.P[0] = pseudorange;
+                    obs.push_back(o);
+                    sats.emplace_back(eph, pseudorange);
+                }
+            ASSERT_GE(sats.size(), 6U);
+
+            arma::vec x;
+            double gdop = 0.0;
+            double pdop = 0.0;
+            double rms = 0.0;
+            ASSERT_TRUE(solve_single_point_position(tow, sats, x, gdop, pdop, rms));
+
+            sol_t sol{};
+            char msg[128] = "";
+            ASSERT_EQ(1, pntpos(obs.data(), static_cast<int>(obs.size()), nav.get(), &opt, &sol, nullptr, nullptr, msg)) << msg;
+
+            // both are unweighted least-squares solutions of the same data
+            EXPECT_NEAR(x(3), sol.dtr[0] * SPEED_OF_LIGHT_M_S, 0.01) << "clock bias " << rx_clock_bias_s << " s";
+            for (int i = 0; i < 3; i++)
+                {
+                    EXPECT_NEAR(x(i), sol.rr[i], 0.01) << "clock bias " << rx_clock_bias_s << " s";
+                }
+            EXPECT_NEAR(x(3), rx_clock_bias_m, 10.0 * pdop) << "clock bias " << rx_clock_bias_s << " s";
+            EXPECT_LT(gdop, 5.0);
+        }
+}
@@ -18,46 +18,26 @@
  * -----------------------------------------------------------------------------
  */
 
+#include "MATH_CONSTANTS.h"
+#include "gnss_frequencies.h"
 #include "gnuplot_i.h"
+#include "gps_ephemeris.h"
 #include "obsdiff_flags.h"
+#include "rinex_reader.h"
+#include "single_point_position.h"
 #include <armadillo>
-// Classes for handling observations RINEX files (data)
-#include <gpstk/Rinex3ObsData.hpp>
-#include <gpstk/Rinex3ObsHeader.hpp>
-#include <gpstk/Rinex3ObsStream.hpp>
-
-// Classes for handling satellite navigation parameters RINEX
-// files (ephemerides)
-#include <gpstk/Rinex3NavData.hpp>
-#include <gpstk/Rinex3NavHeader.hpp>
-#include <gpstk/Rinex3NavStream.hpp>
-
-// Classes for handling RINEX files with meteorological parameters
-#include <gpstk/RinexMetBase.hpp>
-#include <gpstk/RinexMetData.hpp>
-#include <gpstk/RinexMetHeader.hpp>
-#include <gpstk/RinexMetStream.hpp>
-
-// Class for handling tropospheric model
-#include <gpstk/GGTropModel.hpp>
-
-// Class for storing >broadcast-type> ephemerides
-#include <gpstk/GPSEphemerisStore.hpp>
-
-// Class for handling RAIM
-#include <gpstk/PRSolution.hpp>
-
-// Class defining GPS system constants
-#include <gpstk/GNSSconstants.hpp>
 #include <matio.h>
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <fstream>
 #include <iomanip>
+#include <limits>
 #include <map>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #if GFLAGS_OLD_NAMESPACE
@@ -94,148 +74,70 @@ std::map<int, arma::mat> ReadRinexObs(const std::string& rinex_file, char system
             std::cout << "Warning: RINEX Obs file " << rinex_file << " does not exist\n";
             return obs_map;
         }
-    // Open and read _baseerence RINEX observables file
-    try
-        {
-            gpstk::Rinex3ObsStream r_base(rinex_file);
-
-            gpstk::Rinex3ObsData r_base_data;
-            gpstk::Rinex3ObsHeader r_base_header;
-
-            gpstk::RinexDatum dataobj;
-
-            r_base >> r_base_header;
-
-            std::set<int> PRN_set;
-            gpstk::SatID prn;
-            switch (system)
-                {
-                case 'G':
-#if OLD_GPSTK
-                    prn.system = gpstk::SatID::systemGPS;
-#else
-                    prn.system = gpstk::SatelliteSystem::GPS;
-#endif
-                    PRN_set = available_gps_prn;
-                    break;
-                case 'E':
-#if OLD_GPSTK
-                    prn.system = gpstk::SatID::systemGalileo;
-#else
-                    prn.system = gpstk::SatelliteSystem::Galileo;
-#endif
-                    PRN_set = available_galileo_prn;
-                    break;
-                default:
-#if OLD_GPSTK
-                    prn.system = gpstk::SatID::systemGPS;
-#else
-                    prn.system = gpstk::SatelliteSystem::GPS;
-#endif
-                    PRN_set = available_gps_prn;
-                }
 
-            std::cout << "Reading RINEX OBS file " << rinex_file << " ...\n";
-            while (r_base >> r_base_data)
-                {
-                    for (const auto& prn_it : PRN_set)
-                        {
-                            prn.id = prn_it;
-                            gpstk::CommonTime time = r_base_data.time;
-                            double sow(static_cast<gpstk::GPSWeekSecond>(time).sow);
+    // Pseudorange, carrier Doppler and carrier phase codes of the signal
+    std::array<std::string, 3> codes;
+    if (signal == "1C")
+        {
+            codes = {"C1C", "D1C", "L1C"};
+        }
+    else if (signal == "1B")
+        {
+            codes = {"C1B", "D1B", "L1B"};
+        }
+    else if (signal == "2S")  // L2M
+        {
+            codes = {"C2S", "D2S", "L2S"};
+        }
+    else if (signal == "L5")
+        {
+            codes = {"C5I", "D5I", "L5I"};
+        }
+    else if (signal == "5X")  // Simulator gives RINEX with E5a+E5b. Doppler and accumulated Carrier phase WILL differ
+        {
+            codes = {"C8I", "D8I", "L8I"};
+        }
+    else
+        {
+            std::cout << "ReadRinexObs unknown signal requested: " << signal << '\n';
+            return obs_map;
+        }
 
-                            auto pointer = r_base_data.obs.find(prn);
+    const char sys = (system == 'E') ? 'E' : 'G';
+    const std::set<int>& PRN_set = (sys == 'E') ? available_galileo_prn : available_gps_prn;
 
-                            if (pointer != r_base_data.obs.end())
-                                {
-                                    // insert next column
-                                    try
-                                        {
-                                            obs_map.at(prn.id);
-                                        }
-                                    catch (const std::out_of_range& oor)
-                                        {
-                                            obs_map[prn.id] = arma::mat();
-                                        }
-
-                                    arma::mat& obs_mat = obs_map[prn.id];
-                                    obs_mat.insert_rows(obs_mat.n_rows, arma::zeros<arma::mat>(1, 4));
-
-                                    if (strcmp("1C\0", signal.c_str()) == 0)
-                                        {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
-                                            dataobj = r_base_data.getObs(prn, "C1C", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;  // C1C P1 (psudorange L1)
-                                            dataobj = r_base_data.getObs(prn, "D1C", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;  // D1C Carrier Doppler
-                                            dataobj = r_base_data.getObs(prn, "L1C", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;  // L1C Carrier Phase
-                                        }
-                                    else if (strcmp("1B\0", signal.c_str()) == 0)
-                                        {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
-                                            dataobj = r_base_data.getObs(prn, "C1B", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "D1B", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "L1B", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;
-                                        }
-                                    else if (strcmp("2S\0", signal.c_str()) == 0)  // L2M
-                                        {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
-                                            dataobj = r_base_data.getObs(prn, "C2S", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "D2S", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "L2S", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;
-                                        }
-                                    else if (strcmp("L5\0", signal.c_str()) == 0)
-                                        {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
-                                            dataobj = r_base_data.getObs(prn, "C5I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "D5I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "L5I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;
-                                        }
-                                    else if (strcmp("5X\0", signal.c_str()) == 0)  // Simulator gives RINEX with E5a+E5b. Doppler and accumulated Carrier phase WILL differ
-                                        {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
-                                            dataobj = r_base_data.getObs(prn, "C8I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "D8I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;
-                                            dataobj = r_base_data.getObs(prn, "L8I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;
-                                        }
-                                    else
-                                        {
-                                            std::cout << "ReadRinexObs unknown signal requested: " << signal << '\n';
-                                            return obs_map;
-                                        }
-                                }
-                        }
-                }  // end while
-        }          // End of 'try' block
-    catch (const gpstk::FFStreamError& e)
+    std::cout << "Reading RINEX OBS file " << rinex_file << " ...\n";
+    Rinex_Obs_File rinex;
+    if (not rinex.read(rinex_file))
         {
-            std::cout << e;
             return obs_map;
         }
-    catch (const gpstk::Exception& e)
+    std::array<int32_t, 3> columns{};
+    for (size_t n = 0; n < codes.size(); n++)
         {
-            std::cout << e;
-            return obs_map;
+            columns[n] = rinex.obs_index(sys, codes[n]);
         }
-    catch (const std::exception& e)
+
+    // Columns: [sow, pseudorange, carrier Doppler, carrier phase]
+    for (const auto& prn : PRN_set)
         {
-            std::cout << "Exception: " << e.what();
-            std::cout << "unknown error.  I don't feel so well...\n";
-            return obs_map;
+            const Rinex_Obs_Series* series = rinex.series(sys, prn);
+            if (series == nullptr)
+                {
+                    continue;
+                }
+            arma::mat obs_mat(series->tow.size(), 4, arma::fill::zeros);
+            obs_mat.col(0) = arma::vec(series->tow);
+            for (size_t n = 0; n < columns.size(); n++)
+                {
+                    if (columns[n] >= 0)
+                        {
+                            obs_mat.col(n + 1) = arma::vec(series->obs[columns[n]]);
+                        }
+                }
+            obs_map[prn] = std::move(obs_mat);
         }
+
     if (obs_map.empty())
         {
             std::cout << "Warning: file "
@@ -906,7 +808,7 @@ void coderate_phaserate_consistence(
     arma::vec prange = measured_ch0.col(1);
 
     // todo: This code is only valid for L1/E1 carrier frequency.
-    arma::vec phase = measured_ch0.col(3) * (gpstk::C_MPS / gpstk::L1_FREQ_GPS);
+    arma::vec phase = measured_ch0.col(3) * (SPEED_OF_LIGHT_M_S / FREQ1);
 
     double mincodeval = 5000000.0;
     double maxcodeval = 40000000.0;
@@ -1051,7 +953,7 @@ void code_phase_diff(
     arma::interp1(measured_ch1.col(0), measured_ch1.col(3), measurement_time, carrier_phase_ch1_obs_interp);
 
     // generate Code - Phase vector
-    arma::vec code_minus_phase = (measured_ch0.col(1) - code_range_ch1_obs_interp) - (measured_ch0.col(3) - carrier_phase_ch1_obs_interp) * (gpstk::C_MPS / gpstk::L1_FREQ_GPS);
+    arma::vec code_minus_phase = (measured_ch0.col(1) - code_range_ch1_obs_interp) - (measured_ch0.col(3) - carrier_phase_ch1_obs_interp) * (SPEED_OF_LIGHT_M_S / FREQ1);
 
     // remove NaN
     arma::uvec NaN_in_measured_data = arma::find_nonfinite(code_minus_phase);
@@ -1126,6 +1028,26 @@ void code_phase_diff(
 }
 
 
+// WGS84 geodetic latitude and longitude [deg] and height [m]
+void ecef_to_geodetic(const arma::vec& x, double& lat_deg, double& lon_deg, double& h)
+{
+    const double a = 6378137.0;
+    const double f = 1.0 / 298.257223563;
+    const double e2 = f * (2.0 - f);
+    const double p = std::sqrt(x(0) * x(0) + x(1) * x(1));
+    double lat = std::atan2(x(2), p * (1.0 - e2));
+    double N = a;
+    for (int iter = 0; iter < 10; iter++)
+        {
+            N = a / std::sqrt(1.0 - e2 * std::sin(lat) * std::sin(lat));
+            h = p / std::cos(lat) - N;
+            lat = std::atan2(x(2), p * (1.0 - e2 * N / (N + h)));
+        }
+    lat_deg = lat * R2D;
+    lon_deg = std::atan2(x(1), x(0)) * R2D;
+}
+
+
 double compute_rx_clock_error(const std::string& rinex_nav_filename, const std::string& rinex_obs_file)
 {
     std::cout << "Computing receiver's clock error...\n";
@@ -1134,217 +1056,125 @@ double compute_rx_clock_error(const std::string& rinex_nav_filename, const std::
             std::cout << "Warning: RINEX Nav file " << rinex_nav_filename << " does not exist, receiver's clock error could not be computed!\n";
             return 0.0;
         }
-    // Declaration of objects for storing ephemerides and handling RAIM
-    gpstk::GPSEphemerisStore bcestore;
-    gpstk::PRSolution raimSolver;
-
-    // Object for void-type tropospheric model (in case no meteorological
-    // RINEX is available)
-    gpstk::ZeroTropModel noTropModel;
 
-    // Object for GG-type tropospheric model (Goad and Goodman, 1974)
-    // Default constructor => default values for model
-    gpstk::GGTropModel ggTropModel;
-
-    // Pointer to one of the two available tropospheric models. It points
-    // to the void model by default
-    gpstk::TropModel* tropModelPtr = &noTropModel;
-
-    double rx_clock_error_s = 0.0;
-    try
+    // GPS broadcast ephemerides, by PRN
+    Rinex_Nav_File nav;
+    if (not nav.read(rinex_nav_filename))
         {
-            // Read nav file and store unique list of ephemerides
-            gpstk::Rinex3NavStream rnffs(rinex_nav_filename.c_str());  // Open ephemerides data file
-            gpstk::Rinex3NavData rne;
-            gpstk::Rinex3NavHeader hdr;
-
-            // Let's read the header (may be skipped)
-            rnffs >> hdr;
-
-            // Storing the ephemeris in "bcstore"
-            while (rnffs >> rne)
+            return 0.0;
+        }
+    std::map<int32_t, std::vector<Gps_Ephemeris>> ephemerides;
+    for (const auto& record : nav.records)
+        {
+            if (record.system == 'G')
                 {
-                    bcestore.addEphemeris(rne);
+                    ephemerides[record.prn].push_back(rinex_to_gps_ephemeris(record));
                 }
+        }
 
-            // Setting the criteria for looking up ephemeris
-            bcestore.SearchNear();
-
-            // Open and read the observation file one epoch at a time.
-            // For each epoch, compute and print a position solution
-            gpstk::Rinex3ObsStream roffs(rinex_obs_file.c_str());  // Open observations data file
-
-            gpstk::Rinex3ObsHeader roh;
-            gpstk::Rinex3ObsData rod;
-
-            // Let's read the header
-            roffs >> roh;
+    Rinex_Obs_File obs;
+    if (not obs.read(rinex_obs_file))
+        {
+            return 0.0;
+        }
+    const int32_t indexC1 = obs.obs_index('G', "C1C");
+    const auto gps = obs.satellites.find('G');
+    if (indexC1 < 0 or gps == obs.satellites.end())
+        {
+            std::cerr << "The observation file doesn't have C1 pseudoranges, RX clock error could not be computed!\n";
+            return 0.0;
+        }
 
-            int indexC1;
-            try
+    // Walk the epochs in time order, through the rows of each satellite,
+    // until a solution is found
+    std::map<int32_t, size_t> rows;
+    while (true)
+        {
+            double epoch_time = std::numeric_limits<double>::max();
+            for (const auto& sat : gps->second)
                 {
-                    indexC1 = roh.getObsIndex("C1");
+                    const size_t row = rows[sat.first];
+                    if (row < sat.second.tow.size())
+                        {
+                            epoch_time = std::min(epoch_time, sat.second.week[row] * 604800.0 + sat.second.tow[row]);
+                        }
                 }
-            catch (...)
+            if (epoch_time == std::numeric_limits<double>::max())
                 {
-                    std::cerr << "The observation file doesn't have C1 pseudoranges, RX clock error could not be computed!\n";
-                    return (0.0);
+                    break;
                 }
 
-            // Let's process all lines of observation data, one by one
-            while (roffs >> rod)
+            double tow = 0.0;
+            std::vector<std::pair<Gps_Ephemeris, double>> sats;
+            for (const auto& sat : gps->second)
                 {
-                    // Apply editing criteria
-                    if (rod.epochFlag == 0 || rod.epochFlag == 1)  // Begin usable data
+                    size_t& row = rows[sat.first];
+                    if (row >= sat.second.tow.size() or sat.second.week[row] * 604800.0 + sat.second.tow[row] > epoch_time + 1e-6)
                         {
-                            std::vector<gpstk::SatID> prnVec;
-                            std::vector<double> rangeVec;
-
-                            // Define the "it" iterator to visit the observations PRN map.
-                            // Rinex3ObsData::DataMap is a map from RinexSatID to
-                            // vector<RinexDatum>:
-                            //      std::map<RinexSatID, vector<RinexDatum> >
-                            gpstk::Rinex3ObsData::DataMap::const_iterator it;
-
-                            // This part gets the PRN numbers and ionosphere-corrected
-                            // pseudoranges for the current epoch. They are correspondly fed
-                            // into "prnVec" and "rangeVec"; "obs" is a public attribute of
-                            // Rinex3ObsData to get the map of observations
-                            for (it = rod.obs.begin(); it != rod.obs.end(); it++)
-                                {
-                                    // The RINEX file may have P1 observations, but the current
-                                    // satellite may not have them.
-                                    double C1(0.0);
-                                    try
-                                        {
-                                            C1 = rod.getObs((*it).first, indexC1).data;
-                                        }
-                                    catch (...)
-                                        {
-                                            // Ignore this satellite if P1 is not found
-                                            continue;
-                                        }
-                                    // Now, we include the current PRN number in the first part
-                                    // of "it" iterator into the vector holding the satellites.
-                                    // All satellites in view at this epoch that have P1 or P1+P2
-                                    // observations will be included.
-                                    prnVec.push_back((*it).first);
-
-                                    // The same is done for the vector of doubles holding the
-                                    // corrected ranges
-                                    rangeVec.push_back(C1);
-
-                                    // WARNING: Please note that so far no further correction
-                                    // is done on data: Relativistic effects, tropospheric
-                                    // correction, instrumental delays, etc.
-                                }  // End of 'for( it = rod.obs.begin(); it!= rod.obs.end(); ...'
-
-                            // The default constructor for PRSolution2 objects (like
-                            // "raimSolver") is to set a RMSLimit of 6.5. We change that
-                            // here. With this value of 3e6 the solution will have a lot
-                            // more dispersion.
-                            raimSolver.RMSLimit = 3e6;
-
-                            // In order to compute positions we need the current time, the
-                            // vector of visible satellites, the vector of corresponding
-                            // ranges, the object containing satellite ephemerides, and a
-                            // pointer to the tropospheric model to be applied
-                            try
-                                {
-#if OLD_GPSTK
-                                    std::vector<gpstk::SatID::SatelliteSystem> Syss;
-#endif
-                                    gpstk::Matrix<double> invMC;
-                                    int iret;
-                                    // Call RAIMCompute
-#if OLD_GPSTK
-                                    iret = raimSolver.RAIMCompute(rod.time, prnVec, Syss, rangeVec, invMC,
-                                        &bcestore, tropModelPtr);
-#else
-                                    iret = raimSolver.RAIMCompute(rod.time, prnVec, rangeVec, invMC,
-                                        &bcestore, tropModelPtr);
-#endif
-                                    switch (iret)
-                                        {
-                                        /// @return Return values:
-                                        ///  1  solution is ok, but may be degraded; check TropFlag,
-                                        ///  RMSFlag, SlopeFlag 0  ok
-                                        case -1:
-
-                                            std::cout << " algorithm failed to converge at time: " << rod.time
-                                                      << " \n";
-                                            break;
-                                        case -2:
-                                            std::cout
-                                                << " singular problem, no solution is possible at time: "
-                                                << rod.time << " \n";
-                                            break;
-                                        case -3:
-                                            std::cout << " not enough good data (> 4) to form a (RAIM) "
-                                                         "solution at time: "
-                                                      << rod.time << " \n";
-                                            break;
-                                        case -4:
-                                            std::cout
-                                                << "ephemeris not found for all the satellites at time: "
-                                                << rod.time << " \n";
-                                            break;
-                                        default:
-                                            break;
-                                        }
-                                    // return iret;
-                                }
-                            catch (const gpstk::Exception& e)
+                            continue;
+                        }
+                    tow = sat.second.tow[row];
+                    const double C1 = sat.second.obs[indexC1][row];
+                    row++;
+                    const auto eph = ephemerides.find(sat.first);
+                    if (C1 == 0.0 or eph == ephemerides.end())
+                        {
+                            // Ignore this satellite if C1 or its ephemeris is not found
+                            continue;
+                        }
+                    // Ephemeris nearest in time
+                    const Gps_Ephemeris* nearest = &eph->second.front();
+                    for (const auto& e : eph->second)
+                        {
+                            if (std::abs(e.WN * 604800.0 + e.toe - epoch_time) < std::abs(nearest->WN * 604800.0 + nearest->toe - epoch_time))
                                 {
+                                    nearest = &e;
                                 }
+                        }
+                    sats.emplace_back(*nearest, C1);
+                }
 
-                            // If we got a valid solution, let's print it
-                            if (raimSolver.isValid())
-                                {
-                                    std::cout << "RX POS ECEF [XYZ] " << std::fixed << std::setprecision(3) << " "
-                                              << std::setw(12) << raimSolver.Solution(0) << " "
-                                              << std::setw(12) << raimSolver.Solution(1) << " "
-                                              << std::setw(12) << raimSolver.Solution(2) << "\n";
-
-                                    std::cout << "RX CLK " << std::fixed << std::setprecision(16)
-                                              << raimSolver.Solution(3) / gpstk::C_MPS << " [s] \n";
-
-                                    std::cout << "NSATS, DOPs " << std::setw(2) << raimSolver.Nsvs << std::fixed
-                                              << std::setprecision(2) << " "
-                                              << std::setw(4) << raimSolver.PDOP << " " << std::setw(4) << raimSolver.GDOP
-                                              << " " << std::setw(8) << raimSolver.RMSResidual << "\n";
-                                    gpstk::Position rx_pos;
-                                    rx_pos.setECEF(gpstk::Triple(raimSolver.Solution(0), raimSolver.Solution(1), raimSolver.Solution(2)));
-
-                                    double lat_deg = rx_pos.geodeticLatitude();
-                                    double lon_deg = rx_pos.longitude();
-                                    double Alt_m = rx_pos.getAltitude();
-                                    std::cout << "RX POS GEO [Lat,Long,H]" << std::fixed << std::setprecision(10) << " "
-                                              << std::setw(12) << lat_deg << ","
-                                              << std::setw(12) << lon_deg << ","
-                                              << std::setw(12) << Alt_m << " [deg],[deg],[m]\n";
+            arma::vec solution;
+            double gdop = 0.0;
+            double pdop = 0.0;
+            double rms = 0.0;
+            if (sats.size() < 4)
+                {
+                    std::cout << " not enough good data (>= 4) to form a solution at time: " << tow << " \n";
+                    continue;
+                }
+            if (not solve_single_point_position(tow, sats, solution, gdop, pdop, rms))
+                {
+                    std::cout << " algorithm failed to converge at time: " << tow << " \n";
+                    continue;
+                }
 
-                                    // set computed RX clock error and stop iterating obs epochs
-                                    rx_clock_error_s = raimSolver.Solution(3) / gpstk::C_MPS;
-                                    break;
-                                }  // End of 'if( raimSolver.isValid() )'
-                        }          // End of 'if( rod.epochFlag == 0 || rod.epochFlag == 1 )'
-                }                  // End of 'while( roffs >> rod )'
-        }
-    catch (const gpstk::FFStreamError& e)
-        {
-            std::cout << "GPSTK exception: " << e << '\n';
-        }
-    catch (const gpstk::Exception& e)
-        {
-            std::cout << "GPSTK exception: " << e << '\n';
+            std::cout << "RX POS ECEF [XYZ] " << std::fixed << std::setprecision(3) << " "
+                      << std::setw(12) << solution(0) << " "
+                      << std::setw(12) << solution(1) << " "
+                      << std::setw(12) << solution(2) << "\n";
+
+            std::cout << "RX CLK " << std::fixed << std::setprecision(16)
+                      << solution(3) / SPEED_OF_LIGHT_M_S << " [s] \n";
+
+            std::cout << "NSATS, DOPs " << std::setw(2) << sats.size() << std::fixed
+                      << std::setprecision(2) << " "
+                      << std::setw(4) << pdop << " " << std::setw(4) << gdop
+                      << " " << std::setw(8) << rms << "\n";
+
+            double lat_deg;
+            double lon_deg;
+            double Alt_m;
+            ecef_to_geodetic(solution, lat_deg, lon_deg, Alt_m);
+            std::cout << "RX POS GEO [Lat,Long,H]" << std::fixed << std::setprecision(10) << " "
+                      << std::setw(12) << lat_deg << ","
+                      << std::setw(12) << lon_deg << ","
+                      << std::setw(12) << Alt_m << " [deg],[deg],[m]\n";
+
+            // computed RX clock error, stop iterating obs epochs
+            return solution(3) / SPEED_OF_LIGHT_M_S;
         }
-    catch (...)
-        {
-            std::cout << "Caught an unexpected exception.\n";
-        }
-
-    return rx_clock_error_s;
+    return 0.0;
 }
 
 
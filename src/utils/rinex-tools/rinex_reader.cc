@@ -0,0 +1,972 @@
+/*!
+ * \file rinex_reader.cc
+ * \brief Memory-mapped RINEX 2, 3 and 4 observation and navigation file
+ * readers with columnar, per-satellite output.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rinex_reader.h"
+#include "galileo_ephemeris.h"
+#include "gps_ephemeris.h"
+#include <fcntl.h>     // for open, O_RDONLY
+#include <sys/mman.h>  // for mmap, munmap, madvise
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for read, close
+#include <algorithm>   // for std::min, std::max
+#include <cstddef>     // for size_t
+#include <cstdlib>     // for strtod
+#include <cstring>     // for memchr, memcmp, strchr, strlen
+#include <functional>  // for std::cref, std::ref
+#include <iostream>    // for std::cerr
+#include <thread>      // for std::thread
+#include <utility>     // for std::move
+
+
+namespace
+{
+constexpr size_t RINEX_MIN_CHUNK_BYTES = 1 << 20;  // smaller bodies are parsed by a single thread
+constexpr int32_t RINEX_MAX_PRN = 100;
+constexpr int32_t RINEX_NUM_SYSTEMS = 7;
+const char RINEX_SYSTEMS[RINEX_NUM_SYSTEMS + 1] = "GRECJIS";
+
+const double POW10[23] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+
+int32_t system_index(char system)
+{
+    const char* s = std::strchr(RINEX_SYSTEMS, system);
+    if (system == '\0' or s == nullptr)
+        {
+            return -1;
+        }
+    return static_cast<int32_t>(s - RINEX_SYSTEMS);
+}
+
+
+/*
+ * Read-only view of a whole file. Regular files are memory-mapped, anything
+ * else (pipes, special files) is read into a buffer.
+ */
+class Mapped_File
+{
+public:
+    Mapped_File() = default;
+    ~Mapped_File()
+    {
+        if (d_map != nullptr)
+            {
+                munmap(d_map, d_size);
+            }
+    }
+    Mapped_File(const Mapped_File&) = delete;
+    Mapped_File& operator=(const Mapped_File&) = delete;
+
+    bool open(const std::string& filename)
+    {
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            {
+                return false;
+            }
+        struct stat st
+        {
+        };
+        if (fstat(fd, &st) == 0 and S_ISREG(st.st_mode) and st.st_size > 0)
+            {
+                const auto size = static_cast<size_t>(st.st_size);
+                void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (map != MAP_FAILED)
+                    {
+                        madvise(map, size, MADV_WILLNEED);
+                        close(fd);
+                        d_map = map;
+                        d_data = static_cast<const char*>(map);
+                        d_size = size;
+                        return true;
+                    }
+            }
+        std::vector<char> buffer(1 << 16);
+        ssize_t n;
+        while ((n = ::read(fd, buffer.data(), buffer.size())) > 0)
+            {
+                d_buffer.insert(d_buffer.end(), buffer.data(), buffer.data() + n);
+            }
+        close(fd);
+        d_data = d_buffer.data();
+        d_size = d_buffer.size();
+        return true;
+    }
+
+    const char* begin() const { return d_data; }
+    const char* end() const { return d_data + d_size; }
+
+private:
+    void* d_map{nullptr};
+    const char* d_data{nullptr};
+    size_t d_size{0};
+    std::vector<char> d_buffer;
+};
+
+
+/*
+ * A line of the file, without the end of line characters.
+ */
+struct Line
+{
+    const char* p;
+    size_t len;
+};
+
+
+// Returns the line starting at p, and moves p to the start of the next one
+inline Line next_line(const char*& p, const char* end)
+{
+    const auto* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    const char* e = (nl == nullptr) ? end : nl;
+    Line line{p, static_cast<size_t>(e - p)};
+    if (line.len > 0 and line.p[line.len - 1] == '\r')
+        {
+            line.len--;
+        }
+    p = (nl == nullptr) ? end : nl + 1;
+    return line;
+}
+
+
+void skip_lines(const char*& p, const char* end, int32_t n)
+{
+    for (int32_t i = 0; i < n and p < end; i++)
+        {
+            next_line(p, end);
+        }
+}
+
+
+double parse_double_slow(const char* p, const char* end)
+{
+    char buffer[64];
+    const size_t n = std::min(static_cast<size_t>(end - p), sizeof(buffer) - 1);
+    for (size_t i = 0; i < n; i++)
+        {
+            buffer[i] = (p[i] == 'D' or p[i] == 'd') ? 'E' : p[i];
+        }
+    buffer[n] = '\0';
+    return strtod(buffer, nullptr);
+}
+
+
+/*
+ * Converts a fixed-width Fortran field (F or D format) in place. Up to 15
+ * significant digits and exponents within the exact powers of ten take a
+ * single, correctly rounded, floating point operation.
+ */
+double parse_double(const char* p, const char* end)
+{
+    while (p < end and *p == ' ')
+        {
+            p++;
+        }
+    const char* start = p;
+    bool negative = false;
+    if (p < end and (*p == '-' or *p == '+'))
+        {
+            negative = (*p == '-');
+            p++;
+        }
+    uint64_t mantissa = 0;
+    int32_t digits = 0;
+    int32_t exponent = 0;
+    bool point = false;
+    for (; p < end; p++)
+        {
+            const char c = *p;
+            if (c >= '0' and c <= '9')
+                {
+                    if (digits < 19)
+                        {
+                            mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+                            digits += (mantissa != 0) ? 1 : 0;
+                            exponent -= point ? 1 : 0;
+                        }
+                    else if (not point)
+                        {
+                            exponent++;
+                        }
+                }
+            else if (c == '.' and not point)
+                {
+                    point = true;
+                }
+            else
+                {
+                    break;
+                }
+        }
+    if (p < end and (*p == 'D' or *p == 'E' or *p == 'd' or *p == 'e'))
+        {
+            p++;
+            bool negative_exponent = false;
+            if (p < end and (*p == '-' or *p == '+'))
+                {
+                    negative_exponent = (*p == '-');
+                    p++;
+                }
+            int32_t e = 0;
+            for (; p < end and *p >= '0' and *p <= '9' and e < 10000; p++)
+                {
+                    e = e * 10 + (*p - '0');
+                }
+            exponent += negative_exponent ? -e : e;
+        }
+    if (mantissa >= (uint64_t(1) << 53) or exponent < -22 or exponent > 22)
+        {
+            return parse_double_slow(start, end);
+        }
+    const auto m = static_cast<double>(mantissa);
+    const double value = (exponent < 0) ? m / POW10[-exponent] : m * POW10[exponent];
+    return negative ? -value : value;
+}
+
+
+int32_t parse_int(const char* p, const char* end)
+{
+    while (p < end and *p == ' ')
+        {
+            p++;
+        }
+    bool negative = false;
+    if (p < end and (*p == '-' or *p == '+'))
+        {
+            negative = (*p == '-');
+            p++;
+        }
+    int32_t value = 0;
+    for (; p < end and *p >= '0' and *p <= '9'; p++)
+        {
+            value = value * 10 + (*p - '0');
+        }
+    return negative ? -value : value;
+}
+
+
+// Fields beyond the end of the line are blank
+inline double field_double(const Line& line, size_t pos, size_t width)
+{
+    if (pos >= line.len)
+        {
+            return 0.0;
+        }
+    return parse_double(line.p + pos, line.p + std::min(pos + width, line.len));
+}
+
+
+inline int32_t field_int(const Line& line, size_t pos, size_t width)
+{
+    if (pos >= line.len)
+        {
+            return 0;
+        }
+    return parse_int(line.p + pos, line.p + std::min(pos + width, line.len));
+}
+
+
+inline char field_char(const Line& line, size_t pos)
+{
+    return (pos < line.len) ? line.p[pos] : ' ';
+}
+
+
+std::string field_string(const Line& line, size_t pos, size_t width)
+{
+    if (pos >= line.len)
+        {
+            return {};
+        }
+    std::string s(line.p + pos, std::min(width, line.len - pos));
+    s.erase(0, s.find_first_not_of(' '));
+    s.erase(s.find_last_not_of(' ') + 1);
+    return s;
+}
+
+
+inline bool has_label(const Line& line, const char* label)
+{
+    const size_t n = std::strlen(label);
+    return line.len >= 60 + n and std::memcmp(line.p + 60, label, n) == 0;
+}
+
+
+int64_t days_from_civil(int32_t year, int32_t month, int32_t day)
+{
+    const int64_t y = year - (month <= 2 ? 1 : 0);
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const int64_t yoe = y - era * 400;
+    const int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+
+void gps_time(int32_t year, int32_t month, int32_t day, int32_t hour, int32_t minute, double second, int32_t& week, double& tow)
+{
+    if (year < 100)
+        {
+            year += (year < 80) ? 2000 : 1900;
+        }
+    const int64_t days = days_from_civil(year, month, day) - days_from_civil(1980, 1, 6);
+    week = static_cast<int32_t>(days / 7);
+    tow = static_cast<double>(days % 7) * 86400.0 + hour * 3600.0 + minute * 60.0 + second;
+}
+
+
+/*
+ * Output of a parsing thread. Satellites are found through a flat table, and
+ * their columns grow by one row per epoch.
+ */
+struct Obs_Chunk
+{
+    std::map<char, std::map<int32_t, Rinex_Obs_Series>> satellites;
+    std::vector<Rinex_Obs_Series*> lookup = std::vector<Rinex_Obs_Series*>(RINEX_NUM_SYSTEMS * RINEX_MAX_PRN, nullptr);
+    uint64_t epochs{0};
+};
+
+
+inline Rinex_Obs_Series* chunk_series(Obs_Chunk& chunk, int32_t system, int32_t prn, size_t n_obs)
+{
+    Rinex_Obs_Series*& series = chunk.lookup[system * RINEX_MAX_PRN + prn];
+    if (series == nullptr)
+        {
+            series = &chunk.satellites[RINEX_SYSTEMS[system]][prn];
+            series->obs.resize(n_obs);
+        }
+    return series;
+}
+
+
+// RINEX 3 and 4: each epoch starts with a '>' line, followed by one line per satellite
+void parse_obs_v3(const char* p, const char* end, const std::vector<size_t>& n_obs, Obs_Chunk& chunk)
+{
+    while (p < end)
+        {
+            const Line epoch = next_line(p, end);
+            if (epoch.len < 35 or epoch.p[0] != '>')
+                {
+                    continue;
+                }
+            const int32_t flag = field_int(epoch, 31, 1);
+            const int32_t count = field_int(epoch, 32, 3);
+            if (flag > 1)
+                {
+                    // events carry header records, and flag 6 cycle slip records
+                    skip_lines(p, end, count);
+                    continue;
+                }
+            int32_t week;
+            double tow;
+            gps_time(field_int(epoch, 2, 4), field_int(epoch, 6, 3), field_int(epoch, 9, 3),
+                field_int(epoch, 12, 3), field_int(epoch, 15, 3), field_double(epoch, 18, 11), week, tow);
+            for (int32_t n = 0; n < count and p < end; n++)
+                {
+                    const char* line_start = p;
+                    const Line line = next_line(p, end);
+                    if (line.len > 0 and line.p[0] == '>')
+                        {
+                            p = line_start;  // truncated epoch
+                            break;
+                        }
+                    const int32_t system = system_index(field_char(line, 0));
+                    const int32_t prn = field_int(line, 1, 2);
+                    if (system < 0 or prn <= 0 or prn >= RINEX_MAX_PRN or n_obs[system] == 0)
+                        {
+                            continue;
+                        }
+                    Rinex_Obs_Series* series = chunk_series(chunk, system, prn, n_obs[system]);
+                    series->week.push_back(week);
+                    series->tow.push_back(tow);
+                    for (size_t k = 0; k < n_obs[system]; k++)
+                        {
+                            series->obs[k].push_back(field_double(line, 3 + 16 * k, 14));
+                        }
+                }
+            chunk.epochs++;
+        }
+}
+
+
+// RINEX 2: the epoch line lists the satellites, up to 12 per line, followed
+// by their observations, up to 5 per line
+void parse_obs_v2(const std::vector<const char*>& epochs, size_t first, size_t last, const char* end,
+    const std::vector<size_t>& n_obs, Obs_Chunk& chunk)
+{
+    const size_t obs_per_sat = n_obs[0];
+    const int32_t lines_per_sat = static_cast<int32_t>((obs_per_sat + 4) / 5);
+    std::vector<Line> sat_lines;
+    for (size_t e = first; e < last; e++)
+        {
+            const char* p = epochs[e];
+            const Line epoch = next_line(p, end);
+            const int32_t count = field_int(epoch, 29, 3);
+            int32_t week;
+            double tow;
+            gps_time(field_int(epoch, 0, 3), field_int(epoch, 3, 3), field_int(epoch, 6, 3),
+                field_int(epoch, 9, 3), field_int(epoch, 12, 3), field_double(epoch, 15, 11), week, tow);
+            sat_lines.assign(1, epoch);
+            for (int32_t n = 12; n < count; n += 12)
+                {
+                    sat_lines.push_back(next_line(p, end));
+                }
+            for (int32_t n = 0; n < count and p < end; n++)
+                {
+                    const Line& list = sat_lines[n / 12];
+                    const size_t pos = 32 + 3 * (n % 12);
+                    const char sys = field_char(list, pos);
+                    const int32_t system = system_index(sys == ' ' ? 'G' : sys);  // blank means GPS, also in mixed files
+                    const int32_t prn = field_int(list, pos + 1, 2);
+                    if (system < 0 or prn <= 0 or prn >= RINEX_MAX_PRN)
+                        {
+                            skip_lines(p, end, lines_per_sat);
+                            continue;
+                        }
+                    Rinex_Obs_Series* series = chunk_series(chunk, system, prn, obs_per_sat);
+                    series->week.push_back(week);
+                    series->tow.push_back(tow);
+                    Line line{p, 0};
+                    for (size_t k = 0; k < obs_per_sat; k++)
+                        {
+                            if (k % 5 == 0)
+                                {
+                                    line = next_line(p, end);
+                                }
+                            series->obs[k].push_back(field_double(line, 16 * (k % 5), 14));
+                        }
+                }
+            chunk.epochs++;
+        }
+}
+
+
+// Finds the start of the first RINEX 3 epoch at or after p
+const char* next_epoch(const char* p, const char* begin, const char* end)
+{
+    if (p == begin)
+        {
+            return p;
+        }
+    p--;
+    while (p < end)
+        {
+            const auto* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (nl == nullptr)
+                {
+                    return end;
+                }
+            p = nl + 1;
+            if (p < end and *p == '>')
+                {
+                    return p;
+                }
+        }
+    return end;
+}
+
+
+void append_chunk(Obs_Chunk& chunk, std::map<char, std::map<int32_t, Rinex_Obs_Series>>& satellites)
+{
+    for (auto& system : chunk.satellites)
+        {
+            for (auto& sat : system.second)
+                {
+                    Rinex_Obs_Series& dst = satellites[system.first][sat.first];
+                    Rinex_Obs_Series& src = sat.second;
+                    if (dst.tow.empty())
+                        {
+                            dst = std::move(src);
+                            continue;
+                        }
+                    dst.week.insert(dst.week.end(), src.week.begin(), src.week.end());
+                    dst.tow.insert(dst.tow.end(), src.tow.begin(), src.tow.end());
+                    dst.obs.resize(src.obs.size());
+                    for (size_t k = 0; k < src.obs.size(); k++)
+                        {
+                            dst.obs[k].insert(dst.obs[k].end(), src.obs[k].begin(), src.obs[k].end());
+                        }
+                }
+        }
+}
+}  // namespace
+
+
+bool Rinex_Obs_File::read(const std::string& filename, uint32_t threads)
+{
+    Mapped_File file;
+    if (not file.open(filename))
+        {
+            std::cerr << "Could not open RINEX observation file " << filename << '\n';
+            return false;
+        }
+    *this = Rinex_Obs_File();
+
+    // Header
+    const char* p = file.begin();
+    const char* end = file.end();
+    bool header_end = false;
+    std::vector<std::string> v2_types;
+    char types_system = ' ';
+    int32_t types_count = 0;
+    while (p < end and not header_end)
+        {
+            const Line line = next_line(p, end);
+            if (has_label(line, "RINEX VERSION / TYPE"))
+                {
+                    version = field_double(line, 0, 9);
+                    if (field_char(line, 20) != 'O')
+                        {
+                            std::cerr << filename << " is not a RINEX observation file\n";
+                            return false;
+                        }
+                    const char sys = field_char(line, 40);
+                    file_system = (sys == ' ') ? 'G' : sys;
+                }
+            else if (has_label(line, "# / TYPES OF OBSERV"))
+                {
+                    if (v2_types.empty())
+                        {
+                            types_count = field_int(line, 0, 6);
+                        }
+                    for (size_t n = 0; n < 9 and static_cast<int32_t>(v2_types.size()) < types_count; n++)
+                        {
+                            const std::string type = field_string(line, 6 + 6 * n, 6);
+                            if (not type.empty())
+                                {
+                                    v2_types.push_back(type);
+                                }
+                        }
+                }
+            else if (has_label(line, "SYS / # / OBS TYPES"))
+                {
+                    if (field_char(line, 0) != ' ')
+                        {
+                            types_system = field_char(line, 0);
+                            types_count = field_int(line, 3, 3);
+                        }
+                    std::vector<std::string>& types = obs_types[types_system];
+                    for (size_t n = 0; n < 13 and static_cast<int32_t>(types.size()) < types_count; n++)
+                        {
+                            const std::string type = field_string(line, 7 + 4 * n, 3);
+                            if (not type.empty())
+                                {
+                                    types.push_back(type);
+                                }
+                        }
+                }
+            else if (has_label(line, "INTERVAL"))
+                {
+                    interval_s = field_double(line, 0, 10);
+                }
+            else if (has_label(line, "END OF HEADER"))
+                {
+                    header_end = true;
+                }
+        }
+    if (not header_end or version < 1.0)
+        {
+            std::cerr << "Could not read the header of RINEX observation file " << filename << '\n';
+            return false;
+        }
+    if (version < 3.0)
+        {
+            for (int32_t s = 0; s < RINEX_NUM_SYSTEMS; s++)
+                {
+                    obs_types[RINEX_SYSTEMS[s]] = v2_types;
+                }
+        }
+    std::vector<size_t> n_obs(RINEX_NUM_SYSTEMS, 0);
+    for (int32_t s = 0; s < RINEX_NUM_SYSTEMS; s++)
+        {
+            const auto it = obs_types.find(RINEX_SYSTEMS[s]);
+            n_obs[s] = (it == obs_types.end()) ? 0 : it->second.size();
+        }
+
+    // Body, split in chunks that start at epoch boundaries
+    if (threads == 0)
+        {
+            threads = std::max(std::thread::hardware_concurrency(), 1U);
+        }
+    const auto body_size = static_cast<size_t>(end - p);
+    threads = static_cast<uint32_t>(std::min<size_t>(threads, body_size / RINEX_MIN_CHUNK_BYTES + 1));
+
+    std::vector<Obs_Chunk> chunks(threads);
+    std::vector<std::thread> workers;
+    if (version < 3.0)
+        {
+            // Epoch lengths depend on their number of satellites, so they
+            // are located sequentially
+            std::vector<const char*> starts;
+            const int32_t lines_per_sat = static_cast<int32_t>((n_obs[0] + 4) / 5);
+            while (p < end)
+                {
+                    const char* start = p;
+                    const Line epoch = next_line(p, end);
+                    if (epoch.len < 32)
+                        {
+                            continue;
+                        }
+                    const int32_t flag = field_int(epoch, 28, 1);
+                    const int32_t count = field_int(epoch, 29, 3);
+                    if (flag > 1 and flag < 6)
+                        {
+                            skip_lines(p, end, count);
+                            continue;
+                        }
+                    if (flag <= 1)
+                        {
+                            starts.push_back(start);
+                        }
+                    skip_lines(p, end, (count > 0 ? (count - 1) / 12 : 0) + count * lines_per_sat);
+                }
+            const size_t per_thread = (starts.size() + threads - 1) / threads;
+            for (uint32_t t = 0; t < threads; t++)
+                {
+                    const size_t first = std::min(starts.size(), t * per_thread);
+                    const size_t last = std::min(starts.size(), first + per_thread);
+                    workers.emplace_back(parse_obs_v2, std::cref(starts), first, last, end, std::cref(n_obs), std::ref(chunks[t]));
+                }
+            for (auto& worker : workers)
+                {
+                    worker.join();
+                }
+        }
+    else
+        {
+            const char* body = p;
+            std::vector<const char*> starts(threads + 1, end);
+            for (uint32_t t = 0; t < threads; t++)
+                {
+                    starts[t] = next_epoch(body + t * (body_size / threads), body, end);
+                    if (t > 0)
+                        {
+                            starts[t] = std::max(starts[t], starts[t - 1]);
+                        }
+                }
+            for (uint32_t t = 0; t < threads; t++)
+                {
+                    workers.emplace_back(parse_obs_v3, starts[t], starts[t + 1], std::cref(n_obs), std::ref(chunks[t]));
+                }
+            for (auto& worker : workers)
+                {
+                    worker.join();
+                }
+        }
+
+    for (auto& chunk : chunks)
+        {
+            epochs += chunk.epochs;
+            append_chunk(chunk, satellites);
+        }
+    return true;
+}
+
+
+int32_t Rinex_Obs_File::obs_index(char system, const std::string& code) const
+{
+    const auto it = obs_types.find(system);
+    if (it == obs_types.end())
+        {
+            return -1;
+        }
+    const std::vector<std::string>& types = it->second;
+    for (size_t k = 0; k < types.size(); k++)
+        {
+            if (types[k] == code)
+                {
+                    return static_cast<int32_t>(k);
+                }
+        }
+    for (size_t k = 0; k < types.size(); k++)
+        {
+            if (types[k].size() == 2 and code.compare(0, 2, types[k]) == 0)
+                {
+                    return static_cast<int32_t>(k);
+                }
+        }
+    return -1;
+}
+
+
+const Rinex_Obs_Series* Rinex_Obs_File::series(char system, int32_t prn) const
+{
+    const auto sys = satellites.find(system);
+    if (sys == satellites.end())
+        {
+            return nullptr;
+        }
+    const auto sat = sys->second.find(prn);
+    return (sat == sys->second.end()) ? nullptr : &sat->second;
+}
+
+
+bool Rinex_Nav_File::read(const std::string& filename)
+{
+    Mapped_File file;
+    if (not file.open(filename))
+        {
+            std::cerr << "Could not open RINEX navigation file " << filename << '\n';
+            return false;
+        }
+    *this = Rinex_Nav_File();
+
+    const char* p = file.begin();
+    const char* end = file.end();
+    bool header_end = false;
+    while (p < end and not header_end)
+        {
+            const Line line = next_line(p, end);
+            if (has_label(line, "RINEX VERSION / TYPE"))
+                {
+                    version = field_double(line, 0, 9);
+                    file_type = field_char(line, 20);
+                    const char sys = field_char(line, 40);
+                    if (version < 3.0)
+                        {
+                            // the file type tells the system
+                            if (file_type != 'N' and file_type != 'G' and file_type != 'H' and file_type != 'E')
+                                {
+                                    std::cerr << filename << " is not a RINEX navigation file\n";
+                                    return false;
+                                }
+                            file_system = (file_type == 'G') ? 'R' : (file_type == 'H') ? 'S' : (file_type == 'E') ? 'E' : 'G';
+                            file_type = 'N';
+                        }
+                    else
+                        {
+                            file_system = (sys == ' ') ? 'G' : sys;
+                        }
+                    if (file_type != 'N')
+                        {
+                            std::cerr << filename << " is not a RINEX navigation file\n";
+                            return false;
+                        }
+                }
+            else if (has_label(line, "ION ALPHA") or has_label(line, "ION BETA"))
+                {
+                    std::array<double, 4>& iono = iono_corrections[has_label(line, "ION ALPHA") ? "GPSA" : "GPSB"];
+                    for (size_t n = 0; n < 4; n++)
+                        {
+                            iono[n] = field_double(line, 2 + 12 * n, 12);
+                        }
+                }
+            else if (has_label(line, "IONOSPHERIC CORR"))
+                {
+                    std::array<double, 4>& iono = iono_corrections[field_string(line, 0, 4)];
+                    for (size_t n = 0; n < 4; n++)
+                        {
+                            iono[n] = field_double(line, 5 + 12 * n, 12);
+                        }
+                }
+            else if (has_label(line, "DELTA-UTC: A0,A1,T,W"))
+                {
+                    Rinex_Time_Correction& corr = time_corrections["GPUT"];
+                    corr.A0 = field_double(line, 3, 19);
+                    corr.A1 = field_double(line, 22, 19);
+                    corr.ref_tow = field_int(line, 41, 9);
+                    corr.ref_week = field_int(line, 50, 9);
+                }
+            else if (has_label(line, "TIME SYSTEM CORR"))
+                {
+                    Rinex_Time_Correction& corr = time_corrections[field_string(line, 0, 4)];
+                    corr.A0 = field_double(line, 5, 17);
+                    corr.A1 = field_double(line, 22, 16);
+                    corr.ref_tow = field_int(line, 38, 7);
+                    corr.ref_week = field_int(line, 45, 5);
+                }
+            else if (has_label(line, "LEAP SECONDS"))
+                {
+                    leap_seconds = field_int(line, 0, 6);
+                    leap_seconds_future = field_int(line, 6, 6);
+                    leap_week = field_int(line, 12, 6);
+                    leap_day = field_int(line, 18, 6);
+                }
+            else if (has_label(line, "END OF HEADER"))
+                {
+                    header_end = true;
+                }
+        }
+    if (not header_end or version < 1.0)
+        {
+            std::cerr << "Could not read the header of RINEX navigation file " << filename << '\n';
+            return false;
+        }
+
+    // Records: a first line with the satellite, the epoch and the clock
+    // parameters, followed by indented lines with four broadcast orbit values
+    const bool v2 = version < 3.0;
+    const size_t first_value = v2 ? 22 : 23;
+    const size_t orbit_value = v2 ? 3 : 4;
+    std::string type;
+    while (p < end)
+        {
+            const Line line = next_line(p, end);
+            if (line.len == 0)
+                {
+                    continue;
+                }
+            if (line.p[0] == '>')
+                {
+                    // RINEX 4 record header: only ephemerides are kept
+                    type.clear();
+                    if (line.len > 6 and std::memcmp(line.p, "> EPH ", 6) == 0)
+                        {
+                            type = field_string(line, 10, 5);
+                        }
+                    else
+                        {
+                            while (p < end and *p != '>')
+                                {
+                                    next_line(p, end);
+                                }
+                        }
+                    continue;
+                }
+            if (line.len < first_value)
+                {
+                    continue;
+                }
+            Rinex_Nav_Record record;
+            record.type = type;
+            int32_t year;
+            if (v2)
+                {
+                    record.system = file_system;
+                    record.prn = field_int(line, 0, 2);
+                    year = field_int(line, 2, 3);
+                    record.epoch = {year, field_int(line, 5, 3), field_int(line, 8, 3), field_int(line, 11, 3), field_int(line, 14, 3)};
+                    record.second = field_double(line, 17, 5);
+                }
+            else
+                {
+                    record.system = line.p[0];
+                    record.prn = field_int(line, 1, 2);
+                    year = field_int(line, 3, 5);
+                    record.epoch = {year, field_int(line, 8, 3), field_int(line, 11, 3), field_int(line, 14, 3), field_int(line, 17, 3)};
+                    record.second = field_int(line, 20, 3);
+                }
+            if (year < 100)
+                {
+                    record.epoch[0] += (year < 80) ? 2000 : 1900;
+                }
+            gps_time(record.epoch[0], record.epoch[1], record.epoch[2], record.epoch[3], record.epoch[4], record.second, record.week, record.tow);
+            record.data.reserve(3 + 4 * 9);
+            for (size_t n = 0; n < 3; n++)
+                {
+                    record.data.push_back(field_double(line, first_value + 19 * n, 19));
+                }
+            while (p < end)
+                {
+                    const char* next = p;
+                    const Line orbit = next_line(next, end);
+                    if (orbit.len == 0 or orbit.p[0] == '>' or (v2 ? field_char(orbit, 1) : field_char(orbit, 0)) != ' ')
+                        {
+                            break;
+                        }
+                    p = next;
+                    for (size_t n = 0; n < 4; n++)
+                        {
+                            record.data.push_back(field_double(orbit, orbit_value + 19 * n, 19));
+                        }
+                }
+            records.push_back(std::move(record));
+        }
+    return true;
+}
+
+
+namespace
+{
+inline double record_value(const Rinex_Nav_Record& record, size_t n)
+{
+    return (n < record.data.size()) ? record.data[n] : 0.0;
+}
+}  // namespace
+
+
+Gps_Ephemeris rinex_to_gps_ephemeris(const Rinex_Nav_Record& record)
+{
+    Gps_Ephemeris eph;
+    eph.PRN = record.prn;
+    eph.af0 = record_value(record, 0);
+    eph.af1 = record_value(record, 1);
+    eph.af2 = record_value(record, 2);
+    eph.IODE_SF2 = static_cast<int32_t>(record_value(record, 3));
+    eph.IODE_SF3 = eph.IODE_SF2;
+    eph.Crs = record_value(record, 4);
+    eph.delta_n = record_value(record, 5);
+    eph.M_0 = record_value(record, 6);
+    eph.Cuc = record_value(record, 7);
+    eph.ecc = record_value(record, 8);
+    eph.Cus = record_value(record, 9);
+    eph.sqrtA = record_value(record, 10);
+    eph.toe = static_cast<int32_t>(record_value(record, 11));
+    eph.Cic = record_value(record, 12);
+    eph.OMEGA_0 = record_value(record, 13);
+    eph.Cis = record_value(record, 14);
+    eph.i_0 = record_value(record, 15);
+    eph.Crc = record_value(record, 16);
+    eph.omega = record_value(record, 17);
+    eph.OMEGAdot = record_value(record, 18);
+    eph.idot = record_value(record, 19);
+    eph.code_on_L2 = static_cast<int32_t>(record_value(record, 20));
+    eph.WN = static_cast<int32_t>(record_value(record, 21));
+    eph.L2_P_data_flag = record_value(record, 22) != 0.0;
+    eph.SV_accuracy = static_cast<int32_t>(record_value(record, 23));
+    eph.SV_health = static_cast<int32_t>(record_value(record, 24));
+    eph.TGD = record_value(record, 25);
+    eph.IODC = static_cast<int32_t>(record_value(record, 26));
+    eph.tow = static_cast<int32_t>(record_value(record, 27));
+    eph.fit_interval_flag = record_value(record, 28) > 4.0;
+    eph.toc = static_cast<int32_t>(record.tow);
+    return eph;
+}
+
+
+Galileo_Ephemeris rinex_to_galileo_ephemeris(const Rinex_Nav_Record& record)
+{
+    Galileo_Ephemeris eph;
+    eph.PRN = record.prn;
+    eph.af0 = record_value(record, 0);
+    eph.af1 = record_value(record, 1);
+    eph.af2 = record_value(record, 2);
+    eph.IOD_nav = static_cast<int32_t>(record_value(record, 3));
+    eph.IOD_ephemeris = eph.IOD_nav;
+    eph.Crs = record_value(record, 4);
+    eph.delta_n = record_value(record, 5);
+    eph.M_0 = record_value(record, 6);
+    eph.Cuc = record_value(record, 7);
+    eph.ecc = record_value(record, 8);
+    eph.Cus = record_value(record, 9);
+    eph.sqrtA = record_value(record, 10);
+    eph.toe = static_cast<int32_t>(record_value(record, 11));
+    eph.Cic = record_value(record, 12);
+    eph.OMEGA_0 = record_value(record, 13);
+    eph.Cis = record_value(record, 14);
+    eph.i_0 = record_value(record, 15);
+    eph.Crc = record_value(record, 16);
+    eph.omega = record_value(record, 17);
+    eph.OMEGAdot = record_value(record, 18);
+    eph.idot = record_value(record, 19);
+    eph.WN = static_cast<int32_t>(record_value(record, 21));
+    eph.BGD_E1E5a = record_value(record, 25);
+    eph.BGD_E1E5b = record_value(record, 26);
+    eph.tow = static_cast<int32_t>(record_value(record, 27));
+    eph.toc = static_cast<int32_t>(record.tow);
+    return eph;
+}
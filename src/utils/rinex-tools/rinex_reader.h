@@ -0,0 +1,153 @@
+/*!
+ * \file rinex_reader.h
+ * \brief Memory-mapped RINEX 2, 3 and 4 observation and navigation file
+ * readers with columnar, per-satellite output.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RINEX_READER_H
+#define GNSS_SDR_RINEX_READER_H
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class Galileo_Ephemeris;
+class Gps_Ephemeris;
+
+
+/*!
+ * \brief Observations of a single satellite, one column per observation type
+ * of its system (in the order of the header), and one row per epoch.
+ * Blank fields are stored as 0.0.
+ */
+struct Rinex_Obs_Series
+{
+    std::vector<int32_t> week;              //!< GPS week of each epoch
+    std::vector<double> tow;                //!< GPS seconds of week of each epoch
+    std::vector<std::vector<double>> obs;   //!< Observation columns
+};
+
+
+/*!
+ * \brief Reads RINEX 2.xx, 3.xx and 4.xx observation files.
+ *
+ * The file is memory-mapped and the fixed-width fields are converted in
+ * place, without copying lines into strings. The body is split into chunks
+ * at epoch boundaries, which are parsed in parallel and then appended in file
+ * order to the columns of each satellite. Only epochs with flags 0 and 1 are
+ * stored. Epoch times are converted to GPS week and seconds of week,
+ * regardless of the time system of the file.
+ */
+class Rinex_Obs_File
+{
+public:
+    /*!
+     * \brief Reads the file. If threads is zero, one thread per hardware
+     * core is used. Returns false, and prints the reason, if the file could
+     * not be read.
+     */
+    bool read(const std::string& filename, uint32_t threads = 0);
+
+    /*!
+     * \brief Returns the column of the observation code (e.g. "C1C") for a
+     * system, or -1 if the file does not have it. RINEX 2 codes (e.g. "C1")
+     * are matched by their first two characters.
+     */
+    int32_t obs_index(char system, const std::string& code) const;
+
+    /*!
+     * \brief Returns the observations of a satellite, or nullptr if the file
+     * has none.
+     */
+    const Rinex_Obs_Series* series(char system, int32_t prn) const;
+
+    double version{};
+    char file_system{'G'};  //!< G, R, E, C, J, I, S or M (mixed)
+    double interval_s{};
+    uint64_t epochs{};      //!< Number of epochs with observations
+    std::map<char, std::vector<std::string>> obs_types;  //!< By system
+    std::map<char, std::map<int32_t, Rinex_Obs_Series>> satellites;  //!< By system and PRN
+};
+
+
+/*!
+ * \brief A navigation message record: the clock parameters of the first line
+ * followed by the broadcast orbit values, in file order. Blank fields are
+ * stored as 0.0.
+ */
+struct Rinex_Nav_Record
+{
+    char system{'G'};
+    int32_t prn{};
+    std::string type;              //!< RINEX 4 message type (e.g. "LNAV"), empty in older versions
+    std::array<int32_t, 5> epoch{};  //!< Year, month, day, hour and minute of the clock reference time
+    double second{};
+    int32_t week{};                //!< Clock reference time as a GPS week ...
+    double tow{};                  //!< ... and seconds of week
+    std::vector<double> data;
+};
+
+
+/*!
+ * \brief Time system correction from the navigation header.
+ */
+struct Rinex_Time_Correction
+{
+    double A0{};
+    double A1{};
+    int32_t ref_tow{};
+    int32_t ref_week{};
+};
+
+
+/*!
+ * \brief Reads RINEX 2.xx, 3.xx and 4.xx navigation files. Ionospheric and
+ * time system corrections are read from the header (RINEX 2 and 3). RINEX 4
+ * records other than ephemerides (STO, EOP, ION) are skipped.
+ */
+class Rinex_Nav_File
+{
+public:
+    /*!
+     * \brief Reads the file. Returns false, and prints the reason, if the
+     * file could not be read.
+     */
+    bool read(const std::string& filename);
+
+    double version{};
+    char file_type{'N'};
+    char file_system{'G'};  //!< G, R, E, C, J, I, S or M (mixed)
+    int32_t leap_seconds{};
+    int32_t leap_seconds_future{};
+    int32_t leap_week{};
+    int32_t leap_day{};
+    std::map<std::string, std::array<double, 4>> iono_corrections;   //!< By type: GPSA, GPSB, GAL, ...
+    std::map<std::string, Rinex_Time_Correction> time_corrections;  //!< By type: GPUT, GAUT, ...
+    std::vector<Rinex_Nav_Record> records;
+};
+
+
+/*!
+ * \brief Fills a GPS ephemeris from a GPS LNAV record.
+ */
+Gps_Ephemeris rinex_to_gps_ephemeris(const Rinex_Nav_Record& record);
+
+/*!
+ * \brief Fills a Galileo ephemeris from a Galileo I/NAV or F/NAV record.
+ */
+Galileo_Ephemeris rinex_to_galileo_ephemeris(const Rinex_Nav_Record& record);
+
+
+#endif  // GNSS_SDR_RINEX_READER_H
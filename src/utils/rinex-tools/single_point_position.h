@@ -0,0 +1,91 @@
+/*!
+ * \file single_point_position.h
+ * \brief Single point position and receiver clock bias from GPS L1 C/A
+ * pseudoranges, as used by obsdiff to remove the receiver clock error.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SINGLE_POINT_POSITION_H
+#define GNSS_SDR_SINGLE_POINT_POSITION_H
+
+#include "MATH_CONSTANTS.h"
+#include "gps_ephemeris.h"
+#include <armadillo>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+
+/*!
+ * \brief Unweighted least-squares single point solution with the GPS L1 C/A
+ * pseudoranges of an epoch and the broadcast ephemerides, with the
+ * satellite clock (including the relativistic term) and Sagnac corrections
+ * but without atmospheric corrections. Returns false if it does not
+ * converge. x is the ECEF position [m] and the receiver clock bias [m].
+ */
+inline bool solve_single_point_position(double tow, const std::vector<std::pair<Gps_Ephemeris, double>>& sats, arma::vec& x, double& gdop, double& pdop, double& rms)
+{
+    const auto n_sats = static_cast<arma::uword>(sats.size());
+    if (n_sats < 4)
+        {
+            return false;
+        }
+    x = arma::zeros<arma::vec>(4);
+    arma::mat H(n_sats, 4);
+    arma::vec residuals(n_sats);
+    for (int iter = 0; iter < 10; iter++)
+        {
+            for (arma::uword i = 0; i < n_sats; i++)
+                {
+                    Gps_Ephemeris eph = sats[i].first;
+                    const double pseudorange = sats[i].second;
+                    double transmit_time = tow - pseudorange / SPEED_OF_LIGHT_M_S;
+                    transmit_time -= eph.sv_clock_drift(transmit_time);
+                    eph.satellitePosition(transmit_time);
+                    const double sat_clock_m = eph.sv_clock_drift(transmit_time) * SPEED_OF_LIGHT_M_S;
+
+                    // Earth rotation during the geometric time of flight, which
+                    // does not include the receiver clock bias
+                    const arma::vec sat_pos_tx = {eph.satpos_X, eph.satpos_Y, eph.satpos_Z};
+                    const double flight_time = arma::norm(sat_pos_tx - x.subvec(0, 2)) / SPEED_OF_LIGHT_M_S;
+                    const double rotation = GNSS_OMEGA_EARTH_DOT * flight_time;
+                    const arma::vec sat_pos = {eph.satpos_X * std::cos(rotation) + eph.satpos_Y * std::sin(rotation),
+                        -eph.satpos_X * std::sin(rotation) + eph.satpos_Y * std::cos(rotation),
+                        eph.satpos_Z};
+                    const arma::vec los = sat_pos - x.subvec(0, 2);
+                    const double range = arma::norm(los);
+                    residuals(i) = pseudorange - (range + x(3) - sat_clock_m);
+                    H(i, 0) = -los(0) / range;
+                    H(i, 1) = -los(1) / range;
+                    H(i, 2) = -los(2) / range;
+                    H(i, 3) = 1.0;
+                }
+            arma::vec dx;
+            if (not arma::solve(dx, H, residuals))
+                {
+                    return false;
+                }
+            x += dx;
+            if (arma::norm(dx) < 1e-4)
+                {
+                    const arma::mat Q = arma::inv(H.t() * H);
+                    gdop = std::sqrt(arma::trace(Q));
+                    pdop = std::sqrt(Q(0, 0) + Q(1, 1) + Q(2, 2));
+                    rms = std::sqrt(arma::dot(residuals, residuals) / static_cast<double>(n_sats));
+                    return true;
+                }
+        }
+    return false;
+}
+
+
+#endif  // GNSS_SDR_SINGLE_POINT_POSITION_H
@@ -22,18 +22,20 @@
 #include "gps_ephemeris.h"
 #include "gps_iono.h"
 #include "gps_utc_model.h"
+#include "rinex_reader.h"
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/iostreams/copy.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
 #include <boost/serialization/map.hpp>
 #include <gflags/gflags.h>
-#include <gpstk/Rinex3NavData.hpp>
-#include <gpstk/Rinex3NavHeader.hpp>
-#include <gpstk/Rinex3NavStream.hpp>
+#include <array>
 #include <cstddef>  // for size_t
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <string>
 
 #if GFLAGS_OLD_NAMESPACE
 namespace gflags
@@ -150,159 +152,85 @@ int main(int argc, char** argv)
     Galileo_Utc_Model gal_utc_model;
     Galileo_Iono gal_iono;
 
-    int i = 0;
-    int j = 0;
-    try
+    // Read nav file
+    Rinex_Nav_File nav;
+    if (not nav.read(input_filename) or nav.file_type != 'N')
         {
-            // Read nav file
-            gpstk::Rinex3NavStream rnffs(input_filename.c_str());  // Open navigation data file
-            gpstk::Rinex3NavData rne;
-            gpstk::Rinex3NavHeader hdr;
-
-            // Read header
-            rnffs >> hdr;
-
             // Check that it really is a RINEX navigation file
-            if (hdr.fileType.substr(0, 1) != "N")
-                {
-                    std::cerr << "This is not a valid RINEX navigation file, or file not found.\n";
-                    std::cerr << "No XML file will be created.\n";
-                    return 1;
-                }
+            std::cerr << "This is not a valid RINEX navigation file, or file not found.\n";
+            std::cerr << "No XML file will be created.\n";
+            gflags::ShutDownCommandLineFlags();
+            return 1;
+        }
 
-            // Collect UTC parameters from RINEX header
-            if (hdr.fileSys == "G: (GPS)" || hdr.fileSys == "MIXED")
-                {
-                    gps_utc_model.valid = (hdr.valid > 2147483648) ? true : false;
-                    gps_utc_model.A1 = hdr.mapTimeCorr["GPUT"].A0;
-                    gps_utc_model.A0 = hdr.mapTimeCorr["GPUT"].A1;
-                    gps_utc_model.tot = hdr.mapTimeCorr["GPUT"].refSOW;
-                    gps_utc_model.WN_T = hdr.mapTimeCorr["GPUT"].refWeek;
-                    gps_utc_model.DeltaT_LS = hdr.leapSeconds;
-                    gps_utc_model.WN_LSF = hdr.leapWeek;
-                    gps_utc_model.DN = hdr.leapDay;
-                    gps_utc_model.DeltaT_LSF = hdr.leapDelta;
+    // Collect UTC parameters from RINEX header
+    if (nav.file_system == 'G' or nav.file_system == 'M')
+        {
+            const Rinex_Time_Correction& gput = nav.time_corrections["GPUT"];
+            gps_utc_model.valid = nav.time_corrections.count("GPUT") != 0 and (gput.A0 != 0.0 or gput.A1 != 0.0);
+            gps_utc_model.A0 = gput.A0;
+            gps_utc_model.A1 = gput.A1;
+            gps_utc_model.tot = gput.ref_tow;
+            gps_utc_model.WN_T = gput.ref_week;
+            gps_utc_model.DeltaT_LS = nav.leap_seconds;
+            gps_utc_model.WN_LSF = nav.leap_week;
+            gps_utc_model.DN = nav.leap_day;
+            gps_utc_model.DeltaT_LSF = nav.leap_seconds_future;
 
-                    // Collect iono parameters from RINEX header
-                    gps_iono.valid = (hdr.mapIonoCorr["GPSA"].param[0] == 0) ? false : true;
-                    gps_iono.alpha0 = hdr.mapIonoCorr["GPSA"].param[0];
-                    gps_iono.alpha1 = hdr.mapIonoCorr["GPSA"].param[1];
-                    gps_iono.alpha2 = hdr.mapIonoCorr["GPSA"].param[2];
-                    gps_iono.alpha3 = hdr.mapIonoCorr["GPSA"].param[3];
-                    gps_iono.beta0 = hdr.mapIonoCorr["GPSB"].param[0];
-                    gps_iono.beta1 = hdr.mapIonoCorr["GPSB"].param[1];
-                    gps_iono.beta2 = hdr.mapIonoCorr["GPSB"].param[2];
-                    gps_iono.beta3 = hdr.mapIonoCorr["GPSB"].param[3];
-                }
-            if (hdr.fileSys == "E: (GAL)" || hdr.fileSys == "MIXED")
+            // Collect iono parameters from RINEX header
+            const std::array<double, 4>& alpha = nav.iono_corrections["GPSA"];
+            const std::array<double, 4>& beta = nav.iono_corrections["GPSB"];
+            gps_iono.valid = (alpha[0] == 0) ? false : true;
+            gps_iono.alpha0 = alpha[0];
+            gps_iono.alpha1 = alpha[1];
+            gps_iono.alpha2 = alpha[2];
+            gps_iono.alpha3 = alpha[3];
+            gps_iono.beta0 = beta[0];
+            gps_iono.beta1 = beta[1];
+            gps_iono.beta2 = beta[2];
+            gps_iono.beta3 = beta[3];
+        }
+    if (nav.file_system == 'E' or nav.file_system == 'M')
+        {
+            const Rinex_Time_Correction& gaut = nav.time_corrections["GAUT"];
+            const std::array<double, 4>& gal = nav.iono_corrections["GAL"];
+            gal_utc_model.A0 = gaut.A0;
+            gal_utc_model.A1 = gaut.A1;
+            gal_utc_model.Delta_tLS = nav.leap_seconds;
+            gal_utc_model.tot = gaut.ref_tow;
+            gal_utc_model.WNot = gaut.ref_week;
+            gal_utc_model.WN_LSF = nav.leap_week;
+            gal_utc_model.DN = nav.leap_day;
+            gal_utc_model.Delta_tLSF = nav.leap_seconds_future;
+            gal_utc_model.flag_utc_model = (gaut.A0 == 0.0);
+            gal_iono.ai0 = gal[0];
+            gal_iono.ai1 = gal[1];
+            gal_iono.ai2 = gal[2];
+            gal_iono.Region1_flag = false;
+            gal_iono.Region2_flag = false;
+            gal_iono.Region3_flag = false;
+            gal_iono.Region4_flag = false;
+            gal_iono.Region5_flag = false;
+            gal_iono.tow = 0.0;
+            gal_iono.WN = 0.0;
+        }
+
+    // Read navigation data
+    int i = 0;
+    int j = 0;
+    for (const auto& record : nav.records)
+        {
+            if (record.system == 'G' and (record.type.empty() or record.type == "LNAV"))
                 {
-                    gal_utc_model.A0 = hdr.mapTimeCorr["GAUT"].A0;
-                    gal_utc_model.A1 = hdr.mapTimeCorr["GAUT"].A1;
-                    gal_utc_model.Delta_tLS = hdr.leapSeconds;
-                    gal_utc_model.tot = hdr.mapTimeCorr["GAUT"].refSOW;
-                    gal_utc_model.WNot = hdr.mapTimeCorr["GAUT"].refWeek;
-                    gal_utc_model.WN_LSF = hdr.leapWeek;
-                    gal_utc_model.DN = hdr.leapDay;
-                    gal_utc_model.Delta_tLSF = hdr.leapDelta;
-                    gal_utc_model.flag_utc_model = (hdr.mapTimeCorr["GAUT"].A0 == 0.0);
-                    gal_iono.ai0 = hdr.mapIonoCorr["GAL"].param[0];
-                    gal_iono.ai1 = hdr.mapIonoCorr["GAL"].param[1];
-                    gal_iono.ai2 = hdr.mapIonoCorr["GAL"].param[2];
-                    gal_iono.Region1_flag = false;
-                    gal_iono.Region2_flag = false;
-                    gal_iono.Region3_flag = false;
-                    gal_iono.Region4_flag = false;
-                    gal_iono.Region5_flag = false;
-                    gal_iono.tow = 0.0;
-                    gal_iono.WN = 0.0;
+                    eph_map[i] = rinex_to_gps_ephemeris(record);
+                    i++;
                 }
-
-            // Read navigation data
-            while (rnffs >> rne)
+            if (record.system == 'E')
                 {
-                    if (rne.satSys == "G" or rne.satSys.empty())
-                        {
-                            // Fill GPS ephemeris object
-                            Gps_Ephemeris eph;
-                            eph.PRN = rne.PRNID;
-                            eph.tow = rne.xmitTime;
-                            eph.IODE_SF2 = rne.IODE;
-                            eph.IODE_SF3 = rne.IODE;
-                            eph.Crs = rne.Crs;
-                            eph.delta_n = rne.dn;
-                            eph.M_0 = rne.M0;
-                            eph.Cuc = rne.Cuc;
-                            eph.ecc = rne.ecc;
-                            eph.Cus = rne.Cus;
-                            eph.sqrtA = rne.Ahalf;
-                            eph.toe = rne.Toe;
-                            eph.toc = rne.Toc;
-                            eph.Cic = rne.Cic;
-                            eph.OMEGA_0 = rne.OMEGA0;
-                            eph.Cis = rne.Cis;
-                            eph.i_0 = rne.i0;
-                            eph.Crc = rne.Crc;
-                            eph.omega = rne.w;
-                            eph.OMEGAdot = rne.OMEGAdot;
-                            eph.idot = rne.idot;
-                            eph.code_on_L2 = rne.codeflgs;  //
-                            eph.WN = rne.weeknum;
-                            eph.L2_P_data_flag = rne.L2Pdata;
-                            eph.SV_accuracy = rne.accuracy;
-                            eph.SV_health = rne.health;
-                            eph.TGD = rne.Tgd;
-                            eph.IODC = rne.IODC;
-                            eph.AODO = 0;  //
-                            eph.fit_interval_flag = (rne.fitint > 4) ? true : false;
-                            eph.spare1 = 0.0;
-                            eph.spare2 = 0.0;
-                            eph.af0 = rne.af0;
-                            eph.af1 = rne.af1;
-                            eph.af2 = rne.af2;
-                            eph.integrity_status_flag = false;  //
-                            eph.alert_flag = false;             //
-                            eph.antispoofing_flag = false;      //
-                            eph_map[i] = eph;
-                            i++;
-                        }
-                    if (rne.satSys == "E")
-                        {
-                            // Fill Galileo ephemeris object
-                            Galileo_Ephemeris eph;
-                            eph.PRN = rne.PRNID;
-                            eph.M_0 = rne.M0;
-                            eph.ecc = rne.ecc;
-                            eph.sqrtA = rne.Ahalf;
-                            eph.OMEGA_0 = rne.OMEGA0;
-                            eph.i_0 = rne.i0;
-                            eph.omega = rne.w;
-                            eph.OMEGAdot = rne.OMEGAdot;
-                            eph.delta_n = rne.dn;
-                            eph.idot = rne.idot;
-                            eph.Cuc = rne.Cuc;
-                            eph.Cus = rne.Cus;
-                            eph.Crc = rne.Crc;
-                            eph.Crs = rne.Crs;
-                            eph.Cic = rne.Cic;
-                            eph.Cis = rne.Cis;
-                            eph.toe = rne.Toe;
-                            eph.toc = rne.Toc;
-                            eph.af0 = rne.af0;
-                            eph.af1 = rne.af1;
-                            eph.af2 = rne.af2;
-                            eph.WN = rne.weeknum;
-                            eph_gal_map[j] = eph;
-                            j++;
-                        }
+                    eph_gal_map[j] = rinex_to_galileo_ephemeris(record);
+                    j++;
                 }
         }
-    catch (std::exception& e)
-        {
-            std::cerr << "Error reading the RINEX file: " << e.what() << '\n';
-            std::cerr << "No XML file will be created.\n";
-            gflags::ShutDownCommandLineFlags();
-            return 1;
-        }
 
     if (i == 0 and j == 0)
         {